@@ -0,0 +1,137 @@
+/**
+    Insight Data Engineering Code Challenge
+    gen_workload.cpp
+
+    Purpose:
+
+    Writes a synthetic workload of Venmo payments, for rolling_median to
+    read: see WorkloadGenerator. The same options always give the same
+    output.
+
+    Usage: gen_workload [--option=value ...] output_filename
+    with output_filename - for standard output. make gen_workload builds it.
+
+    @author Victor Chen
+*/
+#include "victor/workload.hpp"
+#include "victor/venmo_record.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+bool parse(char const* s, uint64_t& value) {
+	char* end;
+	value = strtoull(s, &end, 10);
+	return *s != '\0' && *end == '\0';
+}
+
+bool parse(char const* s, double& value) {
+	char* end;
+	value = strtod(s, &end);
+	return *s != '\0' && *end == '\0' && value >= 0;
+}
+
+void usage() {
+	std::cout << "Usage:" << std::endl;
+	std::cout << "gen_workload [--option=value ...] output_filename|-" << std::endl;
+	std::cout << "  --records=N         records to write (1000000)" << std::endl;
+	std::cout << "  --seed=N            random seed (1)" << std::endl;
+	std::cout << "  --users=N           number of users (100000)" << std::endl;
+	std::cout << "  --zipf=S            exponent of user popularity, 0 for uniform (1)" << std::endl;
+	std::cout << "  --rate=R            mean records per second (10)" << std::endl;
+	std::cout << "  --burst=B           mean records sharing a second in a burst (1)" << std::endl;
+	std::cout << "  --out-of-order=F    fraction late but inside the window (0.05)" << std::endl;
+	std::cout << "  --out-of-window=F   fraction too late to count (0.01)" << std::endl;
+	std::cout << "  --repeat-edge=F     fraction repeating a recent pair of users (0.1)" << std::endl;
+	std::cout << "  --malformed=F       fraction of malformed records (0.001)" << std::endl;
+	std::cout << "  --start=TIME        created_time of the first record (2016-03-28T23:23:12Z)" << std::endl;
+	std::cout << "  --format=json|msgpack|cbor" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	victor::WorkloadConfig config;
+	uint64_t records = 1000000;
+	int arg = 1;
+	for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; ++arg) {
+		char const* const option = argv[arg];
+		char const* const eq = strchr(option, '=');
+		if (eq == nullptr) {
+			std::cout << "Unknown option: " << option << std::endl;
+			usage();
+			return 1;
+		}
+		std::string const name(option + 2, eq);
+		char const* const value = eq + 1;
+		bool ok;
+		if (name == "records") {
+			ok = parse(value, records);
+		} else if (name == "seed") {
+			ok = parse(value, config.seed);
+		} else if (name == "users") {
+			ok = parse(value, config.num_users) && config.num_users >= 2;
+		} else if (name == "zipf") {
+			ok = parse(value, config.zipf);
+		} else if (name == "rate") {
+			ok = parse(value, config.rate) && config.rate > 0;
+		} else if (name == "burst") {
+			ok = parse(value, config.burst) && config.burst >= 1;
+		} else if (name == "out-of-order") {
+			ok = parse(value, config.out_of_order) && config.out_of_order <= 1;
+		} else if (name == "out-of-window") {
+			ok = parse(value, config.out_of_window) && config.out_of_window <= 1;
+		} else if (name == "repeat-edge") {
+			ok = parse(value, config.repeat_edge) && config.repeat_edge <= 1;
+		} else if (name == "malformed") {
+			ok = parse(value, config.malformed) && config.malformed <= 1;
+		} else if (name == "start") {
+			ok = victor::VenmoRecordReader::parse_time(value, config.start_time);
+		} else if (name == "format") {
+			ok = true;
+			if (strcmp(value, "json") == 0) {
+				config.format = victor::WorkloadConfig::json;
+			} else if (strcmp(value, "msgpack") == 0) {
+				config.format = victor::WorkloadConfig::msgpack;
+			} else if (strcmp(value, "cbor") == 0) {
+				config.format = victor::WorkloadConfig::cbor;
+			} else {
+				ok = false;
+			}
+		} else {
+			std::cout << "Unknown option: " << option << std::endl;
+			usage();
+			return 1;
+		}
+		if (!ok) {
+			std::cout << "Bad value: " << option << std::endl;
+			return 1;
+		}
+	}
+	if (argc - arg != 1) {
+		usage();
+		return 1;
+	}
+
+	std::ofstream file;
+	std::ostream* os = &std::cout;
+	if (strcmp(argv[arg], "-") != 0) {
+		file.open(argv[arg], std::ofstream::binary);
+		if (!file) {
+			std::cout << "Cannot open " << argv[arg] << std::endl;
+			return 1;
+		}
+		os = &file;
+	}
+	std::ios::sync_with_stdio(false);
+	{
+		victor::WorkloadGenerator generator(config);
+		victor::OutputBuffer out(*os, 1 << 20);
+		generator.generate(records, out);
+	}
+	os->flush();
+	return *os ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_json_object.cpp
+
+    Purpose:
+
+    Compares the cost of parsing a Venmo record into a DOM and looking up
+    its "actor", with json (objects are std::map) and flat_json (objects
+    are nlohmann::flat_map), both with json::parse and with a
+    reusable_parser.
+
+    Usage: bench_json_object [input file] [records]
+
+    @author Victor Chen
+*/
+#include "json/json.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+	Parse and look up every record, num_records in total; report ns/record.
+*/
+template<typename Json>
+void run(char const* what, std::vector<std::string> const& lines,
+		 size_t num_records, bool reuse) {
+	typename Json::reusable_parser parser;
+	Json j;
+	size_t found = 0;
+	Clock::time_point const start = Clock::now();
+	for (size_t i = 0; i < num_records; ++i) {
+		std::string const& line = lines[i % lines.size()];
+		if (reuse) {
+			parser.parse(line, j);
+		} else {
+			j = Json::parse(line);
+		}
+		found += j.find("actor") != j.end();
+	}
+	double const ns = std::chrono::duration<double, std::nano>(
+		Clock::now() - start).count();
+	printf("%-32s %8.1f ns/record (%zu found)\n", what,
+		   ns / double(num_records), found);
+
+	// lookups alone, on the last record
+	Clock::time_point const find_start = Clock::now();
+	for (size_t i = 0; i < num_records; ++i) {
+		found += j.find(i % 2 ? "actor" : "target") != j.end();
+	}
+	double const find_ns = std::chrono::duration<double, std::nano>(
+		Clock::now() - find_start).count();
+	printf("%-32s %8.1f ns/find (%zu)\n", "  find", find_ns / double(num_records),
+		   found);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	char const* filename = argc > 1 ? argv[1] : "../data-gen/venmo-trans.txt";
+	size_t const num_records = argc > 2 ? size_t(atol(argv[2])) : 500000;
+
+	std::ifstream ifs(filename);
+	std::vector<std::string> lines;
+	std::string line;
+	while (std::getline(ifs, line)) {
+		lines.push_back(line);
+	}
+	if (lines.empty()) {
+		fprintf(stderr, "can't read %s\n", filename);
+		return 1;
+	}
+
+	run<nlohmann::json>("json (std::map) parse", lines, num_records, false);
+	run<nlohmann::flat_json>("flat_json parse", lines, num_records, false);
+	run<nlohmann::json>("json (std::map) reusable_parser", lines, num_records,
+						true);
+	run<nlohmann::flat_json>("flat_json reusable_parser", lines, num_records,
+							 true);
+	return 0;
+}
@@ -0,0 +1,351 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_med_heap_map.cpp
+
+    Purpose:
+
+    Measures MedHeapMap operations one kind at a time: insert,
+    increase_key, process_edge, median, decrease_key, and decrease_key at
+    degree 1, which erases ("erase"), on heaps of 1k to 10M vertices. The
+    vertices an operation touches are drawn uniformly, or skewed by a Zipf
+    law the way payments are. Each run reports ns/op, cache misses/op
+    (where perf_event_open is allowed) and allocations/op.
+
+    The engine is a template parameter: anything with MedHeapMap's API as
+    VenmoGraph uses it (typedef Id, insert(std::string),
+    increase_key(std::string const&), find(), decrease_key(Id),
+    process_edge(), median() and size()) can be measured by adding a line
+    to main().
+
+    Usage: bench_med_heap_map [max vertices] [min ops]
+
+    @author Victor Chen
+*/
+#include "victor/med_heap_map.hpp"
+#include "victor/workload.hpp"
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+size_t num_allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+	++num_allocations;
+	if (void* p = malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+	Hardware cache misses of this thread, in user space, if the kernel lets
+	us count them.
+*/
+class CacheMisses {
+private:
+	int _fd;
+
+public:
+	CacheMisses() {
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		_fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+
+	~CacheMisses() {
+		if (_fd >= 0) {
+			close(_fd);
+		}
+	}
+
+	CacheMisses(CacheMisses const&) = delete;
+	CacheMisses& operator=(CacheMisses const&) = delete;
+
+	bool available() const {
+		return _fd >= 0;
+	}
+
+	void start() {
+		if (_fd >= 0) {
+			ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+
+	/**
+		@return the misses since start(), or 0 if they can't be counted.
+	*/
+	uint64_t stop() {
+		uint64_t count = 0;
+		if (_fd >= 0) {
+			ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(_fd, &count, sizeof(count)) != ssize_t(sizeof(count))) {
+				count = 0;
+			}
+		}
+		return count;
+	}
+};
+
+/**
+	Time, cache misses and allocations of one kind of operation.
+*/
+class Measurement {
+private:
+	CacheMisses& _misses;
+	Clock::time_point _start;
+	size_t _allocations;
+	double _ns = 0;
+	uint64_t _num_misses = 0;
+	size_t _num_allocations = 0;
+
+public:
+	explicit Measurement(CacheMisses& misses) : _misses(misses) {}
+
+	void start() {
+		_allocations = num_allocations;
+		_misses.start();
+		_start = Clock::now();
+	}
+
+	void stop() {
+		Clock::time_point const end = Clock::now();
+		_num_misses += _misses.stop();
+		_num_allocations += num_allocations - _allocations;
+		_ns += std::chrono::duration<double, std::nano>(end - _start).count();
+	}
+
+	void report(char const* op, size_t num_vertices, char const* dist,
+				size_t num_ops) const {
+		printf("%-12s %9zu %-8s %8.1f ns/op", op, num_vertices, dist,
+			   _ns / double(num_ops));
+		if (_misses.available()) {
+			printf(" %7.2f misses/op", double(_num_misses) / double(num_ops));
+		} else {
+			printf(" %7s misses/op", "-");
+		}
+		printf(" %6.2f allocs/op\n", double(_num_allocations) / double(num_ops));
+	}
+};
+
+/**
+	Draws the vertices operations touch.
+*/
+class Picker {
+private:
+	victor::Random _random;
+	victor::ZipfSampler _zipf;
+	size_t _n;
+	uint64_t _stride;
+
+	static uint64_t gcd(uint64_t a, uint64_t b) {
+		return b == 0 ? a : gcd(b, a % b);
+	}
+
+public:
+	/**
+		@param skew Zipf exponent; 0 is uniform.
+	*/
+	Picker(size_t n, double skew, uint64_t seed)
+		: _random(seed), _zipf(n, skew), _n(n) {
+		// scatter the popular vertices, as a NameTable would
+		_stride = 2654435761u % n;
+		while (_stride == 0 || gcd(_stride, n) != 1) {
+			++_stride;
+		}
+	}
+
+	size_t operator()() {
+		return size_t((_zipf(_random) - 1) * _stride % _n);
+	}
+};
+
+/**
+	Run every operation on an Engine of num_vertices vertices, at least
+	min_ops times each.
+*/
+template<typename Engine>
+void run(std::vector<std::string> const& names, size_t num_vertices,
+		 char const* dist, double skew, size_t min_ops, CacheMisses& misses) {
+	typedef typename Engine::Id Id;
+	size_t const num_ops = num_vertices > min_ops ? num_vertices : min_ops;
+	std::vector<uint32_t> degrees(num_vertices, 1);
+	std::vector<size_t> picks(num_ops);
+	Picker pick(num_vertices, skew, num_vertices);
+	double sink = 0;
+
+	// insert: build fresh engines until there have been enough inserts
+	std::unique_ptr<Engine> engine;
+	{
+		Measurement m(misses);
+		size_t done = 0;
+		while (done < num_ops) {
+			engine.reset(new Engine);
+			m.start();
+			for (size_t i = 0; i < num_vertices; ++i) {
+				engine->insert(names[i]);
+			}
+			m.stop();
+			done += num_vertices;
+		}
+		m.report("insert", num_vertices, dist, done);
+	}
+
+	// increase_key: by name, as the public API has it
+	{
+		for (size_t& p : picks) {
+			p = pick();
+			++degrees[p];
+		}
+		Measurement m(misses);
+		m.start();
+		for (size_t p : picks) {
+			engine->increase_key(names[p]);
+		}
+		m.stop();
+		m.report("increase_key", num_vertices, dist, num_ops);
+	}
+
+	// process_edge: the names are copied, as VenmoGraph's are moved
+	{
+		for (size_t& p : picks) {
+			p = pick();
+		}
+		Measurement m(misses);
+		m.start();
+		for (size_t i = 0; i < num_ops; ++i) {
+			size_t const a = picks[i];
+			size_t b = picks[num_ops - 1 - i];
+			if (b == a) {
+				b = (b + 1) % num_vertices;
+			}
+			std::pair<Id, Id> const p = engine->process_edge(names[a], names[b]);
+			sink += double(p.first);
+		}
+		m.stop();
+		m.report("process_edge", num_vertices, dist, num_ops);
+		for (size_t i = 0; i < num_ops; ++i) {
+			size_t const a = picks[i];
+			size_t b = picks[num_ops - 1 - i];
+			++degrees[a];
+			++degrees[b == a ? (b + 1) % num_vertices : b];
+		}
+	}
+
+	// median
+	{
+		Measurement m(misses);
+		m.start();
+		for (size_t i = 0; i < num_ops; ++i) {
+			sink += engine->median();
+		}
+		m.stop();
+		m.report("median", num_vertices, dist, num_ops);
+	}
+
+	// decrease_key: by id, as VenmoGraph expires edges; no vertex reaches 0
+	std::vector<Id> ids(num_vertices);
+	for (size_t i = 0; i < num_vertices; ++i) {
+		ids[i] = engine->find(names[i]);
+	}
+	{
+		std::vector<Id> targets;
+		for (size_t i = 0; i < num_ops; ++i) {
+			size_t const p = pick();
+			if (degrees[p] > 1) {
+				--degrees[p];
+				targets.push_back(ids[p]);
+			}
+		}
+		Measurement m(misses);
+		size_t kept = 0;
+		m.start();
+		for (Id t : targets) {
+			kept += engine->decrease_key(t);
+		}
+		m.stop();
+		m.report("decrease_key", num_vertices, dist, targets.size());
+		if (kept != targets.size()) {
+			printf("decrease_key erased %zu vertices\n", targets.size() - kept);
+		}
+	}
+
+	// erase: decrease_key at degree 1, after bringing every vertex down to
+	// it, in the order of a shuffle
+	{
+		for (size_t i = 0; i < num_vertices; ++i) {
+			for (; degrees[i] > 1; --degrees[i]) {
+				engine->decrease_key(ids[i]);
+			}
+		}
+		victor::Random random(num_vertices);
+		for (size_t i = num_vertices - 1; i > 0; --i) {
+			std::swap(ids[i], ids[random.below(i + 1)]);
+		}
+		Measurement m(misses);
+		size_t kept = 0;
+		m.start();
+		for (Id id : ids) {
+			kept += engine->decrease_key(id);
+		}
+		m.stop();
+		m.report("erase", num_vertices, dist, num_vertices);
+		if (kept != 0 || engine->size() != 0) {
+			printf("erase left %zu vertices\n", engine->size());
+		}
+	}
+
+	if (sink == 0.5) {
+		printf("%f\n", sink);
+	}
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	size_t const max_vertices = argc > 1 ? size_t(atol(argv[1])) : 10000000;
+	size_t const min_ops = argc > 2 ? size_t(atol(argv[2])) : 1000000;
+
+	CacheMisses misses;
+	if (!misses.available()) {
+		printf("perf_event_open is not allowed here; cache misses not counted\n");
+	}
+
+	std::vector<std::string> names;
+	for (size_t n = 1000; n <= max_vertices; n *= 10) {
+		while (names.size() < n) {
+			names.push_back("user-" + std::to_string(names.size()));
+		}
+		run<victor::MedHeapMap>(names, n, "uniform", 0, min_ops, misses);
+		run<victor::MedHeapMap>(names, n, "zipf", 1.0, min_ops, misses);
+	}
+	return 0;
+}
@@ -0,0 +1,85 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_memory.cpp
+
+    Purpose:
+
+    Reports the memory VenmoGraph holds, per live edge and per live vertex,
+    at several scales. Payments from a generated workload (see
+    src/victor/workload.hpp) arrive 100 a second, then ten times as fast, up
+    to a maximum rate (10000 unless given), so the 60-second window takes
+    in some 6k payments, then 60k, and so on. Each scale runs for two
+    windows, so that the graph is in its steady state, expiring as many
+    edges as it adds, before it is measured; there are ten users for every
+    payment in the window.
+
+    For each scale it prints VenmoGraph::memory_usage() part by part, and
+    checks its total against what malloc reports as handed out
+    (mallinfo2()) over the life of the graph.
+
+    Usage: bench_memory [max rate]
+
+    @author Victor Chen
+*/
+#include "victor/memory_usage.hpp"
+#include "victor/venmo_graph.hpp"
+#include "victor/workload.hpp"
+#include <malloc.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+namespace {
+
+volatile double checksum;
+
+size_t heap_in_use() {
+	struct mallinfo2 const info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	double const max_rate = argc > 1 ? atof(argv[1]) : 10000;
+
+	for (double rate = 100; rate <= max_rate; rate *= 10) {
+		uint64_t const window_edges = uint64_t(rate * 60);
+		victor::WorkloadConfig config;
+		config.rate = rate;
+		config.num_users = 10 * window_edges;
+		victor::WorkloadGenerator generator(config);
+		victor::WorkloadGenerator::Event e;
+		char actor[64];
+		char target[64];
+
+		size_t const before = heap_in_use();
+		victor::VenmoGraph* const graph = new victor::VenmoGraph;
+		for (uint64_t i = 0; i < 2 * window_edges; ++i) {
+			generator.next(e);
+			checksum = graph->extract_median(
+				std::string(actor, victor::WorkloadGenerator::user_name(actor, e.actor)),
+				std::string(target, victor::WorkloadGenerator::user_name(target, e.target)),
+				e.created_time);
+		}
+		size_t const malloc_bytes = heap_in_use() - before;
+		victor::MemoryUsage const m = graph->memory_usage();
+		double const edges = double(graph->num_edges());
+		double const vertices = double(graph->num_vertices());
+
+		printf("%7.0f payments/s: %9.0f edges %9.0f vertices\n", rate, edges, vertices);
+		for (victor::MemoryUsage::Part const& p : m.parts()) {
+			printf("  %-14s %12zu bytes %7.1f per edge %7.1f per vertex\n",
+				   p.name, p.bytes, double(p.bytes) / edges, double(p.bytes) / vertices);
+		}
+		printf("  %-14s %12zu bytes %7.1f per edge %7.1f per vertex\n", "total",
+			   m.total(), double(m.total()) / edges, double(m.total()) / vertices);
+		printf("  %-14s %12zu bytes %7.1f per edge (%+.1f%% unaccounted for)\n",
+			   "malloc", malloc_bytes, double(malloc_bytes) / edges,
+			   100.0 * (double(malloc_bytes) - double(m.total())) / double(malloc_bytes));
+		fflush(stdout);
+		delete graph;
+	}
+	return 0;
+}
@@ -0,0 +1,95 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_number_parse.cpp
+
+    Purpose:
+
+    Compares nlohmann::float_parser with strtod on the kinds of numbers
+    that show up in records (amounts, ids, epoch timestamps, and full
+    precision doubles), and times json::parse on an array of each kind.
+
+    Usage: bench_number_parse [numbers]
+
+    @author Victor Chen
+*/
+#include "json/json.hpp"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsed_ns(Clock::time_point start) {
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+	Convert every number with strtod and with float_parser, then parse them
+	all as one JSON array; report ns/number for each.
+*/
+void run(char const* what, std::vector<std::string> const& numbers) {
+	double sum = 0;
+	Clock::time_point start = Clock::now();
+	for (std::string const& s : numbers) {
+		sum += strtod(s.c_str(), nullptr);
+	}
+	double const strtod_ns = elapsed_ns(start);
+
+	start = Clock::now();
+	for (std::string const& s : numbers) {
+		sum += nlohmann::float_parser::parse(s.data(), s.data() + s.size());
+	}
+	double const fast_ns = elapsed_ns(start);
+
+	std::string array = "[";
+	for (std::string const& s : numbers) {
+		array += s;
+		array += ',';
+	}
+	array.back() = ']';
+	start = Clock::now();
+	nlohmann::json const j = nlohmann::json::parse(array);
+	double const parse_ns = elapsed_ns(start);
+
+	double const n = double(numbers.size());
+	printf("%-12s strtod %6.1f  float_parser %6.1f  json::parse %6.1f ns/number"
+		   " (%g, %zu)\n", what, strtod_ns / n, fast_ns / n, parse_ns / n, sum,
+		   j.size());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	size_t const count = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+	std::mt19937_64 rng(1);
+	char buf[64];
+	std::vector<std::string> amounts, ids, timestamps, doubles;
+	for (size_t i = 0; i < count; ++i) {
+		snprintf(buf, sizeof(buf), "%llu.%02llu",
+				 (unsigned long long)(rng() % 10000),
+				 (unsigned long long)(rng() % 100));
+		amounts.push_back(buf);
+		snprintf(buf, sizeof(buf), "%llu", (unsigned long long)(rng() >> 1));
+		ids.push_back(buf);
+		snprintf(buf, sizeof(buf), "%llu",
+				 (unsigned long long)(1400000000 + rng() % 100000000));
+		timestamps.push_back(buf);
+		uint64_t bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		snprintf(buf, sizeof(buf), "%.17g", std::isfinite(d) ? d : 1.0);
+		doubles.push_back(buf);
+	}
+	run("amounts", amounts);
+	run("ids", ids);
+	run("timestamps", timestamps);
+	run("doubles", doubles);
+	return 0;
+}
@@ -0,0 +1,121 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_output_sink.cpp
+
+    Purpose:
+
+    Compares the cost of writing one event of output: the median through
+    iostream (how it used to be written) and through TextSink, and the
+    whole event as a JSON line through JsonLinesSink and through a json
+    object's dump().
+
+    Usage: bench_output_sink [events]
+
+    @author Victor Chen
+*/
+#include "victor/output_sink.hpp"
+#include "json/json.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+using victor::MedianEvent;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+	Stream buffer that only counts what is written to it.
+*/
+class CountingBuf : public std::streambuf {
+public:
+	size_t count = 0;
+
+protected:
+	int overflow(int c) override {
+		++count;
+		return c;
+	}
+
+	std::streamsize xsputn(char const*, std::streamsize n) override {
+		count += size_t(n);
+		return n;
+	}
+};
+
+/**
+	Write every event, num_events in total, with write(os, e); report
+	ns/event and bytes/event.
+*/
+template<typename Write>
+void run(char const* what, std::vector<MedianEvent> const& events,
+		 size_t num_events, Write write) {
+	CountingBuf buf;
+	std::ostream os(&buf);
+	Clock::time_point const start = Clock::now();
+	write(os, events, num_events);
+	os.flush();
+	double const ns = std::chrono::duration<double, std::nano>(
+		Clock::now() - start).count();
+	printf("%-24s %8.1f ns/event %6.1f bytes/event\n", what,
+		   ns / double(num_events), double(buf.count) / double(num_events));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	size_t const num_events = argc > 1 ? size_t(atol(argv[1])) : 2000000;
+
+	// medians of degrees are multiples of 1/2
+	std::vector<MedianEvent> events(4096);
+	for (size_t i = 0; i < events.size(); ++i) {
+		events[i].created_time = time_t(1459207392 + i);
+		events[i].median = double(1 + i % 7) / 2;
+		events[i].num_vertices = 1000 + i % 100;
+		events[i].num_edges = 3000 + i % 300;
+	}
+
+	typedef std::vector<MedianEvent> Events;
+	run("iostream median", events, num_events,
+		[](std::ostream& os, Events const& ev, size_t n) {
+			os.setf(std::ios::fixed, std::ios::floatfield);
+			os.precision(2);
+			for (size_t i = 0; i < n; ++i) {
+				os << ev[i % ev.size()].median << '\n';
+			}
+		});
+	run("TextSink", events, num_events,
+		[](std::ostream& os, Events const& ev, size_t n) {
+			victor::TextSink sink(os);
+			for (size_t i = 0; i < n; ++i) {
+				sink.write(ev[i % ev.size()]);
+			}
+		});
+	run("JsonLinesSink", events, num_events,
+		[](std::ostream& os, Events const& ev, size_t n) {
+			victor::JsonLinesSink<MedianEvent> sink(os);
+			for (size_t i = 0; i < n; ++i) {
+				sink.write(ev[i % ev.size()]);
+			}
+		});
+	run("json dump", events, num_events,
+		[](std::ostream& os, Events const& ev, size_t n) {
+			char time[32];
+			for (size_t i = 0; i < n; ++i) {
+				MedianEvent const& e = ev[i % ev.size()];
+				nlohmann::json j;
+				j["created_time"] = std::string(time,
+					victor::NumberFormat::iso_time(time, e.created_time));
+				j["median"] = e.median;
+				j["vertices"] = e.num_vertices;
+				j["edges"] = e.num_edges;
+				os << j.dump() << '\n';
+			}
+		});
+	return 0;
+}
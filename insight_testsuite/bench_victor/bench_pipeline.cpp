@@ -0,0 +1,285 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_pipeline.cpp
+
+    Purpose:
+
+    Runs MedDegStream end to end over generated workloads (see
+    src/victor/workload.hpp) of 100k records, then ten times as many, up to
+    a maximum. Payments arrive 1000 a second, so the window holds some 60k
+    edges. For each size it reports:
+
+    - records/sec of MedDegStream::process(), input file to output file;
+    - per-record latency percentiles: the time between one median being
+      written and the next, which covers reading, parsing and the graph
+      update of every record in between (skipped records included);
+    - peak RSS of the run, reset before it through /proc/self/clear_refs
+      where the kernel allows that;
+    - time per stage: reading blocks, indexing lines, parsing records,
+      updating the graph and writing medians. These come from running the
+      pipeline cut short after each stage, as process_json() would run it,
+      and taking differences.
+
+    Each size is also appended to a results file as one JSON object per
+    line, with a label (such as the commit) so that runs on the same
+    machine can be compared.
+
+    Usage: bench_pipeline [max records] [results file] [label]
+
+    @author Victor Chen
+*/
+#include "victor/med_deg_stream.hpp"
+#include "victor/workload.hpp"
+#include "json/json.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using victor::MedianEvent;
+
+typedef std::chrono::steady_clock Clock;
+
+char const* const input_filename = "bench_pipeline_input.txt";
+char const* const output_filename = "bench_pipeline_output.txt";
+
+volatile double checksum;
+
+double seconds_since(Clock::time_point start) {
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+	Reset the peak RSS of this process to its current RSS.
+
+	@return false if the kernel doesn't allow it.
+*/
+bool reset_peak_rss() {
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5";
+	clear_refs.flush();
+	return bool(clear_refs);
+}
+
+/**
+	@return the peak RSS of this process, in KiB.
+*/
+long peak_rss_kb() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return atol(line.c_str() + 6);
+		}
+	}
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+/**
+	Sink that writes medians as text and keeps the time between writes.
+*/
+class LatencySink {
+private:
+	victor::TextSink _text;
+	std::vector<uint32_t>& _ns;
+	Clock::time_point _last;
+
+public:
+	LatencySink(std::ostream& os, std::vector<uint32_t>& ns)
+		: _text(os), _ns(ns), _last(Clock::now()) {}
+
+	void write(MedianEvent const& e) {
+		_text.write(e);
+		Clock::time_point const now = Clock::now();
+		int64_t const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			now - _last).count();
+		_ns.push_back(uint32_t(std::min<int64_t>(ns, 0xffffffff)));
+		_last = now;
+	}
+
+	void flush() {
+		_text.flush();
+	}
+};
+
+/**
+	How far to run the pipeline.
+*/
+enum Stage {
+	read_stage,
+	index_stage,
+	parse_stage,
+	graph_stage,
+	num_stages
+};
+
+char const* const stage_names[] = { "read", "index", "parse", "graph", "output" };
+
+/**
+	Run the pipeline of MedDegStream::process_json() up to a stage.
+
+	@return a checksum, so that nothing is optimized away.
+*/
+double run_to(Stage stage) {
+	victor::LineReader lines(victor::CompressedInput::open(input_filename));
+	victor::StructuralIndex index;
+	victor::VenmoRecordReader reader;
+	victor::VenmoRecord rec;
+	victor::VenmoGraph graph;
+	double sum = 0;
+	char const* block;
+	char const* block_end;
+	while (lines.next_block(block, block_end)) {
+		if (stage == read_stage) {
+			sum += double(block_end - block);
+			continue;
+		}
+		index.build(block, block_end);
+		char const* first;
+		char const* last;
+		uint32_t const* pos;
+		uint32_t const* pos_end;
+		while (index.next_line(first, last, pos, pos_end)) {
+			if (stage == index_stage) {
+				sum += double(last - first);
+				continue;
+			}
+			victor::VenmoRecordReader::Status const status =
+				reader.read(first, last, block, pos, pos_end, rec);
+			if (status != victor::VenmoRecordReader::ok) {
+				continue;
+			}
+			if (stage == parse_stage) {
+				sum += double(rec.created_time);
+				continue;
+			}
+			sum += graph.extract_median(rec.actor, rec.target, rec.created_time);
+		}
+	}
+	return sum;
+}
+
+/**
+	@return the q-th quantile of the latencies, which are reordered.
+*/
+uint32_t quantile(std::vector<uint32_t>& ns, double q) {
+	if (ns.empty()) {
+		return 0;
+	}
+	size_t const i = std::min(ns.size() - 1, size_t(q * double(ns.size())));
+	std::nth_element(ns.begin(), ns.begin() + ptrdiff_t(i), ns.end());
+	return ns[i];
+}
+
+std::string now_iso() {
+	char buf[64];
+	return std::string(buf, victor::NumberFormat::iso_time(buf, time(nullptr)));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	uint64_t const max_records = argc > 1 ? uint64_t(atoll(argv[1])) : 10000000;
+	char const* const results_filename = argc > 2 ? argv[2] : "bench_pipeline.jsonl";
+	std::string const label = argc > 3 ? argv[3] : "";
+
+	std::ofstream results(results_filename, std::ofstream::app);
+	// MedDegStream reports skipped records on cout
+	std::streambuf* const cout_buf = std::cout.rdbuf(nullptr);
+
+	for (uint64_t num_records = 100000; num_records <= max_records;
+		 num_records *= 10) {
+		{
+			victor::WorkloadConfig config;
+			config.rate = 1000;
+			std::ofstream ofs(input_filename, std::ofstream::binary);
+			victor::OutputBuffer out(ofs, 1 << 20);
+			victor::WorkloadGenerator generator(config);
+			generator.generate(num_records, out);
+		}
+
+		// throughput and peak RSS
+		bool const rss_reset = reset_peak_rss();
+		Clock::time_point start = Clock::now();
+		{
+			victor::MedDegStream mds(input_filename, output_filename);
+			mds.process();
+		}
+		double const total_seconds = seconds_since(start);
+		long const rss_kb = peak_rss_kb();
+
+		// latency
+		std::vector<uint32_t> ns;
+		ns.reserve(num_records);
+		{
+			std::ofstream ofs(output_filename);
+			LatencySink sink(ofs, ns);
+			victor::MedDegStream mds(input_filename, "/dev/null");
+			mds.process(sink);
+		}
+		uint32_t const max_ns = ns.empty() ? 0 : *std::max_element(ns.begin(), ns.end());
+		uint32_t const p50 = quantile(ns, 0.5);
+		uint32_t const p99 = quantile(ns, 0.99);
+		uint32_t const p999 = quantile(ns, 0.999);
+
+		// stages
+		double cumulative[num_stages + 1];
+		for (int stage = read_stage; stage < num_stages; ++stage) {
+			start = Clock::now();
+			checksum = run_to(Stage(stage));
+			cumulative[stage] = seconds_since(start);
+		}
+		cumulative[num_stages] = total_seconds;
+
+		nlohmann::json r;
+		r["date"] = now_iso();
+		r["label"] = label;
+		r["records"] = num_records;
+		r["seconds"] = total_seconds;
+		r["records_per_sec"] = double(num_records) / total_seconds;
+		r["latency_ns"]["p50"] = p50;
+		r["latency_ns"]["p99"] = p99;
+		r["latency_ns"]["p99.9"] = p999;
+		r["latency_ns"]["max"] = max_ns;
+		r["peak_rss_kb"] = rss_kb;
+		r["peak_rss_reset"] = rss_reset;
+		double previous = 0;
+		for (int stage = read_stage; stage <= num_stages; ++stage) {
+			// a stage can't take less than nothing, whatever the noise
+			double const t = std::max(0.0, cumulative[stage] - previous);
+			r["stage_seconds"][stage_names[stage]] = t;
+			previous = std::max(previous, cumulative[stage]);
+		}
+		results << r.dump() << std::endl;
+
+		printf("%10llu records %10.0f records/s  latency p50 %5u p99 %6u "
+			   "p99.9 %7u max %9u ns  peak RSS %7ld KiB%s\n",
+			   (unsigned long long)num_records, double(num_records) / total_seconds,
+			   p50, p99, p999, max_ns, rss_kb, rss_reset ? "" : " (not reset)");
+		printf("%10s stages:", "");
+		for (int stage = read_stage; stage <= num_stages; ++stage) {
+			printf(" %s %.3f s", stage_names[stage],
+				   r["stage_seconds"][stage_names[stage]].get<double>());
+		}
+		printf("\n");
+		fflush(stdout);
+	}
+
+	std::cout.rdbuf(cout_buf);
+	std::cout.clear();
+	remove(input_filename);
+	remove(output_filename);
+	printf("results appended to %s\n", results_filename);
+	return 0;
+}
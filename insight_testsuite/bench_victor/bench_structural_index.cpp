@@ -0,0 +1,140 @@
+/**
+    Insight Data Engineering Code Challenge
+    bench_structural_index.cpp
+
+    Purpose:
+
+    Measures the throughput, in GB/s, of StructuralIndex::build() with each
+    kernel the CPU supports, and of reading Venmo records (actor, target,
+    created_time) from a buffer of newline-delimited JSON, by parsing each
+    line and by walking the structural index.
+
+    Usage: bench_structural_index [input file] [MiB]
+
+    The input (data-gen/venmo-trans.txt by default) is repeated until the
+    buffer is the given size (64 MiB by default).
+
+    @author Victor Chen
+*/
+#include "victor/structural_index.hpp"
+#include "victor/venmo_record.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace victor;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+	Best time of a few runs of f, in seconds.
+*/
+template<typename F>
+double best_of(int runs, F f) {
+	double best = 1e30;
+	for (int i = 0; i < runs; ++i) {
+		Clock::time_point const start = Clock::now();
+		f();
+		double const s =
+			std::chrono::duration<double>(Clock::now() - start).count();
+		if (s < best) {
+			best = s;
+		}
+	}
+	return best;
+}
+
+void report(char const* what, size_t bytes, size_t records, double seconds) {
+	printf("%-28s %8.3f GB/s", what, double(bytes) / seconds / 1e9);
+	if (records != 0) {
+		printf(" %8.2f M records/s", double(records) / seconds / 1e6);
+	}
+	printf("\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	char const* filename = argc > 1 ? argv[1] : "../data-gen/venmo-trans.txt";
+	size_t const mib = argc > 2 ? size_t(atoi(argv[2])) : 64;
+
+	std::ifstream ifs(filename, std::ifstream::binary);
+	std::stringstream ss;
+	ss << ifs.rdbuf();
+	std::string const sample = ss.str();
+	if (sample.empty()) {
+		fprintf(stderr, "can't read %s\n", filename);
+		return 1;
+	}
+	std::string buf;
+	buf.reserve(mib << 20);
+	while (buf.size() < (mib << 20)) {
+		buf += sample;
+		if (buf.back() != '\n') {
+			buf += '\n';
+		}
+	}
+	char const* const first = buf.data();
+	char const* const last = first + buf.size();
+	printf("%s: %zu MiB\n", filename, buf.size() >> 20);
+
+	for (int k = StructuralIndex::scalar_kernel;
+		 k <= StructuralIndex::avx2_kernel; ++k) {
+		StructuralIndex::Kernel const kernel = StructuralIndex::Kernel(k);
+		if (!StructuralIndex::supported(kernel)) {
+			continue;
+		}
+		StructuralIndex index(kernel);
+		double const s = best_of(5, [&] { index.build(first, last); });
+		std::string const what = std::string("index (") +
+			StructuralIndex::kernel_name(kernel) + ")";
+		report(what.c_str(), buf.size(), 0, s);
+	}
+
+	VenmoRecordReader reader;
+	VenmoRecord rec;
+	size_t records = 0;
+	size_t checksum = 0;
+	double const parsed = best_of(3, [&] {
+		records = 0;
+		for (char const* line = first; line != last;) {
+			char const* eol = static_cast<char const*>(
+				memchr(line, '\n', size_t(last - line)));
+			if (reader.read(line, eol, rec) == VenmoRecordReader::ok) {
+				++records;
+				checksum += size_t(rec.created_time);
+			}
+			line = eol + 1;
+		}
+	});
+	report("records (sax_parse)", buf.size(), records, parsed);
+
+	StructuralIndex index;
+	double const walked = best_of(3, [&] {
+		records = 0;
+		index.build(first, last);
+		char const* line;
+		char const* eol;
+		uint32_t const* pos;
+		uint32_t const* pos_end;
+		while (index.next_line(line, eol, pos, pos_end)) {
+			if (reader.read(line, eol, first, pos, pos_end, rec) ==
+				VenmoRecordReader::ok) {
+				++records;
+				checksum += size_t(rec.created_time);
+			}
+		}
+	});
+	std::string const what = std::string("records (index, ") +
+		StructuralIndex::kernel_name(index.kernel()) + ")";
+	report(what.c_str(), buf.size(), records, walked);
+
+	printf("checksum %zu\n", checksum);
+	return 0;
+}
@@ -0,0 +1,331 @@
+#include "victor/binary_record.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+using json = nlohmann::json;
+
+/**
+	Append an integer of n bytes, big-endian.
+*/
+void put(std::string& out, uint64_t v, int n) {
+	for (int i = n - 1; i >= 0; --i) {
+		out += char((v >> (8 * i)) & 0xff);
+	}
+}
+
+/**
+	Append a MessagePack encoding of a json value.
+*/
+void to_msgpack(json const& j, std::string& out) {
+	switch (j.type()) {
+	case json::value_t::object:
+		out += char(0xde);
+		put(out, j.size(), 2);
+		for (auto it = j.begin(); it != j.end(); ++it) {
+			to_msgpack(it.key(), out);
+			to_msgpack(it.value(), out);
+		}
+		break;
+	case json::value_t::array:
+		out += char(0xdc);
+		put(out, j.size(), 2);
+		for (auto const& e : j) {
+			to_msgpack(e, out);
+		}
+		break;
+	case json::value_t::string: {
+		std::string const s = j;
+		out += char(0xdb);
+		put(out, s.size(), 4);
+		out += s;
+		break;
+	}
+	case json::value_t::number_unsigned:
+		out += char(0xcf);
+		put(out, j.get<uint64_t>(), 8);
+		break;
+	case json::value_t::number_integer:
+		out += char(0xd3);
+		put(out, uint64_t(j.get<int64_t>()), 8);
+		break;
+	case json::value_t::number_float: {
+		double const d = j;
+		uint64_t bits;
+		memcpy(&bits, &d, sizeof(d));
+		out += char(0xcb);
+		put(out, bits, 8);
+		break;
+	}
+	case json::value_t::boolean:
+		out += char(j.get<bool>() ? 0xc3 : 0xc2);
+		break;
+	default:
+		out += char(0xc0);
+		break;
+	}
+}
+
+/**
+	Append a CBOR item header.
+*/
+void cbor_head(std::string& out, unsigned major, uint64_t v) {
+	if (v < 24) {
+		out += char(major << 5 | v);
+	} else {
+		out += char(major << 5 | 27);
+		put(out, v, 8);
+	}
+}
+
+/**
+	Append a CBOR encoding of a json value. Objects are written with
+	indefinite length, to exercise that path.
+*/
+void to_cbor(json const& j, std::string& out) {
+	switch (j.type()) {
+	case json::value_t::object:
+		out += char(0xbf);
+		for (auto it = j.begin(); it != j.end(); ++it) {
+			to_cbor(it.key(), out);
+			to_cbor(it.value(), out);
+		}
+		out += char(0xff);
+		break;
+	case json::value_t::array:
+		cbor_head(out, 4, j.size());
+		for (auto const& e : j) {
+			to_cbor(e, out);
+		}
+		break;
+	case json::value_t::string: {
+		std::string const s = j;
+		cbor_head(out, 3, s.size());
+		out += s;
+		break;
+	}
+	case json::value_t::number_unsigned:
+		cbor_head(out, 0, j.get<uint64_t>());
+		break;
+	case json::value_t::number_integer: {
+		int64_t const i = j;
+		cbor_head(out, i < 0 ? 1 : 0, i < 0 ? uint64_t(-1 - i) : uint64_t(i));
+		break;
+	}
+	case json::value_t::number_float: {
+		double const d = j;
+		uint64_t bits;
+		memcpy(&bits, &d, sizeof(d));
+		out += char(0xfb);
+		put(out, bits, 8);
+		break;
+	}
+	case json::value_t::boolean:
+		out += char(j.get<bool>() ? 0xf5 : 0xf4);
+		break;
+	default:
+		out += char(0xf6);
+		break;
+	}
+}
+
+std::string encode(BinaryRecordReader::Format format, json const& j) {
+	std::string out;
+	if (format == BinaryRecordReader::msgpack) {
+		to_msgpack(j, out);
+	} else {
+		to_cbor(j, out);
+	}
+	return out;
+}
+
+/**
+	Read one record that must take up all of buf.
+*/
+VenmoRecordReader::Status read_one(BinaryRecordReader::Format format,
+								   std::string const& buf, VenmoRecord& rec) {
+	BinaryRecordReader reader(format);
+	char const* next = nullptr;
+	VenmoRecordReader::Status status = VenmoRecordReader::malformed;
+	EXPECT_EQ(reader.read(buf.data(), buf.data() + buf.size(), next, rec,
+						  status), BinaryRecordReader::framed);
+	EXPECT_EQ(next, buf.data() + buf.size());
+	return status;
+}
+
+BinaryRecordReader::Format const formats[] = {
+	BinaryRecordReader::msgpack, BinaryRecordReader::cbor
+};
+
+TEST(BinaryRecordReaderTest, ReadsFields) {
+	json const j = json::parse("{\"amount\": 1.5, \"created_time\": "
+		"\"2016-03-28T23:23:12Z\", \"note\": {\"x\": [1, -2, null, true]}, "
+		"\"target\": \"Joey-Feste\", \"actor\": \"Ricardo-Lach\", "
+		"\"id\": 18446744073709551615}");
+	for (auto format : formats) {
+		VenmoRecord rec;
+		ASSERT_EQ(read_one(format, encode(format, j), rec), VenmoRecordReader::ok);
+		EXPECT_EQ(rec.actor, "Ricardo-Lach");
+		EXPECT_EQ(rec.target, "Joey-Feste");
+		EXPECT_EQ(rec.created_time, 1459207392);
+	}
+}
+
+TEST(BinaryRecordReaderTest, ReportsBadRecords) {
+	struct {
+		char const* record;
+		VenmoRecordReader::Status status;
+	} const cases[] = {
+		{ "[1, 2]", VenmoRecordReader::malformed },
+		{ "{\"target\": \"b\", \"created_time\": 5}",
+		  VenmoRecordReader::missing_actor },
+		{ "{\"actor\": 1, \"target\": \"b\", \"created_time\": 5}",
+		  VenmoRecordReader::bad_actor },
+		{ "{\"actor\": \"a\", \"target\": \"\", \"created_time\": 5}",
+		  VenmoRecordReader::empty_target },
+		{ "{\"actor\": \"a\", \"target\": \"b\", \"created_time\": \"\"}",
+		  VenmoRecordReader::empty_created_time },
+		{ "{\"actor\": \"a\", \"target\": \"b\", \"created_time\": \"noon\"}",
+		  VenmoRecordReader::bad_created_time },
+		{ "{\"actor\": \"a\", \"target\": \"b\", \"created_time\": 1459207392}",
+		  VenmoRecordReader::ok },
+		{ "{\"actor\": \"\\u00e9\", \"target\": \"b\", \"created_time\": 0}",
+		  VenmoRecordReader::ok },
+	};
+	for (auto format : formats) {
+		for (auto const& c : cases) {
+			VenmoRecord rec;
+			EXPECT_EQ(read_one(format, encode(format, json::parse(c.record)), rec),
+					  c.status) << c.record;
+		}
+		std::string bad_utf8 = encode(format, json::parse(
+			"{\"actor\": \"@\", \"target\": \"b\", \"created_time\": 0}"));
+		bad_utf8[bad_utf8.find('@')] = char(0xff);
+		VenmoRecord rec;
+		EXPECT_EQ(read_one(format, bad_utf8, rec), VenmoRecordReader::malformed);
+	}
+}
+
+TEST(BinaryRecordReaderTest, TimeEncodings) {
+	std::string const prefix_msgpack =
+		"\x83\xa5" "actor\xa1" "a\xa6" "target\xa1" "b\xac" "created_time";
+	std::string const prefix_cbor =
+		"\xa3\x65" "actor\x61" "a\x66" "target\x61" "b\x6c" "created_time";
+	struct {
+		BinaryRecordReader::Format format;
+		std::string time;
+		time_t expected;
+	} const cases[] = {
+		// timestamp 32, 64 (with nanoseconds) and 96
+		{ BinaryRecordReader::msgpack, std::string("\xd6\xff\x56\xf9\xbd\xe0", 6),
+		  1459207648 },
+		{ BinaryRecordReader::msgpack,
+		  std::string("\xd7\xff\x00\x00\x00\x04\x56\xf9\xbd\xe0", 10), 1459207648 },
+		{ BinaryRecordReader::msgpack,
+		  std::string("\xc7\x0c\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xfe", 15),
+		  -2 },
+		{ BinaryRecordReader::msgpack, std::string("\xd0\xfe", 2), -2 },
+		// tag 0 string, tag 1 integer and double
+		{ BinaryRecordReader::cbor, "\xc0\x74" "2016-03-28T23:27:28Z", 1459207648 },
+		{ BinaryRecordReader::cbor, std::string("\xc1\x1a\x56\xf9\xbd\xe0", 6),
+		  1459207648 },
+		{ BinaryRecordReader::cbor,
+		  std::string("\xc1\xfb\x41\xd5\xbe\x6f\x78\x20\x00\x00", 10), 1459207648 },
+	};
+	for (auto const& c : cases) {
+		std::string const buf = (c.format == BinaryRecordReader::msgpack
+			? prefix_msgpack : prefix_cbor) + c.time;
+		VenmoRecord rec;
+		ASSERT_EQ(read_one(c.format, buf, rec), VenmoRecordReader::ok);
+		EXPECT_EQ(rec.created_time, c.expected);
+	}
+}
+
+TEST(BinaryRecordReaderTest, FramesRecords) {
+	json const j = json::parse("{\"actor\": \"a\", \"target\": \"b\", "
+		"\"created_time\": \"2016-03-28T23:23:12Z\", \"x\": [[[\"deep\"]]]}");
+	for (auto format : formats) {
+		std::string const one = encode(format, j);
+		std::string const two = one + one;
+		BinaryRecordReader reader(format);
+		VenmoRecord rec;
+		VenmoRecordReader::Status status;
+		char const* next = nullptr;
+		for (size_t n = 0; n < one.size(); ++n) {
+			EXPECT_EQ(reader.read(two.data(), two.data() + n, next, rec, status),
+					  BinaryRecordReader::need_more) << n;
+		}
+		ASSERT_EQ(reader.read(two.data(), two.data() + two.size(), next, rec,
+							  status), BinaryRecordReader::framed);
+		EXPECT_EQ(next, two.data() + one.size());
+	}
+	std::string const unused_byte = "\xc1";
+	VenmoRecord rec;
+	VenmoRecordReader::Status status;
+	char const* next;
+	EXPECT_EQ(BinaryRecordReader(BinaryRecordReader::msgpack).read(
+		unused_byte.data(), unused_byte.data() + 1, next, rec, status),
+		BinaryRecordReader::corrupt);
+	std::string const huge = "\xdb\xff\xff\xff\xff";
+	EXPECT_EQ(BinaryRecordReader(BinaryRecordReader::msgpack).read(
+		huge.data(), huge.data() + huge.size(), next, rec, status),
+		BinaryRecordReader::corrupt) << "Absurd lengths should not be waited for.";
+}
+
+TEST(BinaryRecordReaderTest, MatchesJsonInput) {
+	char const* const json_in = "tests/test-1-venmo-trans/venmo_input/venmo-trans.txt";
+	std::ifstream ifs(json_in);
+	ASSERT_TRUE(ifs.is_open());
+	std::string msgpack_data;
+	std::string cbor_data;
+	std::string line;
+	while (std::getline(ifs, line)) {
+		json const j = json::parse(line);
+		to_msgpack(j, msgpack_data);
+		to_cbor(j, cbor_data);
+	}
+
+	struct {
+		MedDegStream::Format format;
+		std::string const& data;
+	} const inputs[] = {
+		{ MedDegStream::msgpack, msgpack_data },
+		{ MedDegStream::cbor, cbor_data },
+	};
+	{
+		MedDegStream mds(json_in, "binary_record_test_json.txt");
+		mds.process();
+	}
+	std::ifstream expected_ifs("binary_record_test_json.txt");
+	std::string const expected((std::istreambuf_iterator<char>(expected_ifs)),
+							   std::istreambuf_iterator<char>());
+	ASSERT_FALSE(expected.empty());
+	for (auto const& input : inputs) {
+		{
+			std::ofstream ofs("binary_record_test.bin", std::ofstream::binary);
+			ofs << input.data;
+		}
+		{
+			MedDegStream mds("binary_record_test.bin", "binary_record_test_out.txt",
+							 input.format);
+			mds.process();
+		}
+		std::ifstream actual_ifs("binary_record_test_out.txt");
+		std::string const actual((std::istreambuf_iterator<char>(actual_ifs)),
+								 std::istreambuf_iterator<char>());
+		EXPECT_EQ(actual, expected) << "Format " << input.format;
+	}
+	remove("binary_record_test_json.txt");
+	remove("binary_record_test.bin");
+	remove("binary_record_test_out.txt");
+}
+
+}  // namespace victor
\ No newline at end of file
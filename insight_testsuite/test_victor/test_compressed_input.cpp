@@ -0,0 +1,227 @@
+#include "victor/compressed_input.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <zlib.h>
+#ifdef VICTOR_ZSTD
+#include <zstd.h>
+#endif
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+
+namespace victor {
+
+/**
+	Lines of text that compress well, but not too well.
+*/
+std::string sample_text(size_t size) {
+	std::mt19937 rng(5);
+	std::string text;
+	while (text.size() < size) {
+		text += "{\"actor\": \"user-" + std::to_string(rng() % 1000) +
+			"\", \"target\": \"user-" + std::to_string(rng() % 1000) + "\"}\n";
+	}
+	return text;
+}
+
+/**
+	Compress with zlib.
+
+	@param window_bits 31 for a gzip member, -15 for raw deflate.
+*/
+std::string deflate(std::string const& text, int window_bits) {
+	z_stream z = z_stream();
+	deflateInit2(&z, 6, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
+	std::string out(deflateBound(&z, uLong(text.size())) + 32, '\0');
+	z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+	z.avail_in = uInt(text.size());
+	z.next_out = reinterpret_cast<Bytef*>(&out[0]);
+	z.avail_out = uInt(out.size());
+	deflate(&z, Z_FINISH);
+	out.resize(z.total_out);
+	deflateEnd(&z);
+	return out;
+}
+
+void put_le(std::string& out, uint32_t v, int n) {
+	for (int i = 0; i < n; ++i) {
+		out += char(v >> (8 * i));
+	}
+}
+
+/**
+	Compress as one BGZF member: a gzip member with its compressed size in
+	a "BC" extra field.
+*/
+std::string bgzf_member(std::string const& chunk) {
+	std::string const body = deflate(chunk, -15);
+	std::string out("\x1f\x8b\x08\x04\0\0\0\0\0\xff", 10);
+	put_le(out, 6, 2);
+	out += "BC";
+	put_le(out, 2, 2);
+	put_le(out, uint32_t(body.size() + 25), 2);
+	out += body;
+	put_le(out, uint32_t(crc32(0, reinterpret_cast<Bytef const*>(chunk.data()),
+							   uInt(chunk.size()))), 4);
+	put_le(out, uint32_t(chunk.size()), 4);
+	return out;
+}
+
+/**
+	Compress as BGZF: members of at most 64 KiB of text, then an empty one.
+*/
+std::string bgzf(std::string const& text) {
+	std::string out;
+	for (size_t i = 0; i < text.size(); i += 65280) {
+		out += bgzf_member(text.substr(i, 65280));
+	}
+	return out + bgzf_member("");
+}
+
+/**
+	Read everything from a CompressedInput over compressed data.
+*/
+std::string decompress(std::string const& data, CompressedInput::Codec codec,
+					   size_t buffer_size, bool& failed, unsigned num_workers = 0) {
+	std::unique_ptr<std::streambuf> file(new std::stringbuf(data));
+	CompressedInput in(std::move(file), codec, buffer_size, num_workers);
+	std::string out((std::istreambuf_iterator<char>(&in)),
+					std::istreambuf_iterator<char>());
+	failed = in.failed();
+	return out;
+}
+
+TEST(CompressedInputTest, DetectsCodec) {
+	EXPECT_EQ(CompressedInput::detect("\x1f\x8b\x08\x00", 4), CompressedInput::gzip);
+	EXPECT_EQ(CompressedInput::detect("\x28\xb5\x2f\xfd", 4), CompressedInput::zstd);
+	EXPECT_EQ(CompressedInput::detect("{\"ac", 4), CompressedInput::plain);
+	EXPECT_EQ(CompressedInput::detect("\x1f", 1), CompressedInput::plain);
+}
+
+TEST(CompressedInputTest, ReadsGzip) {
+	std::string const text = sample_text(3 << 20);
+	std::string const one = deflate(text, 31);
+	std::string const two = deflate(text.substr(0, 1000), 31) +
+		deflate(text.substr(1000), 31);
+	for (size_t buffer_size : { 4096, 100000, 1 << 20 }) {
+		bool failed;
+		EXPECT_EQ(decompress(one, CompressedInput::gzip, buffer_size, failed), text);
+		EXPECT_FALSE(failed);
+		EXPECT_EQ(decompress(two, CompressedInput::gzip, buffer_size, failed), text)
+			<< "Concatenated members should read as their concatenation.";
+		EXPECT_FALSE(failed);
+	}
+}
+
+TEST(CompressedInputTest, ReadsBgzfInParallel) {
+	std::string const text = sample_text(3 << 20);
+	std::string const data = bgzf(text);
+	for (unsigned num_workers : { 1, 3 }) {
+		for (size_t buffer_size : { 4096, 1 << 20 }) {
+			bool failed;
+			EXPECT_EQ(decompress(data, CompressedInput::gzip, buffer_size, failed,
+								 num_workers), text);
+			EXPECT_FALSE(failed);
+		}
+	}
+}
+
+TEST(CompressedInputTest, ReportsBadInput) {
+	std::string const text = sample_text(1 << 20);
+	for (std::string const& data : { deflate(text, 31), bgzf(text) }) {
+		bool failed;
+		std::string const cut = decompress(data.substr(0, data.size() / 2),
+			CompressedInput::gzip, 4096, failed);
+		EXPECT_TRUE(failed);
+		EXPECT_EQ(cut, text.substr(0, cut.size()))
+			<< "What comes before the end should still be read.";
+
+		std::string corrupt = data;
+		for (size_t i = data.size() / 2; i < data.size() / 2 + 16; ++i) {
+			corrupt[i] = char(0x55);
+		}
+		decompress(corrupt, CompressedInput::gzip, 4096, failed);
+		EXPECT_TRUE(failed);
+	}
+}
+
+#ifdef VICTOR_ZSTD
+
+std::string zstd_compress(std::string const& text) {
+	std::string out(ZSTD_compressBound(text.size()), '\0');
+	out.resize(ZSTD_compress(&out[0], out.size(), text.data(), text.size(), 3));
+	return out;
+}
+
+TEST(CompressedInputTest, ReadsZstd) {
+	std::string const text = sample_text(3 << 20);
+	std::string const one = zstd_compress(text);
+	std::string frames;
+	for (size_t i = 0; i < text.size(); i += 300000) {
+		frames += zstd_compress(text.substr(i, 300000));
+	}
+	for (size_t buffer_size : { 4096, 1 << 20 }) {
+		bool failed;
+		EXPECT_EQ(decompress(one, CompressedInput::zstd, buffer_size, failed), text);
+		EXPECT_FALSE(failed);
+		EXPECT_EQ(decompress(frames, CompressedInput::zstd, buffer_size, failed, 3),
+				  text);
+		EXPECT_FALSE(failed);
+		decompress(one.substr(0, one.size() / 2), CompressedInput::zstd,
+				   buffer_size, failed);
+		EXPECT_TRUE(failed);
+		decompress(frames.substr(0, frames.size() / 2), CompressedInput::zstd,
+				   buffer_size, failed);
+		EXPECT_TRUE(failed);
+	}
+}
+
+#else
+
+TEST(CompressedInputTest, ZstdNeedsBuildFlag) {
+	bool failed;
+	EXPECT_EQ(decompress(std::string("\x28\xb5\x2f\xfd\0\0\0\0", 8),
+						 CompressedInput::zstd, 4096, failed), "");
+	EXPECT_TRUE(failed);
+}
+
+#endif  // VICTOR_ZSTD
+
+TEST(CompressedInputTest, MedDegStreamReadsGzip) {
+	char const* const in_filename = "tests/test-1-venmo-trans/venmo_input/venmo-trans.txt";
+	std::ifstream ifs(in_filename, std::ifstream::binary);
+	std::string const text((std::istreambuf_iterator<char>(ifs)),
+						   std::istreambuf_iterator<char>());
+	ASSERT_FALSE(text.empty());
+	{
+		std::ofstream ofs("compressed_input_test.gz", std::ofstream::binary);
+		ofs << deflate(text, 31);
+	}
+	{
+		MedDegStream mds(in_filename, "compressed_input_test_plain.txt");
+		mds.process();
+	}
+	{
+		MedDegStream mds("compressed_input_test.gz", "compressed_input_test_gz.txt");
+		mds.process();
+	}
+	std::ifstream plain("compressed_input_test_plain.txt");
+	std::ifstream gz("compressed_input_test_gz.txt");
+	std::string const expected((std::istreambuf_iterator<char>(plain)),
+							   std::istreambuf_iterator<char>());
+	std::string const actual((std::istreambuf_iterator<char>(gz)),
+							 std::istreambuf_iterator<char>());
+	EXPECT_FALSE(expected.empty());
+	EXPECT_EQ(actual, expected);
+	remove("compressed_input_test.gz");
+	remove("compressed_input_test_plain.txt");
+	remove("compressed_input_test_gz.txt");
+}
+
+}  // namespace victor
\ No newline at end of file
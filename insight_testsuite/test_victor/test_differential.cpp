@@ -0,0 +1,91 @@
+#include "victor/differential.hpp"
+#include "victor/reference_graph.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+TEST(ReferenceGraphTest, FollowsTheRules) {
+	ReferenceGraph graph;
+	time_t const t = 1459207392;
+	EXPECT_EQ(graph.extract_median("A", "B", t), 1.0);
+	EXPECT_EQ(graph.extract_median("B", "C", t), 1.0);	// 1 2 1
+	EXPECT_EQ(graph.extract_median("C", "B", t - 10), 1.0);
+	EXPECT_EQ(graph.num_edges(), 2u);
+	// paying oneself adds nothing
+	EXPECT_EQ(graph.extract_median("D", "D", t), 1.0);
+	EXPECT_EQ(graph.num_vertices(), 3u);
+	// too late
+	EXPECT_EQ(graph.extract_median("A", "C", t - 60), 1.0);
+	EXPECT_EQ(graph.num_edges(), 2u);
+	EXPECT_EQ(graph.extract_median("A", "C", t - 59), 2.0);
+	// B-C was paid at t, so it outlives the late payment at t - 10
+	EXPECT_EQ(graph.extract_median("A", "E", t + 55), 1.5);	// 2 2 1 1
+	EXPECT_EQ(graph.num_edges(), 3u);
+	EXPECT_EQ(graph.extract_median("E", "E", t + 60), 1.0);
+	EXPECT_EQ(graph.num_edges(), 1u);
+	EXPECT_EQ(graph.extract_median("E", "E", t + 200), 0.0);
+	EXPECT_EQ(graph.num_vertices(), 0u);
+}
+
+TEST(DifferentialTest, FindsAndShrinksAMismatch) {
+	Differential d(7);
+	// wrong as soon as a vertex has degree 3
+	d.add_engine("buggy", [](PaymentStream const& stream) {
+		std::vector<MedianEvent> events;
+		ReferenceGraph graph;
+		char actor[64];
+		char target[64];
+		for (Payment const& p : stream) {
+			MedianEvent e;
+			e.created_time = p.created_time;
+			e.median = graph.extract_median(
+				std::string(actor, WorkloadGenerator::user_name(actor, p.actor)),
+				std::string(target, WorkloadGenerator::user_name(target, p.target)),
+				p.created_time);
+			e.num_vertices = graph.num_vertices();
+			e.num_edges = graph.num_edges();
+			if (e.num_edges == 3 && e.num_vertices == 4) {
+				e.median = 0;
+			}
+			events.push_back(e);
+		}
+		return events;
+	});
+	std::string failure;
+	d.run(10000, 60, 100, failure);
+	ASSERT_NE(failure, "");
+	// three payments from one user to three others, in some order
+	EXPECT_EQ(std::count(failure.begin(), failure.end(), '\n'), 4) << failure;
+	EXPECT_NE(failure.find("buggy at payment 2"), std::string::npos) << failure;
+}
+
+TEST(DifferentialTest, EnginesAgreeWithReference) {
+	Differential d(1);
+	std::string failure;
+	EXPECT_EQ(d.run(500, 600, 100, failure), 500u);
+	EXPECT_EQ(failure, "");
+}
+
+/**
+	Runs for VICTOR_SOAK_SECONDS, if it is set: make soak.
+*/
+TEST(DifferentialTest, Soak) {
+	char const* const seconds = getenv("VICTOR_SOAK_SECONDS");
+	if (seconds == nullptr) {
+		return;
+	}
+	char const* const seed = getenv("VICTOR_SOAK_SEED");
+	Differential d(seed == nullptr ? uint64_t(time(nullptr)) : strtoull(seed, nullptr, 10));
+	std::string failure;
+	uint64_t const passed = d.run(~uint64_t(0), atof(seconds), 1000, failure);
+	printf("%llu streams passed\n", (unsigned long long)passed);
+	EXPECT_EQ(failure, "");
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -0,0 +1,131 @@
+#define VICTOR_INSTRUMENT
+#include "victor/instrument.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "gtest/gtest.h"
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+/**
+	Spin for about some ticks.
+*/
+void spin(uint64_t ticks) {
+	uint64_t const start = Instrument::now();
+	while (Instrument::now() - start < ticks) {
+	}
+}
+
+TEST(InstrumentTest, HistogramIsWithinBucketPrecision) {
+	TickHistogram h;
+	std::mt19937_64 rng(4);
+	std::vector<uint64_t> values;
+	for (int i = 0; i < 100000; ++i) {
+		uint64_t const v = rng() >> (rng() % 64);
+		values.push_back(v);
+		h.record(v);
+	}
+	std::sort(values.begin(), values.end());
+	EXPECT_EQ(h.count(), values.size());
+	EXPECT_EQ(h.max(), values.back());
+	for (double q : { 0.0, 0.1, 0.5, 0.9, 0.99, 0.999 }) {
+		double const expected = double(values[size_t(q * double(values.size()))]);
+		double const actual = double(h.quantile(q));
+		EXPECT_GE(actual, expected) << q;
+		EXPECT_LE(actual, expected * (1 + 1.0 / 16) + 1) << q;
+	}
+	for (uint64_t v = 0; v < 100000; v += 7) {
+		int const b = TickHistogram::bucket(v);
+		EXPECT_LE(TickHistogram::lowest(b), v);
+		EXPECT_GT(TickHistogram::lowest(b + 1), v);
+	}
+	int const num_buckets = TickHistogram::num_buckets;
+	EXPECT_LT(TickHistogram::bucket(~uint64_t(0)), num_buckets);
+}
+
+TEST(InstrumentTest, ChargesOwnTime) {
+	Instrument& instrument = Instrument::instance();
+	// time away, if the thread is descheduled or throttled, can only add;
+	// so the least of some runs, started at different offsets, is checked
+	uint64_t graph = ~uint64_t(0);
+	uint64_t expire = ~uint64_t(0);
+	uint64_t heap = ~uint64_t(0);
+	for (int run = 0; run < 50 && (graph >= 3000000 || expire >= 5000000); ++run) {
+		spin(uint64_t(run) * 777777 % 5000000);
+		instrument.clear();
+		{
+			VICTOR_PROBE(graph);
+			spin(1000000);
+			int const x = VICTOR_TIMED(heap, (spin(3000000), 42));
+			EXPECT_EQ(x, 42);
+			{
+				VICTOR_PROBE(expire);
+				spin(2000000);
+				VICTOR_TIMED(heap, spin(3000000));
+			}
+		}
+		EXPECT_EQ(instrument.histogram(Instrument::graph).count(), 1u);
+		EXPECT_EQ(instrument.histogram(Instrument::heap).count(), 2u);
+		EXPECT_EQ(instrument.histogram(Instrument::expire).count(), 1u);
+		graph = std::min(graph, instrument.ticks(Instrument::graph));
+		expire = std::min(expire, instrument.ticks(Instrument::expire));
+		heap = std::min(heap, instrument.ticks(Instrument::heap));
+	}
+	EXPECT_GE(graph, 1000000u);
+	EXPECT_LT(graph, 3000000u);
+	EXPECT_GE(expire, 2000000u);
+	EXPECT_LT(expire, 5000000u);
+	EXPECT_GE(heap, 6000000u);
+	instrument.clear();
+}
+
+TEST(InstrumentTest, TimesMedDegStream) {
+	Instrument& instrument = Instrument::instance();
+	instrument.clear();
+	{
+		MedDegStream mds("../data-gen/venmo-trans.txt", "instrument_test_output.txt");
+		mds.process();
+	}
+	remove("instrument_test_output.txt");
+	EXPECT_GE(instrument.histogram(Instrument::read).count(), 1u);
+	EXPECT_GE(instrument.histogram(Instrument::index).count(), 1u);
+	EXPECT_EQ(instrument.histogram(Instrument::parse).count(), 1792u);
+	EXPECT_EQ(instrument.histogram(Instrument::graph).count(), 1792u);
+	EXPECT_EQ(instrument.histogram(Instrument::output).count(), 1792u);
+	EXPECT_GE(instrument.histogram(Instrument::heap).count(), 1792u);
+	EXPECT_GE(instrument.histogram(Instrument::expire).count(), 1u);
+
+	testing::internal::CaptureStderr();
+	instrument.report(stderr);
+	std::string const report = testing::internal::GetCapturedStderr();
+	for (int s = 0; s < Instrument::num_stages; ++s) {
+		EXPECT_NE(report.find(Instrument::name(Instrument::Stage(s))),
+				  std::string::npos) << report;
+	}
+	instrument.clear();
+}
+
+TEST(InstrumentTest, ReportsOnSignal) {
+	Instrument& instrument = Instrument::instance();
+	testing::internal::CaptureStderr();
+	VICTOR_POLL();
+	EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+
+	raise(SIGUSR1);
+	testing::internal::CaptureStderr();
+	VICTOR_POLL();
+	EXPECT_NE(testing::internal::GetCapturedStderr().find("total"), std::string::npos);
+
+	testing::internal::CaptureStderr();
+	instrument.poll();
+	EXPECT_EQ(testing::internal::GetCapturedStderr(), "")
+		<< "A signal should be reported once.";
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "json/json.hpp"
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <clocale>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+using json = nlohmann::json;
+
+/**
+	Records SAX events as strings, for checking the order they come in.
+*/
+struct EventLog {
+	typedef nlohmann::string_ref string_ref;
+	std::vector<std::string> events;
+	int stop_after = -1;
+
+	bool add(std::string e) {
+		events.push_back(std::move(e));
+		return int(events.size()) != stop_after;
+	}
+	bool null() { return add("null"); }
+	bool boolean(bool b) { return add(b ? "true" : "false"); }
+	bool number_integer(long long i) { return add("int " + std::to_string(i)); }
+	bool number_unsigned(unsigned long long u) {
+		return add("uint " + std::to_string(u));
+	}
+	bool number_float(double, string_ref raw) {
+		return add("float " + raw.to_string());
+	}
+	bool string(string_ref s) { return add("string " + s.to_string()); }
+	bool key(string_ref s) { return add("key " + s.to_string()); }
+	bool start_object() { return add("{"); }
+	bool end_object() { return add("}"); }
+	bool start_array() { return add("["); }
+	bool end_array() { return add("]"); }
+	bool parse_error(size_t pos, string_ref token) {
+		return add("error " + std::to_string(pos) + " " + token.to_string());
+	}
+};
+
+TEST(SaxParseTest, EventsComeInOrder) {
+	EventLog log;
+	std::string const text =
+		"{\"a\": [1, -2, 3.5, true, null], \"b\\n\": {\"c\": \"x\\u0041\"}}";
+	ASSERT_TRUE(json::sax_parse(text, log));
+	std::vector<std::string> const expected = {
+		"{", "key a", "[", "uint 1", "int -2", "float 3.5", "true", "null",
+		"]", "key b\n", "{", "key c", "string xA", "}", "}"
+	};
+	EXPECT_EQ(log.events, expected);
+}
+
+TEST(SaxParseTest, HandlerCanStopEarly) {
+	EventLog log;
+	log.stop_after = 2;
+	EXPECT_FALSE(json::sax_parse("{\"a\": 1, \"b\": 2", log));
+	ASSERT_EQ(log.events.size(), 2) <<
+		"Parser kept going after the handler asked it to stop.";
+}
+
+TEST(SaxParseTest, ReportsSyntaxErrors) {
+	EventLog log;
+	EXPECT_FALSE(json::sax_parse("{\"a\" 1}", log));
+	ASSERT_FALSE(log.events.empty());
+	EXPECT_EQ(log.events.back(), "error 5 1");
+
+	EventLog trailing;
+	EXPECT_FALSE(json::sax_parse("[] x", trailing));
+}
+
+TEST(SaxParseTest, ParsesRangeInPlace) {
+	// the range stops short of the buffer's end, so the parser must not
+	// read past it
+	std::string const buf = "{\"a\": \"xyz\", \"b\": 12}garbage";
+	char const* first = buf.data();
+	char const* last = first + buf.find('}') + 1;
+
+	EventLog log;
+	ASSERT_TRUE(json::sax_parse(first, last, log));
+	std::vector<std::string> const expected = {
+		"{", "key a", "string xyz", "key b", "uint 12", "}"
+	};
+	EXPECT_EQ(log.events, expected);
+
+	nlohmann::json const j = json::parse(first, last);
+	EXPECT_EQ(j["a"], "xyz");
+	EXPECT_EQ(j["b"], 12);
+
+	// a token cut off by the end of the range
+	EXPECT_THROW(json::parse(first, first + 9),
+		std::invalid_argument);
+	EXPECT_EQ(json::parse(first + 18, first + 20), 12) <<
+		"Number at the end of the range was misread.";
+	EXPECT_THROW(json::parse(first, first), std::invalid_argument);
+}
+
+TEST(ReusableParserTest, ParsesIntoExistingValue) {
+	json::reusable_parser parser;
+	json j;
+	parser.parse("{\"a\": \"first\", \"b\": [1, 2, 3], \"c\": {\"d\": null}}", j);
+	EXPECT_EQ(j, json::parse(
+		"{\"a\": \"first\", \"b\": [1, 2, 3], \"c\": {\"d\": null}}"));
+
+	std::string const* a = &j["a"].get_ref<std::string const&>();
+	json const* b0 = &j["b"][0];
+	parser.parse("{\"b\": [4], \"a\": \"2nd\", \"e\": true}", j);
+	EXPECT_EQ(j, json::parse("{\"a\": \"2nd\", \"b\": [4], \"e\": true}")) <<
+		"Members and elements missing from the new input should be removed.";
+	EXPECT_EQ(&j["a"].get_ref<std::string const&>(), a) <<
+		"String member was reallocated instead of reused.";
+	EXPECT_EQ(&j["b"][0], b0) << "Array was reallocated instead of reused.";
+
+	// a different shape replaces the value
+	parser.parse("[\"x\", {\"y\": 1.5}]", j);
+	EXPECT_EQ(j, json::parse("[\"x\", {\"y\": 1.5}]"));
+	parser.parse("{\"k\": 1, \"k\": 2, \"z\": 3}", j);
+	parser.parse("{\"k\": 1, \"k\": 2}", j);
+	EXPECT_EQ(j, json::parse("{\"k\": 2}")) <<
+		"A repeated key hid a member that should have been removed.";
+
+	std::string const range = "{\"n\": -7}tail";
+	parser.parse(range.data(), range.data() + 9, j);
+	EXPECT_EQ(j, json::parse("{\"n\": -7}"));
+}
+
+TEST(ReusableParserTest, RecoversFromErrors) {
+	json::reusable_parser parser;
+	json j;
+	EXPECT_THROW(parser.parse("{\"a\": [1, 2", j), std::invalid_argument);
+	EXPECT_THROW(parser.parse("{} {}", j), std::invalid_argument);
+	parser.parse("{\"a\": [1]}", j);
+	EXPECT_EQ(j, json::parse("{\"a\": [1]}"));
+}
+
+TEST(FlatMapTest, KeepsInsertionOrder) {
+	using flat_json = nlohmann::flat_json;
+	flat_json j = flat_json::parse("{\"b\": 1, \"a\": [true], \"c\": {\"d\": \"e\"}}");
+	EXPECT_EQ(j.dump(), "{\"b\":1,\"a\":[true],\"c\":{\"d\":\"e\"}}");
+	EXPECT_EQ(j["a"][0], true);
+	EXPECT_EQ(j.count("c"), 1);
+	EXPECT_TRUE(j.find("z") == j.end());
+	j["z"] = 5;
+	EXPECT_EQ(j.size(), 4);
+	EXPECT_EQ(j.erase("b"), 1);
+	EXPECT_EQ(j.dump(), "{\"a\":[true],\"c\":{\"d\":\"e\"},\"z\":5}");
+	EXPECT_THROW(j.at("b"), std::out_of_range);
+
+	flat_json const k = flat_json::parse("{\"z\": 5, \"c\": {\"d\": \"e\"}, \"a\": [true]}");
+	EXPECT_EQ(j, k) << "Equality should not depend on member order.";
+	EXPECT_FALSE(j < k);
+	EXPECT_FALSE(k < j);
+	EXPECT_TRUE(flat_json::parse("{\"a\": 1}") < flat_json::parse("{\"a\": 2}"));
+}
+
+TEST(FlatMapTest, LargeObjectsUseIndex) {
+	nlohmann::flat_map<std::string, int> m;
+	size_t const n = 10 * nlohmann::flat_map<std::string, int>::index_threshold;
+	for (size_t i = 0; i < n; ++i) {
+		ASSERT_TRUE(m.emplace("key" + std::to_string(i), int(i)).second);
+	}
+	EXPECT_FALSE(m.emplace("key3", 0).second);
+	for (size_t i = 0; i < n; i += 2) {
+		ASSERT_EQ(m.erase("key" + std::to_string(i)), 1);
+	}
+	ASSERT_EQ(m.size(), n / 2);
+	for (size_t i = 0; i < n; ++i) {
+		auto const it = m.find("key" + std::to_string(i));
+		if (i % 2 == 0) {
+			EXPECT_TRUE(it == m.end()) << i;
+		} else {
+			ASSERT_TRUE(it != m.end()) << i;
+			EXPECT_EQ(it->second, int(i));
+		}
+	}
+	EXPECT_EQ(m.begin()->first, "key1") << "Erase should keep the order.";
+}
+
+TEST(FlatMapTest, ReusableParserWorks) {
+	nlohmann::flat_json::reusable_parser parser;
+	nlohmann::flat_json j;
+	parser.parse("{\"a\": 1, \"b\": {\"x\": 1}}", j);
+	parser.parse("{\"c\": 2, \"b\": {\"y\": 2}, \"d\": 3, \"e\": 4}", j);
+	EXPECT_EQ(j, nlohmann::flat_json::parse(
+		"{\"b\": {\"y\": 2}, \"c\": 2, \"d\": 3, \"e\": 4}"));
+}
+
+TEST(NumberParseTest, IntegersAtLimits) {
+	json j = json::parse("18446744073709551615");
+	EXPECT_TRUE(j.is_number_unsigned());
+	EXPECT_EQ(j.get<uint64_t>(), 18446744073709551615ull);
+	EXPECT_TRUE(json::parse("18446744073709551616").is_number_float())
+		<< "Integers that overflow should become floats.";
+	j = json::parse("-9223372036854775808");
+	EXPECT_TRUE(j.is_number_integer());
+	EXPECT_EQ(j.get<int64_t>(), INT64_MIN);
+	EXPECT_TRUE(json::parse("-9223372036854775809").is_number_float());
+	j = json::parse("-0");
+	EXPECT_TRUE(j.is_number_integer());
+	EXPECT_EQ(j.get<int64_t>(), 0);
+	EXPECT_EQ(json::parse("[1234567890123456789, -42]").dump(),
+			  "[1234567890123456789,-42]");
+}
+
+TEST(NumberParseTest, FloatsRoundCorrectly) {
+	char const* const edge[] = {
+		"0.0", "-0.0", "0.1", "1e23", "1e-400", "1e400", "5e-324",
+		"2.4703282292062327e-324", "2.4703282292062328e-324",
+		"2.2250738585072011e-308", "1.7976931348623157e308",
+		"1.7976931348623159e308", "9007199254740993.0",
+		"1.00000000000000011102230246251565404236316680908203125",
+		"1.00000000000000011102230246251565404236316680908203124",
+		"123456789012345678901234567890e-10",
+		"0.000000000000000000000000000000000001234567890123456789012"
+	};
+	for (char const* s : edge) {
+		double const expected = strtod(s, nullptr);
+		double const actual = nlohmann::float_parser::parse(s, s + strlen(s));
+		EXPECT_EQ(memcmp(&expected, &actual, sizeof(double)), 0) << s;
+	}
+	std::mt19937_64 rng(7);
+	char buf[64];
+	for (int i = 0; i < 100000; ++i) {
+		uint64_t const bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		if (!std::isfinite(d)) {
+			continue;
+		}
+		snprintf(buf, sizeof(buf), "%.*e", int(i % 18), d);
+		double const expected = strtod(buf, nullptr);
+		json const j = json::parse(buf);
+		ASSERT_TRUE(j.is_number_float()) << buf;
+		double const actual = j.get<double>();
+		ASSERT_EQ(memcmp(&expected, &actual, sizeof(double)), 0) << buf;
+	}
+}
+
+TEST(NumberParseTest, IgnoresLocale) {
+	// a locale with a decimal comma, where available
+	std::string const old = setlocale(LC_NUMERIC, nullptr);
+	if (setlocale(LC_NUMERIC, "de_DE.UTF-8") == nullptr) {
+		setlocale(LC_NUMERIC, "de_DE");
+	}
+	double const d = json::parse("[2.5e-3]")[0].get<double>();
+	setlocale(LC_NUMERIC, old.c_str());
+	EXPECT_EQ(d, 0.0025);
+}
+
+TEST(StringScanTest, PlainStringsAreViews) {
+	std::string const text = "[\"plain string longer than sixteen bytes\", \"a\\\"b\"]";
+	struct Views : EventLog {
+		std::vector<char const*> data;
+		std::vector<std::string> strings;
+		bool string(string_ref s) {
+			data.push_back(s.data());
+			strings.push_back(s.to_string());
+			return true;
+		}
+	} views;
+	ASSERT_TRUE(json::sax_parse(text.data(), text.data() + text.size(), views));
+	ASSERT_EQ(views.strings.size(), 2u);
+	EXPECT_EQ(views.data[0], text.data() + 2)
+		<< "A string without escapes should point into the input.";
+	EXPECT_EQ(views.strings[1], "a\"b");
+	std::istringstream stream(text);
+	EXPECT_EQ(json::parse(stream)[0], "plain string longer than sixteen bytes");
+}
+
+TEST(StringScanTest, RejectsInvalidUtf8) {
+	EXPECT_EQ(json::parse("\"J\xc3\xa9r\xc3\xb4me \xe2\x82\xac \xf0\x9f\x98\x80\""),
+			  "J\xc3\xa9r\xc3\xb4me \xe2\x82\xac \xf0\x9f\x98\x80");
+	char const* const bad[] = {
+		"\"\xff\"", "\"\xc0\x80\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"",
+		"\"truncated \xe2\x82\"", "\"\x80 stray continuation\"",
+		"\"escaped \\n and then \xc3\""
+	};
+	for (char const* s : bad) {
+		EXPECT_THROW(json::parse(s), std::invalid_argument) << s;
+	}
+}
+
+TEST(StringScanTest, Utf8KernelsAgree) {
+	std::mt19937_64 rng(9);
+	char const* const pieces[] = {
+		"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xc0\x80",
+		"\xed\xa0\x80", "\xf4\x90\x80\x80", "\x80", "\xe2\x82", "\xff",
+		"0123456789abcdef"
+	};
+	for (int i = 0; i < 20000; ++i) {
+		std::string s;
+		for (int n = int(rng() % 12); n != 0; --n) {
+			s += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+		}
+		if (!s.empty() && rng() % 4 == 0) {
+			s[rng() % s.size()] = char(rng());
+		}
+		bool const expected = nlohmann::string_scanner::valid_utf8_scalar(
+			s.data(), s.data() + s.size());
+		ASSERT_EQ(nlohmann::string_scanner::valid_utf8(s.data(), s.data() + s.size()),
+				  expected) << s;
+	}
+}
+
+}  // namespace victor
\ No newline at end of file
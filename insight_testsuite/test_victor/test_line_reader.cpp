@@ -0,0 +1,62 @@
+#include "victor/line_reader.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+/**
+	Write a file and read its lines back with the given chunk size.
+*/
+std::vector<std::string> read_lines(std::string const& contents,
+									size_t chunk_size) {
+	char const* filename = "line_reader_test.txt";
+	{
+		std::ofstream ofs(filename, std::ofstream::binary);
+		ofs << contents;
+	}
+	std::vector<std::string> lines;
+	LineReader reader(filename, chunk_size);
+	EXPECT_TRUE(reader.is_open());
+	char const* first;
+	char const* last;
+	while (reader.next(first, last)) {
+		lines.emplace_back(first, last);
+	}
+	remove(filename);
+	return lines;
+}
+
+TEST(LineReaderTest, SplitsLines) {
+	std::vector<std::string> const expected = { "ab", "", "cde", "f" };
+	EXPECT_EQ(read_lines("ab\n\ncde\nf", 1 << 16), expected);
+	EXPECT_EQ(read_lines("ab\n\ncde\nf\n", 1 << 16), expected) <<
+		"A trailing newline should not make an extra line.";
+	EXPECT_TRUE(read_lines("", 1 << 16).empty());
+}
+
+TEST(LineReaderTest, LinesSpanChunks) {
+	std::string contents;
+	std::vector<std::string> expected;
+	for (int i = 0; i < 100; ++i) {
+		expected.push_back(std::string(size_t(i), char('a' + i % 26)));
+		contents += expected.back() + '\n';
+	}
+	for (size_t chunk_size = 1; chunk_size < 40; chunk_size += 7) {
+		EXPECT_EQ(read_lines(contents, chunk_size), expected) <<
+			"Chunk size " << chunk_size << " broke a line.";
+	}
+}
+
+TEST(LineReaderTest, MissingFile) {
+	LineReader reader("no/such/file.txt");
+	EXPECT_FALSE(reader.is_open());
+	char const* first;
+	char const* last;
+	EXPECT_FALSE(reader.next(first, last));
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "victor/med_deg_stream.hpp"
 #include "gtest/gtest.h"
+#include "json/json.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <string>
 
 
 namespace victor {
@@ -11,4 +16,34 @@ TEST(MedDegStreamTest, ProcessWorks) {
 	mds.process();
 }
 
+TEST(MedDegStreamTest, JsonLinesMatchText) {
+	char const* in_filename = "tests/test-1-venmo-trans/venmo_input/venmo-trans.txt";
+	{
+		MedDegStream mds(in_filename, "med_deg_stream_test.txt");
+		mds.process();
+	}
+	{
+		MedDegStream mds(in_filename, "med_deg_stream_test.jsonl",
+						 MedDegStream::json, MedDegStream::json_lines);
+		mds.process();
+	}
+	std::ifstream text("med_deg_stream_test.txt");
+	std::ifstream lines("med_deg_stream_test.jsonl");
+	std::string median;
+	std::string line;
+	int n = 0;
+	while (std::getline(text, median)) {
+		ASSERT_TRUE(std::getline(lines, line).good());
+		nlohmann::json const j = nlohmann::json::parse(line);
+		EXPECT_EQ(j["median"].get<double>(), strtod(median.c_str(), nullptr));
+		EXPECT_GT(j["vertices"].get<size_t>(), 0u);
+		EXPECT_GT(j["edges"].get<size_t>(), 0u);
+		++n;
+	}
+	EXPECT_FALSE(std::getline(lines, line).good());
+	EXPECT_GT(n, 0);
+	remove("med_deg_stream_test.txt");
+	remove("med_deg_stream_test.jsonl");
+}
+
 }  // namespace victor
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "victor/med_heap_map.hpp"
+#include "victor/workload.hpp"
 #include "gtest/gtest.h"
 #include <math.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 #include <iostream>
 using std::cout;
@@ -26,42 +30,42 @@ TEST(MedHeapMapTest, InsertWorks) {
 	ASSERT_EQ(med_heap.size(), 2);
 
 	med_heap.insert("Christina-Mitchens");
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
 	ASSERT_EQ(med_heap.size(), 3);
 
 	med_heap.insert("Hillary-Clinton");
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
 	ASSERT_EQ(med_heap.size(), 4);
 
 	med_heap.insert("Benjamin-Button");
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
 	ASSERT_EQ(med_heap.size(), 5);
 
 	med_heap.insert("Charlie-bitmyfinger-Unicorn");
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
 	ASSERT_EQ(med_heap.size(), 6);
 
 	med_heap.insert("Hilnold-Trumpton");
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
 	ASSERT_EQ(med_heap.size(), 7);
 
 	med_heap.insert("Shaggy");
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
@@ -87,7 +91,7 @@ TEST(MedHeapMapTest, IncreaseKeyWorks) {
 	old_size = med_heap.size();
 	med_heap.increase_key("Adam-West");
 	ASSERT_EQ(med_heap.degree("Adam-West"), 2);
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
@@ -97,7 +101,7 @@ TEST(MedHeapMapTest, IncreaseKeyWorks) {
 	old_size = med_heap.size();
 	med_heap.increase_key("Christina-Mitchens");
 	ASSERT_EQ(med_heap.degree("Christina-Mitchens"), 2);
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
@@ -107,7 +111,7 @@ TEST(MedHeapMapTest, IncreaseKeyWorks) {
 	old_size = med_heap.size();
 	med_heap.increase_key("Adam-West");
 	ASSERT_EQ(med_heap.degree("Adam-West"), 3);
-	ASSERT_LT(size_t(abs(med_heap.size_lh() - med_heap.size_gh())), 2) <<
+	ASSERT_LT(size_t(abs(ssize_t(med_heap.size_lh()) - ssize_t(med_heap.size_gh()))), 2) <<
 		"Median Heap isn't balanced:\n  med_heap.size_lh() == " <<
 		med_heap.size_lh() << "\n  med_heap.size_gh() == " <<
 		med_heap.size_gh();
@@ -293,4 +297,119 @@ TEST(MedHeapMapTest, MedianWorks) {
 	ASSERT_EQ(static_cast<int>(med_heap.median()), 1);
 }
 
-}  // namespace victor
+TEST(MedHeapMapTest, ErasedIdsAreRecycled) {
+	MedHeapMap med_heap;
+	med_heap.insert("A");
+	med_heap.insert("B");
+	MedHeapMap::Id const a = med_heap.find("A");
+
+	med_heap.decrease_key("A");
+	ASSERT_FALSE(med_heap.contains("A"));
+	ASSERT_EQ(med_heap.names().size(), 1) <<
+		"A was erased, but its name is still interned.";
+
+	med_heap.insert("C");
+	EXPECT_EQ(med_heap.find("C"), a) <<
+		"C should have reused the id released by A.";
+	EXPECT_EQ(med_heap.name(a), "C");
+	EXPECT_EQ(med_heap.degree("C"), 1);
+	EXPECT_EQ(med_heap.degree("B"), 1);
+}
+
+TEST(MedHeapMapTest, IgnoresUnknownNames) {
+	MedHeapMap med_heap;
+	EXPECT_EQ(med_heap.degree("nobody"), 0u);
+	EXPECT_FALSE(med_heap.in_gh("nobody"));
+	EXPECT_FALSE(med_heap.decrease_key("nobody"));
+	med_heap.increase_key("nobody");
+	med_heap.erase("nobody");
+	EXPECT_EQ(med_heap.size(), 0);
+
+	med_heap.insert("A");
+	med_heap.insert("B");
+	med_heap.increase_key("B");
+	med_heap.increase_key("nobody");
+	med_heap.erase("nobody");
+	EXPECT_FALSE(med_heap.decrease_key("nobody"));
+	EXPECT_FALSE(med_heap.contains("nobody"));
+	EXPECT_EQ(med_heap.degree("nobody"), 0u);
+	EXPECT_EQ(med_heap.size(), 2);
+	EXPECT_EQ(med_heap.degree("A"), 1u);
+	EXPECT_EQ(med_heap.degree("B"), 2u);
+	EXPECT_EQ(med_heap.median(), 1.5);
+}
+
+TEST(MedHeapMapTest, CountsWhatItDoes) {
+	MedHeapMap med_heap;
+	med_heap.insert("A");
+	med_heap.insert("B");
+	med_heap.insert("C");
+	EXPECT_EQ(med_heap.counters().peak_size, 3u);
+	EXPECT_EQ(med_heap.counters().rotations, 1u) <<
+		"The second vertex should have been rotated into the lesser half.";
+	EXPECT_GE(med_heap.counters().swaps, 1u);
+	EXPECT_EQ(med_heap.counters().erased, 0u);
+
+	med_heap.decrease_key("A");
+	med_heap.decrease_key("B");
+	EXPECT_EQ(med_heap.counters().erased, 2u);
+	EXPECT_EQ(med_heap.counters().peak_size, 3u);
+}
+
+TEST(MedHeapMapTest, QuantileWorks) {
+	MedHeapMap med_heap;
+	EXPECT_EQ(med_heap.quantile(0.99), 0u);
+	char const* const names[] = { "A", "B", "C", "D", "E" };
+	int const degrees[] = { 3, 1, 10, 4, 2 };
+	for (int i = 0; i < 5; ++i) {
+		med_heap.insert(names[i]);
+		for (int d = 1; d < degrees[i]; ++d) {
+			med_heap.increase_key(names[i]);
+		}
+	}
+	EXPECT_EQ(med_heap.quantile(0), 1u);
+	EXPECT_EQ(med_heap.quantile(0.2), 1u);
+	EXPECT_EQ(med_heap.quantile(0.21), 2u);
+	EXPECT_EQ(med_heap.quantile(0.5), 3u);
+	EXPECT_EQ(med_heap.quantile(0.99), 10u);
+	EXPECT_EQ(med_heap.quantile(1), 10u);
+	EXPECT_EQ(med_heap.median(), 3.0);
+}
+
+TEST(MedHeapMapTest, QuantileMatchesSortedDegrees) {
+	Random random(7);
+	MedHeapMap med_heap;
+	std::vector<uint32_t> degrees(40);
+	for (int i = 0; i < 3000; ++i) {
+		size_t const v = size_t(random.below(degrees.size()));
+		std::string const name = "user-" + std::to_string(v);
+		if (degrees[v] == 0) {
+			med_heap.insert(name);
+			++degrees[v];
+		} else if (random.below(2) == 0) {
+			med_heap.increase_key(name);
+			++degrees[v];
+		} else if (random.below(10) == 0) {
+			med_heap.erase(name);
+			degrees[v] = 0;
+		} else {
+			med_heap.decrease_key(name);
+			--degrees[v];
+		}
+		std::vector<uint32_t> sorted;
+		for (uint32_t d : degrees) {
+			if (d != 0) {
+				sorted.push_back(d);
+			}
+		}
+		std::sort(sorted.begin(), sorted.end());
+		ASSERT_EQ(med_heap.size(), sorted.size());
+		for (size_t k = 0; k < sorted.size(); ++k) {
+			// the least q whose nearest rank is k + 1
+			double const q = (double(k) + 0.5) / double(sorted.size());
+			ASSERT_EQ(med_heap.quantile(q), sorted[k]) << i << " " << k;
+		}
+	}
+}
+
+}  // namespace victor
\ No newline at end of file
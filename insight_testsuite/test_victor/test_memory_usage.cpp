@@ -0,0 +1,120 @@
+#include "victor/memory_usage.hpp"
+#include "victor/venmo_graph.hpp"
+#include "victor/workload.hpp"
+#include "gtest/gtest.h"
+#include <malloc.h>
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace victor {
+
+/**
+	@return bytes malloc has handed out and not been given back.
+*/
+size_t heap_in_use() {
+	struct mallinfo2 const info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+}
+
+/**
+	Check an estimate against what malloc counts. Chunks freed into the
+	thread cache still count as in use, so the two differ by a little.
+*/
+void expect_near(size_t estimate, size_t measured) {
+	EXPECT_GE(double(estimate), 0.95 * double(measured)) << estimate << " of " << measured;
+	EXPECT_LE(double(estimate), 1.05 * double(measured)) << estimate << " of " << measured;
+}
+
+TEST(MemoryUsageTest, RoundsLikeMalloc) {
+	EXPECT_EQ(MemoryUsage::allocation(0), 32u);
+	EXPECT_EQ(MemoryUsage::allocation(24), 32u);
+	EXPECT_EQ(MemoryUsage::allocation(25), 48u);
+	EXPECT_EQ(MemoryUsage::allocation(100), 112u);
+	EXPECT_EQ(MemoryUsage::of(std::string("short")), 0u);
+	EXPECT_EQ(MemoryUsage::of(std::string(40, 'x')), 64u);
+	EXPECT_EQ(MemoryUsage::of(std::vector<int>()), 0u);
+}
+
+TEST(MemoryUsageTest, AddsParts) {
+	MemoryUsage a;
+	a.add("x", 10);
+	a.add("y", 5);
+	MemoryUsage b;
+	b.add("y", 1);
+	b.add("z", 2);
+	a.add(b);
+	EXPECT_EQ(a.parts().size(), 3u);
+	EXPECT_EQ(a.bytes("y"), 6u);
+	EXPECT_EQ(a.bytes("w"), 0u);
+	EXPECT_EQ(a.total(), 18u);
+}
+
+TEST(MemoryUsageTest, MatchesMallocForContainers) {
+	size_t const before = heap_in_use();
+	std::unique_ptr<std::multimap<time_t, std::pair<uint32_t, uint32_t> > > tree(
+		new std::multimap<time_t, std::pair<uint32_t, uint32_t> >);
+	size_t const empty_tree = heap_in_use();
+	for (uint32_t i = 0; i < 1000; ++i) {
+		tree->emplace(time_t(i % 7), std::make_pair(i, i));
+	}
+	expect_near(MemoryUsage::tree(*tree), heap_in_use() - empty_tree);
+
+	std::unique_ptr<std::unordered_map<uint32_t, time_t> > table(
+		new std::unordered_map<uint32_t, time_t>);
+	size_t const empty_table = heap_in_use();
+	for (uint32_t i = 0; i < 1000; ++i) {
+		(*table)[i * 7] = time_t(i);
+	}
+	expect_near(MemoryUsage::hash_table(*table), heap_in_use() - empty_table);
+
+	size_t const no_strings = heap_in_use();
+	std::vector<std::string> strings;
+	for (int i = 0; i < 1000; ++i) {
+		strings.push_back(std::string(size_t(i % 40), 'x'));
+	}
+	size_t expected = MemoryUsage::of(strings);
+	for (std::string const& s : strings) {
+		expected += MemoryUsage::of(s);
+	}
+	expect_near(expected, heap_in_use() - no_strings);
+	EXPECT_GT(no_strings, before);
+}
+
+TEST(MemoryUsageTest, MatchesMallocForGraph) {
+	WorkloadConfig config;
+	config.num_users = 20000;
+	config.rate = 1000;
+	WorkloadGenerator generator(config);
+	WorkloadGenerator::Event e;
+	char actor[64];
+	char target[64];
+
+	size_t const before = heap_in_use();
+	std::unique_ptr<VenmoGraph> graph(new VenmoGraph);
+	for (int i = 0; i < 200000; ++i) {
+		generator.next(e);
+		graph->extract_median(
+			std::string(actor, WorkloadGenerator::user_name(actor, e.actor)),
+			std::string(target, WorkloadGenerator::user_name(target, e.target)),
+			e.created_time);
+	}
+	size_t const used = heap_in_use() - before;
+	MemoryUsage const m = graph->memory_usage();
+	for (char const* part : { "edges", "neighbors", "heaps", "forward_index",
+							  "degree_counts", "names", "name_index", "free_ids" }) {
+		EXPECT_GT(m.bytes(part), 0u) << part;
+	}
+	EXPECT_EQ(m.parts().size(), 8u);
+	// only the graph object itself, and memory malloc keeps in its own
+	// structures, go unaccounted
+	EXPECT_LE(m.total(), used);
+	EXPECT_GE(double(m.total()), 0.97 * double(used))
+		<< m.total() << " of " << used << " bytes accounted for";
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "victor/merged_input.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "victor/workload.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+std::string read_file(char const* filename) {
+	std::ifstream ifs(filename, std::ifstream::binary);
+	return std::string((std::istreambuf_iterator<char>(ifs)),
+					   std::istreambuf_iterator<char>());
+}
+
+/**
+	@return the value of a sample in Prometheus text.
+*/
+double counter(std::string const& metrics, std::string const& name) {
+	size_t const at = metrics.find("\n" + name + " ");
+	return at == std::string::npos ? -1
+		: strtod(metrics.c_str() + at + name.size() + 2, nullptr);
+}
+
+/**
+	Payments of one workload, written to a file per producer host; each
+	file is in time order, but the hosts interleave.
+*/
+class HostFiles {
+public:
+	std::vector<std::string> filenames;
+	std::vector<WorkloadGenerator::Event> merged;	// in the merge's order
+
+	HostFiles(int num_hosts, uint64_t num_records, WorkloadConfig config) {
+		config.out_of_order = 0;
+		config.out_of_window = 0;
+		config.malformed = 0;
+		WorkloadGenerator generator(config);
+		std::vector<std::unique_ptr<std::ofstream>> files;
+		std::vector<std::unique_ptr<OutputBuffer>> outs;
+		std::vector<std::vector<WorkloadGenerator::Event>> events(num_hosts);
+		for (int h = 0; h < num_hosts; ++h) {
+			filenames.push_back("merged_test_host" + std::to_string(h) + ".txt");
+			files.emplace_back(new std::ofstream(filenames.back().c_str(),
+												 std::ofstream::binary));
+			outs.emplace_back(new OutputBuffer(*files.back()));
+		}
+		WorkloadGenerator::Event e;
+		for (uint64_t i = 0; i < num_records; ++i) {
+			generator.next(e);
+			int const h = int(e.actor % uint64_t(num_hosts));
+			generator.write(e, *outs[h]);
+			events[h].push_back(e);
+		}
+		// the merge takes the earliest time, and the first host of a tie
+		std::vector<size_t> next(num_hosts);
+		for (uint64_t i = 0; i < num_records; ++i) {
+			int best = -1;
+			for (int h = 0; h < num_hosts; ++h) {
+				if (next[h] < events[h].size() && (best < 0 ||
+					events[h][next[h]].created_time <
+					events[best][next[best]].created_time)) {
+					best = h;
+				}
+			}
+			merged.push_back(events[best][next[best]++]);
+		}
+	}
+
+	~HostFiles() {
+		for (std::string const& f : filenames) {
+			remove(f.c_str());
+		}
+	}
+};
+
+TEST(MergedInputTest, MergesByTime) {
+	WorkloadConfig config;
+	config.num_users = 500;
+	config.rate = 50;
+	config.burst = 4;
+	HostFiles const hosts(5, 20000, config);
+
+	MergedInput merged(hosts.filenames, false);
+	VenmoRecordReader::Status status;
+	VenmoRecord const* rec;
+	size_t n = 0;
+	char name[64];
+	while (merged.next(status, rec)) {
+		ASSERT_LT(n, hosts.merged.size());
+		ASSERT_EQ(status, VenmoRecordReader::ok);
+		WorkloadGenerator::Event const& e = hosts.merged[n++];
+		EXPECT_EQ(rec->created_time, e.created_time);
+		EXPECT_EQ(rec->actor, std::string(name, WorkloadGenerator::user_name(name, e.actor)));
+		EXPECT_EQ(rec->target, std::string(name, WorkloadGenerator::user_name(name, e.target)));
+	}
+	EXPECT_EQ(n, hosts.merged.size());
+	EXPECT_TRUE(merged.errors().empty());
+}
+
+TEST(MergedInputTest, DropsNoLateRecords) {
+	WorkloadConfig config;
+	config.num_users = 500;
+	config.rate = 50;
+	HostFiles const hosts(3, 10000, config);
+
+	// the same records, one file after another, are mostly too late
+	{
+		std::ofstream ofs("merged_test_concatenated.txt", std::ofstream::binary);
+		for (std::string const& f : hosts.filenames) {
+			ofs << read_file(f.c_str());
+		}
+	}
+	MedDegStream concatenated("merged_test_concatenated.txt", "merged_test_output.txt");
+	concatenated.process();
+	EXPECT_GT(counter(concatenated.metrics(), "rolling_median_dropped_total"), 1000);
+
+	MedDegStream merged(hosts.filenames, "merged_test_output.txt");
+	merged.process();
+	EXPECT_EQ(counter(merged.metrics(), "rolling_median_dropped_total"), 0);
+	EXPECT_EQ(counter(merged.metrics(), "rolling_median_late_total"), 0);
+
+	// and are read in the order of the merge
+	{
+		WorkloadGenerator const writer((WorkloadConfig()));
+		std::ofstream ofs("merged_test_concatenated.txt", std::ofstream::binary);
+		OutputBuffer out(ofs);
+		for (WorkloadGenerator::Event const& e : hosts.merged) {
+			writer.write(e, out);
+		}
+	}
+	std::string const merged_output = read_file("merged_test_output.txt");
+	{
+		MedDegStream sorted("merged_test_concatenated.txt", "merged_test_output.txt");
+		sorted.process();
+	}
+	EXPECT_TRUE(read_file("merged_test_output.txt") == merged_output);
+	remove("merged_test_concatenated.txt");
+	remove("merged_test_output.txt");
+}
+
+TEST(MergedInputTest, ReportsBadRecordsAndFiles) {
+	{
+		std::ofstream a("merged_test_a.txt", std::ofstream::binary);
+		a << "{\"created_time\": \"2016-03-28T23:23:12Z\", \"target\": \"A\", \"actor\": \"B\"}\n"
+			 "{\"created_time\": \"2016-03-28T23:23:20Z\", \"target\": \"A\", \"actor\": \"C\"}\n";
+		std::ofstream b("merged_test_b.txt", std::ofstream::binary);
+		b << "{\"created_time\": \"2016-03-28T23:23:15Z\", \"target\": \"D\", \"actor\": \"E\"}\n"
+			 "not json\n"
+			 "{\"created_time\": \"2016-03-28T23:23:25Z\", \"target\": \"A\", \"actor\": \"E\"}";
+	}
+	std::vector<std::string> const files = {
+		"merged_test_a.txt", "merged_test_b.txt", "merged_test_none.txt" };
+	testing::internal::CaptureStdout();
+	{
+		MedDegStream mds(files, "merged_test_output.txt", MedDegStream::json,
+						 MedDegStream::json_lines);
+		mds.process();
+	}
+	std::string const messages = testing::internal::GetCapturedStdout();
+	EXPECT_NE(messages.find("cannot read merged_test_none.txt"), std::string::npos);
+	EXPECT_EQ(std::count(messages.begin(), messages.end(), '\n'), 2);
+	std::string const output = read_file("merged_test_output.txt");
+	EXPECT_EQ(std::count(output.begin(), output.end(), '\n'), 4);
+	EXPECT_NE(output.find("\"2016-03-28T23:23:15Z\""), std::string::npos);
+	EXPECT_LT(output.find("23:23:15Z"), output.find("23:23:20Z"));
+	EXPECT_LT(output.find("23:23:20Z"), output.find("23:23:25Z"));
+	remove("merged_test_a.txt");
+	remove("merged_test_b.txt");
+	remove("merged_test_output.txt");
+}
+
+TEST(MergedInputTest, MergesBinaryRecords) {
+	WorkloadConfig config;
+	config.num_users = 100;
+	config.format = WorkloadConfig::cbor;
+	HostFiles const hosts(2, 3000, config);
+	MergedInput merged(hosts.filenames, true, BinaryRecordReader::cbor);
+	VenmoRecordReader::Status status;
+	VenmoRecord const* rec;
+	size_t n = 0;
+	while (merged.next(status, rec)) {
+		ASSERT_EQ(status, VenmoRecordReader::ok);
+		EXPECT_EQ(rec->created_time, hosts.merged[n++].created_time);
+	}
+	EXPECT_EQ(n, 3000u);
+}
+
+TEST(MergedInputTest, ExpandsDirectories) {
+	mkdir("merged_test_dir", 0755);
+	mkdir("merged_test_dir/sub", 0755);
+	for (char const* f : { "merged_test_dir/b.txt", "merged_test_dir/a.txt",
+						   "merged_test_dir/.hidden" }) {
+		std::ofstream ofs(f);
+	}
+	std::vector<std::string> const files = MergedInput::expand(
+		{ "x.txt", "merged_test_dir", "y.txt" });
+	std::vector<std::string> const expected = {
+		"x.txt", "merged_test_dir/a.txt", "merged_test_dir/b.txt", "y.txt" };
+	EXPECT_EQ(files, expected);
+	remove("merged_test_dir/a.txt");
+	remove("merged_test_dir/b.txt");
+	remove("merged_test_dir/.hidden");
+	rmdir("merged_test_dir/sub");
+	rmdir("merged_test_dir");
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "victor/metrics.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+
+
+namespace victor {
+
+std::string read_file(char const* filename) {
+	std::ifstream ifs(filename, std::ifstream::binary);
+	return std::string((std::istreambuf_iterator<char>(ifs)),
+					   std::istreambuf_iterator<char>());
+}
+
+/**
+	Parse samples of the Prometheus text format, checking that each has a
+	HELP and a TYPE line before it.
+*/
+std::map<std::string, double> parse_samples(std::string const& text) {
+	std::map<std::string, double> samples;
+	std::istringstream in(text);
+	std::string help, type, sample;
+	while (std::getline(in, help)) {
+		EXPECT_TRUE(std::getline(in, type));
+		EXPECT_TRUE(std::getline(in, sample));
+		std::string const name = sample.substr(0, sample.find(' '));
+		EXPECT_EQ(help.compare(0, 8 + name.size(), "# HELP " + name + " "), 0) << help;
+		EXPECT_TRUE(type == "# TYPE " + name + " counter" ||
+					type == "# TYPE " + name + " gauge") << type;
+		samples[name] = strtod(sample.c_str() + name.size() + 1, nullptr);
+	}
+	return samples;
+}
+
+TEST(MetricsTest, WritesPrometheusText) {
+	PrometheusText t;
+	t.counter("x_total", "Some xs.", 18446744073709551615u);
+	t.gauge("y", "A y.", uint64_t(3));
+	t.gauge("z", "A z.", 2.5);
+	t.gauge("w", "A w.", std::numeric_limits<double>::quiet_NaN());
+	EXPECT_EQ(t.str(),
+			  "# HELP x_total Some xs.\n# TYPE x_total counter\n"
+			  "x_total 18446744073709551615\n"
+			  "# HELP y A y.\n# TYPE y gauge\ny 3\n"
+			  "# HELP z A z.\n# TYPE z gauge\nz 2.5\n"
+			  "# HELP w A w.\n# TYPE w gauge\nw NaN\n");
+}
+
+TEST(MetricsTest, ReplacesFile) {
+	MetricsFile file("metrics_test.prom", 3600);
+	EXPECT_TRUE(file.due());
+	EXPECT_TRUE(file.write("a 1\n"));
+	EXPECT_FALSE(file.due());
+	EXPECT_TRUE(file.write("b 2\n"));
+	EXPECT_EQ(read_file("metrics_test.prom"), "b 2\n");
+	EXPECT_EQ(fopen("metrics_test.prom.tmp", "rb"), nullptr)
+		<< "The temporary file should be renamed.";
+	remove("metrics_test.prom");
+
+	MetricsFile bad("no_such_directory/metrics_test.prom", 1);
+	EXPECT_FALSE(bad.write("a 1\n"));
+}
+
+TEST(MetricsTest, MedDegStreamCounts) {
+	{
+		MedDegStream mds("../data-gen/venmo-trans.txt", "metrics_test_output.txt");
+		mds.export_metrics("metrics_test.prom", 3600);
+		mds.process();
+	}
+	std::map<std::string, double> m = parse_samples(read_file("metrics_test.prom"));
+	remove("metrics_test.prom");
+	remove("metrics_test_output.txt");
+
+	EXPECT_EQ(m["rolling_median_records_total"], 1792);
+	EXPECT_EQ(m["rolling_median_records_skipped_total"], 0);
+	// every payment is added, updates an edge, is to oneself, or is dropped
+	EXPECT_EQ(m["rolling_median_edges_inserted_total"] +
+			  m["rolling_median_edges_updated_total"] +
+			  m["rolling_median_self_payments_total"] +
+			  m["rolling_median_dropped_total"], 1792);
+	EXPECT_EQ(m["rolling_median_edges_inserted_total"] -
+			  m["rolling_median_edges_expired_total"], m["rolling_median_edges"]);
+	EXPECT_GT(m["rolling_median_edges_expired_total"], 0);
+	EXPECT_GT(m["rolling_median_late_total"], 0);
+	EXPECT_GT(m["rolling_median_heap_rotations_total"], 0);
+	EXPECT_GT(m["rolling_median_heap_swaps_total"], 0);
+	EXPECT_GT(m["rolling_median_vertices_erased_total"], 0);
+	EXPECT_GE(m["rolling_median_peak_vertices"], m["rolling_median_vertices"]);
+	EXPECT_GE(m["rolling_median_peak_edges"], m["rolling_median_edges"]);
+	EXPECT_GT(m["rolling_median_median"], 0);
+}
+
+}  // namespace victor
\ No newline at end of file
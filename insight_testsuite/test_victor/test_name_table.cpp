@@ -0,0 +1,130 @@
+#include "victor/name_table.hpp"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+TEST(NameTableTest, InternWorks) {
+	NameTable names;
+	NameTable::Id adam = names.intern("Adam-West");
+	NameTable::Id oak = names.intern("Professor-Oak");
+	ASSERT_NE(adam, oak);
+	ASSERT_EQ(names.size(), 2);
+
+	EXPECT_EQ(names.intern("Adam-West"), adam) <<
+		"Interning a name twice should return the same id.";
+	EXPECT_EQ(names.find("Professor-Oak"), oak);
+	EXPECT_EQ(names.name(adam), "Adam-West");
+	EXPECT_EQ(names.name(oak), "Professor-Oak");
+	EXPECT_TRUE(names.find("Shaggy") == NameTable::npos);
+	EXPECT_EQ(names.size(), 2);
+}
+
+TEST(NameTableTest, ReleaseRecyclesIds) {
+	NameTable names;
+	NameTable::Id adam = names.intern("Adam-West");
+	names.intern("Professor-Oak");
+
+	names.release(adam);
+	ASSERT_EQ(names.size(), 1);
+	ASSERT_TRUE(names.find("Adam-West") == NameTable::npos) <<
+		"Adam-West was released, but it can still be found.";
+
+	NameTable::Id shaggy = names.intern("Shaggy");
+	EXPECT_EQ(shaggy, adam) << "Released id was not reused.";
+	EXPECT_EQ(names.name(shaggy), "Shaggy");
+	EXPECT_EQ(names.id_capacity(), 2);
+}
+
+TEST(NameTableTest, MemoryBoundedByLiveNames) {
+	NameTable names;
+	std::vector<NameTable::Id> live;
+	size_t peak_slots = 0;
+
+	// 1000 generations of 100 short-lived names each: the id space and the
+	// hash table should stay the size of one generation, not of all
+	// 100000 names ever seen.
+	for (int gen = 0; gen < 1000; ++gen) {
+		for (int i = 0; i < 100; ++i) {
+			live.push_back(names.intern("user-" + std::to_string(gen) +
+										"-" + std::to_string(i)));
+		}
+		for (NameTable::Id id : live) {
+			names.release(id);
+		}
+		live.clear();
+		if (names.num_slots() > peak_slots) {
+			peak_slots = names.num_slots();
+		}
+	}
+	EXPECT_EQ(names.size(), 0);
+	EXPECT_LE(names.id_capacity(), 100);
+	EXPECT_LE(peak_slots, 2048);
+}
+
+TEST(NameTableTest, CompactionKeepsNamesFindable) {
+	NameTable names;
+	std::vector<NameTable::Id> ids;
+	for (int i = 0; i < 5000; ++i) {
+		ids.push_back(names.intern("user-" + std::to_string(i)));
+	}
+	// shrink to a tenth; the table compacts while names come and go
+	for (int i = 0; i < 4500; ++i) {
+		names.release(ids[i]);
+		for (int j = 4500; j < 5000; j += 97) {
+			ASSERT_EQ(names.find("user-" + std::to_string(j)), ids[j]) <<
+				"lost user-" << j << " after releasing " << i + 1 <<
+				" names";
+		}
+	}
+	while (names.compacting()) {
+		names.release(names.intern("temp"));
+	}
+	for (int i = 0; i < 5000; ++i) {
+		if (i < 4500) {
+			ASSERT_TRUE(names.find("user-" + std::to_string(i)) ==
+						NameTable::npos);
+		} else {
+			ASSERT_EQ(names.find("user-" + std::to_string(i)), ids[i]);
+		}
+	}
+	EXPECT_LT(names.num_slots(), 5000);
+}
+
+TEST(NameTableTest, GrowingLeavesNamesInPlace) {
+	NameTable names;
+	NameTable::Id const first = names.intern("a-name-longer-than-fifteen-bytes");
+	std::string const* const held = &names.name(first);
+	char const* const chars = held->data();
+	for (int i = 0; i < 5000; ++i) {
+		names.intern("user-" + std::to_string(i));
+	}
+	EXPECT_EQ(&names.name(first), held);
+	EXPECT_EQ(names.name(first).data(), chars);
+	EXPECT_EQ(names.find("a-name-longer-than-fifteen-bytes"), first);
+}
+
+TEST(NameTableTest, FindsNamesInPlace) {
+	NameTable names;
+	// names in a buffer, with no '\0' after them
+	char const line[] = "Adam-WestProfessor-Oak";
+	StringRef const adam_ref(line, 9);
+	StringRef const oak_ref(line + 9, 13);
+	EXPECT_TRUE(adam_ref == StringRef("Adam-West"));
+	EXPECT_TRUE(adam_ref != oak_ref);
+	EXPECT_TRUE(StringRef(line, 4) != StringRef("Adam-West"));
+
+	bool inserted;
+	NameTable::Id adam = names.intern(adam_ref, inserted);
+	EXPECT_TRUE(inserted);
+	EXPECT_EQ(names.intern(std::string("Adam-West"), inserted), adam);
+	EXPECT_FALSE(inserted);
+	NameTable::Id oak = names.intern(oak_ref);
+	EXPECT_EQ(names.name(oak), "Professor-Oak");
+	EXPECT_EQ(names.find(StringRef(line, 9)), adam);
+	EXPECT_TRUE(names.find(StringRef(line, 8)) == NameTable::npos);
+}
+
+}  // namespace victor
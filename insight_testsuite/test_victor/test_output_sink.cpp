@@ -0,0 +1,218 @@
+#include "victor/output_sink.hpp"
+#include "victor/venmo_record.hpp"
+#include "json/json.hpp"
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <clocale>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+
+namespace victor {
+
+template <typename T>
+std::string format(char* (*f)(char*, T), T v) {
+	char buf[400];
+	return std::string(buf, f(buf, v));
+}
+
+std::string shortest(double d) {
+	return format(&NumberFormat::shortest, d);
+}
+
+std::string fixed2(double d) {
+	return format(&NumberFormat::fixed2, d);
+}
+
+/**
+	Significant digits of a number in JSON syntax.
+*/
+int significant_digits(std::string const& s) {
+	std::string digits;
+	for (char c : s.substr(0, s.find('e'))) {
+		if ('0' <= c && c <= '9') {
+			digits += c;
+		}
+	}
+	digits.erase(0, digits.find_first_not_of('0'));
+	while (digits.size() > 1 && digits.back() == '0') {
+		digits.pop_back();
+	}
+	return int(digits.size());
+}
+
+TEST(NumberFormatTest, Integers) {
+	EXPECT_EQ(format<uint64_t>(&NumberFormat::integer, 0), "0");
+	EXPECT_EQ(format<uint64_t>(&NumberFormat::integer, 9), "9");
+	EXPECT_EQ(format<uint64_t>(&NumberFormat::integer, 10), "10");
+	EXPECT_EQ(format<uint64_t>(&NumberFormat::integer, 100), "100");
+	EXPECT_EQ(format<uint64_t>(&NumberFormat::integer, 18446744073709551615u),
+			  "18446744073709551615");
+	EXPECT_EQ(format<int64_t>(&NumberFormat::integer, -1), "-1");
+	EXPECT_EQ(format<int64_t>(&NumberFormat::integer,
+			  std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+}
+
+TEST(NumberFormatTest, FixedMatchesPrintf) {
+	std::mt19937_64 rng(1);
+	std::vector<double> values = {
+		0, -0.0, 0.5, 1, 2.5, 0.005, 0.015, 0.125, 0.07, 0.29, 1e15, 1e300,
+		std::numeric_limits<double>::max(), std::numeric_limits<double>::infinity()
+	};
+	for (int i = 0; i < 10000; ++i) {
+		values.push_back(double(rng() % 2000000) / 2);
+		values.push_back(double(rng() % 100000000) / 1000);
+		uint64_t const bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		values.push_back(d);
+	}
+	for (double d : values) {
+		char expected[400];
+		snprintf(expected, sizeof(expected), "%.2f", d);
+		EXPECT_EQ(fixed2(d), expected);
+	}
+}
+
+TEST(NumberFormatTest, ShortestRoundTrips) {
+	EXPECT_EQ(shortest(0.1), "0.1");
+	EXPECT_EQ(shortest(1.5), "1.5");
+	EXPECT_EQ(shortest(2), "2.0");
+	EXPECT_EQ(shortest(-0.0), "-0.0");
+	EXPECT_EQ(shortest(1e23), "1e+23");
+	EXPECT_EQ(shortest(5e-324), "5e-324");
+	EXPECT_EQ(shortest(std::numeric_limits<double>::max()),
+			  "1.7976931348623157e+308");
+	EXPECT_EQ(shortest(std::numeric_limits<double>::quiet_NaN()), "null");
+
+	std::mt19937_64 rng(2);
+	for (int i = 0; i < 20000; ++i) {
+		uint64_t const bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		if (i % 2 != 0) {
+			d = double(rng() % 100000000) / pow(10.0, double(rng() % 12));
+		}
+		if (!std::isfinite(d) || d == 0) {
+			continue;
+		}
+		std::string const s = shortest(d);
+		EXPECT_EQ(strtod(s.c_str(), nullptr), d) << s;
+		int fewest = 17;
+		for (int n = 1; n < 17; ++n) {
+			char buf[32];
+			snprintf(buf, sizeof(buf), "%.*e", n - 1, d);
+			if (strtod(buf, nullptr) == d) {
+				fewest = n;
+				break;
+			}
+		}
+		EXPECT_EQ(significant_digits(s), fewest) << s;
+	}
+}
+
+TEST(NumberFormatTest, IgnoresLocale) {
+	// a locale with a decimal comma, where available
+	std::string const old = setlocale(LC_NUMERIC, nullptr);
+	if (setlocale(LC_NUMERIC, "de_DE.UTF-8") == nullptr) {
+		setlocale(LC_NUMERIC, "de_DE");
+	}
+	std::string const a = fixed2(0.001);
+	std::string const b = shortest(1.0 / 3);
+	std::string const c = shortest(1e-300);
+	setlocale(LC_NUMERIC, old.c_str());
+	EXPECT_EQ(a, "0.00");
+	EXPECT_EQ(b, "0.3333333333333333");
+	EXPECT_EQ(c, "1e-300");
+}
+
+TEST(NumberFormatTest, IsoTimeRoundTrips) {
+	std::mt19937_64 rng(3);
+	for (int i = 0; i < 10000; ++i) {
+		// years 0000 through 9999
+		time_t const t = time_t(int64_t(rng() % 315537897600) - 62167219200);
+		std::string const s = format(&NumberFormat::iso_time, t);
+		time_t back;
+		ASSERT_TRUE(VenmoRecordReader::parse_time(s.c_str(), back)) << s;
+		EXPECT_EQ(back, t) << s;
+	}
+	EXPECT_EQ(format<time_t>(&NumberFormat::iso_time, 1459207392),
+			  "2016-03-28T23:23:12Z");
+	EXPECT_EQ(format<time_t>(&NumberFormat::iso_time, -1), "1969-12-31T23:59:59Z");
+}
+
+TEST(OutputSinkTest, TextMatchesIostream) {
+	std::ostringstream expected;
+	expected.setf(std::ios::fixed, std::ios::floatfield);
+	expected.precision(2);
+	std::ostringstream actual;
+	{
+		TextSink sink(actual);
+		MedianEvent e;
+		for (int i = 0; i < 100000; ++i) {
+			e.median = double(i % 777) / 2;
+			expected << e.median << '\n';
+			sink.write(e);
+		}
+	}
+	EXPECT_EQ(actual.str(), expected.str());
+}
+
+TEST(OutputSinkTest, JsonLinesParse) {
+	std::ostringstream out;
+	{
+		JsonLinesSink<MedianEvent> sink(out);
+		MedianEvent e;
+		for (int i = 0; i < 100000; ++i) {
+			e.created_time = 1459207392 + i;
+			e.median = double(i % 777) / 2;
+			e.num_vertices = size_t(i);
+			e.num_edges = size_t(i) * 3;
+			sink.write(e);
+		}
+	}
+	std::istringstream in(out.str());
+	std::string line;
+	int i = 0;
+	for (; std::getline(in, line); ++i) {
+		nlohmann::json const j = nlohmann::json::parse(line);
+		ASSERT_EQ(j.size(), 4u) << line;
+		time_t t;
+		ASSERT_TRUE(VenmoRecordReader::parse_time(
+			j["created_time"].get<std::string>().c_str(), t)) << line;
+		EXPECT_EQ(t, 1459207392 + i);
+		EXPECT_TRUE(j["median"].is_number_float()) << line;
+		EXPECT_EQ(j["median"].get<double>(), double(i % 777) / 2);
+		EXPECT_EQ(j["vertices"].get<uint64_t>(), uint64_t(i));
+		EXPECT_EQ(j["edges"].get<uint64_t>(), uint64_t(i) * 3);
+	}
+	EXPECT_EQ(i, 100000);
+}
+
+TEST(OutputSinkTest, ShortWritesMarkTheStreamBad) {
+	std::ofstream full("/dev/full", std::ofstream::binary);
+	ASSERT_TRUE(full.good());
+	{
+		// past the stream buffer's own buffer, so it writes straight through
+		OutputBuffer out(full, 1 << 16);
+		out.write(std::string(1 << 16, 'x').data(), 1 << 16);
+		out.flush();
+		EXPECT_FALSE(full.good());
+	}
+	std::ostringstream ss;
+	{
+		OutputBuffer out(ss, 4);
+		out.write("abcdefgh", 8);
+	}
+	EXPECT_EQ(ss.str(), "abcdefgh");
+	EXPECT_TRUE(ss.good());
+}
+
+}  // namespace victor
\ No newline at end of file
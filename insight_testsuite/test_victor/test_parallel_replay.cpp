@@ -0,0 +1,150 @@
+#include "victor/parallel_replay.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "victor/workload.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <zlib.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+
+namespace victor {
+
+std::string read_file(char const* filename) {
+	std::ifstream ifs(filename, std::ifstream::binary);
+	return std::string((std::istreambuf_iterator<char>(ifs)),
+					   std::istreambuf_iterator<char>());
+}
+
+void write_file(char const* filename, std::string const& text) {
+	std::ofstream ofs(filename, std::ofstream::binary);
+	ofs << text;
+}
+
+/**
+	Run a file sequentially and in parallel in every way, and check that the
+	medians and the messages are the same.
+*/
+void expect_same_as_sequential(char const* filename, MedDegStream::Output output) {
+	testing::internal::CaptureStdout();
+	{
+		MedDegStream mds(filename, "replay_test_sequential.txt",
+						 MedDegStream::json, output);
+		mds.process();
+	}
+	std::string const messages = testing::internal::GetCapturedStdout();
+	std::string const medians = read_file("replay_test_sequential.txt");
+	remove("replay_test_sequential.txt");
+
+	for (unsigned threads : { 1, 2, 3, 7, 16 }) {
+		for (size_t block_size : { 1, 4096, 1 << 16 }) {
+			// one chunk per thread, and, on two threads, more chunks than
+			// threads, which may be done out of order
+			for (size_t chunk_size : { size_t(1) << 26, size_t(1) << 18 }) {
+				if (chunk_size < (size_t(1) << 26) && threads != 2) {
+					continue;
+				}
+				testing::internal::CaptureStdout();
+				ParallelReplay replay(filename, "replay_test_parallel.txt", threads,
+									  output, block_size, chunk_size);
+				EXPECT_TRUE(replay.process());
+				EXPECT_EQ(testing::internal::GetCapturedStdout(), messages)
+					<< threads << " threads, blocks of " << block_size
+					<< ", chunks of " << chunk_size;
+				EXPECT_TRUE(read_file("replay_test_parallel.txt") == medians)
+					<< threads << " threads, blocks of " << block_size
+					<< ", chunks of " << chunk_size;
+				remove("replay_test_parallel.txt");
+			}
+		}
+	}
+}
+
+TEST(ParallelReplayTest, MatchesSequentialRun) {
+	WorkloadConfig config;
+	config.num_users = 2000;
+	config.rate = 100;
+	config.burst = 3;
+	config.out_of_order = 0.2;
+	config.out_of_window = 0.05;
+	config.malformed = 0.01;
+	{
+		std::ofstream ofs("replay_test_input.txt", std::ofstream::binary);
+		OutputBuffer out(ofs);
+		WorkloadGenerator generator(config);
+		generator.generate(10000, out);
+	}
+	expect_same_as_sequential("replay_test_input.txt", MedDegStream::text);
+	expect_same_as_sequential("replay_test_input.txt", MedDegStream::json_lines);
+	remove("replay_test_input.txt");
+}
+
+TEST(ParallelReplayTest, HandlesEdgeCases) {
+	char const* const record =
+		"{\"created_time\": \"2016-03-28T23:23:12Z\", \"target\": \"A\", \"actor\": \"B\"}\n";
+	// a late payment at the very start of a chunk, a jump ahead, a payment
+	// too late, and a last line with no newline
+	std::string const text = std::string(record) +
+		"{\"created_time\": \"2016-03-28T23:23:50Z\", \"target\": \"A\", \"actor\": \"C\"}\n"
+		"{\"created_time\": \"2016-03-28T23:23:13Z\", \"target\": \"C\", \"actor\": \"D\"}\n"
+		"not json\n"
+		"\n"
+		"{\"created_time\": \"2016-03-29T23:23:12Z\", \"target\": \"E\", \"actor\": \"F\"}\n"
+		"{\"created_time\": \"2016-03-29T23:22:12Z\", \"target\": \"E\", \"actor\": \"G\"}\n"
+		"{\"created_time\": \"2016-03-29T23:23:12Z\", \"target\": \"G\", \"actor\": \"G\"}\n"
+		"{\"created_time\": \"2016-03-29T23:23:11Z\", \"target\": \"F\", \"actor\": \"G\"}";
+	write_file("replay_test_input.txt", text);
+	expect_same_as_sequential("replay_test_input.txt", MedDegStream::json_lines);
+
+	write_file("replay_test_input.txt", "");
+	expect_same_as_sequential("replay_test_input.txt", MedDegStream::text);
+	remove("replay_test_input.txt");
+}
+
+TEST(ParallelReplayTest, ReadsMappedAndCompressedInput) {
+	WorkloadConfig config;
+	config.num_users = 300;
+	config.malformed = 0.01;
+	std::string text;
+	{
+		std::ostringstream oss;
+		{
+			OutputBuffer out(oss);
+			WorkloadGenerator generator(config);
+			generator.generate(1000, out);
+		}
+		text = oss.str();
+	}
+	// a whole number of pages, with no byte past the last line mapped
+	text.resize(text.size() / 4096 * 4096);
+	text.back() = '\n';
+	write_file("replay_test_input.txt", text);
+	expect_same_as_sequential("replay_test_input.txt", MedDegStream::text);
+
+	gzFile const gz = gzopen("replay_test_input.txt.gz", "wb");
+	ASSERT_TRUE(gz != nullptr);
+	gzwrite(gz, text.data(), unsigned(text.size()));
+	gzclose(gz);
+	expect_same_as_sequential("replay_test_input.txt.gz", MedDegStream::json_lines);
+
+	// an output that can't be written fails the run
+	testing::internal::CaptureStdout();
+	ParallelReplay replay("replay_test_input.txt", "/dev/full", 3);
+	EXPECT_FALSE(replay.process());
+	std::string const messages = testing::internal::GetCapturedStdout();
+	EXPECT_NE(messages.find("cannot write /dev/full\n"), std::string::npos);
+
+	// and so does an input that can't be read
+	testing::internal::CaptureStdout();
+	ParallelReplay missing("replay_test_missing.txt", "replay_test_output.txt", 3);
+	EXPECT_FALSE(missing.process());
+	EXPECT_EQ(testing::internal::GetCapturedStdout(),
+			  "cannot read replay_test_missing.txt\n");
+	remove("replay_test_output.txt");
+	remove("replay_test_input.txt");
+	remove("replay_test_input.txt.gz");
+}
+
+}  // namespace victor
\ No newline at end of file
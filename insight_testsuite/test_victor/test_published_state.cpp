@@ -0,0 +1,192 @@
+#include "victor/published_state.hpp"
+#include "victor/venmo_graph.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+
+namespace victor {
+
+GraphState read(PublishedState const& state) {
+	GraphState s;
+	EXPECT_TRUE(state.read(s));
+	return s;
+}
+
+TEST(PublishedStateTest, PublishesEveryPayment) {
+	PublishedState state;
+	GraphState s = read(state);
+	EXPECT_EQ(s.payments, 0u);
+	EXPECT_EQ(s.latest_time, 0);
+
+	VenmoGraph graph;
+	graph.publish_to(&state);
+	struct { char const* actor; char const* target; time_t t; } const payments[] = {
+		{ "A", "B", 1000 }, { "B", "C", 1010 }, { "C", "C", 1020 },
+		{ "D", "A", 900 }, { "E", "F", 1075 } };
+	uint64_t n = 0;
+	for (auto const& p : payments) {
+		double const median = graph.extract_median(p.actor, p.target, p.t);
+		s = read(state);
+		EXPECT_EQ(s.payments, ++n);
+		EXPECT_EQ(state.version(), n);
+		EXPECT_EQ(s.median, median);
+		EXPECT_EQ(s.num_vertices, graph.num_vertices());
+		EXPECT_EQ(s.num_edges, graph.num_edges());
+	}
+	EXPECT_EQ(s.latest_time, 1075);
+	EXPECT_EQ(s.num_edges, 1u);		// the first two expired
+
+	graph.publish_to(nullptr);
+	graph.extract_median("G", "H", 1080);
+	EXPECT_EQ(read(state).payments, n);
+}
+
+TEST(PublishedStateTest, ReadersSeeWholeSnapshots) {
+	PublishedState state;
+	uint64_t const writes = 2000000;
+	std::atomic<bool> done(false);
+	std::atomic<uint64_t> torn(0);
+	std::atomic<uint64_t> reads(0);
+	auto const reader = [&]() {
+		uint64_t last = 0;
+		GraphState s;
+		while (!done.load()) {
+			if (!state.try_read(s)) {
+				continue;
+			}
+			// every field is worked out from the same number, bar the
+			// empty state before the first write
+			uint64_t const i = s.payments;
+			if ((i != 0 && (uint64_t(s.latest_time) != i || s.median != double(i) / 2 ||
+				 s.num_vertices != 3 * i || s.num_edges != (i ^ 0x5555))) || i < last) {
+				++torn;
+			}
+			last = i;
+			++reads;
+		}
+	};
+	std::thread r1(reader);
+	std::thread r2(reader);
+	GraphState s;
+	for (uint64_t i = 1; i <= writes; ++i) {
+		s.latest_time = time_t(i);
+		s.median = double(i) / 2;
+		s.num_vertices = 3 * i;
+		s.num_edges = i ^ 0x5555;
+		s.payments = i;
+		state.publish(s);
+	}
+	while (reads.load() < 2) {
+		std::this_thread::yield();
+	}
+	done = true;
+	r1.join();
+	r2.join();
+	EXPECT_EQ(torn.load(), 0u);
+	EXPECT_EQ(read(state).payments, writes);
+	EXPECT_EQ(state.version(), writes);
+}
+
+TEST(PublishedStateTest, GivesUpOnAnUnfinishedWrite) {
+	PublishedState state;
+	GraphState s;
+	s.payments = 3;
+	state.publish(s);
+	// the sequence number left odd, as by a writer that died in publish()
+	std::atomic<uint64_t>* const words = reinterpret_cast<std::atomic<uint64_t>*>(&state);
+	words[1].fetch_add(1);
+	GraphState got;
+	got.payments = 99;
+	std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+	EXPECT_FALSE(state.read(got, 0.05));
+	EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+	EXPECT_EQ(got.payments, 99u);
+	EXPECT_FALSE(state.try_read(got));
+
+	// a write finished later is read again
+	words[1].fetch_add(1);
+	EXPECT_TRUE(state.read(got));
+	EXPECT_EQ(got.payments, 3u);
+}
+
+TEST(PublishedStateTest, SharesAFileWithAnotherProcess) {
+	{
+		PublishedStateFile writer("state_test.bin", true);
+		ASSERT_TRUE(writer.is_open()) << writer.error();
+		GraphState s;
+		s.latest_time = 1459207392;
+		s.median = 1.5;
+		s.num_vertices = 4;
+		s.num_edges = 3;
+		s.payments = 7;
+		writer.state()->publish(s);
+
+		pid_t const child = fork();
+		ASSERT_GE(child, 0);
+		if (child == 0) {
+			PublishedStateFile reader("state_test.bin", false);
+			bool const same = reader.is_open() &&
+				read(*reader.state()).median == 1.5 &&
+				read(*reader.state()).payments == 7;
+			_exit(same ? 0 : 1);
+		}
+		int status;
+		ASSERT_EQ(waitpid(child, &status, 0), child);
+		EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	}
+	// the last state outlives the writer
+	PublishedStateFile reader("state_test.bin", false);
+	ASSERT_TRUE(reader.is_open()) << reader.error();
+	EXPECT_EQ(read(*reader.state()).latest_time, 1459207392);
+	EXPECT_EQ(read(*reader.state()).num_edges, 3u);
+	remove("state_test.bin");
+
+	PublishedStateFile missing("state_test_none.bin", false);
+	EXPECT_FALSE(missing.is_open());
+	EXPECT_NE(missing.error().find("cannot open state_test_none.bin"), std::string::npos);
+	{
+		std::ofstream ofs("state_test.txt");
+		ofs << "not a state";
+	}
+	PublishedStateFile other("state_test.txt", false);
+	EXPECT_FALSE(other.is_open());
+	EXPECT_EQ(other.error(), "state_test.txt holds no published state");
+	remove("state_test.txt");
+}
+
+TEST(PublishedStateTest, StreamPublishesItsGraph) {
+	{
+		std::ofstream ofs("state_test_input.txt");
+		ofs << "{\"created_time\": \"2016-03-28T23:23:12Z\", \"target\": \"A\", \"actor\": \"B\"}\n"
+			   "{\"created_time\": \"2016-03-28T23:23:20Z\", \"target\": \"A\", \"actor\": \"C\"}\n"
+			   "not json\n"
+			   "{\"created_time\": \"2016-03-28T23:21:20Z\", \"target\": \"D\", \"actor\": \"C\"}\n";
+	}
+	testing::internal::CaptureStdout();
+	{
+		MedDegStream mds("state_test_input.txt", "state_test_output.txt");
+		ASSERT_TRUE(mds.publish_state("state_test.bin"));
+		mds.process();
+	}
+	testing::internal::GetCapturedStdout();
+	PublishedStateFile reader("state_test.bin", false);
+	ASSERT_TRUE(reader.is_open()) << reader.error();
+	GraphState const s = read(*reader.state());
+	EXPECT_EQ(s.payments, 3u);		// the dropped one too, not the bad line
+	EXPECT_EQ(s.num_vertices, 3u);
+	EXPECT_EQ(s.num_edges, 2u);
+	EXPECT_EQ(s.median, 1.0);
+	remove("state_test_input.txt");
+	remove("state_test_output.txt");
+	remove("state_test.bin");
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "victor/query_server.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace victor {
+
+typedef nlohmann::json json;
+
+json ask(VenmoGraph const& graph, std::string const& query) {
+	std::string const reply = QueryServer::respond(graph, query);
+	EXPECT_EQ(reply.back(), '\n');
+	return json::parse(reply);
+}
+
+/**
+	@return JSON text in the form the server writes it, to compare with
+	a reply (gtest can't print a json).
+*/
+std::string normal(char const* text) {
+	return json::parse(text).dump();
+}
+
+/**
+	Connect to a socket, send it some text, and read everything it sends
+	back until it hangs up.
+*/
+std::string converse(char const* path, std::string const& text) {
+	int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	sockaddr_un addr = sockaddr_un();
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	if (connect(fd, reinterpret_cast<sockaddr const*>(&addr), sizeof addr) != 0) {
+		close(fd);
+		return "cannot connect";
+	}
+	for (size_t sent = 0; sent < text.size(); ) {
+		ssize_t const n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+		if (n <= 0) {
+			break;
+		}
+		sent += size_t(n);
+	}
+	shutdown(fd, SHUT_WR);
+	std::string reply;
+	char buf[4096];
+	ssize_t n;
+	while ((n = recv(fd, buf, sizeof buf, 0)) > 0) {
+		reply.append(buf, size_t(n));
+	}
+	close(fd);
+	return reply;
+}
+
+TEST(QueryServerTest, AnswersQueries) {
+	VenmoGraph graph;
+	EXPECT_EQ(ask(graph, "stats").dump(), normal(
+		"{\"vertices\":0,\"edges\":0,\"payments\":0}"));
+	EXPECT_EQ(ask(graph, "degree A")["degree"].get<uint64_t>(), 0u);
+
+	time_t const t = 1459207392;	// 2016-03-28T23:23:12Z
+	graph.extract_median("A", "B", t);
+	graph.extract_median("A", "C", t + 1);
+	graph.extract_median("A", "D", t + 2);
+	graph.extract_median("E", "D", t + 3);
+	graph.extract_median("Ann Lee", "B", t + 4);
+
+	EXPECT_EQ(ask(graph, "degree A").dump(), normal(
+		"{\"user\":\"A\",\"degree\":3,\"payments\":5}"));
+	EXPECT_EQ(ask(graph, "degree Ann Lee")["degree"].get<uint64_t>(), 1u);
+	EXPECT_EQ(ask(graph, "degree Z")["degree"].get<uint64_t>(), 0u);
+	EXPECT_EQ(ask(graph, "counterparties D").dump(), normal(
+		"{\"user\":\"D\",\"counterparties\":["
+		"{\"user\":\"A\",\"created_time\":\"2016-03-28T23:23:14Z\"},"
+		"{\"user\":\"E\",\"created_time\":\"2016-03-28T23:23:15Z\"}],"
+		"\"payments\":5}"));
+	EXPECT_EQ(ask(graph, "median")["median"].get<double>(), graph.vertices().median());
+	EXPECT_EQ(ask(graph, "quantile 0.99").dump(), normal(
+		"{\"quantile\":0.99,\"degree\":3,\"payments\":5}"));
+	EXPECT_EQ(ask(graph, "stats").dump(), normal(
+		"{\"latest_time\":\"2016-03-28T23:23:16Z\",\"median\":1.5,"
+		"\"vertices\":6,\"edges\":5,\"payments\":5}"));
+
+	for (char const* bad : { "", "degree", "degrees A", "median now",
+							 "quantile 2", "quantile x", "Quantile 0.5" }) {
+		EXPECT_EQ(ask(graph, bad).count("error"), 1u) << bad;
+	}
+}
+
+TEST(QueryServerTest, ServesClientsBetweenPayments) {
+	QueryServer server("query_test.sock");
+	ASSERT_TRUE(server.is_open()) << server.error();
+
+	VenmoGraph graph;
+	graph.extract_median("A", "B", 1459207392);
+	std::atomic<int> done(0);
+	std::string replies[3];
+	std::vector<std::thread> clients;
+	clients.emplace_back([&]() {
+		replies[0] = converse("query_test.sock", "degree A\r\nmedian\nfoo\n");
+		++done;
+	});
+	clients.emplace_back([&]() {
+		replies[1] = converse("query_test.sock", "stats\nstats\nquantile 0.5");
+		++done;
+	});
+	clients.emplace_back([&]() {
+		replies[2] = converse("query_test.sock", std::string(10000, 'x'));
+		++done;
+	});
+	// the graph's thread answers as it goes
+	while (done.load() < 3) {
+		server.answer(graph);
+		std::this_thread::yield();
+	}
+	for (std::thread& t : clients) {
+		t.join();
+	}
+	EXPECT_EQ(replies[0],
+		"{\"degree\":1,\"payments\":1,\"user\":\"A\"}\n"
+		"{\"median\":1,\"payments\":1}\n"
+		"{\"error\":\"unknown query: foo\",\"payments\":1}\n");
+	// a last line with no newline isn't a query
+	EXPECT_EQ(std::count(replies[1].begin(), replies[1].end(), '\n'), 2);
+	EXPECT_EQ(replies[2], "{\"error\":\"query too long\"}\n");
+}
+
+TEST(QueryServerTest, BoundsTheQueriesWaiting) {
+	QueryServer server("query_test.sock");
+	ASSERT_TRUE(server.is_open()) << server.error();
+
+	VenmoGraph graph;
+	graph.extract_median("A", "B", 1459207392);
+	std::string queries;
+	for (int i = 0; i < 2000; ++i) {
+		queries += "median\n";
+	}
+	std::atomic<bool> done(false);
+	std::string reply;
+	std::thread client([&]() {
+		reply = converse("query_test.sock", queries);
+		done = true;
+	});
+	// nothing is answered until all the queries are in
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+	size_t calls = 0;
+	while (!done.load()) {
+		server.answer(graph);
+		++calls;
+		std::this_thread::yield();
+	}
+	client.join();
+	EXPECT_GE(calls, 1024 / QueryServer::max_answered);
+	EXPECT_EQ(std::count(reply.begin(), reply.end(), '\n'), 1025);
+	// the replies owed come first, and the error last
+	std::string const error = "{\"error\":\"too many queries waiting\"}\n";
+	ASSERT_GT(reply.size(), error.size());
+	EXPECT_EQ(reply.find("error"), reply.size() - error.size() + 2);
+	EXPECT_EQ(reply.substr(reply.size() - error.size()), error);
+}
+
+TEST(QueryServerTest, ReportsBadPaths) {
+	QueryServer server("query_test_none/query.sock");
+	EXPECT_FALSE(server.is_open());
+	EXPECT_NE(server.error().find("cannot listen on query_test_none/query.sock"),
+			  std::string::npos);
+	QueryServer server2(std::string(200, 'x').c_str());
+	EXPECT_FALSE(server2.is_open());
+}
+
+TEST(QueryServerTest, ReplacesOnlySockets) {
+	{
+		QueryServer server("query_test.sock");
+		ASSERT_TRUE(server.is_open()) << server.error();
+	}
+	// a socket left behind by a server that died is replaced
+	int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	sockaddr_un addr = sockaddr_un();
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, "query_test.sock");
+	ASSERT_EQ(bind(fd, reinterpret_cast<sockaddr const*>(&addr), sizeof addr), 0);
+	close(fd);
+	{
+		QueryServer server("query_test.sock");
+		EXPECT_TRUE(server.is_open()) << server.error();
+	}
+
+	// a file given by mistake is not
+	FILE* const f = fopen("query_test.txt", "w");
+	ASSERT_TRUE(f != nullptr);
+	fputs("keep me\n", f);
+	fclose(f);
+	QueryServer server("query_test.txt");
+	EXPECT_FALSE(server.is_open());
+	EXPECT_EQ(server.error(), "not a socket, won't replace: query_test.txt");
+	char text[16] = {};
+	FILE* const g = fopen("query_test.txt", "r");
+	ASSERT_TRUE(g != nullptr);
+	EXPECT_TRUE(fgets(text, sizeof text, g) != nullptr);
+	fclose(g);
+	EXPECT_STREQ(text, "keep me\n");
+	remove("query_test.txt");
+}
+
+}  // namespace victor
\ No newline at end of file
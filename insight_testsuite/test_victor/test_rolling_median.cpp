@@ -0,0 +1,120 @@
+#include "victor/rolling_median.hpp"
+#include "victor/venmo_graph.hpp"
+#include "victor/workload.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+/**
+	Keeps every event written to it.
+*/
+struct EventLog {
+	std::vector<MedianEvent> events;
+
+	void write(MedianEvent const& e) {
+		events.push_back(e);
+	}
+};
+
+/**
+	Random payments, with names that all lie in one buffer.
+*/
+struct Payments {
+	std::string names;
+	std::vector<RollingMedian::Payment> payments;
+
+	explicit Payments(size_t n) {
+		WorkloadConfig config;
+		config.num_users = 200;
+		config.out_of_order = 0.1;
+		WorkloadGenerator generator(config);
+		std::vector<std::pair<size_t, size_t>> actors;
+		std::vector<std::pair<size_t, size_t>> targets;
+		std::vector<time_t> times;
+		WorkloadGenerator::Event e;
+		for (size_t i = 0; i < n; ++i) {
+			generator.next(e);
+			std::string const actor = "user-" + std::to_string(e.actor);
+			std::string const target = "user-" + std::to_string(e.target);
+			actors.emplace_back(names.size(), actor.size());
+			names += actor;
+			targets.emplace_back(names.size(), target.size());
+			names += target;
+			times.push_back(e.created_time);
+		}
+		for (size_t i = 0; i < n; ++i) {
+			RollingMedian::Payment const p = {
+				StringRef(names.data() + actors[i].first, actors[i].second),
+				StringRef(names.data() + targets[i].first, targets[i].second),
+				times[i] };
+			payments.push_back(p);
+		}
+	}
+};
+
+TEST(RollingMedianTest, MatchesTheGraph) {
+	Payments const p(20000);
+	RollingMedian rolling;
+	VenmoGraph graph;
+	EXPECT_EQ(rolling.median(), 0.0);
+	for (RollingMedian::Payment const& payment : p.payments) {
+		double const median = rolling.push(payment.actor, payment.target,
+										   payment.created_time);
+		ASSERT_EQ(median, graph.extract_median(payment.actor.str(),
+			payment.target.str(), payment.created_time));
+		ASSERT_EQ(rolling.median(), median);
+	}
+	EXPECT_EQ(rolling.graph().num_vertices(), graph.num_vertices());
+	EXPECT_EQ(rolling.graph().num_edges(), graph.num_edges());
+	EXPECT_EQ(rolling.graph().payments(), p.payments.size());
+}
+
+TEST(RollingMedianTest, WritesToSinksAndCallbacks) {
+	Payments const p(5000);
+	RollingMedian::Payment const* const first = p.payments.data();
+	RollingMedian::Payment const* const last = first + p.payments.size();
+
+	// one at a time, to a sink
+	EventLog expected;
+	RollingMedian rolling;
+	for (RollingMedian::Payment const* it = first; it != last; ++it) {
+		rolling.push(it->actor, it->target, it->created_time, expected);
+	}
+	ASSERT_EQ(expected.events.size(), p.payments.size());
+
+	// in a batch, to a sink
+	EventLog batch;
+	RollingMedian rolling2;
+	EXPECT_EQ(rolling2.push(first, last, batch), rolling.median());
+
+	// in two batches, to a callback
+	EventLog called;
+	RollingMedian rolling3([&called](MedianEvent const& e) {
+		called.write(e);
+	});
+	rolling3.push(first, first + 100);
+	EXPECT_EQ(rolling3.push(first + 100, last), rolling.median());
+
+	for (EventLog const* log : { &batch, &called }) {
+		ASSERT_EQ(log->events.size(), expected.events.size());
+		for (size_t i = 0; i < expected.events.size(); ++i) {
+			MedianEvent const& a = expected.events[i];
+			MedianEvent const& b = log->events[i];
+			ASSERT_EQ(b.created_time, a.created_time) << i;
+			ASSERT_EQ(b.median, a.median) << i;
+			ASSERT_EQ(b.num_vertices, a.num_vertices) << i;
+			ASSERT_EQ(b.num_edges, a.num_edges) << i;
+		}
+	}
+
+	// no callback once it is cleared
+	rolling3.on_median(RollingMedian::Callback());
+	rolling3.push("A", "B", last[-1].created_time);
+	EXPECT_EQ(called.events.size(), p.payments.size());
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "victor/structural_index.hpp"
+#include "victor/venmo_record.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+std::string const record = "{\"created_time\": \"2016-03-28T23:23:12Z\", "
+	"\"target\": \"Joey-Feste\", \"actor\": \"Ricardo-Lach\"}";
+
+/**
+	Offsets of the indexed bytes, found one byte at a time.
+*/
+std::vector<uint32_t> expected_offsets(std::string const& buf) {
+	std::vector<uint32_t> offsets;
+	for (size_t i = 0; i < buf.size(); ++i) {
+		unsigned char const c = static_cast<unsigned char>(buf[i]);
+		if (strchr("{}[]:,\"\\", c) != nullptr && c != '\0') {
+			offsets.push_back(uint32_t(i));
+		} else if (c < 0x20 || c >= 0x80) {
+			offsets.push_back(uint32_t(i));
+		}
+	}
+	return offsets;
+}
+
+TEST(StructuralIndexTest, KernelsAgree) {
+	std::mt19937 rng(7);
+	std::string buf;
+	for (int i = 0; i < 300; ++i) {
+		buf += char(rng() % 256);
+		if (i % 37 == 0) {
+			buf += record + "\n";
+		}
+	}
+	for (int k = StructuralIndex::scalar_kernel;
+		 k <= StructuralIndex::avx2_kernel; ++k) {
+		StructuralIndex::Kernel const kernel = StructuralIndex::Kernel(k);
+		if (!StructuralIndex::supported(kernel)) {
+			continue;
+		}
+		StructuralIndex index(kernel);
+		// every length, so that every tail size is covered
+		for (size_t n = 0; n <= 130; ++n) {
+			std::string const part = buf.substr(0, n);
+			index.build(part.data(), part.data() + n);
+			std::vector<uint32_t> const got(index.begin(), index.end());
+			ASSERT_EQ(got, expected_offsets(part)) <<
+				StructuralIndex::kernel_name(kernel) << " kernel, length " << n;
+		}
+		index.build(buf.data(), buf.data() + buf.size());
+		std::vector<uint32_t> const got(index.begin(), index.end());
+		EXPECT_EQ(got, expected_offsets(buf)) <<
+			StructuralIndex::kernel_name(kernel) << " kernel";
+	}
+}
+
+TEST(StructuralIndexTest, SplitsLines) {
+	std::string const buf = "{\"a\": 1}\n\n[2]";
+	StructuralIndex index;
+	index.build(buf.data(), buf.data() + buf.size());
+	std::vector<std::string> lines;
+	std::vector<size_t> counts;
+	char const* first;
+	char const* last;
+	uint32_t const* pos;
+	uint32_t const* pos_end;
+	while (index.next_line(first, last, pos, pos_end)) {
+		lines.emplace_back(first, last);
+		counts.push_back(size_t(pos_end - pos));
+	}
+	std::vector<std::string> const expected = { "{\"a\": 1}", "", "[2]" };
+	EXPECT_EQ(lines, expected);
+	std::vector<size_t> const expected_counts = { 5, 0, 2 };
+	EXPECT_EQ(counts, expected_counts);
+}
+
+TEST(StructuralIndexTest, WalkMatchesParser) {
+	// mutate a record at random and check that walking the index reads
+	// the same as the parser
+	std::mt19937 rng(11);
+	char const alphabet[] = "{}[]:,\" \\tfnrue0123456789-.eE\t\r\x01\x80" "ab";
+	VenmoRecordReader walked_reader;
+	VenmoRecordReader parsed_reader;
+	VenmoRecord walked;
+	VenmoRecord parsed;
+	StructuralIndex index;
+	for (int i = 0; i < 20000; ++i) {
+		std::string line = record;
+		for (int m = int(rng() % 4); m != 0; --m) {
+			size_t const p = rng() % line.size();
+			char const c = alphabet[rng() % (sizeof(alphabet) - 1)];
+			switch (rng() % 3) {
+			case 0: line.insert(line.begin() + p, c); break;
+			case 1: line.erase(p, 1); break;
+			default: line[p] = c; break;
+			}
+		}
+		index.build(line.data(), line.data() + line.size());
+		VenmoRecordReader::Status const walked_status = walked_reader.read(
+			line.data(), line.data() + line.size(), line.data(),
+			index.begin(), index.end(), walked);
+		VenmoRecordReader::Status const parsed_status =
+			parsed_reader.read(line, parsed);
+		ASSERT_EQ(walked_status, parsed_status) << line;
+		if (parsed_status == VenmoRecordReader::ok) {
+			ASSERT_EQ(walked.actor, parsed.actor) << line;
+			ASSERT_EQ(walked.target, parsed.target) << line;
+			ASSERT_EQ(walked.created_time, parsed.created_time) << line;
+		}
+	}
+}
+
+}  // namespace victor
\ No newline at end of file
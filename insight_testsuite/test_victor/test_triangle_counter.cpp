@@ -0,0 +1,146 @@
+#include "victor/triangle_counter.hpp"
+#include "victor/venmo_graph.hpp"
+#include "victor/workload.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+typedef TriangleCounter::Id Id;
+
+static Id const num_users = 30;
+
+/**
+	@return the triangles among the users joined, counted one by one.
+*/
+uint64_t brute_force(bool const (&joined)[num_users][num_users]) {
+	uint64_t n = 0;
+	for (Id a = 0; a < num_users; ++a) {
+		for (Id b = a + 1; b < num_users; ++b) {
+			for (Id c = b + 1; c < num_users && joined[a][b]; ++c) {
+				n += joined[a][c] && joined[b][c];
+			}
+		}
+	}
+	return n;
+}
+
+TEST(TriangleCounterTest, CountsTriangles) {
+	TriangleCounter counter;
+	EXPECT_EQ(counter.triangles(), 0u);
+	// four users who have all paid each other
+	counter.insert_edge(0, 1);
+	counter.insert_edge(1, 2);
+	EXPECT_EQ(counter.triangles(), 0u);
+	counter.insert_edge(2, 0);
+	EXPECT_EQ(counter.triangles(), 1u);
+	counter.insert_edge(3, 0);
+	counter.insert_edge(1, 3);
+	EXPECT_EQ(counter.triangles(), 2u);
+	counter.insert_edge(3, 2);
+	EXPECT_EQ(counter.triangles(), 4u);
+	EXPECT_EQ(counter.common_neighbors(0, 1), 2u);
+	EXPECT_EQ(counter.num_edges(), 6u);
+
+	counter.erase_edge(0, 1);
+	EXPECT_EQ(counter.triangles(), 2u);
+	EXPECT_TRUE(counter.neighbors(0) == std::vector<Id>({ 2, 3 }));
+	counter.erase_edge(2, 0);
+	counter.erase_edge(3, 0);
+	EXPECT_EQ(counter.triangles(), 1u);
+	EXPECT_TRUE(counter.neighbors(0).empty());
+	EXPECT_TRUE(counter.neighbors(100).empty());
+}
+
+TEST(TriangleCounterTest, KernelsAgree) {
+	Random random(3);
+	for (int round = 0; round < 2000; ++round) {
+		// sizes around the block of four, and far apart for binary search
+		std::vector<Id> arrays[2];
+		for (std::vector<Id>& v : arrays) {
+			size_t const n = size_t(random.below(round % 10 == 0 ? 400 : 20));
+			Id const range = Id(1 + random.below(round % 2 == 0 ? 50 : 5000));
+			std::set<Id> ids;
+			for (size_t i = 0; i < n; ++i) {
+				ids.insert(Id(random.below(range)));
+			}
+			v.assign(ids.begin(), ids.end());
+		}
+		std::vector<Id> both;
+		std::set_intersection(arrays[0].begin(), arrays[0].end(),
+							  arrays[1].begin(), arrays[1].end(),
+							  std::back_inserter(both));
+		for (TriangleCounter::Kernel kernel : { TriangleCounter::scalar_kernel,
+												TriangleCounter::sse2_kernel }) {
+			if (!TriangleCounter::supported(kernel)) {
+				continue;
+			}
+			ASSERT_EQ(TriangleCounter::intersect(arrays[0], arrays[1], kernel),
+					  both.size()) << kernel << " " << round;
+		}
+	}
+}
+
+TEST(TriangleCounterTest, MatchesBruteForce) {
+	Random random(5);
+	for (TriangleCounter::Kernel kernel : { TriangleCounter::scalar_kernel,
+											TriangleCounter::sse2_kernel }) {
+		TriangleCounter counter(kernel);
+		bool joined[num_users][num_users] = {};
+		size_t edges = 0;
+		for (int i = 0; i < 3000; ++i) {
+			Id const a = Id(random.below(num_users));
+			Id const b = Id(random.below(num_users));
+			if (a == b) {
+				continue;
+			}
+			if (!joined[a][b]) {
+				counter.insert_edge(a, b);
+				++edges;
+			} else {
+				counter.erase_edge(b, a);
+				--edges;
+			}
+			joined[a][b] = joined[b][a] = !joined[a][b];
+			ASSERT_EQ(counter.triangles(), brute_force(joined)) << i;
+		}
+		EXPECT_EQ(counter.num_edges(), edges);
+	}
+}
+
+TEST(TriangleCounterTest, GraphCountsItsWindow) {
+	WorkloadConfig config;
+	config.num_users = 60;
+	config.out_of_order = 0.1;
+	WorkloadGenerator generator(config);
+	VenmoGraph graph;
+	VenmoGraph late;		// starts counting half way
+	graph.count_triangles();
+	EXPECT_TRUE(graph.counts_triangles());
+	EXPECT_FALSE(late.counts_triangles());
+	uint64_t most = 0;
+	WorkloadGenerator::Event e;
+	for (int i = 0; i < 20000; ++i) {
+		generator.next(e);
+		std::string const actor = "user-" + std::to_string(e.actor);
+		std::string const target = "user-" + std::to_string(e.target);
+		graph.extract_median(actor, target, e.created_time);
+		late.extract_median(actor, target, e.created_time);
+		if (i == 10000) {
+			late.count_triangles();
+		}
+		if (i >= 10000) {
+			ASSERT_EQ(late.triangles(), graph.triangles()) << i;
+		}
+		most = std::max(most, graph.triangles());
+	}
+	EXPECT_GT(most, 0u);
+	EXPECT_GT(graph.memory_usage().bytes("triangle_adjacency"), 0u);
+}
+
+}  // namespace victor
\ No newline at end of file
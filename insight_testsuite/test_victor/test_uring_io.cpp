@@ -0,0 +1,255 @@
+#include "victor/uring_io.hpp"
+#include "victor/med_deg_stream.hpp"
+#include "victor/workload.hpp"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace victor {
+
+std::string read_file(char const* filename) {
+	std::ifstream ifs(filename, std::ifstream::binary);
+	return std::string((std::istreambuf_iterator<char>(ifs)),
+					   std::istreambuf_iterator<char>());
+}
+
+void write_file(char const* filename, std::string const& text) {
+	std::ofstream ofs(filename, std::ofstream::binary);
+	ofs << text;
+}
+
+/**
+	@return bytes that don't repeat with any small period.
+*/
+std::string pattern(size_t n) {
+	std::string s(n, '\0');
+	uint32_t x = 12345;
+	for (char& c : s) {
+		x = x * 1103515245 + 12345;
+		c = char(x >> 24);
+	}
+	return s;
+}
+
+/**
+	@return whether io_uring can be used here; the tests pass trivially if
+	it can't, since the callers fall back to std::filebuf.
+*/
+bool have_uring() {
+	write_file("uring_test_probe.txt", "x");
+	bool const have = UringInput::open("uring_test_probe.txt") != nullptr;
+	remove("uring_test_probe.txt");
+	if (!have) {
+		std::cout << "io_uring can't be used here; skipped" << std::endl;
+	}
+	return have;
+}
+
+TEST(UringIoTest, ReadsFilesInOrder) {
+	if (!have_uring()) {
+		return;
+	}
+	size_t const buffer_size = 1 << 12;
+	for (size_t size : { size_t(0), size_t(1), buffer_size - 1, buffer_size,
+						 3 * buffer_size, 3 * buffer_size + 7, size_t(1 << 20) + 3 }) {
+		std::string const text = pattern(size);
+		write_file("uring_test_input.txt", text);
+		for (unsigned depth : { 1u, 2u, 5u }) {
+			std::unique_ptr<std::streambuf> in =
+				UringInput::open("uring_test_input.txt", buffer_size, depth);
+			ASSERT_TRUE(in != nullptr);
+			std::string got;
+			char chunk[1000];
+			std::streamsize n;
+			while ((n = in->sgetn(chunk, 1 + std::streamsize(got.size() % 999))) > 0) {
+				got.append(chunk, size_t(n));
+			}
+			EXPECT_TRUE(got == text) << size << " bytes, " << depth << " in flight";
+			EXPECT_EQ(in->sgetc(), std::char_traits<char>::eof());
+		}
+	}
+	remove("uring_test_input.txt");
+	EXPECT_TRUE(UringInput::open("uring_test_none.txt") == nullptr);
+}
+
+TEST(UringIoTest, WritesFilesInOrder) {
+	if (!have_uring()) {
+		return;
+	}
+	std::string const text = pattern((1 << 20) + 11);
+	for (unsigned depth : { 1u, 3u }) {
+		{
+			std::unique_ptr<std::streambuf> out =
+				UringOutput::open("uring_test_output.txt", 1 << 12, depth);
+			ASSERT_TRUE(out != nullptr);
+			std::ostream os(out.get());
+			// writes of every size, and single characters, and a flush
+			// half way
+			size_t i = 0;
+			for (size_t k = 0; i < text.size(); ++k) {
+				size_t n = std::min(k * 7919 % 9000 + 1, text.size() - i);
+				if (k % 3 == 0) {
+					os.put(text[i]);
+					n = 1;
+				} else {
+					os.write(text.data() + i, std::streamsize(n));
+				}
+				i += n;
+				if (i > text.size() / 2 && i - n <= text.size() / 2) {
+					os.flush();
+					EXPECT_TRUE(read_file("uring_test_output.txt") == text.substr(0, i));
+				}
+			}
+			EXPECT_TRUE(os.good());
+		}
+		EXPECT_TRUE(read_file("uring_test_output.txt") == text) << depth << " in flight";
+	}
+	remove("uring_test_output.txt");
+}
+
+TEST(UringIoTest, StreamMatchesPosixIo) {
+	WorkloadConfig config;
+	config.num_users = 1000;
+	config.out_of_order = 0.1;
+	config.malformed = 0.01;
+	{
+		std::ofstream ofs("uring_test_input.txt", std::ofstream::binary);
+		OutputBuffer out(ofs);
+		WorkloadGenerator generator(config);
+		generator.generate(30000, out);
+	}
+	std::string outputs[2];
+	std::string messages[2];
+	for (MedDegStream::Io io : { MedDegStream::posix, MedDegStream::uring }) {
+		testing::internal::CaptureStdout();
+		{
+			MedDegStream mds("uring_test_input.txt", "uring_test_output.txt",
+							 MedDegStream::json, MedDegStream::json_lines, io);
+			mds.process();
+		}
+		messages[io] = testing::internal::GetCapturedStdout();
+		outputs[io] = read_file("uring_test_output.txt");
+	}
+	EXPECT_FALSE(outputs[0].empty());
+	EXPECT_TRUE(outputs[0] == outputs[1]);
+	EXPECT_EQ(messages[0], messages[1]);
+	remove("uring_test_input.txt");
+	remove("uring_test_output.txt");
+}
+
+TEST(UringIoTest, ReportsFailedReadsAndWrites) {
+	if (!have_uring()) {
+		return;
+	}
+	// a directory opens, but can't be read
+	mkdir("uring_test_dir", 0755);
+	std::unique_ptr<std::streambuf> in = UringInput::open("uring_test_dir");
+	ASSERT_TRUE(in != nullptr);
+	EXPECT_EQ(in->sgetc(), std::char_traits<char>::eof());
+	EXPECT_EQ(static_cast<UringInput const*>(in.get())->error(),
+			  "cannot read: Is a directory");
+	in.reset();
+	// and /dev/full takes no bytes
+	std::unique_ptr<std::streambuf> out = UringOutput::open("/dev/full", 1 << 12);
+	ASSERT_TRUE(out != nullptr);
+	std::ostream os(out.get());
+	os << pattern(10000);
+	os.flush();
+	EXPECT_FALSE(os.good());
+	EXPECT_EQ(static_cast<UringOutput const*>(out.get())->error(),
+			  "cannot write: No space left on device");
+	out.reset();
+
+	// the stream says so, and fails
+	write_file("uring_test_input.txt", "{\"created_time\": \"2016-03-28T23:23:12Z\", "
+		"\"target\": \"B\", \"actor\": \"A\"}\n");
+	testing::internal::CaptureStdout();
+	{
+		MedDegStream mds("uring_test_dir", "uring_test_output.txt",
+						 MedDegStream::json, MedDegStream::text, MedDegStream::uring);
+		EXPECT_FALSE(mds.process());
+	}
+	EXPECT_EQ(testing::internal::GetCapturedStdout(), "cannot read: Is a directory\n");
+	testing::internal::CaptureStdout();
+	{
+		MedDegStream mds("uring_test_input.txt", "/dev/full",
+						 MedDegStream::json, MedDegStream::text, MedDegStream::uring);
+		EXPECT_FALSE(mds.process());
+	}
+	EXPECT_EQ(testing::internal::GetCapturedStdout(),
+			  "cannot write: No space left on device (/dev/full)\n");
+	testing::internal::CaptureStdout();
+	{
+		MedDegStream mds("uring_test_input.txt", "/dev/full");
+		EXPECT_FALSE(mds.process());
+	}
+	EXPECT_EQ(testing::internal::GetCapturedStdout(), "cannot write /dev/full\n");
+	{
+		MedDegStream mds("uring_test_input.txt", "uring_test_output.txt",
+						 MedDegStream::json, MedDegStream::text, MedDegStream::uring);
+		EXPECT_TRUE(mds.process());
+	}
+	EXPECT_EQ(read_file("uring_test_output.txt"), "1.00\n");
+	rmdir("uring_test_dir");
+	remove("uring_test_input.txt");
+	remove("uring_test_output.txt");
+}
+
+TEST(UringIoTest, ReportsInputsThatCannotBeRead) {
+	MedDegStream::Io const ios[] = { MedDegStream::posix, MedDegStream::uring };
+	write_file("uring_test_input.txt", "{\"created_time\": \"2016-03-28T23:23:12Z\", "
+		"\"target\": \"B\", \"actor\": \"A\"}\n");
+	for (MedDegStream::Io io : ios) {
+		// a missing input isn't taken for an empty one
+		testing::internal::CaptureStdout();
+		{
+			MedDegStream mds("uring_test_missing.txt", "uring_test_output.txt",
+							 MedDegStream::json, MedDegStream::text, io);
+			EXPECT_FALSE(mds.process());
+		}
+		EXPECT_EQ(testing::internal::GetCapturedStdout(),
+				  "cannot read uring_test_missing.txt\n");
+
+		// nor is one of several merged
+		std::vector<std::string> const inputs = {
+			"uring_test_input.txt", "uring_test_missing.txt"
+		};
+		testing::internal::CaptureStdout();
+		{
+			MedDegStream mds(inputs, "uring_test_output.txt",
+							 MedDegStream::json, MedDegStream::text, io);
+			EXPECT_FALSE(mds.process());
+		}
+		EXPECT_EQ(testing::internal::GetCapturedStdout(),
+				  "cannot read uring_test_missing.txt\n");
+		EXPECT_EQ(read_file("uring_test_output.txt"), "1.00\n");
+	}
+
+	// binary input that is corrupt, or ends in the middle of a record
+	struct { char const* data; size_t size; char const* message; } const binary[] = {
+		{ "\xc1", 1, "corrupt input\n" },
+		{ "\x83\xa6", 2, "truncated record\n" }
+	};
+	for (auto const& b : binary) {
+		write_file("uring_test_input.txt", std::string(b.data, b.size));
+		testing::internal::CaptureStdout();
+		{
+			MedDegStream mds("uring_test_input.txt", "uring_test_output.txt",
+							 MedDegStream::msgpack);
+			EXPECT_FALSE(mds.process());
+		}
+		EXPECT_EQ(testing::internal::GetCapturedStdout(), b.message);
+	}
+	remove("uring_test_input.txt");
+	remove("uring_test_output.txt");
+}
+
+}  // namespace victor
\ No newline at end of file
@@ -11,7 +11,7 @@ using std::endl;
 namespace victor {
 
 static time_t create_time(char const* datetime) {
-	tm time_obj;
+	tm time_obj = tm();
 	sscanf(datetime, "%4d-%2d-%2dT%2d:%2d:%2dZ",
 		   &time_obj.tm_year, &time_obj.tm_mon, &time_obj.tm_mday,
 		   &time_obj.tm_hour, &time_obj.tm_min, &time_obj.tm_sec);
@@ -104,4 +104,116 @@ TEST(VenmoGraphTest, VenmoGraphWorks) {
 	// cout << graph.dump() << endl;
 }
 
+TEST(VenmoGraphTest, RepeatedEdgeAfterExpiryIsNotDuplicated) {
+	VenmoGraph graph;
+	graph.extract_median("A", "B", create_time("2016-07-09T16:19:00Z"));
+	graph.extract_median("A", "C", create_time("2016-07-09T16:19:30Z"));
+
+	// A-B expires while A keeps its edge to C
+	graph.extract_median("D", "E", create_time("2016-07-09T16:20:05Z"));
+	ASSERT_EQ(graph.num_edges(), 2);
+	ASSERT_EQ(graph.num_vertices(), 4);
+
+	// A-C is seen again: its time is updated, it isn't a new edge
+	graph.extract_median("C", "A", create_time("2016-07-09T16:20:06Z"));
+	EXPECT_EQ(graph.num_edges(), 2);
+	EXPECT_EQ(graph.num_vertices(), 4);
+	EXPECT_EQ(graph.vertices().degree("A"), 1);
+	EXPECT_EQ(graph.vertices().degree("C"), 1);
+}
+
+TEST(VenmoGraphTest, LatePaymentDoesNotAgeEdge) {
+	VenmoGraph graph;
+	graph.extract_median("A", "B", create_time("2016-07-09T16:19:00Z"));
+	graph.extract_median("B", "A", create_time("2016-07-09T16:18:50Z"));
+
+	// A-B was last paid at 16:19:00, so it is still in the window
+	graph.extract_median("C", "D", create_time("2016-07-09T16:19:55Z"));
+	EXPECT_EQ(graph.num_edges(), 2);
+	EXPECT_EQ(graph.num_vertices(), 4);
+	graph.extract_median("C", "D", create_time("2016-07-09T16:20:00Z"));
+	EXPECT_EQ(graph.num_edges(), 1);
+}
+
+TEST(VenmoGraphTest, PaymentToOneselfAddsNoEdge) {
+	VenmoGraph graph;
+	EXPECT_EQ(graph.extract_median("A", "A", create_time("2016-07-09T16:19:00Z")), 0.0);
+	EXPECT_EQ(graph.num_vertices(), 0);
+	EXPECT_EQ(graph.num_edges(), 0);
+	EXPECT_EQ(graph.extract_median("A", "B", create_time("2016-07-09T16:19:01Z")), 1.0);
+	EXPECT_EQ(graph.extract_median("B", "B", create_time("2016-07-09T16:19:02Z")), 1.0);
+	EXPECT_EQ(graph.vertices().degree("B"), 1);
+
+	// it still moves the window
+	EXPECT_EQ(graph.extract_median("C", "C", create_time("2016-07-09T16:20:01Z")), 0.0);
+	EXPECT_EQ(graph.num_vertices(), 0);
+	EXPECT_EQ(graph.counters().self_payments, 3u);
+}
+
+TEST(VenmoGraphTest, CountsWhatItDoes) {
+	VenmoGraph graph;
+	graph.extract_median("A", "B", create_time("2016-07-09T16:19:00Z"));
+	graph.extract_median("C", "D", create_time("2016-07-09T16:18:50Z"));
+	graph.extract_median("B", "A", create_time("2016-07-09T16:18:55Z"));
+	graph.extract_median("E", "F", create_time("2016-07-09T16:17:00Z"));
+	graph.extract_median("G", "H", create_time("2016-07-09T16:20:05Z"));
+
+	VenmoGraph::Counters const& c = graph.counters();
+	EXPECT_EQ(c.edges_inserted, 3u);
+	EXPECT_EQ(c.edges_updated, 1u);
+	EXPECT_EQ(c.late, 2u);
+	EXPECT_EQ(c.dropped, 1u);
+	EXPECT_EQ(c.edges_expired, 2u);
+	EXPECT_EQ(c.peak_edges, 2u);
+	EXPECT_EQ(graph.vertices().counters().erased, 4u);
+	EXPECT_EQ(graph.vertices().counters().peak_size, 4u);
+}
+
+TEST(VenmoGraphTest, ListsCounterparties) {
+	VenmoGraph graph;
+	time_t const t = create_time("2016-07-09T16:19:00Z");
+	graph.extract_median("B", "A", t);
+	graph.extract_median("C", "D", t + 1);
+	graph.extract_median("D", "B", t + 2);
+	graph.extract_median("A", "B", t + 3);
+	graph.extract_median("B", "B", t + 4);
+
+	typedef std::vector<std::pair<std::string, time_t>> Counterparties;
+	EXPECT_EQ(graph.counterparties("B"),
+			  Counterparties({ { "A", t + 3 }, { "D", t + 2 } }));
+	EXPECT_EQ(graph.counterparties("C"), Counterparties({ { "D", t + 1 } }));
+	EXPECT_TRUE(graph.counterparties("E").empty());
+	EXPECT_EQ(graph.payments(), 5u);
+
+	// the edges of the first payments expire
+	graph.extract_median("E", "C", t + 62);
+	EXPECT_EQ(graph.counterparties("B"), Counterparties({ { "A", t + 3 } }));
+	EXPECT_EQ(graph.counterparties("C"), Counterparties({ { "E", t + 62 } }));
+}
+
+TEST(VenmoGraphTest, IndexedCounterpartiesAgree) {
+	VenmoGraph graph;
+	VenmoGraph indexed;
+	VenmoGraph late;		// starts indexing half way
+	indexed.index_counterparties();
+	time_t const t = create_time("2016-07-09T16:19:00Z");
+	for (int i = 0; i < 4000; ++i) {
+		// about ten payments a second, some of them late, among 30 users
+		std::string const actor = "user-" + std::to_string(i * 7 % 30);
+		std::string const target = "user-" + std::to_string(i * 13 % 29);
+		time_t const created_time = t + i / 10 - (i % 11 == 0 ? 30 : 0);
+		for (VenmoGraph* g : { &graph, &indexed, &late }) {
+			g->extract_median(actor, target, created_time);
+		}
+		if (i == 2000) {
+			late.index_counterparties();
+		}
+		std::string const user = "user-" + std::to_string(i % 31);
+		ASSERT_EQ(indexed.counterparties(user), graph.counterparties(user)) << i;
+		ASSERT_EQ(late.counterparties(user), graph.counterparties(user)) << i;
+	}
+	EXPECT_GT(indexed.memory_usage().bytes("counterparty_index"), 0u);
+	EXPECT_EQ(graph.memory_usage().bytes("counterparty_index"), 0u);
+}
+
 }  // namespace victor
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "victor/venmo_record.hpp"
+#include "gtest/gtest.h"
+#include <string>
+
+
+namespace victor {
+
+TEST(VenmoRecordReaderTest, ReadsFields) {
+	VenmoRecordReader reader;
+	VenmoRecord rec;
+	std::string const line = "{\"created_time\": \"2016-03-28T23:23:12Z\", "
+		"\"target\": \"Joey-Feste\", \"actor\": \"Ricardo-Lach\"}";
+	ASSERT_EQ(reader.read(line, rec), VenmoRecordReader::ok);
+	EXPECT_EQ(rec.actor, "Ricardo-Lach");
+	EXPECT_EQ(rec.target, "Joey-Feste");
+	EXPECT_EQ(rec.created_time, 1459207392);
+}
+
+TEST(VenmoRecordReaderTest, IgnoresOtherFields) {
+	VenmoRecordReader reader;
+	VenmoRecord rec;
+	std::string const line = "{\"note\": {\"actor\": \"Nobody\"}, "
+		"\"actor\": \"A\\\\B\", \"amount\": [1, 2], \"target\": \"C\", "
+		"\"created_time\": \"1970-01-01T00:01:00Z\"}";
+	ASSERT_EQ(reader.read(line, rec), VenmoRecordReader::ok);
+	EXPECT_EQ(rec.actor, "A\\B") << "Nested actor key should be ignored.";
+	EXPECT_EQ(rec.target, "C");
+	EXPECT_EQ(rec.created_time, 60);
+}
+
+TEST(VenmoRecordReaderTest, ReportsBadLines) {
+	VenmoRecordReader reader;
+	VenmoRecord rec;
+	EXPECT_EQ(reader.read("{\"target\": \"B\"}", rec),
+		VenmoRecordReader::missing_actor);
+	EXPECT_EQ(reader.read("{\"actor\": \"\", \"target\": \"B\"}", rec),
+		VenmoRecordReader::empty_actor);
+	EXPECT_EQ(reader.read("{\"actor\": 3, \"target\": \"B\"}", rec),
+		VenmoRecordReader::bad_actor);
+	EXPECT_EQ(reader.read("{\"actor\": \"A\", \"target\": null}", rec),
+		VenmoRecordReader::bad_target);
+	EXPECT_EQ(reader.read("{\"actor\": \"A\", \"target\": \"B\"}", rec),
+		VenmoRecordReader::missing_created_time);
+	EXPECT_EQ(reader.read("{\"actor\": \"A\", \"target\": \"B\", "
+		"\"created_time\": \"2016-13-01T00:00:00Z\"}", rec),
+		VenmoRecordReader::bad_created_time);
+	EXPECT_EQ(reader.read("{\"actor\": \"A\", \"target\"", rec),
+		VenmoRecordReader::malformed);
+	EXPECT_EQ(reader.read("[\"actor\"]", rec), VenmoRecordReader::malformed);
+	EXPECT_EQ(reader.read("", rec), VenmoRecordReader::malformed);
+}
+
+TEST(VenmoRecordReaderTest, ParseTimeWorks) {
+	time_t t;
+	ASSERT_TRUE(VenmoRecordReader::parse_time("2000-02-29T12:00:00Z", t));
+	EXPECT_EQ(t, 951825600);
+	EXPECT_FALSE(VenmoRecordReader::parse_time("2000-02-29 12:00:00Z", t));
+	EXPECT_FALSE(VenmoRecordReader::parse_time("2000-02-29T12:00:00", t));
+	EXPECT_FALSE(VenmoRecordReader::parse_time("2000-2-29T12:00:00Z", t));
+}
+
+}  // namespace victor
\ No newline at end of file
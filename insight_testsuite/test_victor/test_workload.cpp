@@ -0,0 +1,166 @@
+#include "victor/workload.hpp"
+#include "victor/binary_record.hpp"
+#include "victor/venmo_record.hpp"
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace victor {
+
+std::string generate(WorkloadConfig const& config, uint64_t count) {
+	std::ostringstream os;
+	{
+		WorkloadGenerator generator(config);
+		OutputBuffer out(os);
+		generator.generate(count, out);
+	}
+	return os.str();
+}
+
+TEST(WorkloadTest, IsDeterministic) {
+	WorkloadConfig config;
+	config.malformed = 0.05;
+	std::string const a = generate(config, 20000);
+	EXPECT_EQ(generate(config, 20000), a);
+	config.seed = 2;
+	EXPECT_NE(generate(config, 20000), a);
+	config.format = WorkloadConfig::msgpack;
+	EXPECT_EQ(generate(config, 20000), generate(config, 20000));
+}
+
+TEST(WorkloadTest, ZipfFollowsLaw) {
+	Random random(7);
+	for (double s : { 0.0, 0.8, 1.0, 1.5 }) {
+		uint64_t const n = 50;
+		ZipfSampler const zipf(n, s);
+		std::vector<double> counts(n + 1);
+		int const num_samples = 500000;
+		for (int i = 0; i < num_samples; ++i) {
+			uint64_t const k = zipf(random);
+			ASSERT_GE(k, 1u);
+			ASSERT_LE(k, n);
+			++counts[k];
+		}
+		double total = 0;
+		for (uint64_t k = 1; k <= n; ++k) {
+			total += std::pow(double(k), -s);
+		}
+		for (uint64_t k : { 1, 2, 5, 20, 50 }) {
+			double const expected = num_samples * std::pow(double(k), -s) / total;
+			EXPECT_NEAR(counts[k], expected, 5 * std::sqrt(expected) + 1)
+				<< "s = " << s << ", k = " << k;
+		}
+	}
+}
+
+TEST(WorkloadTest, MatchesConfig) {
+	WorkloadConfig config;
+	config.num_users = 5000;
+	config.rate = 20;
+	config.burst = 3;
+	config.out_of_order = 0.1;
+	config.out_of_window = 0.05;
+	config.repeat_edge = 0.2;
+	config.malformed = 0.02;
+	uint64_t const count = 200000;
+	std::istringstream in(generate(config, count));
+
+	VenmoRecordReader reader;
+	VenmoRecord rec;
+	std::string line;
+	uint64_t lines = 0, bad = 0, late = 0, too_late = 0, repeats = 0, self_loops = 0;
+	time_t first = 0, latest = 0;
+	std::set<std::pair<std::string, std::string> > recent;
+	std::vector<std::pair<std::string, std::string> > order;
+	while (std::getline(in, line)) {
+		++lines;
+		if (reader.read(line, rec) != VenmoRecordReader::ok) {
+			++bad;
+			continue;
+		}
+		if (first == 0) {
+			first = latest = rec.created_time;
+		}
+		if (rec.created_time <= latest - 60) {
+			++too_late;
+		} else if (rec.created_time < latest) {
+			++late;
+		}
+		latest = std::max(latest, rec.created_time);
+		self_loops += rec.actor == rec.target;
+		std::pair<std::string, std::string> edge(std::min(rec.actor, rec.target),
+												 std::max(rec.actor, rec.target));
+		repeats += recent.count(edge);
+		recent.insert(edge);
+		order.push_back(edge);
+		if (order.size() > 2000) {
+			recent.erase(order[order.size() - 2001]);
+		}
+	}
+	EXPECT_EQ(lines, count);
+	EXPECT_EQ(self_loops, 0u);
+	EXPECT_NEAR(double(bad) / count, config.malformed, 0.003);
+	EXPECT_NEAR(double(late) / count, config.out_of_order, 0.01);
+	EXPECT_NEAR(double(too_late) / count, config.out_of_window, 0.005);
+	EXPECT_GE(double(repeats) / count, config.repeat_edge - 0.01)
+		<< "Repeats of recent edges should be at least as many as asked for.";
+	EXPECT_LT(double(repeats) / count, config.repeat_edge + 0.1);
+	EXPECT_NEAR(double(latest - first), count / config.rate, 0.05 * count / config.rate);
+}
+
+TEST(WorkloadTest, BinaryMatchesJson) {
+	WorkloadConfig config;
+	config.malformed = 0.05;
+	uint64_t const count = 50000;
+	std::istringstream json_in(generate(config, count));
+	struct {
+		WorkloadConfig::Format format;
+		BinaryRecordReader::Format reader_format;
+	} const formats[] = {
+		{ WorkloadConfig::msgpack, BinaryRecordReader::msgpack },
+		{ WorkloadConfig::cbor, BinaryRecordReader::cbor },
+	};
+	for (auto const& format : formats) {
+		config.format = format.format;
+		std::string const data = generate(config, count);
+		json_in.clear();
+		json_in.seekg(0);
+
+		VenmoRecordReader json_reader;
+		BinaryRecordReader reader(format.reader_format);
+		char const* p = data.data();
+		char const* const last = p + data.size();
+		std::string line;
+		uint64_t records = 0;
+		while (std::getline(json_in, line)) {
+			VenmoRecord expected;
+			VenmoRecordReader::Status const expected_status =
+				json_reader.read(line, expected);
+			char const* next;
+			VenmoRecord actual;
+			VenmoRecordReader::Status status;
+			ASSERT_EQ(reader.read(p, last, next, actual, status),
+					  BinaryRecordReader::framed) << "Record " << records;
+			p = next;
+			++records;
+			ASSERT_EQ(status == VenmoRecordReader::ok,
+					  expected_status == VenmoRecordReader::ok) << line;
+			if (status == VenmoRecordReader::ok) {
+				EXPECT_EQ(actual.actor, expected.actor);
+				EXPECT_EQ(actual.target, expected.target);
+				EXPECT_EQ(actual.created_time, expected.created_time);
+			}
+		}
+		EXPECT_EQ(records, count);
+		EXPECT_EQ(p, last);
+	}
+}
+
+}  // namespace victor
\ No newline at end of file
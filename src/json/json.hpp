@@ -33,11 +33,14 @@ SOFTWARE.
 #include <array>
 #include <cassert>
 #include <cerrno>
+#include <cfloat>
 #include <ciso646>
+#include <clocale>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <iomanip>
@@ -53,6 +56,20 @@ SOFTWARE.
 #include <utility>
 #include <vector>
 
+// strtod_l
+#if defined(__APPLE__) || defined(__FreeBSD__)
+    #include <xlocale.h>
+#endif
+
+// vectorized string scanning
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define NLOHMANN_JSON_X86_SIMD
+    #include <tmmintrin.h>
+#endif
+
 // disable float-equal warnings on GCC/clang
 #if defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
     #pragma GCC diagnostic push
@@ -104,2351 +121,3186 @@ class DecimalSeparator : public std::numpunct<char>
 }
 
 /*!
-@brief a class to store JSON values
-
-@tparam ObjectType type for JSON objects (`std::map` by default; will be used
-in @ref object_t)
-@tparam ArrayType type for JSON arrays (`std::vector` by default; will be used
-in @ref array_t)
-@tparam StringType type for JSON strings and object keys (`std::string` by
-default; will be used in @ref string_t)
-@tparam BooleanType type for JSON booleans (`bool` by default; will be used
-in @ref boolean_t)
-@tparam NumberIntegerType type for JSON integer numbers (`int64_t` by
-default; will be used in @ref number_integer_t)
-@tparam NumberUnsignedType type for JSON unsigned integer numbers (@c
-`uint64_t` by default; will be used in @ref number_unsigned_t)
-@tparam NumberFloatType type for JSON floating-point numbers (`double` by
-default; will be used in @ref number_float_t)
-@tparam AllocatorType type of the allocator to use (`std::allocator` by
-default)
-
-@requirement The class satisfies the following concept requirements:
-- Basic
- - [DefaultConstructible](http://en.cppreference.com/w/cpp/concept/DefaultConstructible):
-   JSON values can be default constructed. The result will be a JSON null value.
- - [MoveConstructible](http://en.cppreference.com/w/cpp/concept/MoveConstructible):
-   A JSON value can be constructed from an rvalue argument.
- - [CopyConstructible](http://en.cppreference.com/w/cpp/concept/CopyConstructible):
-   A JSON value can be copy-constructed from an lvalue expression.
- - [MoveAssignable](http://en.cppreference.com/w/cpp/concept/MoveAssignable):
-   A JSON value van be assigned from an rvalue argument.
- - [CopyAssignable](http://en.cppreference.com/w/cpp/concept/CopyAssignable):
-   A JSON value can be copy-assigned from an lvalue expression.
- - [Destructible](http://en.cppreference.com/w/cpp/concept/Destructible):
-   JSON values can be destructed.
-- Layout
- - [StandardLayoutType](http://en.cppreference.com/w/cpp/concept/StandardLayoutType):
-   JSON values have
-   [standard layout](http://en.cppreference.com/w/cpp/language/data_members#Standard_layout):
-   All non-static data members are private and standard layout types, the class
-   has no virtual functions or (virtual) base classes.
-- Library-wide
- - [EqualityComparable](http://en.cppreference.com/w/cpp/concept/EqualityComparable):
-   JSON values can be compared with `==`, see @ref
-   operator==(const_reference,const_reference).
- - [LessThanComparable](http://en.cppreference.com/w/cpp/concept/LessThanComparable):
-   JSON values can be compared with `<`, see @ref
-   operator<(const_reference,const_reference).
- - [Swappable](http://en.cppreference.com/w/cpp/concept/Swappable):
-   Any JSON lvalue or rvalue of can be swapped with any lvalue or rvalue of
-   other compatible types, using unqualified function call @ref swap().
- - [NullablePointer](http://en.cppreference.com/w/cpp/concept/NullablePointer):
-   JSON values can be compared against `std::nullptr_t` objects which are used
-   to model the `null` value.
-- Container
- - [Container](http://en.cppreference.com/w/cpp/concept/Container):
-   JSON values can be used like STL containers and provide iterator access.
- - [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer);
-   JSON values can be used like STL containers and provide reverse iterator
-   access.
-
-@internal
-@note ObjectType trick from http://stackoverflow.com/a/9860911
-@endinternal
-
-@see [RFC 7159: The JavaScript Object Notation (JSON) Data Interchange
-Format](http://rfc7159.net/rfc7159)
-
-@since version 1.0.0
+@brief non-owning reference to a sequence of characters
 
-@nosubgrouping
+A minimal stand-in for C++17's `std::string_view`. It is used by the SAX
+interface (see @ref basic_json::sax_parse) to hand out object keys and string
+values without copying them into a new string.
 */
-template <
-    template<typename U, typename V, typename... Args> class ObjectType = std::map,
-    template<typename U, typename... Args> class ArrayType = std::vector,
-    class StringType = std::string,
-    class BooleanType = bool,
-    class NumberIntegerType = std::int64_t,
-    class NumberUnsignedType = std::uint64_t,
-    class NumberFloatType = double,
-    template<typename U> class AllocatorType = std::allocator
-    >
-class basic_json
+class string_ref
 {
-  private:
-    /// workaround type for MSVC
-    using basic_json_t = basic_json<ObjectType,
-          ArrayType,
-          StringType,
-          BooleanType,
-          NumberIntegerType,
-          NumberUnsignedType,
-          NumberFloatType,
-          AllocatorType>;
-
   public:
-    // forward declarations
-    template<typename Base> class json_reverse_iterator;
-    class json_pointer;
+    /// iterator over the referenced characters
+    using const_iterator = const char*;
 
-    /////////////////////
-    // container types //
-    /////////////////////
+    /// an empty reference
+    constexpr string_ref() noexcept
+        : m_data(nullptr), m_size(0)
+    {}
 
-    /// @name container types
-    /// @{
+    /// reference to @a n characters starting at @a s
+    constexpr string_ref(const char* s, std::size_t n) noexcept
+        : m_data(s), m_size(n)
+    {}
 
-    /// the type of elements in a basic_json container
-    using value_type = basic_json;
+    /// reference to a null-terminated string
+    string_ref(const char* s) noexcept
+        : m_data(s), m_size(std::strlen(s))
+    {}
 
-    /// the type of an element reference
-    using reference = value_type&;
-    /// the type of an element const reference
-    using const_reference = const value_type&;
+    /// reference to the contents of a string
+    string_ref(const std::string& s) noexcept
+        : m_data(s.data()), m_size(s.size())
+    {}
 
-    /// a type to represent differences between iterators
-    using difference_type = std::ptrdiff_t;
-    /// a type to represent container sizes
-    using size_type = std::size_t;
+    constexpr const char* data() const noexcept
+    {
+        return m_data;
+    }
 
-    /// the allocator type
-    using allocator_type = AllocatorType<basic_json>;
+    constexpr std::size_t size() const noexcept
+    {
+        return m_size;
+    }
 
-    /// the type of an element pointer
-    using pointer = typename std::allocator_traits<allocator_type>::pointer;
-    /// the type of an element const pointer
-    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+    constexpr bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
 
-    /// an iterator for a basic_json container
-    class iterator;
-    /// a const iterator for a basic_json container
-    class const_iterator;
-    /// a reverse iterator for a basic_json container
-    using reverse_iterator = json_reverse_iterator<typename basic_json::iterator>;
-    /// a const reverse iterator for a basic_json container
-    using const_reverse_iterator = json_reverse_iterator<typename basic_json::const_iterator>;
+    constexpr const_iterator begin() const noexcept
+    {
+        return m_data;
+    }
 
-    /// @}
+    constexpr const_iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
 
+    constexpr char operator[](std::size_t i) const noexcept
+    {
+        return m_data[i];
+    }
 
-    /*!
-    @brief returns the allocator associated with the container
-    */
-    static allocator_type get_allocator()
+    /// copy of the referenced characters
+    std::string to_string() const
     {
-        return allocator_type();
+        return std::string(m_data, m_size);
     }
 
+    friend bool operator==(string_ref lhs, string_ref rhs) noexcept
+    {
+        return lhs.m_size == rhs.m_size and
+               (lhs.m_size == 0 or std::memcmp(lhs.m_data, rhs.m_data, lhs.m_size) == 0);
+    }
 
-    ///////////////////////////
-    // JSON value data types //
-    ///////////////////////////
+    friend bool operator!=(string_ref lhs, string_ref rhs) noexcept
+    {
+        return not (lhs == rhs);
+    }
 
-    /// @name JSON value data types
-    /// @{
+  private:
+    const char* m_data;
+    std::size_t m_size;
+};
 
-    /*!
-    @brief a type for an object
+/*!
+@brief flat associative container for small JSON objects
+
+An alternative to `std::map` for basic_json's @a ObjectType template
+parameter (see @ref flat_json). The key/value pairs are kept in one vector
+in insertion order, so a small object costs a single allocation and a
+lookup is a linear scan over contiguous pairs, comparing key lengths before
+key bytes. Once an object holds @ref index_threshold pairs, an
+open-addressing hash index over the vector is built and used for lookups.
+
+Differences to `std::map`:
+- iteration (and so serialization) follows insertion order instead of key
+  order;
+- inserting or erasing a pair invalidates iterators and references to all
+  pairs, as for `std::vector`;
+- erasing a pair is linear in the size of the object.
+
+@tparam Key key type
+@tparam T mapped type
+@tparam Compare key ordering; only used by `operator<`
+@tparam Allocator allocator, rebound to `std::pair<Key, T>`
+*/
+template<typename Key, typename T, typename Compare = std::less<Key>,
+         typename Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_map
+{
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    /// pairs are stored with a mutable key so that they can be moved
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using allocator_type = typename std::allocator_traits<Allocator>::template
+                           rebind_alloc<value_type>;
+    using container_type = std::vector<value_type, allocator_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
 
-    [RFC 7159](http://rfc7159.net/rfc7159) describes JSON objects as follows:
-    > An object is an unordered collection of zero or more name/value pairs,
-    > where a name is a string and a value is a string, number, boolean, null,
-    > object, or array.
+    /// number of pairs from which on lookups go through a hash index
+    static constexpr size_type index_threshold = 16;
 
-    To store objects in C++, a type is defined by the template parameters
-    described below.
+    flat_map() = default;
 
-    @tparam ObjectType  the container to store objects (e.g., `std::map` or
-    `std::unordered_map`)
-    @tparam StringType the type of the keys or names (e.g., `std::string`).
-    The comparison function `std::less<StringType>` is used to order elements
-    inside the container.
-    @tparam AllocatorType the allocator to use for objects (e.g.,
-    `std::allocator`)
+    /// create a map from a range of pairs; later duplicates are ignored
+    template<class InputIt>
+    flat_map(InputIt first, InputIt last)
+    {
+        insert(first, last);
+    }
 
-    #### Default type
+    iterator begin() noexcept
+    {
+        return m_pairs.begin();
+    }
 
-    With the default values for @a ObjectType (`std::map`), @a StringType
-    (`std::string`), and @a AllocatorType (`std::allocator`), the default
-    value for @a object_t is:
+    const_iterator begin() const noexcept
+    {
+        return m_pairs.begin();
+    }
 
-    @code {.cpp}
-    std::map<
-      std::string, // key_type
-      basic_json, // value_type
-      std::less<std::string>, // key_compare
-      std::allocator<std::pair<const std::string, basic_json>> // allocator_type
-    >
-    @endcode
+    const_iterator cbegin() const noexcept
+    {
+        return m_pairs.cbegin();
+    }
 
-    #### Behavior
+    iterator end() noexcept
+    {
+        return m_pairs.end();
+    }
 
-    The choice of @a object_t influences the behavior of the JSON class. With
-    the default type, objects have the following behavior:
+    const_iterator end() const noexcept
+    {
+        return m_pairs.end();
+    }
 
-    - When all names are unique, objects will be interoperable in the sense
-      that all software implementations receiving that object will agree on
-      the name-value mappings.
-    - When the names within an object are not unique, later stored name/value
-      pairs overwrite previously stored name/value pairs, leaving the used
-      names unique. For instance, `{"key": 1}` and `{"key": 2, "key": 1}` will
-      be treated as equal and both stored as `{"key": 1}`.
-    - Internally, name/value pairs are stored in lexicographical order of the
-      names. Objects will also be serialized (see @ref dump) in this order.
-      For instance, `{"b": 1, "a": 2}` and `{"a": 2, "b": 1}` will be stored
-      and serialized as `{"a": 2, "b": 1}`.
-    - When comparing objects, the order of the name/value pairs is irrelevant.
-      This makes objects interoperable in the sense that they will not be
-      affected by these differences. For instance, `{"b": 1, "a": 2}` and
-      `{"a": 2, "b": 1}` will be treated as equal.
+    const_iterator cend() const noexcept
+    {
+        return m_pairs.cend();
+    }
 
-    #### Limits
+    bool empty() const noexcept
+    {
+        return m_pairs.empty();
+    }
 
-    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
-    > An implementation may set limits on the maximum depth of nesting.
+    size_type size() const noexcept
+    {
+        return m_pairs.size();
+    }
 
-    In this class, the object's limit of nesting is not constraint explicitly.
-    However, a maximum depth of nesting may be introduced by the compiler or
-    runtime environment. A theoretical limit can be queried by calling the
-    @ref max_size function of a JSON object.
+    size_type max_size() const noexcept
+    {
+        return m_pairs.max_size();
+    }
 
-    #### Storage
+    /// reserve storage for @a n pairs
+    void reserve(size_type n)
+    {
+        m_pairs.reserve(n);
+    }
 
-    Objects are stored as pointers in a @ref basic_json type. That is, for any
-    access to object values, a pointer of type `object_t*` must be
-    dereferenced.
+    void clear() noexcept
+    {
+        m_pairs.clear();
+        m_index.clear();
+    }
 
-    @sa @ref array_t -- type for an array value
+    void swap(flat_map& other) noexcept
+    {
+        m_pairs.swap(other.m_pairs);
+        m_index.swap(other.m_index);
+    }
 
-    @since version 1.0.0
+    iterator find(const key_type& key)
+    {
+        return m_pairs.begin() + static_cast<difference_type>(locate(key));
+    }
 
-    @note The order name/value pairs are added to the object is *not*
-    preserved by the library. Therefore, iterating an object may return
-    name/value pairs in a different order than they were originally stored. In
-    fact, keys will be traversed in alphabetical order as `std::map` with
-    `std::less` is used by default. Please note this behavior conforms to [RFC
-    7159](http://rfc7159.net/rfc7159), because any order implements the
-    specified "unordered" nature of JSON objects.
-    */
-    using object_t = ObjectType<StringType,
-          basic_json,
-          std::less<StringType>,
-          AllocatorType<std::pair<const StringType,
-          basic_json>>>;
+    const_iterator find(const key_type& key) const
+    {
+        return m_pairs.begin() + static_cast<difference_type>(locate(key));
+    }
 
-    /*!
-    @brief a type for an array
+    size_type count(const key_type& key) const
+    {
+        return locate(key) == m_pairs.size() ? 0 : 1;
+    }
 
-    [RFC 7159](http://rfc7159.net/rfc7159) describes JSON arrays as follows:
-    > An array is an ordered sequence of zero or more values.
+    /// access specified element with bounds checking
+    mapped_type& at(const key_type& key)
+    {
+        const auto i = locate(key);
+        if (i == m_pairs.size())
+        {
+            throw std::out_of_range("key not found");
+        }
+        return m_pairs[i].second;
+    }
 
-    To store objects in C++, a type is defined by the template parameters
-    explained below.
+    /// access specified element with bounds checking
+    const mapped_type& at(const key_type& key) const
+    {
+        const auto i = locate(key);
+        if (i == m_pairs.size())
+        {
+            throw std::out_of_range("key not found");
+        }
+        return m_pairs[i].second;
+    }
 
-    @tparam ArrayType  container type to store arrays (e.g., `std::vector` or
-    `std::list`)
-    @tparam AllocatorType  allocator to use for arrays (e.g., `std::allocator`)
+    /// access specified element, inserting a default value if needed
+    mapped_type& operator[](const key_type& key)
+    {
+        return emplace(key, mapped_type()).first->second;
+    }
 
-    #### Default type
+    /*!
+    @brief insert a pair unless the key exists
 
-    With the default values for @a ArrayType (`std::vector`) and @a
-    AllocatorType (`std::allocator`), the default value for @a array_t is:
+    @return iterator to the pair with the key, and whether it was inserted
+    */
+    template<typename K, typename V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value)
+    {
+        const auto i = locate(key);
+        if (i != m_pairs.size())
+        {
+            return {m_pairs.begin() + static_cast<difference_type>(i), false};
+        }
+        m_pairs.emplace_back(std::forward<K>(key), std::forward<V>(value));
+        index_back();
+        return {std::prev(m_pairs.end()), true};
+    }
 
-    @code {.cpp}
-    std::vector<
-      basic_json, // value_type
-      std::allocator<basic_json> // allocator_type
-    >
-    @endcode
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return emplace(value.first, value.second);
+    }
 
-    #### Limits
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return emplace(std::move(value.first), std::move(value.second));
+    }
 
-    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
-    > An implementation may set limits on the maximum depth of nesting.
+    template<class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            emplace(first->first, first->second);
+        }
+    }
 
-    In this class, the array's limit of nesting is not constraint explicitly.
-    However, a maximum depth of nesting may be introduced by the compiler or
-    runtime environment. A theoretical limit can be queried by calling the
-    @ref max_size function of a JSON array.
+    /// remove a pair; returns the iterator following it
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, std::next(pos));
+    }
 
-    #### Storage
+    /// remove a range of pairs; returns the iterator following them
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const auto offset = first - m_pairs.cbegin();
+        m_pairs.erase(first, last);
+        rebuild_index();
+        return m_pairs.begin() + offset;
+    }
 
-    Arrays are stored as pointers in a @ref basic_json type. That is, for any
-    access to array values, a pointer of type `array_t*` must be dereferenced.
+    /// remove the pair with a key; returns the number of pairs removed
+    size_type erase(const key_type& key)
+    {
+        const auto i = locate(key);
+        if (i == m_pairs.size())
+        {
+            return 0;
+        }
+        erase(m_pairs.cbegin() + static_cast<difference_type>(i));
+        return 1;
+    }
 
-    @sa @ref object_t -- type for an object value
+    /// equal if both hold the same pairs, in any order
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (const auto& p : lhs.m_pairs)
+        {
+            const auto i = rhs.locate(p.first);
+            if (i == rhs.m_pairs.size() or not (rhs.m_pairs[i].second == p.second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-    @since version 1.0.0
-    */
-    using array_t = ArrayType<basic_json, AllocatorType<basic_json>>;
+    friend bool operator!=(const flat_map& lhs, const flat_map& rhs)
+    {
+        return not (lhs == rhs);
+    }
 
-    /*!
-    @brief a type for a string
+    /// ordered like the `std::map` holding the same pairs
+    friend bool operator<(const flat_map& lhs, const flat_map& rhs)
+    {
+        const auto l = lhs.sorted();
+        const auto r = rhs.sorted();
+        return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end(),
+                                            [](const value_type * a, const value_type * b)
+        {
+            return Compare()(a->first, b->first) or
+                   (not Compare()(b->first, a->first) and a->second < b->second);
+        });
+    }
 
-    [RFC 7159](http://rfc7159.net/rfc7159) describes JSON strings as follows:
-    > A string is a sequence of zero or more Unicode characters.
+  private:
+    /// pointers to the pairs, in key order
+    std::vector<const value_type*> sorted() const
+    {
+        std::vector<const value_type*> result;
+        result.reserve(m_pairs.size());
+        for (const auto& p : m_pairs)
+        {
+            result.push_back(&p);
+        }
+        std::sort(result.begin(), result.end(), [](const value_type * a, const value_type * b)
+        {
+            return Compare()(a->first, b->first);
+        });
+        return result;
+    }
 
-    To store objects in C++, a type is defined by the template parameter
-    described below. Unicode values are split by the JSON class into
-    byte-sized characters during deserialization.
+    /// position of the pair with @a key, or size() if there is none
+    size_type locate(const key_type& key) const
+    {
+        if (m_index.empty())
+        {
+            // small object: compare sizes before bytes
+            const auto n = key.size();
+            for (size_type i = 0; i < m_pairs.size(); ++i)
+            {
+                const key_type& k = m_pairs[i].first;
+                if (k.size() == n and k == key)
+                {
+                    return i;
+                }
+            }
+            return m_pairs.size();
+        }
 
-    @tparam StringType  the container to store strings (e.g., `std::string`).
-    Note this container is used for keys/names in objects, see @ref object_t.
+        const auto mask = m_index.size() - 1;
+        for (auto slot = std::hash<key_type>()(key) & mask; ; slot = (slot + 1) & mask)
+        {
+            const auto entry = m_index[slot];
+            if (entry == 0)
+            {
+                return m_pairs.size();
+            }
+            if (m_pairs[entry - 1].first == key)
+            {
+                return entry - 1;
+            }
+        }
+    }
 
-    #### Default type
+    /// add the last pair to the hash index, building or growing it as needed
+    void index_back()
+    {
+        if (m_pairs.size() < index_threshold)
+        {
+            return;
+        }
+        // keep the load factor at or below 1/2
+        if (m_index.size() < 2 * m_pairs.size())
+        {
+            rebuild_index();
+            return;
+        }
+        place(m_pairs.size() - 1);
+    }
 
-    With the default values for @a StringType (`std::string`), the default
-    value for @a string_t is:
+    /// rebuild the hash index from scratch, or drop it for small objects
+    void rebuild_index()
+    {
+        m_index.clear();
+        if (m_pairs.size() < index_threshold)
+        {
+            return;
+        }
+        size_type capacity = 2 * index_threshold;
+        while (capacity < 4 * m_pairs.size())
+        {
+            capacity *= 2;
+        }
+        m_index.assign(capacity, 0);
+        for (size_type i = 0; i < m_pairs.size(); ++i)
+        {
+            place(i);
+        }
+    }
 
-    @code {.cpp}
-    std::string
-    @endcode
+    /// enter pair @a i into the hash index
+    void place(size_type i)
+    {
+        const auto mask = m_index.size() - 1;
+        auto slot = std::hash<key_type>()(m_pairs[i].first) & mask;
+        while (m_index[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        m_index[slot] = i + 1;
+    }
 
-    #### String comparison
+    /// the pairs, in insertion order
+    container_type m_pairs;
+    /// open-addressing hash index: slot -> position + 1, or 0 if empty
+    std::vector<size_type> m_index;
+};
 
-    [RFC 7159](http://rfc7159.net/rfc7159) states:
-    > Software implementations are typically required to test names of object
-    > members for equality. Implementations that transform the textual
-    > representation into sequences of Unicode code units and then perform the
-    > comparison numerically, code unit by code unit, are interoperable in the
-    > sense that implementations will agree in all cases on equality or
-    > inequality of two strings. For example, implementations that compare
-    > strings with escaped characters unconverted may incorrectly find that
-    > `"a\\b"` and `"a\u005Cb"` are not equal.
+template<typename Key, typename T, typename Compare, typename Allocator>
+constexpr typename flat_map<Key, T, Compare, Allocator>::size_type
+flat_map<Key, T, Compare, Allocator>::index_threshold;
 
-    This implementation is interoperable as it does compare strings code unit
-    by code unit.
+/*!
+@brief locale-independent conversion of JSON number tokens to `double`
 
-    #### Storage
+Significands of up to 19 digits are converted with Clinger's fast path when
+both the significand and the power of ten are exact doubles, and otherwise
+with the Eisel-Lemire algorithm: the significand is multiplied by a 128-bit
+approximation of the power of five, which determines the correctly rounded
+result except for products too close to a halfway point to tell. Those rare
+cases, and longer significands whose truncation to 19 digits changes the
+result, fall back to `strtod_l` in the "C" locale. No case consults the global
+C locale, and the token is always read in place.
 
-    String values are stored as pointers in a @ref basic_json type. That is,
-    for any access to string values, a pointer of type `string_t*` must be
-    dereferenced.
+*/
+class float_parser
+{
+  public:
+    /*!
+    @brief convert a JSON number token
 
-    @since version 1.0.0
+    @param[in] first  first character of a valid JSON number token
+    @param[in] last  one past its last character
+
+    @return the correctly rounded value (infinity if it is out of range)
     */
-    using string_t = StringType;
+    static double parse(const char* first, const char* last) noexcept
+    {
+        const bool negative = (*first == '-');
+        const char* p = negative ? first + 1 : first;
 
-    /*!
-    @brief a type for a boolean
+        // the significand, ignoring the radix point (may wrap; see below)
+        uint64_t w = 0;
+        const char* const int_first = p;
+        while (p != last and is_digit(*p))
+        {
+            w = 10 * w + static_cast<uint64_t>(*p++ - '0');
+        }
+        const char* const int_last = p;
+        const char* frac_first = p;
+        if (p != last and *p == '.')
+        {
+            frac_first = ++p;
+            while (p != last and is_digit(*p))
+            {
+                w = 10 * w + static_cast<uint64_t>(*p++ - '0');
+            }
+        }
+        const char* const frac_last = p;
 
-    [RFC 7159](http://rfc7159.net/rfc7159) implicitly describes a boolean as a
-    type which differentiates the two literals `true` and `false`.
+        int64_t exp_number = 0;
+        if (p != last and (*p == 'e' or *p == 'E'))
+        {
+            ++p;
+            const bool negative_exp = (p != last and *p == '-');
+            if (p != last and (*p == '-' or *p == '+'))
+            {
+                ++p;
+            }
+            while (p != last and is_digit(*p))
+            {
+                // saturate; anything this large is 0 or infinity anyway
+                if (exp_number < 0x10000000)
+                {
+                    exp_number = 10 * exp_number + (*p - '0');
+                }
+                ++p;
+            }
+            if (negative_exp)
+            {
+                exp_number = -exp_number;
+            }
+        }
+        int64_t exponent = exp_number - (frac_last - frac_first);
 
-    To store objects in C++, a type is defined by the template parameter @a
-    BooleanType which chooses the type to use.
+        // more than 19 significant digits: keep the first 19 and check
+        // below that the dropped ones do not matter
+        bool truncated = false;
+        auto num_digits = (int_last - int_first) + (frac_last - frac_first);
+        if (num_digits > 19)
+        {
+            for (const char* s = int_first; s != frac_last and (*s == '0' or *s == '.'); ++s)
+            {
+                num_digits -= (*s == '0');
+            }
+            if (num_digits > 19)
+            {
+                const uint64_t min_19_digits = 1000000000000000000ULL;
+                truncated = true;
+                w = 0;
+                p = int_first;
+                while (w < min_19_digits and p != int_last)
+                {
+                    w = 10 * w + static_cast<uint64_t>(*p++ - '0');
+                }
+                if (w >= min_19_digits)
+                {
+                    exponent = exp_number + (int_last - p);
+                }
+                else
+                {
+                    p = frac_first;
+                    while (w < min_19_digits and p != frac_last)
+                    {
+                        w = 10 * w + static_cast<uint64_t>(*p++ - '0');
+                    }
+                    exponent = exp_number - (p - frac_first);
+                }
+            }
+        }
 
-    #### Default type
+        // Clinger: both operands are exact, so one rounding is all there is
+        if (clinger_exact and not truncated and exponent >= -22 and exponent <= 22
+                and w <= (uint64_t(1) << 53))
+        {
+            static const double powers_of_ten[] =
+            {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            double d = static_cast<double>(w);
+            d = (exponent < 0) ? d / powers_of_ten[-exponent] : d * powers_of_ten[exponent];
+            return negative ? -d : d;
+        }
 
-    With the default values for @a BooleanType (`bool`), the default value for
-    @a boolean_t is:
+        adjusted_mantissa am = eisel_lemire(exponent, w);
+        if (truncated and am.power2 >= 0 and not (am == eisel_lemire(exponent, w + 1)))
+        {
+            am.power2 = -1;
+        }
+        if (am.power2 < 0)
+        {
+            return slow_path(first);
+        }
 
-    @code {.cpp}
-    bool
-    @endcode
+        const uint64_t bits = am.mantissa | (static_cast<uint64_t>(am.power2) << 52)
+                              | (static_cast<uint64_t>(negative) << 63);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
 
-    #### Storage
+  private:
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    static constexpr bool clinger_exact = true;
+#else
+    /// with extended precision intermediates the fast path rounds twice
+    static constexpr bool clinger_exact = false;
+#endif
 
-    Boolean values are stored directly inside a @ref basic_json type.
+    /// range of the power of five table
+    static constexpr int smallest_power = -342;
+    static constexpr int largest_power = 308;
 
-    @since version 1.0.0
-    */
-    using boolean_t = BooleanType;
+    /// a double as significand (with the hidden bit cleared) and biased
+    /// exponent; a negative exponent means the result is undecided
+    struct adjusted_mantissa
+    {
+        uint64_t mantissa;
+        int power2;
 
-    /*!
-    @brief a type for a number (integer)
+        bool operator==(const adjusted_mantissa& other) const noexcept
+        {
+            return mantissa == other.mantissa and power2 == other.power2;
+        }
+    };
 
-    [RFC 7159](http://rfc7159.net/rfc7159) describes numbers as follows:
-    > The representation of numbers is similar to that used in most
-    > programming languages. A number is represented in base 10 using decimal
-    > digits. It contains an integer component that may be prefixed with an
-    > optional minus sign, which may be followed by a fraction part and/or an
-    > exponent part. Leading zeros are not allowed. (...) Numeric values that
-    > cannot be represented in the grammar below (such as Infinity and NaN)
-    > are not permitted.
-
-    This description includes both integer and floating-point numbers.
-    However, C++ allows more precise storage if it is known whether the number
-    is a signed integer, an unsigned integer or a floating-point number.
-    Therefore, three different types, @ref number_integer_t, @ref
-    number_unsigned_t and @ref number_float_t are used.
-
-    To store integer numbers in C++, a type is defined by the template
-    parameter @a NumberIntegerType which chooses the type to use.
+    static bool is_digit(char c) noexcept
+    {
+        return c >= '0' and c <= '9';
+    }
 
-    #### Default type
+    static int leading_zeros(uint64_t x) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_clzll(x);
+#else
+        int n = 0;
+        for (; (x & (uint64_t(1) << 63)) == 0; x <<= 1)
+        {
+            ++n;
+        }
+        return n;
+#endif
+    }
 
-    With the default values for @a NumberIntegerType (`int64_t`), the default
-    value for @a number_integer_t is:
+    /// the 128-bit product of two 64-bit numbers
+    static void multiply(uint64_t a, uint64_t b, uint64_t& hi, uint64_t& lo) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 uint128;
+        const uint128 r = static_cast<uint128>(a) * b;
+        hi = static_cast<uint64_t>(r >> 64);
+        lo = static_cast<uint64_t>(r);
+#else
+        const uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+        const uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+        const uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+        const uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+        const uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+        lo = (mid << 32) | (ll & 0xffffffffu);
+        hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    }
 
-    @code {.cpp}
-    int64_t
-    @endcode
+    /*!
+    @brief the correctly rounded double nearest w * 10^q
 
-    #### Default behavior
+    @param[in] q  decimal exponent
+    @param[in] w  decimal significand
 
-    - The restrictions about leading zeros is not enforced in C++. Instead,
-      leading zeros in integer literals lead to an interpretation as octal
-      number. Internally, the value will be stored as decimal number. For
-      instance, the C++ integer literal `010` will be serialized to `8`.
-      During deserialization, leading zeros yield an error.
-    - Not-a-number (NaN) values will be serialized to `null`.
+    @return the result, or a negative power2 if the product is too close to
+    a halfway point to round
+    */
+    static adjusted_mantissa eisel_lemire(int64_t q, uint64_t w) noexcept
+    {
+        adjusted_mantissa answer = {0, 0};
+        if (w == 0 or q < smallest_power)
+        {
+            return answer;
+        }
+        if (q > largest_power)
+        {
+            answer.power2 = 0x7FF;
+            return answer;
+        }
 
-    #### Limits
+        const int lz = leading_zeros(w);
+        w <<= lz;
 
-    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
-    > An implementation may set limits on the range and precision of numbers.
+        // w times the truncated power of five; the second word of the power
+        // only matters if the first product is ambiguous in the 55 bits used
+        const uint64_t* const power = powers_of_five() + 2 * (q - smallest_power);
+        uint64_t hi, lo;
+        multiply(w, power[0], hi, lo);
+        if ((hi & 0x1FF) == 0x1FF)
+        {
+            uint64_t hi2, lo2;
+            multiply(w, power[1], hi2, lo2);
+            lo += hi2;
+            hi += (hi2 > lo);
+            if (lo == 0xFFFFFFFFFFFFFFFFULL and (q < -27 or q > 55))
+            {
+                answer.power2 = -1;
+                return answer;
+            }
+        }
 
-    When the default type is used, the maximal integer number that can be
-    stored is `9223372036854775807` (INT64_MAX) and the minimal integer number
-    that can be stored is `-9223372036854775808` (INT64_MIN). Integer numbers
-    that are out of range will yield over/underflow when used in a
-    constructor. During deserialization, too large or small integer numbers
-    will be automatically be stored as @ref number_unsigned_t or @ref
-    number_float_t.
+        const int upperbit = static_cast<int>(hi >> 63);
+        const int shift = upperbit + 64 - 52 - 3;
+        answer.mantissa = hi >> shift;
+        // floor(q * log2(10)) + 63
+        const int power_of_two = static_cast<int>(((152170 + 65536) * q) >> 16) + 63;
+        answer.power2 = power_of_two + upperbit - lz + 1023;
 
-    [RFC 7159](http://rfc7159.net/rfc7159) further states:
-    > Note that when such software is used, numbers that are integers and are
-    > in the range \f$[-2^{53}+1, 2^{53}-1]\f$ are interoperable in the sense
-    > that implementations will agree exactly on their numeric values.
+        if (answer.power2 <= 0)
+        {
+            // subnormal
+            if (-answer.power2 + 1 >= 64)
+            {
+                answer.mantissa = 0;
+                answer.power2 = 0;
+                return answer;
+            }
+            answer.mantissa >>= -answer.power2 + 1;
+            answer.mantissa += (answer.mantissa & 1);
+            answer.mantissa >>= 1;
+            answer.power2 = (answer.mantissa < (uint64_t(1) << 52)) ? 0 : 1;
+            return answer;
+        }
 
-    As this range is a subrange of the exactly supported range [INT64_MIN,
-    INT64_MAX], this class's integer type is interoperable.
+        // exactly halfway between two doubles: round to even
+        if (lo <= 1 and q >= -4 and q <= 23 and (answer.mantissa & 3) == 1
+                and (answer.mantissa << shift) == hi)
+        {
+            answer.mantissa &= ~uint64_t(1);
+        }
 
-    #### Storage
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        if (answer.mantissa >= (uint64_t(2) << 52))
+        {
+            answer.mantissa = uint64_t(1) << 52;
+            ++answer.power2;
+        }
+        answer.mantissa &= ~(uint64_t(1) << 52);
+        if (answer.power2 >= 0x7FF)
+        {
+            answer.mantissa = 0;
+            answer.power2 = 0x7FF;
+        }
+        return answer;
+    }
 
-    Integer number values are stored directly inside a @ref basic_json type.
+    /// an arbitrary precision unsigned integer, least significant limb first
+    using bignum = std::vector<uint32_t>;
 
-    @sa @ref number_float_t -- type for number values (floating-point)
+    static void bignum_multiply_5(bignum& v)
+    {
+        uint64_t carry = 0;
+        for (auto& limb : v)
+        {
+            const uint64_t x = uint64_t(limb) * 5 + carry;
+            limb = static_cast<uint32_t>(x);
+            carry = x >> 32;
+        }
+        if (carry != 0)
+        {
+            v.push_back(static_cast<uint32_t>(carry));
+        }
+    }
 
-    @sa @ref number_unsigned_t -- type for number values (unsigned integer)
+    /// v = floor(v / 5)
+    static void bignum_divide_5(bignum& v)
+    {
+        uint64_t rem = 0;
+        for (size_t i = v.size(); i-- > 0;)
+        {
+            const uint64_t x = (rem << 32) | v[i];
+            v[i] = static_cast<uint32_t>(x / 5);
+            rem = x % 5;
+        }
+        while (not v.empty() and v.back() == 0)
+        {
+            v.pop_back();
+        }
+    }
 
-    @since version 1.0.0
-    */
-    using number_integer_t = NumberIntegerType;
+    static int64_t bignum_bits(const bignum& v)
+    {
+        if (v.empty())
+        {
+            return 0;
+        }
+        int64_t bits = 32 * static_cast<int64_t>(v.size());
+        for (uint32_t top = v.back(); (top & 0x80000000u) == 0; top <<= 1)
+        {
+            --bits;
+        }
+        return bits;
+    }
 
-    /*!
-    @brief a type for a number (unsigned)
+    static bool bignum_bit(const bignum& v, int64_t i)
+    {
+        return i >= 0 and static_cast<size_t>(i / 32) < v.size()
+               and ((v[static_cast<size_t>(i / 32)] >> (i % 32)) & 1) != 0;
+    }
 
-    [RFC 7159](http://rfc7159.net/rfc7159) describes numbers as follows:
-    > The representation of numbers is similar to that used in most
-    > programming languages. A number is represented in base 10 using decimal
-    > digits. It contains an integer component that may be prefixed with an
-    > optional minus sign, which may be followed by a fraction part and/or an
-    > exponent part. Leading zeros are not allowed. (...) Numeric values that
-    > cannot be represented in the grammar below (such as Infinity and NaN)
-    > are not permitted.
+    /// floor(v / 2^s) + 1
+    static bignum bignum_shift_increment(const bignum& v, int64_t s)
+    {
+        bignum r;
+        const int64_t n = bignum_bits(v) - s;
+        r.resize(static_cast<size_t>(n / 32 + 2));
+        for (int64_t i = 0; i < n; ++i)
+        {
+            if (bignum_bit(v, i + s))
+            {
+                r[static_cast<size_t>(i / 32)] |= uint32_t(1) << (i % 32);
+            }
+        }
+        for (auto& limb : r)
+        {
+            if (++limb != 0)
+            {
+                break;
+            }
+        }
+        while (not r.empty() and r.back() == 0)
+        {
+            r.pop_back();
+        }
+        return r;
+    }
 
-    This description includes both integer and floating-point numbers.
-    However, C++ allows more precise storage if it is known whether the number
-    is a signed integer, an unsigned integer or a floating-point number.
-    Therefore, three different types, @ref number_integer_t, @ref
-    number_unsigned_t and @ref number_float_t are used.
+    /// the 128 most significant bits of v, scaled up if v has fewer
+    static void bignum_top(const bignum& v, uint64_t* out)
+    {
+        const int64_t bits = bignum_bits(v);
+        out[0] = out[1] = 0;
+        for (int i = 0; i < 128; ++i)
+        {
+            if (bignum_bit(v, bits - 1 - i))
+            {
+                out[i / 64] |= uint64_t(1) << (63 - i % 64);
+            }
+        }
+    }
 
-    To store unsigned integer numbers in C++, a type is defined by the
-    template parameter @a NumberUnsignedType which chooses the type to use.
+    /*!
+    @brief 128-bit truncations of 5^q for q in [-342, 308]
 
-    #### Default type
+    Entry q is 5^q scaled by a power of two into [2^127, 2^128), as two
+    64-bit words, most significant first. Positive powers are truncated;
+    negative ones are rounded up before truncation, as the Eisel-Lemire
+    error analysis requires. The table is computed exactly, with a small
+    bignum, the first time a number needs it.
+    */
+    static const uint64_t* powers_of_five()
+    {
+        struct table
+        {
+            uint64_t entries[2 * (largest_power - smallest_power + 1)];
 
-    With the default values for @a NumberUnsignedType (`uint64_t`), the
-    default value for @a number_unsigned_t is:
+            table()
+            {
+                bignum power = {1};
+                for (int q = 0; q <= largest_power; ++q)
+                {
+                    bignum_top(power, entries + 2 * (q - smallest_power));
+                    bignum_multiply_5(power);
+                }
 
-    @code {.cpp}
-    uint64_t
-    @endcode
+                // floor(2^b / 5^p) is floor(2^b_max / 5^p) >> (b_max - b)
+                const int64_t b_max = 1800;
+                bignum quotient(b_max / 32 + 1, 0);
+                quotient.back() = uint32_t(1) << (b_max % 32);
+                power = {1};
+                for (int q = -1; q >= smallest_power; --q)
+                {
+                    bignum_multiply_5(power);
+                    bignum_divide_5(quotient);
+                    const int64_t z = bignum_bits(power);
+                    const int64_t b = (q >= -27) ? z + 127 : 2 * z + 128;
+                    bignum_top(bignum_shift_increment(quotient, b_max - b),
+                               entries + 2 * (q - smallest_power));
+                }
+            }
+        };
+        static const table powers;
+        return powers.entries;
+    }
+
+    /// correctly rounded conversion for the cases the fast paths leave open
+    static double slow_path(const char* first)
+    {
+        // the token is followed by a character that cannot continue a number
+#if defined(_WIN32)
+        static const _locale_t c_locale = _create_locale(LC_NUMERIC, "C");
+        return _strtod_l(first, nullptr, c_locale);
+#elif defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+        static const locale_t c_locale = newlocale(LC_NUMERIC_MASK, "C", locale_t(0));
+        return strtod_l(first, nullptr, c_locale);
+#else
+        return std::strtod(first, nullptr);
+#endif
+    }
+};
 
-    #### Default behavior
+/*!
+@brief vectorized scanning of JSON string contents
+
+Used by the lexer to find the end of a string without running it through the
+general scanner, and to check that strings are valid UTF-8. On x86 the scan
+looks at 16 bytes at a time with SSE2, and the validation classifies 16 bytes
+at a time with the SSSE3 table lookups of Keiser and Lemire ("Validating
+UTF-8 In Less Than One Instruction Per Byte"), chosen at run time; blocks of
+pure ASCII are skipped after a single test. Elsewhere both fall back to a
+byte at a time.
+*/
+class string_scanner
+{
+  public:
+    /*!
+    @brief find the first byte that ends a plain run of string contents
 
-    - The restrictions about leading zeros is not enforced in C++. Instead,
-      leading zeros in integer literals lead to an interpretation as octal
-      number. Internally, the value will be stored as decimal number. For
-      instance, the C++ integer literal `010` will be serialized to `8`.
-      During deserialization, leading zeros yield an error.
-    - Not-a-number (NaN) values will be serialized to `null`.
+    @param[in] first  first byte after the opening quote
+    @param[in] last  end of the readable input
+    @param[out] ascii  whether all bytes before the result are ASCII
 
-    #### Limits
+    @return the first quote, backslash, or control character in
+    [first, last), or @a last if there is none
+    */
+    static const char* find_special(const char* first, const char* last, bool& ascii) noexcept
+    {
+        unsigned high = 0;
+#if defined(__SSE2__)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        for (; last - first >= 16; first += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            const __m128i special = _mm_or_si128(
+                                        _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                        _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+            const unsigned non_ascii = static_cast<unsigned>(_mm_movemask_epi8(v));
+            if (mask != 0)
+            {
+                // only the bytes before the special one count
+                const unsigned before = mask & (0u - mask);
+                ascii = ((high | (non_ascii & (before - 1))) == 0);
+                return first + count_trailing_zeros(mask);
+            }
+            high |= non_ascii;
+        }
+#endif
+        for (; first != last; ++first)
+        {
+            const auto c = static_cast<unsigned char>(*first);
+            if (c == '"' or c == '\\' or c < 0x20)
+            {
+                break;
+            }
+            high |= (c & 0x80u);
+        }
+        ascii = (high == 0);
+        return first;
+    }
 
-    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
-    > An implementation may set limits on the range and precision of numbers.
+    /*!
+    @brief check that a range of bytes is valid UTF-8
 
-    When the default type is used, the maximal integer number that can be
-    stored is `18446744073709551615` (UINT64_MAX) and the minimal integer
-    number that can be stored is `0`. Integer numbers that are out of range
-    will yield over/underflow when used in a constructor. During
-    deserialization, too large or small integer numbers will be automatically
-    be stored as @ref number_integer_t or @ref number_float_t.
+    Overlong encodings, surrogates, code points above U+10FFFF and truncated
+    sequences are all rejected.
 
-    [RFC 7159](http://rfc7159.net/rfc7159) further states:
-    > Note that when such software is used, numbers that are integers and are
-    > in the range \f$[-2^{53}+1, 2^{53}-1]\f$ are interoperable in the sense
-    > that implementations will agree exactly on their numeric values.
+    @param[in] first  first byte
+    @param[in] last  one past the last byte
 
-    As this range is a subrange (when considered in conjunction with the
-    number_integer_t type) of the exactly supported range [0, UINT64_MAX], this
-    class's integer type is interoperable.
+    @return whether [first, last) is valid UTF-8
+    */
+    static bool valid_utf8(const char* first, const char* last) noexcept
+    {
+#if defined(NLOHMANN_JSON_X86_SIMD)
+        static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+        if (has_ssse3)
+        {
+            return valid_utf8_ssse3(first, last);
+        }
+#endif
+        return valid_utf8_scalar(first, last);
+    }
 
-    #### Storage
+    /// check UTF-8 one byte at a time (also the reference for the SSSE3 path)
+    static bool valid_utf8_scalar(const char* first, const char* last) noexcept
+    {
+        const auto* p = reinterpret_cast<const unsigned char*>(first);
+        const auto* const end = reinterpret_cast<const unsigned char*>(last);
+        while (p != end)
+        {
+            const unsigned char c = *p;
+            if (c < 0x80)
+            {
+                ++p;
+                continue;
+            }
 
-    Integer number values are stored directly inside a @ref basic_json type.
+            // the length of the sequence and the range of its second byte
+            std::ptrdiff_t len;
+            unsigned char lo = 0x80, hi = 0xBF;
+            if (c >= 0xC2 and c <= 0xDF)
+            {
+                len = 2;
+            }
+            else if (c >= 0xE0 and c <= 0xEF)
+            {
+                len = 3;
+                lo = (c == 0xE0) ? 0xA0 : 0x80;
+                hi = (c == 0xED) ? 0x9F : 0xBF;
+            }
+            else if (c >= 0xF0 and c <= 0xF4)
+            {
+                len = 4;
+                lo = (c == 0xF0) ? 0x90 : 0x80;
+                hi = (c == 0xF4) ? 0x8F : 0xBF;
+            }
+            else
+            {
+                return false;
+            }
 
-    @sa @ref number_float_t -- type for number values (floating-point)
+            if (end - p < len or p[1] < lo or p[1] > hi)
+            {
+                return false;
+            }
+            for (std::ptrdiff_t i = 2; i < len; ++i)
+            {
+                if ((p[i] & 0xC0) != 0x80)
+                {
+                    return false;
+                }
+            }
+            p += len;
+        }
+        return true;
+    }
+
+#if defined(NLOHMANN_JSON_X86_SIMD)
+    /// check UTF-8 16 bytes at a time; requires SSSE3
+    __attribute__((target("ssse3")))
+    static bool valid_utf8_ssse3(const char* first, const char* last) noexcept
+    {
+        // error classes of a byte pair, looked up by the high and low nibble
+        // of the first byte and the high nibble of the second
+        const uint8_t too_short = 1 << 0;   // lead byte followed by ASCII or a lead
+        const uint8_t too_long = 1 << 1;    // ASCII followed by a continuation
+        const uint8_t overlong_3 = 1 << 2;  // E0 80..9F
+        const uint8_t too_large = 1 << 3;   // F4 90..BF, F5..FF
+        const uint8_t surrogate = 1 << 4;   // ED A0..BF
+        const uint8_t overlong_2 = 1 << 5;  // C0..C1
+        const uint8_t too_large_1000 = 1 << 6;
+        const uint8_t overlong_4 = 1 << 6;  // F0 80..8F
+        const uint8_t two_conts = 1 << 7;   // two continuations in a row
+        const uint8_t carry = too_short | too_long | two_conts;
+
+        const __m128i byte_1_high_table = _mm_setr_epi8(
+                                              too_long, too_long, too_long, too_long,
+                                              too_long, too_long, too_long, too_long,
+                                              char(two_conts), char(two_conts), char(two_conts), char(two_conts),
+                                              too_short | overlong_2,
+                                              too_short,
+                                              too_short | overlong_3 | surrogate,
+                                              too_short | too_large | too_large_1000 | overlong_4);
+        const __m128i byte_1_low_table = _mm_setr_epi8(
+                                             char(carry | overlong_3 | overlong_2 | overlong_4),
+                                             char(carry | overlong_2),
+                                             char(carry), char(carry),
+                                             char(carry | too_large),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000 | surrogate),
+                                             char(carry | too_large | too_large_1000),
+                                             char(carry | too_large | too_large_1000));
+        const __m128i byte_2_high_table = _mm_setr_epi8(
+                                              too_short, too_short, too_short, too_short,
+                                              too_short, too_short, too_short, too_short,
+                                              char(too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4),
+                                              char(too_long | overlong_2 | two_conts | overlong_3 | too_large),
+                                              char(too_long | overlong_2 | two_conts | surrogate | too_large),
+                                              char(too_long | overlong_2 | two_conts | surrogate | too_large),
+                                              too_short, too_short, too_short, too_short);
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        // a lead byte in the last three positions needs more bytes
+        const __m128i incomplete_max = _mm_setr_epi8(
+                                           -1, -1, -1, -1, -1, -1, -1, -1,
+                                           -1, -1, -1, -1, -1,
+                                           char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+
+        __m128i error = _mm_setzero_si128();
+        __m128i prev = _mm_setzero_si128();
+        __m128i prev_incomplete = _mm_setzero_si128();
+        bool done = false;
+        while (not done)
+        {
+            __m128i input;
+            if (last - first >= 16)
+            {
+                input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                first += 16;
+            }
+            else
+            {
+                // the tail, padded with ASCII so that truncation shows
+                char block[16] = {};
+                std::memcpy(block, first, static_cast<size_t>(last - first));
+                input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+                done = true;
+            }
 
-    @sa @ref number_integer_t -- type for number values (integer)
+            if (_mm_movemask_epi8(input) == 0)
+            {
+                // pure ASCII: only a sequence cut off by the last block is wrong
+                error = _mm_or_si128(error, prev_incomplete);
+                prev_incomplete = _mm_setzero_si128();
+            }
+            else
+            {
+                const __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+                const __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table,
+                                            _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+                const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table,
+                                           _mm_and_si128(prev1, nibble));
+                const __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table,
+                                            _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+                const __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low),
+                                              byte_2_high);
+
+                // third and fourth bytes of a sequence must be continuations
+                const __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+                const __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+                const __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80)));
+                const __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)));
+                const __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third, is_fourth),
+                                                     _mm_set1_epi8(char(0x80)));
+                error = _mm_or_si128(error, _mm_xor_si128(must_be_continuation, special_cases));
+                prev_incomplete = _mm_subs_epu8(input, incomplete_max);
+            }
+            prev = input;
+        }
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+    }
+#endif
 
-    @since version 2.0.0
-    */
-    using number_unsigned_t = NumberUnsignedType;
+  private:
+    static int count_trailing_zeros(unsigned mask) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_ctz(mask);
+#else
+        int n = 0;
+        for (; (mask & 1) == 0; mask >>= 1)
+        {
+            ++n;
+        }
+        return n;
+#endif
+    }
+};
 
-    /*!
-    @brief a type for a number (floating-point)
+/*!
+@brief a class to store JSON values
 
-    [RFC 7159](http://rfc7159.net/rfc7159) describes numbers as follows:
-    > The representation of numbers is similar to that used in most
-    > programming languages. A number is represented in base 10 using decimal
-    > digits. It contains an integer component that may be prefixed with an
-    > optional minus sign, which may be followed by a fraction part and/or an
-    > exponent part. Leading zeros are not allowed. (...) Numeric values that
-    > cannot be represented in the grammar below (such as Infinity and NaN)
-    > are not permitted.
-
-    This description includes both integer and floating-point numbers.
-    However, C++ allows more precise storage if it is known whether the number
-    is a signed integer, an unsigned integer or a floating-point number.
-    Therefore, three different types, @ref number_integer_t, @ref
-    number_unsigned_t and @ref number_float_t are used.
+@tparam ObjectType type for JSON objects (`std::map` by default; will be used
+in @ref object_t)
+@tparam ArrayType type for JSON arrays (`std::vector` by default; will be used
+in @ref array_t)
+@tparam StringType type for JSON strings and object keys (`std::string` by
+default; will be used in @ref string_t)
+@tparam BooleanType type for JSON booleans (`bool` by default; will be used
+in @ref boolean_t)
+@tparam NumberIntegerType type for JSON integer numbers (`int64_t` by
+default; will be used in @ref number_integer_t)
+@tparam NumberUnsignedType type for JSON unsigned integer numbers (@c
+`uint64_t` by default; will be used in @ref number_unsigned_t)
+@tparam NumberFloatType type for JSON floating-point numbers (`double` by
+default; will be used in @ref number_float_t)
+@tparam AllocatorType type of the allocator to use (`std::allocator` by
+default)
 
-    To store floating-point numbers in C++, a type is defined by the template
-    parameter @a NumberFloatType which chooses the type to use.
+@requirement The class satisfies the following concept requirements:
+- Basic
+ - [DefaultConstructible](http://en.cppreference.com/w/cpp/concept/DefaultConstructible):
+   JSON values can be default constructed. The result will be a JSON null value.
+ - [MoveConstructible](http://en.cppreference.com/w/cpp/concept/MoveConstructible):
+   A JSON value can be constructed from an rvalue argument.
+ - [CopyConstructible](http://en.cppreference.com/w/cpp/concept/CopyConstructible):
+   A JSON value can be copy-constructed from an lvalue expression.
+ - [MoveAssignable](http://en.cppreference.com/w/cpp/concept/MoveAssignable):
+   A JSON value van be assigned from an rvalue argument.
+ - [CopyAssignable](http://en.cppreference.com/w/cpp/concept/CopyAssignable):
+   A JSON value can be copy-assigned from an lvalue expression.
+ - [Destructible](http://en.cppreference.com/w/cpp/concept/Destructible):
+   JSON values can be destructed.
+- Layout
+ - [StandardLayoutType](http://en.cppreference.com/w/cpp/concept/StandardLayoutType):
+   JSON values have
+   [standard layout](http://en.cppreference.com/w/cpp/language/data_members#Standard_layout):
+   All non-static data members are private and standard layout types, the class
+   has no virtual functions or (virtual) base classes.
+- Library-wide
+ - [EqualityComparable](http://en.cppreference.com/w/cpp/concept/EqualityComparable):
+   JSON values can be compared with `==`, see @ref
+   operator==(const_reference,const_reference).
+ - [LessThanComparable](http://en.cppreference.com/w/cpp/concept/LessThanComparable):
+   JSON values can be compared with `<`, see @ref
+   operator<(const_reference,const_reference).
+ - [Swappable](http://en.cppreference.com/w/cpp/concept/Swappable):
+   Any JSON lvalue or rvalue of can be swapped with any lvalue or rvalue of
+   other compatible types, using unqualified function call @ref swap().
+ - [NullablePointer](http://en.cppreference.com/w/cpp/concept/NullablePointer):
+   JSON values can be compared against `std::nullptr_t` objects which are used
+   to model the `null` value.
+- Container
+ - [Container](http://en.cppreference.com/w/cpp/concept/Container):
+   JSON values can be used like STL containers and provide iterator access.
+ - [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer);
+   JSON values can be used like STL containers and provide reverse iterator
+   access.
 
-    #### Default type
+@internal
+@note ObjectType trick from http://stackoverflow.com/a/9860911
+@endinternal
 
-    With the default values for @a NumberFloatType (`double`), the default
-    value for @a number_float_t is:
+@see [RFC 7159: The JavaScript Object Notation (JSON) Data Interchange
+Format](http://rfc7159.net/rfc7159)
 
-    @code {.cpp}
-    double
-    @endcode
+@since version 1.0.0
 
-    #### Default behavior
+@nosubgrouping
+*/
+template <
+    template<typename U, typename V, typename... Args> class ObjectType = std::map,
+    template<typename U, typename... Args> class ArrayType = std::vector,
+    class StringType = std::string,
+    class BooleanType = bool,
+    class NumberIntegerType = std::int64_t,
+    class NumberUnsignedType = std::uint64_t,
+    class NumberFloatType = double,
+    template<typename U> class AllocatorType = std::allocator
+    >
+class basic_json
+{
+  private:
+    /// workaround type for MSVC
+    using basic_json_t = basic_json<ObjectType,
+          ArrayType,
+          StringType,
+          BooleanType,
+          NumberIntegerType,
+          NumberUnsignedType,
+          NumberFloatType,
+          AllocatorType>;
 
-    - The restrictions about leading zeros is not enforced in C++. Instead,
-      leading zeros in floating-point literals will be ignored. Internally,
-      the value will be stored as decimal number. For instance, the C++
-      floating-point literal `01.2` will be serialized to `1.2`. During
-      deserialization, leading zeros yield an error.
-    - Not-a-number (NaN) values will be serialized to `null`.
+  public:
+    // forward declarations
+    template<typename Base> class json_reverse_iterator;
+    class json_pointer;
 
-    #### Limits
+    /////////////////////
+    // container types //
+    /////////////////////
 
-    [RFC 7159](http://rfc7159.net/rfc7159) states:
-    > This specification allows implementations to set limits on the range and
-    > precision of numbers accepted. Since software that implements IEEE
-    > 754-2008 binary64 (double precision) numbers is generally available and
-    > widely used, good interoperability can be achieved by implementations
-    > that expect no more precision or range than these provide, in the sense
-    > that implementations will approximate JSON numbers within the expected
-    > precision.
+    /// @name container types
+    /// @{
 
-    This implementation does exactly follow this approach, as it uses double
-    precision floating-point numbers. Note values smaller than
-    `-1.79769313486232e+308` and values greater than `1.79769313486232e+308`
-    will be stored as NaN internally and be serialized to `null`.
+    /// the type of elements in a basic_json container
+    using value_type = basic_json;
 
-    #### Storage
+    /// the type of an element reference
+    using reference = value_type&;
+    /// the type of an element const reference
+    using const_reference = const value_type&;
 
-    Floating-point number values are stored directly inside a @ref basic_json
-    type.
+    /// a type to represent differences between iterators
+    using difference_type = std::ptrdiff_t;
+    /// a type to represent container sizes
+    using size_type = std::size_t;
 
-    @sa @ref number_integer_t -- type for number values (integer)
+    /// the allocator type
+    using allocator_type = AllocatorType<basic_json>;
 
-    @sa @ref number_unsigned_t -- type for number values (unsigned integer)
+    /// the type of an element pointer
+    using pointer = typename std::allocator_traits<allocator_type>::pointer;
+    /// the type of an element const pointer
+    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
 
-    @since version 1.0.0
-    */
-    using number_float_t = NumberFloatType;
+    /// an iterator for a basic_json container
+    class iterator;
+    /// a const iterator for a basic_json container
+    class const_iterator;
+    /// a reverse iterator for a basic_json container
+    using reverse_iterator = json_reverse_iterator<typename basic_json::iterator>;
+    /// a const reverse iterator for a basic_json container
+    using const_reverse_iterator = json_reverse_iterator<typename basic_json::const_iterator>;
 
     /// @}
 
 
+    /*!
+    @brief returns the allocator associated with the container
+    */
+    static allocator_type get_allocator()
+    {
+        return allocator_type();
+    }
+
+
     ///////////////////////////
-    // JSON type enumeration //
+    // JSON value data types //
     ///////////////////////////
 
+    /// @name JSON value data types
+    /// @{
+
     /*!
-    @brief the JSON type enumeration
+    @brief a type for an object
 
-    This enumeration collects the different JSON types. It is internally used
-    to distinguish the stored values, and the functions @ref is_null(), @ref
-    is_object(), @ref is_array(), @ref is_string(), @ref is_boolean(), @ref
-    is_number(), and @ref is_discarded() rely on it.
+    [RFC 7159](http://rfc7159.net/rfc7159) describes JSON objects as follows:
+    > An object is an unordered collection of zero or more name/value pairs,
+    > where a name is a string and a value is a string, number, boolean, null,
+    > object, or array.
 
-    @since version 1.0.0
-    */
-    enum class value_t : uint8_t
-    {
-        null,            ///< null value
-        object,          ///< object (unordered set of name/value pairs)
-        array,           ///< array (ordered collection of values)
-        string,          ///< string value
-        boolean,         ///< boolean value
-        number_integer,  ///< number value (integer)
-        number_unsigned, ///< number value (unsigned integer)
-        number_float,    ///< number value (floating-point)
-        discarded        ///< discarded by the the parser callback function
-    };
+    To store objects in C++, a type is defined by the template parameters
+    described below.
 
+    @tparam ObjectType  the container to store objects (e.g., `std::map` or
+    `std::unordered_map`)
+    @tparam StringType the type of the keys or names (e.g., `std::string`).
+    The comparison function `std::less<StringType>` is used to order elements
+    inside the container.
+    @tparam AllocatorType the allocator to use for objects (e.g.,
+    `std::allocator`)
 
-  private:
+    #### Default type
 
-    /// helper for exception-safe object creation
-    template<typename T, typename... Args>
-    static T* create(Args&& ... args)
-    {
-        AllocatorType<T> alloc;
-        auto deleter = [&](T * object)
-        {
-            alloc.deallocate(object, 1);
-        };
-        std::unique_ptr<T, decltype(deleter)> object(alloc.allocate(1), deleter);
-        alloc.construct(object.get(), std::forward<Args>(args)...);
-        return object.release();
-    }
+    With the default values for @a ObjectType (`std::map`), @a StringType
+    (`std::string`), and @a AllocatorType (`std::allocator`), the default
+    value for @a object_t is:
 
-    ////////////////////////
-    // JSON value storage //
-    ////////////////////////
+    @code {.cpp}
+    std::map<
+      std::string, // key_type
+      basic_json, // value_type
+      std::less<std::string>, // key_compare
+      std::allocator<std::pair<const std::string, basic_json>> // allocator_type
+    >
+    @endcode
 
-    /*!
-    @brief a JSON value
+    #### Behavior
 
-    The actual storage for a JSON value of the @ref basic_json class.
+    The choice of @a object_t influences the behavior of the JSON class. With
+    the default type, objects have the following behavior:
 
-    @since version 1.0.0
-    */
-    union json_value
-    {
-        /// object (stored with pointer to save storage)
-        object_t* object;
-        /// array (stored with pointer to save storage)
-        array_t* array;
-        /// string (stored with pointer to save storage)
-        string_t* string;
-        /// boolean
-        boolean_t boolean;
-        /// number (integer)
-        number_integer_t number_integer;
-        /// number (unsigned integer)
-        number_unsigned_t number_unsigned;
-        /// number (floating-point)
-        number_float_t number_float;
+    - When all names are unique, objects will be interoperable in the sense
+      that all software implementations receiving that object will agree on
+      the name-value mappings.
+    - When the names within an object are not unique, later stored name/value
+      pairs overwrite previously stored name/value pairs, leaving the used
+      names unique. For instance, `{"key": 1}` and `{"key": 2, "key": 1}` will
+      be treated as equal and both stored as `{"key": 1}`.
+    - Internally, name/value pairs are stored in lexicographical order of the
+      names. Objects will also be serialized (see @ref dump) in this order.
+      For instance, `{"b": 1, "a": 2}` and `{"a": 2, "b": 1}` will be stored
+      and serialized as `{"a": 2, "b": 1}`.
+    - When comparing objects, the order of the name/value pairs is irrelevant.
+      This makes objects interoperable in the sense that they will not be
+      affected by these differences. For instance, `{"b": 1, "a": 2}` and
+      `{"a": 2, "b": 1}` will be treated as equal.
 
-        /// default constructor (for null values)
-        json_value() = default;
-        /// constructor for booleans
-        json_value(boolean_t v) noexcept : boolean(v) {}
-        /// constructor for numbers (integer)
-        json_value(number_integer_t v) noexcept : number_integer(v) {}
-        /// constructor for numbers (unsigned)
-        json_value(number_unsigned_t v) noexcept : number_unsigned(v) {}
-        /// constructor for numbers (floating-point)
-        json_value(number_float_t v) noexcept : number_float(v) {}
-        /// constructor for empty values of a given type
-        json_value(value_t t)
-        {
-            switch (t)
-            {
-                case value_t::object:
-                {
-                    object = create<object_t>();
-                    break;
-                }
+    #### Limits
 
-                case value_t::array:
-                {
-                    array = create<array_t>();
-                    break;
-                }
+    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
+    > An implementation may set limits on the maximum depth of nesting.
 
-                case value_t::string:
-                {
-                    string = create<string_t>("");
-                    break;
-                }
+    In this class, the object's limit of nesting is not constraint explicitly.
+    However, a maximum depth of nesting may be introduced by the compiler or
+    runtime environment. A theoretical limit can be queried by calling the
+    @ref max_size function of a JSON object.
 
-                case value_t::boolean:
-                {
-                    boolean = boolean_t(false);
-                    break;
-                }
+    #### Storage
 
-                case value_t::number_integer:
-                {
-                    number_integer = number_integer_t(0);
-                    break;
-                }
+    Objects are stored as pointers in a @ref basic_json type. That is, for any
+    access to object values, a pointer of type `object_t*` must be
+    dereferenced.
 
-                case value_t::number_unsigned:
-                {
-                    number_unsigned = number_unsigned_t(0);
-                    break;
-                }
+    @sa @ref array_t -- type for an array value
 
-                case value_t::number_float:
-                {
-                    number_float = number_float_t(0.0);
-                    break;
-                }
+    @since version 1.0.0
 
-                default:
-                {
-                    break;
-                }
-            }
-        }
+    @note The order name/value pairs are added to the object is *not*
+    preserved by the library. Therefore, iterating an object may return
+    name/value pairs in a different order than they were originally stored. In
+    fact, keys will be traversed in alphabetical order as `std::map` with
+    `std::less` is used by default. Please note this behavior conforms to [RFC
+    7159](http://rfc7159.net/rfc7159), because any order implements the
+    specified "unordered" nature of JSON objects.
+    */
+    using object_t = ObjectType<StringType,
+          basic_json,
+          std::less<StringType>,
+          AllocatorType<std::pair<const StringType,
+          basic_json>>>;
 
-        /// constructor for strings
-        json_value(const string_t& value)
-        {
-            string = create<string_t>(value);
-        }
+    /*!
+    @brief a type for an array
 
-        /// constructor for objects
-        json_value(const object_t& value)
-        {
-            object = create<object_t>(value);
-        }
+    [RFC 7159](http://rfc7159.net/rfc7159) describes JSON arrays as follows:
+    > An array is an ordered sequence of zero or more values.
 
-        /// constructor for arrays
-        json_value(const array_t& value)
-        {
-            array = create<array_t>(value);
-        }
-    };
+    To store objects in C++, a type is defined by the template parameters
+    explained below.
 
+    @tparam ArrayType  container type to store arrays (e.g., `std::vector` or
+    `std::list`)
+    @tparam AllocatorType  allocator to use for arrays (e.g., `std::allocator`)
 
-  public:
-    //////////////////////////
-    // JSON parser callback //
-    //////////////////////////
+    #### Default type
 
-    /*!
-    @brief JSON callback events
+    With the default values for @a ArrayType (`std::vector`) and @a
+    AllocatorType (`std::allocator`), the default value for @a array_t is:
 
-    This enumeration lists the parser events that can trigger calling a
-    callback function of type @ref parser_callback_t during parsing.
+    @code {.cpp}
+    std::vector<
+      basic_json, // value_type
+      std::allocator<basic_json> // allocator_type
+    >
+    @endcode
+
+    #### Limits
+
+    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
+    > An implementation may set limits on the maximum depth of nesting.
+
+    In this class, the array's limit of nesting is not constraint explicitly.
+    However, a maximum depth of nesting may be introduced by the compiler or
+    runtime environment. A theoretical limit can be queried by calling the
+    @ref max_size function of a JSON array.
+
+    #### Storage
+
+    Arrays are stored as pointers in a @ref basic_json type. That is, for any
+    access to array values, a pointer of type `array_t*` must be dereferenced.
+
+    @sa @ref object_t -- type for an object value
 
     @since version 1.0.0
     */
-    enum class parse_event_t : uint8_t
-    {
-        /// the parser read `{` and started to process a JSON object
-        object_start,
-        /// the parser read `}` and finished processing a JSON object
-        object_end,
-        /// the parser read `[` and started to process a JSON array
-        array_start,
-        /// the parser read `]` and finished processing a JSON array
-        array_end,
-        /// the parser read a key of a value in an object
-        key,
-        /// the parser finished reading a JSON value
-        value
-    };
+    using array_t = ArrayType<basic_json, AllocatorType<basic_json>>;
 
     /*!
-    @brief per-element parser callback type
+    @brief a type for a string
 
-    With a parser callback function, the result of parsing a JSON text can be
-    influenced. When passed to @ref parse(std::istream&, parser_callback_t) or
-    @ref parse(const string_t&, parser_callback_t), it is called on certain
-    events (passed as @ref parse_event_t via parameter @a event) with a set
-    recursion depth @a depth and context JSON value @a parsed. The return
-    value of the callback function is a boolean indicating whether the element
-    that emitted the callback shall be kept or not.
+    [RFC 7159](http://rfc7159.net/rfc7159) describes JSON strings as follows:
+    > A string is a sequence of zero or more Unicode characters.
 
-    We distinguish six scenarios (determined by the event type) in which the
-    callback function can be called. The following table describes the values
-    of the parameters @a depth, @a event, and @a parsed.
+    To store objects in C++, a type is defined by the template parameter
+    described below. Unicode values are split by the JSON class into
+    byte-sized characters during deserialization.
 
-    parameter @a event | description | parameter @a depth | parameter @a parsed
-    ------------------ | ----------- | ------------------ | -------------------
-    parse_event_t::object_start | the parser read `{` and started to process a JSON object | depth of the parent of the JSON object | a JSON value with type discarded
-    parse_event_t::key | the parser read a key of a value in an object | depth of the currently parsed JSON object | a JSON string containing the key
-    parse_event_t::object_end | the parser read `}` and finished processing a JSON object | depth of the parent of the JSON object | the parsed JSON object
-    parse_event_t::array_start | the parser read `[` and started to process a JSON array | depth of the parent of the JSON array | a JSON value with type discarded
-    parse_event_t::array_end | the parser read `]` and finished processing a JSON array | depth of the parent of the JSON array | the parsed JSON array
-    parse_event_t::value | the parser finished reading a JSON value | depth of the value | the parsed JSON value
+    @tparam StringType  the container to store strings (e.g., `std::string`).
+    Note this container is used for keys/names in objects, see @ref object_t.
 
-    Discarding a value (i.e., returning `false`) has different effects
-    depending on the context in which function was called:
+    #### Default type
 
-    - Discarded values in structured types are skipped. That is, the parser
-      will behave as if the discarded value was never read.
-    - In case a value outside a structured type is skipped, it is replaced
-      with `null`. This case happens if the top-level element is skipped.
+    With the default values for @a StringType (`std::string`), the default
+    value for @a string_t is:
 
-    @param[in] depth  the depth of the recursion during parsing
+    @code {.cpp}
+    std::string
+    @endcode
 
-    @param[in] event  an event of type parse_event_t indicating the context in
-    the callback function has been called
+    #### String comparison
 
-    @param[in,out] parsed  the current intermediate parse result; note that
-    writing to this value has no effect for parse_event_t::key events
+    [RFC 7159](http://rfc7159.net/rfc7159) states:
+    > Software implementations are typically required to test names of object
+    > members for equality. Implementations that transform the textual
+    > representation into sequences of Unicode code units and then perform the
+    > comparison numerically, code unit by code unit, are interoperable in the
+    > sense that implementations will agree in all cases on equality or
+    > inequality of two strings. For example, implementations that compare
+    > strings with escaped characters unconverted may incorrectly find that
+    > `"a\\b"` and `"a\u005Cb"` are not equal.
 
-    @return Whether the JSON value which called the function during parsing
-    should be kept (`true`) or not (`false`). In the latter case, it is either
-    skipped completely or replaced by an empty discarded object.
+    This implementation is interoperable as it does compare strings code unit
+    by code unit.
 
-    @sa @ref parse(std::istream&, parser_callback_t) or
-    @ref parse(const string_t&, parser_callback_t) for examples
+    #### Storage
+
+    String values are stored as pointers in a @ref basic_json type. That is,
+    for any access to string values, a pointer of type `string_t*` must be
+    dereferenced.
 
     @since version 1.0.0
     */
-    using parser_callback_t = std::function<bool(int depth, parse_event_t event, basic_json& parsed)>;
+    using string_t = StringType;
 
+    /*!
+    @brief a type for a boolean
 
-    //////////////////
-    // constructors //
-    //////////////////
+    [RFC 7159](http://rfc7159.net/rfc7159) implicitly describes a boolean as a
+    type which differentiates the two literals `true` and `false`.
 
-    /// @name constructors and destructors
-    /// @{
-
-    /*!
-    @brief create an empty value with a given type
-
-    Create an empty JSON value with a given type. The value will be default
-    initialized with an empty value which depends on the type:
-
-    Value type  | initial value
-    ----------- | -------------
-    null        | `null`
-    boolean     | `false`
-    string      | `""`
-    number      | `0`
-    object      | `{}`
-    array       | `[]`
+    To store objects in C++, a type is defined by the template parameter @a
+    BooleanType which chooses the type to use.
 
-    @param[in] value_type  the type of the value to create
+    #### Default type
 
-    @complexity Constant.
+    With the default values for @a BooleanType (`bool`), the default value for
+    @a boolean_t is:
 
-    @throw std::bad_alloc if allocation for object, array, or string value
-    fails
+    @code {.cpp}
+    bool
+    @endcode
 
-    @liveexample{The following code shows the constructor for different @ref
-    value_t values,basic_json__value_t}
+    #### Storage
 
-    @sa @ref basic_json(std::nullptr_t) -- create a `null` value
-    @sa @ref basic_json(boolean_t value) -- create a boolean value
-    @sa @ref basic_json(const string_t&) -- create a string value
-    @sa @ref basic_json(const object_t&) -- create a object value
-    @sa @ref basic_json(const array_t&) -- create a array value
-    @sa @ref basic_json(const number_float_t) -- create a number
-    (floating-point) value
-    @sa @ref basic_json(const number_integer_t) -- create a number (integer)
-    value
-    @sa @ref basic_json(const number_unsigned_t) -- create a number (unsigned)
-    value
+    Boolean values are stored directly inside a @ref basic_json type.
 
     @since version 1.0.0
     */
-    basic_json(const value_t value_type)
-        : m_type(value_type), m_value(value_type)
-    {}
+    using boolean_t = BooleanType;
 
     /*!
-    @brief create a null object (implicitly)
-
-    Create a `null` JSON value. This is the implicit version of the `null`
-    value constructor as it takes no parameters.
-
-    @complexity Constant.
-
-    @exceptionsafety No-throw guarantee: this constructor never throws
-    exceptions.
-
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
-    - As postcondition, it holds: `basic_json().empty() == true`.
+    @brief a type for a number (integer)
 
-    @liveexample{The following code shows the constructor for a `null` JSON
-    value.,basic_json}
+    [RFC 7159](http://rfc7159.net/rfc7159) describes numbers as follows:
+    > The representation of numbers is similar to that used in most
+    > programming languages. A number is represented in base 10 using decimal
+    > digits. It contains an integer component that may be prefixed with an
+    > optional minus sign, which may be followed by a fraction part and/or an
+    > exponent part. Leading zeros are not allowed. (...) Numeric values that
+    > cannot be represented in the grammar below (such as Infinity and NaN)
+    > are not permitted.
 
-    @sa @ref basic_json(std::nullptr_t) -- create a `null` value
+    This description includes both integer and floating-point numbers.
+    However, C++ allows more precise storage if it is known whether the number
+    is a signed integer, an unsigned integer or a floating-point number.
+    Therefore, three different types, @ref number_integer_t, @ref
+    number_unsigned_t and @ref number_float_t are used.
 
-    @since version 1.0.0
-    */
-    basic_json() = default;
+    To store integer numbers in C++, a type is defined by the template
+    parameter @a NumberIntegerType which chooses the type to use.
 
-    /*!
-    @brief create a null object (explicitly)
+    #### Default type
 
-    Create a `null` JSON value. This is the explicitly version of the `null`
-    value constructor as it takes a null pointer as parameter. It allows to
-    create `null` values by explicitly assigning a `nullptr` to a JSON value.
-    The passed null pointer itself is not read -- it is only used to choose
-    the right constructor.
+    With the default values for @a NumberIntegerType (`int64_t`), the default
+    value for @a number_integer_t is:
 
-    @complexity Constant.
+    @code {.cpp}
+    int64_t
+    @endcode
 
-    @exceptionsafety No-throw guarantee: this constructor never throws
-    exceptions.
+    #### Default behavior
 
-    @liveexample{The following code shows the constructor with null pointer
-    parameter.,basic_json__nullptr_t}
+    - The restrictions about leading zeros is not enforced in C++. Instead,
+      leading zeros in integer literals lead to an interpretation as octal
+      number. Internally, the value will be stored as decimal number. For
+      instance, the C++ integer literal `010` will be serialized to `8`.
+      During deserialization, leading zeros yield an error.
+    - Not-a-number (NaN) values will be serialized to `null`.
 
-    @sa @ref basic_json() -- default constructor (implicitly creating a `null`
-    value)
+    #### Limits
 
-    @since version 1.0.0
-    */
-    basic_json(std::nullptr_t) noexcept
-        : basic_json(value_t::null)
-    {}
+    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
+    > An implementation may set limits on the range and precision of numbers.
 
-    /*!
-    @brief create an object (explicit)
+    When the default type is used, the maximal integer number that can be
+    stored is `9223372036854775807` (INT64_MAX) and the minimal integer number
+    that can be stored is `-9223372036854775808` (INT64_MIN). Integer numbers
+    that are out of range will yield over/underflow when used in a
+    constructor. During deserialization, too large or small integer numbers
+    will be automatically be stored as @ref number_unsigned_t or @ref
+    number_float_t.
 
-    Create an object JSON value with a given content.
+    [RFC 7159](http://rfc7159.net/rfc7159) further states:
+    > Note that when such software is used, numbers that are integers and are
+    > in the range \f$[-2^{53}+1, 2^{53}-1]\f$ are interoperable in the sense
+    > that implementations will agree exactly on their numeric values.
 
-    @param[in] val  a value for the object
+    As this range is a subrange of the exactly supported range [INT64_MIN,
+    INT64_MAX], this class's integer type is interoperable.
 
-    @complexity Linear in the size of the passed @a val.
+    #### Storage
 
-    @throw std::bad_alloc if allocation for object value fails
+    Integer number values are stored directly inside a @ref basic_json type.
 
-    @liveexample{The following code shows the constructor with an @ref
-    object_t parameter.,basic_json__object_t}
+    @sa @ref number_float_t -- type for number values (floating-point)
 
-    @sa @ref basic_json(const CompatibleObjectType&) -- create an object value
-    from a compatible STL container
+    @sa @ref number_unsigned_t -- type for number values (unsigned integer)
 
     @since version 1.0.0
     */
-    basic_json(const object_t& val)
-        : m_type(value_t::object), m_value(val)
-    {}
+    using number_integer_t = NumberIntegerType;
 
     /*!
-    @brief create an object (implicit)
+    @brief a type for a number (unsigned)
 
-    Create an object JSON value with a given content. This constructor allows
-    any type @a CompatibleObjectType that can be used to construct values of
-    type @ref object_t.
+    [RFC 7159](http://rfc7159.net/rfc7159) describes numbers as follows:
+    > The representation of numbers is similar to that used in most
+    > programming languages. A number is represented in base 10 using decimal
+    > digits. It contains an integer component that may be prefixed with an
+    > optional minus sign, which may be followed by a fraction part and/or an
+    > exponent part. Leading zeros are not allowed. (...) Numeric values that
+    > cannot be represented in the grammar below (such as Infinity and NaN)
+    > are not permitted.
 
-    @tparam CompatibleObjectType An object type whose `key_type` and
-    `value_type` is compatible to @ref object_t. Examples include `std::map`,
-    `std::unordered_map`, `std::multimap`, and `std::unordered_multimap` with
-    a `key_type` of `std::string`, and a `value_type` from which a @ref
-    basic_json value can be constructed.
+    This description includes both integer and floating-point numbers.
+    However, C++ allows more precise storage if it is known whether the number
+    is a signed integer, an unsigned integer or a floating-point number.
+    Therefore, three different types, @ref number_integer_t, @ref
+    number_unsigned_t and @ref number_float_t are used.
 
-    @param[in] val  a value for the object
+    To store unsigned integer numbers in C++, a type is defined by the
+    template parameter @a NumberUnsignedType which chooses the type to use.
 
-    @complexity Linear in the size of the passed @a val.
+    #### Default type
 
-    @throw std::bad_alloc if allocation for object value fails
+    With the default values for @a NumberUnsignedType (`uint64_t`), the
+    default value for @a number_unsigned_t is:
 
-    @liveexample{The following code shows the constructor with several
-    compatible object type parameters.,basic_json__CompatibleObjectType}
+    @code {.cpp}
+    uint64_t
+    @endcode
 
-    @sa @ref basic_json(const object_t&) -- create an object value
+    #### Default behavior
 
-    @since version 1.0.0
-    */
-    template <class CompatibleObjectType, typename
-              std::enable_if<
-                  std::is_constructible<typename object_t::key_type, typename CompatibleObjectType::key_type>::value and
-                  std::is_constructible<basic_json, typename CompatibleObjectType::mapped_type>::value, int>::type
-              = 0>
-    basic_json(const CompatibleObjectType& val)
-        : m_type(value_t::object)
-    {
-        using std::begin;
-        using std::end;
-        m_value.object = create<object_t>(begin(val), end(val));
-    }
+    - The restrictions about leading zeros is not enforced in C++. Instead,
+      leading zeros in integer literals lead to an interpretation as octal
+      number. Internally, the value will be stored as decimal number. For
+      instance, the C++ integer literal `010` will be serialized to `8`.
+      During deserialization, leading zeros yield an error.
+    - Not-a-number (NaN) values will be serialized to `null`.
 
-    /*!
-    @brief create an array (explicit)
+    #### Limits
 
-    Create an array JSON value with a given content.
+    [RFC 7159](http://rfc7159.net/rfc7159) specifies:
+    > An implementation may set limits on the range and precision of numbers.
 
-    @param[in] val  a value for the array
+    When the default type is used, the maximal integer number that can be
+    stored is `18446744073709551615` (UINT64_MAX) and the minimal integer
+    number that can be stored is `0`. Integer numbers that are out of range
+    will yield over/underflow when used in a constructor. During
+    deserialization, too large or small integer numbers will be automatically
+    be stored as @ref number_integer_t or @ref number_float_t.
 
-    @complexity Linear in the size of the passed @a val.
+    [RFC 7159](http://rfc7159.net/rfc7159) further states:
+    > Note that when such software is used, numbers that are integers and are
+    > in the range \f$[-2^{53}+1, 2^{53}-1]\f$ are interoperable in the sense
+    > that implementations will agree exactly on their numeric values.
 
-    @throw std::bad_alloc if allocation for array value fails
+    As this range is a subrange (when considered in conjunction with the
+    number_integer_t type) of the exactly supported range [0, UINT64_MAX], this
+    class's integer type is interoperable.
 
-    @liveexample{The following code shows the constructor with an @ref array_t
-    parameter.,basic_json__array_t}
+    #### Storage
 
-    @sa @ref basic_json(const CompatibleArrayType&) -- create an array value
-    from a compatible STL containers
+    Integer number values are stored directly inside a @ref basic_json type.
 
-    @since version 1.0.0
+    @sa @ref number_float_t -- type for number values (floating-point)
+
+    @sa @ref number_integer_t -- type for number values (integer)
+
+    @since version 2.0.0
     */
-    basic_json(const array_t& val)
-        : m_type(value_t::array), m_value(val)
-    {}
+    using number_unsigned_t = NumberUnsignedType;
 
     /*!
-    @brief create an array (implicit)
-
-    Create an array JSON value with a given content. This constructor allows
-    any type @a CompatibleArrayType that can be used to construct values of
-    type @ref array_t.
+    @brief a type for a number (floating-point)
 
-    @tparam CompatibleArrayType An object type whose `value_type` is
-    compatible to @ref array_t. Examples include `std::vector`, `std::deque`,
-    `std::list`, `std::forward_list`, `std::array`, `std::set`,
-    `std::unordered_set`, `std::multiset`, and `unordered_multiset` with a
-    `value_type` from which a @ref basic_json value can be constructed.
+    [RFC 7159](http://rfc7159.net/rfc7159) describes numbers as follows:
+    > The representation of numbers is similar to that used in most
+    > programming languages. A number is represented in base 10 using decimal
+    > digits. It contains an integer component that may be prefixed with an
+    > optional minus sign, which may be followed by a fraction part and/or an
+    > exponent part. Leading zeros are not allowed. (...) Numeric values that
+    > cannot be represented in the grammar below (such as Infinity and NaN)
+    > are not permitted.
 
-    @param[in] val  a value for the array
+    This description includes both integer and floating-point numbers.
+    However, C++ allows more precise storage if it is known whether the number
+    is a signed integer, an unsigned integer or a floating-point number.
+    Therefore, three different types, @ref number_integer_t, @ref
+    number_unsigned_t and @ref number_float_t are used.
 
-    @complexity Linear in the size of the passed @a val.
+    To store floating-point numbers in C++, a type is defined by the template
+    parameter @a NumberFloatType which chooses the type to use.
 
-    @throw std::bad_alloc if allocation for array value fails
+    #### Default type
 
-    @liveexample{The following code shows the constructor with several
-    compatible array type parameters.,basic_json__CompatibleArrayType}
+    With the default values for @a NumberFloatType (`double`), the default
+    value for @a number_float_t is:
 
-    @sa @ref basic_json(const array_t&) -- create an array value
+    @code {.cpp}
+    double
+    @endcode
 
-    @since version 1.0.0
-    */
-    template <class CompatibleArrayType, typename
-              std::enable_if<
-                  not std::is_same<CompatibleArrayType, typename basic_json_t::iterator>::value and
-                  not std::is_same<CompatibleArrayType, typename basic_json_t::const_iterator>::value and
-                  not std::is_same<CompatibleArrayType, typename basic_json_t::reverse_iterator>::value and
-                  not std::is_same<CompatibleArrayType, typename basic_json_t::const_reverse_iterator>::value and
-                  not std::is_same<CompatibleArrayType, typename array_t::iterator>::value and
-                  not std::is_same<CompatibleArrayType, typename array_t::const_iterator>::value and
-                  std::is_constructible<basic_json, typename CompatibleArrayType::value_type>::value, int>::type
-              = 0>
-    basic_json(const CompatibleArrayType& val)
-        : m_type(value_t::array)
-    {
-        using std::begin;
-        using std::end;
-        m_value.array = create<array_t>(begin(val), end(val));
-    }
+    #### Default behavior
 
-    /*!
-    @brief create a string (explicit)
+    - The restrictions about leading zeros is not enforced in C++. Instead,
+      leading zeros in floating-point literals will be ignored. Internally,
+      the value will be stored as decimal number. For instance, the C++
+      floating-point literal `01.2` will be serialized to `1.2`. During
+      deserialization, leading zeros yield an error.
+    - Not-a-number (NaN) values will be serialized to `null`.
 
-    Create an string JSON value with a given content.
+    #### Limits
 
-    @param[in] val  a value for the string
+    [RFC 7159](http://rfc7159.net/rfc7159) states:
+    > This specification allows implementations to set limits on the range and
+    > precision of numbers accepted. Since software that implements IEEE
+    > 754-2008 binary64 (double precision) numbers is generally available and
+    > widely used, good interoperability can be achieved by implementations
+    > that expect no more precision or range than these provide, in the sense
+    > that implementations will approximate JSON numbers within the expected
+    > precision.
 
-    @complexity Linear in the size of the passed @a val.
+    This implementation does exactly follow this approach, as it uses double
+    precision floating-point numbers. Note values smaller than
+    `-1.79769313486232e+308` and values greater than `1.79769313486232e+308`
+    will be stored as NaN internally and be serialized to `null`.
 
-    @throw std::bad_alloc if allocation for string value fails
+    #### Storage
 
-    @liveexample{The following code shows the constructor with an @ref
-    string_t parameter.,basic_json__string_t}
+    Floating-point number values are stored directly inside a @ref basic_json
+    type.
 
-    @sa @ref basic_json(const typename string_t::value_type*) -- create a
-    string value from a character pointer
-    @sa @ref basic_json(const CompatibleStringType&) -- create a string value
-    from a compatible string container
+    @sa @ref number_integer_t -- type for number values (integer)
+
+    @sa @ref number_unsigned_t -- type for number values (unsigned integer)
 
     @since version 1.0.0
     */
-    basic_json(const string_t& val)
-        : m_type(value_t::string), m_value(val)
-    {}
-
-    /*!
-    @brief create a string (explicit)
-
-    Create a string JSON value with a given content.
+    using number_float_t = NumberFloatType;
 
-    @param[in] val  a literal value for the string
+    /// @}
 
-    @complexity Linear in the size of the passed @a val.
 
-    @throw std::bad_alloc if allocation for string value fails
+    ///////////////////////////
+    // JSON type enumeration //
+    ///////////////////////////
 
-    @liveexample{The following code shows the constructor with string literal
-    parameter.,basic_json__string_t_value_type}
+    /*!
+    @brief the JSON type enumeration
 
-    @sa @ref basic_json(const string_t&) -- create a string value
-    @sa @ref basic_json(const CompatibleStringType&) -- create a string value
-    from a compatible string container
+    This enumeration collects the different JSON types. It is internally used
+    to distinguish the stored values, and the functions @ref is_null(), @ref
+    is_object(), @ref is_array(), @ref is_string(), @ref is_boolean(), @ref
+    is_number(), and @ref is_discarded() rely on it.
 
     @since version 1.0.0
     */
-    basic_json(const typename string_t::value_type* val)
-        : basic_json(string_t(val))
-    {}
-
-    /*!
-    @brief create a string (implicit)
-
-    Create a string JSON value with a given content.
+    enum class value_t : uint8_t
+    {
+        null,            ///< null value
+        object,          ///< object (unordered set of name/value pairs)
+        array,           ///< array (ordered collection of values)
+        string,          ///< string value
+        boolean,         ///< boolean value
+        number_integer,  ///< number value (integer)
+        number_unsigned, ///< number value (unsigned integer)
+        number_float,    ///< number value (floating-point)
+        discarded        ///< discarded by the the parser callback function
+    };
 
-    @param[in] val  a value for the string
 
-    @tparam CompatibleStringType an string type which is compatible to @ref
-    string_t, for instance `std::string`.
+  private:
 
-    @complexity Linear in the size of the passed @a val.
+    /// helper for exception-safe object creation
+    template<typename T, typename... Args>
+    static T* create(Args&& ... args)
+    {
+        AllocatorType<T> alloc;
+        auto deleter = [&](T * object)
+        {
+            alloc.deallocate(object, 1);
+        };
+        std::unique_ptr<T, decltype(deleter)> object(alloc.allocate(1), deleter);
+        alloc.construct(object.get(), std::forward<Args>(args)...);
+        return object.release();
+    }
 
-    @throw std::bad_alloc if allocation for string value fails
+    ////////////////////////
+    // JSON value storage //
+    ////////////////////////
 
-    @liveexample{The following code shows the construction of a string value
-    from a compatible type.,basic_json__CompatibleStringType}
+    /*!
+    @brief a JSON value
 
-    @sa @ref basic_json(const string_t&) -- create a string value
-    @sa @ref basic_json(const typename string_t::value_type*) -- create a
-    string value from a character pointer
+    The actual storage for a JSON value of the @ref basic_json class.
 
     @since version 1.0.0
     */
-    template <class CompatibleStringType, typename
-              std::enable_if<
-                  std::is_constructible<string_t, CompatibleStringType>::value, int>::type
-              = 0>
-    basic_json(const CompatibleStringType& val)
-        : basic_json(string_t(val))
-    {}
-
-    /*!
-    @brief create a boolean (explicit)
+    union json_value
+    {
+        /// object (stored with pointer to save storage)
+        object_t* object;
+        /// array (stored with pointer to save storage)
+        array_t* array;
+        /// string (stored with pointer to save storage)
+        string_t* string;
+        /// boolean
+        boolean_t boolean;
+        /// number (integer)
+        number_integer_t number_integer;
+        /// number (unsigned integer)
+        number_unsigned_t number_unsigned;
+        /// number (floating-point)
+        number_float_t number_float;
 
-    Creates a JSON boolean type from a given value.
+        /// default constructor (for null values)
+        json_value() = default;
+        /// constructor for booleans
+        json_value(boolean_t v) noexcept : boolean(v) {}
+        /// constructor for numbers (integer)
+        json_value(number_integer_t v) noexcept : number_integer(v) {}
+        /// constructor for numbers (unsigned)
+        json_value(number_unsigned_t v) noexcept : number_unsigned(v) {}
+        /// constructor for numbers (floating-point)
+        json_value(number_float_t v) noexcept : number_float(v) {}
+        /// constructor for empty values of a given type
+        json_value(value_t t)
+        {
+            switch (t)
+            {
+                case value_t::object:
+                {
+                    object = create<object_t>();
+                    break;
+                }
 
-    @param[in] val  a boolean value to store
+                case value_t::array:
+                {
+                    array = create<array_t>();
+                    break;
+                }
 
-    @complexity Constant.
+                case value_t::string:
+                {
+                    string = create<string_t>("");
+                    break;
+                }
 
-    @liveexample{The example below demonstrates boolean
-    values.,basic_json__boolean_t}
+                case value_t::boolean:
+                {
+                    boolean = boolean_t(false);
+                    break;
+                }
 
-    @since version 1.0.0
-    */
-    basic_json(boolean_t val) noexcept
-        : m_type(value_t::boolean), m_value(val)
-    {}
+                case value_t::number_integer:
+                {
+                    number_integer = number_integer_t(0);
+                    break;
+                }
 
-    /*!
-    @brief create an integer number (explicit)
+                case value_t::number_unsigned:
+                {
+                    number_unsigned = number_unsigned_t(0);
+                    break;
+                }
 
-    Create an integer number JSON value with a given content.
+                case value_t::number_float:
+                {
+                    number_float = number_float_t(0.0);
+                    break;
+                }
 
-    @tparam T A helper type to remove this function via SFINAE in case @ref
-    number_integer_t is the same as `int`. In this case, this constructor
-    would have the same signature as @ref basic_json(const int value). Note
-    the helper type @a T is not visible in this constructor's interface.
+                default:
+                {
+                    break;
+                }
+            }
+        }
 
-    @param[in] val  an integer to create a JSON number from
+        /// constructor for strings
+        json_value(const string_t& value)
+        {
+            string = create<string_t>(value);
+        }
 
-    @complexity Constant.
+        /// constructor for objects
+        json_value(const object_t& value)
+        {
+            object = create<object_t>(value);
+        }
 
-    @liveexample{The example below shows the construction of an integer
-    number value.,basic_json__number_integer_t}
+        /// constructor for arrays
+        json_value(const array_t& value)
+        {
+            array = create<array_t>(value);
+        }
+    };
 
-    @sa @ref basic_json(const int) -- create a number value (integer)
-    @sa @ref basic_json(const CompatibleNumberIntegerType) -- create a number
-    value (integer) from a compatible number type
+
+  public:
+    //////////////////////////
+    // JSON parser callback //
+    //////////////////////////
+
+    /*!
+    @brief JSON callback events
+
+    This enumeration lists the parser events that can trigger calling a
+    callback function of type @ref parser_callback_t during parsing.
 
     @since version 1.0.0
     */
-    template<typename T,
-             typename std::enable_if<
-                 not (std::is_same<T, int>::value)
-                 and std::is_same<T, number_integer_t>::value
-                 , int>::type
-             = 0>
-    basic_json(const number_integer_t val) noexcept
-        : m_type(value_t::number_integer), m_value(val)
-    {}
+    enum class parse_event_t : uint8_t
+    {
+        /// the parser read `{` and started to process a JSON object
+        object_start,
+        /// the parser read `}` and finished processing a JSON object
+        object_end,
+        /// the parser read `[` and started to process a JSON array
+        array_start,
+        /// the parser read `]` and finished processing a JSON array
+        array_end,
+        /// the parser read a key of a value in an object
+        key,
+        /// the parser finished reading a JSON value
+        value
+    };
 
     /*!
-    @brief create an integer number from an enum type (explicit)
+    @brief per-element parser callback type
 
-    Create an integer number JSON value with a given content.
+    With a parser callback function, the result of parsing a JSON text can be
+    influenced. When passed to @ref parse(std::istream&, parser_callback_t) or
+    @ref parse(const string_t&, parser_callback_t), it is called on certain
+    events (passed as @ref parse_event_t via parameter @a event) with a set
+    recursion depth @a depth and context JSON value @a parsed. The return
+    value of the callback function is a boolean indicating whether the element
+    that emitted the callback shall be kept or not.
 
-    @param[in] val  an integer to create a JSON number from
+    We distinguish six scenarios (determined by the event type) in which the
+    callback function can be called. The following table describes the values
+    of the parameters @a depth, @a event, and @a parsed.
 
-    @note This constructor allows to pass enums directly to a constructor. As
-    C++ has no way of specifying the type of an anonymous enum explicitly, we
-    can only rely on the fact that such values implicitly convert to int. As
-    int may already be the same type of number_integer_t, we may need to
-    switch off the constructor @ref basic_json(const number_integer_t).
+    parameter @a event | description | parameter @a depth | parameter @a parsed
+    ------------------ | ----------- | ------------------ | -------------------
+    parse_event_t::object_start | the parser read `{` and started to process a JSON object | depth of the parent of the JSON object | a JSON value with type discarded
+    parse_event_t::key | the parser read a key of a value in an object | depth of the currently parsed JSON object | a JSON string containing the key
+    parse_event_t::object_end | the parser read `}` and finished processing a JSON object | depth of the parent of the JSON object | the parsed JSON object
+    parse_event_t::array_start | the parser read `[` and started to process a JSON array | depth of the parent of the JSON array | a JSON value with type discarded
+    parse_event_t::array_end | the parser read `]` and finished processing a JSON array | depth of the parent of the JSON array | the parsed JSON array
+    parse_event_t::value | the parser finished reading a JSON value | depth of the value | the parsed JSON value
 
-    @complexity Constant.
+    Discarding a value (i.e., returning `false`) has different effects
+    depending on the context in which function was called:
 
-    @liveexample{The example below shows the construction of an integer
-    number value from an anonymous enum.,basic_json__const_int}
+    - Discarded values in structured types are skipped. That is, the parser
+      will behave as if the discarded value was never read.
+    - In case a value outside a structured type is skipped, it is replaced
+      with `null`. This case happens if the top-level element is skipped.
 
-    @sa @ref basic_json(const number_integer_t) -- create a number value
-    (integer)
-    @sa @ref basic_json(const CompatibleNumberIntegerType) -- create a number
-    value (integer) from a compatible number type
+    @param[in] depth  the depth of the recursion during parsing
+
+    @param[in] event  an event of type parse_event_t indicating the context in
+    the callback function has been called
+
+    @param[in,out] parsed  the current intermediate parse result; note that
+    writing to this value has no effect for parse_event_t::key events
+
+    @return Whether the JSON value which called the function during parsing
+    should be kept (`true`) or not (`false`). In the latter case, it is either
+    skipped completely or replaced by an empty discarded object.
+
+    @sa @ref parse(std::istream&, parser_callback_t) or
+    @ref parse(const string_t&, parser_callback_t) for examples
 
     @since version 1.0.0
     */
-    basic_json(const int val) noexcept
-        : m_type(value_t::number_integer),
-          m_value(static_cast<number_integer_t>(val))
-    {}
+    using parser_callback_t = std::function<bool(int depth, parse_event_t event, basic_json& parsed)>;
+
+
+    //////////////////
+    // constructors //
+    //////////////////
+
+    /// @name constructors and destructors
+    /// @{
 
     /*!
-    @brief create an integer number (implicit)
+    @brief create an empty value with a given type
 
-    Create an integer number JSON value with a given content. This constructor
-    allows any type @a CompatibleNumberIntegerType that can be used to
-    construct values of type @ref number_integer_t.
+    Create an empty JSON value with a given type. The value will be default
+    initialized with an empty value which depends on the type:
 
-    @tparam CompatibleNumberIntegerType An integer type which is compatible to
-    @ref number_integer_t. Examples include the types `int`, `int32_t`,
-    `long`, and `short`.
+    Value type  | initial value
+    ----------- | -------------
+    null        | `null`
+    boolean     | `false`
+    string      | `""`
+    number      | `0`
+    object      | `{}`
+    array       | `[]`
 
-    @param[in] val  an integer to create a JSON number from
+    @param[in] value_type  the type of the value to create
 
     @complexity Constant.
 
-    @liveexample{The example below shows the construction of several integer
-    number values from compatible
-    types.,basic_json__CompatibleIntegerNumberType}
+    @throw std::bad_alloc if allocation for object, array, or string value
+    fails
 
-    @sa @ref basic_json(const number_integer_t) -- create a number value
-    (integer)
-    @sa @ref basic_json(const int) -- create a number value (integer)
+    @liveexample{The following code shows the constructor for different @ref
+    value_t values,basic_json__value_t}
+
+    @sa @ref basic_json(std::nullptr_t) -- create a `null` value
+    @sa @ref basic_json(boolean_t value) -- create a boolean value
+    @sa @ref basic_json(const string_t&) -- create a string value
+    @sa @ref basic_json(const object_t&) -- create a object value
+    @sa @ref basic_json(const array_t&) -- create a array value
+    @sa @ref basic_json(const number_float_t) -- create a number
+    (floating-point) value
+    @sa @ref basic_json(const number_integer_t) -- create a number (integer)
+    value
+    @sa @ref basic_json(const number_unsigned_t) -- create a number (unsigned)
+    value
 
     @since version 1.0.0
     */
-    template<typename CompatibleNumberIntegerType, typename
-             std::enable_if<
-                 std::is_constructible<number_integer_t, CompatibleNumberIntegerType>::value and
-                 std::numeric_limits<CompatibleNumberIntegerType>::is_integer and
-                 std::numeric_limits<CompatibleNumberIntegerType>::is_signed,
-                 CompatibleNumberIntegerType>::type
-             = 0>
-    basic_json(const CompatibleNumberIntegerType val) noexcept
-        : m_type(value_t::number_integer),
-          m_value(static_cast<number_integer_t>(val))
+    basic_json(const value_t value_type)
+        : m_type(value_type), m_value(value_type)
     {}
 
     /*!
-    @brief create an unsigned integer number (explicit)
+    @brief create a null object (implicitly)
 
-    Create an unsigned integer number JSON value with a given content.
+    Create a `null` JSON value. This is the implicit version of the `null`
+    value constructor as it takes no parameters.
 
-    @tparam T  helper type to compare number_unsigned_t and unsigned int
-    (not visible in) the interface.
+    @complexity Constant.
 
-    @param[in] val  an integer to create a JSON number from
+    @exceptionsafety No-throw guarantee: this constructor never throws
+    exceptions.
 
-    @complexity Constant.
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
+    - As postcondition, it holds: `basic_json().empty() == true`.
 
-    @sa @ref basic_json(const CompatibleNumberUnsignedType) -- create a number
-    value (unsigned integer) from a compatible number type
+    @liveexample{The following code shows the constructor for a `null` JSON
+    value.,basic_json}
 
-    @since version 2.0.0
+    @sa @ref basic_json(std::nullptr_t) -- create a `null` value
+
+    @since version 1.0.0
     */
-    template<typename T,
-             typename std::enable_if<
-                 not (std::is_same<T, int>::value)
-                 and std::is_same<T, number_unsigned_t>::value
-                 , int>::type
-             = 0>
-    basic_json(const number_unsigned_t val) noexcept
-        : m_type(value_t::number_unsigned), m_value(val)
-    {}
+    basic_json() = default;
 
     /*!
-    @brief create an unsigned number (implicit)
+    @brief create a null object (explicitly)
 
-    Create an unsigned number JSON value with a given content. This
-    constructor allows any type @a CompatibleNumberUnsignedType that can be
-    used to construct values of type @ref number_unsigned_t.
+    Create a `null` JSON value. This is the explicitly version of the `null`
+    value constructor as it takes a null pointer as parameter. It allows to
+    create `null` values by explicitly assigning a `nullptr` to a JSON value.
+    The passed null pointer itself is not read -- it is only used to choose
+    the right constructor.
 
-    @tparam CompatibleNumberUnsignedType An integer type which is compatible
-    to @ref number_unsigned_t. Examples may include the types `unsigned int`,
-    `uint32_t`, or `unsigned short`.
+    @complexity Constant.
 
-    @param[in] val  an unsigned integer to create a JSON number from
+    @exceptionsafety No-throw guarantee: this constructor never throws
+    exceptions.
 
-    @complexity Constant.
+    @liveexample{The following code shows the constructor with null pointer
+    parameter.,basic_json__nullptr_t}
 
-    @sa @ref basic_json(const number_unsigned_t) -- create a number value
-    (unsigned)
+    @sa @ref basic_json() -- default constructor (implicitly creating a `null`
+    value)
 
-    @since version 2.0.0
+    @since version 1.0.0
     */
-    template <typename CompatibleNumberUnsignedType, typename
-              std::enable_if <
-                  std::is_constructible<number_unsigned_t, CompatibleNumberUnsignedType>::value and
-                  std::numeric_limits<CompatibleNumberUnsignedType>::is_integer and
-                  not std::numeric_limits<CompatibleNumberUnsignedType>::is_signed,
-                  CompatibleNumberUnsignedType>::type
-              = 0>
-    basic_json(const CompatibleNumberUnsignedType val) noexcept
-        : m_type(value_t::number_unsigned),
-          m_value(static_cast<number_unsigned_t>(val))
+    basic_json(std::nullptr_t) noexcept
+        : basic_json(value_t::null)
     {}
 
     /*!
-    @brief create a floating-point number (explicit)
+    @brief create an object (explicit)
 
-    Create a floating-point number JSON value with a given content.
+    Create an object JSON value with a given content.
 
-    @param[in] val  a floating-point value to create a JSON number from
+    @param[in] val  a value for the object
 
-    @note [RFC 7159](http://www.rfc-editor.org/rfc/rfc7159.txt), section 6
-    disallows NaN values:
-    > Numeric values that cannot be represented in the grammar below (such as
-    > Infinity and NaN) are not permitted.
-    In case the parameter @a val is not a number, a JSON null value is
-    created instead.
+    @complexity Linear in the size of the passed @a val.
 
-    @complexity Constant.
+    @throw std::bad_alloc if allocation for object value fails
 
-    @liveexample{The following example creates several floating-point
-    values.,basic_json__number_float_t}
+    @liveexample{The following code shows the constructor with an @ref
+    object_t parameter.,basic_json__object_t}
 
-    @sa @ref basic_json(const CompatibleNumberFloatType) -- create a number
-    value (floating-point) from a compatible number type
+    @sa @ref basic_json(const CompatibleObjectType&) -- create an object value
+    from a compatible STL container
 
     @since version 1.0.0
     */
-    basic_json(const number_float_t val) noexcept
-        : m_type(value_t::number_float), m_value(val)
-    {
-        // replace infinity and NAN by null
-        if (not std::isfinite(val))
-        {
-            m_type = value_t::null;
-            m_value = json_value();
-        }
-    }
+    basic_json(const object_t& val)
+        : m_type(value_t::object), m_value(val)
+    {}
 
     /*!
-    @brief create an floating-point number (implicit)
+    @brief create an object (implicit)
 
-    Create an floating-point number JSON value with a given content. This
-    constructor allows any type @a CompatibleNumberFloatType that can be used
-    to construct values of type @ref number_float_t.
+    Create an object JSON value with a given content. This constructor allows
+    any type @a CompatibleObjectType that can be used to construct values of
+    type @ref object_t.
 
-    @tparam CompatibleNumberFloatType A floating-point type which is
-    compatible to @ref number_float_t. Examples may include the types `float`
-    or `double`.
+    @tparam CompatibleObjectType An object type whose `key_type` and
+    `value_type` is compatible to @ref object_t. Examples include `std::map`,
+    `std::unordered_map`, `std::multimap`, and `std::unordered_multimap` with
+    a `key_type` of `std::string`, and a `value_type` from which a @ref
+    basic_json value can be constructed.
 
-    @param[in] val  a floating-point to create a JSON number from
+    @param[in] val  a value for the object
 
-    @note [RFC 7159](http://www.rfc-editor.org/rfc/rfc7159.txt), section 6
-    disallows NaN values:
-    > Numeric values that cannot be represented in the grammar below (such as
-    > Infinity and NaN) are not permitted.
-    In case the parameter @a val is not a number, a JSON null value is
-    created instead.
+    @complexity Linear in the size of the passed @a val.
 
-    @complexity Constant.
+    @throw std::bad_alloc if allocation for object value fails
 
-    @liveexample{The example below shows the construction of several
-    floating-point number values from compatible
-    types.,basic_json__CompatibleNumberFloatType}
+    @liveexample{The following code shows the constructor with several
+    compatible object type parameters.,basic_json__CompatibleObjectType}
 
-    @sa @ref basic_json(const number_float_t) -- create a number value
-    (floating-point)
+    @sa @ref basic_json(const object_t&) -- create an object value
 
     @since version 1.0.0
     */
-    template<typename CompatibleNumberFloatType, typename = typename
-             std::enable_if<
-                 std::is_constructible<number_float_t, CompatibleNumberFloatType>::value and
-                 std::is_floating_point<CompatibleNumberFloatType>::value>::type
-             >
-    basic_json(const CompatibleNumberFloatType val) noexcept
-        : basic_json(number_float_t(val))
-    {}
+    template <class CompatibleObjectType, typename
+              std::enable_if<
+                  std::is_constructible<typename object_t::key_type, typename CompatibleObjectType::key_type>::value and
+                  std::is_constructible<basic_json, typename CompatibleObjectType::mapped_type>::value, int>::type
+              = 0>
+    basic_json(const CompatibleObjectType& val)
+        : m_type(value_t::object)
+    {
+        using std::begin;
+        using std::end;
+        m_value.object = create<object_t>(begin(val), end(val));
+    }
 
     /*!
-    @brief create a container (array or object) from an initializer list
+    @brief create an array (explicit)
 
-    Creates a JSON value of type array or object from the passed initializer
-    list @a init. In case @a type_deduction is `true` (default), the type of
-    the JSON value to be created is deducted from the initializer list @a init
-    according to the following rules:
+    Create an array JSON value with a given content.
 
-    1. If the list is empty, an empty JSON object value `{}` is created.
-    2. If the list consists of pairs whose first element is a string, a JSON
-    object value is created where the first elements of the pairs are treated
-    as keys and the second elements are as values.
-    3. In all other cases, an array is created.
+    @param[in] val  a value for the array
 
-    The rules aim to create the best fit between a C++ initializer list and
-    JSON values. The rationale is as follows:
+    @complexity Linear in the size of the passed @a val.
 
-    1. The empty initializer list is written as `{}` which is exactly an empty
-    JSON object.
-    2. C++ has now way of describing mapped types other than to list a list of
-    pairs. As JSON requires that keys must be of type string, rule 2 is the
-    weakest constraint one can pose on initializer lists to interpret them as
-    an object.
-    3. In all other cases, the initializer list could not be interpreted as
-    JSON object type, so interpreting it as JSON array type is safe.
+    @throw std::bad_alloc if allocation for array value fails
 
-    With the rules described above, the following JSON values cannot be
-    expressed by an initializer list:
+    @liveexample{The following code shows the constructor with an @ref array_t
+    parameter.,basic_json__array_t}
 
-    - the empty array (`[]`): use @ref array(std::initializer_list<basic_json>)
-      with an empty initializer list in this case
-    - arrays whose elements satisfy rule 2: use @ref
-      array(std::initializer_list<basic_json>) with the same initializer list
-      in this case
+    @sa @ref basic_json(const CompatibleArrayType&) -- create an array value
+    from a compatible STL containers
 
-    @note When used without parentheses around an empty initializer list, @ref
-    basic_json() is called instead of this function, yielding the JSON null
-    value.
+    @since version 1.0.0
+    */
+    basic_json(const array_t& val)
+        : m_type(value_t::array), m_value(val)
+    {}
 
-    @param[in] init  initializer list with JSON values
+    /*!
+    @brief create an array (implicit)
 
-    @param[in] type_deduction internal parameter; when set to `true`, the type
-    of the JSON value is deducted from the initializer list @a init; when set
-    to `false`, the type provided via @a manual_type is forced. This mode is
-    used by the functions @ref array(std::initializer_list<basic_json>) and
-    @ref object(std::initializer_list<basic_json>).
+    Create an array JSON value with a given content. This constructor allows
+    any type @a CompatibleArrayType that can be used to construct values of
+    type @ref array_t.
 
-    @param[in] manual_type internal parameter; when @a type_deduction is set
-    to `false`, the created JSON value will use the provided type (only @ref
-    value_t::array and @ref value_t::object are valid); when @a type_deduction
-    is set to `true`, this parameter has no effect
+    @tparam CompatibleArrayType An object type whose `value_type` is
+    compatible to @ref array_t. Examples include `std::vector`, `std::deque`,
+    `std::list`, `std::forward_list`, `std::array`, `std::set`,
+    `std::unordered_set`, `std::multiset`, and `unordered_multiset` with a
+    `value_type` from which a @ref basic_json value can be constructed.
 
-    @throw std::domain_error if @a type_deduction is `false`, @a manual_type
-    is `value_t::object`, but @a init contains an element which is not a pair
-    whose first element is a string; example: `"cannot create object from
-    initializer list"`
+    @param[in] val  a value for the array
 
-    @complexity Linear in the size of the initializer list @a init.
+    @complexity Linear in the size of the passed @a val.
 
-    @liveexample{The example below shows how JSON values are created from
-    initializer lists.,basic_json__list_init_t}
+    @throw std::bad_alloc if allocation for array value fails
 
-    @sa @ref array(std::initializer_list<basic_json>) -- create a JSON array
-    value from an initializer list
-    @sa @ref object(std::initializer_list<basic_json>) -- create a JSON object
-    value from an initializer list
+    @liveexample{The following code shows the constructor with several
+    compatible array type parameters.,basic_json__CompatibleArrayType}
+
+    @sa @ref basic_json(const array_t&) -- create an array value
 
     @since version 1.0.0
     */
-    basic_json(std::initializer_list<basic_json> init,
-               bool type_deduction = true,
-               value_t manual_type = value_t::array)
+    template <class CompatibleArrayType, typename
+              std::enable_if<
+                  not std::is_same<CompatibleArrayType, typename basic_json_t::iterator>::value and
+                  not std::is_same<CompatibleArrayType, typename basic_json_t::const_iterator>::value and
+                  not std::is_same<CompatibleArrayType, typename basic_json_t::reverse_iterator>::value and
+                  not std::is_same<CompatibleArrayType, typename basic_json_t::const_reverse_iterator>::value and
+                  not std::is_same<CompatibleArrayType, typename array_t::iterator>::value and
+                  not std::is_same<CompatibleArrayType, typename array_t::const_iterator>::value and
+                  std::is_constructible<basic_json, typename CompatibleArrayType::value_type>::value, int>::type
+              = 0>
+    basic_json(const CompatibleArrayType& val)
+        : m_type(value_t::array)
     {
-        // the initializer list could describe an object
-        bool is_an_object = true;
+        using std::begin;
+        using std::end;
+        m_value.array = create<array_t>(begin(val), end(val));
+    }
 
-        // check if each element is an array with two elements whose first
-        // element is a string
-        for (const auto& element : init)
-        {
-            if (not element.is_array() or element.size() != 2
-                    or not element[0].is_string())
-            {
-                // we found an element that makes it impossible to use the
-                // initializer list as object
-                is_an_object = false;
-                break;
-            }
-        }
+    /*!
+    @brief create a string (explicit)
 
-        // adjust type if type deduction is not wanted
-        if (not type_deduction)
-        {
-            // if array is wanted, do not create an object though possible
-            if (manual_type == value_t::array)
-            {
-                is_an_object = false;
-            }
+    Create an string JSON value with a given content.
 
-            // if object is wanted but impossible, throw an exception
-            if (manual_type == value_t::object and not is_an_object)
-            {
-                throw std::domain_error("cannot create object from initializer list");
-            }
-        }
+    @param[in] val  a value for the string
 
-        if (is_an_object)
-        {
-            // the initializer list is a list of pairs -> create object
-            m_type = value_t::object;
-            m_value = value_t::object;
+    @complexity Linear in the size of the passed @a val.
 
-            assert(m_value.object != nullptr);
+    @throw std::bad_alloc if allocation for string value fails
 
-            for (auto& element : init)
-            {
-                m_value.object->emplace(*(element[0].m_value.string), element[1]);
-            }
-        }
-        else
-        {
-            // the initializer list describes an array -> create array
-            m_type = value_t::array;
-            m_value.array = create<array_t>(init);
-        }
-    }
+    @liveexample{The following code shows the constructor with an @ref
+    string_t parameter.,basic_json__string_t}
 
-    /*!
-    @brief explicitly create an array from an initializer list
+    @sa @ref basic_json(const typename string_t::value_type*) -- create a
+    string value from a character pointer
+    @sa @ref basic_json(const CompatibleStringType&) -- create a string value
+    from a compatible string container
 
-    Creates a JSON array value from a given initializer list. That is, given a
-    list of values `a, b, c`, creates the JSON value `[a, b, c]`. If the
-    initializer list is empty, the empty array `[]` is created.
+    @since version 1.0.0
+    */
+    basic_json(const string_t& val)
+        : m_type(value_t::string), m_value(val)
+    {}
 
-    @note This function is only needed to express two edge cases that cannot
-    be realized with the initializer list constructor (@ref
-    basic_json(std::initializer_list<basic_json>, bool, value_t)). These cases
-    are:
-    1. creating an array whose elements are all pairs whose first element is a
-    string -- in this case, the initializer list constructor would create an
-    object, taking the first elements as keys
-    2. creating an empty array -- passing the empty initializer list to the
-    initializer list constructor yields an empty object
+    /*!
+    @brief create a string (explicit)
 
-    @param[in] init  initializer list with JSON values to create an array from
-    (optional)
+    Create a string JSON value with a given content.
 
-    @return JSON array value
+    @param[in] val  a literal value for the string
 
-    @complexity Linear in the size of @a init.
+    @complexity Linear in the size of the passed @a val.
 
-    @liveexample{The following code shows an example for the `array`
-    function.,array}
+    @throw std::bad_alloc if allocation for string value fails
 
-    @sa @ref basic_json(std::initializer_list<basic_json>, bool, value_t) --
-    create a JSON value from an initializer list
-    @sa @ref object(std::initializer_list<basic_json>) -- create a JSON object
-    value from an initializer list
+    @liveexample{The following code shows the constructor with string literal
+    parameter.,basic_json__string_t_value_type}
+
+    @sa @ref basic_json(const string_t&) -- create a string value
+    @sa @ref basic_json(const CompatibleStringType&) -- create a string value
+    from a compatible string container
 
     @since version 1.0.0
     */
-    static basic_json array(std::initializer_list<basic_json> init =
-                                std::initializer_list<basic_json>())
-    {
-        return basic_json(init, false, value_t::array);
-    }
+    basic_json(const typename string_t::value_type* val)
+        : basic_json(string_t(val))
+    {}
 
     /*!
-    @brief explicitly create an object from an initializer list
-
-    Creates a JSON object value from a given initializer list. The initializer
-    lists elements must be pairs, and their first elements must be strings. If
-    the initializer list is empty, the empty object `{}` is created.
+    @brief create a string (implicit)
 
-    @note This function is only added for symmetry reasons. In contrast to the
-    related function @ref array(std::initializer_list<basic_json>), there are
-    no cases which can only be expressed by this function. That is, any
-    initializer list @a init can also be passed to the initializer list
-    constructor @ref basic_json(std::initializer_list<basic_json>, bool,
-    value_t).
+    Create a string JSON value with a given content.
 
-    @param[in] init  initializer list to create an object from (optional)
+    @param[in] val  a value for the string
 
-    @return JSON object value
+    @tparam CompatibleStringType an string type which is compatible to @ref
+    string_t, for instance `std::string`.
 
-    @throw std::domain_error if @a init is not a pair whose first elements are
-    strings; thrown by
-    @ref basic_json(std::initializer_list<basic_json>, bool, value_t)
+    @complexity Linear in the size of the passed @a val.
 
-    @complexity Linear in the size of @a init.
+    @throw std::bad_alloc if allocation for string value fails
 
-    @liveexample{The following code shows an example for the `object`
-    function.,object}
+    @liveexample{The following code shows the construction of a string value
+    from a compatible type.,basic_json__CompatibleStringType}
 
-    @sa @ref basic_json(std::initializer_list<basic_json>, bool, value_t) --
-    create a JSON value from an initializer list
-    @sa @ref array(std::initializer_list<basic_json>) -- create a JSON array
-    value from an initializer list
+    @sa @ref basic_json(const string_t&) -- create a string value
+    @sa @ref basic_json(const typename string_t::value_type*) -- create a
+    string value from a character pointer
 
     @since version 1.0.0
     */
-    static basic_json object(std::initializer_list<basic_json> init =
-                                 std::initializer_list<basic_json>())
-    {
-        return basic_json(init, false, value_t::object);
-    }
+    template <class CompatibleStringType, typename
+              std::enable_if<
+                  std::is_constructible<string_t, CompatibleStringType>::value, int>::type
+              = 0>
+    basic_json(const CompatibleStringType& val)
+        : basic_json(string_t(val))
+    {}
 
     /*!
-    @brief construct an array with count copies of given value
+    @brief create a boolean (explicit)
 
-    Constructs a JSON array value by creating @a cnt copies of a passed value.
-    In case @a cnt is `0`, an empty array is created. As postcondition,
-    `std::distance(begin(),end()) == cnt` holds.
+    Creates a JSON boolean type from a given value.
 
-    @param[in] cnt  the number of JSON copies of @a val to create
-    @param[in] val  the JSON value to copy
+    @param[in] val  a boolean value to store
 
-    @complexity Linear in @a cnt.
+    @complexity Constant.
 
-    @liveexample{The following code shows examples for the @ref
-    basic_json(size_type\, const basic_json&)
-    constructor.,basic_json__size_type_basic_json}
+    @liveexample{The example below demonstrates boolean
+    values.,basic_json__boolean_t}
 
     @since version 1.0.0
     */
-    basic_json(size_type cnt, const basic_json& val)
-        : m_type(value_t::array)
-    {
-        m_value.array = create<array_t>(cnt, val);
-    }
+    basic_json(boolean_t val) noexcept
+        : m_type(value_t::boolean), m_value(val)
+    {}
 
     /*!
-    @brief construct a JSON container given an iterator range
+    @brief create an integer number (explicit)
 
-    Constructs the JSON value with the contents of the range `[first, last)`.
-    The semantics depends on the different types a JSON value can have:
-    - In case of primitive types (number, boolean, or string), @a first must
-      be `begin()` and @a last must be `end()`. In this case, the value is
-      copied. Otherwise, std::out_of_range is thrown.
-    - In case of structured types (array, object), the constructor behaves as
-      similar versions for `std::vector`.
-    - In case of a null type, std::domain_error is thrown.
+    Create an integer number JSON value with a given content.
 
-    @tparam InputIT an input iterator type (@ref iterator or @ref
-    const_iterator)
+    @tparam T A helper type to remove this function via SFINAE in case @ref
+    number_integer_t is the same as `int`. In this case, this constructor
+    would have the same signature as @ref basic_json(const int value). Note
+    the helper type @a T is not visible in this constructor's interface.
 
-    @param[in] first begin of the range to copy from (included)
-    @param[in] last end of the range to copy from (excluded)
+    @param[in] val  an integer to create a JSON number from
 
-    @throw std::domain_error if iterators are not compatible; that is, do not
-    belong to the same JSON value; example: `"iterators are not compatible"`
-    @throw std::out_of_range if iterators are for a primitive type (number,
-    boolean, or string) where an out of range error can be detected easily;
-    example: `"iterators out of range"`
-    @throw std::bad_alloc if allocation for object, array, or string fails
-    @throw std::domain_error if called with a null value; example: `"cannot
-    use construct with iterators from null"`
+    @complexity Constant.
 
-    @complexity Linear in distance between @a first and @a last.
+    @liveexample{The example below shows the construction of an integer
+    number value.,basic_json__number_integer_t}
 
-    @liveexample{The example below shows several ways to create JSON values by
-    specifying a subrange with iterators.,basic_json__InputIt_InputIt}
+    @sa @ref basic_json(const int) -- create a number value (integer)
+    @sa @ref basic_json(const CompatibleNumberIntegerType) -- create a number
+    value (integer) from a compatible number type
 
     @since version 1.0.0
     */
-    template <class InputIT, typename
-              std::enable_if<
-                  std::is_same<InputIT, typename basic_json_t::iterator>::value or
-                  std::is_same<InputIT, typename basic_json_t::const_iterator>::value
-                  , int>::type
-              = 0>
-    basic_json(InputIT first, InputIT last) : m_type(first.m_object->m_type)
-    {
-        // make sure iterator fits the current value
-        if (first.m_object != last.m_object)
-        {
-            throw std::domain_error("iterators are not compatible");
-        }
+    template<typename T,
+             typename std::enable_if<
+                 not (std::is_same<T, int>::value)
+                 and std::is_same<T, number_integer_t>::value
+                 , int>::type
+             = 0>
+    basic_json(const number_integer_t val) noexcept
+        : m_type(value_t::number_integer), m_value(val)
+    {}
 
-        // check if iterator range is complete for primitive values
-        switch (m_type)
-        {
-            case value_t::boolean:
-            case value_t::number_float:
-            case value_t::number_integer:
-            case value_t::number_unsigned:
-            case value_t::string:
-            {
-                if (not first.m_it.primitive_iterator.is_begin() or not last.m_it.primitive_iterator.is_end())
-                {
-                    throw std::out_of_range("iterators out of range");
-                }
-                break;
-            }
+    /*!
+    @brief create an integer number from an enum type (explicit)
 
-            default:
-            {
-                break;
-            }
-        }
+    Create an integer number JSON value with a given content.
 
-        switch (m_type)
-        {
-            case value_t::number_integer:
-            {
-                assert(first.m_object != nullptr);
-                m_value.number_integer = first.m_object->m_value.number_integer;
-                break;
-            }
+    @param[in] val  an integer to create a JSON number from
 
-            case value_t::number_unsigned:
-            {
-                assert(first.m_object != nullptr);
-                m_value.number_unsigned = first.m_object->m_value.number_unsigned;
-                break;
-            }
+    @note This constructor allows to pass enums directly to a constructor. As
+    C++ has no way of specifying the type of an anonymous enum explicitly, we
+    can only rely on the fact that such values implicitly convert to int. As
+    int may already be the same type of number_integer_t, we may need to
+    switch off the constructor @ref basic_json(const number_integer_t).
 
-            case value_t::number_float:
-            {
-                assert(first.m_object != nullptr);
-                m_value.number_float = first.m_object->m_value.number_float;
-                break;
-            }
+    @complexity Constant.
 
-            case value_t::boolean:
-            {
-                assert(first.m_object != nullptr);
-                m_value.boolean = first.m_object->m_value.boolean;
-                break;
-            }
+    @liveexample{The example below shows the construction of an integer
+    number value from an anonymous enum.,basic_json__const_int}
 
-            case value_t::string:
-            {
-                assert(first.m_object != nullptr);
-                m_value = *first.m_object->m_value.string;
-                break;
-            }
+    @sa @ref basic_json(const number_integer_t) -- create a number value
+    (integer)
+    @sa @ref basic_json(const CompatibleNumberIntegerType) -- create a number
+    value (integer) from a compatible number type
 
-            case value_t::object:
-            {
-                m_value.object = create<object_t>(first.m_it.object_iterator, last.m_it.object_iterator);
-                break;
-            }
+    @since version 1.0.0
+    */
+    basic_json(const int val) noexcept
+        : m_type(value_t::number_integer),
+          m_value(static_cast<number_integer_t>(val))
+    {}
 
-            case value_t::array:
-            {
-                m_value.array = create<array_t>(first.m_it.array_iterator, last.m_it.array_iterator);
-                break;
-            }
+    /*!
+    @brief create an integer number (implicit)
 
-            default:
-            {
-                assert(first.m_object != nullptr);
-                throw std::domain_error("cannot use construct with iterators from " + first.m_object->type_name());
-            }
-        }
-    }
+    Create an integer number JSON value with a given content. This constructor
+    allows any type @a CompatibleNumberIntegerType that can be used to
+    construct values of type @ref number_integer_t.
 
-    /*!
-    @brief construct a JSON value given an input stream
+    @tparam CompatibleNumberIntegerType An integer type which is compatible to
+    @ref number_integer_t. Examples include the types `int`, `int32_t`,
+    `long`, and `short`.
 
-    @param[in,out] i  stream to read a serialized JSON value from
-    @param[in] cb a parser callback function of type @ref parser_callback_t
-    which is used to control the deserialization by filtering unwanted values
-    (optional)
+    @param[in] val  an integer to create a JSON number from
 
-    @complexity Linear in the length of the input. The parser is a predictive
-    LL(1) parser. The complexity can be higher if the parser callback function
-    @a cb has a super-linear complexity.
+    @complexity Constant.
 
-    @note A UTF-8 byte order mark is silently ignored.
+    @liveexample{The example below shows the construction of several integer
+    number values from compatible
+    types.,basic_json__CompatibleIntegerNumberType}
 
-    @liveexample{The example below demonstrates constructing a JSON value from
-    a `std::stringstream` with and without callback
-    function.,basic_json__istream}
+    @sa @ref basic_json(const number_integer_t) -- create a number value
+    (integer)
+    @sa @ref basic_json(const int) -- create a number value (integer)
 
-    @since version 2.0.0
+    @since version 1.0.0
     */
-    explicit basic_json(std::istream& i, parser_callback_t cb = nullptr)
-    {
-        *this = parser(i, cb).parse();
-    }
-
-    ///////////////////////////////////////
-    // other constructors and destructor //
-    ///////////////////////////////////////
+    template<typename CompatibleNumberIntegerType, typename
+             std::enable_if<
+                 std::is_constructible<number_integer_t, CompatibleNumberIntegerType>::value and
+                 std::numeric_limits<CompatibleNumberIntegerType>::is_integer and
+                 std::numeric_limits<CompatibleNumberIntegerType>::is_signed,
+                 CompatibleNumberIntegerType>::type
+             = 0>
+    basic_json(const CompatibleNumberIntegerType val) noexcept
+        : m_type(value_t::number_integer),
+          m_value(static_cast<number_integer_t>(val))
+    {}
 
     /*!
-    @brief copy constructor
-
-    Creates a copy of a given JSON value.
+    @brief create an unsigned integer number (explicit)
 
-    @param[in] other  the JSON value to copy
+    Create an unsigned integer number JSON value with a given content.
 
-    @complexity Linear in the size of @a other.
+    @tparam T  helper type to compare number_unsigned_t and unsigned int
+    (not visible in) the interface.
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is linear.
-    - As postcondition, it holds: `other == basic_json(other)`.
+    @param[in] val  an integer to create a JSON number from
 
-    @throw std::bad_alloc if allocation for object, array, or string fails.
+    @complexity Constant.
 
-    @liveexample{The following code shows an example for the copy
-    constructor.,basic_json__basic_json}
+    @sa @ref basic_json(const CompatibleNumberUnsignedType) -- create a number
+    value (unsigned integer) from a compatible number type
 
-    @since version 1.0.0
+    @since version 2.0.0
     */
-    basic_json(const basic_json& other)
-        : m_type(other.m_type)
-    {
-        switch (m_type)
-        {
-            case value_t::object:
-            {
-                assert(other.m_value.object != nullptr);
-                m_value = *other.m_value.object;
-                break;
-            }
+    template<typename T,
+             typename std::enable_if<
+                 not (std::is_same<T, int>::value)
+                 and std::is_same<T, number_unsigned_t>::value
+                 , int>::type
+             = 0>
+    basic_json(const number_unsigned_t val) noexcept
+        : m_type(value_t::number_unsigned), m_value(val)
+    {}
 
-            case value_t::array:
-            {
-                assert(other.m_value.array != nullptr);
-                m_value = *other.m_value.array;
-                break;
-            }
+    /*!
+    @brief create an unsigned number (implicit)
 
-            case value_t::string:
-            {
-                assert(other.m_value.string != nullptr);
-                m_value = *other.m_value.string;
-                break;
-            }
+    Create an unsigned number JSON value with a given content. This
+    constructor allows any type @a CompatibleNumberUnsignedType that can be
+    used to construct values of type @ref number_unsigned_t.
 
-            case value_t::boolean:
-            {
-                m_value = other.m_value.boolean;
-                break;
-            }
+    @tparam CompatibleNumberUnsignedType An integer type which is compatible
+    to @ref number_unsigned_t. Examples may include the types `unsigned int`,
+    `uint32_t`, or `unsigned short`.
 
-            case value_t::number_integer:
-            {
-                m_value = other.m_value.number_integer;
-                break;
-            }
+    @param[in] val  an unsigned integer to create a JSON number from
 
-            case value_t::number_unsigned:
-            {
-                m_value = other.m_value.number_unsigned;
-                break;
-            }
+    @complexity Constant.
 
-            case value_t::number_float:
-            {
-                m_value = other.m_value.number_float;
-                break;
-            }
+    @sa @ref basic_json(const number_unsigned_t) -- create a number value
+    (unsigned)
 
-            default:
-            {
-                break;
-            }
-        }
-    }
+    @since version 2.0.0
+    */
+    template <typename CompatibleNumberUnsignedType, typename
+              std::enable_if <
+                  std::is_constructible<number_unsigned_t, CompatibleNumberUnsignedType>::value and
+                  std::numeric_limits<CompatibleNumberUnsignedType>::is_integer and
+                  not std::numeric_limits<CompatibleNumberUnsignedType>::is_signed,
+                  CompatibleNumberUnsignedType>::type
+              = 0>
+    basic_json(const CompatibleNumberUnsignedType val) noexcept
+        : m_type(value_t::number_unsigned),
+          m_value(static_cast<number_unsigned_t>(val))
+    {}
 
     /*!
-    @brief move constructor
+    @brief create a floating-point number (explicit)
 
-    Move constructor. Constructs a JSON value with the contents of the given
-    value @a other using move semantics. It "steals" the resources from @a
-    other and leaves it as JSON null value.
+    Create a floating-point number JSON value with a given content.
 
-    @param[in,out] other  value to move to this object
+    @param[in] val  a floating-point value to create a JSON number from
 
-    @post @a other is a JSON null value
+    @note [RFC 7159](http://www.rfc-editor.org/rfc/rfc7159.txt), section 6
+    disallows NaN values:
+    > Numeric values that cannot be represented in the grammar below (such as
+    > Infinity and NaN) are not permitted.
+    In case the parameter @a val is not a number, a JSON null value is
+    created instead.
 
     @complexity Constant.
 
-    @liveexample{The code below shows the move constructor explicitly called
-    via std::move.,basic_json__moveconstructor}
+    @liveexample{The following example creates several floating-point
+    values.,basic_json__number_float_t}
+
+    @sa @ref basic_json(const CompatibleNumberFloatType) -- create a number
+    value (floating-point) from a compatible number type
 
     @since version 1.0.0
     */
-    basic_json(basic_json&& other) noexcept
-        : m_type(std::move(other.m_type)),
-          m_value(std::move(other.m_value))
+    basic_json(const number_float_t val) noexcept
+        : m_type(value_t::number_float), m_value(val)
     {
-        // invalidate payload
-        other.m_type = value_t::null;
-        other.m_value = {};
+        // replace infinity and NAN by null
+        if (not std::isfinite(val))
+        {
+            m_type = value_t::null;
+            m_value = json_value();
+        }
     }
 
     /*!
-    @brief copy assignment
-
-    Copy assignment operator. Copies a JSON value via the "copy and swap"
-    strategy: It is expressed in terms of the copy constructor, destructor,
-    and the swap() member function.
+    @brief create an floating-point number (implicit)
 
-    @param[in] other  value to copy from
+    Create an floating-point number JSON value with a given content. This
+    constructor allows any type @a CompatibleNumberFloatType that can be used
+    to construct values of type @ref number_float_t.
 
-    @complexity Linear.
+    @tparam CompatibleNumberFloatType A floating-point type which is
+    compatible to @ref number_float_t. Examples may include the types `float`
+    or `double`.
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is linear.
+    @param[in] val  a floating-point to create a JSON number from
 
-    @liveexample{The code below shows and example for the copy assignment. It
-    creates a copy of value `a` which is then swapped with `b`. Finally\, the
-    copy of `a` (which is the null value after the swap) is
-    destroyed.,basic_json__copyassignment}
+    @note [RFC 7159](http://www.rfc-editor.org/rfc/rfc7159.txt), section 6
+    disallows NaN values:
+    > Numeric values that cannot be represented in the grammar below (such as
+    > Infinity and NaN) are not permitted.
+    In case the parameter @a val is not a number, a JSON null value is
+    created instead.
 
-    @since version 1.0.0
-    */
-    reference& operator=(basic_json other) noexcept (
-        std::is_nothrow_move_constructible<value_t>::value and
-        std::is_nothrow_move_assignable<value_t>::value and
-        std::is_nothrow_move_constructible<json_value>::value and
-        std::is_nothrow_move_assignable<json_value>::value
-    )
-    {
-        using std::swap;
-        swap(m_type, other.m_type);
-        swap(m_value, other.m_value);
-        return *this;
-    }
+    @complexity Constant.
 
-    /*!
-    @brief destructor
+    @liveexample{The example below shows the construction of several
+    floating-point number values from compatible
+    types.,basic_json__CompatibleNumberFloatType}
 
-    Destroys the JSON value and frees all allocated memory.
+    @sa @ref basic_json(const number_float_t) -- create a number value
+    (floating-point)
 
-    @complexity Linear.
+    @since version 1.0.0
+    */
+    template<typename CompatibleNumberFloatType, typename = typename
+             std::enable_if<
+                 std::is_constructible<number_float_t, CompatibleNumberFloatType>::value and
+                 std::is_floating_point<CompatibleNumberFloatType>::value>::type
+             >
+    basic_json(const CompatibleNumberFloatType val) noexcept
+        : basic_json(number_float_t(val))
+    {}
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is linear.
-    - All stored elements are destroyed and all memory is freed.
+    /*!
+    @brief create a container (array or object) from an initializer list
+
+    Creates a JSON value of type array or object from the passed initializer
+    list @a init. In case @a type_deduction is `true` (default), the type of
+    the JSON value to be created is deducted from the initializer list @a init
+    according to the following rules:
+
+    1. If the list is empty, an empty JSON object value `{}` is created.
+    2. If the list consists of pairs whose first element is a string, a JSON
+    object value is created where the first elements of the pairs are treated
+    as keys and the second elements are as values.
+    3. In all other cases, an array is created.
+
+    The rules aim to create the best fit between a C++ initializer list and
+    JSON values. The rationale is as follows:
+
+    1. The empty initializer list is written as `{}` which is exactly an empty
+    JSON object.
+    2. C++ has now way of describing mapped types other than to list a list of
+    pairs. As JSON requires that keys must be of type string, rule 2 is the
+    weakest constraint one can pose on initializer lists to interpret them as
+    an object.
+    3. In all other cases, the initializer list could not be interpreted as
+    JSON object type, so interpreting it as JSON array type is safe.
+
+    With the rules described above, the following JSON values cannot be
+    expressed by an initializer list:
+
+    - the empty array (`[]`): use @ref array(std::initializer_list<basic_json>)
+      with an empty initializer list in this case
+    - arrays whose elements satisfy rule 2: use @ref
+      array(std::initializer_list<basic_json>) with the same initializer list
+      in this case
+
+    @note When used without parentheses around an empty initializer list, @ref
+    basic_json() is called instead of this function, yielding the JSON null
+    value.
+
+    @param[in] init  initializer list with JSON values
+
+    @param[in] type_deduction internal parameter; when set to `true`, the type
+    of the JSON value is deducted from the initializer list @a init; when set
+    to `false`, the type provided via @a manual_type is forced. This mode is
+    used by the functions @ref array(std::initializer_list<basic_json>) and
+    @ref object(std::initializer_list<basic_json>).
+
+    @param[in] manual_type internal parameter; when @a type_deduction is set
+    to `false`, the created JSON value will use the provided type (only @ref
+    value_t::array and @ref value_t::object are valid); when @a type_deduction
+    is set to `true`, this parameter has no effect
+
+    @throw std::domain_error if @a type_deduction is `false`, @a manual_type
+    is `value_t::object`, but @a init contains an element which is not a pair
+    whose first element is a string; example: `"cannot create object from
+    initializer list"`
+
+    @complexity Linear in the size of the initializer list @a init.
+
+    @liveexample{The example below shows how JSON values are created from
+    initializer lists.,basic_json__list_init_t}
+
+    @sa @ref array(std::initializer_list<basic_json>) -- create a JSON array
+    value from an initializer list
+    @sa @ref object(std::initializer_list<basic_json>) -- create a JSON object
+    value from an initializer list
 
     @since version 1.0.0
     */
-    ~basic_json()
+    basic_json(std::initializer_list<basic_json> init,
+               bool type_deduction = true,
+               value_t manual_type = value_t::array)
     {
-        switch (m_type)
+        // the initializer list could describe an object
+        bool is_an_object = true;
+
+        // check if each element is an array with two elements whose first
+        // element is a string
+        for (const auto& element : init)
         {
-            case value_t::object:
+            if (not element.is_array() or element.size() != 2
+                    or not element[0].is_string())
             {
-                AllocatorType<object_t> alloc;
-                alloc.destroy(m_value.object);
-                alloc.deallocate(m_value.object, 1);
+                // we found an element that makes it impossible to use the
+                // initializer list as object
+                is_an_object = false;
                 break;
             }
+        }
 
-            case value_t::array:
+        // adjust type if type deduction is not wanted
+        if (not type_deduction)
+        {
+            // if array is wanted, do not create an object though possible
+            if (manual_type == value_t::array)
             {
-                AllocatorType<array_t> alloc;
-                alloc.destroy(m_value.array);
-                alloc.deallocate(m_value.array, 1);
-                break;
+                is_an_object = false;
             }
 
-            case value_t::string:
+            // if object is wanted but impossible, throw an exception
+            if (manual_type == value_t::object and not is_an_object)
             {
-                AllocatorType<string_t> alloc;
-                alloc.destroy(m_value.string);
-                alloc.deallocate(m_value.string, 1);
-                break;
+                throw std::domain_error("cannot create object from initializer list");
             }
+        }
 
-            default:
+        if (is_an_object)
+        {
+            // the initializer list is a list of pairs -> create object
+            m_type = value_t::object;
+            m_value = value_t::object;
+
+            assert(m_value.object != nullptr);
+
+            for (auto& element : init)
             {
-                // all other types need no specific destructor
-                break;
+                m_value.object->emplace(*(element[0].m_value.string), element[1]);
             }
         }
+        else
+        {
+            // the initializer list describes an array -> create array
+            m_type = value_t::array;
+            m_value.array = create<array_t>(init);
+        }
     }
 
-    /// @}
-
-  public:
-    ///////////////////////
-    // object inspection //
-    ///////////////////////
-
-    /// @name object inspection
-    /// @{
-
     /*!
-    @brief serialization
+    @brief explicitly create an array from an initializer list
 
-    Serialization function for JSON values. The function tries to mimic
-    Python's @p json.dumps() function, and currently supports its @p indent
-    parameter.
+    Creates a JSON array value from a given initializer list. That is, given a
+    list of values `a, b, c`, creates the JSON value `[a, b, c]`. If the
+    initializer list is empty, the empty array `[]` is created.
 
-    @param[in] indent if indent is nonnegative, then array elements and object
-    members will be pretty-printed with that indent level. An indent level of
-    0 will only insert newlines. -1 (the default) selects the most compact
-    representation
+    @note This function is only needed to express two edge cases that cannot
+    be realized with the initializer list constructor (@ref
+    basic_json(std::initializer_list<basic_json>, bool, value_t)). These cases
+    are:
+    1. creating an array whose elements are all pairs whose first element is a
+    string -- in this case, the initializer list constructor would create an
+    object, taking the first elements as keys
+    2. creating an empty array -- passing the empty initializer list to the
+    initializer list constructor yields an empty object
 
-    @return string containing the serialization of the JSON value
+    @param[in] init  initializer list with JSON values to create an array from
+    (optional)
 
-    @complexity Linear.
+    @return JSON array value
 
-    @liveexample{The following example shows the effect of different @a indent
-    parameters to the result of the serialization.,dump}
+    @complexity Linear in the size of @a init.
 
-    @see https://docs.python.org/2/library/json.html#json.dump
+    @liveexample{The following code shows an example for the `array`
+    function.,array}
+
+    @sa @ref basic_json(std::initializer_list<basic_json>, bool, value_t) --
+    create a JSON value from an initializer list
+    @sa @ref object(std::initializer_list<basic_json>) -- create a JSON object
+    value from an initializer list
 
     @since version 1.0.0
     */
-    string_t dump(const int indent = -1) const
+    static basic_json array(std::initializer_list<basic_json> init =
+                                std::initializer_list<basic_json>())
     {
-        std::stringstream ss;
-        // fix locale problems
-        ss.imbue(std::locale(std::locale(), new DecimalSeparator));
-
-        if (indent >= 0)
-        {
-            dump(ss, true, static_cast<unsigned int>(indent));
-        }
-        else
-        {
-            dump(ss, false, 0);
-        }
-
-        return ss.str();
+        return basic_json(init, false, value_t::array);
     }
 
     /*!
-    @brief return the type of the JSON value (explicit)
+    @brief explicitly create an object from an initializer list
 
-    Return the type of the JSON value as a value from the @ref value_t
-    enumeration.
+    Creates a JSON object value from a given initializer list. The initializer
+    lists elements must be pairs, and their first elements must be strings. If
+    the initializer list is empty, the empty object `{}` is created.
 
-    @return the type of the JSON value
+    @note This function is only added for symmetry reasons. In contrast to the
+    related function @ref array(std::initializer_list<basic_json>), there are
+    no cases which can only be expressed by this function. That is, any
+    initializer list @a init can also be passed to the initializer list
+    constructor @ref basic_json(std::initializer_list<basic_json>, bool,
+    value_t).
 
-    @complexity Constant.
+    @param[in] init  initializer list to create an object from (optional)
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @return JSON object value
 
-    @liveexample{The following code exemplifies `type()` for all JSON
-    types.,type}
+    @throw std::domain_error if @a init is not a pair whose first elements are
+    strings; thrown by
+    @ref basic_json(std::initializer_list<basic_json>, bool, value_t)
+
+    @complexity Linear in the size of @a init.
+
+    @liveexample{The following code shows an example for the `object`
+    function.,object}
+
+    @sa @ref basic_json(std::initializer_list<basic_json>, bool, value_t) --
+    create a JSON value from an initializer list
+    @sa @ref array(std::initializer_list<basic_json>) -- create a JSON array
+    value from an initializer list
 
     @since version 1.0.0
     */
-    constexpr value_t type() const noexcept
+    static basic_json object(std::initializer_list<basic_json> init =
+                                 std::initializer_list<basic_json>())
     {
-        return m_type;
+        return basic_json(init, false, value_t::object);
     }
 
     /*!
-    @brief return whether type is primitive
+    @brief construct an array with count copies of given value
 
-    This function returns true iff the JSON type is primitive (string, number,
-    boolean, or null).
+    Constructs a JSON array value by creating @a cnt copies of a passed value.
+    In case @a cnt is `0`, an empty array is created. As postcondition,
+    `std::distance(begin(),end()) == cnt` holds.
 
-    @return `true` if type is primitive (string, number, boolean, or null),
-    `false` otherwise.
+    @param[in] cnt  the number of JSON copies of @a val to create
+    @param[in] val  the JSON value to copy
 
-    @complexity Constant.
-
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
-
-    @liveexample{The following code exemplifies `is_primitive()` for all JSON
-    types.,is_primitive}
+    @complexity Linear in @a cnt.
 
-    @sa @ref is_structured() -- returns whether JSON value is structured
-    @sa @ref is_null() -- returns whether JSON value is `null`
-    @sa @ref is_string() -- returns whether JSON value is a string
-    @sa @ref is_boolean() -- returns whether JSON value is a boolean
-    @sa @ref is_number() -- returns whether JSON value is a number
+    @liveexample{The following code shows examples for the @ref
+    basic_json(size_type\, const basic_json&)
+    constructor.,basic_json__size_type_basic_json}
 
     @since version 1.0.0
     */
-    constexpr bool is_primitive() const noexcept
+    basic_json(size_type cnt, const basic_json& val)
+        : m_type(value_t::array)
     {
-        return is_null() or is_string() or is_boolean() or is_number();
+        m_value.array = create<array_t>(cnt, val);
     }
 
     /*!
-    @brief return whether type is structured
+    @brief construct a JSON container given an iterator range
 
-    This function returns true iff the JSON type is structured (array or
-    object).
+    Constructs the JSON value with the contents of the range `[first, last)`.
+    The semantics depends on the different types a JSON value can have:
+    - In case of primitive types (number, boolean, or string), @a first must
+      be `begin()` and @a last must be `end()`. In this case, the value is
+      copied. Otherwise, std::out_of_range is thrown.
+    - In case of structured types (array, object), the constructor behaves as
+      similar versions for `std::vector`.
+    - In case of a null type, std::domain_error is thrown.
 
-    @return `true` if type is structured (array or object), `false` otherwise.
+    @tparam InputIT an input iterator type (@ref iterator or @ref
+    const_iterator)
 
-    @complexity Constant.
+    @param[in] first begin of the range to copy from (included)
+    @param[in] last end of the range to copy from (excluded)
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @throw std::domain_error if iterators are not compatible; that is, do not
+    belong to the same JSON value; example: `"iterators are not compatible"`
+    @throw std::out_of_range if iterators are for a primitive type (number,
+    boolean, or string) where an out of range error can be detected easily;
+    example: `"iterators out of range"`
+    @throw std::bad_alloc if allocation for object, array, or string fails
+    @throw std::domain_error if called with a null value; example: `"cannot
+    use construct with iterators from null"`
 
-    @liveexample{The following code exemplifies `is_structured()` for all JSON
-    types.,is_structured}
+    @complexity Linear in distance between @a first and @a last.
 
-    @sa @ref is_primitive() -- returns whether value is primitive
-    @sa @ref is_array() -- returns whether value is an array
-    @sa @ref is_object() -- returns whether value is an object
+    @liveexample{The example below shows several ways to create JSON values by
+    specifying a subrange with iterators.,basic_json__InputIt_InputIt}
 
     @since version 1.0.0
     */
-    constexpr bool is_structured() const noexcept
+    template <class InputIT, typename
+              std::enable_if<
+                  std::is_same<InputIT, typename basic_json_t::iterator>::value or
+                  std::is_same<InputIT, typename basic_json_t::const_iterator>::value
+                  , int>::type
+              = 0>
+    basic_json(InputIT first, InputIT last) : m_type(first.m_object->m_type)
     {
-        return is_array() or is_object();
-    }
-
-    /*!
-    @brief return whether value is null
-
-    This function returns true iff the JSON value is null.
-
-    @return `true` if type is null, `false` otherwise.
-
-    @complexity Constant.
+        // make sure iterator fits the current value
+        if (first.m_object != last.m_object)
+        {
+            throw std::domain_error("iterators are not compatible");
+        }
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+        // check if iterator range is complete for primitive values
+        switch (m_type)
+        {
+            case value_t::boolean:
+            case value_t::number_float:
+            case value_t::number_integer:
+            case value_t::number_unsigned:
+            case value_t::string:
+            {
+                if (not first.m_it.primitive_iterator.is_begin() or not last.m_it.primitive_iterator.is_end())
+                {
+                    throw std::out_of_range("iterators out of range");
+                }
+                break;
+            }
 
-    @liveexample{The following code exemplifies `is_null()` for all JSON
-    types.,is_null}
+            default:
+            {
+                break;
+            }
+        }
 
-    @since version 1.0.0
-    */
-    constexpr bool is_null() const noexcept
-    {
-        return m_type == value_t::null;
-    }
+        switch (m_type)
+        {
+            case value_t::number_integer:
+            {
+                assert(first.m_object != nullptr);
+                m_value.number_integer = first.m_object->m_value.number_integer;
+                break;
+            }
 
-    /*!
-    @brief return whether value is a boolean
+            case value_t::number_unsigned:
+            {
+                assert(first.m_object != nullptr);
+                m_value.number_unsigned = first.m_object->m_value.number_unsigned;
+                break;
+            }
 
-    This function returns true iff the JSON value is a boolean.
+            case value_t::number_float:
+            {
+                assert(first.m_object != nullptr);
+                m_value.number_float = first.m_object->m_value.number_float;
+                break;
+            }
 
-    @return `true` if type is boolean, `false` otherwise.
+            case value_t::boolean:
+            {
+                assert(first.m_object != nullptr);
+                m_value.boolean = first.m_object->m_value.boolean;
+                break;
+            }
 
-    @complexity Constant.
+            case value_t::string:
+            {
+                assert(first.m_object != nullptr);
+                m_value = *first.m_object->m_value.string;
+                break;
+            }
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+            case value_t::object:
+            {
+                m_value.object = create<object_t>(first.m_it.object_iterator, last.m_it.object_iterator);
+                break;
+            }
 
-    @liveexample{The following code exemplifies `is_boolean()` for all JSON
-    types.,is_boolean}
+            case value_t::array:
+            {
+                m_value.array = create<array_t>(first.m_it.array_iterator, last.m_it.array_iterator);
+                break;
+            }
 
-    @since version 1.0.0
-    */
-    constexpr bool is_boolean() const noexcept
-    {
-        return m_type == value_t::boolean;
+            default:
+            {
+                assert(first.m_object != nullptr);
+                throw std::domain_error("cannot use construct with iterators from " + first.m_object->type_name());
+            }
+        }
     }
 
     /*!
-    @brief return whether value is a number
-
-    This function returns true iff the JSON value is a number. This includes
-    both integer and floating-point values.
-
-    @return `true` if type is number (regardless whether integer, unsigned
-    integer or floating-type), `false` otherwise.
+    @brief construct a JSON value given an input stream
 
-    @complexity Constant.
+    @param[in,out] i  stream to read a serialized JSON value from
+    @param[in] cb a parser callback function of type @ref parser_callback_t
+    which is used to control the deserialization by filtering unwanted values
+    (optional)
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @complexity Linear in the length of the input. The parser is a predictive
+    LL(1) parser. The complexity can be higher if the parser callback function
+    @a cb has a super-linear complexity.
 
-    @liveexample{The following code exemplifies `is_number()` for all JSON
-    types.,is_number}
+    @note A UTF-8 byte order mark is silently ignored.
 
-    @sa @ref is_number_integer() -- check if value is an integer or unsigned
-    integer number
-    @sa @ref is_number_unsigned() -- check if value is an unsigned integer
-    number
-    @sa @ref is_number_float() -- check if value is a floating-point number
+    @liveexample{The example below demonstrates constructing a JSON value from
+    a `std::stringstream` with and without callback
+    function.,basic_json__istream}
 
-    @since version 1.0.0
+    @since version 2.0.0
     */
-    constexpr bool is_number() const noexcept
+    explicit basic_json(std::istream& i, parser_callback_t cb = nullptr)
     {
-        return is_number_integer() or is_number_float();
+        *this = parser(i, cb).parse();
     }
 
+    ///////////////////////////////////////
+    // other constructors and destructor //
+    ///////////////////////////////////////
+
     /*!
-    @brief return whether value is an integer number
+    @brief copy constructor
 
-    This function returns true iff the JSON value is an integer or unsigned
-    integer number. This excludes floating-point values.
+    Creates a copy of a given JSON value.
 
-    @return `true` if type is an integer or unsigned integer number, `false`
-    otherwise.
+    @param[in] other  the JSON value to copy
 
-    @complexity Constant.
+    @complexity Linear in the size of @a other.
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is linear.
+    - As postcondition, it holds: `other == basic_json(other)`.
 
-    @liveexample{The following code exemplifies `is_number_integer()` for all
-    JSON types.,is_number_integer}
+    @throw std::bad_alloc if allocation for object, array, or string fails.
 
-    @sa @ref is_number() -- check if value is a number
-    @sa @ref is_number_unsigned() -- check if value is an unsigned integer
-    number
-    @sa @ref is_number_float() -- check if value is a floating-point number
+    @liveexample{The following code shows an example for the copy
+    constructor.,basic_json__basic_json}
 
     @since version 1.0.0
     */
-    constexpr bool is_number_integer() const noexcept
+    basic_json(const basic_json& other)
+        : m_type(other.m_type)
     {
-        return m_type == value_t::number_integer or m_type == value_t::number_unsigned;
-    }
-
-    /*!
-    @brief return whether value is an unsigned integer number
+        switch (m_type)
+        {
+            case value_t::object:
+            {
+                assert(other.m_value.object != nullptr);
+                m_value = *other.m_value.object;
+                break;
+            }
 
-    This function returns true iff the JSON value is an unsigned integer
-    number. This excludes floating-point and (signed) integer values.
+            case value_t::array:
+            {
+                assert(other.m_value.array != nullptr);
+                m_value = *other.m_value.array;
+                break;
+            }
 
-    @return `true` if type is an unsigned integer number, `false` otherwise.
+            case value_t::string:
+            {
+                assert(other.m_value.string != nullptr);
+                m_value = *other.m_value.string;
+                break;
+            }
 
-    @complexity Constant.
+            case value_t::boolean:
+            {
+                m_value = other.m_value.boolean;
+                break;
+            }
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+            case value_t::number_integer:
+            {
+                m_value = other.m_value.number_integer;
+                break;
+            }
 
-    @liveexample{The following code exemplifies `is_number_unsigned()` for all
-    JSON types.,is_number_unsigned}
+            case value_t::number_unsigned:
+            {
+                m_value = other.m_value.number_unsigned;
+                break;
+            }
 
-    @sa @ref is_number() -- check if value is a number
-    @sa @ref is_number_integer() -- check if value is an integer or unsigned
-    integer number
-    @sa @ref is_number_float() -- check if value is a floating-point number
+            case value_t::number_float:
+            {
+                m_value = other.m_value.number_float;
+                break;
+            }
 
-    @since version 2.0.0
-    */
-    constexpr bool is_number_unsigned() const noexcept
-    {
-        return m_type == value_t::number_unsigned;
+            default:
+            {
+                break;
+            }
+        }
     }
 
     /*!
-    @brief return whether value is a floating-point number
-
-    This function returns true iff the JSON value is a floating-point number.
-    This excludes integer and unsigned integer values.
+    @brief move constructor
 
-    @return `true` if type is a floating-point number, `false` otherwise.
+    Move constructor. Constructs a JSON value with the contents of the given
+    value @a other using move semantics. It "steals" the resources from @a
+    other and leaves it as JSON null value.
 
-    @complexity Constant.
+    @param[in,out] other  value to move to this object
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @post @a other is a JSON null value
 
-    @liveexample{The following code exemplifies `is_number_float()` for all
-    JSON types.,is_number_float}
+    @complexity Constant.
 
-    @sa @ref is_number() -- check if value is number
-    @sa @ref is_number_integer() -- check if value is an integer number
-    @sa @ref is_number_unsigned() -- check if value is an unsigned integer
-    number
+    @liveexample{The code below shows the move constructor explicitly called
+    via std::move.,basic_json__moveconstructor}
 
     @since version 1.0.0
     */
-    constexpr bool is_number_float() const noexcept
+    basic_json(basic_json&& other) noexcept
+        : m_type(std::move(other.m_type)),
+          m_value(std::move(other.m_value))
     {
-        return m_type == value_t::number_float;
+        // invalidate payload
+        other.m_type = value_t::null;
+        other.m_value = {};
     }
 
     /*!
-    @brief return whether value is an object
+    @brief copy assignment
 
-    This function returns true iff the JSON value is an object.
+    Copy assignment operator. Copies a JSON value via the "copy and swap"
+    strategy: It is expressed in terms of the copy constructor, destructor,
+    and the swap() member function.
 
-    @return `true` if type is object, `false` otherwise.
+    @param[in] other  value to copy from
 
-    @complexity Constant.
+    @complexity Linear.
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is linear.
 
-    @liveexample{The following code exemplifies `is_object()` for all JSON
-    types.,is_object}
+    @liveexample{The code below shows and example for the copy assignment. It
+    creates a copy of value `a` which is then swapped with `b`. Finally\, the
+    copy of `a` (which is the null value after the swap) is
+    destroyed.,basic_json__copyassignment}
 
     @since version 1.0.0
     */
-    constexpr bool is_object() const noexcept
+    reference& operator=(basic_json other) noexcept (
+        std::is_nothrow_move_constructible<value_t>::value and
+        std::is_nothrow_move_assignable<value_t>::value and
+        std::is_nothrow_move_constructible<json_value>::value and
+        std::is_nothrow_move_assignable<json_value>::value
+    )
     {
-        return m_type == value_t::object;
+        using std::swap;
+        swap(m_type, other.m_type);
+        swap(m_value, other.m_value);
+        return *this;
     }
 
     /*!
-    @brief return whether value is an array
-
-    This function returns true iff the JSON value is an array.
-
-    @return `true` if type is array, `false` otherwise.
+    @brief destructor
 
-    @complexity Constant.
+    Destroys the JSON value and frees all allocated memory.
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @complexity Linear.
 
-    @liveexample{The following code exemplifies `is_array()` for all JSON
-    types.,is_array}
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is linear.
+    - All stored elements are destroyed and all memory is freed.
 
     @since version 1.0.0
     */
-    constexpr bool is_array() const noexcept
+    ~basic_json()
     {
-        return m_type == value_t::array;
-    }
-
-    /*!
-    @brief return whether value is a string
+        switch (m_type)
+        {
+            case value_t::object:
+            {
+                AllocatorType<object_t> alloc;
+                alloc.destroy(m_value.object);
+                alloc.deallocate(m_value.object, 1);
+                break;
+            }
 
-    This function returns true iff the JSON value is a string.
+            case value_t::array:
+            {
+                AllocatorType<array_t> alloc;
+                alloc.destroy(m_value.array);
+                alloc.deallocate(m_value.array, 1);
+                break;
+            }
 
-    @return `true` if type is string, `false` otherwise.
+            case value_t::string:
+            {
+                AllocatorType<string_t> alloc;
+                alloc.destroy(m_value.string);
+                alloc.deallocate(m_value.string, 1);
+                break;
+            }
 
-    @complexity Constant.
+            default:
+            {
+                // all other types need no specific destructor
+                break;
+            }
+        }
+    }
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    /// @}
 
-    @liveexample{The following code exemplifies `is_string()` for all JSON
-    types.,is_string}
+  public:
+    ///////////////////////
+    // object inspection //
+    ///////////////////////
 
-    @since version 1.0.0
-    */
-    constexpr bool is_string() const noexcept
-    {
-        return m_type == value_t::string;
-    }
+    /// @name object inspection
+    /// @{
 
     /*!
-    @brief return whether value is discarded
+    @brief serialization
 
-    This function returns true iff the JSON value was discarded during parsing
-    with a callback function (see @ref parser_callback_t).
+    Serialization function for JSON values. The function tries to mimic
+    Python's @p json.dumps() function, and currently supports its @p indent
+    parameter.
 
-    @note This function will always be `false` for JSON values after parsing.
-    That is, discarded values can only occur during parsing, but will be
-    removed when inside a structured value or replaced by null in other cases.
+    @param[in] indent if indent is nonnegative, then array elements and object
+    members will be pretty-printed with that indent level. An indent level of
+    0 will only insert newlines. -1 (the default) selects the most compact
+    representation
 
-    @return `true` if type is discarded, `false` otherwise.
+    @return string containing the serialization of the JSON value
 
-    @complexity Constant.
+    @complexity Linear.
 
-    @exceptionsafety No-throw guarantee: this member function never throws
-    exceptions.
+    @liveexample{The following example shows the effect of different @a indent
+    parameters to the result of the serialization.,dump}
 
-    @liveexample{The following code exemplifies `is_discarded()` for all JSON
-    types.,is_discarded}
+    @see https://docs.python.org/2/library/json.html#json.dump
 
     @since version 1.0.0
     */
-    constexpr bool is_discarded() const noexcept
+    string_t dump(const int indent = -1) const
     {
-        return m_type == value_t::discarded;
+        std::stringstream ss;
+        // fix locale problems
+        ss.imbue(std::locale(std::locale(), new DecimalSeparator));
+
+        if (indent >= 0)
+        {
+            dump(ss, true, static_cast<unsigned int>(indent));
+        }
+        else
+        {
+            dump(ss, false, 0);
+        }
+
+        return ss.str();
     }
 
     /*!
-    @brief return the type of the JSON value (implicit)
+    @brief return the type of the JSON value (explicit)
 
-    Implicitly return the type of the JSON value as a value from the @ref
-    value_t enumeration.
+    Return the type of the JSON value as a value from the @ref value_t
+    enumeration.
 
     @return the type of the JSON value
 
@@ -2457,6047 +3309,7212 @@ class basic_json
     @exceptionsafety No-throw guarantee: this member function never throws
     exceptions.
 
-    @liveexample{The following code exemplifies the @ref value_t operator for
-    all JSON types.,operator__value_t}
+    @liveexample{The following code exemplifies `type()` for all JSON
+    types.,type}
 
     @since version 1.0.0
     */
-    constexpr operator value_t() const noexcept
+    constexpr value_t type() const noexcept
     {
         return m_type;
     }
 
-    /// @}
+    /*!
+    @brief return whether type is primitive
 
-  private:
-    //////////////////
-    // value access //
-    //////////////////
+    This function returns true iff the JSON type is primitive (string, number,
+    boolean, or null).
 
-    /// get an object (explicit)
-    template <class T, typename
-              std::enable_if<
-                  std::is_convertible<typename object_t::key_type, typename T::key_type>::value and
-                  std::is_convertible<basic_json_t, typename T::mapped_type>::value
-                  , int>::type = 0>
-    T get_impl(T*) const
-    {
-        if (is_object())
-        {
-            assert(m_value.object != nullptr);
-            return T(m_value.object->begin(), m_value.object->end());
-        }
-        else
-        {
-            throw std::domain_error("type must be object, but is " + type_name());
-        }
-    }
+    @return `true` if type is primitive (string, number, boolean, or null),
+    `false` otherwise.
 
-    /// get an object (explicit)
-    object_t get_impl(object_t*) const
-    {
-        if (is_object())
-        {
-            assert(m_value.object != nullptr);
-            return *(m_value.object);
-        }
-        else
-        {
-            throw std::domain_error("type must be object, but is " + type_name());
-        }
-    }
+    @complexity Constant.
 
-    /// get an array (explicit)
-    template <class T, typename
-              std::enable_if<
-                  std::is_convertible<basic_json_t, typename T::value_type>::value and
-                  not std::is_same<basic_json_t, typename T::value_type>::value and
-                  not std::is_arithmetic<T>::value and
-                  not std::is_convertible<std::string, T>::value and
-                  not has_mapped_type<T>::value
-                  , int>::type = 0>
-    T get_impl(T*) const
-    {
-        if (is_array())
-        {
-            T to_vector;
-            assert(m_value.array != nullptr);
-            std::transform(m_value.array->begin(), m_value.array->end(),
-                           std::inserter(to_vector, to_vector.end()), [](basic_json i)
-            {
-                return i.get<typename T::value_type>();
-            });
-            return to_vector;
-        }
-        else
-        {
-            throw std::domain_error("type must be array, but is " + type_name());
-        }
-    }
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    /// get an array (explicit)
-    template <class T, typename
-              std::enable_if<
-                  std::is_convertible<basic_json_t, T>::value and
-                  not std::is_same<basic_json_t, T>::value
-                  , int>::type = 0>
-    std::vector<T> get_impl(std::vector<T>*) const
-    {
-        if (is_array())
-        {
-            std::vector<T> to_vector;
-            assert(m_value.array != nullptr);
-            to_vector.reserve(m_value.array->size());
-            std::transform(m_value.array->begin(), m_value.array->end(),
-                           std::inserter(to_vector, to_vector.end()), [](basic_json i)
-            {
-                return i.get<T>();
-            });
-            return to_vector;
-        }
-        else
-        {
-            throw std::domain_error("type must be array, but is " + type_name());
-        }
-    }
+    @liveexample{The following code exemplifies `is_primitive()` for all JSON
+    types.,is_primitive}
 
-    /// get an array (explicit)
-    template <class T, typename
-              std::enable_if<
-                  std::is_same<basic_json, typename T::value_type>::value and
-                  not has_mapped_type<T>::value
-                  , int>::type = 0>
-    T get_impl(T*) const
-    {
-        if (is_array())
-        {
-            assert(m_value.array != nullptr);
-            return T(m_value.array->begin(), m_value.array->end());
-        }
-        else
-        {
-            throw std::domain_error("type must be array, but is " + type_name());
-        }
-    }
+    @sa @ref is_structured() -- returns whether JSON value is structured
+    @sa @ref is_null() -- returns whether JSON value is `null`
+    @sa @ref is_string() -- returns whether JSON value is a string
+    @sa @ref is_boolean() -- returns whether JSON value is a boolean
+    @sa @ref is_number() -- returns whether JSON value is a number
 
-    /// get an array (explicit)
-    array_t get_impl(array_t*) const
+    @since version 1.0.0
+    */
+    constexpr bool is_primitive() const noexcept
     {
-        if (is_array())
-        {
-            assert(m_value.array != nullptr);
-            return *(m_value.array);
-        }
-        else
-        {
-            throw std::domain_error("type must be array, but is " + type_name());
-        }
+        return is_null() or is_string() or is_boolean() or is_number();
     }
 
-    /// get a string (explicit)
-    template <typename T, typename
-              std::enable_if<
-                  std::is_convertible<string_t, T>::value
-                  , int>::type = 0>
-    T get_impl(T*) const
-    {
-        if (is_string())
-        {
-            assert(m_value.string != nullptr);
-            return *m_value.string;
-        }
-        else
-        {
-            throw std::domain_error("type must be string, but is " + type_name());
-        }
-    }
+    /*!
+    @brief return whether type is structured
 
-    /// get a number (explicit)
-    template<typename T, typename
-             std::enable_if<
-                 std::is_arithmetic<T>::value
-                 , int>::type = 0>
-    T get_impl(T*) const
-    {
-        switch (m_type)
-        {
-            case value_t::number_integer:
-            {
-                return static_cast<T>(m_value.number_integer);
-            }
+    This function returns true iff the JSON type is structured (array or
+    object).
 
-            case value_t::number_unsigned:
-            {
-                return static_cast<T>(m_value.number_unsigned);
-            }
+    @return `true` if type is structured (array or object), `false` otherwise.
 
-            case value_t::number_float:
-            {
-                return static_cast<T>(m_value.number_float);
-            }
+    @complexity Constant.
 
-            default:
-            {
-                throw std::domain_error("type must be number, but is " + type_name());
-            }
-        }
-    }
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    /// get a boolean (explicit)
-    constexpr boolean_t get_impl(boolean_t*) const
-    {
-        return is_boolean()
-               ? m_value.boolean
-               : throw std::domain_error("type must be boolean, but is " + type_name());
-    }
+    @liveexample{The following code exemplifies `is_structured()` for all JSON
+    types.,is_structured}
 
-    /// get a pointer to the value (object)
-    object_t* get_impl_ptr(object_t*) noexcept
-    {
-        return is_object() ? m_value.object : nullptr;
-    }
+    @sa @ref is_primitive() -- returns whether value is primitive
+    @sa @ref is_array() -- returns whether value is an array
+    @sa @ref is_object() -- returns whether value is an object
 
-    /// get a pointer to the value (object)
-    constexpr const object_t* get_impl_ptr(const object_t*) const noexcept
+    @since version 1.0.0
+    */
+    constexpr bool is_structured() const noexcept
     {
-        return is_object() ? m_value.object : nullptr;
+        return is_array() or is_object();
     }
 
-    /// get a pointer to the value (array)
-    array_t* get_impl_ptr(array_t*) noexcept
-    {
-        return is_array() ? m_value.array : nullptr;
-    }
+    /*!
+    @brief return whether value is null
 
-    /// get a pointer to the value (array)
-    constexpr const array_t* get_impl_ptr(const array_t*) const noexcept
-    {
-        return is_array() ? m_value.array : nullptr;
-    }
+    This function returns true iff the JSON value is null.
 
-    /// get a pointer to the value (string)
-    string_t* get_impl_ptr(string_t*) noexcept
-    {
-        return is_string() ? m_value.string : nullptr;
-    }
+    @return `true` if type is null, `false` otherwise.
 
-    /// get a pointer to the value (string)
-    constexpr const string_t* get_impl_ptr(const string_t*) const noexcept
-    {
-        return is_string() ? m_value.string : nullptr;
-    }
+    @complexity Constant.
 
-    /// get a pointer to the value (boolean)
-    boolean_t* get_impl_ptr(boolean_t*) noexcept
-    {
-        return is_boolean() ? &m_value.boolean : nullptr;
-    }
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    /// get a pointer to the value (boolean)
-    constexpr const boolean_t* get_impl_ptr(const boolean_t*) const noexcept
-    {
-        return is_boolean() ? &m_value.boolean : nullptr;
-    }
+    @liveexample{The following code exemplifies `is_null()` for all JSON
+    types.,is_null}
 
-    /// get a pointer to the value (integer number)
-    number_integer_t* get_impl_ptr(number_integer_t*) noexcept
+    @since version 1.0.0
+    */
+    constexpr bool is_null() const noexcept
     {
-        return is_number_integer() ? &m_value.number_integer : nullptr;
+        return m_type == value_t::null;
     }
 
-    /// get a pointer to the value (integer number)
-    constexpr const number_integer_t* get_impl_ptr(const number_integer_t*) const noexcept
-    {
-        return is_number_integer() ? &m_value.number_integer : nullptr;
-    }
+    /*!
+    @brief return whether value is a boolean
 
-    /// get a pointer to the value (unsigned number)
-    number_unsigned_t* get_impl_ptr(number_unsigned_t*) noexcept
-    {
-        return is_number_unsigned() ? &m_value.number_unsigned : nullptr;
-    }
-
-    /// get a pointer to the value (unsigned number)
-    constexpr const number_unsigned_t* get_impl_ptr(const number_unsigned_t*) const noexcept
-    {
-        return is_number_unsigned() ? &m_value.number_unsigned : nullptr;
-    }
-
-    /// get a pointer to the value (floating-point number)
-    number_float_t* get_impl_ptr(number_float_t*) noexcept
-    {
-        return is_number_float() ? &m_value.number_float : nullptr;
-    }
+    This function returns true iff the JSON value is a boolean.
 
-    /// get a pointer to the value (floating-point number)
-    constexpr const number_float_t* get_impl_ptr(const number_float_t*) const noexcept
-    {
-        return is_number_float() ? &m_value.number_float : nullptr;
-    }
+    @return `true` if type is boolean, `false` otherwise.
 
-    /*!
-    @brief helper function to implement get_ref()
+    @complexity Constant.
 
-    This funcion helps to implement get_ref() without code duplication for
-    const and non-const overloads
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    @tparam ThisType will be deduced as `basic_json` or `const basic_json`
+    @liveexample{The following code exemplifies `is_boolean()` for all JSON
+    types.,is_boolean}
 
-    @throw std::domain_error if ReferenceType does not match underlying value
-    type of the current JSON
+    @since version 1.0.0
     */
-    template<typename ReferenceType, typename ThisType>
-    static ReferenceType get_ref_impl(ThisType& obj)
+    constexpr bool is_boolean() const noexcept
     {
-        // delegate the call to get_ptr<>()
-        using PointerType = typename std::add_pointer<ReferenceType>::type;
-        auto ptr = obj.template get_ptr<PointerType>();
-
-        if (ptr != nullptr)
-        {
-            return *ptr;
-        }
-        else
-        {
-            throw std::domain_error("incompatible ReferenceType for get_ref, actual type is " +
-                                    obj.type_name());
-        }
+        return m_type == value_t::boolean;
     }
 
-  public:
-
-    /// @name value access
-    /// @{
-
     /*!
-    @brief get a value (explicit)
-
-    Explicit type conversion between the JSON value and a compatible value.
-
-    @tparam ValueType non-pointer type compatible to the JSON value, for
-    instance `int` for JSON integer numbers, `bool` for JSON booleans, or
-    `std::vector` types for JSON arrays
+    @brief return whether value is a number
 
-    @return copy of the JSON value, converted to type @a ValueType
+    This function returns true iff the JSON value is a number. This includes
+    both integer and floating-point values.
 
-    @throw std::domain_error in case passed type @a ValueType is incompatible
-    to JSON; example: `"type must be object, but is null"`
+    @return `true` if type is number (regardless whether integer, unsigned
+    integer or floating-type), `false` otherwise.
 
-    @complexity Linear in the size of the JSON value.
+    @complexity Constant.
 
-    @liveexample{The example below shows several conversions from JSON values
-    to other types. There a few things to note: (1) Floating-point numbers can
-    be converted to integers\, (2) A JSON array can be converted to a standard
-    `std::vector<short>`\, (3) A JSON object can be converted to C++
-    associative containers such as `std::unordered_map<std::string\,
-    json>`.,get__ValueType_const}
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    @internal
-    The idea of using a casted null pointer to choose the correct
-    implementation is from <http://stackoverflow.com/a/8315197/266378>.
-    @endinternal
+    @liveexample{The following code exemplifies `is_number()` for all JSON
+    types.,is_number}
 
-    @sa @ref operator ValueType() const for implicit conversion
-    @sa @ref get() for pointer-member access
+    @sa @ref is_number_integer() -- check if value is an integer or unsigned
+    integer number
+    @sa @ref is_number_unsigned() -- check if value is an unsigned integer
+    number
+    @sa @ref is_number_float() -- check if value is a floating-point number
 
     @since version 1.0.0
     */
-    template<typename ValueType, typename
-             std::enable_if<
-                 not std::is_pointer<ValueType>::value
-                 , int>::type = 0>
-    ValueType get() const
+    constexpr bool is_number() const noexcept
     {
-        return get_impl(static_cast<ValueType*>(nullptr));
+        return is_number_integer() or is_number_float();
     }
 
     /*!
-    @brief get a pointer value (explicit)
-
-    Explicit pointer access to the internally stored JSON value. No copies are
-    made.
-
-    @warning The pointer becomes invalid if the underlying JSON object changes.
+    @brief return whether value is an integer number
 
-    @tparam PointerType pointer type; must be a pointer to @ref array_t, @ref
-    object_t, @ref string_t, @ref boolean_t, @ref number_integer_t,
-    @ref number_unsigned_t, or @ref number_float_t.
+    This function returns true iff the JSON value is an integer or unsigned
+    integer number. This excludes floating-point values.
 
-    @return pointer to the internally stored JSON value if the requested
-    pointer type @a PointerType fits to the JSON value; `nullptr` otherwise
+    @return `true` if type is an integer or unsigned integer number, `false`
+    otherwise.
 
     @complexity Constant.
 
-    @liveexample{The example below shows how pointers to internal values of a
-    JSON value can be requested. Note that no type conversions are made and a
-    `nullptr` is returned if the value and the requested pointer type does not
-    match.,get__PointerType}
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    @sa @ref get_ptr() for explicit pointer-member access
+    @liveexample{The following code exemplifies `is_number_integer()` for all
+    JSON types.,is_number_integer}
+
+    @sa @ref is_number() -- check if value is a number
+    @sa @ref is_number_unsigned() -- check if value is an unsigned integer
+    number
+    @sa @ref is_number_float() -- check if value is a floating-point number
 
     @since version 1.0.0
     */
-    template<typename PointerType, typename
-             std::enable_if<
-                 std::is_pointer<PointerType>::value
-                 , int>::type = 0>
-    PointerType get() noexcept
+    constexpr bool is_number_integer() const noexcept
     {
-        // delegate the call to get_ptr
-        return get_ptr<PointerType>();
+        return m_type == value_t::number_integer or m_type == value_t::number_unsigned;
     }
 
     /*!
-    @brief get a pointer value (explicit)
-    @copydoc get()
+    @brief return whether value is an unsigned integer number
+
+    This function returns true iff the JSON value is an unsigned integer
+    number. This excludes floating-point and (signed) integer values.
+
+    @return `true` if type is an unsigned integer number, `false` otherwise.
+
+    @complexity Constant.
+
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
+
+    @liveexample{The following code exemplifies `is_number_unsigned()` for all
+    JSON types.,is_number_unsigned}
+
+    @sa @ref is_number() -- check if value is a number
+    @sa @ref is_number_integer() -- check if value is an integer or unsigned
+    integer number
+    @sa @ref is_number_float() -- check if value is a floating-point number
+
+    @since version 2.0.0
     */
-    template<typename PointerType, typename
-             std::enable_if<
-                 std::is_pointer<PointerType>::value
-                 , int>::type = 0>
-    constexpr const PointerType get() const noexcept
+    constexpr bool is_number_unsigned() const noexcept
     {
-        // delegate the call to get_ptr
-        return get_ptr<PointerType>();
+        return m_type == value_t::number_unsigned;
     }
 
     /*!
-    @brief get a pointer value (implicit)
+    @brief return whether value is a floating-point number
 
-    Implicit pointer access to the internally stored JSON value. No copies are
-    made.
+    This function returns true iff the JSON value is a floating-point number.
+    This excludes integer and unsigned integer values.
 
-    @warning Writing data to the pointee of the result yields an undefined
-    state.
+    @return `true` if type is a floating-point number, `false` otherwise.
 
-    @tparam PointerType pointer type; must be a pointer to @ref array_t, @ref
-    object_t, @ref string_t, @ref boolean_t, @ref number_integer_t,
-    @ref number_unsigned_t, or @ref number_float_t.
+    @complexity Constant.
 
-    @return pointer to the internally stored JSON value if the requested
-    pointer type @a PointerType fits to the JSON value; `nullptr` otherwise
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    @complexity Constant.
+    @liveexample{The following code exemplifies `is_number_float()` for all
+    JSON types.,is_number_float}
 
-    @liveexample{The example below shows how pointers to internal values of a
-    JSON value can be requested. Note that no type conversions are made and a
-    `nullptr` is returned if the value and the requested pointer type does not
-    match.,get_ptr}
+    @sa @ref is_number() -- check if value is number
+    @sa @ref is_number_integer() -- check if value is an integer number
+    @sa @ref is_number_unsigned() -- check if value is an unsigned integer
+    number
 
     @since version 1.0.0
     */
-    template<typename PointerType, typename
-             std::enable_if<
-                 std::is_pointer<PointerType>::value
-                 , int>::type = 0>
-    PointerType get_ptr() noexcept
+    constexpr bool is_number_float() const noexcept
     {
-        // delegate the call to get_impl_ptr<>()
-        return get_impl_ptr(static_cast<PointerType>(nullptr));
+        return m_type == value_t::number_float;
     }
 
     /*!
-    @brief get a pointer value (implicit)
-    @copydoc get_ptr()
+    @brief return whether value is an object
+
+    This function returns true iff the JSON value is an object.
+
+    @return `true` if type is object, `false` otherwise.
+
+    @complexity Constant.
+
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
+
+    @liveexample{The following code exemplifies `is_object()` for all JSON
+    types.,is_object}
+
+    @since version 1.0.0
     */
-    template<typename PointerType, typename
-             std::enable_if<
-                 std::is_pointer<PointerType>::value
-                 and std::is_const<typename std::remove_pointer<PointerType>::type>::value
-                 , int>::type = 0>
-    constexpr const PointerType get_ptr() const noexcept
+    constexpr bool is_object() const noexcept
     {
-        // delegate the call to get_impl_ptr<>() const
-        return get_impl_ptr(static_cast<const PointerType>(nullptr));
+        return m_type == value_t::object;
     }
 
     /*!
-    @brief get a reference value (implicit)
-
-    Implict reference access to the internally stored JSON value. No copies
-    are made.
+    @brief return whether value is an array
 
-    @warning Writing data to the referee of the result yields an undefined
-    state.
+    This function returns true iff the JSON value is an array.
 
-    @tparam ReferenceType reference type; must be a reference to @ref array_t,
-    @ref object_t, @ref string_t, @ref boolean_t, @ref number_integer_t, or
-    @ref number_float_t.
+    @return `true` if type is array, `false` otherwise.
 
-    @return reference to the internally stored JSON value if the requested
-    reference type @a ReferenceType fits to the JSON value; throws
-    std::domain_error otherwise
+    @complexity Constant.
 
-    @throw std::domain_error in case passed type @a ReferenceType is
-    incompatible with the stored JSON value
-
-    @complexity Constant.
-
-    @liveexample{The example shows several calls to `get_ref()`.,get_ref}
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    @since version 1.1.0
-    */
-    template<typename ReferenceType, typename
-             std::enable_if<
-                 std::is_reference<ReferenceType>::value
-                 , int>::type = 0>
-    ReferenceType get_ref()
-    {
-        // delegate call to get_ref_impl
-        return get_ref_impl<ReferenceType>(*this);
-    }
+    @liveexample{The following code exemplifies `is_array()` for all JSON
+    types.,is_array}
 
-    /*!
-    @brief get a reference value (implicit)
-    @copydoc get_ref()
+    @since version 1.0.0
     */
-    template<typename ReferenceType, typename
-             std::enable_if<
-                 std::is_reference<ReferenceType>::value
-                 and std::is_const<typename std::remove_reference<ReferenceType>::type>::value
-                 , int>::type = 0>
-    ReferenceType get_ref() const
+    constexpr bool is_array() const noexcept
     {
-        // delegate call to get_ref_impl
-        return get_ref_impl<ReferenceType>(*this);
+        return m_type == value_t::array;
     }
 
     /*!
-    @brief get a value (implicit)
-
-    Implicit type conversion between the JSON value and a compatible value.
-    The call is realized by calling @ref get() const.
+    @brief return whether value is a string
 
-    @tparam ValueType non-pointer type compatible to the JSON value, for
-    instance `int` for JSON integer numbers, `bool` for JSON booleans, or
-    `std::vector` types for JSON arrays. The character type of @ref string_t
-    as well as an initializer list of this type is excluded to avoid
-    ambiguities as these types implicitly convert to `std::string`.
+    This function returns true iff the JSON value is a string.
 
-    @return copy of the JSON value, converted to type @a ValueType
+    @return `true` if type is string, `false` otherwise.
 
-    @throw std::domain_error in case passed type @a ValueType is incompatible
-    to JSON, thrown by @ref get() const
+    @complexity Constant.
 
-    @complexity Linear in the size of the JSON value.
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
 
-    @liveexample{The example below shows several conversions from JSON values
-    to other types. There a few things to note: (1) Floating-point numbers can
-    be converted to integers\, (2) A JSON array can be converted to a standard
-    `std::vector<short>`\, (3) A JSON object can be converted to C++
-    associative containers such as `std::unordered_map<std::string\,
-    json>`.,operator__ValueType}
+    @liveexample{The following code exemplifies `is_string()` for all JSON
+    types.,is_string}
 
     @since version 1.0.0
     */
-    template < typename ValueType, typename
-               std::enable_if <
-                   not std::is_pointer<ValueType>::value
-                   and not std::is_same<ValueType, typename string_t::value_type>::value
-#ifndef _MSC_VER  // Fix for issue #167 operator<< abiguity under VS2015
-                   and not std::is_same<ValueType, std::initializer_list<typename string_t::value_type>>::value
-#endif
-                   , int >::type = 0 >
-    operator ValueType() const
+    constexpr bool is_string() const noexcept
     {
-        // delegate the call to get<>() const
-        return get<ValueType>();
+        return m_type == value_t::string;
     }
 
-    /// @}
-
-
-    ////////////////////
-    // element access //
-    ////////////////////
-
-    /// @name element access
-    /// @{
-
     /*!
-    @brief access specified array element with bounds checking
-
-    Returns a reference to the element at specified location @a idx, with
-    bounds checking.
+    @brief return whether value is discarded
 
-    @param[in] idx  index of the element to access
+    This function returns true iff the JSON value was discarded during parsing
+    with a callback function (see @ref parser_callback_t).
 
-    @return reference to the element at index @a idx
+    @note This function will always be `false` for JSON values after parsing.
+    That is, discarded values can only occur during parsing, but will be
+    removed when inside a structured value or replaced by null in other cases.
 
-    @throw std::domain_error if the JSON value is not an array; example:
-    `"cannot use at() with string"`
-    @throw std::out_of_range if the index @a idx is out of range of the array;
-    that is, `idx >= size()`; example: `"array index 7 is out of range"`
+    @return `true` if type is discarded, `false` otherwise.
 
     @complexity Constant.
 
-    @liveexample{The example below shows how array elements can be read and
-    written using `at()`.,at__size_type}
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
+
+    @liveexample{The following code exemplifies `is_discarded()` for all JSON
+    types.,is_discarded}
 
     @since version 1.0.0
     */
-    reference at(size_type idx)
+    constexpr bool is_discarded() const noexcept
     {
-        // at only works for arrays
-        if (is_array())
-        {
-            try
-            {
-                assert(m_value.array != nullptr);
-                return m_value.array->at(idx);
-            }
-            catch (std::out_of_range&)
-            {
-                // create better exception explanation
-                throw std::out_of_range("array index " + std::to_string(idx) + " is out of range");
-            }
-        }
-        else
-        {
-            throw std::domain_error("cannot use at() with " + type_name());
-        }
+        return m_type == value_t::discarded;
     }
 
     /*!
-    @brief access specified array element with bounds checking
-
-    Returns a const reference to the element at specified location @a idx,
-    with bounds checking.
-
-    @param[in] idx  index of the element to access
+    @brief return the type of the JSON value (implicit)
 
-    @return const reference to the element at index @a idx
+    Implicitly return the type of the JSON value as a value from the @ref
+    value_t enumeration.
 
-    @throw std::domain_error if the JSON value is not an array; example:
-    `"cannot use at() with string"`
-    @throw std::out_of_range if the index @a idx is out of range of the array;
-    that is, `idx >= size()`; example: `"array index 7 is out of range"`
+    @return the type of the JSON value
 
     @complexity Constant.
 
-    @liveexample{The example below shows how array elements can be read using
-    `at()`.,at__size_type_const}
+    @exceptionsafety No-throw guarantee: this member function never throws
+    exceptions.
+
+    @liveexample{The following code exemplifies the @ref value_t operator for
+    all JSON types.,operator__value_t}
 
     @since version 1.0.0
     */
-    const_reference at(size_type idx) const
+    constexpr operator value_t() const noexcept
     {
-        // at only works for arrays
-        if (is_array())
-        {
-            try
-            {
-                assert(m_value.array != nullptr);
-                return m_value.array->at(idx);
-            }
-            catch (std::out_of_range&)
-            {
-                // create better exception explanation
-                throw std::out_of_range("array index " + std::to_string(idx) + " is out of range");
-            }
-        }
-        else
-        {
-            throw std::domain_error("cannot use at() with " + type_name());
-        }
+        return m_type;
     }
 
-    /*!
-    @brief access specified object element with bounds checking
-
-    Returns a reference to the element at with specified key @a key, with
-    bounds checking.
-
-    @param[in] key  key of the element to access
-
-    @return reference to the element at key @a key
-
-    @throw std::domain_error if the JSON value is not an object; example:
-    `"cannot use at() with boolean"`
-    @throw std::out_of_range if the key @a key is is not stored in the object;
-    that is, `find(key) == end()`; example: `"key "the fast" not found"`
-
-    @complexity Logarithmic in the size of the container.
-
-    @liveexample{The example below shows how object elements can be read and
-    written using `at()`.,at__object_t_key_type}
+    /// @}
 
-    @sa @ref operator[](const typename object_t::key_type&) for unchecked
-    access by reference
-    @sa @ref value() for access by value with a default value
+  private:
+    //////////////////
+    // value access //
+    //////////////////
 
-    @since version 1.0.0
-    */
-    reference at(const typename object_t::key_type& key)
+    /// get an object (explicit)
+    template <class T, typename
+              std::enable_if<
+                  std::is_convertible<typename object_t::key_type, typename T::key_type>::value and
+                  std::is_convertible<basic_json_t, typename T::mapped_type>::value
+                  , int>::type = 0>
+    T get_impl(T*) const
     {
-        // at only works for objects
         if (is_object())
         {
-            try
-            {
-                assert(m_value.object != nullptr);
-                return m_value.object->at(key);
-            }
-            catch (std::out_of_range&)
-            {
-                // create better exception explanation
-                throw std::out_of_range("key '" + key + "' not found");
-            }
+            assert(m_value.object != nullptr);
+            return T(m_value.object->begin(), m_value.object->end());
         }
         else
         {
-            throw std::domain_error("cannot use at() with " + type_name());
+            throw std::domain_error("type must be object, but is " + type_name());
         }
     }
 
-    /*!
-    @brief access specified object element with bounds checking
-
-    Returns a const reference to the element at with specified key @a key,
-    with bounds checking.
-
-    @param[in] key  key of the element to access
-
-    @return const reference to the element at key @a key
-
-    @throw std::domain_error if the JSON value is not an object; example:
-    `"cannot use at() with boolean"`
-    @throw std::out_of_range if the key @a key is is not stored in the object;
-    that is, `find(key) == end()`; example: `"key "the fast" not found"`
-
-    @complexity Logarithmic in the size of the container.
-
-    @liveexample{The example below shows how object elements can be read using
-    `at()`.,at__object_t_key_type_const}
-
-    @sa @ref operator[](const typename object_t::key_type&) for unchecked
-    access by reference
-    @sa @ref value() for access by value with a default value
-
-    @since version 1.0.0
-    */
-    const_reference at(const typename object_t::key_type& key) const
+    /// get an object (explicit)
+    object_t get_impl(object_t*) const
     {
-        // at only works for objects
         if (is_object())
         {
-            try
-            {
-                assert(m_value.object != nullptr);
-                return m_value.object->at(key);
-            }
-            catch (std::out_of_range&)
-            {
-                // create better exception explanation
-                throw std::out_of_range("key '" + key + "' not found");
-            }
+            assert(m_value.object != nullptr);
+            return *(m_value.object);
         }
         else
         {
-            throw std::domain_error("cannot use at() with " + type_name());
+            throw std::domain_error("type must be object, but is " + type_name());
         }
     }
 
-    /*!
-    @brief access specified array element
-
-    Returns a reference to the element at specified location @a idx.
-
-    @note If @a idx is beyond the range of the array (i.e., `idx >= size()`),
-    then the array is silently filled up with `null` values to make `idx` a
-    valid reference to the last stored element.
-
-    @param[in] idx  index of the element to access
-
-    @return reference to the element at index @a idx
-
-    @throw std::domain_error if JSON is not an array or null; example:
-    `"cannot use operator[] with string"`
-
-    @complexity Constant if @a idx is in the range of the array. Otherwise
-    linear in `idx - size()`.
-
-    @liveexample{The example below shows how array elements can be read and
-    written using `[]` operator. Note the addition of `null`
-    values.,operatorarray__size_type}
-
-    @since version 1.0.0
-    */
-    reference operator[](size_type idx)
+    /// get an array (explicit)
+    template <class T, typename
+              std::enable_if<
+                  std::is_convertible<basic_json_t, typename T::value_type>::value and
+                  not std::is_same<basic_json_t, typename T::value_type>::value and
+                  not std::is_arithmetic<T>::value and
+                  not std::is_convertible<std::string, T>::value and
+                  not has_mapped_type<T>::value
+                  , int>::type = 0>
+    T get_impl(T*) const
     {
-        // implicitly convert null value to an empty array
-        if (is_null())
-        {
-            m_type = value_t::array;
-            m_value.array = create<array_t>();
-        }
-
-        // operator[] only works for arrays
         if (is_array())
         {
-            // fill up array with null values until given idx is reached
+            T to_vector;
             assert(m_value.array != nullptr);
-            for (size_t i = m_value.array->size(); i <= idx; ++i)
+            std::transform(m_value.array->begin(), m_value.array->end(),
+                           std::inserter(to_vector, to_vector.end()), [](basic_json i)
             {
-                m_value.array->push_back(basic_json());
-            }
-
-            return m_value.array->operator[](idx);
+                return i.get<typename T::value_type>();
+            });
+            return to_vector;
         }
         else
         {
-            throw std::domain_error("cannot use operator[] with " + type_name());
+            throw std::domain_error("type must be array, but is " + type_name());
         }
     }
 
-    /*!
-    @brief access specified array element
-
-    Returns a const reference to the element at specified location @a idx.
-
-    @param[in] idx  index of the element to access
-
-    @return const reference to the element at index @a idx
-
-    @throw std::domain_error if JSON is not an array; example: `"cannot use
-    operator[] with null"`
-
-    @complexity Constant.
-
-    @liveexample{The example below shows how array elements can be read using
-    the `[]` operator.,operatorarray__size_type_const}
-
-    @since version 1.0.0
-    */
-    const_reference operator[](size_type idx) const
+    /// get an array (explicit)
+    template <class T, typename
+              std::enable_if<
+                  std::is_convertible<basic_json_t, T>::value and
+                  not std::is_same<basic_json_t, T>::value
+                  , int>::type = 0>
+    std::vector<T> get_impl(std::vector<T>*) const
     {
-        // const operator[] only works for arrays
         if (is_array())
         {
+            std::vector<T> to_vector;
             assert(m_value.array != nullptr);
-            return m_value.array->operator[](idx);
+            to_vector.reserve(m_value.array->size());
+            std::transform(m_value.array->begin(), m_value.array->end(),
+                           std::inserter(to_vector, to_vector.end()), [](basic_json i)
+            {
+                return i.get<T>();
+            });
+            return to_vector;
         }
         else
         {
-            throw std::domain_error("cannot use operator[] with " + type_name());
+            throw std::domain_error("type must be array, but is " + type_name());
         }
     }
 
-    /*!
-    @brief access specified object element
-
-    Returns a reference to the element at with specified key @a key.
-
-    @note If @a key is not found in the object, then it is silently added to
-    the object and filled with a `null` value to make `key` a valid reference.
-    In case the value was `null` before, it is converted to an object.
-
-    @param[in] key  key of the element to access
-
-    @return reference to the element at key @a key
-
-    @throw std::domain_error if JSON is not an object or null; example:
-    `"cannot use operator[] with string"`
-
-    @complexity Logarithmic in the size of the container.
-
-    @liveexample{The example below shows how object elements can be read and
-    written using the `[]` operator.,operatorarray__key_type}
-
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref value() for access by value with a default value
-
-    @since version 1.0.0
-    */
-    reference operator[](const typename object_t::key_type& key)
+    /// get an array (explicit)
+    template <class T, typename
+              std::enable_if<
+                  std::is_same<basic_json, typename T::value_type>::value and
+                  not has_mapped_type<T>::value
+                  , int>::type = 0>
+    T get_impl(T*) const
     {
-        // implicitly convert null value to an empty object
-        if (is_null())
+        if (is_array())
         {
-            m_type = value_t::object;
-            m_value.object = create<object_t>();
+            assert(m_value.array != nullptr);
+            return T(m_value.array->begin(), m_value.array->end());
         }
+        else
+        {
+            throw std::domain_error("type must be array, but is " + type_name());
+        }
+    }
 
-        // operator[] only works for objects
-        if (is_object())
+    /// get an array (explicit)
+    array_t get_impl(array_t*) const
+    {
+        if (is_array())
         {
-            assert(m_value.object != nullptr);
-            return m_value.object->operator[](key);
+            assert(m_value.array != nullptr);
+            return *(m_value.array);
         }
         else
         {
-            throw std::domain_error("cannot use operator[] with " + type_name());
+            throw std::domain_error("type must be array, but is " + type_name());
         }
     }
 
-    /*!
-    @brief read-only access specified object element
-
-    Returns a const reference to the element at with specified key @a key. No
-    bounds checking is performed.
-
-    @warning If the element with key @a key does not exist, the behavior is
-    undefined.
-
-    @param[in] key  key of the element to access
-
-    @return const reference to the element at key @a key
-
-    @throw std::domain_error if JSON is not an object; example: `"cannot use
-    operator[] with null"`
-
-    @complexity Logarithmic in the size of the container.
-
-    @liveexample{The example below shows how object elements can be read using
-    the `[]` operator.,operatorarray__key_type_const}
-
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref value() for access by value with a default value
-
-    @since version 1.0.0
-    */
-    const_reference operator[](const typename object_t::key_type& key) const
+    /// get a string (explicit)
+    template <typename T, typename
+              std::enable_if<
+                  std::is_convertible<string_t, T>::value
+                  , int>::type = 0>
+    T get_impl(T*) const
     {
-        // const operator[] only works for objects
-        if (is_object())
+        if (is_string())
         {
-            assert(m_value.object != nullptr);
-            assert(m_value.object->find(key) != m_value.object->end());
-            return m_value.object->find(key)->second;
+            assert(m_value.string != nullptr);
+            return *m_value.string;
         }
         else
         {
-            throw std::domain_error("cannot use operator[] with " + type_name());
+            throw std::domain_error("type must be string, but is " + type_name());
         }
     }
 
-    /*!
-    @brief access specified object element
+    /// get a number (explicit)
+    template<typename T, typename
+             std::enable_if<
+                 std::is_arithmetic<T>::value
+                 , int>::type = 0>
+    T get_impl(T*) const
+    {
+        switch (m_type)
+        {
+            case value_t::number_integer:
+            {
+                return static_cast<T>(m_value.number_integer);
+            }
 
-    Returns a reference to the element at with specified key @a key.
+            case value_t::number_unsigned:
+            {
+                return static_cast<T>(m_value.number_unsigned);
+            }
 
-    @note If @a key is not found in the object, then it is silently added to
-    the object and filled with a `null` value to make `key` a valid reference.
-    In case the value was `null` before, it is converted to an object.
+            case value_t::number_float:
+            {
+                return static_cast<T>(m_value.number_float);
+            }
 
-    @param[in] key  key of the element to access
+            default:
+            {
+                throw std::domain_error("type must be number, but is " + type_name());
+            }
+        }
+    }
 
-    @return reference to the element at key @a key
+    /// get a boolean (explicit)
+    constexpr boolean_t get_impl(boolean_t*) const
+    {
+        return is_boolean()
+               ? m_value.boolean
+               : throw std::domain_error("type must be boolean, but is " + type_name());
+    }
 
-    @throw std::domain_error if JSON is not an object or null; example:
-    `"cannot use operator[] with string"`
-
-    @complexity Logarithmic in the size of the container.
-
-    @liveexample{The example below shows how object elements can be read and
-    written using the `[]` operator.,operatorarray__key_type}
+    /// get a pointer to the value (object)
+    object_t* get_impl_ptr(object_t*) noexcept
+    {
+        return is_object() ? m_value.object : nullptr;
+    }
 
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref value() for access by value with a default value
+    /// get a pointer to the value (object)
+    constexpr const object_t* get_impl_ptr(const object_t*) const noexcept
+    {
+        return is_object() ? m_value.object : nullptr;
+    }
 
-    @since version 1.0.0
-    */
-    template<typename T, std::size_t n>
-    reference operator[](T * (&key)[n])
+    /// get a pointer to the value (array)
+    array_t* get_impl_ptr(array_t*) noexcept
     {
-        return operator[](static_cast<const T>(key));
+        return is_array() ? m_value.array : nullptr;
     }
 
-    /*!
-    @brief read-only access specified object element
+    /// get a pointer to the value (array)
+    constexpr const array_t* get_impl_ptr(const array_t*) const noexcept
+    {
+        return is_array() ? m_value.array : nullptr;
+    }
 
-    Returns a const reference to the element at with specified key @a key. No
-    bounds checking is performed.
+    /// get a pointer to the value (string)
+    string_t* get_impl_ptr(string_t*) noexcept
+    {
+        return is_string() ? m_value.string : nullptr;
+    }
 
-    @warning If the element with key @a key does not exist, the behavior is
-    undefined.
+    /// get a pointer to the value (string)
+    constexpr const string_t* get_impl_ptr(const string_t*) const noexcept
+    {
+        return is_string() ? m_value.string : nullptr;
+    }
 
-    @note This function is required for compatibility reasons with Clang.
+    /// get a pointer to the value (boolean)
+    boolean_t* get_impl_ptr(boolean_t*) noexcept
+    {
+        return is_boolean() ? &m_value.boolean : nullptr;
+    }
 
-    @param[in] key  key of the element to access
+    /// get a pointer to the value (boolean)
+    constexpr const boolean_t* get_impl_ptr(const boolean_t*) const noexcept
+    {
+        return is_boolean() ? &m_value.boolean : nullptr;
+    }
 
-    @return const reference to the element at key @a key
+    /// get a pointer to the value (integer number)
+    number_integer_t* get_impl_ptr(number_integer_t*) noexcept
+    {
+        return is_number_integer() ? &m_value.number_integer : nullptr;
+    }
 
-    @throw std::domain_error if JSON is not an object; example: `"cannot use
-    operator[] with null"`
+    /// get a pointer to the value (integer number)
+    constexpr const number_integer_t* get_impl_ptr(const number_integer_t*) const noexcept
+    {
+        return is_number_integer() ? &m_value.number_integer : nullptr;
+    }
 
-    @complexity Logarithmic in the size of the container.
+    /// get a pointer to the value (unsigned number)
+    number_unsigned_t* get_impl_ptr(number_unsigned_t*) noexcept
+    {
+        return is_number_unsigned() ? &m_value.number_unsigned : nullptr;
+    }
 
-    @liveexample{The example below shows how object elements can be read using
-    the `[]` operator.,operatorarray__key_type_const}
+    /// get a pointer to the value (unsigned number)
+    constexpr const number_unsigned_t* get_impl_ptr(const number_unsigned_t*) const noexcept
+    {
+        return is_number_unsigned() ? &m_value.number_unsigned : nullptr;
+    }
 
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref value() for access by value with a default value
+    /// get a pointer to the value (floating-point number)
+    number_float_t* get_impl_ptr(number_float_t*) noexcept
+    {
+        return is_number_float() ? &m_value.number_float : nullptr;
+    }
 
-    @since version 1.0.0
-    */
-    template<typename T, std::size_t n>
-    const_reference operator[](T * (&key)[n]) const
+    /// get a pointer to the value (floating-point number)
+    constexpr const number_float_t* get_impl_ptr(const number_float_t*) const noexcept
     {
-        return operator[](static_cast<const T>(key));
+        return is_number_float() ? &m_value.number_float : nullptr;
     }
 
     /*!
-    @brief access specified object element
-
-    Returns a reference to the element at with specified key @a key.
-
-    @note If @a key is not found in the object, then it is silently added to
-    the object and filled with a `null` value to make `key` a valid reference.
-    In case the value was `null` before, it is converted to an object.
-
-    @param[in] key  key of the element to access
-
-    @return reference to the element at key @a key
-
-    @throw std::domain_error if JSON is not an object or null; example:
-    `"cannot use operator[] with string"`
-
-    @complexity Logarithmic in the size of the container.
+    @brief helper function to implement get_ref()
 
-    @liveexample{The example below shows how object elements can be read and
-    written using the `[]` operator.,operatorarray__key_type}
+    This funcion helps to implement get_ref() without code duplication for
+    const and non-const overloads
 
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref value() for access by value with a default value
+    @tparam ThisType will be deduced as `basic_json` or `const basic_json`
 
-    @since version 1.1.0
+    @throw std::domain_error if ReferenceType does not match underlying value
+    type of the current JSON
     */
-    template<typename T>
-    reference operator[](T* key)
+    template<typename ReferenceType, typename ThisType>
+    static ReferenceType get_ref_impl(ThisType& obj)
     {
-        // implicitly convert null to object
-        if (is_null())
-        {
-            m_type = value_t::object;
-            m_value = value_t::object;
-        }
+        // delegate the call to get_ptr<>()
+        using PointerType = typename std::add_pointer<ReferenceType>::type;
+        auto ptr = obj.template get_ptr<PointerType>();
 
-        // at only works for objects
-        if (is_object())
+        if (ptr != nullptr)
         {
-            assert(m_value.object != nullptr);
-            return m_value.object->operator[](key);
+            return *ptr;
         }
         else
         {
-            throw std::domain_error("cannot use operator[] with " + type_name());
+            throw std::domain_error("incompatible ReferenceType for get_ref, actual type is " +
+                                    obj.type_name());
         }
     }
 
+  public:
+
+    /// @name value access
+    /// @{
+
     /*!
-    @brief read-only access specified object element
+    @brief get a value (explicit)
 
-    Returns a const reference to the element at with specified key @a key. No
-    bounds checking is performed.
+    Explicit type conversion between the JSON value and a compatible value.
 
-    @warning If the element with key @a key does not exist, the behavior is
-    undefined.
+    @tparam ValueType non-pointer type compatible to the JSON value, for
+    instance `int` for JSON integer numbers, `bool` for JSON booleans, or
+    `std::vector` types for JSON arrays
 
-    @param[in] key  key of the element to access
+    @return copy of the JSON value, converted to type @a ValueType
 
-    @return const reference to the element at key @a key
+    @throw std::domain_error in case passed type @a ValueType is incompatible
+    to JSON; example: `"type must be object, but is null"`
 
-    @throw std::domain_error if JSON is not an object; example: `"cannot use
-    operator[] with null"`
+    @complexity Linear in the size of the JSON value.
 
-    @complexity Logarithmic in the size of the container.
+    @liveexample{The example below shows several conversions from JSON values
+    to other types. There a few things to note: (1) Floating-point numbers can
+    be converted to integers\, (2) A JSON array can be converted to a standard
+    `std::vector<short>`\, (3) A JSON object can be converted to C++
+    associative containers such as `std::unordered_map<std::string\,
+    json>`.,get__ValueType_const}
 
-    @liveexample{The example below shows how object elements can be read using
-    the `[]` operator.,operatorarray__key_type_const}
+    @internal
+    The idea of using a casted null pointer to choose the correct
+    implementation is from <http://stackoverflow.com/a/8315197/266378>.
+    @endinternal
 
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref value() for access by value with a default value
+    @sa @ref operator ValueType() const for implicit conversion
+    @sa @ref get() for pointer-member access
 
-    @since version 1.1.0
+    @since version 1.0.0
     */
-    template<typename T>
-    const_reference operator[](T* key) const
+    template<typename ValueType, typename
+             std::enable_if<
+                 not std::is_pointer<ValueType>::value
+                 , int>::type = 0>
+    ValueType get() const
     {
-        // at only works for objects
-        if (is_object())
-        {
-            assert(m_value.object != nullptr);
-            assert(m_value.object->find(key) != m_value.object->end());
-            return m_value.object->find(key)->second;
-        }
-        else
-        {
-            throw std::domain_error("cannot use operator[] with " + type_name());
-        }
+        return get_impl(static_cast<ValueType*>(nullptr));
     }
 
     /*!
-    @brief access specified object element with default value
-
-    Returns either a copy of an object's element at the specified key @a key or
-    a given default value if no element with key @a key exists.
+    @brief get a pointer value (explicit)
 
-    The function is basically equivalent to executing
-    @code {.cpp}
-    try {
-        return at(key);
-    } catch(std::out_of_range) {
-        return default_value;
-    }
-    @endcode
+    Explicit pointer access to the internally stored JSON value. No copies are
+    made.
 
-    @note Unlike @ref at(const typename object_t::key_type&), this function
-    does not throw if the given key @a key was not found.
+    @warning The pointer becomes invalid if the underlying JSON object changes.
 
-    @note Unlike @ref operator[](const typename object_t::key_type& key), this
-    function does not implicitly add an element to the position defined by @a
-    key. This function is furthermore also applicable to const objects.
+    @tparam PointerType pointer type; must be a pointer to @ref array_t, @ref
+    object_t, @ref string_t, @ref boolean_t, @ref number_integer_t,
+    @ref number_unsigned_t, or @ref number_float_t.
 
-    @param[in] key  key of the element to access
-    @param[in] default_value  the value to return if @a key is not found
+    @return pointer to the internally stored JSON value if the requested
+    pointer type @a PointerType fits to the JSON value; `nullptr` otherwise
 
-    @tparam ValueType type compatible to JSON values, for instance `int` for
-    JSON integer numbers, `bool` for JSON booleans, or `std::vector` types for
-    JSON arrays. Note the type of the expected value at @a key and the default
-    value @a default_value must be compatible.
+    @complexity Constant.
 
-    @return copy of the element at key @a key or @a default_value if @a key
-    is not found
+    @liveexample{The example below shows how pointers to internal values of a
+    JSON value can be requested. Note that no type conversions are made and a
+    `nullptr` is returned if the value and the requested pointer type does not
+    match.,get__PointerType}
 
-    @throw std::domain_error if JSON is not an object; example: `"cannot use
-    value() with null"`
-
-    @complexity Logarithmic in the size of the container.
-
-    @liveexample{The example below shows how object elements can be queried
-    with a default value.,basic_json__value}
-
-    @sa @ref at(const typename object_t::key_type&) for access by reference
-    with range checking
-    @sa @ref operator[](const typename object_t::key_type&) for unchecked
-    access by reference
+    @sa @ref get_ptr() for explicit pointer-member access
 
     @since version 1.0.0
     */
-    template <class ValueType, typename
-              std::enable_if<
-                  std::is_convertible<basic_json_t, ValueType>::value
-                  , int>::type = 0>
-    ValueType value(const typename object_t::key_type& key, ValueType default_value) const
+    template<typename PointerType, typename
+             std::enable_if<
+                 std::is_pointer<PointerType>::value
+                 , int>::type = 0>
+    PointerType get() noexcept
     {
-        // at only works for objects
-        if (is_object())
-        {
-            // if key is found, return value and given default value otherwise
-            const auto it = find(key);
-            if (it != end())
-            {
-                return *it;
-            }
-            else
-            {
-                return default_value;
-            }
-        }
-        else
-        {
-            throw std::domain_error("cannot use value() with " + type_name());
-        }
+        // delegate the call to get_ptr
+        return get_ptr<PointerType>();
     }
 
     /*!
-    @brief overload for a default value of type const char*
-    @copydoc basic_json::value()
+    @brief get a pointer value (explicit)
+    @copydoc get()
     */
-    string_t value(const typename object_t::key_type& key, const char* default_value) const
+    template<typename PointerType, typename
+             std::enable_if<
+                 std::is_pointer<PointerType>::value
+                 , int>::type = 0>
+    constexpr const PointerType get() const noexcept
     {
-        return value(key, string_t(default_value));
+        // delegate the call to get_ptr
+        return get_ptr<PointerType>();
     }
 
     /*!
-    @brief access the first element
-
-    Returns a reference to the first element in the container. For a JSON
-    container `c`, the expression `c.front()` is equivalent to `*c.begin()`.
+    @brief get a pointer value (implicit)
 
-    @return In case of a structured type (array or object), a reference to the
-    first element is returned. In cast of number, string, or boolean values, a
-    reference to the value is returned.
+    Implicit pointer access to the internally stored JSON value. No copies are
+    made.
 
-    @complexity Constant.
+    @warning Writing data to the pointee of the result yields an undefined
+    state.
 
-    @pre The JSON value must not be `null` (would throw `std::out_of_range`)
-    or an empty array or object (undefined behavior, guarded by assertions).
-    @post The JSON value remains unchanged.
+    @tparam PointerType pointer type; must be a pointer to @ref array_t, @ref
+    object_t, @ref string_t, @ref boolean_t, @ref number_integer_t,
+    @ref number_unsigned_t, or @ref number_float_t.
 
-    @throw std::out_of_range when called on `null` value
+    @return pointer to the internally stored JSON value if the requested
+    pointer type @a PointerType fits to the JSON value; `nullptr` otherwise
 
-    @liveexample{The following code shows an example for `front()`.,front}
+    @complexity Constant.
 
-    @sa @ref back() -- access the last element
+    @liveexample{The example below shows how pointers to internal values of a
+    JSON value can be requested. Note that no type conversions are made and a
+    `nullptr` is returned if the value and the requested pointer type does not
+    match.,get_ptr}
 
     @since version 1.0.0
     */
-    reference front()
+    template<typename PointerType, typename
+             std::enable_if<
+                 std::is_pointer<PointerType>::value
+                 , int>::type = 0>
+    PointerType get_ptr() noexcept
     {
-        return *begin();
+        // delegate the call to get_impl_ptr<>()
+        return get_impl_ptr(static_cast<PointerType>(nullptr));
     }
 
     /*!
-    @copydoc basic_json::front()
+    @brief get a pointer value (implicit)
+    @copydoc get_ptr()
     */
-    const_reference front() const
+    template<typename PointerType, typename
+             std::enable_if<
+                 std::is_pointer<PointerType>::value
+                 and std::is_const<typename std::remove_pointer<PointerType>::type>::value
+                 , int>::type = 0>
+    constexpr const PointerType get_ptr() const noexcept
     {
-        return *cbegin();
+        // delegate the call to get_impl_ptr<>() const
+        return get_impl_ptr(static_cast<const PointerType>(nullptr));
     }
 
     /*!
-    @brief access the last element
+    @brief get a reference value (implicit)
 
-    Returns a reference to the last element in the container. For a JSON
-    container `c`, the expression `c.back()` is equivalent to
-    @code {.cpp}
-    auto tmp = c.end();
-    --tmp;
-    return *tmp;
-    @endcode
+    Implict reference access to the internally stored JSON value. No copies
+    are made.
 
-    @return In case of a structured type (array or object), a reference to the
-    last element is returned. In cast of number, string, or boolean values, a
-    reference to the value is returned.
+    @warning Writing data to the referee of the result yields an undefined
+    state.
 
-    @complexity Constant.
+    @tparam ReferenceType reference type; must be a reference to @ref array_t,
+    @ref object_t, @ref string_t, @ref boolean_t, @ref number_integer_t, or
+    @ref number_float_t.
 
-    @pre The JSON value must not be `null` (would throw `std::out_of_range`)
-    or an empty array or object (undefined behavior, guarded by assertions).
-    @post The JSON value remains unchanged.
+    @return reference to the internally stored JSON value if the requested
+    reference type @a ReferenceType fits to the JSON value; throws
+    std::domain_error otherwise
 
-    @throw std::out_of_range when called on `null` value.
+    @throw std::domain_error in case passed type @a ReferenceType is
+    incompatible with the stored JSON value
 
-    @liveexample{The following code shows an example for `back()`.,back}
+    @complexity Constant.
 
-    @sa @ref front() -- access the first element
+    @liveexample{The example shows several calls to `get_ref()`.,get_ref}
 
-    @since version 1.0.0
+    @since version 1.1.0
     */
-    reference back()
+    template<typename ReferenceType, typename
+             std::enable_if<
+                 std::is_reference<ReferenceType>::value
+                 , int>::type = 0>
+    ReferenceType get_ref()
     {
-        auto tmp = end();
-        --tmp;
-        return *tmp;
+        // delegate call to get_ref_impl
+        return get_ref_impl<ReferenceType>(*this);
     }
 
     /*!
-    @copydoc basic_json::back()
+    @brief get a reference value (implicit)
+    @copydoc get_ref()
     */
-    const_reference back() const
+    template<typename ReferenceType, typename
+             std::enable_if<
+                 std::is_reference<ReferenceType>::value
+                 and std::is_const<typename std::remove_reference<ReferenceType>::type>::value
+                 , int>::type = 0>
+    ReferenceType get_ref() const
     {
-        auto tmp = cend();
-        --tmp;
-        return *tmp;
+        // delegate call to get_ref_impl
+        return get_ref_impl<ReferenceType>(*this);
     }
 
     /*!
-    @brief remove element given an iterator
-
-    Removes the element specified by iterator @a pos. The iterator @a pos must
-    be valid and dereferenceable. Thus the `end()` iterator (which is valid,
-    but is not dereferenceable) cannot be used as a value for @a pos.
-
-    If called on a primitive type other than `null`, the resulting JSON value
-    will be `null`.
-
-    @param[in] pos iterator to the element to remove
-    @return Iterator following the last removed element. If the iterator @a
-    pos refers to the last element, the `end()` iterator is returned.
+    @brief get a value (implicit)
 
-    @tparam InteratorType an @ref iterator or @ref const_iterator
+    Implicit type conversion between the JSON value and a compatible value.
+    The call is realized by calling @ref get() const.
 
-    @post Invalidates iterators and references at or after the point of the
-    erase, including the `end()` iterator.
+    @tparam ValueType non-pointer type compatible to the JSON value, for
+    instance `int` for JSON integer numbers, `bool` for JSON booleans, or
+    `std::vector` types for JSON arrays. The character type of @ref string_t
+    as well as an initializer list of this type is excluded to avoid
+    ambiguities as these types implicitly convert to `std::string`.
 
-    @throw std::domain_error if called on a `null` value; example: `"cannot
-    use erase() with null"`
-    @throw std::domain_error if called on an iterator which does not belong to
-    the current JSON value; example: `"iterator does not fit current value"`
-    @throw std::out_of_range if called on a primitive type with invalid
-    iterator (i.e., any iterator which is not `begin()`); example: `"iterator
-    out of range"`
+    @return copy of the JSON value, converted to type @a ValueType
 
-    @complexity The complexity depends on the type:
-    - objects: amortized constant
-    - arrays: linear in distance between pos and the end of the container
-    - strings: linear in the length of the string
-    - other types: constant
+    @throw std::domain_error in case passed type @a ValueType is incompatible
+    to JSON, thrown by @ref get() const
 
-    @liveexample{The example shows the result of `erase()` for different JSON
-    types.,erase__IteratorType}
+    @complexity Linear in the size of the JSON value.
 
-    @sa @ref erase(InteratorType, InteratorType) -- removes the elements in
-    the given range
-    @sa @ref erase(const typename object_t::key_type&) -- removes the element
-    from an object at the given key
-    @sa @ref erase(const size_type) -- removes the element from an array at
-    the given index
+    @liveexample{The example below shows several conversions from JSON values
+    to other types. There a few things to note: (1) Floating-point numbers can
+    be converted to integers\, (2) A JSON array can be converted to a standard
+    `std::vector<short>`\, (3) A JSON object can be converted to C++
+    associative containers such as `std::unordered_map<std::string\,
+    json>`.,operator__ValueType}
 
     @since version 1.0.0
     */
-    template <class InteratorType, typename
-              std::enable_if<
-                  std::is_same<InteratorType, typename basic_json_t::iterator>::value or
-                  std::is_same<InteratorType, typename basic_json_t::const_iterator>::value
-                  , int>::type
-              = 0>
-    InteratorType erase(InteratorType pos)
+    template < typename ValueType, typename
+               std::enable_if <
+                   not std::is_pointer<ValueType>::value
+                   and not std::is_same<ValueType, typename string_t::value_type>::value
+#ifndef _MSC_VER  // Fix for issue #167 operator<< abiguity under VS2015
+                   and not std::is_same<ValueType, std::initializer_list<typename string_t::value_type>>::value
+#endif
+                   , int >::type = 0 >
+    operator ValueType() const
     {
-        // make sure iterator fits the current value
-        if (this != pos.m_object)
-        {
-            throw std::domain_error("iterator does not fit current value");
-        }
+        // delegate the call to get<>() const
+        return get<ValueType>();
+    }
 
-        InteratorType result = end();
+    /// @}
 
-        switch (m_type)
-        {
-            case value_t::boolean:
-            case value_t::number_float:
-            case value_t::number_integer:
-            case value_t::number_unsigned:
-            case value_t::string:
-            {
-                if (not pos.m_it.primitive_iterator.is_begin())
-                {
-                    throw std::out_of_range("iterator out of range");
-                }
 
-                if (is_string())
-                {
-                    delete m_value.string;
-                    m_value.string = nullptr;
-                }
-
-                m_type = value_t::null;
-                break;
-            }
-
-            case value_t::object:
-            {
-                assert(m_value.object != nullptr);
-                result.m_it.object_iterator = m_value.object->erase(pos.m_it.object_iterator);
-                break;
-            }
-
-            case value_t::array:
-            {
-                assert(m_value.array != nullptr);
-                result.m_it.array_iterator = m_value.array->erase(pos.m_it.array_iterator);
-                break;
-            }
-
-            default:
-            {
-                throw std::domain_error("cannot use erase() with " + type_name());
-            }
-        }
+    ////////////////////
+    // element access //
+    ////////////////////
 
-        return result;
-    }
+    /// @name element access
+    /// @{
 
     /*!
-    @brief remove elements given an iterator range
-
-    Removes the element specified by the range `[first; last)`. The iterator
-    @a first does not need to be dereferenceable if `first == last`: erasing
-    an empty range is a no-op.
-
-    If called on a primitive type other than `null`, the resulting JSON value
-    will be `null`.
-
-    @param[in] first iterator to the beginning of the range to remove
-    @param[in] last iterator past the end of the range to remove
-    @return Iterator following the last removed element. If the iterator @a
-    second refers to the last element, the `end()` iterator is returned.
+    @brief access specified array element with bounds checking
 
-    @tparam InteratorType an @ref iterator or @ref const_iterator
+    Returns a reference to the element at specified location @a idx, with
+    bounds checking.
 
-    @post Invalidates iterators and references at or after the point of the
-    erase, including the `end()` iterator.
+    @param[in] idx  index of the element to access
 
-    @throw std::domain_error if called on a `null` value; example: `"cannot
-    use erase() with null"`
-    @throw std::domain_error if called on iterators which does not belong to
-    the current JSON value; example: `"iterators do not fit current value"`
-    @throw std::out_of_range if called on a primitive type with invalid
-    iterators (i.e., if `first != begin()` and `last != end()`); example:
-    `"iterators out of range"`
+    @return reference to the element at index @a idx
 
-    @complexity The complexity depends on the type:
-    - objects: `log(size()) + std::distance(first, last)`
-    - arrays: linear in the distance between @a first and @a last, plus linear
-      in the distance between @a last and end of the container
-    - strings: linear in the length of the string
-    - other types: constant
+    @throw std::domain_error if the JSON value is not an array; example:
+    `"cannot use at() with string"`
+    @throw std::out_of_range if the index @a idx is out of range of the array;
+    that is, `idx >= size()`; example: `"array index 7 is out of range"`
 
-    @liveexample{The example shows the result of `erase()` for different JSON
-    types.,erase__IteratorType_IteratorType}
+    @complexity Constant.
 
-    @sa @ref erase(InteratorType) -- removes the element at a given position
-    @sa @ref erase(const typename object_t::key_type&) -- removes the element
-    from an object at the given key
-    @sa @ref erase(const size_type) -- removes the element from an array at
-    the given index
+    @liveexample{The example below shows how array elements can be read and
+    written using `at()`.,at__size_type}
 
     @since version 1.0.0
     */
-    template <class InteratorType, typename
-              std::enable_if<
-                  std::is_same<InteratorType, typename basic_json_t::iterator>::value or
-                  std::is_same<InteratorType, typename basic_json_t::const_iterator>::value
-                  , int>::type
-              = 0>
-    InteratorType erase(InteratorType first, InteratorType last)
+    reference at(size_type idx)
     {
-        // make sure iterator fits the current value
-        if (this != first.m_object or this != last.m_object)
-        {
-            throw std::domain_error("iterators do not fit current value");
-        }
-
-        InteratorType result = end();
-
-        switch (m_type)
+        // at only works for arrays
+        if (is_array())
         {
-            case value_t::boolean:
-            case value_t::number_float:
-            case value_t::number_integer:
-            case value_t::number_unsigned:
-            case value_t::string:
-            {
-                if (not first.m_it.primitive_iterator.is_begin() or not last.m_it.primitive_iterator.is_end())
-                {
-                    throw std::out_of_range("iterators out of range");
-                }
-
-                if (is_string())
-                {
-                    delete m_value.string;
-                    m_value.string = nullptr;
-                }
-
-                m_type = value_t::null;
-                break;
-            }
-
-            case value_t::object:
-            {
-                assert(m_value.object != nullptr);
-                result.m_it.object_iterator = m_value.object->erase(first.m_it.object_iterator,
-                                              last.m_it.object_iterator);
-                break;
-            }
-
-            case value_t::array:
+            try
             {
                 assert(m_value.array != nullptr);
-                result.m_it.array_iterator = m_value.array->erase(first.m_it.array_iterator,
-                                             last.m_it.array_iterator);
-                break;
+                return m_value.array->at(idx);
             }
-
-            default:
+            catch (std::out_of_range&)
             {
-                throw std::domain_error("cannot use erase() with " + type_name());
+                // create better exception explanation
+                throw std::out_of_range("array index " + std::to_string(idx) + " is out of range");
             }
         }
-
-        return result;
+        else
+        {
+            throw std::domain_error("cannot use at() with " + type_name());
+        }
     }
 
     /*!
-    @brief remove element from a JSON object given a key
-
-    Removes elements from a JSON object with the key value @a key.
-
-    @param[in] key value of the elements to remove
+    @brief access specified array element with bounds checking
 
-    @return Number of elements removed. If @a ObjectType is the default
-    `std::map` type, the return value will always be `0` (@a key was not
-    found) or `1` (@a key was found).
+    Returns a const reference to the element at specified location @a idx,
+    with bounds checking.
 
-    @post References and iterators to the erased elements are invalidated.
-    Other references and iterators are not affected.
+    @param[in] idx  index of the element to access
 
-    @throw std::domain_error when called on a type other than JSON object;
-    example: `"cannot use erase() with null"`
+    @return const reference to the element at index @a idx
 
-    @complexity `log(size()) + count(key)`
+    @throw std::domain_error if the JSON value is not an array; example:
+    `"cannot use at() with string"`
+    @throw std::out_of_range if the index @a idx is out of range of the array;
+    that is, `idx >= size()`; example: `"array index 7 is out of range"`
 
-    @liveexample{The example shows the effect of `erase()`.,erase__key_type}
+    @complexity Constant.
 
-    @sa @ref erase(InteratorType) -- removes the element at a given position
-    @sa @ref erase(InteratorType, InteratorType) -- removes the elements in
-    the given range
-    @sa @ref erase(const size_type) -- removes the element from an array at
-    the given index
+    @liveexample{The example below shows how array elements can be read using
+    `at()`.,at__size_type_const}
 
     @since version 1.0.0
     */
-    size_type erase(const typename object_t::key_type& key)
+    const_reference at(size_type idx) const
     {
-        // this erase only works for objects
-        if (is_object())
+        // at only works for arrays
+        if (is_array())
         {
-            assert(m_value.object != nullptr);
-            return m_value.object->erase(key);
+            try
+            {
+                assert(m_value.array != nullptr);
+                return m_value.array->at(idx);
+            }
+            catch (std::out_of_range&)
+            {
+                // create better exception explanation
+                throw std::out_of_range("array index " + std::to_string(idx) + " is out of range");
+            }
         }
         else
         {
-            throw std::domain_error("cannot use erase() with " + type_name());
+            throw std::domain_error("cannot use at() with " + type_name());
         }
     }
 
     /*!
-    @brief remove element from a JSON array given an index
+    @brief access specified object element with bounds checking
 
-    Removes element from a JSON array at the index @a idx.
+    Returns a reference to the element at with specified key @a key, with
+    bounds checking.
 
-    @param[in] idx index of the element to remove
+    @param[in] key  key of the element to access
 
-    @throw std::domain_error when called on a type other than JSON array;
-    example: `"cannot use erase() with null"`
-    @throw std::out_of_range when `idx >= size()`; example: `"array index 17
-    is out of range"`
+    @return reference to the element at key @a key
 
-    @complexity Linear in distance between @a idx and the end of the container.
+    @throw std::domain_error if the JSON value is not an object; example:
+    `"cannot use at() with boolean"`
+    @throw std::out_of_range if the key @a key is is not stored in the object;
+    that is, `find(key) == end()`; example: `"key "the fast" not found"`
 
-    @liveexample{The example shows the effect of `erase()`.,erase__size_type}
+    @complexity Logarithmic in the size of the container.
 
-    @sa @ref erase(InteratorType) -- removes the element at a given position
-    @sa @ref erase(InteratorType, InteratorType) -- removes the elements in
-    the given range
-    @sa @ref erase(const typename object_t::key_type&) -- removes the element
-    from an object at the given key
+    @liveexample{The example below shows how object elements can be read and
+    written using `at()`.,at__object_t_key_type}
+
+    @sa @ref operator[](const typename object_t::key_type&) for unchecked
+    access by reference
+    @sa @ref value() for access by value with a default value
 
     @since version 1.0.0
     */
-    void erase(const size_type idx)
+    reference at(const typename object_t::key_type& key)
     {
-        // this erase only works for arrays
-        if (is_array())
+        // at only works for objects
+        if (is_object())
         {
-            if (idx >= size())
+            try
             {
-                throw std::out_of_range("array index " + std::to_string(idx) + " is out of range");
+                assert(m_value.object != nullptr);
+                return m_value.object->at(key);
+            }
+            catch (std::out_of_range&)
+            {
+                // create better exception explanation
+                throw std::out_of_range("key '" + key + "' not found");
             }
-
-            assert(m_value.array != nullptr);
-            m_value.array->erase(m_value.array->begin() + static_cast<difference_type>(idx));
         }
         else
         {
-            throw std::domain_error("cannot use erase() with " + type_name());
+            throw std::domain_error("cannot use at() with " + type_name());
         }
     }
 
-    /// @}
-
+    /*!
+    @brief access specified object element with bounds checking
 
-    ////////////
-    // lookup //
-    ////////////
-
-    /// @name lookup
-    /// @{
+    Returns a const reference to the element at with specified key @a key,
+    with bounds checking.
 
-    /*!
-    @brief find an element in a JSON object
+    @param[in] key  key of the element to access
 
-    Finds an element in a JSON object with key equivalent to @a key. If the
-    element is not found or the JSON value is not an object, end() is
-    returned.
+    @return const reference to the element at key @a key
 
-    @param[in] key key value of the element to search for
+    @throw std::domain_error if the JSON value is not an object; example:
+    `"cannot use at() with boolean"`
+    @throw std::out_of_range if the key @a key is is not stored in the object;
+    that is, `find(key) == end()`; example: `"key "the fast" not found"`
 
-    @return Iterator to an element with key equivalent to @a key. If no such
-    element is found, past-the-end (see end()) iterator is returned.
+    @complexity Logarithmic in the size of the container.
 
-    @complexity Logarithmic in the size of the JSON object.
+    @liveexample{The example below shows how object elements can be read using
+    `at()`.,at__object_t_key_type_const}
 
-    @liveexample{The example shows how `find()` is used.,find__key_type}
+    @sa @ref operator[](const typename object_t::key_type&) for unchecked
+    access by reference
+    @sa @ref value() for access by value with a default value
 
     @since version 1.0.0
     */
-    iterator find(typename object_t::key_type key)
+    const_reference at(const typename object_t::key_type& key) const
     {
-        auto result = end();
-
+        // at only works for objects
         if (is_object())
         {
-            assert(m_value.object != nullptr);
-            result.m_it.object_iterator = m_value.object->find(key);
+            try
+            {
+                assert(m_value.object != nullptr);
+                return m_value.object->at(key);
+            }
+            catch (std::out_of_range&)
+            {
+                // create better exception explanation
+                throw std::out_of_range("key '" + key + "' not found");
+            }
         }
-
-        return result;
-    }
-
-    /*!
-    @brief find an element in a JSON object
-    @copydoc find(typename object_t::key_type)
-    */
-    const_iterator find(typename object_t::key_type key) const
-    {
-        auto result = cend();
-
-        if (is_object())
+        else
         {
-            assert(m_value.object != nullptr);
-            result.m_it.object_iterator = m_value.object->find(key);
+            throw std::domain_error("cannot use at() with " + type_name());
         }
-
-        return result;
     }
 
     /*!
-    @brief returns the number of occurrences of a key in a JSON object
+    @brief access specified array element
 
-    Returns the number of elements with key @a key. If ObjectType is the
-    default `std::map` type, the return value will always be `0` (@a key was
-    not found) or `1` (@a key was found).
+    Returns a reference to the element at specified location @a idx.
 
-    @param[in] key key value of the element to count
+    @note If @a idx is beyond the range of the array (i.e., `idx >= size()`),
+    then the array is silently filled up with `null` values to make `idx` a
+    valid reference to the last stored element.
 
-    @return Number of elements with key @a key. If the JSON value is not an
-    object, the return value will be `0`.
+    @param[in] idx  index of the element to access
 
-    @complexity Logarithmic in the size of the JSON object.
+    @return reference to the element at index @a idx
 
-    @liveexample{The example shows how `count()` is used.,count}
+    @throw std::domain_error if JSON is not an array or null; example:
+    `"cannot use operator[] with string"`
+
+    @complexity Constant if @a idx is in the range of the array. Otherwise
+    linear in `idx - size()`.
+
+    @liveexample{The example below shows how array elements can be read and
+    written using `[]` operator. Note the addition of `null`
+    values.,operatorarray__size_type}
 
     @since version 1.0.0
     */
-    size_type count(typename object_t::key_type key) const
+    reference operator[](size_type idx)
     {
-        // return 0 for all nonobject types
-        assert(not is_object() or m_value.object != nullptr);
-        return is_object() ? m_value.object->count(key) : 0;
-    }
-
-    /// @}
-
+        // implicitly convert null value to an empty array
+        if (is_null())
+        {
+            m_type = value_t::array;
+            m_value.array = create<array_t>();
+        }
 
-    ///////////////
-    // iterators //
-    ///////////////
+        // operator[] only works for arrays
+        if (is_array())
+        {
+            // fill up array with null values until given idx is reached
+            assert(m_value.array != nullptr);
+            for (size_t i = m_value.array->size(); i <= idx; ++i)
+            {
+                m_value.array->push_back(basic_json());
+            }
 
-    /// @name iterators
-    /// @{
+            return m_value.array->operator[](idx);
+        }
+        else
+        {
+            throw std::domain_error("cannot use operator[] with " + type_name());
+        }
+    }
 
     /*!
-    @brief returns an iterator to the first element
-
-    Returns an iterator to the first element.
+    @brief access specified array element
 
-    @image html range-begin-end.svg "Illustration from cppreference.com"
+    Returns a const reference to the element at specified location @a idx.
 
-    @return iterator to the first element
+    @param[in] idx  index of the element to access
 
-    @complexity Constant.
+    @return const reference to the element at index @a idx
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
+    @throw std::domain_error if JSON is not an array; example: `"cannot use
+    operator[] with null"`
 
-    @liveexample{The following code shows an example for `begin()`.,begin}
+    @complexity Constant.
 
-    @sa @ref cbegin() -- returns a const iterator to the beginning
-    @sa @ref end() -- returns an iterator to the end
-    @sa @ref cend() -- returns a const iterator to the end
+    @liveexample{The example below shows how array elements can be read using
+    the `[]` operator.,operatorarray__size_type_const}
 
     @since version 1.0.0
     */
-    iterator begin() noexcept
+    const_reference operator[](size_type idx) const
     {
-        iterator result(this);
-        result.set_begin();
-        return result;
+        // const operator[] only works for arrays
+        if (is_array())
+        {
+            assert(m_value.array != nullptr);
+            return m_value.array->operator[](idx);
+        }
+        else
+        {
+            throw std::domain_error("cannot use operator[] with " + type_name());
+        }
     }
 
     /*!
-    @copydoc basic_json::cbegin()
-    */
-    const_iterator begin() const noexcept
-    {
-        return cbegin();
-    }
+    @brief access specified object element
 
-    /*!
-    @brief returns a const iterator to the first element
+    Returns a reference to the element at with specified key @a key.
 
-    Returns a const iterator to the first element.
+    @note If @a key is not found in the object, then it is silently added to
+    the object and filled with a `null` value to make `key` a valid reference.
+    In case the value was `null` before, it is converted to an object.
 
-    @image html range-begin-end.svg "Illustration from cppreference.com"
+    @param[in] key  key of the element to access
 
-    @return const iterator to the first element
+    @return reference to the element at key @a key
 
-    @complexity Constant.
+    @throw std::domain_error if JSON is not an object or null; example:
+    `"cannot use operator[] with string"`
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `const_cast<const basic_json&>(*this).begin()`.
+    @complexity Logarithmic in the size of the container.
 
-    @liveexample{The following code shows an example for `cbegin()`.,cbegin}
+    @liveexample{The example below shows how object elements can be read and
+    written using the `[]` operator.,operatorarray__key_type}
 
-    @sa @ref begin() -- returns an iterator to the beginning
-    @sa @ref end() -- returns an iterator to the end
-    @sa @ref cend() -- returns a const iterator to the end
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref value() for access by value with a default value
 
     @since version 1.0.0
     */
-    const_iterator cbegin() const noexcept
+    reference operator[](const typename object_t::key_type& key)
     {
-        const_iterator result(this);
-        result.set_begin();
-        return result;
+        // implicitly convert null value to an empty object
+        if (is_null())
+        {
+            m_type = value_t::object;
+            m_value.object = create<object_t>();
+        }
+
+        // operator[] only works for objects
+        if (is_object())
+        {
+            assert(m_value.object != nullptr);
+            return m_value.object->operator[](key);
+        }
+        else
+        {
+            throw std::domain_error("cannot use operator[] with " + type_name());
+        }
     }
 
     /*!
-    @brief returns an iterator to one past the last element
+    @brief read-only access specified object element
 
-    Returns an iterator to one past the last element.
+    Returns a const reference to the element at with specified key @a key. No
+    bounds checking is performed.
 
-    @image html range-begin-end.svg "Illustration from cppreference.com"
+    @warning If the element with key @a key does not exist, the behavior is
+    undefined.
 
-    @return iterator one past the last element
+    @param[in] key  key of the element to access
 
-    @complexity Constant.
+    @return const reference to the element at key @a key
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
+    @throw std::domain_error if JSON is not an object; example: `"cannot use
+    operator[] with null"`
 
-    @liveexample{The following code shows an example for `end()`.,end}
+    @complexity Logarithmic in the size of the container.
 
-    @sa @ref cend() -- returns a const iterator to the end
-    @sa @ref begin() -- returns an iterator to the beginning
-    @sa @ref cbegin() -- returns a const iterator to the beginning
+    @liveexample{The example below shows how object elements can be read using
+    the `[]` operator.,operatorarray__key_type_const}
+
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref value() for access by value with a default value
 
     @since version 1.0.0
     */
-    iterator end() noexcept
+    const_reference operator[](const typename object_t::key_type& key) const
     {
-        iterator result(this);
-        result.set_end();
-        return result;
+        // const operator[] only works for objects
+        if (is_object())
+        {
+            assert(m_value.object != nullptr);
+            assert(m_value.object->find(key) != m_value.object->end());
+            return m_value.object->find(key)->second;
+        }
+        else
+        {
+            throw std::domain_error("cannot use operator[] with " + type_name());
+        }
     }
 
     /*!
-    @copydoc basic_json::cend()
-    */
-    const_iterator end() const noexcept
-    {
-        return cend();
-    }
+    @brief access specified object element
 
-    /*!
-    @brief returns a const iterator to one past the last element
+    Returns a reference to the element at with specified key @a key.
 
-    Returns a const iterator to one past the last element.
+    @note If @a key is not found in the object, then it is silently added to
+    the object and filled with a `null` value to make `key` a valid reference.
+    In case the value was `null` before, it is converted to an object.
 
-    @image html range-begin-end.svg "Illustration from cppreference.com"
+    @param[in] key  key of the element to access
 
-    @return const iterator one past the last element
+    @return reference to the element at key @a key
 
-    @complexity Constant.
+    @throw std::domain_error if JSON is not an object or null; example:
+    `"cannot use operator[] with string"`
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `const_cast<const basic_json&>(*this).end()`.
+    @complexity Logarithmic in the size of the container.
 
-    @liveexample{The following code shows an example for `cend()`.,cend}
+    @liveexample{The example below shows how object elements can be read and
+    written using the `[]` operator.,operatorarray__key_type}
 
-    @sa @ref end() -- returns an iterator to the end
-    @sa @ref begin() -- returns an iterator to the beginning
-    @sa @ref cbegin() -- returns a const iterator to the beginning
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref value() for access by value with a default value
 
     @since version 1.0.0
     */
-    const_iterator cend() const noexcept
+    template<typename T, std::size_t n>
+    reference operator[](T * (&key)[n])
     {
-        const_iterator result(this);
-        result.set_end();
-        return result;
+        return operator[](static_cast<const T>(key));
     }
 
     /*!
-    @brief returns an iterator to the reverse-beginning
+    @brief read-only access specified object element
 
-    Returns an iterator to the reverse-beginning; that is, the last element.
+    Returns a const reference to the element at with specified key @a key. No
+    bounds checking is performed.
 
-    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
+    @warning If the element with key @a key does not exist, the behavior is
+    undefined.
 
-    @complexity Constant.
+    @note This function is required for compatibility reasons with Clang.
 
-    @requirement This function helps `basic_json` satisfying the
-    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `reverse_iterator(end())`.
+    @param[in] key  key of the element to access
 
-    @liveexample{The following code shows an example for `rbegin()`.,rbegin}
+    @return const reference to the element at key @a key
 
-    @sa @ref crbegin() -- returns a const reverse iterator to the beginning
-    @sa @ref rend() -- returns a reverse iterator to the end
-    @sa @ref crend() -- returns a const reverse iterator to the end
+    @throw std::domain_error if JSON is not an object; example: `"cannot use
+    operator[] with null"`
+
+    @complexity Logarithmic in the size of the container.
+
+    @liveexample{The example below shows how object elements can be read using
+    the `[]` operator.,operatorarray__key_type_const}
+
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref value() for access by value with a default value
 
     @since version 1.0.0
     */
-    reverse_iterator rbegin() noexcept
+    template<typename T, std::size_t n>
+    const_reference operator[](T * (&key)[n]) const
     {
-        return reverse_iterator(end());
+        return operator[](static_cast<const T>(key));
     }
 
     /*!
-    @copydoc basic_json::crbegin()
-    */
-    const_reverse_iterator rbegin() const noexcept
-    {
-        return crbegin();
-    }
+    @brief access specified object element
 
-    /*!
-    @brief returns an iterator to the reverse-end
+    Returns a reference to the element at with specified key @a key.
 
-    Returns an iterator to the reverse-end; that is, one before the first
-    element.
+    @note If @a key is not found in the object, then it is silently added to
+    the object and filled with a `null` value to make `key` a valid reference.
+    In case the value was `null` before, it is converted to an object.
 
-    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
+    @param[in] key  key of the element to access
 
-    @complexity Constant.
+    @return reference to the element at key @a key
 
-    @requirement This function helps `basic_json` satisfying the
-    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `reverse_iterator(begin())`.
+    @throw std::domain_error if JSON is not an object or null; example:
+    `"cannot use operator[] with string"`
 
-    @liveexample{The following code shows an example for `rend()`.,rend}
+    @complexity Logarithmic in the size of the container.
 
-    @sa @ref crend() -- returns a const reverse iterator to the end
-    @sa @ref rbegin() -- returns a reverse iterator to the beginning
-    @sa @ref crbegin() -- returns a const reverse iterator to the beginning
+    @liveexample{The example below shows how object elements can be read and
+    written using the `[]` operator.,operatorarray__key_type}
 
-    @since version 1.0.0
-    */
-    reverse_iterator rend() noexcept
-    {
-        return reverse_iterator(begin());
-    }
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref value() for access by value with a default value
 
-    /*!
-    @copydoc basic_json::crend()
+    @since version 1.1.0
     */
-    const_reverse_iterator rend() const noexcept
+    template<typename T>
+    reference operator[](T* key)
     {
-        return crend();
+        // implicitly convert null to object
+        if (is_null())
+        {
+            m_type = value_t::object;
+            m_value = value_t::object;
+        }
+
+        // at only works for objects
+        if (is_object())
+        {
+            assert(m_value.object != nullptr);
+            return m_value.object->operator[](key);
+        }
+        else
+        {
+            throw std::domain_error("cannot use operator[] with " + type_name());
+        }
     }
 
     /*!
-    @brief returns a const reverse iterator to the last element
+    @brief read-only access specified object element
 
-    Returns a const iterator to the reverse-beginning; that is, the last
-    element.
+    Returns a const reference to the element at with specified key @a key. No
+    bounds checking is performed.
 
-    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
+    @warning If the element with key @a key does not exist, the behavior is
+    undefined.
 
-    @complexity Constant.
+    @param[in] key  key of the element to access
 
-    @requirement This function helps `basic_json` satisfying the
-    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `const_cast<const basic_json&>(*this).rbegin()`.
+    @return const reference to the element at key @a key
 
-    @liveexample{The following code shows an example for `crbegin()`.,crbegin}
+    @throw std::domain_error if JSON is not an object; example: `"cannot use
+    operator[] with null"`
 
-    @sa @ref rbegin() -- returns a reverse iterator to the beginning
-    @sa @ref rend() -- returns a reverse iterator to the end
-    @sa @ref crend() -- returns a const reverse iterator to the end
+    @complexity Logarithmic in the size of the container.
 
-    @since version 1.0.0
+    @liveexample{The example below shows how object elements can be read using
+    the `[]` operator.,operatorarray__key_type_const}
+
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref value() for access by value with a default value
+
+    @since version 1.1.0
     */
-    const_reverse_iterator crbegin() const noexcept
+    template<typename T>
+    const_reference operator[](T* key) const
     {
-        return const_reverse_iterator(cend());
+        // at only works for objects
+        if (is_object())
+        {
+            assert(m_value.object != nullptr);
+            assert(m_value.object->find(key) != m_value.object->end());
+            return m_value.object->find(key)->second;
+        }
+        else
+        {
+            throw std::domain_error("cannot use operator[] with " + type_name());
+        }
     }
 
     /*!
-    @brief returns a const reverse iterator to one before the first
+    @brief access specified object element with default value
 
-    Returns a const reverse iterator to the reverse-end; that is, one before
-    the first element.
+    Returns either a copy of an object's element at the specified key @a key or
+    a given default value if no element with key @a key exists.
 
-    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
+    The function is basically equivalent to executing
+    @code {.cpp}
+    try {
+        return at(key);
+    } catch(std::out_of_range) {
+        return default_value;
+    }
+    @endcode
 
-    @complexity Constant.
+    @note Unlike @ref at(const typename object_t::key_type&), this function
+    does not throw if the given key @a key was not found.
 
-    @requirement This function helps `basic_json` satisfying the
-    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `const_cast<const basic_json&>(*this).rend()`.
+    @note Unlike @ref operator[](const typename object_t::key_type& key), this
+    function does not implicitly add an element to the position defined by @a
+    key. This function is furthermore also applicable to const objects.
 
-    @liveexample{The following code shows an example for `crend()`.,crend}
+    @param[in] key  key of the element to access
+    @param[in] default_value  the value to return if @a key is not found
 
-    @sa @ref rend() -- returns a reverse iterator to the end
-    @sa @ref rbegin() -- returns a reverse iterator to the beginning
-    @sa @ref crbegin() -- returns a const reverse iterator to the beginning
+    @tparam ValueType type compatible to JSON values, for instance `int` for
+    JSON integer numbers, `bool` for JSON booleans, or `std::vector` types for
+    JSON arrays. Note the type of the expected value at @a key and the default
+    value @a default_value must be compatible.
 
-    @since version 1.0.0
-    */
-    const_reverse_iterator crend() const noexcept
-    {
-        return const_reverse_iterator(cbegin());
-    }
+    @return copy of the element at key @a key or @a default_value if @a key
+    is not found
 
-  private:
-    // forward declaration
-    template<typename IteratorType> class iteration_proxy;
+    @throw std::domain_error if JSON is not an object; example: `"cannot use
+    value() with null"`
+
+    @complexity Logarithmic in the size of the container.
+
+    @liveexample{The example below shows how object elements can be queried
+    with a default value.,basic_json__value}
+
+    @sa @ref at(const typename object_t::key_type&) for access by reference
+    with range checking
+    @sa @ref operator[](const typename object_t::key_type&) for unchecked
+    access by reference
+
+    @since version 1.0.0
+    */
+    template <class ValueType, typename
+              std::enable_if<
+                  std::is_convertible<basic_json_t, ValueType>::value
+                  , int>::type = 0>
+    ValueType value(const typename object_t::key_type& key, ValueType default_value) const
+    {
+        // at only works for objects
+        if (is_object())
+        {
+            // if key is found, return value and given default value otherwise
+            const auto it = find(key);
+            if (it != end())
+            {
+                return *it;
+            }
+            else
+            {
+                return default_value;
+            }
+        }
+        else
+        {
+            throw std::domain_error("cannot use value() with " + type_name());
+        }
+    }
 
-  public:
     /*!
-    @brief wrapper to access iterator member functions in range-based for
+    @brief overload for a default value of type const char*
+    @copydoc basic_json::value()
+    */
+    string_t value(const typename object_t::key_type& key, const char* default_value) const
+    {
+        return value(key, string_t(default_value));
+    }
 
-    This function allows to access @ref iterator::key() and @ref
-    iterator::value() during range-based for loops. In these loops, a
-    reference to the JSON values is returned, so there is no access to the
-    underlying iterator.
+    /*!
+    @brief access the first element
 
-    @note The name of this function is not yet final and may change in the
-    future.
+    Returns a reference to the first element in the container. For a JSON
+    container `c`, the expression `c.front()` is equivalent to `*c.begin()`.
+
+    @return In case of a structured type (array or object), a reference to the
+    first element is returned. In cast of number, string, or boolean values, a
+    reference to the value is returned.
+
+    @complexity Constant.
+
+    @pre The JSON value must not be `null` (would throw `std::out_of_range`)
+    or an empty array or object (undefined behavior, guarded by assertions).
+    @post The JSON value remains unchanged.
+
+    @throw std::out_of_range when called on `null` value
+
+    @liveexample{The following code shows an example for `front()`.,front}
+
+    @sa @ref back() -- access the last element
+
+    @since version 1.0.0
     */
-    static iteration_proxy<iterator> iterator_wrapper(reference cont)
+    reference front()
     {
-        return iteration_proxy<iterator>(cont);
+        return *begin();
     }
 
     /*!
-    @copydoc iterator_wrapper(reference)
+    @copydoc basic_json::front()
     */
-    static iteration_proxy<const_iterator> iterator_wrapper(const_reference cont)
+    const_reference front() const
     {
-        return iteration_proxy<const_iterator>(cont);
+        return *cbegin();
     }
 
-    /// @}
+    /*!
+    @brief access the last element
 
+    Returns a reference to the last element in the container. For a JSON
+    container `c`, the expression `c.back()` is equivalent to
+    @code {.cpp}
+    auto tmp = c.end();
+    --tmp;
+    return *tmp;
+    @endcode
 
-    //////////////
-    // capacity //
-    //////////////
+    @return In case of a structured type (array or object), a reference to the
+    last element is returned. In cast of number, string, or boolean values, a
+    reference to the value is returned.
 
-    /// @name capacity
-    /// @{
+    @complexity Constant.
+
+    @pre The JSON value must not be `null` (would throw `std::out_of_range`)
+    or an empty array or object (undefined behavior, guarded by assertions).
+    @post The JSON value remains unchanged.
+
+    @throw std::out_of_range when called on `null` value.
+
+    @liveexample{The following code shows an example for `back()`.,back}
+
+    @sa @ref front() -- access the first element
+
+    @since version 1.0.0
+    */
+    reference back()
+    {
+        auto tmp = end();
+        --tmp;
+        return *tmp;
+    }
 
     /*!
-    @brief checks whether the container is empty
+    @copydoc basic_json::back()
+    */
+    const_reference back() const
+    {
+        auto tmp = cend();
+        --tmp;
+        return *tmp;
+    }
 
-    Checks if a JSON value has no elements.
+    /*!
+    @brief remove element given an iterator
 
-    @return The return value depends on the different types and is
-            defined as follows:
-            Value type  | return value
-            ----------- | -------------
-            null        | `true`
-            boolean     | `false`
-            string      | `false`
-            number      | `false`
-            object      | result of function `object_t::empty()`
-            array       | result of function `array_t::empty()`
+    Removes the element specified by iterator @a pos. The iterator @a pos must
+    be valid and dereferenceable. Thus the `end()` iterator (which is valid,
+    but is not dereferenceable) cannot be used as a value for @a pos.
 
-    @complexity Constant, as long as @ref array_t and @ref object_t satisfy
-    the Container concept; that is, their `empty()` functions have constant
-    complexity.
+    If called on a primitive type other than `null`, the resulting JSON value
+    will be `null`.
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `begin() == end()`.
+    @param[in] pos iterator to the element to remove
+    @return Iterator following the last removed element. If the iterator @a
+    pos refers to the last element, the `end()` iterator is returned.
 
-    @liveexample{The following code uses `empty()` to check if a JSON
-    object contains any elements.,empty}
+    @tparam InteratorType an @ref iterator or @ref const_iterator
 
-    @sa @ref size() -- returns the number of elements
+    @post Invalidates iterators and references at or after the point of the
+    erase, including the `end()` iterator.
+
+    @throw std::domain_error if called on a `null` value; example: `"cannot
+    use erase() with null"`
+    @throw std::domain_error if called on an iterator which does not belong to
+    the current JSON value; example: `"iterator does not fit current value"`
+    @throw std::out_of_range if called on a primitive type with invalid
+    iterator (i.e., any iterator which is not `begin()`); example: `"iterator
+    out of range"`
+
+    @complexity The complexity depends on the type:
+    - objects: amortized constant
+    - arrays: linear in distance between pos and the end of the container
+    - strings: linear in the length of the string
+    - other types: constant
+
+    @liveexample{The example shows the result of `erase()` for different JSON
+    types.,erase__IteratorType}
+
+    @sa @ref erase(InteratorType, InteratorType) -- removes the elements in
+    the given range
+    @sa @ref erase(const typename object_t::key_type&) -- removes the element
+    from an object at the given key
+    @sa @ref erase(const size_type) -- removes the element from an array at
+    the given index
 
     @since version 1.0.0
     */
-    bool empty() const noexcept
+    template <class InteratorType, typename
+              std::enable_if<
+                  std::is_same<InteratorType, typename basic_json_t::iterator>::value or
+                  std::is_same<InteratorType, typename basic_json_t::const_iterator>::value
+                  , int>::type
+              = 0>
+    InteratorType erase(InteratorType pos)
     {
+        // make sure iterator fits the current value
+        if (this != pos.m_object)
+        {
+            throw std::domain_error("iterator does not fit current value");
+        }
+
+        InteratorType result = end();
+
         switch (m_type)
         {
-            case value_t::null:
+            case value_t::boolean:
+            case value_t::number_float:
+            case value_t::number_integer:
+            case value_t::number_unsigned:
+            case value_t::string:
             {
-                // null values are empty
-                return true;
-            }
+                if (not pos.m_it.primitive_iterator.is_begin())
+                {
+                    throw std::out_of_range("iterator out of range");
+                }
 
-            case value_t::array:
-            {
-                assert(m_value.array != nullptr);
-                return m_value.array->empty();
+                if (is_string())
+                {
+                    delete m_value.string;
+                    m_value.string = nullptr;
+                }
+
+                m_type = value_t::null;
+                break;
             }
 
             case value_t::object:
             {
                 assert(m_value.object != nullptr);
-                return m_value.object->empty();
+                result.m_it.object_iterator = m_value.object->erase(pos.m_it.object_iterator);
+                break;
+            }
+
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+                result.m_it.array_iterator = m_value.array->erase(pos.m_it.array_iterator);
+                break;
             }
 
             default:
             {
-                // all other types are nonempty
-                return false;
+                throw std::domain_error("cannot use erase() with " + type_name());
             }
         }
+
+        return result;
     }
 
     /*!
-    @brief returns the number of elements
+    @brief remove elements given an iterator range
 
-    Returns the number of elements in a JSON value.
+    Removes the element specified by the range `[first; last)`. The iterator
+    @a first does not need to be dereferenceable if `first == last`: erasing
+    an empty range is a no-op.
 
-    @return The return value depends on the different types and is
-            defined as follows:
-            Value type  | return value
-            ----------- | -------------
-            null        | `0`
-            boolean     | `1`
-            string      | `1`
-            number      | `1`
-            object      | result of function object_t::size()
-            array       | result of function array_t::size()
+    If called on a primitive type other than `null`, the resulting JSON value
+    will be `null`.
 
-    @complexity Constant, as long as @ref array_t and @ref object_t satisfy
-    the Container concept; that is, their size() functions have constant
-    complexity.
+    @param[in] first iterator to the beginning of the range to remove
+    @param[in] last iterator past the end of the range to remove
+    @return Iterator following the last removed element. If the iterator @a
+    second refers to the last element, the `end()` iterator is returned.
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of `std::distance(begin(), end())`.
+    @tparam InteratorType an @ref iterator or @ref const_iterator
 
-    @liveexample{The following code calls `size()` on the different value
-    types.,size}
+    @post Invalidates iterators and references at or after the point of the
+    erase, including the `end()` iterator.
 
-    @sa @ref empty() -- checks whether the container is empty
-    @sa @ref max_size() -- returns the maximal number of elements
+    @throw std::domain_error if called on a `null` value; example: `"cannot
+    use erase() with null"`
+    @throw std::domain_error if called on iterators which does not belong to
+    the current JSON value; example: `"iterators do not fit current value"`
+    @throw std::out_of_range if called on a primitive type with invalid
+    iterators (i.e., if `first != begin()` and `last != end()`); example:
+    `"iterators out of range"`
+
+    @complexity The complexity depends on the type:
+    - objects: `log(size()) + std::distance(first, last)`
+    - arrays: linear in the distance between @a first and @a last, plus linear
+      in the distance between @a last and end of the container
+    - strings: linear in the length of the string
+    - other types: constant
+
+    @liveexample{The example shows the result of `erase()` for different JSON
+    types.,erase__IteratorType_IteratorType}
+
+    @sa @ref erase(InteratorType) -- removes the element at a given position
+    @sa @ref erase(const typename object_t::key_type&) -- removes the element
+    from an object at the given key
+    @sa @ref erase(const size_type) -- removes the element from an array at
+    the given index
 
     @since version 1.0.0
     */
-    size_type size() const noexcept
+    template <class InteratorType, typename
+              std::enable_if<
+                  std::is_same<InteratorType, typename basic_json_t::iterator>::value or
+                  std::is_same<InteratorType, typename basic_json_t::const_iterator>::value
+                  , int>::type
+              = 0>
+    InteratorType erase(InteratorType first, InteratorType last)
     {
+        // make sure iterator fits the current value
+        if (this != first.m_object or this != last.m_object)
+        {
+            throw std::domain_error("iterators do not fit current value");
+        }
+
+        InteratorType result = end();
+
         switch (m_type)
         {
-            case value_t::null:
+            case value_t::boolean:
+            case value_t::number_float:
+            case value_t::number_integer:
+            case value_t::number_unsigned:
+            case value_t::string:
             {
-                // null values are empty
-                return 0;
-            }
+                if (not first.m_it.primitive_iterator.is_begin() or not last.m_it.primitive_iterator.is_end())
+                {
+                    throw std::out_of_range("iterators out of range");
+                }
 
-            case value_t::array:
-            {
-                assert(m_value.array != nullptr);
-                return m_value.array->size();
+                if (is_string())
+                {
+                    delete m_value.string;
+                    m_value.string = nullptr;
+                }
+
+                m_type = value_t::null;
+                break;
             }
 
             case value_t::object:
             {
                 assert(m_value.object != nullptr);
-                return m_value.object->size();
+                result.m_it.object_iterator = m_value.object->erase(first.m_it.object_iterator,
+                                              last.m_it.object_iterator);
+                break;
+            }
+
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+                result.m_it.array_iterator = m_value.array->erase(first.m_it.array_iterator,
+                                             last.m_it.array_iterator);
+                break;
             }
 
             default:
             {
-                // all other types have size 1
-                return 1;
+                throw std::domain_error("cannot use erase() with " + type_name());
             }
         }
+
+        return result;
     }
 
     /*!
-    @brief returns the maximum possible number of elements
+    @brief remove element from a JSON object given a key
 
-    Returns the maximum number of elements a JSON value is able to hold due to
-    system or library implementation limitations, i.e. `std::distance(begin(),
-    end())` for the JSON value.
+    Removes elements from a JSON object with the key value @a key.
 
-    @return The return value depends on the different types and is
-            defined as follows:
-            Value type  | return value
-            ----------- | -------------
-            null        | `0` (same as `size()`)
-            boolean     | `1` (same as `size()`)
-            string      | `1` (same as `size()`)
-            number      | `1` (same as `size()`)
-            object      | result of function `object_t::max_size()`
-            array       | result of function `array_t::max_size()`
+    @param[in] key value of the elements to remove
 
-    @complexity Constant, as long as @ref array_t and @ref object_t satisfy
-    the Container concept; that is, their `max_size()` functions have constant
-    complexity.
+    @return Number of elements removed. If @a ObjectType is the default
+    `std::map` type, the return value will always be `0` (@a key was not
+    found) or `1` (@a key was found).
 
-    @requirement This function helps `basic_json` satisfying the
-    [Container](http://en.cppreference.com/w/cpp/concept/Container)
-    requirements:
-    - The complexity is constant.
-    - Has the semantics of returning `b.size()` where `b` is the largest
-      possible JSON value.
+    @post References and iterators to the erased elements are invalidated.
+    Other references and iterators are not affected.
 
-    @liveexample{The following code calls `max_size()` on the different value
-    types. Note the output is implementation specific.,max_size}
+    @throw std::domain_error when called on a type other than JSON object;
+    example: `"cannot use erase() with null"`
 
-    @sa @ref size() -- returns the number of elements
+    @complexity `log(size()) + count(key)`
+
+    @liveexample{The example shows the effect of `erase()`.,erase__key_type}
+
+    @sa @ref erase(InteratorType) -- removes the element at a given position
+    @sa @ref erase(InteratorType, InteratorType) -- removes the elements in
+    the given range
+    @sa @ref erase(const size_type) -- removes the element from an array at
+    the given index
 
     @since version 1.0.0
     */
-    size_type max_size() const noexcept
+    size_type erase(const typename object_t::key_type& key)
     {
-        switch (m_type)
+        // this erase only works for objects
+        if (is_object())
         {
-            case value_t::array:
-            {
-                assert(m_value.array != nullptr);
-                return m_value.array->max_size();
-            }
+            assert(m_value.object != nullptr);
+            return m_value.object->erase(key);
+        }
+        else
+        {
+            throw std::domain_error("cannot use erase() with " + type_name());
+        }
+    }
 
-            case value_t::object:
-            {
-                assert(m_value.object != nullptr);
-                return m_value.object->max_size();
-            }
+    /*!
+    @brief remove element from a JSON array given an index
 
-            default:
+    Removes element from a JSON array at the index @a idx.
+
+    @param[in] idx index of the element to remove
+
+    @throw std::domain_error when called on a type other than JSON array;
+    example: `"cannot use erase() with null"`
+    @throw std::out_of_range when `idx >= size()`; example: `"array index 17
+    is out of range"`
+
+    @complexity Linear in distance between @a idx and the end of the container.
+
+    @liveexample{The example shows the effect of `erase()`.,erase__size_type}
+
+    @sa @ref erase(InteratorType) -- removes the element at a given position
+    @sa @ref erase(InteratorType, InteratorType) -- removes the elements in
+    the given range
+    @sa @ref erase(const typename object_t::key_type&) -- removes the element
+    from an object at the given key
+
+    @since version 1.0.0
+    */
+    void erase(const size_type idx)
+    {
+        // this erase only works for arrays
+        if (is_array())
+        {
+            if (idx >= size())
             {
-                // all other types have max_size() == size()
-                return size();
+                throw std::out_of_range("array index " + std::to_string(idx) + " is out of range");
             }
+
+            assert(m_value.array != nullptr);
+            m_value.array->erase(m_value.array->begin() + static_cast<difference_type>(idx));
+        }
+        else
+        {
+            throw std::domain_error("cannot use erase() with " + type_name());
         }
     }
 
     /// @}
 
 
-    ///////////////
-    // modifiers //
-    ///////////////
+    ////////////
+    // lookup //
+    ////////////
 
-    /// @name modifiers
+    /// @name lookup
     /// @{
 
     /*!
-    @brief clears the contents
+    @brief find an element in a JSON object
 
-    Clears the content of a JSON value and resets it to the default value as
-    if @ref basic_json(value_t) would have been called:
+    Finds an element in a JSON object with key equivalent to @a key. If the
+    element is not found or the JSON value is not an object, end() is
+    returned.
 
-    Value type  | initial value
-    ----------- | -------------
-    null        | `null`
-    boolean     | `false`
-    string      | `""`
-    number      | `0`
-    object      | `{}`
-    array       | `[]`
+    @param[in] key key value of the element to search for
 
-    @note Floating-point numbers are set to `0.0` which will be serialized to
-    `0`. The vale type remains @ref number_float_t.
+    @return Iterator to an element with key equivalent to @a key. If no such
+    element is found, past-the-end (see end()) iterator is returned.
 
-    @complexity Linear in the size of the JSON value.
+    @complexity Logarithmic in the size of the JSON object.
 
-    @liveexample{The example below shows the effect of `clear()` to different
-    JSON types.,clear}
+    @liveexample{The example shows how `find()` is used.,find__key_type}
 
     @since version 1.0.0
     */
-    void clear() noexcept
+    iterator find(typename object_t::key_type key)
     {
-        switch (m_type)
+        auto result = end();
+
+        if (is_object())
         {
-            case value_t::number_integer:
-            {
-                m_value.number_integer = 0;
-                break;
-            }
-
-            case value_t::number_unsigned:
-            {
-                m_value.number_unsigned = 0;
-                break;
-            }
-
-            case value_t::number_float:
-            {
-                m_value.number_float = 0.0;
-                break;
-            }
-
-            case value_t::boolean:
-            {
-                m_value.boolean = false;
-                break;
-            }
-
-            case value_t::string:
-            {
-                assert(m_value.string != nullptr);
-                m_value.string->clear();
-                break;
-            }
+            assert(m_value.object != nullptr);
+            result.m_it.object_iterator = m_value.object->find(key);
+        }
 
-            case value_t::array:
-            {
-                assert(m_value.array != nullptr);
-                m_value.array->clear();
-                break;
-            }
+        return result;
+    }
 
-            case value_t::object:
-            {
-                assert(m_value.object != nullptr);
-                m_value.object->clear();
-                break;
-            }
+    /*!
+    @brief find an element in a JSON object
+    @copydoc find(typename object_t::key_type)
+    */
+    const_iterator find(typename object_t::key_type key) const
+    {
+        auto result = cend();
 
-            default:
-            {
-                break;
-            }
+        if (is_object())
+        {
+            assert(m_value.object != nullptr);
+            result.m_it.object_iterator = m_value.object->find(key);
         }
+
+        return result;
     }
 
     /*!
-    @brief add an object to an array
+    @brief returns the number of occurrences of a key in a JSON object
 
-    Appends the given element @a val to the end of the JSON value. If the
-    function is called on a JSON null value, an empty array is created before
-    appending @a val.
+    Returns the number of elements with key @a key. If ObjectType is the
+    default `std::map` type, the return value will always be `0` (@a key was
+    not found) or `1` (@a key was found).
 
-    @param[in] val the value to add to the JSON array
+    @param[in] key key value of the element to count
 
-    @throw std::domain_error when called on a type other than JSON array or
-    null; example: `"cannot use push_back() with number"`
+    @return Number of elements with key @a key. If the JSON value is not an
+    object, the return value will be `0`.
 
-    @complexity Amortized constant.
+    @complexity Logarithmic in the size of the JSON object.
 
-    @liveexample{The example shows how `push_back()` and `+=` can be used to
-    add elements to a JSON array. Note how the `null` value was silently
-    converted to a JSON array.,push_back}
+    @liveexample{The example shows how `count()` is used.,count}
 
     @since version 1.0.0
     */
-    void push_back(basic_json&& val)
+    size_type count(typename object_t::key_type key) const
     {
-        // push_back only works for null objects or arrays
-        if (not(is_null() or is_array()))
-        {
-            throw std::domain_error("cannot use push_back() with " + type_name());
-        }
-
-        // transform null object into an array
-        if (is_null())
-        {
-            m_type = value_t::array;
-            m_value = value_t::array;
-        }
-
-        // add element to array (move semantics)
-        assert(m_value.array != nullptr);
-        m_value.array->push_back(std::move(val));
-        // invalidate object
-        val.m_type = value_t::null;
+        // return 0 for all nonobject types
+        assert(not is_object() or m_value.object != nullptr);
+        return is_object() ? m_value.object->count(key) : 0;
     }
 
-    /*!
-    @brief add an object to an array
-    @copydoc push_back(basic_json&&)
-    */
-    reference operator+=(basic_json&& val)
-    {
-        push_back(std::move(val));
-        return *this;
-    }
+    /// @}
 
-    /*!
-    @brief add an object to an array
-    @copydoc push_back(basic_json&&)
-    */
-    void push_back(const basic_json& val)
-    {
-        // push_back only works for null objects or arrays
-        if (not(is_null() or is_array()))
-        {
-            throw std::domain_error("cannot use push_back() with " + type_name());
-        }
 
-        // transform null object into an array
-        if (is_null())
-        {
-            m_type = value_t::array;
-            m_value = value_t::array;
-        }
+    ///////////////
+    // iterators //
+    ///////////////
 
-        // add element to array
-        assert(m_value.array != nullptr);
-        m_value.array->push_back(val);
-    }
+    /// @name iterators
+    /// @{
 
     /*!
-    @brief add an object to an array
-    @copydoc push_back(basic_json&&)
-    */
-    reference operator+=(const basic_json& val)
-    {
-        push_back(val);
-        return *this;
-    }
+    @brief returns an iterator to the first element
 
-    /*!
-    @brief add an object to an object
+    Returns an iterator to the first element.
 
-    Inserts the given element @a val to the JSON object. If the function is
-    called on a JSON null value, an empty object is created before inserting
-    @a val.
+    @image html range-begin-end.svg "Illustration from cppreference.com"
 
-    @param[in] val the value to add to the JSON object
+    @return iterator to the first element
 
-    @throw std::domain_error when called on a type other than JSON object or
-    null; example: `"cannot use push_back() with number"`
+    @complexity Constant.
 
-    @complexity Logarithmic in the size of the container, O(log(`size()`)).
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
 
-    @liveexample{The example shows how `push_back()` and `+=` can be used to
-    add elements to a JSON object. Note how the `null` value was silently
-    converted to a JSON object.,push_back__object_t__value}
+    @liveexample{The following code shows an example for `begin()`.,begin}
+
+    @sa @ref cbegin() -- returns a const iterator to the beginning
+    @sa @ref end() -- returns an iterator to the end
+    @sa @ref cend() -- returns a const iterator to the end
 
     @since version 1.0.0
     */
-    void push_back(const typename object_t::value_type& val)
+    iterator begin() noexcept
     {
-        // push_back only works for null objects or objects
-        if (not(is_null() or is_object()))
-        {
-            throw std::domain_error("cannot use push_back() with " + type_name());
-        }
-
-        // transform null object into an object
-        if (is_null())
-        {
-            m_type = value_t::object;
-            m_value = value_t::object;
-        }
-
-        // add element to array
-        assert(m_value.object != nullptr);
-        m_value.object->insert(val);
+        iterator result(this);
+        result.set_begin();
+        return result;
     }
 
     /*!
-    @brief add an object to an object
-    @copydoc push_back(const typename object_t::value_type&)
+    @copydoc basic_json::cbegin()
     */
-    reference operator+=(const typename object_t::value_type& val)
+    const_iterator begin() const noexcept
     {
-        push_back(val);
-        return *this;
+        return cbegin();
     }
 
     /*!
-    @brief add an object to an object
+    @brief returns a const iterator to the first element
 
-    This function allows to use `push_back` with an initializer list. In case
+    Returns a const iterator to the first element.
 
-    1. the current value is an object,
-    2. the initializer list @a init contains only two elements, and
-    3. the first element of @a init is a string,
+    @image html range-begin-end.svg "Illustration from cppreference.com"
 
-    @a init is converted into an object element and added using
-    @ref push_back(const typename object_t::value_type&). Otherwise, @a init
-    is converted to a JSON value and added using @ref push_back(basic_json&&).
+    @return const iterator to the first element
 
-    @param init  an initializer list
+    @complexity Constant.
 
-    @complexity Linear in the size of the initializer list @a init.
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `const_cast<const basic_json&>(*this).begin()`.
 
-    @note This function is required to resolve an ambiguous overload error,
-          because pairs like `{"key", "value"}` can be both interpreted as
-          `object_t::value_type` or `std::initializer_list<basic_json>`, see
-          https://github.com/nlohmann/json/issues/235 for more information.
+    @liveexample{The following code shows an example for `cbegin()`.,cbegin}
 
-    @liveexample{The example shows how initializer lists are treated as
-    objects when possible.,push_back__initializer_list}
+    @sa @ref begin() -- returns an iterator to the beginning
+    @sa @ref end() -- returns an iterator to the end
+    @sa @ref cend() -- returns a const iterator to the end
+
+    @since version 1.0.0
     */
-    void push_back(std::initializer_list<basic_json> init)
+    const_iterator cbegin() const noexcept
     {
-        if (is_object() and init.size() == 2 and init.begin()->is_string())
-        {
-            const string_t key = *init.begin();
-            push_back(typename object_t::value_type(key, *(init.begin() + 1)));
-        }
-        else
-        {
-            push_back(basic_json(init));
-        }
+        const_iterator result(this);
+        result.set_begin();
+        return result;
     }
 
     /*!
-    @brief add an object to an object
-    @copydoc push_back(std::initializer_list<basic_json>)
-    */
-    reference operator+=(std::initializer_list<basic_json> init)
-    {
-        push_back(init);
-        return *this;
-    }
+    @brief returns an iterator to one past the last element
 
-    /*!
-    @brief inserts element
+    Returns an iterator to one past the last element.
 
-    Inserts element @a val before iterator @a pos.
+    @image html range-begin-end.svg "Illustration from cppreference.com"
 
-    @param[in] pos iterator before which the content will be inserted; may be
-    the end() iterator
-    @param[in] val element to insert
-    @return iterator pointing to the inserted @a val.
+    @return iterator one past the last element
 
-    @throw std::domain_error if called on JSON values other than arrays;
-    example: `"cannot use insert() with string"`
-    @throw std::domain_error if @a pos is not an iterator of *this; example:
-    `"iterator does not fit current value"`
+    @complexity Constant.
 
-    @complexity Constant plus linear in the distance between pos and end of the
-    container.
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
 
-    @liveexample{The example shows how `insert()` is used.,insert}
+    @liveexample{The following code shows an example for `end()`.,end}
+
+    @sa @ref cend() -- returns a const iterator to the end
+    @sa @ref begin() -- returns an iterator to the beginning
+    @sa @ref cbegin() -- returns a const iterator to the beginning
 
     @since version 1.0.0
     */
-    iterator insert(const_iterator pos, const basic_json& val)
+    iterator end() noexcept
     {
-        // insert only works for arrays
-        if (is_array())
-        {
-            // check if iterator pos fits to this JSON value
-            if (pos.m_object != this)
-            {
-                throw std::domain_error("iterator does not fit current value");
-            }
-
-            // insert to array and return iterator
-            iterator result(this);
-            assert(m_value.array != nullptr);
-            result.m_it.array_iterator = m_value.array->insert(pos.m_it.array_iterator, val);
-            return result;
-        }
-        else
-        {
-            throw std::domain_error("cannot use insert() with " + type_name());
-        }
+        iterator result(this);
+        result.set_end();
+        return result;
     }
 
     /*!
-    @brief inserts element
-    @copydoc insert(const_iterator, const basic_json&)
+    @copydoc basic_json::cend()
     */
-    iterator insert(const_iterator pos, basic_json&& val)
+    const_iterator end() const noexcept
     {
-        return insert(pos, val);
+        return cend();
     }
 
     /*!
-    @brief inserts elements
+    @brief returns a const iterator to one past the last element
 
-    Inserts @a cnt copies of @a val before iterator @a pos.
+    Returns a const iterator to one past the last element.
 
-    @param[in] pos iterator before which the content will be inserted; may be
-    the end() iterator
-    @param[in] cnt number of copies of @a val to insert
-    @param[in] val element to insert
-    @return iterator pointing to the first element inserted, or @a pos if
-    `cnt==0`
+    @image html range-begin-end.svg "Illustration from cppreference.com"
 
-    @throw std::domain_error if called on JSON values other than arrays;
-    example: `"cannot use insert() with string"`
-    @throw std::domain_error if @a pos is not an iterator of *this; example:
-    `"iterator does not fit current value"`
+    @return const iterator one past the last element
 
-    @complexity Linear in @a cnt plus linear in the distance between @a pos
-    and end of the container.
+    @complexity Constant.
 
-    @liveexample{The example shows how `insert()` is used.,insert__count}
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `const_cast<const basic_json&>(*this).end()`.
+
+    @liveexample{The following code shows an example for `cend()`.,cend}
+
+    @sa @ref end() -- returns an iterator to the end
+    @sa @ref begin() -- returns an iterator to the beginning
+    @sa @ref cbegin() -- returns a const iterator to the beginning
 
     @since version 1.0.0
     */
-    iterator insert(const_iterator pos, size_type cnt, const basic_json& val)
+    const_iterator cend() const noexcept
     {
-        // insert only works for arrays
-        if (is_array())
-        {
-            // check if iterator pos fits to this JSON value
-            if (pos.m_object != this)
-            {
-                throw std::domain_error("iterator does not fit current value");
-            }
-
-            // insert to array and return iterator
-            iterator result(this);
-            assert(m_value.array != nullptr);
-            result.m_it.array_iterator = m_value.array->insert(pos.m_it.array_iterator, cnt, val);
-            return result;
-        }
-        else
-        {
-            throw std::domain_error("cannot use insert() with " + type_name());
-        }
+        const_iterator result(this);
+        result.set_end();
+        return result;
     }
 
     /*!
-    @brief inserts elements
+    @brief returns an iterator to the reverse-beginning
 
-    Inserts elements from range `[first, last)` before iterator @a pos.
+    Returns an iterator to the reverse-beginning; that is, the last element.
 
-    @param[in] pos iterator before which the content will be inserted; may be
-    the end() iterator
-    @param[in] first begin of the range of elements to insert
-    @param[in] last end of the range of elements to insert
+    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
 
-    @throw std::domain_error if called on JSON values other than arrays;
-    example: `"cannot use insert() with string"`
-    @throw std::domain_error if @a pos is not an iterator of *this; example:
-    `"iterator does not fit current value"`
-    @throw std::domain_error if @a first and @a last do not belong to the same
-    JSON value; example: `"iterators do not fit"`
-    @throw std::domain_error if @a first or @a last are iterators into
-    container for which insert is called; example: `"passed iterators may not
-    belong to container"`
+    @complexity Constant.
 
-    @return iterator pointing to the first element inserted, or @a pos if
-    `first==last`
+    @requirement This function helps `basic_json` satisfying the
+    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `reverse_iterator(end())`.
 
-    @complexity Linear in `std::distance(first, last)` plus linear in the
-    distance between @a pos and end of the container.
+    @liveexample{The following code shows an example for `rbegin()`.,rbegin}
 
-    @liveexample{The example shows how `insert()` is used.,insert__range}
+    @sa @ref crbegin() -- returns a const reverse iterator to the beginning
+    @sa @ref rend() -- returns a reverse iterator to the end
+    @sa @ref crend() -- returns a const reverse iterator to the end
 
     @since version 1.0.0
     */
-    iterator insert(const_iterator pos, const_iterator first, const_iterator last)
+    reverse_iterator rbegin() noexcept
     {
-        // insert only works for arrays
-        if (not is_array())
-        {
-            throw std::domain_error("cannot use insert() with " + type_name());
-        }
-
-        // check if iterator pos fits to this JSON value
-        if (pos.m_object != this)
-        {
-            throw std::domain_error("iterator does not fit current value");
-        }
-
-        // check if range iterators belong to the same JSON object
-        if (first.m_object != last.m_object)
-        {
-            throw std::domain_error("iterators do not fit");
-        }
-
-        if (first.m_object == this or last.m_object == this)
-        {
-            throw std::domain_error("passed iterators may not belong to container");
-        }
+        return reverse_iterator(end());
+    }
 
-        // insert to array and return iterator
-        iterator result(this);
-        assert(m_value.array != nullptr);
-        result.m_it.array_iterator = m_value.array->insert(
-                                         pos.m_it.array_iterator,
-                                         first.m_it.array_iterator,
-                                         last.m_it.array_iterator);
-        return result;
+    /*!
+    @copydoc basic_json::crbegin()
+    */
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return crbegin();
     }
 
     /*!
-    @brief inserts elements
+    @brief returns an iterator to the reverse-end
 
-    Inserts elements from initializer list @a ilist before iterator @a pos.
+    Returns an iterator to the reverse-end; that is, one before the first
+    element.
 
-    @param[in] pos iterator before which the content will be inserted; may be
-    the end() iterator
-    @param[in] ilist initializer list to insert the values from
+    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
 
-    @throw std::domain_error if called on JSON values other than arrays;
-    example: `"cannot use insert() with string"`
-    @throw std::domain_error if @a pos is not an iterator of *this; example:
-    `"iterator does not fit current value"`
+    @complexity Constant.
 
-    @return iterator pointing to the first element inserted, or @a pos if
-    `ilist` is empty
+    @requirement This function helps `basic_json` satisfying the
+    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `reverse_iterator(begin())`.
 
-    @complexity Linear in `ilist.size()` plus linear in the distance between
-    @a pos and end of the container.
+    @liveexample{The following code shows an example for `rend()`.,rend}
 
-    @liveexample{The example shows how `insert()` is used.,insert__ilist}
+    @sa @ref crend() -- returns a const reverse iterator to the end
+    @sa @ref rbegin() -- returns a reverse iterator to the beginning
+    @sa @ref crbegin() -- returns a const reverse iterator to the beginning
 
     @since version 1.0.0
     */
-    iterator insert(const_iterator pos, std::initializer_list<basic_json> ilist)
+    reverse_iterator rend() noexcept
     {
-        // insert only works for arrays
-        if (not is_array())
-        {
-            throw std::domain_error("cannot use insert() with " + type_name());
-        }
-
-        // check if iterator pos fits to this JSON value
-        if (pos.m_object != this)
-        {
-            throw std::domain_error("iterator does not fit current value");
-        }
+        return reverse_iterator(begin());
+    }
 
-        // insert to array and return iterator
-        iterator result(this);
-        assert(m_value.array != nullptr);
-        result.m_it.array_iterator = m_value.array->insert(pos.m_it.array_iterator, ilist);
-        return result;
+    /*!
+    @copydoc basic_json::crend()
+    */
+    const_reverse_iterator rend() const noexcept
+    {
+        return crend();
     }
 
     /*!
-    @brief exchanges the values
+    @brief returns a const reverse iterator to the last element
 
-    Exchanges the contents of the JSON value with those of @a other. Does not
-    invoke any move, copy, or swap operations on individual elements. All
-    iterators and references remain valid. The past-the-end iterator is
-    invalidated.
+    Returns a const iterator to the reverse-beginning; that is, the last
+    element.
 
-    @param[in,out] other JSON value to exchange the contents with
+    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
 
     @complexity Constant.
 
-    @liveexample{The example below shows how JSON values can be swapped with
-    `swap()`.,swap__reference}
+    @requirement This function helps `basic_json` satisfying the
+    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `const_cast<const basic_json&>(*this).rbegin()`.
+
+    @liveexample{The following code shows an example for `crbegin()`.,crbegin}
+
+    @sa @ref rbegin() -- returns a reverse iterator to the beginning
+    @sa @ref rend() -- returns a reverse iterator to the end
+    @sa @ref crend() -- returns a const reverse iterator to the end
 
     @since version 1.0.0
     */
-    void swap(reference other) noexcept (
-        std::is_nothrow_move_constructible<value_t>::value and
-        std::is_nothrow_move_assignable<value_t>::value and
-        std::is_nothrow_move_constructible<json_value>::value and
-        std::is_nothrow_move_assignable<json_value>::value
-    )
+    const_reverse_iterator crbegin() const noexcept
     {
-        std::swap(m_type, other.m_type);
-        std::swap(m_value, other.m_value);
+        return const_reverse_iterator(cend());
     }
 
     /*!
-    @brief exchanges the values
-
-    Exchanges the contents of a JSON array with those of @a other. Does not
-    invoke any move, copy, or swap operations on individual elements. All
-    iterators and references remain valid. The past-the-end iterator is
-    invalidated.
+    @brief returns a const reverse iterator to one before the first
 
-    @param[in,out] other array to exchange the contents with
+    Returns a const reverse iterator to the reverse-end; that is, one before
+    the first element.
 
-    @throw std::domain_error when JSON value is not an array; example: `"cannot
-    use swap() with string"`
+    @image html range-rbegin-rend.svg "Illustration from cppreference.com"
 
     @complexity Constant.
 
-    @liveexample{The example below shows how arrays can be swapped with
-    `swap()`.,swap__array_t}
+    @requirement This function helps `basic_json` satisfying the
+    [ReversibleContainer](http://en.cppreference.com/w/cpp/concept/ReversibleContainer)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `const_cast<const basic_json&>(*this).rend()`.
+
+    @liveexample{The following code shows an example for `crend()`.,crend}
+
+    @sa @ref rend() -- returns a reverse iterator to the end
+    @sa @ref rbegin() -- returns a reverse iterator to the beginning
+    @sa @ref crbegin() -- returns a const reverse iterator to the beginning
 
     @since version 1.0.0
     */
-    void swap(array_t& other)
+    const_reverse_iterator crend() const noexcept
     {
-        // swap only works for arrays
-        if (is_array())
-        {
-            assert(m_value.array != nullptr);
-            std::swap(*(m_value.array), other);
-        }
-        else
-        {
-            throw std::domain_error("cannot use swap() with " + type_name());
-        }
+        return const_reverse_iterator(cbegin());
     }
 
-    /*!
-    @brief exchanges the values
-
-    Exchanges the contents of a JSON object with those of @a other. Does not
-    invoke any move, copy, or swap operations on individual elements. All
-    iterators and references remain valid. The past-the-end iterator is
-    invalidated.
-
-    @param[in,out] other object to exchange the contents with
-
-    @throw std::domain_error when JSON value is not an object; example:
-    `"cannot use swap() with string"`
+  private:
+    // forward declaration
+    template<typename IteratorType> class iteration_proxy;
 
-    @complexity Constant.
+  public:
+    /*!
+    @brief wrapper to access iterator member functions in range-based for
 
-    @liveexample{The example below shows how objects can be swapped with
-    `swap()`.,swap__object_t}
+    This function allows to access @ref iterator::key() and @ref
+    iterator::value() during range-based for loops. In these loops, a
+    reference to the JSON values is returned, so there is no access to the
+    underlying iterator.
 
-    @since version 1.0.0
+    @note The name of this function is not yet final and may change in the
+    future.
     */
-    void swap(object_t& other)
+    static iteration_proxy<iterator> iterator_wrapper(reference cont)
     {
-        // swap only works for objects
-        if (is_object())
-        {
-            assert(m_value.object != nullptr);
-            std::swap(*(m_value.object), other);
-        }
-        else
-        {
-            throw std::domain_error("cannot use swap() with " + type_name());
-        }
+        return iteration_proxy<iterator>(cont);
     }
 
     /*!
-    @brief exchanges the values
-
-    Exchanges the contents of a JSON string with those of @a other. Does not
-    invoke any move, copy, or swap operations on individual elements. All
-    iterators and references remain valid. The past-the-end iterator is
-    invalidated.
-
-    @param[in,out] other string to exchange the contents with
-
-    @throw std::domain_error when JSON value is not a string; example: `"cannot
-    use swap() with boolean"`
-
-    @complexity Constant.
-
-    @liveexample{The example below shows how strings can be swapped with
-    `swap()`.,swap__string_t}
-
-    @since version 1.0.0
+    @copydoc iterator_wrapper(reference)
     */
-    void swap(string_t& other)
+    static iteration_proxy<const_iterator> iterator_wrapper(const_reference cont)
     {
-        // swap only works for strings
-        if (is_string())
-        {
-            assert(m_value.string != nullptr);
-            std::swap(*(m_value.string), other);
-        }
-        else
-        {
-            throw std::domain_error("cannot use swap() with " + type_name());
-        }
+        return iteration_proxy<const_iterator>(cont);
     }
 
     /// @}
 
 
-    //////////////////////////////////////////
-    // lexicographical comparison operators //
-    //////////////////////////////////////////
+    //////////////
+    // capacity //
+    //////////////
 
-    /// @name lexicographical comparison operators
+    /// @name capacity
     /// @{
 
-  private:
     /*!
-    @brief comparison operator for JSON types
+    @brief checks whether the container is empty
 
-    Returns an ordering that is similar to Python:
-    - order: null < boolean < number < object < array < string
-    - furthermore, each type is not smaller than itself
+    Checks if a JSON value has no elements.
+
+    @return The return value depends on the different types and is
+            defined as follows:
+            Value type  | return value
+            ----------- | -------------
+            null        | `true`
+            boolean     | `false`
+            string      | `false`
+            number      | `false`
+            object      | result of function `object_t::empty()`
+            array       | result of function `array_t::empty()`
+
+    @complexity Constant, as long as @ref array_t and @ref object_t satisfy
+    the Container concept; that is, their `empty()` functions have constant
+    complexity.
+
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `begin() == end()`.
+
+    @liveexample{The following code uses `empty()` to check if a JSON
+    object contains any elements.,empty}
+
+    @sa @ref size() -- returns the number of elements
 
     @since version 1.0.0
     */
-    friend bool operator<(const value_t lhs, const value_t rhs) noexcept
+    bool empty() const noexcept
     {
-        static constexpr std::array<uint8_t, 8> order = {{
-                0, // null
-                3, // object
-                4, // array
-                5, // string
-                1, // boolean
-                2, // integer
-                2, // unsigned
-                2, // float
+        switch (m_type)
+        {
+            case value_t::null:
+            {
+                // null values are empty
+                return true;
             }
-        };
 
-        // discarded values are not comparable
-        if (lhs == value_t::discarded or rhs == value_t::discarded)
-        {
-            return false;
-        }
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+                return m_value.array->empty();
+            }
 
-        return order[static_cast<std::size_t>(lhs)] < order[static_cast<std::size_t>(rhs)];
+            case value_t::object:
+            {
+                assert(m_value.object != nullptr);
+                return m_value.object->empty();
+            }
+
+            default:
+            {
+                // all other types are nonempty
+                return false;
+            }
+        }
     }
 
-  public:
     /*!
-    @brief comparison: equal
+    @brief returns the number of elements
 
-    Compares two JSON values for equality according to the following rules:
-    - Two JSON values are equal if (1) they are from the same type and (2)
-      their stored values are the same.
-    - Integer and floating-point numbers are automatically converted before
-      comparison. Floating-point numbers are compared indirectly: two
-      floating-point numbers `f1` and `f2` are considered equal if neither
-      `f1 > f2` nor `f2 > f1` holds.
-    - Two JSON null values are equal.
+    Returns the number of elements in a JSON value.
 
-    @param[in] lhs  first JSON value to consider
-    @param[in] rhs  second JSON value to consider
-    @return whether the values @a lhs and @a rhs are equal
+    @return The return value depends on the different types and is
+            defined as follows:
+            Value type  | return value
+            ----------- | -------------
+            null        | `0`
+            boolean     | `1`
+            string      | `1`
+            number      | `1`
+            object      | result of function object_t::size()
+            array       | result of function array_t::size()
 
-    @complexity Linear.
+    @complexity Constant, as long as @ref array_t and @ref object_t satisfy
+    the Container concept; that is, their size() functions have constant
+    complexity.
 
-    @liveexample{The example demonstrates comparing several JSON
-    types.,operator__equal}
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of `std::distance(begin(), end())`.
 
-    @since version 1.0.0
-    */
-    friend bool operator==(const_reference lhs, const_reference rhs) noexcept
-    {
-        const auto lhs_type = lhs.type();
-        const auto rhs_type = rhs.type();
+    @liveexample{The following code calls `size()` on the different value
+    types.,size}
 
-        if (lhs_type == rhs_type)
+    @sa @ref empty() -- checks whether the container is empty
+    @sa @ref max_size() -- returns the maximal number of elements
+
+    @since version 1.0.0
+    */
+    size_type size() const noexcept
+    {
+        switch (m_type)
         {
-            switch (lhs_type)
+            case value_t::null:
             {
-                case value_t::array:
-                {
-                    assert(lhs.m_value.array != nullptr);
-                    assert(rhs.m_value.array != nullptr);
-                    return *lhs.m_value.array == *rhs.m_value.array;
-                }
-                case value_t::object:
-                {
-                    assert(lhs.m_value.object != nullptr);
-                    assert(rhs.m_value.object != nullptr);
-                    return *lhs.m_value.object == *rhs.m_value.object;
-                }
-                case value_t::null:
-                {
-                    return true;
-                }
-                case value_t::string:
-                {
-                    assert(lhs.m_value.string != nullptr);
-                    assert(rhs.m_value.string != nullptr);
-                    return *lhs.m_value.string == *rhs.m_value.string;
-                }
-                case value_t::boolean:
-                {
-                    return lhs.m_value.boolean == rhs.m_value.boolean;
-                }
-                case value_t::number_integer:
-                {
-                    return lhs.m_value.number_integer == rhs.m_value.number_integer;
-                }
-                case value_t::number_unsigned:
-                {
-                    return lhs.m_value.number_unsigned == rhs.m_value.number_unsigned;
-                }
-                case value_t::number_float:
-                {
-                    return lhs.m_value.number_float == rhs.m_value.number_float;
-                }
-                default:
-                {
-                    return false;
-                }
+                // null values are empty
+                return 0;
             }
-        }
-        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_float)
-        {
-            return static_cast<number_float_t>(lhs.m_value.number_integer) == rhs.m_value.number_float;
-        }
-        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_integer)
-        {
-            return lhs.m_value.number_float == static_cast<number_float_t>(rhs.m_value.number_integer);
-        }
-        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_float)
-        {
-            return static_cast<number_float_t>(lhs.m_value.number_unsigned) == rhs.m_value.number_float;
-        }
-        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_unsigned)
-        {
-            return lhs.m_value.number_float == static_cast<number_float_t>(rhs.m_value.number_unsigned);
-        }
-        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_integer)
-        {
-            return static_cast<number_integer_t>(lhs.m_value.number_unsigned) == rhs.m_value.number_integer;
-        }
-        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_unsigned)
-        {
-            return lhs.m_value.number_integer == static_cast<number_integer_t>(rhs.m_value.number_unsigned);
-        }
-
-        return false;
-    }
-
-    /*!
-    @brief comparison: equal
-
-    The functions compares the given JSON value against a null pointer. As the
-    null pointer can be used to initialize a JSON value to null, a comparison
-    of JSON value @a v with a null pointer should be equivalent to call
-    `v.is_null()`.
-
-    @param[in] v  JSON value to consider
-    @return whether @a v is null
 
-    @complexity Constant.
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+                return m_value.array->size();
+            }
 
-    @liveexample{The example compares several JSON types to the null pointer.
-    ,operator__equal__nullptr_t}
+            case value_t::object:
+            {
+                assert(m_value.object != nullptr);
+                return m_value.object->size();
+            }
 
-    @since version 1.0.0
-    */
-    friend bool operator==(const_reference v, std::nullptr_t) noexcept
-    {
-        return v.is_null();
+            default:
+            {
+                // all other types have size 1
+                return 1;
+            }
+        }
     }
 
     /*!
-    @brief comparison: equal
-    @copydoc operator==(const_reference, std::nullptr_t)
-    */
-    friend bool operator==(std::nullptr_t, const_reference v) noexcept
-    {
-        return v.is_null();
-    }
+    @brief returns the maximum possible number of elements
 
-    /*!
-    @brief comparison: not equal
+    Returns the maximum number of elements a JSON value is able to hold due to
+    system or library implementation limitations, i.e. `std::distance(begin(),
+    end())` for the JSON value.
 
-    Compares two JSON values for inequality by calculating `not (lhs == rhs)`.
+    @return The return value depends on the different types and is
+            defined as follows:
+            Value type  | return value
+            ----------- | -------------
+            null        | `0` (same as `size()`)
+            boolean     | `1` (same as `size()`)
+            string      | `1` (same as `size()`)
+            number      | `1` (same as `size()`)
+            object      | result of function `object_t::max_size()`
+            array       | result of function `array_t::max_size()`
 
-    @param[in] lhs  first JSON value to consider
-    @param[in] rhs  second JSON value to consider
-    @return whether the values @a lhs and @a rhs are not equal
+    @complexity Constant, as long as @ref array_t and @ref object_t satisfy
+    the Container concept; that is, their `max_size()` functions have constant
+    complexity.
 
-    @complexity Linear.
+    @requirement This function helps `basic_json` satisfying the
+    [Container](http://en.cppreference.com/w/cpp/concept/Container)
+    requirements:
+    - The complexity is constant.
+    - Has the semantics of returning `b.size()` where `b` is the largest
+      possible JSON value.
 
-    @liveexample{The example demonstrates comparing several JSON
-    types.,operator__notequal}
+    @liveexample{The following code calls `max_size()` on the different value
+    types. Note the output is implementation specific.,max_size}
+
+    @sa @ref size() -- returns the number of elements
 
     @since version 1.0.0
     */
-    friend bool operator!=(const_reference lhs, const_reference rhs) noexcept
+    size_type max_size() const noexcept
     {
-        return not (lhs == rhs);
-    }
+        switch (m_type)
+        {
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+                return m_value.array->max_size();
+            }
 
-    /*!
-    @brief comparison: not equal
+            case value_t::object:
+            {
+                assert(m_value.object != nullptr);
+                return m_value.object->max_size();
+            }
 
-    The functions compares the given JSON value against a null pointer. As the
-    null pointer can be used to initialize a JSON value to null, a comparison
-    of JSON value @a v with a null pointer should be equivalent to call
-    `not v.is_null()`.
+            default:
+            {
+                // all other types have max_size() == size()
+                return size();
+            }
+        }
+    }
 
-    @param[in] v  JSON value to consider
-    @return whether @a v is not null
+    /// @}
 
-    @complexity Constant.
 
-    @liveexample{The example compares several JSON types to the null pointer.
-    ,operator__notequal__nullptr_t}
+    ///////////////
+    // modifiers //
+    ///////////////
 
-    @since version 1.0.0
-    */
-    friend bool operator!=(const_reference v, std::nullptr_t) noexcept
-    {
-        return not v.is_null();
-    }
+    /// @name modifiers
+    /// @{
 
     /*!
-    @brief comparison: not equal
-    @copydoc operator!=(const_reference, std::nullptr_t)
-    */
-    friend bool operator!=(std::nullptr_t, const_reference v) noexcept
-    {
-        return not v.is_null();
-    }
+    @brief clears the contents
 
-    /*!
-    @brief comparison: less than
+    Clears the content of a JSON value and resets it to the default value as
+    if @ref basic_json(value_t) would have been called:
 
-    Compares whether one JSON value @a lhs is less than another JSON value @a
-    rhs according to the following rules:
-    - If @a lhs and @a rhs have the same type, the values are compared using
-      the default `<` operator.
-    - Integer and floating-point numbers are automatically converted before
-      comparison
-    - In case @a lhs and @a rhs have different types, the values are ignored
-      and the order of the types is considered, see
-      @ref operator<(const value_t, const value_t).
+    Value type  | initial value
+    ----------- | -------------
+    null        | `null`
+    boolean     | `false`
+    string      | `""`
+    number      | `0`
+    object      | `{}`
+    array       | `[]`
 
-    @param[in] lhs  first JSON value to consider
-    @param[in] rhs  second JSON value to consider
-    @return whether @a lhs is less than @a rhs
+    @note Floating-point numbers are set to `0.0` which will be serialized to
+    `0`. The vale type remains @ref number_float_t.
 
-    @complexity Linear.
+    @complexity Linear in the size of the JSON value.
 
-    @liveexample{The example demonstrates comparing several JSON
-    types.,operator__less}
+    @liveexample{The example below shows the effect of `clear()` to different
+    JSON types.,clear}
 
     @since version 1.0.0
     */
-    friend bool operator<(const_reference lhs, const_reference rhs) noexcept
+    void clear() noexcept
     {
-        const auto lhs_type = lhs.type();
-        const auto rhs_type = rhs.type();
-
-        if (lhs_type == rhs_type)
+        switch (m_type)
         {
-            switch (lhs_type)
+            case value_t::number_integer:
             {
-                case value_t::array:
-                {
-                    assert(lhs.m_value.array != nullptr);
-                    assert(rhs.m_value.array != nullptr);
-                    return *lhs.m_value.array < *rhs.m_value.array;
-                }
-                case value_t::object:
-                {
-                    assert(lhs.m_value.object != nullptr);
-                    assert(rhs.m_value.object != nullptr);
-                    return *lhs.m_value.object < *rhs.m_value.object;
-                }
-                case value_t::null:
-                {
-                    return false;
-                }
-                case value_t::string:
-                {
-                    assert(lhs.m_value.string != nullptr);
-                    assert(rhs.m_value.string != nullptr);
-                    return *lhs.m_value.string < *rhs.m_value.string;
-                }
-                case value_t::boolean:
-                {
-                    return lhs.m_value.boolean < rhs.m_value.boolean;
-                }
-                case value_t::number_integer:
-                {
-                    return lhs.m_value.number_integer < rhs.m_value.number_integer;
-                }
-                case value_t::number_unsigned:
-                {
-                    return lhs.m_value.number_unsigned < rhs.m_value.number_unsigned;
-                }
-                case value_t::number_float:
-                {
-                    return lhs.m_value.number_float < rhs.m_value.number_float;
-                }
-                default:
-                {
-                    return false;
-                }
+                m_value.number_integer = 0;
+                break;
             }
-        }
-        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_float)
-        {
-            return static_cast<number_float_t>(lhs.m_value.number_integer) < rhs.m_value.number_float;
-        }
-        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_integer)
-        {
-            return lhs.m_value.number_float < static_cast<number_float_t>(rhs.m_value.number_integer);
-        }
-        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_float)
-        {
-            return static_cast<number_float_t>(lhs.m_value.number_unsigned) < rhs.m_value.number_float;
-        }
-        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_unsigned)
-        {
-            return lhs.m_value.number_float < static_cast<number_float_t>(rhs.m_value.number_unsigned);
-        }
-        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_unsigned)
-        {
-            return lhs.m_value.number_integer < static_cast<number_integer_t>(rhs.m_value.number_unsigned);
-        }
-        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_integer)
-        {
-            return static_cast<number_integer_t>(lhs.m_value.number_unsigned) < rhs.m_value.number_integer;
-        }
 
-        // We only reach this line if we cannot compare values. In that case,
-        // we compare types. Note we have to call the operator explicitly,
-        // because MSVC has problems otherwise.
-        return operator<(lhs_type, rhs_type);
-    }
+            case value_t::number_unsigned:
+            {
+                m_value.number_unsigned = 0;
+                break;
+            }
 
-    /*!
-    @brief comparison: less than or equal
+            case value_t::number_float:
+            {
+                m_value.number_float = 0.0;
+                break;
+            }
 
-    Compares whether one JSON value @a lhs is less than or equal to another
-    JSON value by calculating `not (rhs < lhs)`.
+            case value_t::boolean:
+            {
+                m_value.boolean = false;
+                break;
+            }
 
-    @param[in] lhs  first JSON value to consider
-    @param[in] rhs  second JSON value to consider
-    @return whether @a lhs is less than or equal to @a rhs
+            case value_t::string:
+            {
+                assert(m_value.string != nullptr);
+                m_value.string->clear();
+                break;
+            }
 
-    @complexity Linear.
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+                m_value.array->clear();
+                break;
+            }
 
-    @liveexample{The example demonstrates comparing several JSON
-    types.,operator__greater}
+            case value_t::object:
+            {
+                assert(m_value.object != nullptr);
+                m_value.object->clear();
+                break;
+            }
 
-    @since version 1.0.0
-    */
-    friend bool operator<=(const_reference lhs, const_reference rhs) noexcept
-    {
-        return not (rhs < lhs);
+            default:
+            {
+                break;
+            }
+        }
     }
 
     /*!
-    @brief comparison: greater than
+    @brief add an object to an array
 
-    Compares whether one JSON value @a lhs is greater than another
-    JSON value by calculating `not (lhs <= rhs)`.
+    Appends the given element @a val to the end of the JSON value. If the
+    function is called on a JSON null value, an empty array is created before
+    appending @a val.
 
-    @param[in] lhs  first JSON value to consider
-    @param[in] rhs  second JSON value to consider
-    @return whether @a lhs is greater than to @a rhs
+    @param[in] val the value to add to the JSON array
 
-    @complexity Linear.
+    @throw std::domain_error when called on a type other than JSON array or
+    null; example: `"cannot use push_back() with number"`
 
-    @liveexample{The example demonstrates comparing several JSON
-    types.,operator__lessequal}
+    @complexity Amortized constant.
+
+    @liveexample{The example shows how `push_back()` and `+=` can be used to
+    add elements to a JSON array. Note how the `null` value was silently
+    converted to a JSON array.,push_back}
 
     @since version 1.0.0
     */
-    friend bool operator>(const_reference lhs, const_reference rhs) noexcept
+    void push_back(basic_json&& val)
     {
-        return not (lhs <= rhs);
-    }
-
-    /*!
-    @brief comparison: greater than or equal
-
-    Compares whether one JSON value @a lhs is greater than or equal to another
-    JSON value by calculating `not (lhs < rhs)`.
-
-    @param[in] lhs  first JSON value to consider
-    @param[in] rhs  second JSON value to consider
-    @return whether @a lhs is greater than or equal to @a rhs
+        // push_back only works for null objects or arrays
+        if (not(is_null() or is_array()))
+        {
+            throw std::domain_error("cannot use push_back() with " + type_name());
+        }
 
-    @complexity Linear.
+        // transform null object into an array
+        if (is_null())
+        {
+            m_type = value_t::array;
+            m_value = value_t::array;
+        }
 
-    @liveexample{The example demonstrates comparing several JSON
-    types.,operator__greaterequal}
+        // add element to array (move semantics)
+        assert(m_value.array != nullptr);
+        m_value.array->push_back(std::move(val));
+        // invalidate object
+        val.m_type = value_t::null;
+    }
 
-    @since version 1.0.0
+    /*!
+    @brief add an object to an array
+    @copydoc push_back(basic_json&&)
     */
-    friend bool operator>=(const_reference lhs, const_reference rhs) noexcept
+    reference operator+=(basic_json&& val)
     {
-        return not (lhs < rhs);
+        push_back(std::move(val));
+        return *this;
     }
 
-    /// @}
+    /*!
+    @brief add an object to an array
+    @copydoc push_back(basic_json&&)
+    */
+    void push_back(const basic_json& val)
+    {
+        // push_back only works for null objects or arrays
+        if (not(is_null() or is_array()))
+        {
+            throw std::domain_error("cannot use push_back() with " + type_name());
+        }
 
+        // transform null object into an array
+        if (is_null())
+        {
+            m_type = value_t::array;
+            m_value = value_t::array;
+        }
 
-    ///////////////////
-    // serialization //
-    ///////////////////
+        // add element to array
+        assert(m_value.array != nullptr);
+        m_value.array->push_back(val);
+    }
 
-    /// @name serialization
-    /// @{
+    /*!
+    @brief add an object to an array
+    @copydoc push_back(basic_json&&)
+    */
+    reference operator+=(const basic_json& val)
+    {
+        push_back(val);
+        return *this;
+    }
 
     /*!
-    @brief serialize to stream
+    @brief add an object to an object
 
-    Serialize the given JSON value @a j to the output stream @a o. The JSON
-    value will be serialized using the @ref dump member function. The
-    indentation of the output can be controlled with the member variable
-    `width` of the output stream @a o. For instance, using the manipulator
-    `std::setw(4)` on @a o sets the indentation level to `4` and the
-    serialization result is the same as calling `dump(4)`.
+    Inserts the given element @a val to the JSON object. If the function is
+    called on a JSON null value, an empty object is created before inserting
+    @a val.
 
-    @param[in,out] o  stream to serialize to
-    @param[in] j  JSON value to serialize
+    @param[in] val the value to add to the JSON object
 
-    @return the stream @a o
+    @throw std::domain_error when called on a type other than JSON object or
+    null; example: `"cannot use push_back() with number"`
 
-    @complexity Linear.
+    @complexity Logarithmic in the size of the container, O(log(`size()`)).
 
-    @liveexample{The example below shows the serialization with different
-    parameters to `width` to adjust the indentation level.,operator_serialize}
+    @liveexample{The example shows how `push_back()` and `+=` can be used to
+    add elements to a JSON object. Note how the `null` value was silently
+    converted to a JSON object.,push_back__object_t__value}
 
     @since version 1.0.0
     */
-    friend std::ostream& operator<<(std::ostream& o, const basic_json& j)
+    void push_back(const typename object_t::value_type& val)
     {
-        // read width member and use it as indentation parameter if nonzero
-        const bool pretty_print = (o.width() > 0);
-        const auto indentation = (pretty_print ? o.width() : 0);
-
-        // reset width to 0 for subsequent calls to this stream
-        o.width(0);
-        // fix locale problems
-        auto old_locale = o.imbue(std::locale(std::locale(), new DecimalSeparator));
+        // push_back only works for null objects or objects
+        if (not(is_null() or is_object()))
+        {
+            throw std::domain_error("cannot use push_back() with " + type_name());
+        }
 
-        // do the actual serialization
-        j.dump(o, pretty_print, static_cast<unsigned int>(indentation));
+        // transform null object into an object
+        if (is_null())
+        {
+            m_type = value_t::object;
+            m_value = value_t::object;
+        }
 
-        // reset locale
-        o.imbue(old_locale);
-        return o;
+        // add element to array
+        assert(m_value.object != nullptr);
+        m_value.object->insert(val);
     }
 
     /*!
-    @brief serialize to stream
-    @copydoc operator<<(std::ostream&, const basic_json&)
+    @brief add an object to an object
+    @copydoc push_back(const typename object_t::value_type&)
     */
-    friend std::ostream& operator>>(const basic_json& j, std::ostream& o)
+    reference operator+=(const typename object_t::value_type& val)
     {
-        return o << j;
+        push_back(val);
+        return *this;
     }
 
-    /// @}
-
-
-    /////////////////////
-    // deserialization //
-    /////////////////////
-
-    /// @name deserialization
-    /// @{
-
     /*!
-    @brief deserialize from string
+    @brief add an object to an object
 
-    @param[in] s  string to read a serialized JSON value from
-    @param[in] cb a parser callback function of type @ref parser_callback_t
-    which is used to control the deserialization by filtering unwanted values
-    (optional)
+    This function allows to use `push_back` with an initializer list. In case
 
-    @return result of the deserialization
+    1. the current value is an object,
+    2. the initializer list @a init contains only two elements, and
+    3. the first element of @a init is a string,
 
-    @complexity Linear in the length of the input. The parser is a predictive
-    LL(1) parser. The complexity can be higher if the parser callback function
-    @a cb has a super-linear complexity.
+    @a init is converted into an object element and added using
+    @ref push_back(const typename object_t::value_type&). Otherwise, @a init
+    is converted to a JSON value and added using @ref push_back(basic_json&&).
 
-    @note A UTF-8 byte order mark is silently ignored.
+    @param init  an initializer list
 
-    @liveexample{The example below demonstrates the `parse()` function with
-    and without callback function.,parse__string__parser_callback_t}
+    @complexity Linear in the size of the initializer list @a init.
 
-    @sa @ref parse(std::istream&, parser_callback_t) for a version that reads
-    from an input stream
+    @note This function is required to resolve an ambiguous overload error,
+          because pairs like `{"key", "value"}` can be both interpreted as
+          `object_t::value_type` or `std::initializer_list<basic_json>`, see
+          https://github.com/nlohmann/json/issues/235 for more information.
 
-    @since version 1.0.0
+    @liveexample{The example shows how initializer lists are treated as
+    objects when possible.,push_back__initializer_list}
     */
-    static basic_json parse(const string_t& s, parser_callback_t cb = nullptr)
+    void push_back(std::initializer_list<basic_json> init)
     {
-        return parser(s, cb).parse();
+        if (is_object() and init.size() == 2 and init.begin()->is_string())
+        {
+            const string_t key = *init.begin();
+            push_back(typename object_t::value_type(key, *(init.begin() + 1)));
+        }
+        else
+        {
+            push_back(basic_json(init));
+        }
     }
 
     /*!
-    @brief deserialize from stream
+    @brief add an object to an object
+    @copydoc push_back(std::initializer_list<basic_json>)
+    */
+    reference operator+=(std::initializer_list<basic_json> init)
+    {
+        push_back(init);
+        return *this;
+    }
 
-    @param[in,out] i  stream to read a serialized JSON value from
-    @param[in] cb a parser callback function of type @ref parser_callback_t
-    which is used to control the deserialization by filtering unwanted values
-    (optional)
+    /*!
+    @brief inserts element
 
-    @return result of the deserialization
+    Inserts element @a val before iterator @a pos.
 
-    @complexity Linear in the length of the input. The parser is a predictive
-    LL(1) parser. The complexity can be higher if the parser callback function
-    @a cb has a super-linear complexity.
+    @param[in] pos iterator before which the content will be inserted; may be
+    the end() iterator
+    @param[in] val element to insert
+    @return iterator pointing to the inserted @a val.
 
-    @note A UTF-8 byte order mark is silently ignored.
+    @throw std::domain_error if called on JSON values other than arrays;
+    example: `"cannot use insert() with string"`
+    @throw std::domain_error if @a pos is not an iterator of *this; example:
+    `"iterator does not fit current value"`
 
-    @liveexample{The example below demonstrates the `parse()` function with
-    and without callback function.,parse__istream__parser_callback_t}
+    @complexity Constant plus linear in the distance between pos and end of the
+    container.
 
-    @sa @ref parse(const string_t&, parser_callback_t) for a version that
-    reads from a string
+    @liveexample{The example shows how `insert()` is used.,insert}
 
     @since version 1.0.0
     */
-    static basic_json parse(std::istream& i, parser_callback_t cb = nullptr)
+    iterator insert(const_iterator pos, const basic_json& val)
     {
-        return parser(i, cb).parse();
+        // insert only works for arrays
+        if (is_array())
+        {
+            // check if iterator pos fits to this JSON value
+            if (pos.m_object != this)
+            {
+                throw std::domain_error("iterator does not fit current value");
+            }
+
+            // insert to array and return iterator
+            iterator result(this);
+            assert(m_value.array != nullptr);
+            result.m_it.array_iterator = m_value.array->insert(pos.m_it.array_iterator, val);
+            return result;
+        }
+        else
+        {
+            throw std::domain_error("cannot use insert() with " + type_name());
+        }
     }
 
     /*!
-    @copydoc parse(std::istream&, parser_callback_t)
+    @brief inserts element
+    @copydoc insert(const_iterator, const basic_json&)
     */
-    static basic_json parse(std::istream&& i, parser_callback_t cb = nullptr)
+    iterator insert(const_iterator pos, basic_json&& val)
     {
-        return parser(i, cb).parse();
+        return insert(pos, val);
     }
 
     /*!
-    @brief deserialize from stream
-
-    Deserializes an input stream to a JSON value.
-
-    @param[in,out] i  input stream to read a serialized JSON value from
-    @param[in,out] j  JSON value to write the deserialized input to
+    @brief inserts elements
 
-    @throw std::invalid_argument in case of parse errors
+    Inserts @a cnt copies of @a val before iterator @a pos.
 
-    @complexity Linear in the length of the input. The parser is a predictive
-    LL(1) parser.
+    @param[in] pos iterator before which the content will be inserted; may be
+    the end() iterator
+    @param[in] cnt number of copies of @a val to insert
+    @param[in] val element to insert
+    @return iterator pointing to the first element inserted, or @a pos if
+    `cnt==0`
 
-    @note A UTF-8 byte order mark is silently ignored.
+    @throw std::domain_error if called on JSON values other than arrays;
+    example: `"cannot use insert() with string"`
+    @throw std::domain_error if @a pos is not an iterator of *this; example:
+    `"iterator does not fit current value"`
 
-    @liveexample{The example below shows how a JSON value is constructed by
-    reading a serialization from a stream.,operator_deserialize}
+    @complexity Linear in @a cnt plus linear in the distance between @a pos
+    and end of the container.
 
-    @sa parse(std::istream&, parser_callback_t) for a variant with a parser
-    callback function to filter values while parsing
+    @liveexample{The example shows how `insert()` is used.,insert__count}
 
     @since version 1.0.0
     */
-    friend std::istream& operator<<(basic_json& j, std::istream& i)
-    {
-        j = parser(i).parse();
-        return i;
-    }
-
-    /*!
-    @brief deserialize from stream
-    @copydoc operator<<(basic_json&, std::istream&)
-    */
-    friend std::istream& operator>>(std::istream& i, basic_json& j)
+    iterator insert(const_iterator pos, size_type cnt, const basic_json& val)
     {
-        j = parser(i).parse();
-        return i;
-    }
-
-    /// @}
-
-
-  private:
-    ///////////////////////////
-    // convenience functions //
-    ///////////////////////////
+        // insert only works for arrays
+        if (is_array())
+        {
+            // check if iterator pos fits to this JSON value
+            if (pos.m_object != this)
+            {
+                throw std::domain_error("iterator does not fit current value");
+            }
 
-    /// return the type as string
-    string_t type_name() const noexcept
-    {
-        switch (m_type)
+            // insert to array and return iterator
+            iterator result(this);
+            assert(m_value.array != nullptr);
+            result.m_it.array_iterator = m_value.array->insert(pos.m_it.array_iterator, cnt, val);
+            return result;
+        }
+        else
         {
-            case value_t::null:
-                return "null";
-            case value_t::object:
-                return "object";
-            case value_t::array:
-                return "array";
-            case value_t::string:
-                return "string";
-            case value_t::boolean:
-                return "boolean";
-            case value_t::discarded:
-                return "discarded";
-            default:
-                return "number";
+            throw std::domain_error("cannot use insert() with " + type_name());
         }
     }
 
     /*!
-    @brief calculates the extra space to escape a JSON string
+    @brief inserts elements
 
-    @param[in] s  the string to escape
-    @return the number of characters required to escape string @a s
+    Inserts elements from range `[first, last)` before iterator @a pos.
 
-    @complexity Linear in the length of string @a s.
-    */
-    static std::size_t extra_space(const string_t& s) noexcept
-    {
-        std::size_t result = 0;
+    @param[in] pos iterator before which the content will be inserted; may be
+    the end() iterator
+    @param[in] first begin of the range of elements to insert
+    @param[in] last end of the range of elements to insert
 
-        for (const auto& c : s)
-        {
-            switch (c)
-            {
-                case '"':
-                case '\\':
-                case '\b':
-                case '\f':
-                case '\n':
-                case '\r':
-                case '\t':
-                {
-                    // from c (1 byte) to \x (2 bytes)
-                    result += 1;
-                    break;
-                }
-
-                default:
-                {
-                    if (c >= 0x00 and c <= 0x1f)
-                    {
-                        // from c (1 byte) to \uxxxx (6 bytes)
-                        result += 5;
-                    }
-                    break;
-                }
-            }
-        }
-
-        return result;
-    }
+    @throw std::domain_error if called on JSON values other than arrays;
+    example: `"cannot use insert() with string"`
+    @throw std::domain_error if @a pos is not an iterator of *this; example:
+    `"iterator does not fit current value"`
+    @throw std::domain_error if @a first and @a last do not belong to the same
+    JSON value; example: `"iterators do not fit"`
+    @throw std::domain_error if @a first or @a last are iterators into
+    container for which insert is called; example: `"passed iterators may not
+    belong to container"`
 
-    /*!
-    @brief escape a string
+    @return iterator pointing to the first element inserted, or @a pos if
+    `first==last`
 
-    Escape a string by replacing certain special characters by a sequence of
-    an escape character (backslash) and another character and other control
-    characters by a sequence of "\u" followed by a four-digit hex
-    representation.
+    @complexity Linear in `std::distance(first, last)` plus linear in the
+    distance between @a pos and end of the container.
 
-    @param[in] s  the string to escape
-    @return  the escaped string
+    @liveexample{The example shows how `insert()` is used.,insert__range}
 
-    @complexity Linear in the length of string @a s.
+    @since version 1.0.0
     */
-    static string_t escape_string(const string_t& s)
+    iterator insert(const_iterator pos, const_iterator first, const_iterator last)
     {
-        const auto space = extra_space(s);
-        if (space == 0)
+        // insert only works for arrays
+        if (not is_array())
         {
-            return s;
+            throw std::domain_error("cannot use insert() with " + type_name());
         }
 
-        // create a result string of necessary size
-        string_t result(s.size() + space, '\\');
-        std::size_t pos = 0;
+        // check if iterator pos fits to this JSON value
+        if (pos.m_object != this)
+        {
+            throw std::domain_error("iterator does not fit current value");
+        }
 
-        for (const auto& c : s)
+        // check if range iterators belong to the same JSON object
+        if (first.m_object != last.m_object)
         {
-            switch (c)
-            {
-                // quotation mark (0x22)
-                case '"':
-                {
-                    result[pos + 1] = '"';
-                    pos += 2;
-                    break;
-                }
+            throw std::domain_error("iterators do not fit");
+        }
 
-                // reverse solidus (0x5c)
-                case '\\':
-                {
-                    // nothing to change
-                    pos += 2;
-                    break;
-                }
+        if (first.m_object == this or last.m_object == this)
+        {
+            throw std::domain_error("passed iterators may not belong to container");
+        }
 
-                // backspace (0x08)
-                case '\b':
-                {
-                    result[pos + 1] = 'b';
-                    pos += 2;
-                    break;
-                }
+        // insert to array and return iterator
+        iterator result(this);
+        assert(m_value.array != nullptr);
+        result.m_it.array_iterator = m_value.array->insert(
+                                         pos.m_it.array_iterator,
+                                         first.m_it.array_iterator,
+                                         last.m_it.array_iterator);
+        return result;
+    }
 
-                // formfeed (0x0c)
-                case '\f':
-                {
-                    result[pos + 1] = 'f';
-                    pos += 2;
-                    break;
-                }
+    /*!
+    @brief inserts elements
 
-                // newline (0x0a)
-                case '\n':
-                {
-                    result[pos + 1] = 'n';
-                    pos += 2;
-                    break;
-                }
+    Inserts elements from initializer list @a ilist before iterator @a pos.
 
-                // carriage return (0x0d)
-                case '\r':
-                {
-                    result[pos + 1] = 'r';
-                    pos += 2;
-                    break;
-                }
+    @param[in] pos iterator before which the content will be inserted; may be
+    the end() iterator
+    @param[in] ilist initializer list to insert the values from
 
-                // horizontal tab (0x09)
-                case '\t':
-                {
-                    result[pos + 1] = 't';
-                    pos += 2;
-                    break;
-                }
+    @throw std::domain_error if called on JSON values other than arrays;
+    example: `"cannot use insert() with string"`
+    @throw std::domain_error if @a pos is not an iterator of *this; example:
+    `"iterator does not fit current value"`
 
-                default:
-                {
-                    if (c >= 0x00 and c <= 0x1f)
-                    {
-                        // convert a number 0..15 to its hex representation
-                        // (0..f)
-                        const auto hexify = [](const int v) -> char
-                        {
-                            return (v < 10)
-                            ? ('0' + static_cast<char>(v))
-                            : ('a' + static_cast<char>((v - 10) & 0x1f));
-                        };
+    @return iterator pointing to the first element inserted, or @a pos if
+    `ilist` is empty
 
-                        // print character c as \uxxxx
-                        for (const char m :
-                    { 'u', '0', '0', hexify(c >> 4), hexify(c & 0x0f)
-                        })
-                        {
-                            result[++pos] = m;
-                        }
+    @complexity Linear in `ilist.size()` plus linear in the distance between
+    @a pos and end of the container.
 
-                        ++pos;
-                    }
-                    else
-                    {
-                        // all other characters are added as-is
-                        result[pos++] = c;
-                    }
-                    break;
-                }
-            }
+    @liveexample{The example shows how `insert()` is used.,insert__ilist}
+
+    @since version 1.0.0
+    */
+    iterator insert(const_iterator pos, std::initializer_list<basic_json> ilist)
+    {
+        // insert only works for arrays
+        if (not is_array())
+        {
+            throw std::domain_error("cannot use insert() with " + type_name());
+        }
+
+        // check if iterator pos fits to this JSON value
+        if (pos.m_object != this)
+        {
+            throw std::domain_error("iterator does not fit current value");
         }
 
+        // insert to array and return iterator
+        iterator result(this);
+        assert(m_value.array != nullptr);
+        result.m_it.array_iterator = m_value.array->insert(pos.m_it.array_iterator, ilist);
         return result;
     }
 
     /*!
-    @brief internal implementation of the serialization function
+    @brief exchanges the values
 
-    This function is called by the public member function dump and organizes
-    the serialization internally. The indentation level is propagated as
-    additional parameter. In case of arrays and objects, the function is
-    called recursively. Note that
+    Exchanges the contents of the JSON value with those of @a other. Does not
+    invoke any move, copy, or swap operations on individual elements. All
+    iterators and references remain valid. The past-the-end iterator is
+    invalidated.
 
-    - strings and object keys are escaped using `escape_string()`
-    - integer numbers are converted implicitly via `operator<<`
-    - floating-point numbers are converted to a string using `"%g"` format
+    @param[in,out] other JSON value to exchange the contents with
 
-    @param[out] o              stream to write to
-    @param[in] pretty_print    whether the output shall be pretty-printed
-    @param[in] indent_step     the indent level
-    @param[in] current_indent  the current indent level (only used internally)
+    @complexity Constant.
+
+    @liveexample{The example below shows how JSON values can be swapped with
+    `swap()`.,swap__reference}
+
+    @since version 1.0.0
     */
-    void dump(std::ostream& o,
-              const bool pretty_print,
-              const unsigned int indent_step,
-              const unsigned int current_indent = 0) const
+    void swap(reference other) noexcept (
+        std::is_nothrow_move_constructible<value_t>::value and
+        std::is_nothrow_move_assignable<value_t>::value and
+        std::is_nothrow_move_constructible<json_value>::value and
+        std::is_nothrow_move_assignable<json_value>::value
+    )
     {
-        // variable to hold indentation for recursive calls
-        unsigned int new_indent = current_indent;
+        std::swap(m_type, other.m_type);
+        std::swap(m_value, other.m_value);
+    }
 
-        switch (m_type)
-        {
-            case value_t::object:
-            {
-                assert(m_value.object != nullptr);
+    /*!
+    @brief exchanges the values
 
-                if (m_value.object->empty())
-                {
-                    o << "{}";
-                    return;
-                }
+    Exchanges the contents of a JSON array with those of @a other. Does not
+    invoke any move, copy, or swap operations on individual elements. All
+    iterators and references remain valid. The past-the-end iterator is
+    invalidated.
 
-                o << "{";
+    @param[in,out] other array to exchange the contents with
 
-                // increase indentation
-                if (pretty_print)
-                {
-                    new_indent += indent_step;
-                    o << "\n";
-                }
+    @throw std::domain_error when JSON value is not an array; example: `"cannot
+    use swap() with string"`
 
-                for (auto i = m_value.object->cbegin(); i != m_value.object->cend(); ++i)
-                {
-                    if (i != m_value.object->cbegin())
-                    {
-                        o << (pretty_print ? ",\n" : ",");
-                    }
-                    o << string_t(new_indent, ' ') << "\""
-                      << escape_string(i->first) << "\":"
-                      << (pretty_print ? " " : "");
-                    i->second.dump(o, pretty_print, indent_step, new_indent);
-                }
+    @complexity Constant.
 
-                // decrease indentation
-                if (pretty_print)
-                {
-                    new_indent -= indent_step;
-                    o << "\n";
-                }
+    @liveexample{The example below shows how arrays can be swapped with
+    `swap()`.,swap__array_t}
 
-                o << string_t(new_indent, ' ') + "}";
-                return;
-            }
+    @since version 1.0.0
+    */
+    void swap(array_t& other)
+    {
+        // swap only works for arrays
+        if (is_array())
+        {
+            assert(m_value.array != nullptr);
+            std::swap(*(m_value.array), other);
+        }
+        else
+        {
+            throw std::domain_error("cannot use swap() with " + type_name());
+        }
+    }
 
-            case value_t::array:
-            {
-                assert(m_value.array != nullptr);
+    /*!
+    @brief exchanges the values
 
-                if (m_value.array->empty())
-                {
-                    o << "[]";
-                    return;
-                }
+    Exchanges the contents of a JSON object with those of @a other. Does not
+    invoke any move, copy, or swap operations on individual elements. All
+    iterators and references remain valid. The past-the-end iterator is
+    invalidated.
 
-                o << "[";
+    @param[in,out] other object to exchange the contents with
 
-                // increase indentation
-                if (pretty_print)
-                {
-                    new_indent += indent_step;
-                    o << "\n";
-                }
+    @throw std::domain_error when JSON value is not an object; example:
+    `"cannot use swap() with string"`
 
-                for (auto i = m_value.array->cbegin(); i != m_value.array->cend(); ++i)
-                {
-                    if (i != m_value.array->cbegin())
-                    {
-                        o << (pretty_print ? ",\n" : ",");
-                    }
-                    o << string_t(new_indent, ' ');
-                    i->dump(o, pretty_print, indent_step, new_indent);
-                }
+    @complexity Constant.
 
-                // decrease indentation
-                if (pretty_print)
-                {
-                    new_indent -= indent_step;
-                    o << "\n";
-                }
+    @liveexample{The example below shows how objects can be swapped with
+    `swap()`.,swap__object_t}
 
-                o << string_t(new_indent, ' ') << "]";
-                return;
-            }
+    @since version 1.0.0
+    */
+    void swap(object_t& other)
+    {
+        // swap only works for objects
+        if (is_object())
+        {
+            assert(m_value.object != nullptr);
+            std::swap(*(m_value.object), other);
+        }
+        else
+        {
+            throw std::domain_error("cannot use swap() with " + type_name());
+        }
+    }
 
-            case value_t::string:
-            {
-                assert(m_value.string != nullptr);
-                o << string_t("\"") << escape_string(*m_value.string) << "\"";
-                return;
-            }
+    /*!
+    @brief exchanges the values
 
-            case value_t::boolean:
-            {
-                o << (m_value.boolean ? "true" : "false");
-                return;
-            }
+    Exchanges the contents of a JSON string with those of @a other. Does not
+    invoke any move, copy, or swap operations on individual elements. All
+    iterators and references remain valid. The past-the-end iterator is
+    invalidated.
 
-            case value_t::number_integer:
-            {
-                o << m_value.number_integer;
-                return;
-            }
+    @param[in,out] other string to exchange the contents with
 
-            case value_t::number_unsigned:
-            {
-                o << m_value.number_unsigned;
-                return;
-            }
+    @throw std::domain_error when JSON value is not a string; example: `"cannot
+    use swap() with boolean"`
 
-            case value_t::number_float:
-            {
-                if (m_value.number_float == 0)
-                {
-                    // special case for zero to get "0.0"/"-0.0"
-                    o << (std::signbit(m_value.number_float) ? "-0.0" : "0.0");
-                }
-                else
-                {
-                    // Otherwise 6, 15 or 16 digits of precision allows
-                    // round-trip IEEE 754 string->float->string,
-                    // string->double->string or string->long
-                    // double->string; to be safe, we read this value from
-                    // std::numeric_limits<number_float_t>::digits10
-                    o << std::setprecision(std::numeric_limits<double>::digits10)
-                      << m_value.number_float;
-                }
-                return;
-            }
+    @complexity Constant.
 
-            case value_t::discarded:
-            {
-                o << "<discarded>";
-                return;
-            }
+    @liveexample{The example below shows how strings can be swapped with
+    `swap()`.,swap__string_t}
 
-            case value_t::null:
-            {
-                o << "null";
-                return;
-            }
+    @since version 1.0.0
+    */
+    void swap(string_t& other)
+    {
+        // swap only works for strings
+        if (is_string())
+        {
+            assert(m_value.string != nullptr);
+            std::swap(*(m_value.string), other);
+        }
+        else
+        {
+            throw std::domain_error("cannot use swap() with " + type_name());
         }
     }
 
-  private:
-    //////////////////////
-    // member variables //
-    //////////////////////
+    /// @}
 
-    /// the type of the current element
-    value_t m_type = value_t::null;
 
-    /// the value of the current element
-    json_value m_value = {};
+    //////////////////////////////////////////
+    // lexicographical comparison operators //
+    //////////////////////////////////////////
 
+    /// @name lexicographical comparison operators
+    /// @{
 
   private:
-    ///////////////
-    // iterators //
-    ///////////////
-
     /*!
-    @brief an iterator for primitive JSON types
+    @brief comparison operator for JSON types
 
-    This class models an iterator for primitive JSON types (boolean, number,
-    string). It's only purpose is to allow the iterator/const_iterator classes
-    to "iterate" over primitive values. Internally, the iterator is modeled by
-    a `difference_type` variable. Value begin_value (`0`) models the begin,
-    end_value (`1`) models past the end.
+    Returns an ordering that is similar to Python:
+    - order: null < boolean < number < object < array < string
+    - furthermore, each type is not smaller than itself
+
+    @since version 1.0.0
     */
-    class primitive_iterator_t
+    friend bool operator<(const value_t lhs, const value_t rhs) noexcept
     {
-      public:
-        /// set iterator to a defined beginning
-        void set_begin() noexcept
-        {
-            m_it = begin_value;
-        }
+        static constexpr std::array<uint8_t, 8> order = {{
+                0, // null
+                3, // object
+                4, // array
+                5, // string
+                1, // boolean
+                2, // integer
+                2, // unsigned
+                2, // float
+            }
+        };
 
-        /// set iterator to a defined past the end
-        void set_end() noexcept
+        // discarded values are not comparable
+        if (lhs == value_t::discarded or rhs == value_t::discarded)
         {
-            m_it = end_value;
+            return false;
         }
 
-        /// return whether the iterator can be dereferenced
-        constexpr bool is_begin() const noexcept
-        {
-            return (m_it == begin_value);
-        }
+        return order[static_cast<std::size_t>(lhs)] < order[static_cast<std::size_t>(rhs)];
+    }
 
-        /// return whether the iterator is at end
-        constexpr bool is_end() const noexcept
-        {
-            return (m_it == end_value);
-        }
+  public:
+    /*!
+    @brief comparison: equal
 
-        /// return reference to the value to change and compare
-        operator difference_type& () noexcept
-        {
-            return m_it;
-        }
-
-        /// return value to compare
-        constexpr operator difference_type () const noexcept
-        {
-            return m_it;
-        }
+    Compares two JSON values for equality according to the following rules:
+    - Two JSON values are equal if (1) they are from the same type and (2)
+      their stored values are the same.
+    - Integer and floating-point numbers are automatically converted before
+      comparison. Floating-point numbers are compared indirectly: two
+      floating-point numbers `f1` and `f2` are considered equal if neither
+      `f1 > f2` nor `f2 > f1` holds.
+    - Two JSON null values are equal.
 
-      private:
-        static constexpr difference_type begin_value = 0;
-        static constexpr difference_type end_value = begin_value + 1;
+    @param[in] lhs  first JSON value to consider
+    @param[in] rhs  second JSON value to consider
+    @return whether the values @a lhs and @a rhs are equal
 
-        /// iterator as signed integer type
-        difference_type m_it = std::numeric_limits<std::ptrdiff_t>::denorm_min();
-    };
+    @complexity Linear.
 
-    /*!
-    @brief an iterator value
+    @liveexample{The example demonstrates comparing several JSON
+    types.,operator__equal}
 
-    @note This structure could easily be a union, but MSVC currently does not
-    allow unions members with complex constructors, see
-    https://github.com/nlohmann/json/pull/105.
+    @since version 1.0.0
     */
-    struct internal_iterator
+    friend bool operator==(const_reference lhs, const_reference rhs) noexcept
     {
-        /// iterator for JSON objects
-        typename object_t::iterator object_iterator;
-        /// iterator for JSON arrays
-        typename array_t::iterator array_iterator;
-        /// generic iterator for all other types
-        primitive_iterator_t primitive_iterator;
-
-        /// create an uninitialized internal_iterator
-        internal_iterator() noexcept
-            : object_iterator(), array_iterator(), primitive_iterator()
-        {}
-    };
+        const auto lhs_type = lhs.type();
+        const auto rhs_type = rhs.type();
 
-    /// proxy class for the iterator_wrapper functions
-    template<typename IteratorType>
-    class iteration_proxy
-    {
-      private:
-        /// helper class for iteration
-        class iteration_proxy_internal
+        if (lhs_type == rhs_type)
         {
-          private:
-            /// the iterator
-            IteratorType anchor;
-            /// an index for arrays (used to create key names)
-            size_t array_index = 0;
-
-          public:
-            explicit iteration_proxy_internal(IteratorType it) noexcept
-                : anchor(it)
-            {}
-
-            /// dereference operator (needed for range-based for)
-            iteration_proxy_internal& operator*()
-            {
-                return *this;
-            }
-
-            /// increment operator (needed for range-based for)
-            iteration_proxy_internal& operator++()
+            switch (lhs_type)
             {
-                ++anchor;
-                ++array_index;
-
-                return *this;
+                case value_t::array:
+                {
+                    assert(lhs.m_value.array != nullptr);
+                    assert(rhs.m_value.array != nullptr);
+                    return *lhs.m_value.array == *rhs.m_value.array;
+                }
+                case value_t::object:
+                {
+                    assert(lhs.m_value.object != nullptr);
+                    assert(rhs.m_value.object != nullptr);
+                    return *lhs.m_value.object == *rhs.m_value.object;
+                }
+                case value_t::null:
+                {
+                    return true;
+                }
+                case value_t::string:
+                {
+                    assert(lhs.m_value.string != nullptr);
+                    assert(rhs.m_value.string != nullptr);
+                    return *lhs.m_value.string == *rhs.m_value.string;
+                }
+                case value_t::boolean:
+                {
+                    return lhs.m_value.boolean == rhs.m_value.boolean;
+                }
+                case value_t::number_integer:
+                {
+                    return lhs.m_value.number_integer == rhs.m_value.number_integer;
+                }
+                case value_t::number_unsigned:
+                {
+                    return lhs.m_value.number_unsigned == rhs.m_value.number_unsigned;
+                }
+                case value_t::number_float:
+                {
+                    return lhs.m_value.number_float == rhs.m_value.number_float;
+                }
+                default:
+                {
+                    return false;
+                }
             }
+        }
+        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_float)
+        {
+            return static_cast<number_float_t>(lhs.m_value.number_integer) == rhs.m_value.number_float;
+        }
+        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_integer)
+        {
+            return lhs.m_value.number_float == static_cast<number_float_t>(rhs.m_value.number_integer);
+        }
+        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_float)
+        {
+            return static_cast<number_float_t>(lhs.m_value.number_unsigned) == rhs.m_value.number_float;
+        }
+        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_unsigned)
+        {
+            return lhs.m_value.number_float == static_cast<number_float_t>(rhs.m_value.number_unsigned);
+        }
+        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_integer)
+        {
+            return static_cast<number_integer_t>(lhs.m_value.number_unsigned) == rhs.m_value.number_integer;
+        }
+        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_unsigned)
+        {
+            return lhs.m_value.number_integer == static_cast<number_integer_t>(rhs.m_value.number_unsigned);
+        }
 
-            /// inequality operator (needed for range-based for)
-            bool operator!= (const iteration_proxy_internal& o) const
-            {
-                return anchor != o.anchor;
-            }
+        return false;
+    }
 
-            /// return key of the iterator
-            typename basic_json::string_t key() const
-            {
-                assert(anchor.m_object != nullptr);
+    /*!
+    @brief comparison: equal
 
-                switch (anchor.m_object->type())
-                {
-                    // use integer array index as key
-                    case value_t::array:
-                    {
-                        return std::to_string(array_index);
-                    }
+    The functions compares the given JSON value against a null pointer. As the
+    null pointer can be used to initialize a JSON value to null, a comparison
+    of JSON value @a v with a null pointer should be equivalent to call
+    `v.is_null()`.
 
-                    // use key from the object
-                    case value_t::object:
-                    {
-                        return anchor.key();
-                    }
+    @param[in] v  JSON value to consider
+    @return whether @a v is null
 
-                    // use an empty key for all primitive types
-                    default:
-                    {
-                        return "";
-                    }
-                }
-            }
+    @complexity Constant.
 
-            /// return value of the iterator
-            typename IteratorType::reference value() const
-            {
-                return anchor.value();
-            }
-        };
+    @liveexample{The example compares several JSON types to the null pointer.
+    ,operator__equal__nullptr_t}
 
-        /// the container to iterate
-        typename IteratorType::reference container;
+    @since version 1.0.0
+    */
+    friend bool operator==(const_reference v, std::nullptr_t) noexcept
+    {
+        return v.is_null();
+    }
 
-      public:
-        /// construct iteration proxy from a container
-        explicit iteration_proxy(typename IteratorType::reference cont)
-            : container(cont)
-        {}
+    /*!
+    @brief comparison: equal
+    @copydoc operator==(const_reference, std::nullptr_t)
+    */
+    friend bool operator==(std::nullptr_t, const_reference v) noexcept
+    {
+        return v.is_null();
+    }
 
-        /// return iterator begin (needed for range-based for)
-        iteration_proxy_internal begin() noexcept
-        {
-            return iteration_proxy_internal(container.begin());
-        }
+    /*!
+    @brief comparison: not equal
 
-        /// return iterator end (needed for range-based for)
-        iteration_proxy_internal end() noexcept
-        {
-            return iteration_proxy_internal(container.end());
-        }
-    };
+    Compares two JSON values for inequality by calculating `not (lhs == rhs)`.
 
-  public:
-    /*!
-    @brief a const random access iterator for the @ref basic_json class
+    @param[in] lhs  first JSON value to consider
+    @param[in] rhs  second JSON value to consider
+    @return whether the values @a lhs and @a rhs are not equal
 
-    This class implements a const iterator for the @ref basic_json class. From
-    this class, the @ref iterator class is derived.
+    @complexity Linear.
 
-    @requirement The class satisfies the following concept requirements:
-    - [RandomAccessIterator](http://en.cppreference.com/w/cpp/concept/RandomAccessIterator):
-      The iterator that can be moved to point (forward and backward) to any
-      element in constant time.
+    @liveexample{The example demonstrates comparing several JSON
+    types.,operator__notequal}
 
     @since version 1.0.0
     */
-    class const_iterator : public std::iterator<std::random_access_iterator_tag, const basic_json>
+    friend bool operator!=(const_reference lhs, const_reference rhs) noexcept
     {
-        /// allow basic_json to access private members
-        friend class basic_json;
+        return not (lhs == rhs);
+    }
 
-      public:
-        /// the type of the values when the iterator is dereferenced
-        using value_type = typename basic_json::value_type;
-        /// a type to represent differences between iterators
-        using difference_type = typename basic_json::difference_type;
-        /// defines a pointer to the type iterated over (value_type)
-        using pointer = typename basic_json::const_pointer;
-        /// defines a reference to the type iterated over (value_type)
-        using reference = typename basic_json::const_reference;
-        /// the category of the iterator
-        using iterator_category = std::bidirectional_iterator_tag;
+    /*!
+    @brief comparison: not equal
 
-        /// default constructor
-        const_iterator() = default;
+    The functions compares the given JSON value against a null pointer. As the
+    null pointer can be used to initialize a JSON value to null, a comparison
+    of JSON value @a v with a null pointer should be equivalent to call
+    `not v.is_null()`.
 
-        /// constructor for a given JSON instance
-        explicit const_iterator(pointer object) noexcept
-            : m_object(object)
-        {
-            assert(m_object != nullptr);
+    @param[in] v  JSON value to consider
+    @return whether @a v is not null
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    m_it.object_iterator = typename object_t::iterator();
-                    break;
-                }
+    @complexity Constant.
 
-                case basic_json::value_t::array:
-                {
-                    m_it.array_iterator = typename array_t::iterator();
-                    break;
-                }
+    @liveexample{The example compares several JSON types to the null pointer.
+    ,operator__notequal__nullptr_t}
 
-                default:
-                {
-                    m_it.primitive_iterator = primitive_iterator_t();
-                    break;
-                }
-            }
-        }
+    @since version 1.0.0
+    */
+    friend bool operator!=(const_reference v, std::nullptr_t) noexcept
+    {
+        return not v.is_null();
+    }
 
-        /// copy constructor given a nonconst iterator
-        explicit const_iterator(const iterator& other) noexcept
-            : m_object(other.m_object)
-        {
-            assert(m_object != nullptr);
+    /*!
+    @brief comparison: not equal
+    @copydoc operator!=(const_reference, std::nullptr_t)
+    */
+    friend bool operator!=(std::nullptr_t, const_reference v) noexcept
+    {
+        return not v.is_null();
+    }
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    m_it.object_iterator = other.m_it.object_iterator;
-                    break;
-                }
+    /*!
+    @brief comparison: less than
 
-                case basic_json::value_t::array:
-                {
-                    m_it.array_iterator = other.m_it.array_iterator;
-                    break;
-                }
+    Compares whether one JSON value @a lhs is less than another JSON value @a
+    rhs according to the following rules:
+    - If @a lhs and @a rhs have the same type, the values are compared using
+      the default `<` operator.
+    - Integer and floating-point numbers are automatically converted before
+      comparison
+    - In case @a lhs and @a rhs have different types, the values are ignored
+      and the order of the types is considered, see
+      @ref operator<(const value_t, const value_t).
 
-                default:
-                {
-                    m_it.primitive_iterator = other.m_it.primitive_iterator;
-                    break;
-                }
-            }
-        }
+    @param[in] lhs  first JSON value to consider
+    @param[in] rhs  second JSON value to consider
+    @return whether @a lhs is less than @a rhs
 
-        /// copy constructor
-        const_iterator(const const_iterator& other) noexcept
-            : m_object(other.m_object), m_it(other.m_it)
-        {}
+    @complexity Linear.
 
-        /// copy assignment
-        const_iterator& operator=(const_iterator other) noexcept(
-            std::is_nothrow_move_constructible<pointer>::value and
-            std::is_nothrow_move_assignable<pointer>::value and
-            std::is_nothrow_move_constructible<internal_iterator>::value and
-            std::is_nothrow_move_assignable<internal_iterator>::value
-        )
-        {
-            std::swap(m_object, other.m_object);
-            std::swap(m_it, other.m_it);
-            return *this;
-        }
+    @liveexample{The example demonstrates comparing several JSON
+    types.,operator__less}
 
-      private:
-        /// set the iterator to the first value
-        void set_begin() noexcept
-        {
-            assert(m_object != nullptr);
+    @since version 1.0.0
+    */
+    friend bool operator<(const_reference lhs, const_reference rhs) noexcept
+    {
+        const auto lhs_type = lhs.type();
+        const auto rhs_type = rhs.type();
 
-            switch (m_object->m_type)
+        if (lhs_type == rhs_type)
+        {
+            switch (lhs_type)
             {
-                case basic_json::value_t::object:
-                {
-                    assert(m_object->m_value.object != nullptr);
-                    m_it.object_iterator = m_object->m_value.object->begin();
-                    break;
-                }
-
-                case basic_json::value_t::array:
-                {
-                    assert(m_object->m_value.array != nullptr);
-                    m_it.array_iterator = m_object->m_value.array->begin();
-                    break;
-                }
-
-                case basic_json::value_t::null:
+                case value_t::array:
                 {
-                    // set to end so begin()==end() is true: null is empty
-                    m_it.primitive_iterator.set_end();
-                    break;
+                    assert(lhs.m_value.array != nullptr);
+                    assert(rhs.m_value.array != nullptr);
+                    return *lhs.m_value.array < *rhs.m_value.array;
                 }
-
-                default:
+                case value_t::object:
                 {
-                    m_it.primitive_iterator.set_begin();
-                    break;
+                    assert(lhs.m_value.object != nullptr);
+                    assert(rhs.m_value.object != nullptr);
+                    return *lhs.m_value.object < *rhs.m_value.object;
                 }
-            }
-        }
-
-        /// set the iterator past the last value
-        void set_end() noexcept
-        {
-            assert(m_object != nullptr);
-
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
+                case value_t::null:
                 {
-                    assert(m_object->m_value.object != nullptr);
-                    m_it.object_iterator = m_object->m_value.object->end();
-                    break;
+                    return false;
                 }
-
-                case basic_json::value_t::array:
+                case value_t::string:
                 {
-                    assert(m_object->m_value.array != nullptr);
-                    m_it.array_iterator = m_object->m_value.array->end();
-                    break;
+                    assert(lhs.m_value.string != nullptr);
+                    assert(rhs.m_value.string != nullptr);
+                    return *lhs.m_value.string < *rhs.m_value.string;
                 }
-
-                default:
+                case value_t::boolean:
                 {
-                    m_it.primitive_iterator.set_end();
-                    break;
+                    return lhs.m_value.boolean < rhs.m_value.boolean;
                 }
-            }
-        }
-
-      public:
-        /// return a reference to the value pointed to by the iterator
-        reference operator*() const
-        {
-            assert(m_object != nullptr);
-
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
+                case value_t::number_integer:
                 {
-                    assert(m_object->m_value.object);
-                    assert(m_it.object_iterator != m_object->m_value.object->end());
-                    return m_it.object_iterator->second;
+                    return lhs.m_value.number_integer < rhs.m_value.number_integer;
                 }
-
-                case basic_json::value_t::array:
+                case value_t::number_unsigned:
                 {
-                    assert(m_object->m_value.array);
-                    assert(m_it.array_iterator != m_object->m_value.array->end());
-                    return *m_it.array_iterator;
+                    return lhs.m_value.number_unsigned < rhs.m_value.number_unsigned;
                 }
-
-                case basic_json::value_t::null:
+                case value_t::number_float:
                 {
-                    throw std::out_of_range("cannot get value");
+                    return lhs.m_value.number_float < rhs.m_value.number_float;
                 }
-
                 default:
                 {
-                    if (m_it.primitive_iterator.is_begin())
-                    {
-                        return *m_object;
-                    }
-                    else
-                    {
-                        throw std::out_of_range("cannot get value");
-                    }
+                    return false;
                 }
             }
         }
-
-        /// dereference the iterator
-        pointer operator->() const
+        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_float)
         {
-            assert(m_object != nullptr);
-
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    assert(m_object->m_value.object);
-                    assert(m_it.object_iterator != m_object->m_value.object->end());
-                    return &(m_it.object_iterator->second);
-                }
-
-                case basic_json::value_t::array:
-                {
-                    assert(m_object->m_value.array);
-                    assert(m_it.array_iterator != m_object->m_value.array->end());
-                    return &*m_it.array_iterator;
-                }
-
-                default:
-                {
-                    if (m_it.primitive_iterator.is_begin())
-                    {
-                        return m_object;
-                    }
-                    else
-                    {
-                        throw std::out_of_range("cannot get value");
-                    }
-                }
-            }
+            return static_cast<number_float_t>(lhs.m_value.number_integer) < rhs.m_value.number_float;
         }
-
-        /// post-increment (it++)
-        const_iterator operator++(int)
+        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_integer)
         {
-            auto result = *this;
-            ++(*this);
-            return result;
+            return lhs.m_value.number_float < static_cast<number_float_t>(rhs.m_value.number_integer);
         }
-
-        /// pre-increment (++it)
-        const_iterator& operator++()
+        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_float)
         {
-            assert(m_object != nullptr);
+            return static_cast<number_float_t>(lhs.m_value.number_unsigned) < rhs.m_value.number_float;
+        }
+        else if (lhs_type == value_t::number_float and rhs_type == value_t::number_unsigned)
+        {
+            return lhs.m_value.number_float < static_cast<number_float_t>(rhs.m_value.number_unsigned);
+        }
+        else if (lhs_type == value_t::number_integer and rhs_type == value_t::number_unsigned)
+        {
+            return lhs.m_value.number_integer < static_cast<number_integer_t>(rhs.m_value.number_unsigned);
+        }
+        else if (lhs_type == value_t::number_unsigned and rhs_type == value_t::number_integer)
+        {
+            return static_cast<number_integer_t>(lhs.m_value.number_unsigned) < rhs.m_value.number_integer;
+        }
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    ++m_it.object_iterator;
-                    break;
-                }
+        // We only reach this line if we cannot compare values. In that case,
+        // we compare types. Note we have to call the operator explicitly,
+        // because MSVC has problems otherwise.
+        return operator<(lhs_type, rhs_type);
+    }
 
-                case basic_json::value_t::array:
-                {
-                    ++m_it.array_iterator;
-                    break;
-                }
+    /*!
+    @brief comparison: less than or equal
 
-                default:
-                {
-                    ++m_it.primitive_iterator;
-                    break;
-                }
-            }
+    Compares whether one JSON value @a lhs is less than or equal to another
+    JSON value by calculating `not (rhs < lhs)`.
 
-            return *this;
-        }
+    @param[in] lhs  first JSON value to consider
+    @param[in] rhs  second JSON value to consider
+    @return whether @a lhs is less than or equal to @a rhs
 
-        /// post-decrement (it--)
-        const_iterator operator--(int)
-        {
-            auto result = *this;
-            --(*this);
-            return result;
-        }
+    @complexity Linear.
 
-        /// pre-decrement (--it)
-        const_iterator& operator--()
-        {
-            assert(m_object != nullptr);
+    @liveexample{The example demonstrates comparing several JSON
+    types.,operator__greater}
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    --m_it.object_iterator;
-                    break;
-                }
+    @since version 1.0.0
+    */
+    friend bool operator<=(const_reference lhs, const_reference rhs) noexcept
+    {
+        return not (rhs < lhs);
+    }
 
-                case basic_json::value_t::array:
-                {
-                    --m_it.array_iterator;
-                    break;
-                }
+    /*!
+    @brief comparison: greater than
 
-                default:
-                {
-                    --m_it.primitive_iterator;
-                    break;
-                }
-            }
+    Compares whether one JSON value @a lhs is greater than another
+    JSON value by calculating `not (lhs <= rhs)`.
 
-            return *this;
-        }
+    @param[in] lhs  first JSON value to consider
+    @param[in] rhs  second JSON value to consider
+    @return whether @a lhs is greater than to @a rhs
 
-        /// comparison: equal
-        bool operator==(const const_iterator& other) const
-        {
-            // if objects are not the same, the comparison is undefined
-            if (m_object != other.m_object)
-            {
-                throw std::domain_error("cannot compare iterators of different containers");
-            }
+    @complexity Linear.
 
-            assert(m_object != nullptr);
+    @liveexample{The example demonstrates comparing several JSON
+    types.,operator__lessequal}
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    return (m_it.object_iterator == other.m_it.object_iterator);
-                }
+    @since version 1.0.0
+    */
+    friend bool operator>(const_reference lhs, const_reference rhs) noexcept
+    {
+        return not (lhs <= rhs);
+    }
 
-                case basic_json::value_t::array:
-                {
-                    return (m_it.array_iterator == other.m_it.array_iterator);
-                }
+    /*!
+    @brief comparison: greater than or equal
 
-                default:
-                {
-                    return (m_it.primitive_iterator == other.m_it.primitive_iterator);
-                }
-            }
-        }
+    Compares whether one JSON value @a lhs is greater than or equal to another
+    JSON value by calculating `not (lhs < rhs)`.
 
-        /// comparison: not equal
-        bool operator!=(const const_iterator& other) const
-        {
-            return not operator==(other);
-        }
+    @param[in] lhs  first JSON value to consider
+    @param[in] rhs  second JSON value to consider
+    @return whether @a lhs is greater than or equal to @a rhs
 
-        /// comparison: smaller
-        bool operator<(const const_iterator& other) const
-        {
-            // if objects are not the same, the comparison is undefined
-            if (m_object != other.m_object)
-            {
-                throw std::domain_error("cannot compare iterators of different containers");
-            }
+    @complexity Linear.
 
-            assert(m_object != nullptr);
+    @liveexample{The example demonstrates comparing several JSON
+    types.,operator__greaterequal}
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    throw std::domain_error("cannot compare order of object iterators");
-                }
+    @since version 1.0.0
+    */
+    friend bool operator>=(const_reference lhs, const_reference rhs) noexcept
+    {
+        return not (lhs < rhs);
+    }
 
-                case basic_json::value_t::array:
-                {
-                    return (m_it.array_iterator < other.m_it.array_iterator);
-                }
+    /// @}
 
-                default:
-                {
-                    return (m_it.primitive_iterator < other.m_it.primitive_iterator);
-                }
-            }
-        }
 
-        /// comparison: less than or equal
-        bool operator<=(const const_iterator& other) const
-        {
-            return not other.operator < (*this);
-        }
+    ///////////////////
+    // serialization //
+    ///////////////////
 
-        /// comparison: greater than
-        bool operator>(const const_iterator& other) const
-        {
-            return not operator<=(other);
-        }
+    /// @name serialization
+    /// @{
 
-        /// comparison: greater than or equal
-        bool operator>=(const const_iterator& other) const
-        {
-            return not operator<(other);
-        }
+    /*!
+    @brief serialize to stream
 
-        /// add to iterator
-        const_iterator& operator+=(difference_type i)
-        {
-            assert(m_object != nullptr);
+    Serialize the given JSON value @a j to the output stream @a o. The JSON
+    value will be serialized using the @ref dump member function. The
+    indentation of the output can be controlled with the member variable
+    `width` of the output stream @a o. For instance, using the manipulator
+    `std::setw(4)` on @a o sets the indentation level to `4` and the
+    serialization result is the same as calling `dump(4)`.
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    throw std::domain_error("cannot use offsets with object iterators");
-                }
+    @param[in,out] o  stream to serialize to
+    @param[in] j  JSON value to serialize
 
-                case basic_json::value_t::array:
-                {
-                    m_it.array_iterator += i;
-                    break;
-                }
+    @return the stream @a o
 
-                default:
-                {
-                    m_it.primitive_iterator += i;
-                    break;
-                }
-            }
+    @complexity Linear.
 
-            return *this;
-        }
+    @liveexample{The example below shows the serialization with different
+    parameters to `width` to adjust the indentation level.,operator_serialize}
 
-        /// subtract from iterator
-        const_iterator& operator-=(difference_type i)
-        {
-            return operator+=(-i);
-        }
+    @since version 1.0.0
+    */
+    friend std::ostream& operator<<(std::ostream& o, const basic_json& j)
+    {
+        // read width member and use it as indentation parameter if nonzero
+        const bool pretty_print = (o.width() > 0);
+        const auto indentation = (pretty_print ? o.width() : 0);
 
-        /// add to iterator
-        const_iterator operator+(difference_type i)
-        {
-            auto result = *this;
-            result += i;
-            return result;
-        }
+        // reset width to 0 for subsequent calls to this stream
+        o.width(0);
+        // fix locale problems
+        auto old_locale = o.imbue(std::locale(std::locale(), new DecimalSeparator));
 
-        /// subtract from iterator
-        const_iterator operator-(difference_type i)
-        {
-            auto result = *this;
-            result -= i;
-            return result;
-        }
+        // do the actual serialization
+        j.dump(o, pretty_print, static_cast<unsigned int>(indentation));
 
-        /// return difference
-        difference_type operator-(const const_iterator& other) const
-        {
-            assert(m_object != nullptr);
+        // reset locale
+        o.imbue(old_locale);
+        return o;
+    }
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    throw std::domain_error("cannot use offsets with object iterators");
-                }
+    /*!
+    @brief serialize to stream
+    @copydoc operator<<(std::ostream&, const basic_json&)
+    */
+    friend std::ostream& operator>>(const basic_json& j, std::ostream& o)
+    {
+        return o << j;
+    }
 
-                case basic_json::value_t::array:
-                {
-                    return m_it.array_iterator - other.m_it.array_iterator;
-                }
+    /// @}
 
-                default:
-                {
-                    return m_it.primitive_iterator - other.m_it.primitive_iterator;
-                }
-            }
-        }
 
-        /// access to successor
-        reference operator[](difference_type n) const
-        {
-            assert(m_object != nullptr);
+    /////////////////////
+    // deserialization //
+    /////////////////////
 
-            switch (m_object->m_type)
-            {
-                case basic_json::value_t::object:
-                {
-                    throw std::domain_error("cannot use operator[] for object iterators");
-                }
+    /// @name deserialization
+    /// @{
 
-                case basic_json::value_t::array:
-                {
-                    return *(m_it.array_iterator + n);
-                }
+    /*!
+    @brief deserialize from string
 
-                case basic_json::value_t::null:
-                {
-                    throw std::out_of_range("cannot get value");
-                }
+    @param[in] s  string to read a serialized JSON value from
+    @param[in] cb a parser callback function of type @ref parser_callback_t
+    which is used to control the deserialization by filtering unwanted values
+    (optional)
 
-                default:
-                {
-                    if (m_it.primitive_iterator == -n)
-                    {
-                        return *m_object;
-                    }
-                    else
-                    {
-                        throw std::out_of_range("cannot get value");
-                    }
-                }
-            }
-        }
+    @return result of the deserialization
 
-        /// return the key of an object iterator
-        typename object_t::key_type key() const
-        {
-            assert(m_object != nullptr);
+    @complexity Linear in the length of the input. The parser is a predictive
+    LL(1) parser. The complexity can be higher if the parser callback function
+    @a cb has a super-linear complexity.
 
-            if (m_object->is_object())
-            {
-                return m_it.object_iterator->first;
-            }
-            else
-            {
-                throw std::domain_error("cannot use key() for non-object iterators");
-            }
-        }
+    @note A UTF-8 byte order mark is silently ignored.
 
-        /// return the value of an iterator
-        reference value() const
-        {
-            return operator*();
-        }
+    @liveexample{The example below demonstrates the `parse()` function with
+    and without callback function.,parse__string__parser_callback_t}
 
-      private:
-        /// associated JSON instance
-        pointer m_object = nullptr;
-        /// the actual iterator of the associated instance
-        internal_iterator m_it = internal_iterator();
-    };
+    @sa @ref parse(std::istream&, parser_callback_t) for a version that reads
+    from an input stream
+
+    @since version 1.0.0
+    */
+    static basic_json parse(const string_t& s, parser_callback_t cb = nullptr)
+    {
+        return parser(s, cb).parse();
+    }
 
     /*!
-    @brief a mutable random access iterator for the @ref basic_json class
+    @brief deserialize from stream
 
-    @requirement The class satisfies the following concept requirements:
-    - [RandomAccessIterator](http://en.cppreference.com/w/cpp/concept/RandomAccessIterator):
-      The iterator that can be moved to point (forward and backward) to any
-      element in constant time.
-    - [OutputIterator](http://en.cppreference.com/w/cpp/concept/OutputIterator):
-      It is possible to write to the pointed-to element.
+    @param[in,out] i  stream to read a serialized JSON value from
+    @param[in] cb a parser callback function of type @ref parser_callback_t
+    which is used to control the deserialization by filtering unwanted values
+    (optional)
+
+    @return result of the deserialization
+
+    @complexity Linear in the length of the input. The parser is a predictive
+    LL(1) parser. The complexity can be higher if the parser callback function
+    @a cb has a super-linear complexity.
+
+    @note A UTF-8 byte order mark is silently ignored.
+
+    @liveexample{The example below demonstrates the `parse()` function with
+    and without callback function.,parse__istream__parser_callback_t}
+
+    @sa @ref parse(const string_t&, parser_callback_t) for a version that
+    reads from a string
 
     @since version 1.0.0
     */
-    class iterator : public const_iterator
+    static basic_json parse(std::istream& i, parser_callback_t cb = nullptr)
     {
-      public:
-        using base_iterator = const_iterator;
-        using pointer = typename basic_json::pointer;
-        using reference = typename basic_json::reference;
+        return parser(i, cb).parse();
+    }
 
-        /// default constructor
-        iterator() = default;
+    /*!
+    @copydoc parse(std::istream&, parser_callback_t)
+    */
+    static basic_json parse(std::istream&& i, parser_callback_t cb = nullptr)
+    {
+        return parser(i, cb).parse();
+    }
 
-        /// constructor for a given JSON instance
-        explicit iterator(pointer object) noexcept
-            : base_iterator(object)
-        {}
+    /*!
+    @brief deserialize from a range of characters
 
-        /// copy constructor
-        iterator(const iterator& other) noexcept
-            : base_iterator(other)
-        {}
+    The characters are read in place, so a caller holding its input in
+    memory (for instance, a line inside a larger read buffer, or a memory
+    mapped file) does not need to copy it into a string first. The range
+    does not need to be null-terminated.
 
-        /// copy assignment
-        iterator& operator=(iterator other) noexcept(
-            std::is_nothrow_move_constructible<pointer>::value and
-            std::is_nothrow_move_assignable<pointer>::value and
-            std::is_nothrow_move_constructible<internal_iterator>::value and
-            std::is_nothrow_move_assignable<internal_iterator>::value
-        )
-        {
-            base_iterator::operator=(other);
-            return *this;
-        }
+    @param[in] first  pointer to the first character to read
+    @param[in] last  pointer past the last character to read
+    @param[in] cb  a parser callback function of type @ref parser_callback_t
+    which is used to control the deserialization by filtering unwanted values
+    (optional)
 
-        /// return a reference to the value pointed to by the iterator
-        reference operator*() const
-        {
-            return const_cast<reference>(base_iterator::operator*());
-        }
+    @return result of the deserialization
 
-        /// dereference the iterator
-        pointer operator->() const
-        {
-            return const_cast<pointer>(base_iterator::operator->());
-        }
+    @complexity Linear in the length of the input. The parser is a predictive
+    LL(1) parser. The complexity can be higher if the parser callback function
+    @a cb has a super-linear complexity.
 
-        /// post-increment (it++)
-        iterator operator++(int)
-        {
-            iterator result = *this;
-            base_iterator::operator++();
-            return result;
-        }
+    @note A UTF-8 byte order mark is silently ignored.
 
-        /// pre-increment (++it)
-        iterator& operator++()
-        {
-            base_iterator::operator++();
-            return *this;
-        }
+    @sa @ref parse(const string_t&, parser_callback_t) for a version that
+    reads from a string
+    */
+    static basic_json parse(const char* first, const char* last,
+                            parser_callback_t cb = nullptr)
+    {
+        return parser(first, last, cb).parse();
+    }
 
-        /// post-decrement (it--)
-        iterator operator--(int)
-        {
-            iterator result = *this;
-            base_iterator::operator--();
-            return result;
-        }
+    /*!
+    @brief deserialize from string with a SAX handler
 
-        /// pre-decrement (--it)
-        iterator& operator--()
-        {
-            base_iterator::operator--();
-            return *this;
-        }
+    Reads a JSON text and reports it to @a handler as a sequence of events,
+    without constructing any basic_json value. The handler is a template
+    parameter, so events are dispatched at compile time (no `std::function`).
+    It must provide the following member functions:
 
-        /// add to iterator
-        iterator& operator+=(difference_type i)
-        {
-            base_iterator::operator+=(i);
-            return *this;
-        }
+    handler function | event
+    ---------------- | -----
+    `bool null()` | a `null` literal
+    `bool boolean(bool val)` | a `true` or `false` literal
+    `bool number_integer(number_integer_t val)` | a negative integer
+    `bool number_unsigned(number_unsigned_t val)` | a non-negative integer
+    `bool number_float(number_float_t val, string_ref raw)` | a floating-point number; @a raw is the number as written
+    `bool string(string_ref val)` | a string value
+    `bool key(string_ref val)` | an object key
+    `bool start_object()` | the parser read `{`
+    `bool end_object()` | the parser read `}`
+    `bool start_array()` | the parser read `[`
+    `bool end_array()` | the parser read `]`
+    `bool parse_error(std::size_t position, string_ref token)` | a syntax error at byte @a position near @a token
 
-        /// subtract from iterator
-        iterator& operator-=(difference_type i)
-        {
-            base_iterator::operator-=(i);
-            return *this;
-        }
+    Returning `false` from any handler function stops the parser right away;
+    this lets a handler stop reading as soon as it has what it needs.
 
-        /// add to iterator
-        iterator operator+(difference_type i)
-        {
-            auto result = *this;
-            result += i;
-            return result;
-        }
+    Keys and string values are views. When a string contains no escape
+    sequences, the view points directly into the input; otherwise it points
+    into a parser-owned buffer holding the unescaped string, which is
+    overwritten by the next string that needs unescaping. Either way, a view
+    is only guaranteed to be valid until the handler function returns.
 
-        /// subtract from iterator
-        iterator operator-(difference_type i)
-        {
-            auto result = *this;
-            result -= i;
-            return result;
-        }
+    @param[in] s  string to read a serialized JSON value from
+    @param[in,out] handler  SAX event handler
 
-        /// return difference
-        difference_type operator-(const iterator& other) const
-        {
-            return base_iterator::operator-(other);
-        }
+    @return `false` if the handler stopped the parser (including from
+    `parse_error`), `true` if the whole input was read
 
-        /// access to successor
-        reference operator[](difference_type n) const
-        {
-            return const_cast<reference>(base_iterator::operator[](n));
-        }
+    @complexity Linear in the length of the input.
 
-        /// return the value of an iterator
-        reference value() const
-        {
-            return const_cast<reference>(base_iterator::value());
-        }
-    };
+    @note A UTF-8 byte order mark is silently ignored.
+    */
+    template<typename Handler>
+    static bool sax_parse(const string_t& s, Handler& handler)
+    {
+        return sax_parser<Handler>(s, handler).parse();
+    }
 
     /*!
-    @brief a template for a reverse iterator class
+    @brief deserialize from stream with a SAX handler
+    @copydetails sax_parse(const string_t&, Handler&)
+    */
+    template<typename Handler>
+    static bool sax_parse(std::istream& i, Handler& handler)
+    {
+        return sax_parser<Handler>(i, handler).parse();
+    }
 
-    @tparam Base the base iterator type to reverse. Valid types are @ref
-    iterator (to create @ref reverse_iterator) and @ref const_iterator (to
-    create @ref const_reverse_iterator).
+    /*!
+    @brief deserialize from a range of characters with a SAX handler
 
-    @requirement The class satisfies the following concept requirements:
-    - [RandomAccessIterator](http://en.cppreference.com/w/cpp/concept/RandomAccessIterator):
-      The iterator that can be moved to point (forward and backward) to any
-      element in constant time.
-    - [OutputIterator](http://en.cppreference.com/w/cpp/concept/OutputIterator):
-      It is possible to write to the pointed-to element (only if @a Base is
-      @ref iterator).
+    The characters are read in place and need not be null-terminated; see
+    @ref parse(const char*, const char*, parser_callback_t).
 
-    @since version 1.0.0
+    @copydetails sax_parse(const string_t&, Handler&)
     */
-    template<typename Base>
-    class json_reverse_iterator : public std::reverse_iterator<Base>
+    template<typename Handler>
+    static bool sax_parse(const char* first, const char* last, Handler& handler)
     {
-      public:
-        /// shortcut to the reverse iterator adaptor
-        using base_iterator = std::reverse_iterator<Base>;
-        /// the reference type for the pointed-to element
-        using reference = typename Base::reference;
+        return sax_parser<Handler>(first, last, handler).parse();
+    }
 
-        /// create reverse iterator from iterator
-        json_reverse_iterator(const typename base_iterator::iterator_type& it) noexcept
-            : base_iterator(it)
-        {}
+    /*!
+    @brief deserialize from stream
 
-        /// create reverse iterator from base class
-        json_reverse_iterator(const base_iterator& it) noexcept
-            : base_iterator(it)
-        {}
+    Deserializes an input stream to a JSON value.
 
-        /// post-increment (it++)
-        json_reverse_iterator operator++(int)
-        {
-            return base_iterator::operator++(1);
-        }
+    @param[in,out] i  input stream to read a serialized JSON value from
+    @param[in,out] j  JSON value to write the deserialized input to
 
-        /// pre-increment (++it)
-        json_reverse_iterator& operator++()
-        {
-            base_iterator::operator++();
-            return *this;
-        }
+    @throw std::invalid_argument in case of parse errors
 
-        /// post-decrement (it--)
-        json_reverse_iterator operator--(int)
-        {
-            return base_iterator::operator--(1);
-        }
+    @complexity Linear in the length of the input. The parser is a predictive
+    LL(1) parser.
 
-        /// pre-decrement (--it)
-        json_reverse_iterator& operator--()
-        {
-            base_iterator::operator--();
-            return *this;
-        }
+    @note A UTF-8 byte order mark is silently ignored.
 
-        /// add to iterator
-        json_reverse_iterator& operator+=(difference_type i)
-        {
-            base_iterator::operator+=(i);
-            return *this;
-        }
+    @liveexample{The example below shows how a JSON value is constructed by
+    reading a serialization from a stream.,operator_deserialize}
 
-        /// add to iterator
-        json_reverse_iterator operator+(difference_type i) const
-        {
-            auto result = *this;
-            result += i;
-            return result;
-        }
+    @sa parse(std::istream&, parser_callback_t) for a variant with a parser
+    callback function to filter values while parsing
 
-        /// subtract from iterator
-        json_reverse_iterator operator-(difference_type i) const
-        {
-            auto result = *this;
-            result -= i;
-            return result;
-        }
+    @since version 1.0.0
+    */
+    friend std::istream& operator<<(basic_json& j, std::istream& i)
+    {
+        j = parser(i).parse();
+        return i;
+    }
 
-        /// return difference
-        difference_type operator-(const json_reverse_iterator& other) const
-        {
-            return this->base() - other.base();
-        }
+    /*!
+    @brief deserialize from stream
+    @copydoc operator<<(basic_json&, std::istream&)
+    */
+    friend std::istream& operator>>(std::istream& i, basic_json& j)
+    {
+        j = parser(i).parse();
+        return i;
+    }
 
-        /// access to successor
-        reference operator[](difference_type n) const
-        {
-            return *(this->operator+(n));
-        }
+    /// @}
 
-        /// return the key of an object iterator
-        typename object_t::key_type key() const
+
+  private:
+    ///////////////////////////
+    // convenience functions //
+    ///////////////////////////
+
+    /// return the type as string
+    string_t type_name() const noexcept
+    {
+        switch (m_type)
         {
-            auto it = --this->base();
-            return it.key();
+            case value_t::null:
+                return "null";
+            case value_t::object:
+                return "object";
+            case value_t::array:
+                return "array";
+            case value_t::string:
+                return "string";
+            case value_t::boolean:
+                return "boolean";
+            case value_t::discarded:
+                return "discarded";
+            default:
+                return "number";
         }
+    }
 
-        /// return the value of an iterator
-        reference value() const
+    /*!
+    @brief calculates the extra space to escape a JSON string
+
+    @param[in] s  the string to escape
+    @return the number of characters required to escape string @a s
+
+    @complexity Linear in the length of string @a s.
+    */
+    static std::size_t extra_space(const string_t& s) noexcept
+    {
+        std::size_t result = 0;
+
+        for (const auto& c : s)
         {
-            auto it = --this->base();
-            return it.operator * ();
-        }
-    };
+            switch (c)
+            {
+                case '"':
+                case '\\':
+                case '\b':
+                case '\f':
+                case '\n':
+                case '\r':
+                case '\t':
+                {
+                    // from c (1 byte) to \x (2 bytes)
+                    result += 1;
+                    break;
+                }
 
+                default:
+                {
+                    if (c >= 0x00 and c <= 0x1f)
+                    {
+                        // from c (1 byte) to \uxxxx (6 bytes)
+                        result += 5;
+                    }
+                    break;
+                }
+            }
+        }
 
-  private:
-    //////////////////////
-    // lexer and parser //
-    //////////////////////
+        return result;
+    }
 
     /*!
-    @brief lexical analysis
+    @brief escape a string
 
-    This class organizes the lexical analysis during JSON deserialization. The
-    core of it is a scanner generated by [re2c](http://re2c.org) that
-    processes a buffer and recognizes tokens according to RFC 7159.
+    Escape a string by replacing certain special characters by a sequence of
+    an escape character (backslash) and another character and other control
+    characters by a sequence of "\u" followed by a four-digit hex
+    representation.
+
+    @param[in] s  the string to escape
+    @return  the escaped string
+
+    @complexity Linear in the length of string @a s.
     */
-    class lexer
+    static string_t escape_string(const string_t& s)
     {
-      public:
-        /// token types for the parser
-        enum class token_type
-        {
-            uninitialized,   ///< indicating the scanner is uninitialized
-            literal_true,    ///< the `true` literal
-            literal_false,   ///< the `false` literal
-            literal_null,    ///< the `null` literal
-            value_string,    ///< a string -- use get_string() for actual value
-            value_number,    ///< a number -- use get_number() for actual value
-            begin_array,     ///< the character for array begin `[`
-            begin_object,    ///< the character for object begin `{`
-            end_array,       ///< the character for array end `]`
-            end_object,      ///< the character for object end `}`
-            name_separator,  ///< the name separator `:`
-            value_separator, ///< the value separator `,`
-            parse_error,     ///< indicating a parse error
-            end_of_input     ///< indicating the end of the input buffer
-        };
-
-        /// the char type to use in the lexer
-        using lexer_char_t = unsigned char;
-
-        /// constructor with a given buffer
-        explicit lexer(const string_t& s) noexcept
-            : m_stream(nullptr), m_buffer(s)
-        {
-            m_content = reinterpret_cast<const lexer_char_t*>(s.c_str());
-            assert(m_content != nullptr);
-            m_start = m_cursor = m_content;
-            m_limit = m_content + s.size();
-        }
-
-        /// constructor with a given stream
-        explicit lexer(std::istream* s) noexcept
-            : m_stream(s), m_buffer()
+        const auto space = extra_space(s);
+        if (space == 0)
         {
-            assert(m_stream != nullptr);
-            getline(*m_stream, m_buffer);
-            m_content = reinterpret_cast<const lexer_char_t*>(m_buffer.c_str());
-            assert(m_content != nullptr);
-            m_start = m_cursor = m_content;
-            m_limit = m_content + m_buffer.size();
+            return s;
         }
 
-        /// default constructor
-        lexer() = default;
-
-        // switch off unwanted functions
-        lexer(const lexer&) = delete;
-        lexer operator=(const lexer&) = delete;
-
-        /*!
-        @brief create a string from a Unicode code point
-
-        @param[in] codepoint1  the code point (can be high surrogate)
-        @param[in] codepoint2  the code point (can be low surrogate or 0)
-
-        @return string representation of the code point
-
-        @throw std::out_of_range if code point is > 0x10ffff; example: `"code
-        points above 0x10FFFF are invalid"`
-        @throw std::invalid_argument if the low surrogate is invalid; example:
-        `""missing or wrong low surrogate""`
+        // create a result string of necessary size
+        string_t result(s.size() + space, '\\');
+        std::size_t pos = 0;
 
-        @see <http://en.wikipedia.org/wiki/UTF-8#Sample_code>
-        */
-        static string_t to_unicode(const std::size_t codepoint1,
-                                   const std::size_t codepoint2 = 0)
+        for (const auto& c : s)
         {
-            // calculate the codepoint from the given code points
-            std::size_t codepoint = codepoint1;
-
-            // check if codepoint1 is a high surrogate
-            if (codepoint1 >= 0xD800 and codepoint1 <= 0xDBFF)
+            switch (c)
             {
-                // check if codepoint2 is a low surrogate
-                if (codepoint2 >= 0xDC00 and codepoint2 <= 0xDFFF)
+                // quotation mark (0x22)
+                case '"':
                 {
-                    codepoint =
-                        // high surrogate occupies the most significant 22 bits
-                        (codepoint1 << 10)
-                        // low surrogate occupies the least significant 15 bits
-                        + codepoint2
-                        // there is still the 0xD800, 0xDC00 and 0x10000 noise
-                        // in the result so we have to subtract with:
-                        // (0xD800 << 10) + DC00 - 0x10000 = 0x35FDC00
-                        - 0x35FDC00;
+                    result[pos + 1] = '"';
+                    pos += 2;
+                    break;
                 }
-                else
+
+                // reverse solidus (0x5c)
+                case '\\':
                 {
-                    throw std::invalid_argument("missing or wrong low surrogate");
+                    // nothing to change
+                    pos += 2;
+                    break;
                 }
-            }
 
-            string_t result;
+                // backspace (0x08)
+                case '\b':
+                {
+                    result[pos + 1] = 'b';
+                    pos += 2;
+                    break;
+                }
 
-            if (codepoint < 0x80)
-            {
-                // 1-byte characters: 0xxxxxxx (ASCII)
-                result.append(1, static_cast<typename string_t::value_type>(codepoint));
-            }
-            else if (codepoint <= 0x7ff)
-            {
-                // 2-byte characters: 110xxxxx 10xxxxxx
-                result.append(1, static_cast<typename string_t::value_type>(0xC0 | ((codepoint >> 6) & 0x1F)));
-                result.append(1, static_cast<typename string_t::value_type>(0x80 | (codepoint & 0x3F)));
-            }
-            else if (codepoint <= 0xffff)
-            {
-                // 3-byte characters: 1110xxxx 10xxxxxx 10xxxxxx
-                result.append(1, static_cast<typename string_t::value_type>(0xE0 | ((codepoint >> 12) & 0x0F)));
-                result.append(1, static_cast<typename string_t::value_type>(0x80 | ((codepoint >> 6) & 0x3F)));
-                result.append(1, static_cast<typename string_t::value_type>(0x80 | (codepoint & 0x3F)));
-            }
-            else if (codepoint <= 0x10ffff)
-            {
-                // 4-byte characters: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-                result.append(1, static_cast<typename string_t::value_type>(0xF0 | ((codepoint >> 18) & 0x07)));
-                result.append(1, static_cast<typename string_t::value_type>(0x80 | ((codepoint >> 12) & 0x3F)));
-                result.append(1, static_cast<typename string_t::value_type>(0x80 | ((codepoint >> 6) & 0x3F)));
-                result.append(1, static_cast<typename string_t::value_type>(0x80 | (codepoint & 0x3F)));
-            }
-            else
-            {
-                throw std::out_of_range("code points above 0x10FFFF are invalid");
-            }
+                // formfeed (0x0c)
+                case '\f':
+                {
+                    result[pos + 1] = 'f';
+                    pos += 2;
+                    break;
+                }
 
-            return result;
-        }
+                // newline (0x0a)
+                case '\n':
+                {
+                    result[pos + 1] = 'n';
+                    pos += 2;
+                    break;
+                }
+
+                // carriage return (0x0d)
+                case '\r':
+                {
+                    result[pos + 1] = 'r';
+                    pos += 2;
+                    break;
+                }
+
+                // horizontal tab (0x09)
+                case '\t':
+                {
+                    result[pos + 1] = 't';
+                    pos += 2;
+                    break;
+                }
 
-        /// return name of values of type token_type (only used for errors)
-        static std::string token_type_name(token_type t)
-        {
-            switch (t)
-            {
-                case token_type::uninitialized:
-                    return "<uninitialized>";
-                case token_type::literal_true:
-                    return "true literal";
-                case token_type::literal_false:
-                    return "false literal";
-                case token_type::literal_null:
-                    return "null literal";
-                case token_type::value_string:
-                    return "string literal";
-                case token_type::value_number:
-                    return "number literal";
-                case token_type::begin_array:
-                    return "'['";
-                case token_type::begin_object:
-                    return "'{'";
-                case token_type::end_array:
-                    return "']'";
-                case token_type::end_object:
-                    return "'}'";
-                case token_type::name_separator:
-                    return "':'";
-                case token_type::value_separator:
-                    return "','";
-                case token_type::parse_error:
-                    return "<parse error>";
-                case token_type::end_of_input:
-                    return "end of input";
                 default:
                 {
-                    // catch non-enum values
-                    return "unknown token"; // LCOV_EXCL_LINE
+                    if (c >= 0x00 and c <= 0x1f)
+                    {
+                        // convert a number 0..15 to its hex representation
+                        // (0..f)
+                        const auto hexify = [](const int v) -> char
+                        {
+                            return (v < 10)
+                            ? ('0' + static_cast<char>(v))
+                            : ('a' + static_cast<char>((v - 10) & 0x1f));
+                        };
+
+                        // print character c as \uxxxx
+                        for (const char m :
+                    { 'u', '0', '0', hexify(c >> 4), hexify(c & 0x0f)
+                        })
+                        {
+                            result[++pos] = m;
+                        }
+
+                        ++pos;
+                    }
+                    else
+                    {
+                        // all other characters are added as-is
+                        result[pos++] = c;
+                    }
+                    break;
                 }
             }
         }
 
-        /*!
-        This function implements a scanner for JSON. It is specified using
-        regular expressions that try to follow RFC 7159 as close as possible.
-        These regular expressions are then translated into a minimized
-        deterministic finite automaton (DFA) by the tool
-        [re2c](http://re2c.org). As a result, the translated code for this
-        function consists of a large block of code with `goto` jumps.
-
-        @return the class of the next token read from the buffer
-        */
-        token_type scan() noexcept
-        {
-            // pointer for backtracking information
-            m_marker = nullptr;
-
-            // remember the begin of the token
-            m_start = m_cursor;
-            assert(m_start != nullptr);
+        return result;
+    }
 
+    /*!
+    @brief internal implementation of the serialization function
 
+    This function is called by the public member function dump and organizes
+    the serialization internally. The indentation level is propagated as
+    additional parameter. In case of arrays and objects, the function is
+    called recursively. Note that
+
+    - strings and object keys are escaped using `escape_string()`
+    - integer numbers are converted implicitly via `operator<<`
+    - floating-point numbers are converted to a string using `"%g"` format
+
+    @param[out] o              stream to write to
+    @param[in] pretty_print    whether the output shall be pretty-printed
+    @param[in] indent_step     the indent level
+    @param[in] current_indent  the current indent level (only used internally)
+    */
+    void dump(std::ostream& o,
+              const bool pretty_print,
+              const unsigned int indent_step,
+              const unsigned int current_indent = 0) const
+    {
+        // variable to hold indentation for recursive calls
+        unsigned int new_indent = current_indent;
+
+        switch (m_type)
+        {
+            case value_t::object:
             {
-                lexer_char_t yych;
-                unsigned int yyaccept = 0;
-                static const unsigned char yybm[] =
-                {
-                    0,   0,   0,   0,   0,   0,   0,   0,
-                    0,  32,  32,   0,   0,  32,   0,   0,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    160, 128,   0, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    192, 192, 192, 192, 192, 192, 192, 192,
-                    192, 192, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128,   0, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                    128, 128, 128, 128, 128, 128, 128, 128,
-                };
-                if ((m_limit - m_cursor) < 5)
-                {
-                    yyfill();    // LCOV_EXCL_LINE;
-                }
-                yych = *m_cursor;
-                if (yybm[0 + yych] & 32)
+                assert(m_value.object != nullptr);
+
+                if (m_value.object->empty())
                 {
-                    goto basic_json_parser_6;
+                    o << "{}";
+                    return;
                 }
-                if (yych <= '\\')
+
+                o << "{";
+
+                // increase indentation
+                if (pretty_print)
                 {
-                    if (yych <= '-')
-                    {
-                        if (yych <= '"')
-                        {
-                            if (yych <= 0x00)
-                            {
-                                goto basic_json_parser_2;
-                            }
-                            if (yych <= '!')
-                            {
-                                goto basic_json_parser_4;
-                            }
-                            goto basic_json_parser_9;
-                        }
-                        else
-                        {
-                            if (yych <= '+')
-                            {
-                                goto basic_json_parser_4;
-                            }
-                            if (yych <= ',')
-                            {
-                                goto basic_json_parser_10;
-                            }
-                            goto basic_json_parser_12;
-                        }
-                    }
-                    else
-                    {
-                        if (yych <= '9')
-                        {
-                            if (yych <= '/')
-                            {
-                                goto basic_json_parser_4;
-                            }
-                            if (yych <= '0')
-                            {
-                                goto basic_json_parser_13;
-                            }
-                            goto basic_json_parser_15;
-                        }
-                        else
-                        {
-                            if (yych <= ':')
-                            {
-                                goto basic_json_parser_17;
-                            }
-                            if (yych == '[')
-                            {
-                                goto basic_json_parser_19;
-                            }
-                            goto basic_json_parser_4;
-                        }
-                    }
+                    new_indent += indent_step;
+                    o << "\n";
                 }
-                else
+
+                for (auto i = m_value.object->cbegin(); i != m_value.object->cend(); ++i)
                 {
-                    if (yych <= 't')
-                    {
-                        if (yych <= 'f')
-                        {
-                            if (yych <= ']')
-                            {
-                                goto basic_json_parser_21;
-                            }
-                            if (yych <= 'e')
-                            {
-                                goto basic_json_parser_4;
-                            }
-                            goto basic_json_parser_23;
-                        }
-                        else
-                        {
-                            if (yych == 'n')
-                            {
-                                goto basic_json_parser_24;
-                            }
-                            if (yych <= 's')
-                            {
-                                goto basic_json_parser_4;
-                            }
-                            goto basic_json_parser_25;
-                        }
-                    }
-                    else
+                    if (i != m_value.object->cbegin())
                     {
-                        if (yych <= '|')
-                        {
-                            if (yych == '{')
-                            {
-                                goto basic_json_parser_26;
-                            }
-                            goto basic_json_parser_4;
-                        }
-                        else
-                        {
-                            if (yych <= '}')
-                            {
-                                goto basic_json_parser_28;
-                            }
-                            if (yych == 0xEF)
-                            {
-                                goto basic_json_parser_30;
-                            }
-                            goto basic_json_parser_4;
-                        }
+                        o << (pretty_print ? ",\n" : ",");
                     }
+                    o << string_t(new_indent, ' ') << "\""
+                      << escape_string(i->first) << "\":"
+                      << (pretty_print ? " " : "");
+                    i->second.dump(o, pretty_print, indent_step, new_indent);
                 }
-basic_json_parser_2:
-                ++m_cursor;
-                {
-                    return token_type::end_of_input;
-                }
-basic_json_parser_4:
-                ++m_cursor;
-basic_json_parser_5:
+
+                // decrease indentation
+                if (pretty_print)
                 {
-                    return token_type::parse_error;
+                    new_indent -= indent_step;
+                    o << "\n";
                 }
-basic_json_parser_6:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+
+                o << string_t(new_indent, ' ') + "}";
+                return;
+            }
+
+            case value_t::array:
+            {
+                assert(m_value.array != nullptr);
+
+                if (m_value.array->empty())
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    o << "[]";
+                    return;
                 }
-                yych = *m_cursor;
-                if (yybm[0 + yych] & 32)
+
+                o << "[";
+
+                // increase indentation
+                if (pretty_print)
                 {
-                    goto basic_json_parser_6;
+                    new_indent += indent_step;
+                    o << "\n";
                 }
+
+                for (auto i = m_value.array->cbegin(); i != m_value.array->cend(); ++i)
                 {
-                    return scan();
+                    if (i != m_value.array->cbegin())
+                    {
+                        o << (pretty_print ? ",\n" : ",");
+                    }
+                    o << string_t(new_indent, ' ');
+                    i->dump(o, pretty_print, indent_step, new_indent);
                 }
-basic_json_parser_9:
-                yyaccept = 0;
-                yych = *(m_marker = ++m_cursor);
-                if (yych <= 0x0F)
+
+                // decrease indentation
+                if (pretty_print)
                 {
-                    goto basic_json_parser_5;
+                    new_indent -= indent_step;
+                    o << "\n";
                 }
-                goto basic_json_parser_32;
-basic_json_parser_10:
-                ++m_cursor;
-                {
-                    return token_type::value_separator;
-                }
-basic_json_parser_12:
-                yych = *++m_cursor;
-                if (yych <= '/')
-                {
-                    goto basic_json_parser_5;
-                }
-                if (yych <= '0')
+
+                o << string_t(new_indent, ' ') << "]";
+                return;
+            }
+
+            case value_t::string:
+            {
+                assert(m_value.string != nullptr);
+                o << string_t("\"") << escape_string(*m_value.string) << "\"";
+                return;
+            }
+
+            case value_t::boolean:
+            {
+                o << (m_value.boolean ? "true" : "false");
+                return;
+            }
+
+            case value_t::number_integer:
+            {
+                o << m_value.number_integer;
+                return;
+            }
+
+            case value_t::number_unsigned:
+            {
+                o << m_value.number_unsigned;
+                return;
+            }
+
+            case value_t::number_float:
+            {
+                if (m_value.number_float == 0)
                 {
-                    goto basic_json_parser_13;
+                    // special case for zero to get "0.0"/"-0.0"
+                    o << (std::signbit(m_value.number_float) ? "-0.0" : "0.0");
                 }
-                if (yych <= '9')
+                else
                 {
-                    goto basic_json_parser_15;
+                    // Otherwise 6, 15 or 16 digits of precision allows
+                    // round-trip IEEE 754 string->float->string,
+                    // string->double->string or string->long
+                    // double->string; to be safe, we read this value from
+                    // std::numeric_limits<number_float_t>::digits10
+                    o << std::setprecision(std::numeric_limits<double>::digits10)
+                      << m_value.number_float;
                 }
-                goto basic_json_parser_5;
-basic_json_parser_13:
-                yyaccept = 1;
-                yych = *(m_marker = ++m_cursor);
-                if (yych <= 'D')
+                return;
+            }
+
+            case value_t::discarded:
+            {
+                o << "<discarded>";
+                return;
+            }
+
+            case value_t::null:
+            {
+                o << "null";
+                return;
+            }
+        }
+    }
+
+  private:
+    //////////////////////
+    // member variables //
+    //////////////////////
+
+    /// the type of the current element
+    value_t m_type = value_t::null;
+
+    /// the value of the current element
+    json_value m_value = {};
+
+
+  private:
+    ///////////////
+    // iterators //
+    ///////////////
+
+    /*!
+    @brief an iterator for primitive JSON types
+
+    This class models an iterator for primitive JSON types (boolean, number,
+    string). It's only purpose is to allow the iterator/const_iterator classes
+    to "iterate" over primitive values. Internally, the iterator is modeled by
+    a `difference_type` variable. Value begin_value (`0`) models the begin,
+    end_value (`1`) models past the end.
+    */
+    class primitive_iterator_t
+    {
+      public:
+        /// set iterator to a defined beginning
+        void set_begin() noexcept
+        {
+            m_it = begin_value;
+        }
+
+        /// set iterator to a defined past the end
+        void set_end() noexcept
+        {
+            m_it = end_value;
+        }
+
+        /// return whether the iterator can be dereferenced
+        constexpr bool is_begin() const noexcept
+        {
+            return (m_it == begin_value);
+        }
+
+        /// return whether the iterator is at end
+        constexpr bool is_end() const noexcept
+        {
+            return (m_it == end_value);
+        }
+
+        /// return reference to the value to change and compare
+        operator difference_type& () noexcept
+        {
+            return m_it;
+        }
+
+        /// return value to compare
+        constexpr operator difference_type () const noexcept
+        {
+            return m_it;
+        }
+
+      private:
+        static constexpr difference_type begin_value = 0;
+        static constexpr difference_type end_value = begin_value + 1;
+
+        /// iterator as signed integer type
+        difference_type m_it = std::numeric_limits<std::ptrdiff_t>::denorm_min();
+    };
+
+    /*!
+    @brief an iterator value
+
+    @note This structure could easily be a union, but MSVC currently does not
+    allow unions members with complex constructors, see
+    https://github.com/nlohmann/json/pull/105.
+    */
+    struct internal_iterator
+    {
+        /// iterator for JSON objects
+        typename object_t::iterator object_iterator;
+        /// iterator for JSON arrays
+        typename array_t::iterator array_iterator;
+        /// generic iterator for all other types
+        primitive_iterator_t primitive_iterator;
+
+        /// create an uninitialized internal_iterator
+        internal_iterator() noexcept
+            : object_iterator(), array_iterator(), primitive_iterator()
+        {}
+    };
+
+    /// proxy class for the iterator_wrapper functions
+    template<typename IteratorType>
+    class iteration_proxy
+    {
+      private:
+        /// helper class for iteration
+        class iteration_proxy_internal
+        {
+          private:
+            /// the iterator
+            IteratorType anchor;
+            /// an index for arrays (used to create key names)
+            size_t array_index = 0;
+
+          public:
+            explicit iteration_proxy_internal(IteratorType it) noexcept
+                : anchor(it)
+            {}
+
+            /// dereference operator (needed for range-based for)
+            iteration_proxy_internal& operator*()
+            {
+                return *this;
+            }
+
+            /// increment operator (needed for range-based for)
+            iteration_proxy_internal& operator++()
+            {
+                ++anchor;
+                ++array_index;
+
+                return *this;
+            }
+
+            /// inequality operator (needed for range-based for)
+            bool operator!= (const iteration_proxy_internal& o) const
+            {
+                return anchor != o.anchor;
+            }
+
+            /// return key of the iterator
+            typename basic_json::string_t key() const
+            {
+                assert(anchor.m_object != nullptr);
+
+                switch (anchor.m_object->type())
                 {
-                    if (yych == '.')
+                    // use integer array index as key
+                    case value_t::array:
                     {
-                        goto basic_json_parser_37;
+                        return std::to_string(array_index);
                     }
-                }
-                else
-                {
-                    if (yych <= 'E')
+
+                    // use key from the object
+                    case value_t::object:
                     {
-                        goto basic_json_parser_38;
+                        return anchor.key();
                     }
-                    if (yych == 'e')
+
+                    // use an empty key for all primitive types
+                    default:
                     {
-                        goto basic_json_parser_38;
+                        return "";
                     }
                 }
-basic_json_parser_14:
-                {
-                    return token_type::value_number;
-                }
-basic_json_parser_15:
-                yyaccept = 1;
-                m_marker = ++m_cursor;
-                if ((m_limit - m_cursor) < 3)
-                {
-                    yyfill();    // LCOV_EXCL_LINE;
-                }
-                yych = *m_cursor;
-                if (yybm[0 + yych] & 64)
-                {
-                    goto basic_json_parser_15;
-                }
-                if (yych <= 'D')
-                {
-                    if (yych == '.')
-                    {
-                        goto basic_json_parser_37;
-                    }
-                    goto basic_json_parser_14;
-                }
-                else
+            }
+
+            /// return value of the iterator
+            typename IteratorType::reference value() const
+            {
+                return anchor.value();
+            }
+        };
+
+        /// the container to iterate
+        typename IteratorType::reference container;
+
+      public:
+        /// construct iteration proxy from a container
+        explicit iteration_proxy(typename IteratorType::reference cont)
+            : container(cont)
+        {}
+
+        /// return iterator begin (needed for range-based for)
+        iteration_proxy_internal begin() noexcept
+        {
+            return iteration_proxy_internal(container.begin());
+        }
+
+        /// return iterator end (needed for range-based for)
+        iteration_proxy_internal end() noexcept
+        {
+            return iteration_proxy_internal(container.end());
+        }
+    };
+
+  public:
+    /*!
+    @brief a const random access iterator for the @ref basic_json class
+
+    This class implements a const iterator for the @ref basic_json class. From
+    this class, the @ref iterator class is derived.
+
+    @requirement The class satisfies the following concept requirements:
+    - [RandomAccessIterator](http://en.cppreference.com/w/cpp/concept/RandomAccessIterator):
+      The iterator that can be moved to point (forward and backward) to any
+      element in constant time.
+
+    @since version 1.0.0
+    */
+    class const_iterator : public std::iterator<std::random_access_iterator_tag, const basic_json>
+    {
+        /// allow basic_json to access private members
+        friend class basic_json;
+
+      public:
+        /// the type of the values when the iterator is dereferenced
+        using value_type = typename basic_json::value_type;
+        /// a type to represent differences between iterators
+        using difference_type = typename basic_json::difference_type;
+        /// defines a pointer to the type iterated over (value_type)
+        using pointer = typename basic_json::const_pointer;
+        /// defines a reference to the type iterated over (value_type)
+        using reference = typename basic_json::const_reference;
+        /// the category of the iterator
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        /// default constructor
+        const_iterator() = default;
+
+        /// constructor for a given JSON instance
+        explicit const_iterator(pointer object) noexcept
+            : m_object(object)
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    if (yych <= 'E')
-                    {
-                        goto basic_json_parser_38;
-                    }
-                    if (yych == 'e')
-                    {
-                        goto basic_json_parser_38;
-                    }
-                    goto basic_json_parser_14;
+                    m_it.object_iterator = typename object_t::iterator();
+                    break;
                 }
-basic_json_parser_17:
-                ++m_cursor;
+
+                case basic_json::value_t::array:
                 {
-                    return token_type::name_separator;
+                    m_it.array_iterator = typename array_t::iterator();
+                    break;
                 }
-basic_json_parser_19:
-                ++m_cursor;
+
+                default:
                 {
-                    return token_type::begin_array;
+                    m_it.primitive_iterator = primitive_iterator_t();
+                    break;
                 }
-basic_json_parser_21:
-                ++m_cursor;
+            }
+        }
+
+        /// copy constructor given a nonconst iterator
+        explicit const_iterator(const iterator& other) noexcept
+            : m_object(other.m_object)
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    return token_type::end_array;
+                    m_it.object_iterator = other.m_it.object_iterator;
+                    break;
                 }
-basic_json_parser_23:
-                yyaccept = 0;
-                yych = *(m_marker = ++m_cursor);
-                if (yych == 'a')
+
+                case basic_json::value_t::array:
                 {
-                    goto basic_json_parser_39;
+                    m_it.array_iterator = other.m_it.array_iterator;
+                    break;
                 }
-                goto basic_json_parser_5;
-basic_json_parser_24:
-                yyaccept = 0;
-                yych = *(m_marker = ++m_cursor);
-                if (yych == 'u')
+
+                default:
                 {
-                    goto basic_json_parser_40;
+                    m_it.primitive_iterator = other.m_it.primitive_iterator;
+                    break;
                 }
-                goto basic_json_parser_5;
-basic_json_parser_25:
-                yyaccept = 0;
-                yych = *(m_marker = ++m_cursor);
-                if (yych == 'r')
+            }
+        }
+
+        /// copy constructor
+        const_iterator(const const_iterator& other) noexcept
+            : m_object(other.m_object), m_it(other.m_it)
+        {}
+
+        /// copy assignment
+        const_iterator& operator=(const_iterator other) noexcept(
+            std::is_nothrow_move_constructible<pointer>::value and
+            std::is_nothrow_move_assignable<pointer>::value and
+            std::is_nothrow_move_constructible<internal_iterator>::value and
+            std::is_nothrow_move_assignable<internal_iterator>::value
+        )
+        {
+            std::swap(m_object, other.m_object);
+            std::swap(m_it, other.m_it);
+            return *this;
+        }
+
+      private:
+        /// set the iterator to the first value
+        void set_begin() noexcept
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_41;
+                    assert(m_object->m_value.object != nullptr);
+                    m_it.object_iterator = m_object->m_value.object->begin();
+                    break;
                 }
-                goto basic_json_parser_5;
-basic_json_parser_26:
-                ++m_cursor;
+
+                case basic_json::value_t::array:
                 {
-                    return token_type::begin_object;
+                    assert(m_object->m_value.array != nullptr);
+                    m_it.array_iterator = m_object->m_value.array->begin();
+                    break;
                 }
-basic_json_parser_28:
-                ++m_cursor;
+
+                case basic_json::value_t::null:
                 {
-                    return token_type::end_object;
+                    // set to end so begin()==end() is true: null is empty
+                    m_it.primitive_iterator.set_end();
+                    break;
                 }
-basic_json_parser_30:
-                yyaccept = 0;
-                yych = *(m_marker = ++m_cursor);
-                if (yych == 0xBB)
+
+                default:
                 {
-                    goto basic_json_parser_42;
+                    m_it.primitive_iterator.set_begin();
+                    break;
                 }
-                goto basic_json_parser_5;
-basic_json_parser_31:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+            }
+        }
+
+        /// set the iterator past the last value
+        void set_end() noexcept
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    assert(m_object->m_value.object != nullptr);
+                    m_it.object_iterator = m_object->m_value.object->end();
+                    break;
                 }
-                yych = *m_cursor;
-basic_json_parser_32:
-                if (yybm[0 + yych] & 128)
+
+                case basic_json::value_t::array:
                 {
-                    goto basic_json_parser_31;
+                    assert(m_object->m_value.array != nullptr);
+                    m_it.array_iterator = m_object->m_value.array->end();
+                    break;
                 }
-                if (yych <= 0x0F)
+
+                default:
                 {
-                    goto basic_json_parser_33;
+                    m_it.primitive_iterator.set_end();
+                    break;
                 }
-                if (yych <= '"')
+            }
+        }
+
+      public:
+        /// return a reference to the value pointed to by the iterator
+        reference operator*() const
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_34;
-                }
-                goto basic_json_parser_36;
-basic_json_parser_33:
-                m_cursor = m_marker;
-                if (yyaccept == 0)
-                {
-                    goto basic_json_parser_5;
-                }
-                else
-                {
-                    goto basic_json_parser_14;
+                    assert(m_object->m_value.object);
+                    assert(m_it.object_iterator != m_object->m_value.object->end());
+                    return m_it.object_iterator->second;
                 }
-basic_json_parser_34:
-                ++m_cursor;
+
+                case basic_json::value_t::array:
                 {
-                    return token_type::value_string;
+                    assert(m_object->m_value.array);
+                    assert(m_it.array_iterator != m_object->m_value.array->end());
+                    return *m_it.array_iterator;
                 }
-basic_json_parser_36:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+
+                case basic_json::value_t::null:
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    throw std::out_of_range("cannot get value");
                 }
-                yych = *m_cursor;
-                if (yych <= 'e')
+
+                default:
                 {
-                    if (yych <= '/')
+                    if (m_it.primitive_iterator.is_begin())
                     {
-                        if (yych == '"')
-                        {
-                            goto basic_json_parser_31;
-                        }
-                        if (yych <= '.')
-                        {
-                            goto basic_json_parser_33;
-                        }
-                        goto basic_json_parser_31;
+                        return *m_object;
                     }
                     else
                     {
-                        if (yych <= '\\')
-                        {
-                            if (yych <= '[')
-                            {
-                                goto basic_json_parser_33;
-                            }
-                            goto basic_json_parser_31;
-                        }
-                        else
-                        {
-                            if (yych == 'b')
-                            {
-                                goto basic_json_parser_31;
-                            }
-                            goto basic_json_parser_33;
-                        }
+                        throw std::out_of_range("cannot get value");
                     }
                 }
-                else
+            }
+        }
+
+        /// dereference the iterator
+        pointer operator->() const
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    if (yych <= 'q')
+                    assert(m_object->m_value.object);
+                    assert(m_it.object_iterator != m_object->m_value.object->end());
+                    return &(m_it.object_iterator->second);
+                }
+
+                case basic_json::value_t::array:
+                {
+                    assert(m_object->m_value.array);
+                    assert(m_it.array_iterator != m_object->m_value.array->end());
+                    return &*m_it.array_iterator;
+                }
+
+                default:
+                {
+                    if (m_it.primitive_iterator.is_begin())
                     {
-                        if (yych <= 'f')
-                        {
-                            goto basic_json_parser_31;
-                        }
-                        if (yych == 'n')
-                        {
-                            goto basic_json_parser_31;
-                        }
-                        goto basic_json_parser_33;
+                        return m_object;
                     }
                     else
                     {
-                        if (yych <= 's')
-                        {
-                            if (yych <= 'r')
-                            {
-                                goto basic_json_parser_31;
-                            }
-                            goto basic_json_parser_33;
-                        }
-                        else
-                        {
-                            if (yych <= 't')
-                            {
-                                goto basic_json_parser_31;
-                            }
-                            if (yych <= 'u')
-                            {
-                                goto basic_json_parser_43;
-                            }
-                            goto basic_json_parser_33;
-                        }
+                        throw std::out_of_range("cannot get value");
                     }
                 }
-basic_json_parser_37:
-                yych = *++m_cursor;
-                if (yych <= '/')
+            }
+        }
+
+        /// post-increment (it++)
+        const_iterator operator++(int)
+        {
+            auto result = *this;
+            ++(*this);
+            return result;
+        }
+
+        /// pre-increment (++it)
+        const_iterator& operator++()
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_33;
+                    ++m_it.object_iterator;
+                    break;
                 }
-                if (yych <= '9')
+
+                case basic_json::value_t::array:
                 {
-                    goto basic_json_parser_44;
+                    ++m_it.array_iterator;
+                    break;
                 }
-                goto basic_json_parser_33;
-basic_json_parser_38:
-                yych = *++m_cursor;
-                if (yych <= ',')
+
+                default:
                 {
-                    if (yych == '+')
-                    {
-                        goto basic_json_parser_46;
-                    }
-                    goto basic_json_parser_33;
+                    ++m_it.primitive_iterator;
+                    break;
                 }
-                else
+            }
+
+            return *this;
+        }
+
+        /// post-decrement (it--)
+        const_iterator operator--(int)
+        {
+            auto result = *this;
+            --(*this);
+            return result;
+        }
+
+        /// pre-decrement (--it)
+        const_iterator& operator--()
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    if (yych <= '-')
-                    {
-                        goto basic_json_parser_46;
-                    }
-                    if (yych <= '/')
-                    {
-                        goto basic_json_parser_33;
-                    }
-                    if (yych <= '9')
-                    {
-                        goto basic_json_parser_47;
-                    }
-                    goto basic_json_parser_33;
+                    --m_it.object_iterator;
+                    break;
                 }
-basic_json_parser_39:
-                yych = *++m_cursor;
-                if (yych == 'l')
+
+                case basic_json::value_t::array:
                 {
-                    goto basic_json_parser_49;
+                    --m_it.array_iterator;
+                    break;
                 }
-                goto basic_json_parser_33;
-basic_json_parser_40:
-                yych = *++m_cursor;
-                if (yych == 'l')
+
+                default:
                 {
-                    goto basic_json_parser_50;
+                    --m_it.primitive_iterator;
+                    break;
                 }
-                goto basic_json_parser_33;
-basic_json_parser_41:
-                yych = *++m_cursor;
-                if (yych == 'u')
+            }
+
+            return *this;
+        }
+
+        /// comparison: equal
+        bool operator==(const const_iterator& other) const
+        {
+            // if objects are not the same, the comparison is undefined
+            if (m_object != other.m_object)
+            {
+                throw std::domain_error("cannot compare iterators of different containers");
+            }
+
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_51;
+                    return (m_it.object_iterator == other.m_it.object_iterator);
                 }
-                goto basic_json_parser_33;
-basic_json_parser_42:
-                yych = *++m_cursor;
-                if (yych == 0xBF)
+
+                case basic_json::value_t::array:
                 {
-                    goto basic_json_parser_52;
+                    return (m_it.array_iterator == other.m_it.array_iterator);
                 }
-                goto basic_json_parser_33;
-basic_json_parser_43:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+
+                default:
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
-                }
-                yych = *m_cursor;
-                if (yych <= '@')
-                {
-                    if (yych <= '/')
-                    {
-                        goto basic_json_parser_33;
-                    }
-                    if (yych <= '9')
-                    {
-                        goto basic_json_parser_54;
-                    }
-                    goto basic_json_parser_33;
-                }
-                else
-                {
-                    if (yych <= 'F')
-                    {
-                        goto basic_json_parser_54;
-                    }
-                    if (yych <= '`')
-                    {
-                        goto basic_json_parser_33;
-                    }
-                    if (yych <= 'f')
-                    {
-                        goto basic_json_parser_54;
-                    }
-                    goto basic_json_parser_33;
-                }
-basic_json_parser_44:
-                yyaccept = 1;
-                m_marker = ++m_cursor;
-                if ((m_limit - m_cursor) < 3)
-                {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    return (m_it.primitive_iterator == other.m_it.primitive_iterator);
                 }
-                yych = *m_cursor;
-                if (yych <= 'D')
+            }
+        }
+
+        /// comparison: not equal
+        bool operator!=(const const_iterator& other) const
+        {
+            return not operator==(other);
+        }
+
+        /// comparison: smaller
+        bool operator<(const const_iterator& other) const
+        {
+            // if objects are not the same, the comparison is undefined
+            if (m_object != other.m_object)
+            {
+                throw std::domain_error("cannot compare iterators of different containers");
+            }
+
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    if (yych <= '/')
-                    {
-                        goto basic_json_parser_14;
-                    }
-                    if (yych <= '9')
-                    {
-                        goto basic_json_parser_44;
-                    }
-                    goto basic_json_parser_14;
+                    throw std::domain_error("cannot compare order of object iterators");
                 }
-                else
+
+                case basic_json::value_t::array:
                 {
-                    if (yych <= 'E')
-                    {
-                        goto basic_json_parser_38;
-                    }
-                    if (yych == 'e')
-                    {
-                        goto basic_json_parser_38;
-                    }
-                    goto basic_json_parser_14;
+                    return (m_it.array_iterator < other.m_it.array_iterator);
                 }
-basic_json_parser_46:
-                yych = *++m_cursor;
-                if (yych <= '/')
+
+                default:
                 {
-                    goto basic_json_parser_33;
+                    return (m_it.primitive_iterator < other.m_it.primitive_iterator);
                 }
-                if (yych >= ':')
+            }
+        }
+
+        /// comparison: less than or equal
+        bool operator<=(const const_iterator& other) const
+        {
+            return not other.operator < (*this);
+        }
+
+        /// comparison: greater than
+        bool operator>(const const_iterator& other) const
+        {
+            return not operator<=(other);
+        }
+
+        /// comparison: greater than or equal
+        bool operator>=(const const_iterator& other) const
+        {
+            return not operator<(other);
+        }
+
+        /// add to iterator
+        const_iterator& operator+=(difference_type i)
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_33;
+                    throw std::domain_error("cannot use offsets with object iterators");
                 }
-basic_json_parser_47:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+
+                case basic_json::value_t::array:
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    m_it.array_iterator += i;
+                    break;
                 }
-                yych = *m_cursor;
-                if (yych <= '/')
+
+                default:
                 {
-                    goto basic_json_parser_14;
+                    m_it.primitive_iterator += i;
+                    break;
                 }
-                if (yych <= '9')
+            }
+
+            return *this;
+        }
+
+        /// subtract from iterator
+        const_iterator& operator-=(difference_type i)
+        {
+            return operator+=(-i);
+        }
+
+        /// add to iterator
+        const_iterator operator+(difference_type i)
+        {
+            auto result = *this;
+            result += i;
+            return result;
+        }
+
+        /// subtract from iterator
+        const_iterator operator-(difference_type i)
+        {
+            auto result = *this;
+            result -= i;
+            return result;
+        }
+
+        /// return difference
+        difference_type operator-(const const_iterator& other) const
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_47;
+                    throw std::domain_error("cannot use offsets with object iterators");
                 }
-                goto basic_json_parser_14;
-basic_json_parser_49:
-                yych = *++m_cursor;
-                if (yych == 's')
+
+                case basic_json::value_t::array:
                 {
-                    goto basic_json_parser_55;
+                    return m_it.array_iterator - other.m_it.array_iterator;
                 }
-                goto basic_json_parser_33;
-basic_json_parser_50:
-                yych = *++m_cursor;
-                if (yych == 'l')
+
+                default:
                 {
-                    goto basic_json_parser_56;
+                    return m_it.primitive_iterator - other.m_it.primitive_iterator;
                 }
-                goto basic_json_parser_33;
-basic_json_parser_51:
-                yych = *++m_cursor;
-                if (yych == 'e')
+            }
+        }
+
+        /// access to successor
+        reference operator[](difference_type n) const
+        {
+            assert(m_object != nullptr);
+
+            switch (m_object->m_type)
+            {
+                case basic_json::value_t::object:
                 {
-                    goto basic_json_parser_58;
+                    throw std::domain_error("cannot use operator[] for object iterators");
                 }
-                goto basic_json_parser_33;
-basic_json_parser_52:
-                ++m_cursor;
+
+                case basic_json::value_t::array:
                 {
-                    return scan();
+                    return *(m_it.array_iterator + n);
                 }
-basic_json_parser_54:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+
+                case basic_json::value_t::null:
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    throw std::out_of_range("cannot get value");
                 }
-                yych = *m_cursor;
-                if (yych <= '@')
+
+                default:
                 {
-                    if (yych <= '/')
+                    if (m_it.primitive_iterator == -n)
                     {
-                        goto basic_json_parser_33;
+                        return *m_object;
                     }
-                    if (yych <= '9')
+                    else
                     {
-                        goto basic_json_parser_60;
+                        throw std::out_of_range("cannot get value");
                     }
-                    goto basic_json_parser_33;
                 }
-                else
-                {
-                    if (yych <= 'F')
+            }
+        }
+
+        /// return the key of an object iterator
+        typename object_t::key_type key() const
+        {
+            assert(m_object != nullptr);
+
+            if (m_object->is_object())
+            {
+                return m_it.object_iterator->first;
+            }
+            else
+            {
+                throw std::domain_error("cannot use key() for non-object iterators");
+            }
+        }
+
+        /// return the value of an iterator
+        reference value() const
+        {
+            return operator*();
+        }
+
+      private:
+        /// associated JSON instance
+        pointer m_object = nullptr;
+        /// the actual iterator of the associated instance
+        internal_iterator m_it = internal_iterator();
+    };
+
+    /*!
+    @brief a mutable random access iterator for the @ref basic_json class
+
+    @requirement The class satisfies the following concept requirements:
+    - [RandomAccessIterator](http://en.cppreference.com/w/cpp/concept/RandomAccessIterator):
+      The iterator that can be moved to point (forward and backward) to any
+      element in constant time.
+    - [OutputIterator](http://en.cppreference.com/w/cpp/concept/OutputIterator):
+      It is possible to write to the pointed-to element.
+
+    @since version 1.0.0
+    */
+    class iterator : public const_iterator
+    {
+      public:
+        using base_iterator = const_iterator;
+        using pointer = typename basic_json::pointer;
+        using reference = typename basic_json::reference;
+
+        /// default constructor
+        iterator() = default;
+
+        /// constructor for a given JSON instance
+        explicit iterator(pointer object) noexcept
+            : base_iterator(object)
+        {}
+
+        /// copy constructor
+        iterator(const iterator& other) noexcept
+            : base_iterator(other)
+        {}
+
+        /// copy assignment
+        iterator& operator=(iterator other) noexcept(
+            std::is_nothrow_move_constructible<pointer>::value and
+            std::is_nothrow_move_assignable<pointer>::value and
+            std::is_nothrow_move_constructible<internal_iterator>::value and
+            std::is_nothrow_move_assignable<internal_iterator>::value
+        )
+        {
+            base_iterator::operator=(other);
+            return *this;
+        }
+
+        /// return a reference to the value pointed to by the iterator
+        reference operator*() const
+        {
+            return const_cast<reference>(base_iterator::operator*());
+        }
+
+        /// dereference the iterator
+        pointer operator->() const
+        {
+            return const_cast<pointer>(base_iterator::operator->());
+        }
+
+        /// post-increment (it++)
+        iterator operator++(int)
+        {
+            iterator result = *this;
+            base_iterator::operator++();
+            return result;
+        }
+
+        /// pre-increment (++it)
+        iterator& operator++()
+        {
+            base_iterator::operator++();
+            return *this;
+        }
+
+        /// post-decrement (it--)
+        iterator operator--(int)
+        {
+            iterator result = *this;
+            base_iterator::operator--();
+            return result;
+        }
+
+        /// pre-decrement (--it)
+        iterator& operator--()
+        {
+            base_iterator::operator--();
+            return *this;
+        }
+
+        /// add to iterator
+        iterator& operator+=(difference_type i)
+        {
+            base_iterator::operator+=(i);
+            return *this;
+        }
+
+        /// subtract from iterator
+        iterator& operator-=(difference_type i)
+        {
+            base_iterator::operator-=(i);
+            return *this;
+        }
+
+        /// add to iterator
+        iterator operator+(difference_type i)
+        {
+            auto result = *this;
+            result += i;
+            return result;
+        }
+
+        /// subtract from iterator
+        iterator operator-(difference_type i)
+        {
+            auto result = *this;
+            result -= i;
+            return result;
+        }
+
+        /// return difference
+        difference_type operator-(const iterator& other) const
+        {
+            return base_iterator::operator-(other);
+        }
+
+        /// access to successor
+        reference operator[](difference_type n) const
+        {
+            return const_cast<reference>(base_iterator::operator[](n));
+        }
+
+        /// return the value of an iterator
+        reference value() const
+        {
+            return const_cast<reference>(base_iterator::value());
+        }
+    };
+
+    /*!
+    @brief a template for a reverse iterator class
+
+    @tparam Base the base iterator type to reverse. Valid types are @ref
+    iterator (to create @ref reverse_iterator) and @ref const_iterator (to
+    create @ref const_reverse_iterator).
+
+    @requirement The class satisfies the following concept requirements:
+    - [RandomAccessIterator](http://en.cppreference.com/w/cpp/concept/RandomAccessIterator):
+      The iterator that can be moved to point (forward and backward) to any
+      element in constant time.
+    - [OutputIterator](http://en.cppreference.com/w/cpp/concept/OutputIterator):
+      It is possible to write to the pointed-to element (only if @a Base is
+      @ref iterator).
+
+    @since version 1.0.0
+    */
+    template<typename Base>
+    class json_reverse_iterator : public std::reverse_iterator<Base>
+    {
+      public:
+        /// shortcut to the reverse iterator adaptor
+        using base_iterator = std::reverse_iterator<Base>;
+        /// the reference type for the pointed-to element
+        using reference = typename Base::reference;
+
+        /// create reverse iterator from iterator
+        json_reverse_iterator(const typename base_iterator::iterator_type& it) noexcept
+            : base_iterator(it)
+        {}
+
+        /// create reverse iterator from base class
+        json_reverse_iterator(const base_iterator& it) noexcept
+            : base_iterator(it)
+        {}
+
+        /// post-increment (it++)
+        json_reverse_iterator operator++(int)
+        {
+            return base_iterator::operator++(1);
+        }
+
+        /// pre-increment (++it)
+        json_reverse_iterator& operator++()
+        {
+            base_iterator::operator++();
+            return *this;
+        }
+
+        /// post-decrement (it--)
+        json_reverse_iterator operator--(int)
+        {
+            return base_iterator::operator--(1);
+        }
+
+        /// pre-decrement (--it)
+        json_reverse_iterator& operator--()
+        {
+            base_iterator::operator--();
+            return *this;
+        }
+
+        /// add to iterator
+        json_reverse_iterator& operator+=(difference_type i)
+        {
+            base_iterator::operator+=(i);
+            return *this;
+        }
+
+        /// add to iterator
+        json_reverse_iterator operator+(difference_type i) const
+        {
+            auto result = *this;
+            result += i;
+            return result;
+        }
+
+        /// subtract from iterator
+        json_reverse_iterator operator-(difference_type i) const
+        {
+            auto result = *this;
+            result -= i;
+            return result;
+        }
+
+        /// return difference
+        difference_type operator-(const json_reverse_iterator& other) const
+        {
+            return this->base() - other.base();
+        }
+
+        /// access to successor
+        reference operator[](difference_type n) const
+        {
+            return *(this->operator+(n));
+        }
+
+        /// return the key of an object iterator
+        typename object_t::key_type key() const
+        {
+            auto it = --this->base();
+            return it.key();
+        }
+
+        /// return the value of an iterator
+        reference value() const
+        {
+            auto it = --this->base();
+            return it.operator * ();
+        }
+    };
+
+
+  private:
+    //////////////////////
+    // lexer and parser //
+    //////////////////////
+
+    /*!
+    @brief lexical analysis
+
+    This class organizes the lexical analysis during JSON deserialization. The
+    core of it is a scanner generated by [re2c](http://re2c.org) that
+    processes a buffer and recognizes tokens according to RFC 7159.
+    */
+    class lexer
+    {
+      public:
+        /// token types for the parser
+        enum class token_type
+        {
+            uninitialized,   ///< indicating the scanner is uninitialized
+            literal_true,    ///< the `true` literal
+            literal_false,   ///< the `false` literal
+            literal_null,    ///< the `null` literal
+            value_string,    ///< a string -- use get_string() for actual value
+            value_number,    ///< a number -- use get_number() for actual value
+            begin_array,     ///< the character for array begin `[`
+            begin_object,    ///< the character for object begin `{`
+            end_array,       ///< the character for array end `]`
+            end_object,      ///< the character for object end `}`
+            name_separator,  ///< the name separator `:`
+            value_separator, ///< the value separator `,`
+            parse_error,     ///< indicating a parse error
+            end_of_input     ///< indicating the end of the input buffer
+        };
+
+        /// the char type to use in the lexer
+        using lexer_char_t = unsigned char;
+
+        /// constructor with a given buffer
+        explicit lexer(const string_t& s) noexcept
+            : m_stream(nullptr), m_buffer()
+        {
+            reset(s);
+        }
+
+        /*!
+        @brief constructor with a given range of characters
+
+        The lexer scans the caller's memory in place; the range need not be
+        null-terminated. Only when the scanner is about to run past @a last
+        is the remainder (the last token) copied into an internal buffer,
+        whose terminating null character then ends the input.
+
+        @param[in] first  pointer to the first character of the input
+        @param[in] last  pointer past the last character of the input
+        */
+        lexer(const char* first, const char* last) noexcept
+            : m_stream(nullptr), m_buffer()
+        {
+            reset(first, last);
+        }
+
+        /// constructor with a given stream
+        explicit lexer(std::istream* s) noexcept
+            : m_stream(s), m_buffer()
+        {
+            assert(m_stream != nullptr);
+            getline(*m_stream, m_buffer);
+            m_content = reinterpret_cast<const lexer_char_t*>(m_buffer.c_str());
+            assert(m_content != nullptr);
+            m_start = m_cursor = m_content;
+            m_limit = m_content + m_buffer.size();
+        }
+
+        /// default constructor
+        lexer() = default;
+
+        // switch off unwanted functions
+        lexer(const lexer&) = delete;
+        lexer operator=(const lexer&) = delete;
+
+        /*!
+        @brief restart the lexer on a new string
+
+        The internal buffer keeps its capacity, so a lexer that is reused
+        for many inputs stops allocating once the buffer is large enough.
+        */
+        void reset(const string_t& s) noexcept
+        {
+            m_stream = nullptr;
+            m_in_range = false;
+            m_offset = 0;
+            m_marker = nullptr;
+            m_content = reinterpret_cast<const lexer_char_t*>(s.c_str());
+            assert(m_content != nullptr);
+            m_start = m_cursor = m_content;
+            m_limit = m_content + s.size();
+        }
+
+        /*!
+        @brief restart the lexer on a new range of characters
+        @sa lexer(const char*, const char*)
+        */
+        void reset(const char* first, const char* last) noexcept
+        {
+            m_stream = nullptr;
+            m_in_range = first != last;
+            m_offset = 0;
+            m_marker = nullptr;
+            if (m_in_range)
+            {
+                m_content = reinterpret_cast<const lexer_char_t*>(first);
+                m_limit = reinterpret_cast<const lexer_char_t*>(last);
+            }
+            else
+            {
+                // empty range: scan the empty buffer's null character
+                m_buffer.clear();
+                m_content = reinterpret_cast<const lexer_char_t*>(m_buffer.c_str());
+                m_limit = m_content;
+            }
+            m_start = m_cursor = m_content;
+        }
+
+        /*!
+        @brief create a string from a Unicode code point
+
+        @param[in] codepoint1  the code point (can be high surrogate)
+        @param[in] codepoint2  the code point (can be low surrogate or 0)
+
+        @return string representation of the code point
+
+        @throw std::out_of_range if code point is > 0x10ffff; example: `"code
+        points above 0x10FFFF are invalid"`
+        @throw std::invalid_argument if the low surrogate is invalid; example:
+        `""missing or wrong low surrogate""`
+
+        @see <http://en.wikipedia.org/wiki/UTF-8#Sample_code>
+        */
+        static string_t to_unicode(const std::size_t codepoint1,
+                                   const std::size_t codepoint2 = 0)
+        {
+            // calculate the codepoint from the given code points
+            std::size_t codepoint = codepoint1;
+
+            // check if codepoint1 is a high surrogate
+            if (codepoint1 >= 0xD800 and codepoint1 <= 0xDBFF)
+            {
+                // check if codepoint2 is a low surrogate
+                if (codepoint2 >= 0xDC00 and codepoint2 <= 0xDFFF)
+                {
+                    codepoint =
+                        // high surrogate occupies the most significant 22 bits
+                        (codepoint1 << 10)
+                        // low surrogate occupies the least significant 15 bits
+                        + codepoint2
+                        // there is still the 0xD800, 0xDC00 and 0x10000 noise
+                        // in the result so we have to subtract with:
+                        // (0xD800 << 10) + DC00 - 0x10000 = 0x35FDC00
+                        - 0x35FDC00;
+                }
+                else
+                {
+                    throw std::invalid_argument("missing or wrong low surrogate");
+                }
+            }
+
+            string_t result;
+
+            if (codepoint < 0x80)
+            {
+                // 1-byte characters: 0xxxxxxx (ASCII)
+                result.append(1, static_cast<typename string_t::value_type>(codepoint));
+            }
+            else if (codepoint <= 0x7ff)
+            {
+                // 2-byte characters: 110xxxxx 10xxxxxx
+                result.append(1, static_cast<typename string_t::value_type>(0xC0 | ((codepoint >> 6) & 0x1F)));
+                result.append(1, static_cast<typename string_t::value_type>(0x80 | (codepoint & 0x3F)));
+            }
+            else if (codepoint <= 0xffff)
+            {
+                // 3-byte characters: 1110xxxx 10xxxxxx 10xxxxxx
+                result.append(1, static_cast<typename string_t::value_type>(0xE0 | ((codepoint >> 12) & 0x0F)));
+                result.append(1, static_cast<typename string_t::value_type>(0x80 | ((codepoint >> 6) & 0x3F)));
+                result.append(1, static_cast<typename string_t::value_type>(0x80 | (codepoint & 0x3F)));
+            }
+            else if (codepoint <= 0x10ffff)
+            {
+                // 4-byte characters: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+                result.append(1, static_cast<typename string_t::value_type>(0xF0 | ((codepoint >> 18) & 0x07)));
+                result.append(1, static_cast<typename string_t::value_type>(0x80 | ((codepoint >> 12) & 0x3F)));
+                result.append(1, static_cast<typename string_t::value_type>(0x80 | ((codepoint >> 6) & 0x3F)));
+                result.append(1, static_cast<typename string_t::value_type>(0x80 | (codepoint & 0x3F)));
+            }
+            else
+            {
+                throw std::out_of_range("code points above 0x10FFFF are invalid");
+            }
+
+            return result;
+        }
+
+        /// return name of values of type token_type (only used for errors)
+        static std::string token_type_name(token_type t)
+        {
+            switch (t)
+            {
+                case token_type::uninitialized:
+                    return "<uninitialized>";
+                case token_type::literal_true:
+                    return "true literal";
+                case token_type::literal_false:
+                    return "false literal";
+                case token_type::literal_null:
+                    return "null literal";
+                case token_type::value_string:
+                    return "string literal";
+                case token_type::value_number:
+                    return "number literal";
+                case token_type::begin_array:
+                    return "'['";
+                case token_type::begin_object:
+                    return "'{'";
+                case token_type::end_array:
+                    return "']'";
+                case token_type::end_object:
+                    return "'}'";
+                case token_type::name_separator:
+                    return "':'";
+                case token_type::value_separator:
+                    return "','";
+                case token_type::parse_error:
+                    return "<parse error>";
+                case token_type::end_of_input:
+                    return "end of input";
+                default:
+                {
+                    // catch non-enum values
+                    return "unknown token"; // LCOV_EXCL_LINE
+                }
+            }
+        }
+
+        /*!
+        This function implements a scanner for JSON. It is specified using
+        regular expressions that try to follow RFC 7159 as close as possible.
+        These regular expressions are then translated into a minimized
+        deterministic finite automaton (DFA) by the tool
+        [re2c](http://re2c.org). As a result, the translated code for this
+        function consists of a large block of code with `goto` jumps.
+
+        @return the class of the next token read from the buffer
+        */
+        token_type scan() noexcept
+        {
+            // pointer for backtracking information
+            m_marker = nullptr;
+
+            // remember the begin of the token
+            m_start = m_cursor;
+            assert(m_start != nullptr);
+
+            // most strings have no escapes; find their end without the
+            // general scanner below
+            if (m_cursor < m_limit and *m_cursor == '"')
+            {
+                bool ascii;
+                const auto first = reinterpret_cast<const char*>(m_cursor + 1);
+                const auto end = string_scanner::find_special(
+                                     first, reinterpret_cast<const char*>(m_limit), ascii);
+                if (end != reinterpret_cast<const char*>(m_limit) and *end == '"')
+                {
+                    m_cursor = reinterpret_cast<const lexer_char_t*>(end + 1);
+                    m_plain_string = true;
+                    return (ascii or string_scanner::valid_utf8(first, end))
+                           ? token_type::value_string : token_type::parse_error;
+                }
+            }
+
+            {
+                lexer_char_t yych;
+                unsigned int yyaccept = 0;
+                static const unsigned char yybm[] =
+                {
+                    0,   0,   0,   0,   0,   0,   0,   0,
+                    0,  32,  32,   0,   0,  32,   0,   0,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    160, 128,   0, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    192, 192, 192, 192, 192, 192, 192, 192,
+                    192, 192, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128,   0, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                    128, 128, 128, 128, 128, 128, 128, 128,
+                };
+                if ((m_limit - m_cursor) < 5)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yybm[0 + yych] & 32)
+                {
+                    goto basic_json_parser_6;
+                }
+                if (yych <= '\\')
+                {
+                    if (yych <= '-')
+                    {
+                        if (yych <= '"')
+                        {
+                            if (yych <= 0x00)
+                            {
+                                goto basic_json_parser_2;
+                            }
+                            if (yych <= '!')
+                            {
+                                goto basic_json_parser_4;
+                            }
+                            goto basic_json_parser_9;
+                        }
+                        else
+                        {
+                            if (yych <= '+')
+                            {
+                                goto basic_json_parser_4;
+                            }
+                            if (yych <= ',')
+                            {
+                                goto basic_json_parser_10;
+                            }
+                            goto basic_json_parser_12;
+                        }
+                    }
+                    else
+                    {
+                        if (yych <= '9')
+                        {
+                            if (yych <= '/')
+                            {
+                                goto basic_json_parser_4;
+                            }
+                            if (yych <= '0')
+                            {
+                                goto basic_json_parser_13;
+                            }
+                            goto basic_json_parser_15;
+                        }
+                        else
+                        {
+                            if (yych <= ':')
+                            {
+                                goto basic_json_parser_17;
+                            }
+                            if (yych == '[')
+                            {
+                                goto basic_json_parser_19;
+                            }
+                            goto basic_json_parser_4;
+                        }
+                    }
+                }
+                else
+                {
+                    if (yych <= 't')
+                    {
+                        if (yych <= 'f')
+                        {
+                            if (yych <= ']')
+                            {
+                                goto basic_json_parser_21;
+                            }
+                            if (yych <= 'e')
+                            {
+                                goto basic_json_parser_4;
+                            }
+                            goto basic_json_parser_23;
+                        }
+                        else
+                        {
+                            if (yych == 'n')
+                            {
+                                goto basic_json_parser_24;
+                            }
+                            if (yych <= 's')
+                            {
+                                goto basic_json_parser_4;
+                            }
+                            goto basic_json_parser_25;
+                        }
+                    }
+                    else
+                    {
+                        if (yych <= '|')
+                        {
+                            if (yych == '{')
+                            {
+                                goto basic_json_parser_26;
+                            }
+                            goto basic_json_parser_4;
+                        }
+                        else
+                        {
+                            if (yych <= '}')
+                            {
+                                goto basic_json_parser_28;
+                            }
+                            if (yych == 0xEF)
+                            {
+                                goto basic_json_parser_30;
+                            }
+                            goto basic_json_parser_4;
+                        }
+                    }
+                }
+basic_json_parser_2:
+                ++m_cursor;
+                {
+                    return token_type::end_of_input;
+                }
+basic_json_parser_4:
+                ++m_cursor;
+basic_json_parser_5:
+                {
+                    return token_type::parse_error;
+                }
+basic_json_parser_6:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yybm[0 + yych] & 32)
+                {
+                    goto basic_json_parser_6;
+                }
+                {
+                    return scan();
+                }
+basic_json_parser_9:
+                yyaccept = 0;
+                yych = *(m_marker = ++m_cursor);
+                if (yych <= 0x0F)
+                {
+                    goto basic_json_parser_5;
+                }
+                goto basic_json_parser_32;
+basic_json_parser_10:
+                ++m_cursor;
+                {
+                    return token_type::value_separator;
+                }
+basic_json_parser_12:
+                yych = *++m_cursor;
+                if (yych <= '/')
+                {
+                    goto basic_json_parser_5;
+                }
+                if (yych <= '0')
+                {
+                    goto basic_json_parser_13;
+                }
+                if (yych <= '9')
+                {
+                    goto basic_json_parser_15;
+                }
+                goto basic_json_parser_5;
+basic_json_parser_13:
+                yyaccept = 1;
+                yych = *(m_marker = ++m_cursor);
+                if (yych <= 'D')
+                {
+                    if (yych == '.')
+                    {
+                        goto basic_json_parser_37;
+                    }
+                }
+                else
+                {
+                    if (yych <= 'E')
+                    {
+                        goto basic_json_parser_38;
+                    }
+                    if (yych == 'e')
+                    {
+                        goto basic_json_parser_38;
+                    }
+                }
+basic_json_parser_14:
+                {
+                    return token_type::value_number;
+                }
+basic_json_parser_15:
+                yyaccept = 1;
+                m_marker = ++m_cursor;
+                if ((m_limit - m_cursor) < 3)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yybm[0 + yych] & 64)
+                {
+                    goto basic_json_parser_15;
+                }
+                if (yych <= 'D')
+                {
+                    if (yych == '.')
+                    {
+                        goto basic_json_parser_37;
+                    }
+                    goto basic_json_parser_14;
+                }
+                else
+                {
+                    if (yych <= 'E')
+                    {
+                        goto basic_json_parser_38;
+                    }
+                    if (yych == 'e')
+                    {
+                        goto basic_json_parser_38;
+                    }
+                    goto basic_json_parser_14;
+                }
+basic_json_parser_17:
+                ++m_cursor;
+                {
+                    return token_type::name_separator;
+                }
+basic_json_parser_19:
+                ++m_cursor;
+                {
+                    return token_type::begin_array;
+                }
+basic_json_parser_21:
+                ++m_cursor;
+                {
+                    return token_type::end_array;
+                }
+basic_json_parser_23:
+                yyaccept = 0;
+                yych = *(m_marker = ++m_cursor);
+                if (yych == 'a')
+                {
+                    goto basic_json_parser_39;
+                }
+                goto basic_json_parser_5;
+basic_json_parser_24:
+                yyaccept = 0;
+                yych = *(m_marker = ++m_cursor);
+                if (yych == 'u')
+                {
+                    goto basic_json_parser_40;
+                }
+                goto basic_json_parser_5;
+basic_json_parser_25:
+                yyaccept = 0;
+                yych = *(m_marker = ++m_cursor);
+                if (yych == 'r')
+                {
+                    goto basic_json_parser_41;
+                }
+                goto basic_json_parser_5;
+basic_json_parser_26:
+                ++m_cursor;
+                {
+                    return token_type::begin_object;
+                }
+basic_json_parser_28:
+                ++m_cursor;
+                {
+                    return token_type::end_object;
+                }
+basic_json_parser_30:
+                yyaccept = 0;
+                yych = *(m_marker = ++m_cursor);
+                if (yych == 0xBB)
+                {
+                    goto basic_json_parser_42;
+                }
+                goto basic_json_parser_5;
+basic_json_parser_31:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+basic_json_parser_32:
+                if (yybm[0 + yych] & 128)
+                {
+                    goto basic_json_parser_31;
+                }
+                if (yych <= 0x0F)
+                {
+                    goto basic_json_parser_33;
+                }
+                if (yych <= '"')
+                {
+                    goto basic_json_parser_34;
+                }
+                goto basic_json_parser_36;
+basic_json_parser_33:
+                m_cursor = m_marker;
+                if (yyaccept == 0)
+                {
+                    goto basic_json_parser_5;
+                }
+                else
+                {
+                    goto basic_json_parser_14;
+                }
+basic_json_parser_34:
+                ++m_cursor;
+                {
+                    m_plain_string = false;
+                    return string_scanner::valid_utf8(reinterpret_cast<const char*>(m_start + 1),
+                                                      reinterpret_cast<const char*>(m_cursor - 1))
+                           ? token_type::value_string : token_type::parse_error;
+                }
+basic_json_parser_36:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= 'e')
+                {
+                    if (yych <= '/')
+                    {
+                        if (yych == '"')
+                        {
+                            goto basic_json_parser_31;
+                        }
+                        if (yych <= '.')
+                        {
+                            goto basic_json_parser_33;
+                        }
+                        goto basic_json_parser_31;
+                    }
+                    else
+                    {
+                        if (yych <= '\\')
+                        {
+                            if (yych <= '[')
+                            {
+                                goto basic_json_parser_33;
+                            }
+                            goto basic_json_parser_31;
+                        }
+                        else
+                        {
+                            if (yych == 'b')
+                            {
+                                goto basic_json_parser_31;
+                            }
+                            goto basic_json_parser_33;
+                        }
+                    }
+                }
+                else
+                {
+                    if (yych <= 'q')
+                    {
+                        if (yych <= 'f')
+                        {
+                            goto basic_json_parser_31;
+                        }
+                        if (yych == 'n')
+                        {
+                            goto basic_json_parser_31;
+                        }
+                        goto basic_json_parser_33;
+                    }
+                    else
+                    {
+                        if (yych <= 's')
+                        {
+                            if (yych <= 'r')
+                            {
+                                goto basic_json_parser_31;
+                            }
+                            goto basic_json_parser_33;
+                        }
+                        else
+                        {
+                            if (yych <= 't')
+                            {
+                                goto basic_json_parser_31;
+                            }
+                            if (yych <= 'u')
+                            {
+                                goto basic_json_parser_43;
+                            }
+                            goto basic_json_parser_33;
+                        }
+                    }
+                }
+basic_json_parser_37:
+                yych = *++m_cursor;
+                if (yych <= '/')
+                {
+                    goto basic_json_parser_33;
+                }
+                if (yych <= '9')
+                {
+                    goto basic_json_parser_44;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_38:
+                yych = *++m_cursor;
+                if (yych <= ',')
+                {
+                    if (yych == '+')
+                    {
+                        goto basic_json_parser_46;
+                    }
+                    goto basic_json_parser_33;
+                }
+                else
+                {
+                    if (yych <= '-')
+                    {
+                        goto basic_json_parser_46;
+                    }
+                    if (yych <= '/')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= '9')
+                    {
+                        goto basic_json_parser_47;
+                    }
+                    goto basic_json_parser_33;
+                }
+basic_json_parser_39:
+                yych = *++m_cursor;
+                if (yych == 'l')
+                {
+                    goto basic_json_parser_49;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_40:
+                yych = *++m_cursor;
+                if (yych == 'l')
+                {
+                    goto basic_json_parser_50;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_41:
+                yych = *++m_cursor;
+                if (yych == 'u')
+                {
+                    goto basic_json_parser_51;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_42:
+                yych = *++m_cursor;
+                if (yych == 0xBF)
+                {
+                    goto basic_json_parser_52;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_43:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= '@')
+                {
+                    if (yych <= '/')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= '9')
+                    {
+                        goto basic_json_parser_54;
+                    }
+                    goto basic_json_parser_33;
+                }
+                else
+                {
+                    if (yych <= 'F')
+                    {
+                        goto basic_json_parser_54;
+                    }
+                    if (yych <= '`')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= 'f')
+                    {
+                        goto basic_json_parser_54;
+                    }
+                    goto basic_json_parser_33;
+                }
+basic_json_parser_44:
+                yyaccept = 1;
+                m_marker = ++m_cursor;
+                if ((m_limit - m_cursor) < 3)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= 'D')
+                {
+                    if (yych <= '/')
+                    {
+                        goto basic_json_parser_14;
+                    }
+                    if (yych <= '9')
+                    {
+                        goto basic_json_parser_44;
+                    }
+                    goto basic_json_parser_14;
+                }
+                else
+                {
+                    if (yych <= 'E')
+                    {
+                        goto basic_json_parser_38;
+                    }
+                    if (yych == 'e')
+                    {
+                        goto basic_json_parser_38;
+                    }
+                    goto basic_json_parser_14;
+                }
+basic_json_parser_46:
+                yych = *++m_cursor;
+                if (yych <= '/')
+                {
+                    goto basic_json_parser_33;
+                }
+                if (yych >= ':')
+                {
+                    goto basic_json_parser_33;
+                }
+basic_json_parser_47:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= '/')
+                {
+                    goto basic_json_parser_14;
+                }
+                if (yych <= '9')
+                {
+                    goto basic_json_parser_47;
+                }
+                goto basic_json_parser_14;
+basic_json_parser_49:
+                yych = *++m_cursor;
+                if (yych == 's')
+                {
+                    goto basic_json_parser_55;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_50:
+                yych = *++m_cursor;
+                if (yych == 'l')
+                {
+                    goto basic_json_parser_56;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_51:
+                yych = *++m_cursor;
+                if (yych == 'e')
+                {
+                    goto basic_json_parser_58;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_52:
+                ++m_cursor;
+                {
+                    return scan();
+                }
+basic_json_parser_54:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= '@')
+                {
+                    if (yych <= '/')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= '9')
+                    {
+                        goto basic_json_parser_60;
+                    }
+                    goto basic_json_parser_33;
+                }
+                else
+                {
+                    if (yych <= 'F')
+                    {
+                        goto basic_json_parser_60;
+                    }
+                    if (yych <= '`')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= 'f')
+                    {
+                        goto basic_json_parser_60;
+                    }
+                    goto basic_json_parser_33;
+                }
+basic_json_parser_55:
+                yych = *++m_cursor;
+                if (yych == 'e')
+                {
+                    goto basic_json_parser_61;
+                }
+                goto basic_json_parser_33;
+basic_json_parser_56:
+                ++m_cursor;
+                {
+                    return token_type::literal_null;
+                }
+basic_json_parser_58:
+                ++m_cursor;
+                {
+                    return token_type::literal_true;
+                }
+basic_json_parser_60:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= '@')
+                {
+                    if (yych <= '/')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= '9')
+                    {
+                        goto basic_json_parser_63;
+                    }
+                    goto basic_json_parser_33;
+                }
+                else
+                {
+                    if (yych <= 'F')
+                    {
+                        goto basic_json_parser_63;
+                    }
+                    if (yych <= '`')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= 'f')
+                    {
+                        goto basic_json_parser_63;
+                    }
+                    goto basic_json_parser_33;
+                }
+basic_json_parser_61:
+                ++m_cursor;
+                {
+                    return token_type::literal_false;
+                }
+basic_json_parser_63:
+                ++m_cursor;
+                if (m_limit <= m_cursor)
+                {
+                    yyfill();    // LCOV_EXCL_LINE;
+                }
+                yych = *m_cursor;
+                if (yych <= '@')
+                {
+                    if (yych <= '/')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= '9')
+                    {
+                        goto basic_json_parser_31;
+                    }
+                    goto basic_json_parser_33;
+                }
+                else
+                {
+                    if (yych <= 'F')
+                    {
+                        goto basic_json_parser_31;
+                    }
+                    if (yych <= '`')
+                    {
+                        goto basic_json_parser_33;
+                    }
+                    if (yych <= 'f')
+                    {
+                        goto basic_json_parser_31;
+                    }
+                    goto basic_json_parser_33;
+                }
+            }
+
+        }
+
+        /// append data from the stream to the internal buffer
+        void yyfill() noexcept
+        {
+            if (m_in_range)
+            {
+                fill_from_range();
+                return;
+            }
+
+            if (m_stream == nullptr or not * m_stream)
+            {
+                return;
+            }
+
+            const auto offset_start = m_start - m_content;
+            const auto offset_marker = m_marker - m_start;
+            const auto offset_cursor = m_cursor - m_start;
+
+            m_offset += static_cast<std::size_t>(offset_start);
+            m_buffer.erase(0, static_cast<size_t>(offset_start));
+            std::string line;
+            assert(m_stream != nullptr);
+            std::getline(*m_stream, line);
+            m_buffer += "\n" + line; // add line with newline symbol
+
+            m_content = reinterpret_cast<const lexer_char_t*>(m_buffer.c_str());
+            assert(m_content != nullptr);
+            m_start  = m_content;
+            m_marker = m_start + offset_marker;
+            m_cursor = m_start + offset_cursor;
+            m_limit  = m_start + m_buffer.size() - 1;
+        }
+
+        /*!
+        @brief leave the caller's memory in range mode
+
+        Copies the rest of the input, starting at the current token, into
+        m_buffer and scans on from there. Past this point there is nothing
+        more to read, so the buffer's null character ends the input.
+        */
+        void fill_from_range() noexcept
+        {
+            const auto offset_marker = m_marker == nullptr ? -1 : m_marker - m_start;
+            const auto offset_cursor = m_cursor - m_start;
+
+            m_in_range = false;
+            m_offset += static_cast<std::size_t>(m_start - m_content);
+            m_buffer.assign(reinterpret_cast<typename string_t::const_pointer>(m_start),
+                            static_cast<size_t>(m_limit - m_start));
+
+            m_content = reinterpret_cast<const lexer_char_t*>(m_buffer.c_str());
+            m_start  = m_content;
+            m_marker = offset_marker < 0 ? nullptr : m_start + offset_marker;
+            m_cursor = m_start + offset_cursor;
+            m_limit  = m_start + m_buffer.size();
+        }
+
+        /// return string representation of last read token
+        string_t get_token() const
+        {
+            assert(m_start != nullptr);
+            return string_t(reinterpret_cast<typename string_t::const_pointer>(m_start),
+                            static_cast<size_t>(m_cursor - m_start));
+        }
+
+        /*!
+        @brief return string value for string tokens
+
+        The function iterates the characters between the opening and closing
+        quotes of the string value. The complete string is the range
+        [m_start,m_cursor). Consequently, we iterate from m_start+1 to
+        m_cursor-1.
+
+        We differentiate two cases:
+
+        1. Escaped characters. In this case, a new character is constructed
+           according to the nature of the escape. Some escapes create new
+           characters (e.g., `"\\n"` is replaced by `"\n"`), some are copied
+           as is (e.g., `"\\\\"`). Furthermore, Unicode escapes of the shape
+           `"\\uxxxx"` need special care. In this case, to_unicode takes care
+           of the construction of the values.
+        2. Unescaped characters are copied as is, a whole run between two
+           escapes at a time.
+
+        @return string value of current token without opening and closing
+        quotes
+        @throw std::out_of_range if to_unicode fails
+        */
+        string_t get_string() const
+        {
+            string_t result;
+            get_string(result);
+            return result;
+        }
+
+        /*!
+        @brief return string value for string tokens as a view
+
+        Unescaping is only done (into @a scratch) if the string contains an
+        escape sequence; otherwise the view points into the lexer's input.
+        Strings found by the fast path in @ref scan are known to have none.
+
+        @param[in,out] scratch  buffer for the unescaped string, if needed
+        @return view of the string value of the current token without opening
+        and closing quotes
+        @throw std::out_of_range if to_unicode fails
+        */
+        string_ref get_string_ref(string_t& scratch) const
+        {
+            const auto first = reinterpret_cast<const char*>(m_start + 1);
+            const auto len = static_cast<size_t>(m_cursor - m_start - 2);
+            if (m_plain_string or std::memchr(first, '\\', len) == nullptr)
+            {
+                return string_ref(first, len);
+            }
+            scratch.clear();
+            get_string(scratch);
+            return string_ref(scratch.data(), scratch.size());
+        }
+
+        /// return the last read token as a view
+        string_ref get_token_ref() const noexcept
+        {
+            return string_ref(reinterpret_cast<const char*>(m_start),
+                              static_cast<size_t>(m_cursor - m_start));
+        }
+
+        /// return the offset of the last read token in the input
+        std::size_t get_position() const noexcept
+        {
+            return m_offset + static_cast<std::size_t>(m_start - m_content);
+        }
+
+        /*!
+        @brief append string value for string tokens to a string
+
+        @param[in,out] result  string to append the unescaped value to
+        @throw std::out_of_range if to_unicode fails
+        @sa get_string()
+        */
+        void get_string(string_t& result) const
+        {
+            if (m_plain_string)
+            {
+                // no escapes: a single copy
+                result.append(reinterpret_cast<typename string_t::const_pointer>(m_start + 1),
+                              static_cast<size_t>(m_cursor - m_start - 2));
+                return;
+            }
+
+            result.reserve(result.size() + static_cast<size_t>(m_cursor - m_start - 2));
+
+            // iterate the result between the quotes
+            for (const lexer_char_t* i = m_start + 1; i < m_cursor - 1; ++i)
+            {
+                // copy runs of unescaped characters in one go
+                const auto run_end = static_cast<const lexer_char_t*>(
+                                         std::memchr(i, '\\', static_cast<size_t>(m_cursor - 1 - i)));
+                if (run_end != i)
+                {
+                    const auto n = (run_end == nullptr ? m_cursor - 1 : run_end) - i;
+                    result.append(reinterpret_cast<typename string_t::const_pointer>(i),
+                                  static_cast<size_t>(n));
+                    i += n - 1;
+                    continue;
+                }
+
+                // process escaped characters; all other characters were
+                // copied above
+                if (*i == '\\')
+                {
+                    // read next character
+                    ++i;
+
+                    switch (*i)
+                    {
+                        // the default escapes
+                        case 't':
+                        {
+                            result += "\t";
+                            break;
+                        }
+                        case 'b':
+                        {
+                            result += "\b";
+                            break;
+                        }
+                        case 'f':
+                        {
+                            result += "\f";
+                            break;
+                        }
+                        case 'n':
+                        {
+                            result += "\n";
+                            break;
+                        }
+                        case 'r':
+                        {
+                            result += "\r";
+                            break;
+                        }
+                        case '\\':
+                        {
+                            result += "\\";
+                            break;
+                        }
+                        case '/':
+                        {
+                            result += "/";
+                            break;
+                        }
+                        case '"':
+                        {
+                            result += "\"";
+                            break;
+                        }
+
+                        // unicode
+                        case 'u':
+                        {
+                            // get code xxxx from uxxxx
+                            auto codepoint = std::strtoul(std::string(reinterpret_cast<typename string_t::const_pointer>(i + 1),
+                                                          4).c_str(), nullptr, 16);
+
+                            // check if codepoint is a high surrogate
+                            if (codepoint >= 0xD800 and codepoint <= 0xDBFF)
+                            {
+                                // make sure there is a subsequent unicode
+                                if ((i + 6 >= m_limit) or * (i + 5) != '\\' or * (i + 6) != 'u')
+                                {
+                                    throw std::invalid_argument("missing low surrogate");
+                                }
+
+                                // get code yyyy from uxxxx\uyyyy
+                                auto codepoint2 = std::strtoul(std::string(reinterpret_cast<typename string_t::const_pointer>
+                                                               (i + 7), 4).c_str(), nullptr, 16);
+                                result += to_unicode(codepoint, codepoint2);
+                                // skip the next 10 characters (xxxx\uyyyy)
+                                i += 10;
+                            }
+                            else
+                            {
+                                // add unicode character(s)
+                                result += to_unicode(codepoint);
+                                // skip the next four characters (xxxx)
+                                i += 4;
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        /*!
+        @brief parse floating point number
+
+        This function (and its overloads) serves to select the most approprate
+        standard floating point number parsing function based on the type
+        supplied via the first parameter.  Set this to @a
+        static_cast<number_float_t*>(nullptr).
+
+        @param[in] type  the @ref number_float_t in use
+
+        @param[in,out] endptr recieves a pointer to the first character after
+        the number
+
+        @return the floating point number
+
+        @bug For `float` and `long double`, this function uses `std::strtof`
+        or `std::strtold` which use the current C locale to determine which
+        character is used as decimal point character. This may yield to parse
+        errors if the locale does not used `.`. Doubles are converted by @ref
+        float_parser, which does not depend on the locale.
+        */
+        long double str_to_float_t(long double* /* type */, char** endptr) const
+        {
+            return std::strtold(reinterpret_cast<typename string_t::const_pointer>(m_start), endptr);
+        }
+
+        /*!
+        @brief parse floating point number
+
+        This function (and its overloads) serves to select the most approprate
+        standard floating point number parsing function based on the type
+        supplied via the first parameter.  Set this to @a
+        static_cast<number_float_t*>(nullptr).
+
+        @param[in] type  the @ref number_float_t in use
+
+        @return the correctly rounded floating point number, independent of
+        the C locale
+        */
+        double str_to_float_t(double* /* type */, char** /* endptr */) const
+        {
+            return float_parser::parse(reinterpret_cast<const char*>(m_start),
+                                       reinterpret_cast<const char*>(m_cursor));
+        }
+
+        /*!
+        @brief parse floating point number
+
+        This function (and its overloads) serves to select the most approprate
+        standard floating point number parsing function based on the type
+        supplied via the first parameter.  Set this to @a
+        static_cast<number_float_t*>(nullptr).
+
+        @param[in] type  the @ref number_float_t in use
+
+        @param[in,out] endptr  recieves a pointer to the first character after
+        the number
+
+        @return the floating point number
+        */
+        float str_to_float_t(float* /* type */, char** endptr) const
+        {
+            return std::strtof(reinterpret_cast<typename string_t::const_pointer>(m_start), endptr);
+        }
+
+        /*!
+        @brief return number value for number tokens
+
+        This function translates the last token into the most appropriate
+        number type (either integer, unsigned integer or floating point),
+        which is passed back to the caller via the result parameter.
+
+        Up to 19 digits are accumulated without overflow checks (they cannot
+        overflow 64 bits); only a 20th digit needs one. If there is no radix
+        point or exponent, and the number can fit into a @ref
+        number_integer_t or @ref number_unsigned_t then it sets the result
+        parameter accordingly.
+
+        Otherwise the number is parsed as a floating point number, in place
+        (see @ref str_to_float_t).
+
+        @param[out] result  @ref basic_json object to receive the number
+        */
+        void get_number(basic_json& result) const
+        {
+            assert(m_start != nullptr);
+
+            const lexer::lexer_char_t* curptr = m_start;
+            const bool negative = (*curptr == '-');
+            if (negative)
+            {
+                curptr++;
+            }
+
+            // accumulate the integer conversion result (unsigned for now)
+            uint64_t value = 0;
+            const lexer::lexer_char_t* const safe_end =
+                (m_cursor - curptr > 19) ? curptr + 19 : m_cursor;
+            while (curptr < safe_end and *curptr >= '0' and *curptr <= '9')
+            {
+                value = value * 10 + static_cast<uint64_t>(*curptr++ - '0');
+            }
+
+            bool is_integer = (curptr == m_cursor);
+            if (curptr == safe_end and m_cursor - curptr == 1 and *curptr >= '0' and *curptr <= '9')
+            {
+                // a 20th digit: test for overflow
+                const uint64_t digit = static_cast<uint64_t>(*curptr - '0');
+                const uint64_t limit = (std::numeric_limits<uint64_t>::max)() / 10;
+                if (value < limit or (value == limit and digit <= (std::numeric_limits<uint64_t>::max)() % 10))
+                {
+                    value = value * 10 + digit;
+                    is_integer = true;
+                }
+            }
+
+            if (is_integer and negative)
+            {
+                // maximum absolute value of a negative number_integer_t
+                const uint64_t max = static_cast<uint64_t>((std::numeric_limits<number_integer_t>::max)()) + 1;
+                if (value <= max)
+                {
+                    // negate without overflowing at the minimum
+                    result.m_value.number_integer = (value == 0) ? 0 :
+                                                    -static_cast<number_integer_t>(value - 1) - 1;
+                    result.m_type = value_t::number_integer;
+                    return;
+                }
+            }
+            else if (is_integer)
+            {
+                if (value <= static_cast<uint64_t>((std::numeric_limits<number_unsigned_t>::max)()))
+                {
+                    result.m_value.number_unsigned = static_cast<number_unsigned_t>(value);
+                    result.m_type = value_t::number_unsigned;
+                    return;
+                }
+            }
+
+            result.m_value.number_float = str_to_float_t(static_cast<number_float_t*>(nullptr), NULL);
+            result.m_type = value_t::number_float;
+        }
+
+      private:
+        /// optional input stream
+        std::istream* m_stream = nullptr;
+        /// the buffer
+        string_t m_buffer;
+        /// the buffer pointer
+        const lexer_char_t* m_content = nullptr;
+        /// pointer to the beginning of the current symbol
+        const lexer_char_t* m_start = nullptr;
+        /// pointer for backtracking information
+        const lexer_char_t* m_marker = nullptr;
+        /// pointer to the current symbol
+        const lexer_char_t* m_cursor = nullptr;
+        /// pointer to the end of the buffer
+        const lexer_char_t* m_limit = nullptr;
+        /// whether m_content still points into a caller's (unterminated) range
+        bool m_in_range = false;
+        /// offset of m_content in the input
+        std::size_t m_offset = 0;
+        /// whether the current string token is known to contain no escapes
+        bool m_plain_string = false;
+    };
+
+    /*!
+    @brief syntax analysis
+
+    This class implements a recursive decent parser.
+    */
+    class parser
+    {
+      public:
+        /// constructor for strings
+        parser(const string_t& s, parser_callback_t cb = nullptr) noexcept
+            : callback(cb), m_lexer(s)
+        {
+            // read first token
+            get_token();
+        }
+
+        /// a parser reading from an input stream
+        parser(std::istream& _is, parser_callback_t cb = nullptr) noexcept
+            : callback(cb), m_lexer(&_is)
+        {
+            // read first token
+            get_token();
+        }
+
+        /// a parser reading from a range of characters
+        parser(const char* first, const char* last, parser_callback_t cb = nullptr) noexcept
+            : callback(cb), m_lexer(first, last)
+        {
+            // read first token
+            get_token();
+        }
+
+        /// a parser without input; call reset() before parsing
+        parser() = default;
+
+        /// restart the parser on a new string
+        void reset(const string_t& s) noexcept
+        {
+            m_lexer.reset(s);
+            depth = 0;
+            m_seen.clear();
+            m_seen_keys.clear();
+            get_token();
+        }
+
+        /// restart the parser on a new range of characters
+        void reset(const char* first, const char* last) noexcept
+        {
+            m_lexer.reset(first, last);
+            depth = 0;
+            m_seen.clear();
+            m_seen_keys.clear();
+            get_token();
+        }
+
+        /*!
+        @brief parse into an existing value, reusing its storage
+
+        Object members whose keys appear again are parsed in place, array
+        elements are overwritten front to back, and strings keep their
+        capacity. Members and elements not in the input are removed. The
+        callback is not used.
+
+        @param[in,out] result  value to overwrite with the parse result; if
+        an exception is thrown, it holds some valid but unspecified value
+        */
+        void parse(basic_json& result)
+        {
+            parse_internal(result);
+            expect(lexer::token_type::end_of_input);
+        }
+
+        /// public parser interface
+        basic_json parse()
+        {
+            basic_json result = parse_internal(true);
+
+            expect(lexer::token_type::end_of_input);
+
+            // return parser result and replace it with null in case the
+            // top-level value was discarded by the callback function
+            return result.is_discarded() ? basic_json() : result;
+        }
+
+      private:
+        /// the actual parser
+        basic_json parse_internal(bool keep)
+        {
+            auto result = basic_json(value_t::discarded);
+
+            switch (last_token)
+            {
+                case lexer::token_type::begin_object:
+                {
+                    if (keep and (not callback or (keep = callback(depth++, parse_event_t::object_start, result))))
+                    {
+                        // explicitly set result to object to cope with {}
+                        result.m_type = value_t::object;
+                        result.m_value = json_value(value_t::object);
+                    }
+
+                    // read next token
+                    get_token();
+
+                    // closing } -> we are done
+                    if (last_token == lexer::token_type::end_object)
                     {
-                        goto basic_json_parser_60;
+                        get_token();
+                        if (keep and callback and not callback(--depth, parse_event_t::object_end, result))
+                        {
+                            result = basic_json(value_t::discarded);
+                        }
+                        return result;
                     }
-                    if (yych <= '`')
+
+                    // no comma is expected here
+                    unexpect(lexer::token_type::value_separator);
+
+                    // otherwise: parse key-value pairs
+                    do
                     {
-                        goto basic_json_parser_33;
+                        // ugly, but could be fixed with loop reorganization
+                        if (last_token == lexer::token_type::value_separator)
+                        {
+                            get_token();
+                        }
+
+                        // store key
+                        expect(lexer::token_type::value_string);
+                        const auto key = m_lexer.get_string();
+
+                        bool keep_tag = false;
+                        if (keep)
+                        {
+                            if (callback)
+                            {
+                                basic_json k(key);
+                                keep_tag = callback(depth, parse_event_t::key, k);
+                            }
+                            else
+                            {
+                                keep_tag = true;
+                            }
+                        }
+
+                        // parse separator (:)
+                        get_token();
+                        expect(lexer::token_type::name_separator);
+
+                        // parse and add value
+                        get_token();
+                        auto value = parse_internal(keep);
+                        if (keep and keep_tag and not value.is_discarded())
+                        {
+                            result[key] = std::move(value);
+                        }
                     }
-                    if (yych <= 'f')
+                    while (last_token == lexer::token_type::value_separator);
+
+                    // closing }
+                    expect(lexer::token_type::end_object);
+                    get_token();
+                    if (keep and callback and not callback(--depth, parse_event_t::object_end, result))
                     {
-                        goto basic_json_parser_60;
+                        result = basic_json(value_t::discarded);
                     }
-                    goto basic_json_parser_33;
-                }
-basic_json_parser_55:
-                yych = *++m_cursor;
-                if (yych == 'e')
-                {
-                    goto basic_json_parser_61;
-                }
-                goto basic_json_parser_33;
-basic_json_parser_56:
-                ++m_cursor;
-                {
-                    return token_type::literal_null;
-                }
-basic_json_parser_58:
-                ++m_cursor;
-                {
-                    return token_type::literal_true;
-                }
-basic_json_parser_60:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
-                {
-                    yyfill();    // LCOV_EXCL_LINE;
+
+                    return result;
                 }
-                yych = *m_cursor;
-                if (yych <= '@')
+
+                case lexer::token_type::begin_array:
                 {
-                    if (yych <= '/')
-                    {
-                        goto basic_json_parser_33;
-                    }
-                    if (yych <= '9')
+                    if (keep and (not callback or (keep = callback(depth++, parse_event_t::array_start, result))))
                     {
-                        goto basic_json_parser_63;
+                        // explicitly set result to object to cope with []
+                        result.m_type = value_t::array;
+                        result.m_value = json_value(value_t::array);
                     }
-                    goto basic_json_parser_33;
-                }
-                else
-                {
-                    if (yych <= 'F')
+
+                    // read next token
+                    get_token();
+
+                    // closing ] -> we are done
+                    if (last_token == lexer::token_type::end_array)
                     {
-                        goto basic_json_parser_63;
+                        get_token();
+                        if (callback and not callback(--depth, parse_event_t::array_end, result))
+                        {
+                            result = basic_json(value_t::discarded);
+                        }
+                        return result;
                     }
-                    if (yych <= '`')
+
+                    // no comma is expected here
+                    unexpect(lexer::token_type::value_separator);
+
+                    // otherwise: parse values
+                    do
                     {
-                        goto basic_json_parser_33;
+                        // ugly, but could be fixed with loop reorganization
+                        if (last_token == lexer::token_type::value_separator)
+                        {
+                            get_token();
+                        }
+
+                        // parse value
+                        auto value = parse_internal(keep);
+                        if (keep and not value.is_discarded())
+                        {
+                            result.push_back(std::move(value));
+                        }
                     }
-                    if (yych <= 'f')
+                    while (last_token == lexer::token_type::value_separator);
+
+                    // closing ]
+                    expect(lexer::token_type::end_array);
+                    get_token();
+                    if (keep and callback and not callback(--depth, parse_event_t::array_end, result))
                     {
-                        goto basic_json_parser_63;
+                        result = basic_json(value_t::discarded);
                     }
-                    goto basic_json_parser_33;
+
+                    return result;
                 }
-basic_json_parser_61:
-                ++m_cursor;
+
+                case lexer::token_type::literal_null:
                 {
-                    return token_type::literal_false;
+                    get_token();
+                    result.m_type = value_t::null;
+                    break;
                 }
-basic_json_parser_63:
-                ++m_cursor;
-                if (m_limit <= m_cursor)
+
+                case lexer::token_type::value_string:
                 {
-                    yyfill();    // LCOV_EXCL_LINE;
+                    const auto s = m_lexer.get_string();
+                    get_token();
+                    result = basic_json(s);
+                    break;
                 }
-                yych = *m_cursor;
-                if (yych <= '@')
+
+                case lexer::token_type::literal_true:
                 {
-                    if (yych <= '/')
-                    {
-                        goto basic_json_parser_33;
-                    }
-                    if (yych <= '9')
-                    {
-                        goto basic_json_parser_31;
-                    }
-                    goto basic_json_parser_33;
+                    get_token();
+                    result.m_type = value_t::boolean;
+                    result.m_value = true;
+                    break;
                 }
-                else
+
+                case lexer::token_type::literal_false:
                 {
-                    if (yych <= 'F')
-                    {
-                        goto basic_json_parser_31;
-                    }
-                    if (yych <= '`')
-                    {
-                        goto basic_json_parser_33;
-                    }
-                    if (yych <= 'f')
-                    {
-                        goto basic_json_parser_31;
-                    }
-                    goto basic_json_parser_33;
+                    get_token();
+                    result.m_type = value_t::boolean;
+                    result.m_value = false;
+                    break;
                 }
-            }
-
-        }
-
-        /// append data from the stream to the internal buffer
-        void yyfill() noexcept
-        {
-            if (m_stream == nullptr or not * m_stream)
-            {
-                return;
-            }
-
-            const auto offset_start = m_start - m_content;
-            const auto offset_marker = m_marker - m_start;
-            const auto offset_cursor = m_cursor - m_start;
-
-            m_buffer.erase(0, static_cast<size_t>(offset_start));
-            std::string line;
-            assert(m_stream != nullptr);
-            std::getline(*m_stream, line);
-            m_buffer += "\n" + line; // add line with newline symbol
-
-            m_content = reinterpret_cast<const lexer_char_t*>(m_buffer.c_str());
-            assert(m_content != nullptr);
-            m_start  = m_content;
-            m_marker = m_start + offset_marker;
-            m_cursor = m_start + offset_cursor;
-            m_limit  = m_start + m_buffer.size() - 1;
-        }
-
-        /// return string representation of last read token
-        string_t get_token() const
-        {
-            assert(m_start != nullptr);
-            return string_t(reinterpret_cast<typename string_t::const_pointer>(m_start),
-                            static_cast<size_t>(m_cursor - m_start));
-        }
-
-        /*!
-        @brief return string value for string tokens
 
-        The function iterates the characters between the opening and closing
-        quotes of the string value. The complete string is the range
-        [m_start,m_cursor). Consequently, we iterate from m_start+1 to
-        m_cursor-1.
+                case lexer::token_type::value_number:
+                {
+                    m_lexer.get_number(result);
+                    get_token();
+                    break;
+                }
 
-        We differentiate two cases:
+                default:
+                {
+                    // the last token was unexpected
+                    unexpect(last_token);
+                }
+            }
 
-        1. Escaped characters. In this case, a new character is constructed
-           according to the nature of the escape. Some escapes create new
-           characters (e.g., `"\\n"` is replaced by `"\n"`), some are copied
-           as is (e.g., `"\\\\"`). Furthermore, Unicode escapes of the shape
-           `"\\uxxxx"` need special care. In this case, to_unicode takes care
-           of the construction of the values.
-        2. Unescaped characters are copied as is.
+            if (keep and callback and not callback(depth, parse_event_t::value, result))
+            {
+                result = basic_json(value_t::discarded);
+            }
+            return result;
+        }
 
-        @return string value of current token without opening and closing
-        quotes
-        @throw std::out_of_range if to_unicode fails
-        */
-        string_t get_string() const
+        /// the actual parser, reusing the storage of @a result
+        void parse_internal(basic_json& result)
         {
-            string_t result;
-            result.reserve(static_cast<size_t>(m_cursor - m_start - 2));
-
-            // iterate the result between the quotes
-            for (const lexer_char_t* i = m_start + 1; i < m_cursor - 1; ++i)
+            switch (last_token)
             {
-                // process escaped characters
-                if (*i == '\\')
+                case lexer::token_type::begin_object:
                 {
-                    // read next character
-                    ++i;
+                    if (not result.is_object())
+                    {
+                        result = basic_json(value_t::object);
+                    }
+                    object_t& object = *result.m_value.object;
 
-                    switch (*i)
+                    // the keys seen so far in this object, as spans of
+                    // m_seen_keys; the spans from seen_begin on belong to
+                    // this call. Keys rather than addresses are kept, as
+                    // inserting may move the members of some object types.
+                    const auto seen_begin = m_seen.size();
+
+                    // read next token
+                    get_token();
+
+                    if (last_token != lexer::token_type::end_object)
                     {
-                        // the default escapes
-                        case 't':
-                        {
-                            result += "\t";
-                            break;
-                        }
-                        case 'b':
-                        {
-                            result += "\b";
-                            break;
-                        }
-                        case 'f':
-                        {
-                            result += "\f";
-                            break;
-                        }
-                        case 'n':
-                        {
-                            result += "\n";
-                            break;
-                        }
-                        case 'r':
-                        {
-                            result += "\r";
-                            break;
-                        }
-                        case '\\':
-                        {
-                            result += "\\";
-                            break;
-                        }
-                        case '/':
-                        {
-                            result += "/";
-                            break;
-                        }
-                        case '"':
-                        {
-                            result += "\"";
-                            break;
-                        }
+                        // no comma is expected here
+                        unexpect(lexer::token_type::value_separator);
 
-                        // unicode
-                        case 'u':
+                        // parse key-value pairs
+                        do
                         {
-                            // get code xxxx from uxxxx
-                            auto codepoint = std::strtoul(std::string(reinterpret_cast<typename string_t::const_pointer>(i + 1),
-                                                          4).c_str(), nullptr, 16);
+                            // ugly, but could be fixed with loop reorganization
+                            if (last_token == lexer::token_type::value_separator)
+                            {
+                                get_token();
+                            }
 
-                            // check if codepoint is a high surrogate
-                            if (codepoint >= 0xD800 and codepoint <= 0xDBFF)
+                            // look up the key without allocating
+                            expect(lexer::token_type::value_string);
+                            m_key.clear();
+                            m_lexer.get_string(m_key);
+                            auto it = object.find(m_key);
+                            if (it == object.end())
                             {
-                                // make sure there is a subsequent unicode
-                                if ((i + 6 >= m_limit) or * (i + 5) != '\\' or * (i + 6) != 'u')
-                                {
-                                    throw std::invalid_argument("missing low surrogate");
-                                }
+                                it = object.emplace(m_key, basic_json()).first;
+                            }
+                            m_seen.emplace_back(m_seen_keys.size(), m_key.size());
+                            m_seen_keys += m_key;
 
-                                // get code yyyy from uxxxx\uyyyy
-                                auto codepoint2 = std::strtoul(std::string(reinterpret_cast<typename string_t::const_pointer>
-                                                               (i + 7), 4).c_str(), nullptr, 16);
-                                result += to_unicode(codepoint, codepoint2);
-                                // skip the next 10 characters (xxxx\uyyyy)
-                                i += 10;
+                            // parse separator (:)
+                            get_token();
+                            expect(lexer::token_type::name_separator);
+
+                            // parse value in place
+                            get_token();
+                            parse_internal(it->second);
+                        }
+                        while (last_token == lexer::token_type::value_separator);
+
+                        // closing }
+                        expect(lexer::token_type::end_object);
+                    }
+                    get_token();
+
+                    // remove members that were not in the input; usually
+                    // every member was seen exactly once and there is
+                    // nothing to do
+                    const auto seen_first = m_seen.begin() + static_cast<std::ptrdiff_t>(seen_begin);
+                    const auto key_less = [this](const key_span & a, const key_span & b)
+                    {
+                        return m_seen_keys.compare(a.first, a.second, m_seen_keys, b.first, b.second) < 0;
+                    };
+                    std::sort(seen_first, m_seen.end(), key_less);
+                    const auto key_equal = [&key_less](const key_span & a, const key_span & b)
+                    {
+                        return not key_less(a, b) and not key_less(b, a);
+                    };
+                    if (static_cast<size_t>(m_seen.end() - seen_first) != object.size() or
+                            std::adjacent_find(seen_first, m_seen.end(), key_equal) != m_seen.end())
+                    {
+                        for (auto it = object.begin(); it != object.end();)
+                        {
+                            // look the member's key up among the seen keys
+                            const auto found = std::lower_bound(seen_first, m_seen.end(), it->first,
+                                                                [this](const key_span & a, const string_t& k)
+                            {
+                                return m_seen_keys.compare(a.first, a.second, k) < 0;
+                            });
+                            if (found != m_seen.end() and
+                                    m_seen_keys.compare(found->first, found->second, it->first) == 0)
+                            {
+                                ++it;
                             }
                             else
                             {
-                                // add unicode character(s)
-                                result += to_unicode(codepoint);
-                                // skip the next four characters (xxxx)
-                                i += 4;
+                                it = object.erase(it);
                             }
-                            break;
                         }
                     }
+                    m_seen.resize(seen_begin);
+                    if (seen_begin == 0)
+                    {
+                        m_seen_keys.clear();
+                    }
+                    return;
                 }
-                else
-                {
-                    // all other characters are just copied to the end of the
-                    // string
-                    result.append(1, static_cast<typename string_t::value_type>(*i));
-                }
-            }
 
-            return result;
-        }
-
-        /*!
-        @brief parse floating point number
+                case lexer::token_type::begin_array:
+                {
+                    if (not result.is_array())
+                    {
+                        result = basic_json(value_t::array);
+                    }
+                    array_t& array = *result.m_value.array;
+                    size_t size = 0;
 
-        This function (and its overloads) serves to select the most approprate
-        standard floating point number parsing function based on the type
-        supplied via the first parameter.  Set this to @a
-        static_cast<number_float_t*>(nullptr).
+                    // read next token
+                    get_token();
 
-        @param[in] type  the @ref number_float_t in use
+                    if (last_token != lexer::token_type::end_array)
+                    {
+                        // no comma is expected here
+                        unexpect(lexer::token_type::value_separator);
 
-        @param[in,out] endptr recieves a pointer to the first character after
-        the number
+                        // parse values
+                        do
+                        {
+                            // ugly, but could be fixed with loop reorganization
+                            if (last_token == lexer::token_type::value_separator)
+                            {
+                                get_token();
+                            }
 
-        @return the floating point number
+                            // overwrite old elements before adding new ones
+                            if (size == array.size())
+                            {
+                                array.emplace_back();
+                            }
+                            parse_internal(array[size++]);
+                        }
+                        while (last_token == lexer::token_type::value_separator);
 
-        @bug This function uses `std::strtof`, `std::strtod`, or `std::strtold`
-        which use the current C locale to determine which character is used as
-        decimal point character. This may yield to parse errors if the locale
-        does not used `.`.
-        */
-        long double str_to_float_t(long double* /* type */, char** endptr) const
-        {
-            return std::strtold(reinterpret_cast<typename string_t::const_pointer>(m_start), endptr);
-        }
+                        // closing ]
+                        expect(lexer::token_type::end_array);
+                    }
+                    get_token();
 
-        /*!
-        @brief parse floating point number
+                    array.erase(array.begin() + static_cast<std::ptrdiff_t>(size), array.end());
+                    return;
+                }
 
-        This function (and its overloads) serves to select the most approprate
-        standard floating point number parsing function based on the type
-        supplied via the first parameter.  Set this to @a
-        static_cast<number_float_t*>(nullptr).
+                case lexer::token_type::value_string:
+                {
+                    if (result.is_string())
+                    {
+                        result.m_value.string->clear();
+                    }
+                    else
+                    {
+                        result = basic_json(value_t::string);
+                    }
+                    m_lexer.get_string(*result.m_value.string);
+                    get_token();
+                    return;
+                }
 
-        @param[in] type  the @ref number_float_t in use
+                case lexer::token_type::literal_null:
+                case lexer::token_type::literal_true:
+                case lexer::token_type::literal_false:
+                case lexer::token_type::value_number:
+                {
+                    // no storage to reuse
+                    result = parse_internal(true);
+                    return;
+                }
 
-        @param[in,out] endptr  recieves a pointer to the first character after
-        the number
+                default:
+                {
+                    // the last token was unexpected
+                    unexpect(last_token);
+                }
+            }
+        }
 
-        @return the floating point number
-        */
-        double str_to_float_t(double* /* type */, char** endptr) const
+        /// get next token from lexer
+        typename lexer::token_type get_token() noexcept
         {
-            return std::strtod(reinterpret_cast<typename string_t::const_pointer>(m_start), endptr);
+            last_token = m_lexer.scan();
+            return last_token;
         }
 
-        /*!
-        @brief parse floating point number
-
-        This function (and its overloads) serves to select the most approprate
-        standard floating point number parsing function based on the type
-        supplied via the first parameter.  Set this to @a
-        static_cast<number_float_t*>(nullptr).
-
-        @param[in] type  the @ref number_float_t in use
-
-        @param[in,out] endptr  recieves a pointer to the first character after
-        the number
-
-        @return the floating point number
-        */
-        float str_to_float_t(float* /* type */, char** endptr) const
+        void expect(typename lexer::token_type t) const
         {
-            return std::strtof(reinterpret_cast<typename string_t::const_pointer>(m_start), endptr);
+            if (t != last_token)
+            {
+                std::string error_msg = "parse error - unexpected ";
+                error_msg += (last_token == lexer::token_type::parse_error ? ("'" +  m_lexer.get_token() + "'") :
+                              lexer::token_type_name(last_token));
+                error_msg += "; expected " + lexer::token_type_name(t);
+                throw std::invalid_argument(error_msg);
+            }
         }
 
-        /*!
-        @brief return number value for number tokens
-
-        This function translates the last token into the most appropriate
-        number type (either integer, unsigned integer or floating point),
-        which is passed back to the caller via the result parameter.
-
-        This function parses the integer component up to the radix point or
-        exponent while collecting information about the 'floating point
-        representation', which it stores in the result parameter. If there is
-        no radix point or exponent, and the number can fit into a @ref
-        number_integer_t or @ref number_unsigned_t then it sets the result
-        parameter accordingly.
-
-        If the number is a floating point number the number is then parsed
-        using @a std:strtod (or @a std:strtof or @a std::strtold).
-
-        @param[out] result  @ref basic_json object to receive the number, or
-        NAN if the conversion read past the current token. The latter case
-        needs to be treated by the caller function.
-        */
-        void get_number(basic_json& result) const
+        void unexpect(typename lexer::token_type t) const
         {
-            assert(m_start != nullptr);
-
-            const lexer::lexer_char_t* curptr = m_start;
+            if (t == last_token)
+            {
+                std::string error_msg = "parse error - unexpected ";
+                error_msg += (last_token == lexer::token_type::parse_error ? ("'" +  m_lexer.get_token() + "'") :
+                              lexer::token_type_name(last_token));
+                throw std::invalid_argument(error_msg);
+            }
+        }
 
-            // accumulate the integer conversion result (unsigned for now)
-            number_unsigned_t value = 0;
+      private:
+        /// current level of recursion
+        int depth = 0;
+        /// callback function
+        parser_callback_t callback;
+        /// the type of the last read token
+        typename lexer::token_type last_token = lexer::token_type::uninitialized;
+        /// the lexer
+        lexer m_lexer;
+        /// buffer for object keys when parsing in place
+        string_t m_key;
+        /// position and length of a key in m_seen_keys
+        using key_span = std::pair<std::size_t, std::size_t>;
+        /// object members seen when parsing in place, by key
+        std::vector<key_span> m_seen;
+        /// the keys of m_seen, one after the other
+        string_t m_seen_keys;
+    };
 
-            // maximum absolute value of the relevant integer type
-            number_unsigned_t max;
+  public:
+    /*!
+    @brief reusable deserializer
 
-            // temporarily store the type to avoid unecessary bitfield access
-            value_t type;
+    Parses one JSON text after another into the same basic_json value. For a
+    stream of records that share a shape, such as one JSON object per line,
+    this allocates far less than assigning the result of @ref parse each
+    time: the value's object members, array elements and string capacity
+    are reused, as are the parser's own buffers.
 
-            // look for sign
-            if (*curptr == '-')
-            {
-                type = value_t::number_integer;
-                max = static_cast<uint64_t>((std::numeric_limits<number_integer_t>::max)()) + 1;
-                curptr++;
-            }
-            else
-            {
-                type = value_t::number_unsigned;
-                max = static_cast<uint64_t>((std::numeric_limits<number_unsigned_t>::max)());
-            }
+    @code
+    json::reusable_parser p;
+    json j;
+    p.parse("{\"a\": \"x\", \"b\": [1, 2]}", j);
+    p.parse("{\"a\": \"y\", \"b\": [3]}", j);  // reuses j's nodes
+    @endcode
+    */
+    class reusable_parser
+    {
+      public:
+        /*!
+        @brief deserialize from string into an existing value
 
-            // count the significant figures
-            for (; curptr < m_cursor; curptr++)
-            {
-                // quickly skip tests if a digit
-                if (*curptr < '0' || *curptr > '9')
-                {
-                    if (*curptr == '.')
-                    {
-                        // don't count '.' but change to float
-                        type = value_t::number_float;
-                        continue;
-                    }
-                    // assume exponent (if not then will fail parse): change to
-                    // float, stop counting and record exponent details
-                    type = value_t::number_float;
-                    break;
-                }
+        @param[in] s  string to read a serialized JSON value from
+        @param[in,out] result  value to overwrite with the parse result
 
-                // skip if definitely not an integer
-                if (type != value_t::number_float)
-                {
-                    // multiply last value by ten and add the new digit
-                    auto temp = value * 10 + *curptr - 0x30;
+        @throw std::invalid_argument in case of parse errors; @a result then
+        holds some valid but unspecified value
+        */
+        void parse(const string_t& s, basic_json& result)
+        {
+            m_parser.reset(s);
+            m_parser.parse(result);
+        }
 
-                    // test for overflow
-                    if (temp < value || temp > max)
-                    {
-                        // overflow
-                        type = value_t::number_float;
-                    }
-                    else
-                    {
-                        // no overflow - save it
-                        value = temp;
-                    }
-                }
-            }
+        /*!
+        @brief deserialize from a range of characters into an existing value
+        @sa basic_json::parse(const char*, const char*, parser_callback_t)
 
-            // save the value (if not a float)
-            if (type == value_t::number_unsigned)
-            {
-                result.m_value.number_unsigned = value;
-            }
-            else if (type == value_t::number_integer)
-            {
-                result.m_value.number_integer = -static_cast<number_integer_t>(value);
-            }
-            else
-            {
-                // parse with strtod
-                result.m_value.number_float = str_to_float_t(static_cast<number_float_t*>(nullptr), NULL);
-            }
+        @param[in] first  pointer to the first character to read
+        @param[in] last  pointer past the last character to read
+        @param[in,out] result  value to overwrite with the parse result
 
-            // save the type
-            result.m_type = type;
+        @throw std::invalid_argument in case of parse errors; @a result then
+        holds some valid but unspecified value
+        */
+        void parse(const char* first, const char* last, basic_json& result)
+        {
+            m_parser.reset(first, last);
+            m_parser.parse(result);
         }
 
       private:
-        /// optional input stream
-        std::istream* m_stream = nullptr;
-        /// the buffer
-        string_t m_buffer;
-        /// the buffer pointer
-        const lexer_char_t* m_content = nullptr;
-        /// pointer to the beginning of the current symbol
-        const lexer_char_t* m_start = nullptr;
-        /// pointer for backtracking information
-        const lexer_char_t* m_marker = nullptr;
-        /// pointer to the current symbol
-        const lexer_char_t* m_cursor = nullptr;
-        /// pointer to the end of the buffer
-        const lexer_char_t* m_limit = nullptr;
+        /// the parser, kept for its buffers
+        parser m_parser;
     };
 
     /*!
-    @brief syntax analysis
+    @brief event-driven syntax analysis
 
-    This class implements a recursive decent parser.
+    This class implements a recursive decent parser which reports what it
+    reads to a SAX handler instead of building a basic_json value.
+
+    @tparam Handler  the SAX handler, see @ref sax_parse
     */
-    class parser
+    template<typename Handler>
+    class sax_parser
     {
       public:
         /// constructor for strings
-        parser(const string_t& s, parser_callback_t cb = nullptr) noexcept
-            : callback(cb), m_lexer(s)
+        sax_parser(const string_t& s, Handler& h)
+            : m_handler(h), m_lexer(s)
         {
             // read first token
             get_token();
         }
 
         /// a parser reading from an input stream
-        parser(std::istream& _is, parser_callback_t cb = nullptr) noexcept
-            : callback(cb), m_lexer(&_is)
+        sax_parser(std::istream& _is, Handler& h)
+            : m_handler(h), m_lexer(&_is)
         {
             // read first token
             get_token();
         }
 
-        /// public parser interface
-        basic_json parse()
+        /// a parser reading from a range of characters
+        sax_parser(const char* first, const char* last, Handler& h)
+            : m_handler(h), m_lexer(first, last)
         {
-            basic_json result = parse_internal(true);
-
-            expect(lexer::token_type::end_of_input);
+            // read first token
+            get_token();
+        }
 
-            // return parser result and replace it with null in case the
-            // top-level value was discarded by the callback function
-            return result.is_discarded() ? basic_json() : result;
+        /// public parser interface
+        bool parse()
+        {
+            try
+            {
+                if (not parse_internal())
+                {
+                    return false;
+                }
+                return last_token == lexer::token_type::end_of_input or error();
+            }
+            catch (const std::exception&)
+            {
+                // invalid \u escapes
+                return error();
+            }
         }
 
       private:
         /// the actual parser
-        basic_json parse_internal(bool keep)
+        bool parse_internal()
         {
-            auto result = basic_json(value_t::discarded);
-
             switch (last_token)
             {
                 case lexer::token_type::begin_object:
                 {
-                    if (keep and (not callback or (keep = callback(depth++, parse_event_t::object_start, result))))
+                    if (not m_handler.start_object())
                     {
-                        // explicitly set result to object to cope with {}
-                        result.m_type = value_t::object;
-                        result.m_value = json_value(value_t::object);
+                        return false;
                     }
 
                     // read next token
@@ -8507,75 +10524,56 @@ basic_json_parser_63:
                     if (last_token == lexer::token_type::end_object)
                     {
                         get_token();
-                        if (keep and callback and not callback(--depth, parse_event_t::object_end, result))
-                        {
-                            result = basic_json(value_t::discarded);
-                        }
-                        return result;
+                        return m_handler.end_object();
                     }
 
-                    // no comma is expected here
-                    unexpect(lexer::token_type::value_separator);
-
-                    // otherwise: parse key-value pairs
-                    do
+                    // parse key-value pairs
+                    while (true)
                     {
-                        // ugly, but could be fixed with loop reorganization
-                        if (last_token == lexer::token_type::value_separator)
+                        // key
+                        if (last_token != lexer::token_type::value_string)
                         {
-                            get_token();
+                            return error();
                         }
-
-                        // store key
-                        expect(lexer::token_type::value_string);
-                        const auto key = m_lexer.get_string();
-
-                        bool keep_tag = false;
-                        if (keep)
+                        if (not m_handler.key(m_lexer.get_string_ref(m_scratch)))
                         {
-                            if (callback)
-                            {
-                                basic_json k(key);
-                                keep_tag = callback(depth, parse_event_t::key, k);
-                            }
-                            else
-                            {
-                                keep_tag = true;
-                            }
+                            return false;
                         }
 
                         // parse separator (:)
                         get_token();
-                        expect(lexer::token_type::name_separator);
+                        if (last_token != lexer::token_type::name_separator)
+                        {
+                            return error();
+                        }
 
-                        // parse and add value
+                        // parse value
                         get_token();
-                        auto value = parse_internal(keep);
-                        if (keep and keep_tag and not value.is_discarded())
+                        if (not parse_internal())
                         {
-                            result[key] = std::move(value);
+                            return false;
                         }
-                    }
-                    while (last_token == lexer::token_type::value_separator);
 
-                    // closing }
-                    expect(lexer::token_type::end_object);
-                    get_token();
-                    if (keep and callback and not callback(--depth, parse_event_t::object_end, result))
-                    {
-                        result = basic_json(value_t::discarded);
+                        // comma -> next key-value pair; closing } -> done
+                        if (last_token == lexer::token_type::value_separator)
+                        {
+                            get_token();
+                            continue;
+                        }
+                        if (last_token != lexer::token_type::end_object)
+                        {
+                            return error();
+                        }
+                        get_token();
+                        return m_handler.end_object();
                     }
-
-                    return result;
                 }
 
                 case lexer::token_type::begin_array:
                 {
-                    if (keep and (not callback or (keep = callback(depth++, parse_event_t::array_start, result))))
+                    if (not m_handler.start_array())
                     {
-                        // explicitly set result to object to cope with []
-                        result.m_type = value_t::array;
-                        result.m_value = json_value(value_t::array);
+                        return false;
                     }
 
                     // read next token
@@ -8585,95 +10583,106 @@ basic_json_parser_63:
                     if (last_token == lexer::token_type::end_array)
                     {
                         get_token();
-                        if (callback and not callback(--depth, parse_event_t::array_end, result))
-                        {
-                            result = basic_json(value_t::discarded);
-                        }
-                        return result;
+                        return m_handler.end_array();
                     }
 
-                    // no comma is expected here
-                    unexpect(lexer::token_type::value_separator);
-
-                    // otherwise: parse values
-                    do
+                    // parse values
+                    while (true)
                     {
-                        // ugly, but could be fixed with loop reorganization
+                        if (not parse_internal())
+                        {
+                            return false;
+                        }
+
+                        // comma -> next value; closing ] -> done
                         if (last_token == lexer::token_type::value_separator)
                         {
                             get_token();
+                            continue;
                         }
-
-                        // parse value
-                        auto value = parse_internal(keep);
-                        if (keep and not value.is_discarded())
+                        if (last_token != lexer::token_type::end_array)
                         {
-                            result.push_back(std::move(value));
+                            return error();
                         }
+                        get_token();
+                        return m_handler.end_array();
                     }
-                    while (last_token == lexer::token_type::value_separator);
-
-                    // closing ]
-                    expect(lexer::token_type::end_array);
-                    get_token();
-                    if (keep and callback and not callback(--depth, parse_event_t::array_end, result))
-                    {
-                        result = basic_json(value_t::discarded);
-                    }
-
-                    return result;
                 }
 
                 case lexer::token_type::literal_null:
                 {
                     get_token();
-                    result.m_type = value_t::null;
-                    break;
+                    return m_handler.null();
                 }
 
                 case lexer::token_type::value_string:
                 {
-                    const auto s = m_lexer.get_string();
+                    // the view may point into the lexer buffer, so report it
+                    // before reading on
+                    if (not m_handler.string(m_lexer.get_string_ref(m_scratch)))
+                    {
+                        return false;
+                    }
                     get_token();
-                    result = basic_json(s);
-                    break;
+                    return true;
                 }
 
                 case lexer::token_type::literal_true:
                 {
                     get_token();
-                    result.m_type = value_t::boolean;
-                    result.m_value = true;
-                    break;
+                    return m_handler.boolean(true);
                 }
 
                 case lexer::token_type::literal_false:
                 {
                     get_token();
-                    result.m_type = value_t::boolean;
-                    result.m_value = false;
-                    break;
+                    return m_handler.boolean(false);
                 }
 
                 case lexer::token_type::value_number:
                 {
-                    m_lexer.get_number(result);
+                    // numbers are stored in place; no allocation
+                    basic_json number;
+                    m_lexer.get_number(number);
+                    bool keep_going;
+                    switch (number.m_type)
+                    {
+                        case value_t::number_integer:
+                        {
+                            keep_going = m_handler.number_integer(number.m_value.number_integer);
+                            break;
+                        }
+                        case value_t::number_unsigned:
+                        {
+                            keep_going = m_handler.number_unsigned(number.m_value.number_unsigned);
+                            break;
+                        }
+                        default:
+                        {
+                            // NAN signals a number the lexer could not read
+                            if (not std::isfinite(number.m_value.number_float))
+                            {
+                                return error();
+                            }
+                            keep_going = m_handler.number_float(number.m_value.number_float,
+                                                                m_lexer.get_token_ref());
+                            break;
+                        }
+                    }
+                    if (not keep_going)
+                    {
+                        return false;
+                    }
                     get_token();
-                    break;
+                    return true;
                 }
 
                 default:
                 {
                     // the last token was unexpected
-                    unexpect(last_token);
+                    return error();
                 }
             }
-
-            if (keep and callback and not callback(depth, parse_event_t::value, result))
-            {
-                result = basic_json(value_t::discarded);
-            }
-            return result;
         }
 
         /// get next token from lexer
@@ -8683,34 +10692,18 @@ basic_json_parser_63:
             return last_token;
         }
 
-        void expect(typename lexer::token_type t) const
-        {
-            if (t != last_token)
-            {
-                std::string error_msg = "parse error - unexpected ";
-                error_msg += (last_token == lexer::token_type::parse_error ? ("'" +  m_lexer.get_token() + "'") :
-                              lexer::token_type_name(last_token));
-                error_msg += "; expected " + lexer::token_type_name(t);
-                throw std::invalid_argument(error_msg);
-            }
-        }
-
-        void unexpect(typename lexer::token_type t) const
+        /// report a syntax error at the last read token
+        bool error()
         {
-            if (t == last_token)
-            {
-                std::string error_msg = "parse error - unexpected ";
-                error_msg += (last_token == lexer::token_type::parse_error ? ("'" +  m_lexer.get_token() + "'") :
-                              lexer::token_type_name(last_token));
-                throw std::invalid_argument(error_msg);
-            }
+            m_handler.parse_error(m_lexer.get_position(), m_lexer.get_token_ref());
+            return false;
         }
 
       private:
-        /// current level of recursion
-        int depth = 0;
-        /// callback function
-        parser_callback_t callback;
+        /// the SAX handler
+        Handler& m_handler;
+        /// buffer for unescaped strings
+        string_t m_scratch;
         /// the type of the last read token
         typename lexer::token_type last_token = lexer::token_type::uninitialized;
         /// the lexer
@@ -9958,6 +11951,16 @@ uses the standard template types.
 @since version 1.0.0
 */
 using json = basic_json<>;
+
+/*!
+@brief JSON class with flat object storage
+
+Like @ref json, but objects are stored in a @ref flat_map: one vector of
+pairs per object (in insertion order) instead of one tree node per member.
+This makes small objects, such as typical records, cheaper to build, copy
+and search.
+*/
+using flat_json = basic_json<flat_map>;
 }
 
 
@@ -10033,4 +12036,6 @@ inline nlohmann::json::json_pointer operator "" _json_pointer(const char* s, std
     #pragma GCC diagnostic pop
 #endif
 
+#undef NLOHMANN_JSON_X86_SIMD
+
 #endif
@@ -0,0 +1,662 @@
+/**
+    Insight Data Engineering Code Challenge
+    binary_record.hpp
+
+    Purpose:
+
+    BinaryRecordReader is the MessagePack and CBOR counterpart of
+    VenmoRecordReader (src/victor/venmo_record.hpp). Upstream may publish
+    the transaction stream as a sequence of binary maps, a MessagePack
+    stream or a CBOR sequence (RFC 8742), instead of lines of JSON. Every
+    item in either encoding carries its own length, so records are framed
+    by the encoding itself: the reader decodes one map and says where the
+    next record starts. There are no separators and no newline scanning.
+
+    As with JSON, only the three fields the graph needs are decoded. The
+    values of all other keys are skipped by their lengths without being
+    looked at, keys are compared in place, and the wanted strings are copied
+    into strings whose capacity is reused from record to record.
+
+    created_time may be an ISO 8601 string as in the JSON records, an
+    integer number of seconds since the epoch, a MessagePack timestamp
+    (extension type -1), or a CBOR date/time string (tag 0) or epoch time
+    (tag 1).
+
+    @author Victor Chen
+*/
+#ifndef BINARY_RECORD_HPP_
+#define BINARY_RECORD_HPP_
+
+#include "victor/venmo_record.hpp"
+#include "json/json.hpp"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace victor {
+
+/**
+	Binary Record Reader
+*/
+class BinaryRecordReader {
+public:
+	enum Format {
+		msgpack,
+		cbor
+	};
+
+	typedef VenmoRecordReader::Status Status;
+
+	/**
+		How a read() ended.
+	*/
+	enum Framing {
+		framed,			// a whole record was decoded
+		need_more,		// the input ends inside the record
+		corrupt			// not a valid encoding; the stream can't be resynced
+	};
+
+private:
+	typedef nlohmann::string_ref string_ref;
+
+	static int const max_depth = 64;
+	// longer strings, and longer arrays and maps, are taken as corruption
+	// rather than waited for
+	static uint64_t const max_length = uint64_t(1) << 26;
+
+	/**
+		Which top-level field a value belongs to.
+	*/
+	enum Field {
+		no_field = -1,
+		actor_field,
+		target_field,
+		created_time_field,
+		num_fields
+	};
+
+	/**
+		Header of one encoded item. Strings, byte strings and extensions
+		include their payload; containers and tags are followed by their
+		contents.
+	*/
+	struct Item {
+		enum Kind {
+			unsigned_int,	// value
+			negative_int,	// -1 - value
+			text,			// value bytes at data
+			bytes,			// value bytes at data
+			array,			// value items
+			map,			// value pairs
+			tag,			// CBOR tag number value, then one item
+			ext,			// MessagePack extension ext_type, value bytes at data
+			float32,		// bits at data
+			float64,		// bits at data
+			simple,			// nil, booleans, half floats and the like
+			stop			// CBOR "break"
+		};
+		Kind kind;
+		uint64_t value;
+		char const* data;
+		int ext_type;
+		bool indefinite;	// CBOR indefinite-length string, array or map
+	};
+
+	/**
+		Position in the input, and what went wrong, if anything.
+	*/
+	struct Cursor {
+		char const* p;
+		char const* last;
+		Framing failure;	// framed while nothing went wrong
+	};
+
+	Format _format;
+	std::string _time_str;	// created_time as a string, reused
+	std::string _key;		// a key split into chunks, reused
+	bool _time_empty = false;	// whether created_time was an empty string
+
+	static uint64_t big_endian(char const* p, int n) {
+		uint64_t v = 0;
+		for (int i = 0; i < n; ++i) {
+			v = (v << 8) | static_cast<unsigned char>(p[i]);
+		}
+		return v;
+	}
+
+	static bool fail(Cursor& c, Framing failure) {
+		c.failure = failure;
+		return false;
+	}
+
+	/**
+		Take n bytes from the input.
+
+		@param c cursor, advanced past the bytes.
+		@param n number of bytes.
+		@param bytes set to the first byte.
+		@return false if the input ends first.
+	*/
+	static bool take(Cursor& c, uint64_t n, char const*& bytes) {
+		if (n > max_length) {
+			return fail(c, corrupt);
+		}
+		if (uint64_t(c.last - c.p) < n) {
+			return fail(c, need_more);
+		}
+		bytes = c.p;
+		c.p += n;
+		return true;
+	}
+
+	/**
+		Read the header of a MessagePack item.
+	*/
+	static bool msgpack_item(Cursor& c, Item& it) {
+		char const* b;
+		if (!take(c, 1, b)) {
+			return false;
+		}
+		unsigned const t = static_cast<unsigned char>(*b);
+		it.indefinite = false;
+		it.value = 0;
+		it.data = nullptr;
+		if (t <= 0x7f) {
+			it.kind = Item::unsigned_int;
+			it.value = t;
+			return true;
+		}
+		if (t >= 0xe0) {
+			it.kind = Item::negative_int;
+			it.value = 0xff - t;
+			return true;
+		}
+		if (t <= 0x8f) {
+			it.kind = Item::map;
+			it.value = t & 0x0f;
+			return true;
+		}
+		if (t <= 0x9f) {
+			it.kind = Item::array;
+			it.value = t & 0x0f;
+			return true;
+		}
+		if (t <= 0xbf) {
+			it.kind = Item::text;
+			it.value = t & 0x1f;
+			return take(c, it.value, it.data);
+		}
+		switch (t) {
+		case 0xc0: case 0xc2: case 0xc3:
+			it.kind = Item::simple;
+			return true;
+		case 0xdc: case 0xdd:
+			it.kind = Item::array;
+			return count(c, t == 0xdc ? 2 : 4, it.value);
+		case 0xde: case 0xdf:
+			it.kind = Item::map;
+			return count(c, t == 0xde ? 2 : 4, it.value);
+		case 0xc4: case 0xc5: case 0xc6:
+			it.kind = Item::bytes;
+			return count(c, 1 << (t - 0xc4), it.value) &&
+				take(c, it.value, it.data);
+		case 0xd9: case 0xda: case 0xdb:
+			it.kind = Item::text;
+			return count(c, 1 << (t - 0xd9), it.value) &&
+				take(c, it.value, it.data);
+		case 0xc7: case 0xc8: case 0xc9:
+			it.kind = Item::ext;
+			return count(c, 1 << (t - 0xc7), it.value) &&
+				ext_payload(c, it);
+		case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+			it.kind = Item::ext;
+			it.value = uint64_t(1) << (t - 0xd4);
+			return ext_payload(c, it);
+		case 0xca: case 0xcb:
+			it.kind = t == 0xca ? Item::float32 : Item::float64;
+			return take(c, t == 0xca ? 4 : 8, it.data);
+		case 0xcc: case 0xcd: case 0xce: case 0xcf:
+			it.kind = Item::unsigned_int;
+			return count(c, 1 << (t - 0xcc), it.value, false);
+		case 0xd0: case 0xd1: case 0xd2: case 0xd3: {
+			int const n = 1 << (t - 0xd0);
+			if (!take(c, uint64_t(n), b)) {
+				return false;
+			}
+			// sign-extend
+			uint64_t v = big_endian(b, n);
+			if (n < 8 && (v >> (8 * n - 1)) != 0) {
+				v |= ~uint64_t(0) << (8 * n);
+			}
+			if ((v >> 63) != 0) {
+				it.kind = Item::negative_int;
+				it.value = ~v;
+			} else {
+				it.kind = Item::unsigned_int;
+				it.value = v;
+			}
+			return true;
+		}
+		default:	// 0xc1 is never used
+			return fail(c, corrupt);
+		}
+	}
+
+	/**
+		Read a big-endian length or integer of n bytes.
+
+		@param limited whether the value is a length (see max_length).
+	*/
+	static bool count(Cursor& c, int n, uint64_t& value, bool limited = true) {
+		char const* b;
+		if (!take(c, uint64_t(n), b)) {
+			return false;
+		}
+		value = big_endian(b, n);
+		return !limited || value <= max_length || fail(c, corrupt);
+	}
+
+	/**
+		Read the type and data of a MessagePack extension of it.value bytes.
+	*/
+	static bool ext_payload(Cursor& c, Item& it) {
+		char const* b;
+		if (!take(c, 1, b)) {
+			return false;
+		}
+		it.ext_type = static_cast<signed char>(*b);
+		return take(c, it.value, it.data);
+	}
+
+	/**
+		Read the header of a CBOR item.
+	*/
+	static bool cbor_item(Cursor& c, Item& it) {
+		char const* b;
+		if (!take(c, 1, b)) {
+			return false;
+		}
+		unsigned const major = static_cast<unsigned char>(*b) >> 5;
+		unsigned const info = static_cast<unsigned char>(*b) & 0x1f;
+		it.indefinite = false;
+		it.value = 0;
+		it.data = nullptr;
+		if (major == 7) {
+			switch (info) {
+			case 25:
+				it.kind = Item::simple;	// half float
+				return take(c, 2, b);
+			case 26:
+			case 27:
+				it.kind = info == 26 ? Item::float32 : Item::float64;
+				return take(c, info == 26 ? 4 : 8, it.data);
+			case 24:
+				it.kind = Item::simple;
+				return take(c, 1, b);
+			case 31:
+				it.kind = Item::stop;
+				return true;
+			default:
+				it.kind = Item::simple;
+				return info < 24 || fail(c, corrupt);
+			}
+		}
+		static Item::Kind const kinds[] = {
+			Item::unsigned_int, Item::negative_int, Item::bytes, Item::text,
+			Item::array, Item::map, Item::tag
+		};
+		it.kind = kinds[major];
+		if (info < 24) {
+			it.value = info;
+		} else if (info < 28) {
+			if (!count(c, 1 << (info - 24), it.value, false)) {
+				return false;
+			}
+		} else if (info == 31 && 2 <= major && major <= 5) {
+			it.indefinite = true;
+			return true;
+		} else {
+			return fail(c, corrupt);
+		}
+		if (it.kind == Item::bytes || it.kind == Item::text) {
+			return take(c, it.value, it.data);
+		}
+		if ((it.kind == Item::array || it.kind == Item::map) &&
+			it.value > max_length) {
+			return fail(c, corrupt);
+		}
+		return true;
+	}
+
+	bool item(Cursor& c, Item& it) const {
+		return _format == msgpack ? msgpack_item(c, it) : cbor_item(c, it);
+	}
+
+	/**
+		Skip the contents of an item whose header has been read.
+
+		@param depth nesting level of the item.
+	*/
+	bool skip(Cursor& c, Item const& it, int depth) const {
+		if (depth > max_depth) {
+			return fail(c, corrupt);
+		}
+		Item sub;
+		switch (it.kind) {
+		case Item::text:
+		case Item::bytes:
+			if (!it.indefinite) {
+				return true;
+			}
+			// definite chunks of the same kind, then a break
+			while (item(c, sub) && sub.kind != Item::stop) {
+				if (sub.kind != it.kind || sub.indefinite) {
+					return fail(c, corrupt);
+				}
+			}
+			return c.failure == framed;
+		case Item::array:
+		case Item::map: {
+			uint64_t const n = it.kind == Item::map ? 2 * it.value : it.value;
+			for (uint64_t i = 0; it.indefinite || i < n; ++i) {
+				if (!item(c, sub)) {
+					return false;
+				}
+				if (sub.kind == Item::stop) {
+					// a map can't stop between a key and its value
+					return (it.indefinite && (it.kind == Item::array || i % 2 == 0))
+						|| fail(c, corrupt);
+				}
+				if (!skip(c, sub, depth + 1)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Item::tag:
+			return item(c, sub) && (sub.kind != Item::stop || fail(c, corrupt))
+				&& skip(c, sub, depth + 1);
+		case Item::stop:
+			return fail(c, corrupt);
+		default:
+			return true;
+		}
+	}
+
+	/**
+		Read a text item's contents into a string.
+
+		@param out set to the text.
+		@return false if the input ends or is corrupt.
+	*/
+	bool text(Cursor& c, Item const& it, std::string& out) const {
+		if (!it.indefinite) {
+			out.assign(it.data, size_t(it.value));
+			return true;
+		}
+		out.clear();
+		Item chunk;
+		while (item(c, chunk) && chunk.kind != Item::stop) {
+			if (chunk.kind != Item::text || chunk.indefinite) {
+				return fail(c, corrupt);
+			}
+			out.append(chunk.data, size_t(chunk.value));
+		}
+		return c.failure == framed;
+	}
+
+	/**
+		Decode the value of created_time as seconds since the epoch.
+
+		@param good set to whether the value is a usable time.
+		@return false if the input ends or is corrupt.
+	*/
+	bool time_value(Cursor& c, Item const& it, VenmoRecord& rec, bool& good) {
+		good = false;
+		switch (it.kind) {
+		case Item::text:
+			if (!text(c, it, _time_str)) {
+				return false;
+			}
+			_time_empty = _time_str.empty();
+			good = VenmoRecordReader::parse_time(_time_str.c_str(),
+												 rec.created_time);
+			return true;
+		case Item::unsigned_int:
+		case Item::negative_int:
+			good = seconds(it, rec.created_time);
+			return true;
+		case Item::ext:
+			if (it.ext_type == -1) {
+				good = msgpack_timestamp(it, rec.created_time);
+			}
+			return true;
+		case Item::tag: {
+			Item sub;
+			if (!item(c, sub)) {
+				return false;
+			}
+			if (sub.kind == Item::stop) {
+				return fail(c, corrupt);
+			}
+			if (it.value == 0 && sub.kind == Item::text) {
+				return time_value(c, sub, rec, good);
+			}
+			if (it.value == 1 && (sub.kind == Item::unsigned_int ||
+				sub.kind == Item::negative_int)) {
+				good = seconds(sub, rec.created_time);
+				return true;
+			}
+			if (it.value == 1 && (sub.kind == Item::float32 ||
+				sub.kind == Item::float64)) {
+				good = float_seconds(sub, rec.created_time);
+				return true;
+			}
+			return skip(c, sub, 2);
+		}
+		default:
+			return skip(c, it, 1);
+		}
+	}
+
+	/**
+		An integer item as a time_t.
+
+		@return false if it doesn't fit.
+	*/
+	static bool seconds(Item const& it, time_t& t) {
+		uint64_t const max = uint64_t((std::numeric_limits<time_t>::max)());
+		if (it.value > max) {
+			return false;
+		}
+		t = it.kind == Item::unsigned_int ? time_t(it.value)
+			: time_t(-1) - time_t(it.value);
+		return true;
+	}
+
+	/**
+		A float item as a time_t, rounded down.
+
+		@return false if it is not finite or doesn't fit.
+	*/
+	static bool float_seconds(Item const& it, time_t& t) {
+		double d;
+		if (it.kind == Item::float32) {
+			uint32_t const bits = uint32_t(big_endian(it.data, 4));
+			float f;
+			memcpy(&f, &bits, sizeof(f));
+			d = f;
+		} else {
+			uint64_t const bits = big_endian(it.data, 8);
+			memcpy(&d, &bits, sizeof(d));
+		}
+		d = std::floor(d);
+		if (!(d >= -9.2e18 && d <= 9.2e18)) {
+			return false;
+		}
+		t = time_t(d);
+		return double(t) == d;
+	}
+
+	/**
+		A MessagePack timestamp (32, 64 or 96 bit) as a time_t, dropping the
+		nanoseconds.
+
+		@return false if it is malformed.
+	*/
+	static bool msgpack_timestamp(Item const& it, time_t& t) {
+		switch (it.value) {
+		case 4:
+			t = time_t(big_endian(it.data, 4));
+			return true;
+		case 8:
+			t = time_t(big_endian(it.data, 8) & ((uint64_t(1) << 34) - 1));
+			return true;
+		case 12:
+			t = time_t(int64_t(big_endian(it.data + 4, 8)));
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+		The field a key names, if it is a key the graph needs.
+	*/
+	static Field field_of(string_ref k) {
+		if (k == "actor") {
+			return actor_field;
+		}
+		if (k == "target") {
+			return target_field;
+		}
+		if (k == "created_time") {
+			return created_time_field;
+		}
+		return no_field;
+	}
+
+public:
+	explicit BinaryRecordReader(Format format) : _format(format) {}
+
+	/**
+		Decode the record at the start of [first, last). Anything that is
+		not a map is a malformed record; invalid UTF-8 in actor or target
+		makes the record malformed too. If a field appears more than once,
+		the first occurrence wins.
+
+		@param first first byte of the record.
+		@param last end of the input available so far.
+		@param next set to one past the record, if it is framed.
+		@param rec set to the fields read; only meaningful on ok.
+		@param status set to ok, or why the record should be skipped; only
+		meaningful if the record is framed.
+		@return framed, or why no record could be decoded.
+	*/
+	Framing read(char const* first, char const* last, char const*& next,
+				 VenmoRecord& rec, Status& status) {
+		Cursor c = { first, last, framed };
+		Item top;
+		if (!item(c, top)) {
+			return c.failure;
+		}
+		if (top.kind != Item::map) {
+			if (!skip(c, top, 0)) {
+				return c.failure;
+			}
+			next = c.p;
+			status = VenmoRecordReader::malformed;
+			return framed;
+		}
+
+		bool seen[num_fields] = { false, false, false };
+		bool good[num_fields] = { false, false, false };
+		bool valid_utf8 = true;
+		_time_empty = false;
+		for (uint64_t i = 0; top.indefinite || i < top.value; ++i) {
+			Item key;
+			if (!item(c, key)) {
+				return c.failure;
+			}
+			if (key.kind == Item::stop && top.indefinite) {
+				break;
+			}
+			Field f = no_field;
+			if (key.kind == Item::text) {
+				if (key.indefinite) {
+					if (!text(c, key, _key)) {
+						return c.failure;
+					}
+					f = field_of(string_ref(_key));
+				} else {
+					f = field_of(string_ref(key.data, size_t(key.value)));
+				}
+			} else if (!skip(c, key, 1)) {
+				return c.failure;
+			}
+
+			Item value;
+			if (!item(c, value)) {
+				return c.failure;
+			}
+			if (value.kind == Item::stop) {
+				return corrupt;
+			}
+			if (f == no_field || seen[f]) {
+				if (!skip(c, value, 1)) {
+					return c.failure;
+				}
+				continue;
+			}
+			seen[f] = true;
+			if (f == created_time_field) {
+				if (!time_value(c, value, rec, good[f])) {
+					return c.failure;
+				}
+			} else if (value.kind == Item::text) {
+				std::string& dst = f == actor_field ? rec.actor : rec.target;
+				if (!text(c, value, dst)) {
+					return c.failure;
+				}
+				good[f] = true;
+				valid_utf8 = valid_utf8 && nlohmann::string_scanner::valid_utf8(
+					dst.data(), dst.data() + dst.size());
+			} else if (!skip(c, value, 1)) {
+				return c.failure;
+			}
+		}
+		next = c.p;
+
+		// same precedence as VenmoRecordReader
+		if (!valid_utf8) {
+			status = VenmoRecordReader::malformed;
+		} else if (!seen[actor_field]) {
+			status = VenmoRecordReader::missing_actor;
+		} else if (!good[actor_field]) {
+			status = VenmoRecordReader::bad_actor;
+		} else if (rec.actor.empty()) {
+			status = VenmoRecordReader::empty_actor;
+		} else if (!seen[target_field]) {
+			status = VenmoRecordReader::missing_target;
+		} else if (!good[target_field]) {
+			status = VenmoRecordReader::bad_target;
+		} else if (rec.target.empty()) {
+			status = VenmoRecordReader::empty_target;
+		} else if (!seen[created_time_field]) {
+			status = VenmoRecordReader::missing_created_time;
+		} else if (!good[created_time_field]) {
+			status = _time_empty ? VenmoRecordReader::empty_created_time
+				: VenmoRecordReader::bad_created_time;
+		} else {
+			status = VenmoRecordReader::ok;
+		}
+		return framed;
+	}
+};  // class BinaryRecordReader
+
+}  // namespace victor
+
+#endif  // BINARY_RECORD_HPP_
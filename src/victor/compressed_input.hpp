@@ -0,0 +1,724 @@
+/**
+    Insight Data Engineering Code Challenge
+    compressed_input.hpp
+
+    Purpose:
+
+    CompressedInput is a stream buffer that reads a gzip (or, when built
+    with VICTOR_ZSTD, zstd) file and hands out its decompressed bytes.
+    Decompression runs on other threads into a ring of large buffers, so it
+    overlaps with the parsing and graph updates done by the reading thread;
+    the reader waits only when it gets ahead of decompression, and
+    decompression waits only when every buffer is full.
+
+    Plain gzip and single-frame zstd files have to be decompressed in
+    order, by one thread. Where a file is made of members whose compressed
+    size can be found without decompressing them -- BGZF gzip files, whose
+    members record their size in a header field, and zstd files of many
+    frames -- one thread splits the file into jobs of whole members and a
+    pool of workers decompresses the jobs in parallel. Either way the bytes
+    come out in file order.
+
+    open() picks the codec from the file's first bytes, so uncompressed
+    files keep being read directly. It can also read the file, compressed
+    or not, through io_uring (src/victor/uring_io.hpp).
+
+    @author Victor Chen
+*/
+#ifndef COMPRESSED_INPUT_HPP_
+#define COMPRESSED_INPUT_HPP_
+
+#include "victor/uring_io.hpp"
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <zlib.h>
+#ifdef VICTOR_ZSTD
+#include <zstd.h>
+#endif
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace victor {
+
+/**
+	Compressed Input
+*/
+class CompressedInput : public std::streambuf {
+public:
+	/**
+		Compression format of a file.
+	*/
+	enum Codec {
+		plain,	// not compressed
+		gzip,
+		zstd
+	};
+
+private:
+	/**
+		What a slot of the ring holds.
+	*/
+	enum State {
+		free_slot,	// nothing; may be reused
+		filling,	// being filled by the splitting or decompressing thread
+		queued,		// compressed members, waiting for a worker
+		decoding,	// being decompressed by a worker
+		full		// decompressed bytes, waiting for the reader
+	};
+
+	struct Slot {
+		State state = free_slot;
+		std::vector<char> input;	// compressed members of a job
+		std::vector<char> data;		// decompressed bytes
+		size_t size = 0;			// bytes of data in use
+	};
+
+	static size_t const no_end = size_t(-1);
+
+	Codec _codec;
+	size_t _buffer_size;
+	std::unique_ptr<std::streambuf> _file;
+
+	// compressed bytes read from _file, only touched by the thread that
+	// splits or decompresses the file in order
+	std::vector<char> _in;
+	size_t _in_begin = 0;	// start of the unused part of _in
+	size_t _in_end = 0;		// end of the data in _in
+	bool _in_eof = false;
+
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+	std::vector<Slot> _slots;	// slot of sequence number i is i % size
+	size_t _produced = 0;		// sequence number of the next slot filled
+	size_t _next = 0;			// sequence number of the next slot read
+	size_t _end = no_end;		// number of slots read, once known
+	bool _split_done = false;	// whether every job has been queued
+	bool _stop = false;			// whether the threads must exit
+	std::string _error;
+	std::string _file_error;	// why reading the file stopped early
+	Slot* _current = nullptr;	// slot the get area is in
+	std::vector<std::thread> _threads;
+
+	/**
+		Buffer at least n compressed bytes past _in_begin, or all that is
+		left of the file.
+
+		@param n bytes wanted.
+		@return bytes buffered.
+	*/
+	size_t fill_input(size_t n) {
+		if (_in_end - _in_begin >= n || _in_eof) {
+			return _in_end - _in_begin;
+		}
+		memmove(_in.data(), _in.data() + _in_begin, _in_end - _in_begin);
+		_in_end -= _in_begin;
+		_in_begin = 0;
+		if (_in.size() < n) {
+			_in.resize(std::max(n, _in.size() * 2));
+		}
+		while (_in_end < n && !_in_eof) {
+			std::streamsize const got = _file->sgetn(_in.data() + _in_end,
+				std::streamsize(_in.size() - _in_end));
+			if (got <= 0) {
+				_in_eof = true;
+				note_file_error();
+			} else {
+				_in_end += size_t(got);
+			}
+		}
+		return _in_end;
+	}
+
+	/**
+		Keep what stopped the file being read, if it says; a file read
+		through io_uring does.
+	*/
+	void note_file_error() {
+		UringInput const* const uring = dynamic_cast<UringInput const*>(_file.get());
+		if (uring != nullptr && !uring->error().empty()) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_file_error = uring->error();
+		}
+	}
+
+	/**
+		The unused compressed bytes; moved by fill_input().
+	*/
+	unsigned char const* input() const {
+		return reinterpret_cast<unsigned char const*>(_in.data() + _in_begin);
+	}
+
+	/**
+		Take the next slot to fill, in sequence, once the reader is done
+		with what it held.
+
+		@return the slot, or null if the threads must stop.
+	*/
+	Slot* acquire() {
+		std::unique_lock<std::mutex> lock(_mutex);
+		Slot& slot = _slots[_produced % _slots.size()];
+		_cv.wait(lock, [&] {
+			return _stop || _produced >= _end || slot.state == free_slot;
+		});
+		if (_stop || _produced >= _end) {
+			return nullptr;
+		}
+		++_produced;
+		slot.state = filling;
+		slot.size = 0;
+		return &slot;
+	}
+
+	void publish(Slot& slot, State state) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		slot.state = state;
+		_cv.notify_all();
+	}
+
+	/**
+		Stop after the slots before a sequence number.
+
+		@param seq number of slots the reader gets.
+		@param error why, or null if the input just ran out.
+	*/
+	void end_at(size_t seq, char const* error) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (error != nullptr && seq < _end) {
+			_error = error;
+		}
+		_end = std::min(_end, seq);
+		_cv.notify_all();
+	}
+
+	/**
+		No more jobs will be queued.
+
+		@param error why, or null if the input just ran out.
+	*/
+	void end_split(char const* error) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (error != nullptr && _produced < _end) {
+			_error = error;
+		}
+		_end = std::min(_end, _produced);
+		_split_done = true;
+		_cv.notify_all();
+	}
+
+	/**
+		Size of a BGZF member: a gzip member with a "BC" extra field.
+
+		@param p the member's first byte.
+		@param n bytes available.
+		@param header_size set to the bytes needed to tell, if more than n.
+		@return its compressed size, or 0 if it is not one or n is short.
+	*/
+	static size_t bgzf_size(unsigned char const* p, size_t n,
+							size_t& header_size) {
+		header_size = 12;
+		if (n < 12 || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 ||
+			(p[3] & 4) == 0) {
+			return 0;
+		}
+		size_t const xlen = size_t(p[10]) | size_t(p[11]) << 8;
+		header_size = 12 + xlen;
+		if (n < header_size) {
+			return 0;
+		}
+		for (size_t i = 12; i + 4 <= header_size; ) {
+			size_t const slen = size_t(p[i + 2]) | size_t(p[i + 3]) << 8;
+			if (p[i] == 'B' && p[i + 1] == 'C' && slen == 2 &&
+				i + 6 <= header_size) {
+				return (size_t(p[i + 4]) | size_t(p[i + 5]) << 8) + 1;
+			}
+			i += 4 + slen;
+		}
+		return 0;
+	}
+
+	/**
+		Buffer the next whole member of a file that can be split.
+
+		@param n set to its compressed size.
+		@param error set to what is wrong, on -1.
+		@return 1 if there is one, 0 at the end of the file, -1 if the
+			file is corrupt.
+	*/
+	int next_member(size_t& n, char const*& error) {
+		size_t avail = fill_input(18);
+		if (avail == 0) {
+			return 0;
+		}
+		if (_codec == gzip) {
+			size_t header_size;
+			n = bgzf_size(input(), avail, header_size);
+			if (n == 0 && avail < header_size) {
+				avail = fill_input(header_size);
+				n = bgzf_size(input(), avail, header_size);
+			}
+			if (n == 0) {
+				error = "gzip member without a BGZF block size";
+				return -1;
+			}
+		} else {
+#ifdef VICTOR_ZSTD
+			while (true) {
+				n = ZSTD_findFrameCompressedSize(_in.data() + _in_begin, avail);
+				if (!ZSTD_isError(n) || _in_eof) {
+					break;
+				}
+				avail = fill_input(avail * 2);
+			}
+			if (ZSTD_isError(n)) {
+				error = "truncated or corrupt zstd frame";
+				return -1;
+			}
+#else
+			error = "zstd input needs a build with VICTOR_ZSTD";
+			return -1;
+#endif
+		}
+		if (fill_input(n) < n) {
+			error = "unexpected end of compressed input";
+			return -1;
+		}
+		return 1;
+	}
+
+	/**
+		Split a file of independent members into jobs of whole members,
+		about a quarter of a buffer each, for the workers.
+	*/
+	void split() {
+		size_t const job_size = _buffer_size / 4;
+		char const* error = nullptr;
+		size_t n;
+		int more = next_member(n, error);
+		while (more > 0) {
+			Slot* const slot = acquire();
+			if (slot == nullptr) {
+				return;
+			}
+			slot->input.clear();
+			do {
+				char const* const p = _in.data() + _in_begin;
+				slot->input.insert(slot->input.end(), p, p + n);
+				_in_begin += n;
+			} while ((more = next_member(n, error)) > 0 &&
+					 slot->input.size() < job_size);
+			publish(*slot, queued);
+		}
+		end_split(more < 0 ? error : nullptr);
+	}
+
+	/**
+		Decompress queued jobs until there are no more.
+	*/
+	void work() {
+		while (true) {
+			Slot* slot = nullptr;
+			size_t seq = 0;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [&] {
+					// the oldest queued job is the one the reader needs first
+					for (size_t s = _next; s != _produced; ++s) {
+						Slot& candidate = _slots[s % _slots.size()];
+						if (candidate.state == queued) {
+							slot = &candidate;
+							seq = s;
+							return true;
+						}
+					}
+					return _stop || _split_done;
+				});
+				if (slot == nullptr) {
+					return;
+				}
+				slot->state = decoding;
+			}
+			char const* error = _codec == gzip ? inflate_job(*slot)
+				: zstd_job(*slot);
+			if (error != nullptr) {
+				end_at(seq, error);
+			}
+			publish(*slot, full);
+		}
+	}
+
+	/**
+		Make room in a slot for more decompressed bytes.
+
+		@return bytes of room.
+	*/
+	static size_t grow(Slot& slot, size_t hint) {
+		if (slot.data.size() - slot.size < 4096) {
+			slot.data.resize(std::max(std::max(slot.data.size() * 2, hint),
+									  size_t(1) << 16));
+		}
+		return std::min(slot.data.size() - slot.size, size_t(UINT_MAX));
+	}
+
+	/**
+		Decompress the gzip members of a job.
+
+		@return null, or what is wrong with them.
+	*/
+	static char const* inflate_job(Slot& slot) {
+		z_stream z;
+		memset(&z, 0, sizeof(z));
+		if (inflateInit2(&z, 15 + 16) != Z_OK) {
+			return "can't start inflating";
+		}
+		z.next_in = reinterpret_cast<Bytef*>(slot.input.data());
+		z.avail_in = uInt(slot.input.size());
+		char const* error = nullptr;
+		while (true) {
+			z.avail_out = uInt(grow(slot, slot.input.size() * 4));
+			z.next_out = reinterpret_cast<Bytef*>(slot.data.data() + slot.size);
+			uInt const room = z.avail_out;
+			int const r = inflate(&z, Z_NO_FLUSH);
+			slot.size += room - z.avail_out;
+			if (r == Z_STREAM_END) {
+				if (z.avail_in == 0) {
+					break;
+				}
+				inflateReset(&z);
+			} else if (r != Z_OK && !(r == Z_BUF_ERROR && z.avail_out == 0)) {
+				error = r == Z_BUF_ERROR ? "unexpected end of compressed input"
+					: "corrupt gzip data";
+				break;
+			}
+		}
+		inflateEnd(&z);
+		return error;
+	}
+
+	/**
+		Decompress the zstd frames of a job.
+
+		@return null, or what is wrong with them.
+	*/
+	static char const* zstd_job(Slot& slot) {
+#ifdef VICTOR_ZSTD
+		ZSTD_DCtx* const dctx = ZSTD_createDCtx();
+		ZSTD_inBuffer in = { slot.input.data(), slot.input.size(), 0 };
+		char const* error = nullptr;
+		size_t r = 0;
+		while (in.pos != in.size || r != 0) {
+			size_t const room = grow(slot, slot.input.size() * 4);
+			ZSTD_outBuffer out = { slot.data.data() + slot.size, room, 0 };
+			r = ZSTD_decompressStream(dctx, &out, &in);
+			slot.size += out.pos;
+			if (ZSTD_isError(r)) {
+				error = "corrupt zstd data";
+				break;
+			}
+			if (in.pos == in.size && r != 0 && out.pos < room) {
+				error = "unexpected end of compressed input";
+				break;
+			}
+		}
+		ZSTD_freeDCtx(dctx);
+		return error;
+#else
+		(void) slot;
+		return "zstd input needs a build with VICTOR_ZSTD";
+#endif
+	}
+
+	/**
+		Decompress a gzip file of one or more members in order.
+	*/
+	void inflate_stream() {
+		z_stream z;
+		memset(&z, 0, sizeof(z));
+		if (inflateInit2(&z, 15 + 16) != Z_OK) {
+			end_at(0, "can't start inflating");
+			return;
+		}
+		bool in_member = false;	// whether a member has been started
+		char const* error = nullptr;
+		Slot* slot = acquire();
+		while (slot != nullptr) {
+			slot->data.resize(_buffer_size);
+			if (_in_begin == _in_end && fill_input(1) == 0) {
+				if (in_member) {
+					error = "unexpected end of compressed input";
+				}
+				break;
+			}
+			size_t const avail = std::min(_in_end - _in_begin, size_t(UINT_MAX));
+			z.next_in = reinterpret_cast<Bytef*>(_in.data() + _in_begin);
+			z.avail_in = uInt(avail);
+			z.next_out = reinterpret_cast<Bytef*>(slot->data.data() + slot->size);
+			z.avail_out = uInt(_buffer_size - slot->size);
+			int const r = inflate(&z, Z_NO_FLUSH);
+			_in_begin += avail - z.avail_in;
+			slot->size = _buffer_size - z.avail_out;
+			in_member = true;
+			if (r == Z_STREAM_END) {
+				// concatenated members decompress to concatenated data
+				in_member = false;
+				inflateReset(&z);
+			} else if (r != Z_OK) {
+				error = "corrupt gzip data";
+				break;
+			}
+			if (slot->size == _buffer_size) {
+				publish(*slot, full);
+				slot = acquire();
+			}
+		}
+		inflateEnd(&z);
+		stream_done(slot, error);
+	}
+
+	/**
+		Decompress a zstd file in order.
+	*/
+	void zstd_stream() {
+#ifdef VICTOR_ZSTD
+		ZSTD_DCtx* const dctx = ZSTD_createDCtx();
+		size_t r = 0;	// 0 between frames
+		char const* error = nullptr;
+		Slot* slot = acquire();
+		while (slot != nullptr) {
+			slot->data.resize(_buffer_size);
+			if (_in_begin == _in_end && fill_input(1) == 0) {
+				if (r != 0) {
+					error = "unexpected end of compressed input";
+				}
+				break;
+			}
+			ZSTD_inBuffer in = { _in.data() + _in_begin, _in_end - _in_begin, 0 };
+			ZSTD_outBuffer out = { slot->data.data(), _buffer_size, slot->size };
+			r = ZSTD_decompressStream(dctx, &out, &in);
+			_in_begin += in.pos;
+			slot->size = out.pos;
+			if (ZSTD_isError(r)) {
+				error = "corrupt zstd data";
+				break;
+			}
+			if (slot->size == _buffer_size) {
+				publish(*slot, full);
+				slot = acquire();
+			}
+		}
+		ZSTD_freeDCtx(dctx);
+		stream_done(slot, error);
+#else
+		end_at(0, "zstd input needs a build with VICTOR_ZSTD");
+#endif
+	}
+
+	/**
+		Hand over the last slot of an in-order decompression.
+
+		@param slot the slot being filled, or null.
+		@param error what went wrong, or null.
+	*/
+	void stream_done(Slot* slot, char const* error) {
+		if (slot == nullptr) {
+			return;
+		}
+		publish(*slot, full);
+		std::lock_guard<std::mutex> lock(_mutex);
+		size_t const seq = _produced;
+		if (error != nullptr && seq < _end) {
+			_error = error;
+		}
+		_end = std::min(_end, seq);
+		_cv.notify_all();
+	}
+
+	/**
+		Whether the file starts with a member whose size is known without
+		decompressing it, so the file can be split for the workers.
+	*/
+	bool splittable() {
+		if (_codec == gzip) {
+			size_t header_size;
+			size_t avail = fill_input(18);
+			if (bgzf_size(input(), avail, header_size) != 0) {
+				return true;
+			}
+			if (avail >= header_size) {
+				return false;
+			}
+			avail = fill_input(header_size);
+			return bgzf_size(input(), avail, header_size) != 0;
+		}
+#ifdef VICTOR_ZSTD
+		// a first frame that is not too large to buffer
+		size_t const avail = fill_input(_buffer_size);
+		return _codec == zstd && avail != 0 &&
+			!ZSTD_isError(ZSTD_findFrameCompressedSize(_in.data(), avail));
+#else
+		return false;
+#endif
+	}
+
+protected:
+	int_type underflow() override {
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true) {
+			if (_current != nullptr) {
+				_current->state = free_slot;
+				_current = nullptr;
+				setg(nullptr, nullptr, nullptr);
+				_cv.notify_all();
+			}
+			Slot& slot = _slots[_next % _slots.size()];
+			_cv.wait(lock, [&] {
+				return _next >= _end || slot.state == full;
+			});
+			if (_next >= _end) {
+				return traits_type::eof();
+			}
+			++_next;
+			_current = &slot;
+			if (slot.size != 0) {
+				setg(slot.data.data(), slot.data.data(),
+					 slot.data.data() + slot.size);
+				return traits_type::to_int_type(*gptr());
+			}
+		}
+	}
+
+public:
+	/**
+		@param file the compressed file.
+		@param codec its compression format; not plain.
+		@param buffer_size bytes decompressed into each buffer of the ring.
+		@param num_workers threads decompressing split files; 0 for one
+			per hardware thread.
+	*/
+	CompressedInput(std::unique_ptr<std::streambuf> file, Codec codec,
+					size_t buffer_size = 1 << 20, unsigned num_workers = 0)
+		: _codec(codec), _buffer_size(buffer_size < 4096 ? 4096 : buffer_size),
+		  _file(std::move(file)), _in(_buffer_size) {
+		if (num_workers == 0) {
+			num_workers = std::max(1u, std::thread::hardware_concurrency());
+		}
+		if (splittable()) {
+			_slots = std::vector<Slot>(std::max(4u, 2 * num_workers + 2));
+			_threads.emplace_back(&CompressedInput::split, this);
+			for (unsigned i = 0; i < num_workers; ++i) {
+				_threads.emplace_back(&CompressedInput::work, this);
+			}
+		} else {
+			_slots = std::vector<Slot>(4);
+			_threads.emplace_back(codec == gzip ? &CompressedInput::inflate_stream
+				: &CompressedInput::zstd_stream, this);
+		}
+	}
+
+	~CompressedInput() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_cv.notify_all();
+		for (std::thread& t : _threads) {
+			t.join();
+		}
+	}
+
+	CompressedInput(CompressedInput const&) = delete;
+	CompressedInput& operator=(CompressedInput const&) = delete;
+
+	/**
+		Whether reading or decompressing the file failed. The bytes before
+		the failure are still read.
+
+		@return true if the input ended early because of an error.
+	*/
+	bool failed() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return !_error.empty() || !_file_error.empty();
+	}
+
+	/**
+		What went wrong, if failed(); a failure to read the file comes
+		before what it did to decompression.
+
+		@return a short description, or "" if nothing did.
+	*/
+	std::string error() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _file_error.empty() ? _error : _file_error;
+	}
+
+	/**
+		Tell the compression format from a file's first bytes.
+
+		@param p the first bytes.
+		@param n how many there are.
+		@return the codec.
+	*/
+	static Codec detect(char const* p, size_t n) {
+		unsigned char const* const u = reinterpret_cast<unsigned char const*>(p);
+		if (n >= 2 && u[0] == 0x1f && u[1] == 0x8b) {
+			return gzip;
+		}
+		if (n >= 4 && u[0] == 0x28 && u[1] == 0xb5 && u[2] == 0x2f &&
+			u[3] == 0xfd) {
+			return zstd;
+		}
+		return plain;
+	}
+
+	/**
+		Open a file for reading, decompressing it if it is compressed.
+
+		@param filename the file.
+		@param buffer_size bytes decompressed into each buffer of the ring.
+		@param uring whether to read the file through io_uring (see
+			src/victor/uring_io.hpp), where it can be used.
+		@return a stream buffer of its contents, or null if it can't be
+			opened.
+	*/
+	static std::unique_ptr<std::streambuf> open(char const* filename,
+												size_t buffer_size = 1 << 20,
+												bool uring = false) {
+		std::unique_ptr<std::filebuf> file(new std::filebuf);
+		if (file->open(filename, std::ios::in | std::ios::binary) == nullptr) {
+			return nullptr;
+		}
+		// through an istream, so that a file that can't be read comes out
+		// short instead of throwing; reading it proper tells why
+		char magic[4];
+		std::istream sniff(file.get());
+		sniff.read(magic, sizeof(magic));
+		std::streamsize const n = sniff.gcount();
+		file->pubseekpos(0, std::ios::in);
+		Codec const codec = detect(magic, n < 0 ? 0 : size_t(n));
+		std::unique_ptr<std::streambuf> raw(file.release());
+		if (uring) {
+			std::unique_ptr<std::streambuf> in = UringInput::open(filename);
+			if (in) {
+				raw = std::move(in);
+			}
+		}
+		if (codec == plain) {
+			return raw;
+		}
+		return std::unique_ptr<std::streambuf>(new CompressedInput(
+			std::move(raw), codec, buffer_size));
+	}
+};  // class CompressedInput
+
+}  // namespace victor
+
+#endif  // COMPRESSED_INPUT_HPP_
@@ -0,0 +1,433 @@
+/**
+    Insight Data Engineering Code Challenge
+    differential.hpp
+
+    Purpose:
+
+    Differential testing of the engines against ReferenceGraph (defined in
+    src/victor/reference_graph.hpp): the same stream of payments goes to
+    the reference and to every production engine, and after each payment
+    the median, the number of vertices and the number of edges must be
+    the same, and the number of triangles too, where an engine counts
+    them. The production engines are VenmoGraph itself, and
+    MedDegStream reading the stream written as JSON lines, MessagePack and
+    CBOR, so parsing is checked along with the graph.
+
+    Streams are random and short, drawn from a handful of users so that
+    they collide, and made of the payments that are easy to get wrong: in
+    the same second, late but in the window, just inside and just outside
+    the window's edge, too late to count, after a jump far ahead in time,
+    repeating an edge in either direction, and paid to oneself.
+
+    When a stream tells the engines apart, it is shrunk before it is
+    reported: stretches of payments are cut out, users renamed in order
+    of appearance and times pulled back, for as long as the engines still
+    disagree.
+
+    insight_testsuite/test_victor/test_differential.cpp runs a fixed
+    number of streams, and, with VICTOR_SOAK_SECONDS set (make soak), as
+    many as fit in that many seconds.
+
+    @author Victor Chen
+*/
+#ifndef DIFFERENTIAL_HPP_
+#define DIFFERENTIAL_HPP_
+
+#include "victor/med_deg_stream.hpp"
+#include "victor/reference_graph.hpp"
+#include "victor/venmo_graph.hpp"
+#include "victor/workload.hpp"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace victor {
+
+typedef WorkloadGenerator::Event Payment;
+typedef std::vector<Payment> PaymentStream;
+
+/**
+	Differential
+*/
+class Differential {
+public:
+	/**
+		An engine: runs a stream, and returns what it says after each
+		payment.
+	*/
+	typedef std::function<std::vector<MedianEvent>(PaymentStream const&)> Engine;
+
+	/**
+		Where an engine first disagrees with the reference.
+	*/
+	struct Mismatch {
+		std::string engine;			// empty if none disagrees
+		size_t index = 0;			// of the payment
+		MedianEvent expected;
+		MedianEvent actual;
+	};
+
+private:
+	std::vector<std::pair<std::string, Engine>> _engines;
+	std::string _filename;
+	Random _random;
+
+	static std::string name(uint64_t user) {
+		char buf[64];
+		return std::string(buf, WorkloadGenerator::user_name(buf, user));
+	}
+
+	static bool same(MedianEvent const& a, MedianEvent const& b) {
+		return a.created_time == b.created_time && a.median == b.median &&
+			   a.num_vertices == b.num_vertices && a.num_edges == b.num_edges &&
+			   (a.triangles < 0 || b.triangles < 0 || a.triangles == b.triangles);
+	}
+
+	/**
+		Feed a stream to anything with extract_median(), num_vertices(),
+		num_edges(), count_triangles() and triangles().
+	*/
+	template <typename Graph>
+	static std::vector<MedianEvent> run_graph(PaymentStream const& stream) {
+		Graph graph;
+		graph.count_triangles();
+		std::vector<MedianEvent> events;
+		for (Payment const& p : stream) {
+			MedianEvent e;
+			e.created_time = p.created_time;
+			e.median = graph.extract_median(name(p.actor), name(p.target),
+											p.created_time);
+			e.num_vertices = graph.num_vertices();
+			e.num_edges = graph.num_edges();
+			e.triangles = int64_t(graph.triangles());
+			events.push_back(e);
+		}
+		return events;
+	}
+
+	/**
+		Keeps what MedDegStream writes.
+	*/
+	class CollectingSink {
+	private:
+		std::vector<MedianEvent>& _events;
+
+	public:
+		explicit CollectingSink(std::vector<MedianEvent>& events)
+			: _events(events) {}
+
+		void write(MedianEvent const& e) {
+			_events.push_back(e);
+		}
+
+		void flush() {}
+	};
+
+	/**
+		Write a stream to a file in a format, and run MedDegStream over it.
+	*/
+	static std::vector<MedianEvent> run_stream(PaymentStream const& stream,
+											   WorkloadConfig::Format format,
+											   std::string const& filename) {
+		{
+			WorkloadConfig config;
+			config.format = format;
+			WorkloadGenerator const writer(config);
+			std::ofstream ofs(filename.c_str(), std::ofstream::binary);
+			OutputBuffer out(ofs);
+			for (Payment const& p : stream) {
+				writer.write(p, out);
+			}
+		}
+		std::vector<MedianEvent> events;
+		{
+			CollectingSink sink(events);
+			MedDegStream mds(filename.c_str(), "/dev/null",
+							 MedDegStream::Format(format));
+			mds.count_triangles();
+			mds.process(sink);
+		}
+		remove(filename.c_str());
+		return events;
+	}
+
+	/**
+		Cut out stretches of payments, halving their length, for as long as
+		the stream still fails.
+	*/
+	template <typename Fails>
+	static bool cut(PaymentStream& stream, Fails const& fails) {
+		bool cut_any = false;
+		for (size_t chunk = stream.size() / 2; chunk >= 1; chunk /= 2) {
+			for (size_t i = 0; i + chunk <= stream.size(); ) {
+				PaymentStream candidate(stream.begin(), stream.begin() + ptrdiff_t(i));
+				candidate.insert(candidate.end(),
+								 stream.begin() + ptrdiff_t(i + chunk), stream.end());
+				if (fails(candidate)) {
+					stream.swap(candidate);
+					cut_any = true;
+				} else {
+					i += chunk;
+				}
+			}
+		}
+		return cut_any;
+	}
+
+	/**
+		Rename users in order of appearance, and bring each time halfway, or
+		all the way, to the one before it, where the stream still fails.
+	*/
+	template <typename Fails>
+	static bool simplify(PaymentStream& stream, Fails const& fails) {
+		bool simplified = false;
+		std::map<uint64_t, uint64_t> renamed;
+		PaymentStream candidate = stream;
+		bool changed = false;
+		for (Payment& p : candidate) {
+			p.actor = renamed.emplace(p.actor, renamed.size()).first->second;
+			p.target = renamed.emplace(p.target, renamed.size()).first->second;
+		}
+		for (size_t i = 0; i < stream.size(); ++i) {
+			changed |= candidate[i].actor != stream[i].actor ||
+					   candidate[i].target != stream[i].target;
+		}
+		if (changed && fails(candidate)) {
+			stream.swap(candidate);
+			simplified = true;
+		}
+		for (size_t i = 1; i < stream.size(); ++i) {
+			time_t const previous = stream[i - 1].created_time;
+			time_t const t = stream[i].created_time;
+			if (t == previous) {
+				continue;
+			}
+			time_t const simpler[] = { previous, previous + (t - previous) / 2 };
+			for (time_t s : simpler) {
+				candidate = stream;
+				candidate[i].created_time = s;
+				if (s != t && fails(candidate)) {
+					stream.swap(candidate);
+					simplified = true;
+					break;
+				}
+			}
+		}
+		return simplified;
+	}
+
+public:
+	/**
+		@param seed seed of the random streams.
+		@param filename file to write streams to for MedDegStream.
+	*/
+	explicit Differential(uint64_t seed = 1,
+						  std::string filename = "differential_input.bin")
+		: _filename(std::move(filename)), _random(seed) {
+		_engines.push_back(std::make_pair(std::string("VenmoGraph"),
+			Engine(&run_graph<VenmoGraph>)));
+		char const* const names[] = { "MedDegStream/json", "MedDegStream/msgpack",
+									  "MedDegStream/cbor" };
+		WorkloadConfig::Format const formats[] = { WorkloadConfig::json,
+			WorkloadConfig::msgpack, WorkloadConfig::cbor };
+		for (int i = 0; i < 3; ++i) {
+			WorkloadConfig::Format const format = formats[i];
+			std::string const filename = _filename;
+			_engines.push_back(std::make_pair(std::string(names[i]), Engine(
+				[format, filename](PaymentStream const& stream) {
+					return run_stream(stream, format, filename);
+				})));
+		}
+	}
+
+	/**
+		Check another engine, as well as the production ones.
+	*/
+	void add_engine(std::string name, Engine engine) {
+		_engines.push_back(std::make_pair(std::move(name), std::move(engine)));
+	}
+
+	/**
+		Draw a random stream.
+
+		@param max_length the most payments in it.
+		@return the stream.
+	*/
+	PaymentStream random_stream(size_t max_length) {
+		uint64_t const num_users = 2 + _random.below(24);
+		size_t const length = 1 + size_t(_random.below(max_length));
+		// how likely each kind of payment is varies from stream to stream
+		double weights[9];
+		double sum = 0;
+		for (double& w : weights) {
+			w = _random.chance(0.3) ? 0 : _random.uniform();
+			sum += w;
+		}
+		if (sum == 0) {
+			weights[0] = sum = 1;
+		}
+
+		PaymentStream stream;
+		time_t latest = WorkloadConfig().start_time + time_t(_random.below(1000));
+		for (size_t i = 0; i < length; ++i) {
+			Payment p;
+			p.created_time = latest;
+			p.actor = _random.below(num_users);
+			do {
+				p.target = _random.below(num_users);
+			} while (p.target == p.actor);
+			p.defect = WorkloadGenerator::no_defect;
+
+			double pick = _random.uniform() * sum;
+			int kind = 0;
+			while (kind < 8 && pick >= weights[kind]) {
+				pick -= weights[kind++];
+			}
+			switch (kind) {
+			case 0:		// same second
+				break;
+			case 1:		// a little later
+				p.created_time = latest += time_t(1 + _random.below(5));
+				break;
+			case 2:		// late, in the window
+				p.created_time = latest - time_t(_random.below(60));
+				break;
+			case 3:		// at the window's edge
+				p.created_time = latest - time_t(58 + _random.below(4));
+				break;
+			case 4:		// too late
+				p.created_time = latest - time_t(60 + _random.below(100000));
+				break;
+			case 5:		// far ahead, maybe past the whole window
+				p.created_time = latest += time_t(59 + _random.below(
+					_random.chance(0.5) ? 3 : 1000000));
+				break;
+			case 6:		// an edge again, either way round
+				if (!stream.empty()) {
+					Payment const& q = stream[_random.below(stream.size())];
+					bool const flip = _random.chance(0.5);
+					p.actor = flip ? q.target : q.actor;
+					p.target = flip ? q.actor : q.target;
+				}
+				break;
+			case 7:		// to oneself
+				p.target = p.actor;
+				break;
+			default:	// an edge again, later
+				if (!stream.empty()) {
+					Payment const& q = stream[_random.below(stream.size())];
+					p.actor = q.actor;
+					p.target = q.target;
+					p.created_time = q.created_time + time_t(_random.below(70));
+					if (p.created_time > latest) {
+						latest = p.created_time;
+					}
+				}
+				break;
+			}
+			stream.push_back(p);
+		}
+		return stream;
+	}
+
+	/**
+		Run a stream through the reference and every engine.
+
+		@return where the first engine to disagree does, if one does.
+	*/
+	Mismatch check(PaymentStream const& stream) const {
+		std::vector<MedianEvent> const expected = run_graph<ReferenceGraph>(stream);
+		Mismatch m;
+		for (auto const& engine : _engines) {
+			std::vector<MedianEvent> const actual = engine.second(stream);
+			for (size_t i = 0; i < expected.size(); ++i) {
+				if (i >= actual.size() || !same(expected[i], actual[i])) {
+					m.engine = engine.first;
+					m.index = i;
+					m.expected = expected[i];
+					if (i < actual.size()) {
+						m.actual = actual[i];
+					}
+					return m;
+				}
+			}
+		}
+		return m;
+	}
+
+	/**
+		Shrink a stream that some engine disagrees on.
+
+		@param stream the stream; the engines must disagree on it.
+		@return a stream, no longer and usually much shorter, that they
+		still disagree on.
+	*/
+	PaymentStream shrink(PaymentStream stream) const {
+		auto const fails = [this](PaymentStream const& s) {
+			return !check(s).engine.empty();
+		};
+		while (cut(stream, fails) || simplify(stream, fails)) {
+		}
+		return stream;
+	}
+
+	/**
+		@return a stream and where it went wrong, readably.
+	*/
+	static std::string describe(PaymentStream const& stream, Mismatch const& m) {
+		std::ostringstream ss;
+		time_t const start = stream.empty() ? 0 : stream.front().created_time;
+		for (size_t i = 0; i < stream.size(); ++i) {
+			Payment const& p = stream[i];
+			time_t const t = p.created_time - start;
+			ss << (i == m.index ? "> " : "  ") << (t < 0 ? "t" : "t+") << t
+			   << ' ' << name(p.actor) << " -> " << name(p.target) << '\n';
+		}
+		if (!m.engine.empty()) {
+			ss << m.engine << " at payment " << m.index << ": median "
+			   << m.actual.median << ", " << m.actual.num_vertices << " vertices, "
+			   << m.actual.num_edges << " edges, " << m.actual.triangles
+			   << " triangles; expected median " << m.expected.median << ", "
+			   << m.expected.num_vertices << " vertices, "
+			   << m.expected.num_edges << " edges, " << m.expected.triangles
+			   << " triangles\n";
+		}
+		return ss.str();
+	}
+
+	/**
+		Check random streams until one fails, or enough have passed.
+
+		@param max_streams the most streams to check.
+		@param max_seconds the longest to go on.
+		@param max_length the most payments in a stream.
+		@param failure set to the shrunk failing stream and where it fails.
+		@return the number of streams that passed.
+	*/
+	uint64_t run(uint64_t max_streams, double max_seconds, size_t max_length,
+				 std::string& failure) {
+		time_t const deadline = time(nullptr) + time_t(max_seconds);
+		uint64_t passed = 0;
+		while (passed < max_streams && time(nullptr) < deadline) {
+			PaymentStream stream = random_stream(max_length);
+			if (!check(stream).engine.empty()) {
+				stream = shrink(std::move(stream));
+				failure = describe(stream, check(stream));
+				break;
+			}
+			++passed;
+		}
+		return passed;
+	}
+};  // class Differential
+
+}  // namespace victor
+
+#endif  // DIFFERENTIAL_HPP_
@@ -0,0 +1,359 @@
+/**
+    Insight Data Engineering Code Challenge
+    instrument.hpp
+
+    Purpose:
+
+    Timing of the stages of the hot path, for telling where a slow replay
+    spends its time: reading input, indexing lines, parsing records,
+    bookkeeping of edges in VenmoGraph, expiring edges, MedHeapMap
+    operations and writing output.
+
+    It is compiled out unless VICTOR_INSTRUMENT is defined (make
+    INSTRUMENT=1); the macros below then expand to nothing, or to the
+    expression they wrap. When compiled in, the code to time is wrapped in
+    VICTOR_TIMED(stage, expression), or a scope is opened with
+    VICTOR_PROBE(stage). Time is read from the TSC where there is one, and
+    from clock_gettime() otherwise.
+
+    Probes nest, and each stage is charged only its own time: a MedHeapMap
+    operation inside the expiry of edges counts for heap, not expire. So
+    the stages add up to the time spent under any probe. Each stage keeps
+    its total and an HDR-style histogram (log-linear buckets, within 1/16
+    of the value) of the time of each call.
+
+    The breakdown is printed to stderr when the program exits, and when it
+    gets SIGUSR1: the signal only sets a flag, which MedDegStream polls
+    with VICTOR_POLL() between blocks of input.
+
+    Probes are meant for the thread that processes records; the counters
+    are not synchronized.
+
+    @author Victor Chen
+*/
+#ifndef INSTRUMENT_HPP_
+#define INSTRUMENT_HPP_
+
+#ifdef VICTOR_INSTRUMENT
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <chrono>
+
+namespace victor {
+
+/**
+	Histogram of tick counts, in log-linear buckets: values below 32 have a
+	bucket each, and every power of two above has 16.
+*/
+class TickHistogram {
+public:
+	static int const num_buckets = 32 + 59 * 16;
+
+private:
+	uint64_t _counts[num_buckets];
+	uint64_t _count = 0;
+	uint64_t _max = 0;
+
+public:
+	TickHistogram() {
+		memset(_counts, 0, sizeof(_counts));
+	}
+
+	static int bucket(uint64_t v) {
+		if (v < 32) {
+			return int(v);
+		}
+		int const e = 63 - __builtin_clzll(v);
+		return 32 + (e - 5) * 16 + int((v >> (e - 4)) & 15);
+	}
+
+	/**
+		@return the smallest value in a bucket.
+	*/
+	static uint64_t lowest(int b) {
+		if (b < 32) {
+			return uint64_t(b);
+		}
+		int const e = (b - 32) / 16 + 5;
+		return (uint64_t(16 + (b - 32) % 16)) << (e - 4);
+	}
+
+	void record(uint64_t v) {
+		++_counts[bucket(v)];
+		++_count;
+		if (v > _max) {
+			_max = v;
+		}
+	}
+
+	/**
+		@param q in [0, 1].
+		@return a value that at least q of those recorded are at most,
+		within the precision of the buckets.
+	*/
+	uint64_t quantile(double q) const {
+		uint64_t const rank = uint64_t(q * double(_count));
+		uint64_t seen = 0;
+		for (int b = 0; b < num_buckets; ++b) {
+			seen += _counts[b];
+			if (seen > rank) {
+				uint64_t const high = b + 1 < num_buckets ? lowest(b + 1) - 1 : _max;
+				return high < _max ? high : _max;
+			}
+		}
+		return _max;
+	}
+
+	uint64_t count() const {
+		return _count;
+	}
+
+	uint64_t max() const {
+		return _max;
+	}
+
+	void clear() {
+		memset(_counts, 0, sizeof(_counts));
+		_count = 0;
+		_max = 0;
+	}
+};  // class TickHistogram
+
+/**
+	Instrument
+
+	The stages, their counters, and the clock.
+*/
+class Instrument {
+public:
+	enum Stage {
+		read,		// getting blocks of input, decompression included
+		index,		// StructuralIndex::build()
+		parse,		// reading the fields of a record
+		graph,		// VenmoGraph bookkeeping of edges and neighbors
+		expire,		// dropping edges out of the window
+		heap,		// MedHeapMap operations
+		triangle,	// TriangleCounter updates, when counting
+		output,		// writing to the sink
+		num_stages
+	};
+
+private:
+	struct Counters {
+		uint64_t ticks = 0;
+		TickHistogram histogram;
+	};
+
+	Counters _stages[num_stages];
+	uint64_t _child_ticks = 0;		// of probes inside the innermost one
+	uint64_t _start_ticks;
+	std::chrono::steady_clock::time_point _start_time;
+
+	static volatile sig_atomic_t& report_requested() {
+		static volatile sig_atomic_t requested = 0;
+		return requested;
+	}
+
+	static void on_signal(int) {
+		report_requested() = 1;
+	}
+
+	Instrument() : _start_ticks(now()), _start_time(std::chrono::steady_clock::now()) {
+		struct sigaction action;
+		memset(&action, 0, sizeof(action));
+		action.sa_handler = &Instrument::on_signal;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = SA_RESTART;
+		sigaction(SIGUSR1, &action, nullptr);
+	}
+
+	~Instrument() {
+		bool any = false;
+		for (Counters const& c : _stages) {
+			any = any || c.histogram.count() != 0;
+		}
+		if (any) {
+			report(stderr);
+		}
+	}
+
+public:
+	Instrument(Instrument const&) = delete;
+	Instrument& operator=(Instrument const&) = delete;
+
+	static Instrument& instance() {
+		static Instrument instrument;
+		return instrument;
+	}
+
+	static char const* name(Stage stage) {
+		static char const* const names[] = {
+			"read", "index", "parse", "graph", "expire", "heap", "triangle",
+			"output"
+		};
+		return names[stage];
+	}
+
+	/**
+		@return the current time, in ticks.
+	*/
+	static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return uint64_t(ts.tv_sec) * 1000000000u + uint64_t(ts.tv_nsec);
+#endif
+	}
+
+	/**
+		@return nanoseconds per tick, measured since the instrument began.
+	*/
+	double ns_per_tick() const {
+#if defined(__x86_64__) || defined(__i386__)
+		uint64_t const ticks = now() - _start_ticks;
+		double const ns = std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - _start_time).count();
+		return ticks == 0 ? 1 : ns / double(ticks);
+#else
+		return 1;
+#endif
+	}
+
+	/**
+		Start timing a probe.
+
+		@return what to pass to end().
+	*/
+	uint64_t begin() {
+		uint64_t const saved = _child_ticks;
+		_child_ticks = 0;
+		return saved;
+	}
+
+	/**
+		Charge a probe's own time to its stage.
+
+		@param stage the probe's stage.
+		@param elapsed ticks since the probe started.
+		@param saved what begin() returned.
+	*/
+	void end(Stage stage, uint64_t elapsed, uint64_t saved) {
+		uint64_t const own = elapsed > _child_ticks ? elapsed - _child_ticks : 0;
+		_stages[stage].ticks += own;
+		_stages[stage].histogram.record(own);
+		_child_ticks = saved + elapsed;
+	}
+
+	uint64_t ticks(Stage stage) const {
+		return _stages[stage].ticks;
+	}
+
+	TickHistogram const& histogram(Stage stage) const {
+		return _stages[stage].histogram;
+	}
+
+	void clear() {
+		for (Counters& c : _stages) {
+			c.ticks = 0;
+			c.histogram.clear();
+		}
+	}
+
+	/**
+		Print the breakdown: per stage, the calls, total time and share of
+		all stages, and percentiles of the time per call.
+	*/
+	void report(FILE* f) const {
+		double const scale = ns_per_tick();
+		uint64_t all = 0;
+		for (Counters const& c : _stages) {
+			all += c.ticks;
+		}
+		fprintf(f, "%-8s %12s %10s %6s %8s %8s %8s %8s %10s (ns)\n", "stage",
+				"calls", "total s", "share", "p50", "p90", "p99", "p99.9", "max");
+		for (int s = 0; s < num_stages; ++s) {
+			Counters const& c = _stages[s];
+			TickHistogram const& h = c.histogram;
+			fprintf(f, "%-8s %12llu %10.3f %5.1f%% %8.0f %8.0f %8.0f %8.0f %10.0f\n",
+					name(Stage(s)), (unsigned long long)h.count(),
+					double(c.ticks) * scale * 1e-9,
+					all == 0 ? 0.0 : 100.0 * double(c.ticks) / double(all),
+					double(h.quantile(0.5)) * scale, double(h.quantile(0.9)) * scale,
+					double(h.quantile(0.99)) * scale, double(h.quantile(0.999)) * scale,
+					double(h.max()) * scale);
+		}
+		fprintf(f, "%-8s %12s %10.3f\n", "total", "", double(all) * scale * 1e-9);
+		fflush(f);
+	}
+
+	/**
+		Print the breakdown if SIGUSR1 has come since the last poll.
+	*/
+	void poll() {
+		if (report_requested()) {
+			report_requested() = 0;
+			report(stderr);
+		}
+	}
+};  // class Instrument
+
+/**
+	Times the scope it lives in.
+*/
+class Probe {
+private:
+	Instrument& _instrument;
+	Instrument::Stage _stage;
+	uint64_t _saved;
+	uint64_t _start;
+
+public:
+	explicit Probe(Instrument::Stage stage)
+		: _instrument(Instrument::instance()), _stage(stage),
+		  _saved(_instrument.begin()), _start(Instrument::now()) {}
+
+	~Probe() {
+		_instrument.end(_stage, Instrument::now() - _start, _saved);
+	}
+
+	Probe(Probe const&) = delete;
+	Probe& operator=(Probe const&) = delete;
+};  // class Probe
+
+/**
+	@return f(), timed as a stage.
+*/
+template <typename F>
+auto timed(Instrument::Stage stage, F f) -> decltype(f()) {
+	Probe const probe(stage);
+	return f();
+}
+
+}  // namespace victor
+
+#define VICTOR_PROBE_NAME2(line) victor_probe_##line
+#define VICTOR_PROBE_NAME(line) VICTOR_PROBE_NAME2(line)
+#define VICTOR_PROBE(stage) \
+	::victor::Probe const VICTOR_PROBE_NAME(__LINE__)(::victor::Instrument::stage)
+#define VICTOR_TIMED(stage, expression) \
+	::victor::timed(::victor::Instrument::stage, [&]() { return expression; })
+#define VICTOR_POLL() ::victor::Instrument::instance().poll()
+
+#else
+
+#define VICTOR_PROBE(stage) ((void)0)
+#define VICTOR_TIMED(stage, expression) (expression)
+#define VICTOR_POLL() ((void)0)
+
+#endif  // VICTOR_INSTRUMENT
+
+#endif  // INSTRUMENT_HPP_
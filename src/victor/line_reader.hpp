@@ -0,0 +1,225 @@
+/**
+    Insight Data Engineering Code Challenge
+    line_reader.hpp
+
+    Purpose:
+
+    LineReader reads a file in large chunks and hands out its lines as
+    (first, last) character ranges into its own buffer. Unlike std::getline,
+    it does not copy each line into a std::string; together with the range
+    overloads of the json parser, a record goes from the file buffer to the
+    parser without any per-line copy.
+
+    A line is valid until the next call to next(). Lines longer than the
+    buffer make it grow, so there is no limit on line length. Bulk readers
+    can instead take whole blocks of lines with next_block(), and readers
+    of self-delimiting binary records can take the raw buffered bytes with
+    buffered(), consume() what they decode and read_more() for the rest.
+
+    The bytes can come from any stream buffer instead of a file, such as
+    a CompressedInput (src/victor/compressed_input.hpp) that decompresses
+    the file as it is read.
+
+    @author Victor Chen
+*/
+#ifndef LINE_READER_HPP_
+#define LINE_READER_HPP_
+
+#include <string.h>
+#include <fstream>
+#include <memory>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+namespace victor {
+/**
+	Line Reader
+*/
+class LineReader {
+private:
+	std::unique_ptr<std::streambuf> _input;	// null if the file can't be read
+	std::vector<char> _buf;
+	size_t _begin = 0;	// start of the unread part of _buf
+	size_t _end = 0;	// end of the data in _buf
+	bool _eof = false;	// whether the file has been read to the end
+
+	/**
+		Read more of the file into the buffer. The unread part is moved to
+		the front first, and the buffer grows if the unread part fills it.
+	*/
+	void fill() {
+		if (_begin != 0) {
+			memmove(_buf.data(), _buf.data() + _begin, _end - _begin);
+			_end -= _begin;
+			_begin = 0;
+		}
+		if (_end == _buf.size()) {
+			_buf.resize(_buf.size() * 2);
+		}
+		std::streamsize const n = _input->sgetn(_buf.data() + _end,
+			std::streamsize(_buf.size() - _end));
+		if (n <= 0) {
+			_eof = true;
+		} else {
+			_end += size_t(n);
+		}
+	}
+
+public:
+	/**
+		@param filename file to read.
+		@param chunk_size bytes read from the file at a time.
+	*/
+	explicit LineReader(char const* filename, size_t chunk_size = 1 << 16)
+		: _buf(chunk_size < 1 ? 1 : chunk_size) {
+		std::unique_ptr<std::filebuf> file(new std::filebuf);
+		if (file->open(filename, std::ios::in | std::ios::binary) != nullptr) {
+			_input = std::move(file);
+		}
+		_eof = !_input;
+	}
+
+	/**
+		@param input stream buffer to read, or null for no input.
+		@param chunk_size bytes read from the stream buffer at a time.
+	*/
+	explicit LineReader(std::unique_ptr<std::streambuf> input,
+						size_t chunk_size = 1 << 16)
+		: _input(std::move(input)), _buf(chunk_size < 1 ? 1 : chunk_size) {
+		_eof = !_input;
+	}
+
+	/**
+		Whether the file could be opened.
+
+		@return true if it is open.
+	*/
+	bool is_open() const {
+		return _input != nullptr;
+	}
+
+	/**
+		The stream buffer read from.
+
+		@return the stream buffer, or null if there is none.
+	*/
+	std::streambuf const* input() const {
+		return _input.get();
+	}
+
+	/**
+		Get the next line, without its '\n'. A last line that does not end in
+		'\n' is still returned.
+
+		@param first set to the first character of the line.
+		@param last set to one past the last character of the line.
+		@return false once there are no more lines.
+	*/
+	bool next(char const*& first, char const*& last) {
+		size_t scanned = _begin;	// no '\n' in [_begin, scanned)
+		while (true) {
+			char const* const data = _buf.data();
+			void const* const nl = memchr(data + scanned, '\n', _end - scanned);
+			if (nl != nullptr) {
+				first = data + _begin;
+				last = static_cast<char const*>(nl);
+				_begin = size_t(last - data) + 1;
+				return true;
+			}
+			if (_eof) {
+				if (_begin == _end) {
+					return false;
+				}
+				first = data + _begin;
+				last = data + _end;
+				_begin = _end;
+				return true;
+			}
+			scanned = _end - _begin;
+			fill();
+		}
+	}
+
+	/**
+		Get the next block of whole lines: everything buffered up to and
+		including the last '\n' (or up to the end of the file). Blocks are
+		about the chunk size, so they can be processed in bulk.
+
+		@param first set to the first character of the block.
+		@param last set to one past the last character of the block.
+		@return false once there are no more lines.
+	*/
+	bool next_block(char const*& first, char const*& last) {
+		size_t scanned = _begin;	// no '\n' in [_begin, scanned)
+		while (true) {
+			char const* const data = _buf.data();
+			for (size_t i = _end; i > scanned; --i) {
+				if (data[i - 1] == '\n') {
+					first = data + _begin;
+					last = data + i;
+					_begin = i;
+					return true;
+				}
+			}
+			if (_eof) {
+				if (_begin == _end) {
+					return false;
+				}
+				first = data + _begin;
+				last = data + _end;
+				_begin = _end;
+				return true;
+			}
+			scanned = _end - _begin;
+			fill();
+		}
+	}
+
+	/**
+		Get all the bytes read but not yet consumed, reading some if there
+		are none. They stay valid until the next consume() or read_more().
+
+		@param first set to the first byte.
+		@param last set to one past the last byte.
+		@return false once the file is used up.
+	*/
+	bool buffered(char const*& first, char const*& last) {
+		while (_begin == _end) {
+			if (_eof) {
+				return false;
+			}
+			fill();
+		}
+		first = _buf.data() + _begin;
+		last = _buf.data() + _end;
+		return true;
+	}
+
+	/**
+		Mark bytes returned by buffered() as used.
+
+		@param n number of bytes, from the first one.
+	*/
+	void consume(size_t n) {
+		_begin += n;
+	}
+
+	/**
+		Read more of the file after the bytes not yet consumed, growing the
+		buffer if they fill it.
+
+		@return false if the file is used up.
+	*/
+	bool read_more() {
+		size_t const unread = _end - _begin;
+		while (!_eof && _end - _begin == unread) {
+			fill();
+		}
+		return _end - _begin != unread;
+	}
+};  // class LineReader
+
+}  // namespace victor
+
+#endif  // LINE_READER_HPP_
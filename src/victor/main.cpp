@@ -1,13 +1,127 @@
 #include "victor/med_deg_stream.hpp"
+#include "victor/parallel_replay.hpp"
+#include <stdlib.h>
+#include <string.h>
 #include <iostream>
+#include <string>
+#include <vector>
 
 int main(int argc, char* argv[]) {
-	if (argc != 3) {
+	victor::MedDegStream::Format format = victor::MedDegStream::json;
+	victor::MedDegStream::Output output = victor::MedDegStream::text;
+	victor::MedDegStream::Io io = victor::MedDegStream::posix;
+	char const* metrics = nullptr;
+	char const* state = nullptr;
+	char const* query_socket = nullptr;
+	double metrics_interval = 10;
+	unsigned threads = 1;
+	bool triangles = false;
+	int arg = 1;
+	for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; ++arg) {
+		if (strncmp(argv[arg], "--format=", 9) == 0) {
+			if (!victor::MedDegStream::parse_format(argv[arg] + 9, format)) {
+				std::cout << "Unknown format: " << argv[arg] + 9 << std::endl;
+				return 1;
+			}
+		} else if (strncmp(argv[arg], "--output=", 9) == 0) {
+			if (!victor::MedDegStream::parse_output(argv[arg] + 9, output)) {
+				std::cout << "Unknown output: " << argv[arg] + 9 << std::endl;
+				return 1;
+			}
+		} else if (strncmp(argv[arg], "--io=", 5) == 0) {
+			if (!victor::MedDegStream::parse_io(argv[arg] + 5, io)) {
+				std::cout << "Unknown io: " << argv[arg] + 5 << std::endl;
+				return 1;
+			}
+		} else if (strncmp(argv[arg], "--metrics=", 10) == 0) {
+			metrics = argv[arg] + 10;
+		} else if (strncmp(argv[arg], "--metrics-interval=", 19) == 0) {
+			char* end;
+			metrics_interval = strtod(argv[arg] + 19, &end);
+			if (*end != '\0' || !(metrics_interval > 0)) {
+				std::cout << "Bad interval: " << argv[arg] + 19 << std::endl;
+				return 1;
+			}
+		} else if (strcmp(argv[arg], "--triangles") == 0) {
+			triangles = true;
+		} else if (strncmp(argv[arg], "--state=", 8) == 0) {
+			state = argv[arg] + 8;
+		} else if (strncmp(argv[arg], "--query-socket=", 15) == 0) {
+			query_socket = argv[arg] + 15;
+		} else if (strncmp(argv[arg], "--show-state=", 13) == 0) {
+			// a reader of another run's published state
+			victor::PublishedStateFile file(argv[arg] + 13, false);
+			if (!file.is_open()) {
+				std::cout << file.error() << std::endl;
+				return 1;
+			}
+			victor::GraphState s;
+			if (!file.state()->read(s)) {
+				std::cout << argv[arg] + 13 << " is left in the middle of a write; "
+					"its writer may have died" << std::endl;
+				return 1;
+			}
+			victor::JsonLinesSink<victor::GraphState> sink(std::cout);
+			sink.write(s);
+			sink.flush();
+			return 0;
+		} else if (strncmp(argv[arg], "--threads=", 10) == 0) {
+			char* end;
+			unsigned long const n = strtoul(argv[arg] + 10, &end, 10);
+			if (*end != '\0' || end == argv[arg] + 10 || n > 1024) {
+				std::cout << "Bad thread count: " << argv[arg] + 10 << std::endl;
+				return 1;
+			}
+			threads = unsigned(n);
+		} else {
+			std::cout << "Unknown option: " << argv[arg] << std::endl;
+			return 1;
+		}
+	}
+	if (argc - arg < 2) {
 		std::cout << "Usage:" << std::endl;
-		std::cout << "rolling_median input_filename output_filename" << std::endl;
+		std::cout << "rolling_median [--format=json|msgpack|cbor] "
+			"[--output=text|jsonl] [--io=posix|uring] [--triangles] "
+			"[--metrics=file [--metrics-interval=seconds]] "
+			"[--state=file] [--query-socket=path] [--threads=n] "
+			"input_filename... output_filename"
+			<< std::endl;
+		std::cout << "rolling_median --show-state=file" << std::endl;
+		std::cout << "Inputs may be directories, for the files in them; "
+			"the records of several files are merged by time." << std::endl;
+		return 1;
+	}
+	std::vector<std::string> const inputs = victor::MergedInput::expand(
+		std::vector<std::string>(argv + arg, argv + argc - 1));
+	char const* const output_filename = argv[argc - 1];
+	if (threads != 1) {
+		// offline: the whole file is replayed in parallel time ranges
+		if (format != victor::MedDegStream::json || metrics != nullptr ||
+			state != nullptr || query_socket != nullptr ||
+			io != victor::MedDegStream::posix || inputs.size() != 1) {
+			std::cout << "--threads reads one file of JSON lines, "
+				"without --metrics, --state, --query-socket or --io=uring"
+				<< std::endl;
+			return 1;
+		}
+		victor::ParallelReplay replay(inputs[0].c_str(), output_filename, threads, output);
+		if (triangles) {
+			replay.count_triangles();
+		}
+		return replay.process() ? 0 : 1;
+	}
+	victor::MedDegStream mds(inputs, output_filename, format, output, io);
+	if (triangles) {
+		mds.count_triangles();
+	}
+	if (metrics != nullptr) {
+		mds.export_metrics(metrics, metrics_interval);
+	}
+	if (state != nullptr && !mds.publish_state(state)) {
+		return 1;
+	}
+	if (query_socket != nullptr && !mds.serve_queries(query_socket)) {
 		return 1;
 	}
-	victor::MedDegStream mds(argv[1], argv[2]);
-	mds.process();
-	return 0;
+	return mds.process() ? 0 : 1;
 }
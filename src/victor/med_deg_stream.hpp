@@ -6,122 +6,532 @@
     
     MedDegStream, short for Median Degree Stream, is a class for handling the
     in and out streaming of data. In particular, it has a file handle for both
-    the input file to be processed and an output file. It also has a VenmoGraph
-    (defined in src/victor/venmo_graph.hpp) which holds the vertices and edges
-    of the Venmo payment graph.
+    the input file to be processed and an output file. The payments read are
+    pushed into a RollingMedian (defined in src/victor/rolling_median.hpp),
+    whose VenmoGraph holds the vertices and edges of the Venmo payment graph.
     
-    When the data from the input stream is malformed, MedDegStream will skip
-    that input.
+    Input is read in blocks of lines by a LineReader
+    (src/victor/line_reader.hpp). Each block is indexed by a StructuralIndex
+    (src/victor/structural_index.hpp), and each line is then walked through
+    the index by a VenmoRecordReader (src/victor/venmo_record.hpp), which
+    pulls out the actor, target and created_time without building a json
+    object. When the data from the input stream is malformed,
+    MedDegStream will skip that input.
+
+    Several input files are merged by created_time as they are read, by a
+    MergedInput (src/victor/merged_input.hpp), each file parsed ahead on a
+    thread of its own.
+
+    The input may instead be a stream of MessagePack or CBOR maps, which
+    are decoded record by record by a BinaryRecordReader
+    (src/victor/binary_record.hpp) straight from the reader's buffer. A
+    corrupt binary stream can't be resynchronized, so processing stops
+    there.
+
+    Compressed input (gzip, or zstd in a build with VICTOR_ZSTD) is
+    recognized by its first bytes and decompressed on other threads by a
+    CompressedInput (src/victor/compressed_input.hpp) while it is parsed.
+
+    Output goes through a sink (src/victor/output_sink.hpp): by default
+    the median alone, one per line, or else one JSON object per line with
+    the time, the median and the number of active vertices and edges.
+    Either may also have the number of triangles in the window (see
+    src/victor/triangle_counter.hpp).
+
+    In a build with VICTOR_INSTRUMENT, each stage of the way is timed (see
+    src/victor/instrument.hpp). Counters of what the graph and its heaps
+    do are always kept, and can be written every so often to a file in
+    the Prometheus text format (see src/victor/metrics.hpp). The graph's
+    state after each payment can also be published to a file mapped into
+    memory, for other processes to read (see
+    src/victor/published_state.hpp), and queries about it answered on a
+    Unix domain socket, between records (see src/victor/query_server.hpp).
 
     @author Victor Chen
 */
 #ifndef MED_DEG_STREAM_HPP_
 #define MED_DEG_STREAM_HPP_
 
+#include "victor/rolling_median.hpp"
 #include "victor/venmo_graph.hpp"
-#include "json/json.hpp"
-#include <stdio.h>
+#include "victor/venmo_record.hpp"
+#include "victor/binary_record.hpp"
+#include "victor/line_reader.hpp"
+#include "victor/compressed_input.hpp"
+#include "victor/output_sink.hpp"
+#include "victor/instrument.hpp"
+#include "victor/metrics.hpp"
+#include "victor/merged_input.hpp"
+#include "victor/published_state.hpp"
+#include "victor/query_server.hpp"
+#include <stdint.h>
+#include <string.h>
 #include <fstream>
+#include <memory>
 #include <string>
-#include <ios>
+#include <vector>
 
 #include <iostream>
 using std::cout;
 using std::endl;
 
 
-using json = nlohmann::json;  // for convenience
-
 namespace victor {
 
 class MedDegStream {
+public:
+	/**
+		Encoding of the input file.
+	*/
+	enum Format {
+		json,		// one JSON object per line
+		msgpack,	// a stream of MessagePack maps
+		cbor		// a sequence of CBOR maps
+	};
+
+	/**
+		What is written for each payment.
+	*/
+	enum Output {
+		text,		// the median, with two decimals
+		json_lines	// a JSON object with the median and the graph's size
+	};
+
+	/**
+		How the input and output files are read and written.
+	*/
+	enum Io {
+		posix,		// std::filebuf: read() and write()
+		uring		// io_uring, several large reads and writes in flight
+	};
+
 private:
-	VenmoGraph _graph;
-	std::ifstream _ifs;
-	std::ofstream _ofs;
+	RollingMedian _rolling;
+	LineReader _lines;
+	std::vector<std::string> _in_filenames;
+	std::string _out_filename;
+	std::unique_ptr<std::streambuf> _out_buf;
+	std::ostream _ofs;			// writes to _out_buf
+	Format _format;
+	Output _output;
+	uint64_t _records = 0;		// read, skipped ones included
+	uint64_t _skipped = 0;
+	std::unique_ptr<MetricsFile> _metrics;
+	bool _metrics_failed = false;
+	std::unique_ptr<PublishedStateFile> _state;
+	std::unique_ptr<QueryServer> _queries;
 
-public:
-	MedDegStream(char const* in_filename, char const* out_filename) {
-		_ifs.open(in_filename, std::ifstream::in);
-		_ofs.open(out_filename, std::ofstream::out);
-		_ofs.setf(std::ios::fixed, std::ios::floatfield);
-		_ofs.precision(2);
-	}
-
-	void process() {
-		json j;
-		json::const_iterator it_actor;
-		json::const_iterator it_target;
-		json::const_iterator it_created_time;
-		json::const_iterator end;
-		tm dt;
-		
-		std::string line;
-		while (std::getline(_ifs, line)) {
-			j = json::parse(line);
-			
-			// skip a line if it has any malformed or missing
-			// field
-			end = j.cend();
-			it_actor = j.find("actor");
-			std::string actor;
-			if (it_actor == end) {
-				cout << "missing actor" << endl;
-				continue;
-			} else {
-				actor = *it_actor;
-				if (actor.empty()) {
-					cout << "empty actor" << endl;
-					continue;
-				}
-			}
+	void write_metrics() {
+		if (!_metrics->write(metrics()) && !_metrics_failed) {
+			cout << "cannot write metrics to " << _metrics->filename() << endl;
+			_metrics_failed = true;
+		}
+	}
 
-			it_target = j.find("target");
-			std::string target;
-			if (it_target == end) {
-				cout << "missing target" << endl;
-				continue;
-			} else {
-				target = *it_target;
-				if (target.empty()) {
-					cout << "empty target" << endl;
-					continue;
-				}
+	/**
+		Add a record to the graph and write the new median, or report why
+		it is skipped.
+
+		@param sink where to write the median.
+		@param status outcome of reading the record.
+		@param rec the record.
+	*/
+	template <typename Sink>
+	void handle(Sink& sink, VenmoRecordReader::Status status,
+				VenmoRecord const& rec) {
+		// the clock is only read every 1024 records
+		if ((++_records & 1023) == 0 && _metrics && _metrics->due()) {
+			write_metrics();
+		}
+		// queries see the graph as of the record before
+		if (_queries) {
+			_queries->answer(_rolling.graph());
+		}
+		// skip a record if it is malformed or has any malformed or missing
+		// field
+		if (status != VenmoRecordReader::ok) {
+			cout << VenmoRecordReader::describe(status) << endl;
+			++_skipped;
+			return;
+		}
+		_rolling.push(rec.actor, rec.target, rec.created_time, sink);
+	}
+
+	template <typename Sink>
+	void process_json(Sink& sink) {
+		VenmoRecordReader reader;
+		VenmoRecord rec;
+
+		StructuralIndex index;
+
+		char const* block;
+		char const* block_end;
+		while (VICTOR_TIMED(read, _lines.next_block(block, block_end))) {
+			VICTOR_POLL();
+			VICTOR_TIMED(index, index.build(block, block_end));
+			char const* first;
+			char const* last;
+			uint32_t const* pos;
+			uint32_t const* pos_end;
+			while (index.next_line(first, last, pos, pos_end)) {
+				handle(sink, VICTOR_TIMED(parse, reader.read(first, last, block,
+					pos, pos_end, rec)), rec);
 			}
+		}
+	}
+
+	/**
+		@return false, with a message, if the input is corrupt or ends in
+		the middle of a record.
+	*/
+	template <typename Sink>
+	bool process_binary(Sink& sink, BinaryRecordReader::Format format) {
+		BinaryRecordReader reader(format);
+		VenmoRecord rec;
+		VenmoRecordReader::Status status;
 
-			it_created_time = j.find("created_time");
-			std::string time_str;
-			if (it_created_time == end) {
-				cout << "missing created_time" << endl;
-				continue;
-			} else {
-				time_str = *it_created_time;
-				if (time_str.empty()) {
-					cout << "empty created_time" << endl;
-					continue;
+		char const* first;
+		char const* last;
+		while (VICTOR_TIMED(read, _lines.buffered(first, last))) {
+			VICTOR_POLL();
+			// decode every whole record buffered; records are framed by
+			// their encoding, so the next one starts where this one ends
+			char const* p = first;
+			char const* next;
+			BinaryRecordReader::Framing framing;
+			while ((framing = VICTOR_TIMED(parse, reader.read(p, last, next, rec,
+					status))) == BinaryRecordReader::framed) {
+				handle(sink, status, rec);
+				p = next;
+			}
+			_lines.consume(size_t(p - first));
+			if (framing == BinaryRecordReader::corrupt) {
+				cout << "corrupt input" << endl;
+				return false;
+			}
+			if (!VICTOR_TIMED(read, _lines.read_more())) {
+				if (p != last) {
+					cout << "truncated record" << endl;
+					return false;
 				}
+				return true;
 			}
+		}
+		return true;
+	}
+
+	/**
+		Merge the records of several files by time, and process them.
+
+		@return false, with a message, if a file couldn't all be read.
+	*/
+	template <typename Sink>
+	bool process_merged(Sink& sink) {
+		MergedInput merged(_in_filenames, _format != json,
+			_format == cbor ? BinaryRecordReader::cbor : BinaryRecordReader::msgpack);
+		VenmoRecordReader::Status status;
+		VenmoRecord const* rec;
+		while (VICTOR_TIMED(read, merged.next(status, rec))) {
+			VICTOR_POLL();
+			handle(sink, status, *rec);
+		}
+		for (std::string const& error : merged.errors()) {
+			cout << error << endl;
+		}
+		return merged.errors().empty();
+	}
+
+	/**
+		@return what cut the input short, or "" if nothing did.
+	*/
+	std::string input_error() const {
+		std::streambuf const* const in = _lines.input();
+		CompressedInput const* const compressed =
+			dynamic_cast<CompressedInput const*>(in);
+		if (compressed != nullptr) {
+			return compressed->error();
+		}
+		UringInput const* const uring = dynamic_cast<UringInput const*>(in);
+		return uring != nullptr ? uring->error() : std::string();
+	}
 
-			int num_matched = sscanf(time_str.c_str(), "%4d-%2d-%2dT%2d:%2d:%2dZ",
-				&dt.tm_year, &dt.tm_mon, &dt.tm_mday, &dt.tm_hour,
-				&dt.tm_min, &dt.tm_sec);
+	/**
+		Open the output file; through io_uring if asked, and if it can be
+		used.
 
-			if (num_matched != 6) {
-				cout << "bad created_time 2" << endl;
-				continue;
+		@return the stream buffer, or null if the file can't be created.
+	*/
+	static std::unique_ptr<std::streambuf> open_output(char const* filename, Io io) {
+		if (io == uring) {
+			std::unique_ptr<std::streambuf> out = UringOutput::open(filename);
+			if (out) {
+				return out;
 			}
-			// tm_year is relative to 1900
-			// tm_mon starts at 0, ends at 11
-			dt.tm_year -= 1900;
-			--dt.tm_mon;
-			time_t created_time = mktime(&dt);
-			
-			double current_median = _graph.extract_median(std::move(actor),
-				std::move(target),
-				created_time);
-			_ofs << current_median << '\n';
+		}
+		std::unique_ptr<std::filebuf> file(new std::filebuf);
+		if (file->open(filename, std::ios::out | std::ios::trunc) == nullptr) {
+			return nullptr;
+		}
+		return std::unique_ptr<std::streambuf>(file.release());
+	}
+
+public:
+	/**
+		@param in_filename file to read records from.
+		@param out_filename file to write medians to.
+		@param format encoding of the input file.
+		@param output what to write for each payment.
+		@param io how the files are read and written.
+	*/
+	MedDegStream(char const* in_filename, char const* out_filename,
+				 Format format = json, Output output = text, Io io = posix)
+		: _lines(CompressedInput::open(in_filename, 1 << 20, io == uring)),
+		  _in_filenames(1, in_filename), _out_filename(out_filename), _out_buf(open_output(out_filename, io)),
+		  _ofs(_out_buf.get()),
+		  _format(format), _output(output) {}
+
+	/**
+		@param in_filenames files to read records from; records of several
+			files are merged by time, each file read ahead on a thread of
+			its own.
+		@param out_filename file to write medians to.
+		@param format encoding of the input files.
+		@param output what to write for each payment.
+		@param io how the files are read and written; several files are
+			read ahead with std::filebuf.
+	*/
+	MedDegStream(std::vector<std::string> const& in_filenames,
+				 char const* out_filename, Format format = json, Output output = text,
+				 Io io = posix)
+		: _lines(in_filenames.size() == 1
+			  ? CompressedInput::open(in_filenames[0].c_str(), 1 << 20, io == uring)
+			  : nullptr),
+		  _in_filenames(in_filenames), _out_filename(out_filename),
+		  _out_buf(open_output(out_filename, io)), _ofs(_out_buf.get()),
+		  _format(format), _output(output) {}
+
+	/**
+		Process the input, writing to the output file.
+
+		@return false, with a message, if the input was cut short by an
+		error or the output couldn't all be written.
+	*/
+	bool process() {
+		bool read;
+		if (_output == text) {
+			TextSink sink(_ofs);
+			read = process(sink);
+		} else {
+			JsonLinesSink<MedianEvent> sink(_ofs);
+			read = process(sink);
 		}
 		_ofs.flush();
+		UringOutput const* const uring =
+			dynamic_cast<UringOutput const*>(_out_buf.get());
+		if (uring != nullptr && !uring->error().empty()) {
+			cout << uring->error() << " (" << _out_filename << ")" << endl;
+			return false;
+		}
+		if (!_ofs) {
+			cout << "cannot write " << _out_filename << endl;
+			return false;
+		}
+		return read;
+	}
+
+	/**
+		Process the input, writing to a sink of one's own.
+
+		@param sink anything with write(MedianEvent const&) and flush().
+		@return false, with a message, if the input couldn't be opened or
+		was cut short by an error.
+	*/
+	template <typename Sink>
+	bool process(Sink& sink) {
+		bool read = true;
+		if (_in_filenames.size() > 1) {
+			read = process_merged(sink);
+		} else if (!_in_filenames.empty() && _lines.input() == nullptr) {
+			cout << "cannot read " << _in_filenames[0] << endl;
+			read = false;
+		} else {
+			switch (_format) {
+			case json: process_json(sink); break;
+			case msgpack: read = process_binary(sink, BinaryRecordReader::msgpack); break;
+			case cbor: read = process_binary(sink, BinaryRecordReader::cbor); break;
+			}
+		}
+		sink.flush();
+		std::string const error = input_error();
+		if (!error.empty()) {
+			cout << error << endl;
+			read = false;
+		}
+		if (_metrics) {
+			write_metrics();
+		}
+		// answer whatever is still waiting
+		if (_queries) {
+			_queries->answer(_rolling.graph(), size_t(-1));
+		}
+		return read;
+	}
+
+	/**
+		Count the triangles in the window, and write their number with
+		each median.
+	*/
+	void count_triangles() {
+		_rolling.count_triangles();
+	}
+
+	/**
+		Write metrics to a file while processing, and once done.
+
+		@param filename file to write them to; it is replaced each time.
+		@param interval_seconds time between writes.
+	*/
+	void export_metrics(char const* filename, double interval_seconds = 10) {
+		_metrics.reset(new MetricsFile(filename, interval_seconds));
+	}
+
+	/**
+		Publish the graph's state after every payment to a file mapped into
+		memory, for other processes to read while processing (see
+		src/victor/published_state.hpp).
+
+		@param filename file to map; created if need be.
+		@return false, with a message, if the file can't be mapped.
+	*/
+	bool publish_state(char const* filename) {
+		_state.reset(new PublishedStateFile(filename, true));
+		if (!_state->is_open()) {
+			cout << _state->error() << endl;
+			_state.reset();
+			return false;
+		}
+		_rolling.publish_to(_state->state());
+		return true;
+	}
+
+	/**
+		Answer queries about the graph on a Unix domain socket while
+		processing (see src/victor/query_server.hpp).
+
+		@param path the socket's path.
+		@return false, with a message, if the socket can't be served.
+	*/
+	bool serve_queries(char const* path) {
+		_queries.reset(new QueryServer(path));
+		if (!_queries->is_open()) {
+			cout << _queries->error() << endl;
+			_queries.reset();
+			return false;
+		}
+		_rolling.index_counterparties();
+		return true;
+	}
+
+	/**
+		@return the counters of the stream, the graph and its heaps, in the
+		Prometheus text format.
+	*/
+	std::string metrics() const {
+		VenmoGraph const& graph = _rolling.graph();
+		VenmoGraph::Counters const& g = graph.counters();
+		MedHeapMap::Counters const& h = graph.vertices().counters();
+		PrometheusText t;
+		t.counter("rolling_median_records_total",
+				  "Records read, skipped ones included.", _records);
+		t.counter("rolling_median_records_skipped_total",
+				  "Records skipped for being malformed.", _skipped);
+		t.counter("rolling_median_edges_inserted_total",
+				  "Edges added to the graph.", g.edges_inserted);
+		t.counter("rolling_median_edges_updated_total",
+				  "Payments on an edge already in the window.", g.edges_updated);
+		t.counter("rolling_median_edges_expired_total",
+				  "Edges dropped out of the window.", g.edges_expired);
+		t.counter("rolling_median_late_total",
+				  "Payments older than the latest, but in the window.", g.late);
+		t.counter("rolling_median_dropped_total",
+				  "Payments too old for the window.", g.dropped);
+		t.counter("rolling_median_self_payments_total",
+				  "Payments to oneself, which add no edge.", g.self_payments);
+		t.counter("rolling_median_heap_rotations_total",
+				  "Nodes moved between the halves of the median heap.", h.rotations);
+		t.counter("rolling_median_heap_swaps_total",
+				  "Nodes swapped within a half of the median heap.", h.swaps);
+		t.counter("rolling_median_vertices_erased_total",
+				  "Vertices erased at degree 0.", h.erased);
+		t.gauge("rolling_median_vertices",
+				"Vertices in the graph.", uint64_t(graph.num_vertices()));
+		t.gauge("rolling_median_edges",
+				"Edges in the graph.", uint64_t(graph.num_edges()));
+		t.gauge("rolling_median_peak_vertices",
+				"Most vertices in the graph at once.", h.peak_size);
+		t.gauge("rolling_median_peak_edges",
+				"Most edges in the graph at once.", g.peak_edges);
+		t.gauge("rolling_median_median",
+				"The latest median degree.", _rolling.median());
+		if (graph.counts_triangles()) {
+			t.gauge("rolling_median_triangles",
+					"Triangles in the graph.", graph.triangles());
+		}
+		return t.str();
+	}
+
+	/**
+		Parse the name of an input format, as given on the command line.
+
+		@param name "json", "msgpack" or "cbor".
+		@param format set to the format named.
+		@return false if name is none of them.
+	*/
+	static bool parse_format(char const* name, Format& format) {
+		static char const* const names[] = { "json", "msgpack", "cbor" };
+		for (int f = json; f <= cbor; ++f) {
+			if (strcmp(name, names[f]) == 0) {
+				format = Format(f);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+		Parse the name of a way of doing I/O, as given on the command line.
+
+		@param name "posix" or "uring".
+		@param io set to the way named.
+		@return false if name is neither.
+	*/
+	static bool parse_io(char const* name, Io& io) {
+		static char const* const names[] = { "posix", "uring" };
+		for (int i = posix; i <= uring; ++i) {
+			if (strcmp(name, names[i]) == 0) {
+				io = Io(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+		Parse the name of an output format, as given on the command line.
+
+		@param name "text" or "jsonl".
+		@param output set to the output named.
+		@return false if name is neither.
+	*/
+	static bool parse_output(char const* name, Output& output) {
+		static char const* const names[] = { "text", "jsonl" };
+		for (int o = text; o <= json_lines; ++o) {
+			if (strcmp(name, names[o]) == 0) {
+				output = Output(o);
+				return true;
+			}
+		}
+		return false;
 	}
 };  // class MedDegStream
 
@@ -30,22 +30,38 @@
 	popped and pushed into the other heap.
     
     MedHeapMap also consists of a forward and backward index which map between
-    the Venmo vertex name and its corresponding location in the Median Heap Map
-    data structure, and vice versa. These maps are used to locate nodes in the
-    heap map at O(1) time, since these are frequently used operations. Everytime
-    the heaps are heapified (i.e. modified to maintain the heap property) or
-    balanced, the corresponding locations stored in the indexes are modified
-    accordingly.
+    a vertex and its corresponding location in the Median Heap Map data
+    structure, and vice versa. Vertices are identified by integer ids handed
+    out by a NameTable (defined in src/victor/name_table.hpp), so the forward
+    index is a vector indexed by id and the backward index is simply the id
+    stored next to the degree in each heap node. These indexes are used to
+    locate nodes in the heap map at O(1) time, since these are frequently used
+    operations. Everytime the heaps are heapified (i.e. modified to maintain
+    the heap property) or balanced, the corresponding locations stored in the
+    indexes are modified accordingly.
+
+    When a vertex is erased (its degree drops to 0), its id is released back
+    to the NameTable for reuse, so memory is bounded by the live vertices.
+
+    How many vertices have each degree is also counted, in a Fenwick tree
+    indexed by degree, so any quantile of the degrees is found in
+    O(log max degree) time; each change of a degree updates it in the same
+    time.
 
     @author Victor Chen
 */
 #ifndef MED_HEAP_MAP_HPP_
 #define MED_HEAP_MAP_HPP_
 
+#include "victor/name_table.hpp"
+#include <stdint.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
 #include <vector>
-#include <unordered_map>
 #include <string>
 #include <sstream>
+#include <utility>
 
 // #include <iostream>
 // using std::cout;
@@ -67,57 +83,137 @@ namespace victor {
 	Median Heap Map
 */
 class MedHeapMap {
+public:
+	typedef NameTable::Id Id;
+
+	static Id const npos = NameTable::npos;
+
+	/**
+		What the heap map has done since it was made. Always counted; they
+		cost an increment each.
+	*/
+	struct Counters {
+		uint64_t rotations = 0;		// nodes moved from one half to the other
+		uint64_t swaps = 0;			// calls of swap_nodes()
+		uint64_t erased = 0;		// vertices erased at degree 0
+		uint64_t peak_size = 0;		// most vertices at once
+	};
+
 private:
 	/**
 		Information about which heap and where in the heap and element is
-		stored. This is the value stored in the forward map.
+		stored. This is the value stored in the forward index.
 	*/
 	struct FInfo {
-		size_t ind;
+		uint32_t ind;
 		bool in_gh;
 	};
-	
+
 	/**
-		Information about which vertex name a heap element corresponds to.
-		This is the value stored in the backwards map.
+		Heap node. The id is the backward index: it tells which vertex a heap
+		element corresponds to.
 	*/
-	struct BInfo {
-		std::string g_key;
-		std::string l_key;
+	struct Node {
+		uint32_t degree;
+		Id id;
 	};
 
-	std::vector<uint32_t> _lh;						// less-half max-heap
-	std::vector<uint32_t> _gh;						// greater-half min-heap
-	std::unordered_map<std::string, FInfo> _fmap;	// name -> heap location
-													// forward map
-	std::unordered_map<size_t, BInfo> _bmap;		// heap location -> name
-													// backward map
+	std::vector<Node> _lh;			// less-half max-heap
+	std::vector<Node> _gh;			// greater-half min-heap
+	std::vector<FInfo> _fmap;		// id -> heap location
+									// forward index
+	NameTable _names;				// name <-> id
+	std::vector<uint32_t> _degree_counts = std::vector<uint32_t>(2);
+									// Fenwick tree: degree -> how many
+									// elements have it; [0] is unused
+	Counters _counters;
+
+	/**
+		Make the Fenwick tree of degree counts span a degree. It spans a
+		power of two of degrees, so doubling it only needs its new root:
+		everything below the old root, and nothing above it.
+
+		@param degree the degree.
+		@return the degrees spanned.
+	*/
+	size_t span_degree(uint32_t degree) {
+		size_t n = _degree_counts.size() - 1;
+		while (degree > n) {
+			_degree_counts.resize(2 * n + 1);
+			_degree_counts[2 * n] = _degree_counts[n];
+			n *= 2;
+		}
+		return n;
+	}
+
+	/**
+		Count one more element with a degree.
+
+		@param degree the degree, at least 1.
+	*/
+	void count_degree(uint32_t degree) {
+		size_t const n = span_degree(degree);
+		for (size_t i = degree; i <= n; i += i & (~i + 1)) {
+			++_degree_counts[i];
+		}
+	}
+
+	/**
+		Count one fewer element with a degree.
+
+		@param degree the degree, at least 1.
+	*/
+	void uncount_degree(uint32_t degree) {
+		size_t const n = _degree_counts.size() - 1;
+		for (size_t i = degree; i <= n; i += i & (~i + 1)) {
+			--_degree_counts[i];
+		}
+	}
+
+	/**
+		Count an element's degree as changed by one. The tree nodes above
+		both degrees count the element either way, so the two update paths
+		are walked only until they meet, which for small degrees is at
+		once.
+
+		@param from the old degree, at least 1.
+		@param to the new degree, from - 1 or from + 1, at least 1.
+	*/
+	void recount_degree(uint32_t from, uint32_t to) {
+		span_degree(to);
+		size_t i = from;
+		size_t j = to;
+		// both paths end at the root, so they meet
+		while (i != j) {
+			if (i < j) {
+				--_degree_counts[i];
+				i += i & (~i + 1);
+			} else {
+				++_degree_counts[j];
+				j += j & (~j + 1);
+			}
+		}
+	}
 
 	/**
-	    Swap elements in a heap, forward map, and backward map.
+	    Swap elements in a heap and update the forward index.
 	
 	    @param i
 	    @param j
 	    @param in_gh whether or not the elements are in _gh.
 	*/
 	void swap_nodes(size_t i, size_t j, bool in_gh) {
-		std::vector<uint32_t>& vec = in_gh ? _gh : _lh;
+		std::vector<Node>& vec = in_gh ? _gh : _lh;
+		++_counters.swaps;
 
-		// swap degrees in the heap
-		uint32_t t = vec[i];
+		// swap nodes in the heap
+		Node t = vec[i];
 		vec[i] = vec[j];
 		vec[j] = t;
 
-		// swap corresponding elements in _fmap & _bmap
-		if (in_gh) {
-			_bmap[i].g_key.swap(_bmap[j].g_key);
-			_fmap[_bmap[j].g_key].ind = j;
-			_fmap[_bmap[i].g_key].ind = i;
-		} else {
-			_bmap[i].l_key.swap(_bmap[j].l_key);
-			_fmap[_bmap[j].l_key].ind = j;
-			_fmap[_bmap[i].l_key].ind = i;
-		}
+		// update corresponding elements in _fmap
+		_fmap[vec[i].id].ind = uint32_t(i);
+		_fmap[vec[j].id].ind = uint32_t(j);
 	}
 	
 	/**
@@ -127,12 +223,12 @@ private:
 		@param in_gh whether or not the elements are in _gh.
 	*/
 	void float_up(size_t i, bool in_gh) {
-		std::vector<uint32_t>& vec = in_gh ? _gh : _lh;
+		std::vector<Node>& vec = in_gh ? _gh : _lh;
 
 		// move the element in vec up the binary tree
 		size_t j = ANC(i);
-		while (i != 0 && ((in_gh && vec[i] < vec[j]) ||
-						  (!in_gh && vec[i] > vec[j]))) {
+		while (i != 0 && ((in_gh && vec[i].degree < vec[j].degree) ||
+						  (!in_gh && vec[i].degree > vec[j].degree))) {
 			swap_nodes(i, j, in_gh);
 			i = j;
 			j = ANC(i);
@@ -146,7 +242,7 @@ private:
 		@param in_gh whether or not the elements are in _gh.
 	*/
 	void sink_down(size_t i, bool in_gh) {
-		std::vector<uint32_t>& vec = in_gh ? _gh : _lh;
+		std::vector<Node>& vec = in_gh ? _gh : _lh;
 
 		// move the element in vec down the binary tree
 		size_t j = DES1(i);
@@ -156,22 +252,22 @@ private:
 			if (j >= n) {  // j & k are out of bounds
 				return;
 			} else if (k >= n) {  // only k is out of bounds
-				if ((in_gh && vec[j] < vec[i]) ||
-					  (!in_gh && vec[j] > vec[i])) {
+				if ((in_gh && vec[j].degree < vec[i].degree) ||
+					  (!in_gh && vec[j].degree > vec[i].degree)) {
 					swap_nodes(i, j, in_gh);
 					return;
 				}
 				return;
 			} else {  // both j & k are not out of bounds
 				size_t z;
-				if ((in_gh && vec[j] < vec[k]) ||
-					  (!in_gh && vec[j] > vec[k])) {
+				if ((in_gh && vec[j].degree < vec[k].degree) ||
+					  (!in_gh && vec[j].degree > vec[k].degree)) {
 					z = j;
 				} else {
 					z = k;
 				}
-				if ((in_gh && vec[z] < vec[i]) ||
-					  (!in_gh && vec[z] > vec[i])) {
+				if ((in_gh && vec[z].degree < vec[i].degree) ||
+					  (!in_gh && vec[z].degree > vec[i].degree)) {
 					swap_nodes(i, z, in_gh);
 				} else {
 					return;
@@ -193,87 +289,91 @@ private:
 		@param into_gh whether or not to rotate into _gh.
 	*/
 	void rotate(bool into_gh) {
-		if (into_gh) {
-			uint32_t degree = _lh.front();
-			swap_nodes(0, _lh.size() - 1, false);
-			_lh.pop_back();
-			_gh.emplace_back(degree);
-
-			std::unordered_map<size_t, BInfo>::iterator it =
-				_bmap.find(_lh.size());
-			std::string name = std::move((it->second).l_key);
-			FInfo& info = _fmap[name];
-			info.ind = _gh.size() - 1;
-			info.in_gh = true;
-			_bmap[_gh.size() - 1].g_key = std::move(name);
-			if ((it->second).g_key.empty()) {
-				_bmap.erase(it);
-			}
+		std::vector<Node>& from = into_gh ? _lh : _gh;
+		std::vector<Node>& into = into_gh ? _gh : _lh;
+		++_counters.rotations;
 
-			sink_down(0, false);
-			float_up(_gh.size() - 1, true);
-		} else {
-			uint32_t degree = _gh.front();
-			swap_nodes(0, _gh.size() - 1, true);
-			_gh.pop_back();
-			_lh.emplace_back(degree);
-
-			std::unordered_map<size_t, BInfo>::iterator it =
-				_bmap.find(_gh.size());
-			std::string name = std::move((it->second).g_key);
-			FInfo& info = _fmap[name];
-			info.ind = _lh.size() - 1;
-			info.in_gh = false;
-			_bmap[_lh.size() - 1].l_key = std::move(name);
-			if ((it->second).l_key.empty()) {
-				_bmap.erase(it);
-			}
+		Node const node = from.front();
+		swap_nodes(0, from.size() - 1, !into_gh);
+		from.pop_back();
+		into.emplace_back(node);
 
-			sink_down(0, true);
-			float_up(_lh.size() - 1, false);
-		}
-	}
+		FInfo& info = _fmap[node.id];
+		info.ind = uint32_t(into.size() - 1);
+		info.in_gh = into_gh;
 
+		sink_down(0, !into_gh);
+		float_up(into.size() - 1, into_gh);
+	}
 
 	/**
-		Erase an element from the heap. Make sure to rotate to fix
-		median heap invariance.
-		
-		@param i index of element in heap.
-		@param in_gh whether or not the elements are in _gh.
+		Insert a vertex into the heap with degree 1. Make sure to sink/float
+		and rotate to maintain invariance.
+
+		@param id id of the vertex to be inserted.
 	*/
-	void erase(size_t i, bool in_gh) {
-		if (in_gh) {
-			swap_nodes(i, _gh.size() - 1, true);
-			_gh.pop_back();
-			std::unordered_map<size_t, BInfo>::iterator it =
-				_bmap.find(_gh.size());
-			std::string name = std::move((it->second).g_key);
-			_fmap.erase(std::move(name));
-			if ((it->second).l_key.empty()) {
-				_bmap.erase(it);
-			}
-			sink_down(i, true);
+	void insert(Id id) {
+		if (id >= _fmap.size()) {
+			_fmap.resize(size_t(id) + 1);
+		}
+		if (_lh.size() + _gh.size() + 1 > _counters.peak_size) {
+			_counters.peak_size = _lh.size() + _gh.size() + 1;
+		}
+
+		count_degree(1);
+
+		// insert into either the lessor or greater half
+		if (!_lh.empty() && 1 < _lh.front().degree) {
+			Node const node = { 1, id };
+			_lh.emplace_back(node);
+			_fmap[id].ind = uint32_t(_lh.size() - 1);
+			_fmap[id].in_gh = false;
+			float_up(_lh.size() - 1, false);
 			if (_lh.size() == _gh.size() + 2) {
 				rotate(true);
 			}
 		} else {
-			swap_nodes(i, _lh.size() - 1, false);
-			_lh.pop_back();
-			std::unordered_map<size_t, BInfo>::iterator it =
-				_bmap.find(_lh.size());
-			std::string name = std::move((it->second).l_key);
-			_fmap.erase(std::move(name));
-			if ((it->second).g_key.empty()) {
-				_bmap.erase(it);
-			}
-			sink_down(i, false);
+			Node const node = { 1, id };
+			_gh.emplace_back(node);
+			_fmap[id].ind = uint32_t(_gh.size() - 1);
+			_fmap[id].in_gh = true;
+			float_up(_gh.size() - 1, true);
 			if (_gh.size() == _lh.size() + 2) {
 				rotate(false);
 			}
 		}
 	}
 
+	/**
+		Erase an element from the heap and release its id. Make sure to
+		rotate to fix median heap invariance.
+		
+		@param i index of element in heap.
+		@param in_gh whether or not the elements are in _gh.
+	*/
+	void erase(size_t i, bool in_gh) {
+		std::vector<Node>& vec = in_gh ? _gh : _lh;
+		uncount_degree(vec[i].degree);
+		swap_nodes(i, vec.size() - 1, in_gh);
+		Id const id = vec.back().id;
+		vec.pop_back();
+		_names.release(id);
+		++_counters.erased;
+
+		// the last element took the erased element's place; it may belong
+		// either further down or further up
+		if (i < vec.size()) {
+			Id const moved = vec[i].id;
+			sink_down(i, in_gh);
+			float_up(_fmap[moved].ind, in_gh);
+		}
+		if (_lh.size() == _gh.size() + 2) {
+			rotate(true);
+		} else if (_gh.size() == _lh.size() + 2) {
+			rotate(false);
+		}
+	}
+
 	/**
 		Increment the value of an element in the heap. Make sure to sink/float
 		and rotate to maintain invariance.
@@ -282,13 +382,15 @@ private:
 		@param in_gh whether or not the elements are in _gh.
 	*/
 	void increase_key(size_t i, bool in_gh) {
+		uint32_t const degree = (in_gh ? _gh : _lh)[i].degree;
+		recount_degree(degree, degree + 1);
 		if (in_gh) {
-			++(_gh[i]);
+			++(_gh[i].degree);
 			sink_down(i, true);
 		} else {
-			++(_lh[i]);
+			++(_lh[i].degree);
 			float_up(i, false);
-			if (_lh.front() > _gh.front()) {
+			if (!_gh.empty() && _lh.front().degree > _gh.front().degree) {
 				ssize_t const size_diff = ssize_t(_lh.size()) -
 										  ssize_t(_gh.size());
 				if (size_diff == 0) {
@@ -312,10 +414,12 @@ private:
 		@param in_gh whether or not the elements are in _gh.
 	*/
 	void decrease_key(size_t i, bool in_gh) {
+		uint32_t const degree = (in_gh ? _gh : _lh)[i].degree;
+		recount_degree(degree, degree - 1);
 		if (in_gh) {
-			--(_gh[i]);
+			--(_gh[i].degree);
 			float_up(i, true);
-			if (_lh.front() > _gh.front()) {
+			if (!_lh.empty() && _lh.front().degree > _gh.front().degree) {
 				ssize_t const size_diff = ssize_t(_lh.size()) -
 										  ssize_t(_gh.size());
 				if (size_diff == 0) {
@@ -329,7 +433,7 @@ private:
 				}
 			}
 		} else {
-			--(_lh[i]);
+			--(_lh[i].degree);
 			sink_down(i, false);
 		}
 	}
@@ -341,48 +445,23 @@ public:
 		
 		@param name name of the element to be inserted.
 	*/
-	void insert(std::string name) {
-		// prepare the heaps if they are empty
-		if (empty()) {
-			_gh.emplace_back(1);
-			_fmap[name] = { _gh.size() - 1, true };
-			_bmap[_gh.size() - 1].g_key = std::move(name);
-			return;
-		} else if (size() == 1) {
-			_lh.emplace_back(1);
-			_fmap[name] = { _lh.size() - 1, false };
-			_bmap[_lh.size() - 1].l_key = std::move(name);
-			return;
-		}
-
-		// insert into either the lessor or greater half
-		if (1 < _lh.front()) {
-			_lh.emplace_back(1);
-			_fmap[name] = { _lh.size() - 1, false };
-			_bmap[_lh.size() - 1].l_key = std::move(name);
-			float_up(_lh.size() - 1, false);
-			if (_lh.size() == _gh.size() + 2) {
-				rotate(true);
-			}
-		} else {
-			_gh.emplace_back(1);
-			_fmap[name] = { _gh.size() - 1, true };
-			_bmap[_gh.size() - 1].g_key = std::move(name);
-			float_up(_gh.size() - 1, true);
-			if (_gh.size() == _lh.size() + 2) {
-				rotate(false);
-			}
-		}
+	void insert(StringRef name) {
+		insert(_names.intern(name));
 	}
 
 	/**
 		Erase an element from the heap. Make sure to sink/float
 		and rotate to maintain invariance.
 		
-		@param name name of the element to be erased.
+		@param name name of the element to be erased; nothing happens if it
+		isn't contained.
 	*/
 	void erase(std::string const& name) {
-		FInfo const& info = _fmap[name];
+		Id const id = _names.find(name);
+		if (id == npos) {
+			return;
+		}
+		FInfo const info = _fmap[id];
 		erase(info.ind, info.in_gh);
 	}
 
@@ -390,43 +469,52 @@ public:
 		Increment the value of an element in the heap. Make sure to sink/float
 		and rotate to maintain invariance.
 		
-		@param name name of the element to be incremented.
+		@param name name of the element to be incremented; nothing happens if
+		it isn't contained.
 	*/
-	void increase_key(std::string name) {
-		// Assume name exists. Increase its degree.
-		FInfo const& info = _fmap[name];
+	void increase_key(std::string const& name) {
+		Id const id = _names.find(name);
+		if (id == npos) {
+			return;
+		}
+		FInfo const info = _fmap[id];
 		increase_key(info.ind, info.in_gh);
 	}
 
 	/**
 		Decrement the value of an element in the heap. Any vertices with degree
-		0 are erased. Make sure to sink/float and rotate to maintain invariance.
+		0 are erased and their ids released. Make sure to sink/float and rotate
+		to maintain invariance.
 		
-		@param name name of the element to be decremented.
-		@return true if the element was erased, false otherwise.
+		@param id id of the element to be decremented.
+		@return false if the element was erased, true otherwise.
 	*/
-	bool decrease_key(std::string const& name) {
+	bool decrease_key(Id id) {
 		// Erase a vertex if has degree 1. Return false.
 		// Otherwise, decrease its key. Return true.
-		FInfo const& info = _fmap[name];
-		if (info.in_gh) {
-			if (_gh[info.ind] == 1) {
-				erase(info.ind, info.in_gh);
-				return false;
-			} else {
-				decrease_key(info.ind, info.in_gh);
-				return true;
-			}
+		FInfo const info = _fmap[id];
+		std::vector<Node> const& vec = info.in_gh ? _gh : _lh;
+		if (vec[info.ind].degree == 1) {
+			erase(info.ind, info.in_gh);
+			return false;
 		} else {
-			if (_lh[info.ind] == 1) {
-				erase(info.ind, info.in_gh);
-				return false;
-			} else {
-				decrease_key(info.ind, info.in_gh);
-				return true;
-			}
+			decrease_key(info.ind, info.in_gh);
+			return true;
 		}
 	}
+
+	/**
+		Decrement the value of an element in the heap. Any vertices with degree
+		0 are erased. Make sure to sink/float and rotate to maintain invariance.
+		
+		@param name name of the element to be decremented.
+		@return false if the element was erased or isn't contained, true
+		otherwise.
+	*/
+	bool decrease_key(std::string const& name) {
+		Id const id = _names.find(name);
+		return id != npos && decrease_key(id);
+	}
 	
 	/**
 		API used by a VenmoGraph object. VenmoGraph inserts/modifies vertices in
@@ -435,52 +523,75 @@ public:
 		
 		@param name1 name of the 1st element to be inserted/incremented.
 		@param name2 name of the 2nd element to be inserted/incremented.
+		@return the ids of both elements.
 	*/
-	void process_edge(std::string name1, std::string name2) {
-		std::unordered_map<std::string, FInfo>::const_iterator it1 =
-			_fmap.find(name1);
-		if (it1 != _fmap.cend()) {
-			FInfo const& info1 = it1->second;
-			increase_key(info1.ind, info1.in_gh);
-			std::unordered_map<std::string, FInfo>::const_iterator it2 =
-				_fmap.find(name2);
-			if (it2 != _fmap.cend()) {
-				FInfo const& info2 = it2->second;
-				increase_key(info2.ind, info2.in_gh);
-			} else {
-				insert(std::move(name2));
-			}
+	std::pair<Id, Id> process_edge(StringRef name1, StringRef name2) {
+		bool inserted;
+		Id const id1 = _names.intern(name1, inserted);
+		if (inserted) {
+			insert(id1);
 		} else {
-			insert(std::move(name1));
-			std::unordered_map<std::string, FInfo>::const_iterator it2 =
-				_fmap.find(name2);
-			if (it2 != _fmap.cend()) {
-				FInfo const& info = it2->second;
-				increase_key(info.ind, info.in_gh);
-			} else {
-				insert(std::move(name2));
-			}
+			FInfo const info = _fmap[id1];
+			increase_key(info.ind, info.in_gh);
 		}
+		Id const id2 = _names.intern(name2, inserted);
+		if (inserted) {
+			insert(id2);
+		} else {
+			FInfo const info = _fmap[id2];
+			increase_key(info.ind, info.in_gh);
+		}
+		return std::make_pair(id1, id2);
 	}
 
 	/**
 		Current median.
 		
-		@return the current median.
+		@return the current median, or 0 if the heap map is empty.
 	*/
 	double median() const {
 		ssize_t const size_diff = ssize_t(_lh.size()) -
 								  ssize_t(_gh.size());
 
+		if (empty()) {
+			return 0.0;
+		}
 		if (size_diff > 0) {  // _lh.size() > _gh.size()
-			return _lh.front();
+			return _lh.front().degree;
 		}
 		else if (size_diff == 0) {  // _lh.size() == _gh.size()
-			return (_lh.front() + _gh.front()) / 2.0;
+			return (_lh.front().degree + _gh.front().degree) / 2.0;
 		}
 		else {  // _lh.size() < _gh.size()
-			return _gh.front();
+			return _gh.front().degree;
+		}
+	}
+
+	/**
+		A quantile of the degrees, by nearest rank: the smallest degree
+		that at least a fraction q of the elements are at or below. Found
+		by descending the Fenwick tree of degree counts, in O(log max
+		degree) time.
+
+		@param q the fraction, from 0 to 1; 0.5 is the lower median.
+		@return the degree, or 0 if the heap map is empty.
+	*/
+	uint64_t quantile(double q) const {
+		if (empty()) {
+			return 0;
+		}
+		double const rank = std::ceil(q * double(size()));
+		// how many elements are at or below the degree sought
+		uint32_t left = uint32_t(rank < 1 ? 1 : std::min(size_t(rank), size()));
+		// the largest degree with fewer than that at or below it
+		size_t degree = 0;
+		for (size_t step = _degree_counts.size() - 1; step != 0; step >>= 1) {
+			if (_degree_counts[degree + step] < left) {
+				degree += step;
+				left -= _degree_counts[degree];
+			}
 		}
+		return degree + 1;
 	}
 
 	/**
@@ -519,21 +630,78 @@ public:
 		return _gh.size();
 	}
 
+	/**
+		Id of an element.
+
+		@param name name of the element.
+		@return the id of the element, or npos if it isn't contained.
+	*/
+	Id find(StringRef name) const {
+		return _names.find(name);
+	}
+
+	/**
+		Name of an element.
+
+		@param id id of a contained element.
+		@return the name of the element.
+	*/
+	std::string const& name(Id id) const {
+		return _names.name(id);
+	}
+
+	/**
+		Counters, for monitoring.
+
+		@return what the heap map has done since it was made.
+	*/
+	Counters const& counters() const {
+		return _counters;
+	}
+
+	/**
+		Heap memory held, in parts: the heaps (whose nodes hold the backward
+		index), the forward index, the degree counts, and the name table's
+		parts.
+
+		@return the account.
+	*/
+	MemoryUsage memory_usage() const {
+		MemoryUsage m;
+		m.add("heaps", MemoryUsage::of(_lh) + MemoryUsage::of(_gh));
+		m.add("forward_index", MemoryUsage::of(_fmap));
+		m.add("degree_counts", MemoryUsage::of(_degree_counts));
+		m.add(_names.memory_usage());
+		return m;
+	}
+
+	/**
+		The vertex names and their ids.
+
+		@return the name table.
+	*/
+	NameTable const& names() const {
+		return _names;
+	}
+
 	/* Testing & Debugging */
 
 	/**
 		Degree of an element.
 		
 		@param name name of the element.
-		@return the degree of the element.
+		@return the degree of the element, or 0 if it isn't contained.
 	*/
-	uint64_t degree(std::string name) const {
-		std::unordered_map<std::string, FInfo>::const_iterator found =
-			_fmap.find(name);
-		if ((found->second).in_gh) {
-			return _gh[(found->second).ind];
+	uint64_t degree(std::string const& name) const {
+		Id const id = _names.find(name);
+		if (id == npos) {
+			return 0;
+		}
+		FInfo const& info = _fmap[id];
+		if (info.in_gh) {
+			return _gh[info.ind].degree;
 		} else {
-			return _lh[(found->second).ind];
+			return _lh[info.ind].degree;
 		}
 	}
 
@@ -541,12 +709,11 @@ public:
 		Which half the element belongs to.
 		
 		@param name name of the element.
-		@return the half the element belongs to.
+		@return the half the element belongs to, false if it isn't contained.
 	*/
-	bool in_gh(std::string name) const {
-		std::unordered_map<std::string, FInfo>::const_iterator found =
-			_fmap.find(name);
-		return (found->second).in_gh;
+	bool in_gh(std::string const& name) const {
+		Id const id = _names.find(name);
+		return id != npos && _fmap[id].in_gh;
 	}
 
 	/**
@@ -555,8 +722,8 @@ public:
 		@param name name of the element.
 		@return whether or not element is contained.
 	*/
-	bool contains(std::string name) const {
-		return _fmap.count(name) != 0;
+	bool contains(std::string const& name) const {
+		return _names.find(name) != npos;
 	}
 
 	/**
@@ -570,20 +737,16 @@ public:
 		// dump lh
 		ss << "----- _lh -----\n";
 		for (size_t i = 0; i < _lh.size(); ++i) {
-			std::unordered_map<size_t, BInfo>::const_iterator const it =
-				_bmap.find(i);
-			std::string const name = (it->second).l_key;
-			ss << i << ": " << name << ", " << _lh[i] << '\n';
+			ss << i << ": " << _names.name(_lh[i].id) << ", " <<
+				_lh[i].degree << '\n';
 		}
 		ss << '\n';
 		
 		// dump gh
 		ss << "----- _gh -----\n";
 		for (size_t i = 0; i < _gh.size(); ++i) {
-			std::unordered_map<size_t, BInfo>::const_iterator const it =
-				_bmap.find(i);
-			std::string const name = (it->second).g_key;
-			ss << i << ": " << name << ", " << _gh[i] << '\n';
+			ss << i << ": " << _names.name(_gh[i].id) << ", " <<
+				_gh[i].degree << '\n';
 		}
 		ss << '\n';
 		
@@ -591,7 +754,7 @@ public:
 	}
 
 	/**
-		Dump of what are inside the heaps as well as the maps.
+		Dump of what are inside the heaps as well as the indexes.
 		
 		@return string of the dump.
 	*/
@@ -600,37 +763,27 @@ public:
 
 		// dump _lh
 		ss << "----- _lh -----\n";
-		for (uint32_t x : _lh) {
-			ss << x << ' ';
+		for (Node const& x : _lh) {
+			ss << x.degree << ' ';
 		}
 		ss << "\n\n";
 
 		// dump _gh
 		ss << "----- _gh -----\n";
-		for (uint32_t x : _gh) {
-			ss << x << ' ';
+		for (Node const& x : _gh) {
+			ss << x.degree << ' ';
 		}
 		ss << "\n\n";
 
 		// dump _fmap
 		ss << "----- _fmap -----\n";
-		for (auto const& p : _fmap) {
-			ss << p.first << " : (";
-			ss << p.second.ind << ", ";
-			ss << (p.second.in_gh ? "true" : "false") << ")\n";
+		for (Node const& x : _lh) {
+			ss << x.id << ' ' << _names.name(x.id) << " : (";
+			ss << _fmap[x.id].ind << ", false)\n";
 		}
-		ss << '\n';
-
-		// dump _bmap
-		ss << "----- _bmap -----\n";
-		for (auto const& p : _bmap) {
-			ss << p.first << '\n';
-			if (!p.second.g_key.empty()) {
-				ss << "  g: " << p.second.g_key << '\n';
-			}
-			if (!p.second.l_key.empty()) {
-				ss << "  l: " << p.second.l_key << '\n';
-			}
+		for (Node const& x : _gh) {
+			ss << x.id << ' ' << _names.name(x.id) << " : (";
+			ss << _fmap[x.id].ind << ", true)\n";
 		}
 
 		return ss.str();
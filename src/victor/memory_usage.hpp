@@ -0,0 +1,163 @@
+/**
+    Insight Data Engineering Code Challenge
+    memory_usage.hpp
+
+    Purpose:
+
+    MemoryUsage is an account of the heap memory held by a data structure,
+    part by part: VenmoGraph, MedHeapMap and NameTable each return one
+    from memory_usage(), for sizing hosts and for judging work that makes
+    them smaller.
+
+    The bytes are worked out from the sizes and capacities of the
+    containers, the way libstdc++ lays them out and glibc's malloc rounds
+    them up: a vector holds its capacity, not its size; a std::string
+    holds a heap block only past its 15 inline characters; every node of a
+    tree or hash table is a block of its own; and a hash table holds its
+    bucket array, slack included. Each block is counted with malloc's 8
+    bytes of header and 16-byte granularity (32 bytes at the least). The
+    objects themselves (sizeof) are not counted, since they live wherever
+    their owner does.
+
+    @author Victor Chen
+*/
+#ifndef MEMORY_USAGE_HPP_
+#define MEMORY_USAGE_HPP_
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace victor {
+
+/**
+	Memory Usage
+*/
+class MemoryUsage {
+public:
+	/**
+		A named part of a data structure, and the bytes it holds.
+	*/
+	struct Part {
+		char const* name;
+		size_t bytes;
+	};
+
+private:
+	std::vector<Part> _parts;
+
+public:
+	/**
+		Add bytes to a part, adding the part if it isn't there.
+
+		@param name name of the part; must outlive the account.
+		@param bytes bytes held.
+	*/
+	void add(char const* name, size_t bytes) {
+		for (Part& p : _parts) {
+			if (strcmp(p.name, name) == 0) {
+				p.bytes += bytes;
+				return;
+			}
+		}
+		Part const part = { name, bytes };
+		_parts.push_back(part);
+	}
+
+	/**
+		Add every part of another account.
+	*/
+	void add(MemoryUsage const& other) {
+		for (Part const& p : other._parts) {
+			add(p.name, p.bytes);
+		}
+	}
+
+	/**
+		@return the bytes of a part, or 0 if there is no such part.
+	*/
+	size_t bytes(char const* name) const {
+		for (Part const& p : _parts) {
+			if (strcmp(p.name, name) == 0) {
+				return p.bytes;
+			}
+		}
+		return 0;
+	}
+
+	/**
+		@return the bytes of every part.
+	*/
+	size_t total() const {
+		size_t sum = 0;
+		for (Part const& p : _parts) {
+			sum += p.bytes;
+		}
+		return sum;
+	}
+
+	std::vector<Part> const& parts() const {
+		return _parts;
+	}
+
+	/* What containers hold */
+
+	/**
+		@param size bytes asked of malloc.
+		@return bytes malloc takes for them, its header included.
+	*/
+	static size_t allocation(size_t size) {
+		size_t const chunk = (size + sizeof(size_t) + 15) & ~size_t(15);
+		return chunk < 32 ? 32 : chunk;
+	}
+
+	/**
+		@return bytes held by a vector's buffer.
+	*/
+	template <typename T>
+	static size_t of(std::vector<T> const& v) {
+		return v.capacity() == 0 ? 0 : allocation(v.capacity() * sizeof(T));
+	}
+
+	/**
+		@return bytes held by a string outside of itself.
+	*/
+	static size_t of(std::string const& s) {
+		// libstdc++ keeps up to 15 characters inside the string
+		return s.capacity() <= 15 ? 0 : allocation(s.capacity() + 1);
+	}
+
+	/**
+		@return bytes held by the nodes of a std::map, std::multimap or
+		std::set: a red-black tree node, a color and three links, each.
+	*/
+	template <typename Tree>
+	static size_t tree(Tree const& t) {
+		struct Node {
+			int color;
+			void* links[3];
+			typename Tree::value_type value;
+		};
+		return t.size() * allocation(sizeof(Node));
+	}
+
+	/**
+		@return bytes held by the buckets and nodes of a std::unordered_map
+		or std::unordered_set whose hash isn't cached in its nodes: a link
+		and the value, each. A table of a single bucket keeps it inside.
+	*/
+	template <typename Table>
+	static size_t hash_table(Table const& t) {
+		struct Node {
+			void* next;
+			typename Table::value_type value;
+		};
+		size_t const buckets = t.bucket_count() <= 1 ? 0
+			: allocation(t.bucket_count() * sizeof(void*));
+		return buckets + t.size() * allocation(sizeof(Node));
+	}
+};  // class MemoryUsage
+
+}  // namespace victor
+
+#endif  // MEMORY_USAGE_HPP_
@@ -0,0 +1,394 @@
+/**
+    Insight Data Engineering Code Challenge
+    merged_input.hpp
+
+    Purpose:
+
+    MergedInput reads the records of several files (logs split per
+    producer host, say) and hands them out merged by created_time, so that
+    VenmoGraph sees them roughly in time order and drops far fewer late
+    records than it would running the files one after another.
+
+    Each file has a RecordPrefetcher: a thread of its own that reads the
+    file (decompressing it if need be, see src/victor/compressed_input.hpp),
+    parses its records as MedDegStream does, and queues them in batches, a
+    few batches ahead of the merge. The merge itself is a k-way merge: a
+    binary heap of the next record of every file, keyed by created_time
+    (then by file, so that ties come out in the order the files were
+    given). Records that can't be read have no time; they come out as soon
+    as they are at the front of their file, to be reported and skipped.
+    Each file is in the order it was written, so a file whose own records
+    are out of order is merged as well as it can be, not sorted.
+
+    MergedInput::expand() turns a list of files and directories into a list
+    of files: a directory stands for the files in it, in order of name,
+    leaving out hidden ones.
+
+    @author Victor Chen
+*/
+#ifndef MERGED_INPUT_HPP_
+#define MERGED_INPUT_HPP_
+
+#include "victor/binary_record.hpp"
+#include "victor/compressed_input.hpp"
+#include "victor/line_reader.hpp"
+#include "victor/structural_index.hpp"
+#include "victor/venmo_record.hpp"
+#include <dirent.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace victor {
+
+/**
+	Record Prefetcher
+
+	Reads and parses the records of one file on a thread of its own.
+*/
+class RecordPrefetcher {
+public:
+	/**
+		A record, and whether it could be read.
+	*/
+	struct Item {
+		VenmoRecordReader::Status status;
+		VenmoRecord rec;
+	};
+
+	typedef std::vector<Item> Batch;
+
+private:
+	static size_t const batch_size = 1024;
+	static size_t const max_batches = 4;	// queued ahead of the merge
+
+	std::string _filename;
+	BinaryRecordReader::Format _format;
+	bool _binary;
+
+	mutable std::mutex _mutex;
+	std::condition_variable _cv;
+	std::deque<Batch> _batches;
+	bool _done = false;			// whether the last batch is queued
+	bool _stop = false;			// whether the thread must exit
+	std::string _error;			// why the file ended early, if it did
+	std::thread _thread;
+
+	/**
+		Queue a batch, waiting for room.
+
+		@return false if the thread must stop.
+	*/
+	bool push(Batch& batch) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cv.wait(lock, [this] { return _stop || _batches.size() < max_batches; });
+		if (_stop) {
+			return false;
+		}
+		_batches.push_back(std::move(batch));
+		batch.clear();
+		batch.reserve(batch_size);
+		_cv.notify_all();
+		return true;
+	}
+
+	/**
+		Add a record to the batch, queueing the batch once it is full.
+	*/
+	bool add(Batch& batch, VenmoRecordReader::Status status, VenmoRecord& rec) {
+		batch.emplace_back();
+		Item& item = batch.back();
+		item.status = status;
+		if (status == VenmoRecordReader::ok) {
+			item.rec.actor.swap(rec.actor);
+			item.rec.target.swap(rec.target);
+			item.rec.created_time = rec.created_time;
+		}
+		return batch.size() < batch_size || push(batch);
+	}
+
+	bool read_json(LineReader& lines, Batch& batch) {
+		VenmoRecordReader reader;
+		VenmoRecord rec;
+		StructuralIndex index;
+		char const* block;
+		char const* block_end;
+		while (lines.next_block(block, block_end)) {
+			index.build(block, block_end);
+			char const* first;
+			char const* last;
+			uint32_t const* pos;
+			uint32_t const* pos_end;
+			while (index.next_line(first, last, pos, pos_end)) {
+				if (!add(batch, reader.read(first, last, block, pos, pos_end, rec), rec)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool read_binary(LineReader& lines, Batch& batch, std::string& error) {
+		BinaryRecordReader reader(_format);
+		VenmoRecord rec;
+		VenmoRecordReader::Status status;
+		char const* first;
+		char const* last;
+		while (lines.buffered(first, last)) {
+			char const* p = first;
+			char const* next;
+			BinaryRecordReader::Framing framing;
+			while ((framing = reader.read(p, last, next, rec, status)) ==
+				   BinaryRecordReader::framed) {
+				if (!add(batch, status, rec)) {
+					return false;
+				}
+				p = next;
+			}
+			lines.consume(size_t(p - first));
+			if (framing == BinaryRecordReader::corrupt) {
+				error = "corrupt input";
+				return true;
+			}
+			if (!lines.read_more()) {
+				if (p != last) {
+					error = "truncated record";
+				}
+				return true;
+			}
+		}
+		return true;
+	}
+
+	void run() {
+		LineReader lines(CompressedInput::open(_filename.c_str()));
+		Batch batch;
+		batch.reserve(batch_size);
+		std::string error;
+		if (!lines.is_open()) {
+			error = "cannot read " + _filename;
+		} else if (!(_binary ? read_binary(lines, batch, error) : read_json(lines, batch))) {
+			return;
+		}
+		CompressedInput const* const compressed =
+			dynamic_cast<CompressedInput const*>(lines.input());
+		if (error.empty() && compressed != nullptr && compressed->failed()) {
+			error = compressed->error();
+		}
+		if (!batch.empty() && !push(batch)) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(_mutex);
+		_error = error;
+		_done = true;
+		_cv.notify_all();
+	}
+
+public:
+	/**
+		@param filename file to read.
+		@param binary false for JSON lines, true for binary records.
+		@param format encoding of binary records.
+	*/
+	RecordPrefetcher(std::string filename, bool binary,
+					 BinaryRecordReader::Format format = BinaryRecordReader::msgpack)
+		: _filename(std::move(filename)), _format(format), _binary(binary) {
+		_thread = std::thread(&RecordPrefetcher::run, this);
+	}
+
+	~RecordPrefetcher() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_cv.notify_all();
+		_thread.join();
+	}
+
+	RecordPrefetcher(RecordPrefetcher const&) = delete;
+	RecordPrefetcher& operator=(RecordPrefetcher const&) = delete;
+
+	/**
+		Take the next batch, waiting for it.
+
+		@param batch set to the batch; its old contents are lost.
+		@return false once the file is used up.
+	*/
+	bool next(Batch& batch) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cv.wait(lock, [this] { return _done || !_batches.empty(); });
+		if (_batches.empty()) {
+			return false;
+		}
+		batch = std::move(_batches.front());
+		_batches.pop_front();
+		_cv.notify_all();
+		return true;
+	}
+
+	/**
+		@return why the file ended early, or "" if it didn't; known once
+		next() has returned false.
+	*/
+	std::string error() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _error;
+	}
+
+	std::string const& filename() const {
+		return _filename;
+	}
+};  // class RecordPrefetcher
+
+/**
+	Merged Input
+*/
+class MergedInput {
+private:
+	/**
+		A file's place in the merge.
+	*/
+	struct Source {
+		std::unique_ptr<RecordPrefetcher> prefetcher;
+		RecordPrefetcher::Batch batch;
+		size_t next = 0;		// of the batch
+	};
+
+	/**
+		The next record of a file, in the heap.
+	*/
+	struct Head {
+		time_t created_time;
+		size_t source;
+
+		// std::push_heap makes a max-heap
+		bool operator<(Head const& other) const {
+			return created_time != other.created_time
+				? created_time > other.created_time : source > other.source;
+		}
+	};
+
+	std::vector<Source> _sources;
+	std::vector<Head> _heap;
+	std::vector<std::string> _errors;
+	RecordPrefetcher::Item _item;	// the last one handed out
+
+	/**
+		Put a file's next record on the heap, if it has one.
+	*/
+	void advance(size_t i) {
+		Source& s = _sources[i];
+		if (s.next == s.batch.size()) {
+			s.next = 0;
+			if (!s.prefetcher->next(s.batch)) {
+				s.batch.clear();
+				std::string const error = s.prefetcher->error();
+				if (!error.empty()) {
+					_errors.push_back(error);
+				}
+				return;
+			}
+		}
+		RecordPrefetcher::Item const& item = s.batch[s.next];
+		// records that can't be read have no time; they go first
+		Head const h = { item.status == VenmoRecordReader::ok ? item.rec.created_time
+			: std::numeric_limits<time_t>::min(), i };
+		_heap.push_back(h);
+		std::push_heap(_heap.begin(), _heap.end());
+	}
+
+public:
+	/**
+		@param filenames files to read.
+		@param binary false for JSON lines, true for binary records.
+		@param format encoding of binary records.
+	*/
+	MergedInput(std::vector<std::string> const& filenames, bool binary,
+				BinaryRecordReader::Format format = BinaryRecordReader::msgpack)
+		: _sources(filenames.size()) {
+		for (size_t i = 0; i < filenames.size(); ++i) {
+			_sources[i].prefetcher.reset(new RecordPrefetcher(filenames[i], binary, format));
+		}
+		for (size_t i = 0; i < filenames.size(); ++i) {
+			advance(i);
+		}
+	}
+
+	/**
+		Get the earliest of the files' next records.
+
+		@param status set to whether it could be read.
+		@param rec set to the record; valid until the next call.
+		@return false once every file is used up.
+	*/
+	bool next(VenmoRecordReader::Status& status, VenmoRecord const*& rec) {
+		if (_heap.empty()) {
+			return false;
+		}
+		std::pop_heap(_heap.begin(), _heap.end());
+		size_t const i = _heap.back().source;
+		_heap.pop_back();
+		Source& s = _sources[i];
+		_item = std::move(s.batch[s.next++]);
+		advance(i);
+		status = _item.status;
+		rec = &_item.rec;
+		return true;
+	}
+
+	/**
+		@return why files ended early, in the order they did.
+	*/
+	std::vector<std::string> const& errors() const {
+		return _errors;
+	}
+
+	/**
+		Replace each directory in a list of paths with the files in it, in
+		order of name, leaving out hidden ones.
+
+		@param paths files and directories.
+		@return the files.
+	*/
+	static std::vector<std::string> expand(std::vector<std::string> const& paths) {
+		std::vector<std::string> files;
+		for (std::string const& path : paths) {
+			struct stat st;
+			if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+				files.push_back(path);
+				continue;
+			}
+			DIR* const dir = opendir(path.c_str());
+			if (dir == nullptr) {
+				files.push_back(path);
+				continue;
+			}
+			std::vector<std::string> in_dir;
+			while (dirent const* const e = readdir(dir)) {
+				std::string const file = path + '/' + e->d_name;
+				if (e->d_name[0] != '.' && stat(file.c_str(), &st) == 0 &&
+					S_ISREG(st.st_mode)) {
+					in_dir.push_back(file);
+				}
+			}
+			closedir(dir);
+			std::sort(in_dir.begin(), in_dir.end());
+			files.insert(files.end(), in_dir.begin(), in_dir.end());
+		}
+		return files;
+	}
+};  // class MergedInput
+
+}  // namespace victor
+
+#endif  // MERGED_INPUT_HPP_
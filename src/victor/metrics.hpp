@@ -0,0 +1,149 @@
+/**
+    Insight Data Engineering Code Challenge
+    metrics.hpp
+
+    Purpose:
+
+    Export of counters in the Prometheus text format, to a local file that
+    a node exporter's textfile collector (or anything else) can scrape.
+
+    PrometheusText builds the text of one scrape. MetricsFile writes it to
+    a file: to a temporary file first, then renamed over the real one, so
+    a reader never sees half of it. MetricsFile::due() tells when another
+    write is due; it is up to the caller to ask, from the thread that owns
+    the counters, so no counter needs a lock or an atomic.
+
+    @author Victor Chen
+*/
+#ifndef METRICS_HPP_
+#define METRICS_HPP_
+
+#include "victor/output_sink.hpp"
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <utility>
+
+namespace victor {
+
+/**
+	Prometheus Text
+
+	Metrics in the Prometheus text exposition format: a HELP and a TYPE
+	line, then the sample, for each.
+*/
+class PrometheusText {
+private:
+	std::string _text;
+
+	void sample(char const* name, char const* help, char const* type,
+				char const* first, char const* last) {
+		_text += "# HELP ";
+		_text += name;
+		_text += ' ';
+		_text += help;
+		_text += "\n# TYPE ";
+		_text += name;
+		_text += ' ';
+		_text += type;
+		_text += '\n';
+		_text += name;
+		_text += ' ';
+		_text.append(first, last);
+		_text += '\n';
+	}
+
+public:
+	/**
+		Add a counter: a total that only goes up. Its name should end in
+		_total.
+	*/
+	void counter(char const* name, char const* help, uint64_t value) {
+		char buf[24];
+		sample(name, help, "counter", buf, NumberFormat::integer(buf, value));
+	}
+
+	/**
+		Add a gauge: a value that goes up and down.
+	*/
+	void gauge(char const* name, char const* help, uint64_t value) {
+		char buf[24];
+		sample(name, help, "gauge", buf, NumberFormat::integer(buf, value));
+	}
+
+	void gauge(char const* name, char const* help, double value) {
+		char buf[NumberFormat::max_shortest];
+		char* const end = NumberFormat::shortest(buf, value);
+		// Prometheus spells it NaN, not null
+		if (end - buf == 4 && buf[0] == 'n') {
+			sample(name, help, "gauge", "NaN", "NaN" + 3);
+		} else {
+			sample(name, help, "gauge", buf, end);
+		}
+	}
+
+	std::string const& str() const {
+		return _text;
+	}
+};  // class PrometheusText
+
+/**
+	Metrics File
+*/
+class MetricsFile {
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	std::string _filename;
+	std::string _temp_filename;
+	Clock::duration _interval;
+	Clock::time_point _next;
+
+public:
+	/**
+		@param filename file to write metrics to.
+		@param interval_seconds time between writes.
+	*/
+	MetricsFile(std::string filename, double interval_seconds)
+		: _filename(std::move(filename)), _temp_filename(_filename + ".tmp"),
+		  _interval(std::chrono::duration_cast<Clock::duration>(
+			  std::chrono::duration<double>(interval_seconds))),
+		  _next(Clock::now()) {}
+
+	/**
+		@return whether the interval has passed since the last write.
+	*/
+	bool due() const {
+		return Clock::now() >= _next;
+	}
+
+	/**
+		Replace the file's contents, and start the next interval.
+
+		@param text what to write.
+		@return false if the file could not be written.
+	*/
+	bool write(std::string const& text) {
+		_next = Clock::now() + _interval;
+		FILE* const f = fopen(_temp_filename.c_str(), "wb");
+		if (f == nullptr) {
+			return false;
+		}
+		bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+		ok = fclose(f) == 0 && ok;
+		if (!ok || rename(_temp_filename.c_str(), _filename.c_str()) != 0) {
+			remove(_temp_filename.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	std::string const& filename() const {
+		return _filename;
+	}
+};  // class MetricsFile
+
+}  // namespace victor
+
+#endif  // METRICS_HPP_
@@ -0,0 +1,470 @@
+/**
+    Insight Data Engineering Code Challenge
+    name_table.hpp
+
+    Purpose:
+
+    NameTable interns Venmo vertex names into small integer ids. The rest of
+    the graph (MedHeapMap and VenmoGraph) refers to vertices by id only, so a
+    name is stored exactly once no matter how many edges or heap slots refer
+    to it.
+
+    Ids are recycled. When a vertex leaves the graph (its degree drops to 0),
+    its id is released: the name is freed and the id is pushed onto a free
+    list, to be handed out again to the next new name. The id space is
+    therefore bounded by the peak number of live vertices, not by the number
+    of vertices ever seen, which matters for a process that runs for weeks.
+
+    The name -> id index is an open-addressing hash table (linear probing).
+    Released names leave tombstones behind, and a table that once held many
+    names stays large after they leave. Both are fixed by generational
+    compaction: when the table is too full or too sparse, the current table
+    becomes the "old" generation and a fresh, right-sized table becomes the
+    current one. Every later intern/release migrates a small, bounded number
+    of slots from the old generation into the current one, so compaction
+    never rehashes the whole table at once; lookups consult both
+    generations until the old one is drained and freed. Nor is the new
+    table filled up front: an empty slot is all zero bits, so tables come
+    from calloc(), and a large one is mapped from the kernel as zeroed
+    pages, which are only touched as slots are used.
+
+    The names are kept in chunks of a fixed number of ids, so the id space
+    grows without moving the names already held.
+
+    Names are looked up through a StringRef, a pointer and a length, so
+    that a name the table already holds is found without copying it into
+    a std::string first; only a new name is copied, once.
+
+    @author Victor Chen
+*/
+#ifndef NAME_TABLE_HPP_
+#define NAME_TABLE_HPP_
+
+#include "victor/memory_usage.hpp"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <vector>
+#include <string>
+#include <utility>
+
+namespace victor {
+/**
+	A reference to characters owned by someone else, like std::string_view
+	(which C++11 lacks). It must not outlive them.
+*/
+struct StringRef {
+	char const* data;
+	size_t size;
+
+	StringRef(char const* s, size_t n) : data(s), size(n) {}
+	StringRef(char const* s) : data(s), size(strlen(s)) {}
+	StringRef(std::string const& s) : data(s.data()), size(s.size()) {}
+
+	std::string str() const {
+		return std::string(data, size);
+	}
+
+	bool operator==(StringRef const& rhs) const {
+		return size == rhs.size && memcmp(data, rhs.data, size) == 0;
+	}
+
+	bool operator!=(StringRef const& rhs) const {
+		return !(*this == rhs);
+	}
+};
+
+/**
+	Name Table
+*/
+class NameTable {
+public:
+	typedef uint32_t Id;
+
+	static Id const npos = 0xffffffffu;	// "no such name"
+
+private:
+	static uint32_t const empty = 0;			// key of a slot never used
+	static uint32_t const tombstone = 0xffffffffu;	// key of a released name
+	static size_t const min_capacity = 16;		// smallest hash table
+	static size_t const migrate_step = 8;		// old slots moved per op
+	static size_t const no_slot = size_t(-1);	// probe miss
+	static size_t const chunk_ids = 1024;		// names per chunk
+
+	/**
+		Hash table slot. The key is the id plus one, so that a slot of all
+		zero bits is empty. The upper bits of the hash are kept next to it
+		so that most probes are rejected without touching the name.
+	*/
+	struct Slot {
+		uint32_t key;
+		uint32_t hash;
+	};
+
+	struct Free {
+		void operator()(Slot* slots) const {
+			free(slots);
+		}
+	};
+
+	/**
+		One generation of the name -> id index.
+	*/
+	struct Table {
+		std::unique_ptr<Slot[], Free> slots;	// power-of-two sized
+		size_t capacity = 0;		// slots
+		size_t used = 0;			// live + tombstone slots
+		size_t live = 0;			// live slots
+
+		void reset(size_t n) {
+			slots.reset(static_cast<Slot*>(calloc(n, sizeof(Slot))));
+			if (!slots) {
+				throw std::bad_alloc();
+			}
+			capacity = n;
+			used = 0;
+			live = 0;
+		}
+
+		void clear() {
+			slots.reset();
+			capacity = 0;
+			used = 0;
+			live = 0;
+		}
+
+		size_t bytes() const {
+			return capacity == 0 ? 0 : MemoryUsage::allocation(capacity * sizeof(Slot));
+		}
+	};
+
+	std::vector<std::vector<std::string>> _names;	// id -> name, in chunks
+													// of chunk_ids
+	size_t _num_ids = 0;				// ids handed out
+	std::vector<Id> _free;				// released ids, reused LIFO
+	Table _cur;							// current generation
+	Table _old;							// generation being drained
+	size_t _migrate_pos = 0;			// next _old slot to migrate
+
+	/**
+		64-bit hash of a name, 8 bytes at a time.
+
+		@param s pointer to the name.
+		@param n length of the name.
+		@return the hash.
+	*/
+	static uint64_t hash_bytes(char const* s, size_t n) {
+		uint64_t const m = 0x9e3779b97f4a7c15ull;
+		uint64_t h = 0xcbf29ce484222325ull ^ (n * m);
+		while (n >= 8) {
+			uint64_t w;
+			memcpy(&w, s, 8);
+			h = (h ^ w) * m;
+			h ^= h >> 29;
+			s += 8;
+			n -= 8;
+		}
+		uint64_t w = 0;
+		memcpy(&w, s, n);
+		h = (h ^ w) * m;
+		h ^= h >> 32;
+		h *= 0xd6e8feb86659fd93ull;
+		h ^= h >> 32;
+		return h;
+	}
+
+	/**
+		Probe a table for a name.
+
+		@param t table to probe.
+		@param s pointer to the name.
+		@param n length of the name.
+		@param h hash of the name.
+		@return slot index holding the name, or no_slot.
+	*/
+	size_t probe(Table const& t, char const* s, size_t n, uint64_t h) const {
+		if (t.capacity == 0) {
+			return no_slot;
+		}
+		size_t const mask = t.capacity - 1;
+		uint32_t const tag = uint32_t(h >> 32);
+		for (size_t i = size_t(h) & mask; ; i = (i + 1) & mask) {
+			Slot const& slot = t.slots[i];
+			if (slot.key == empty) {
+				return no_slot;
+			}
+			if (slot.key != tombstone && slot.hash == tag) {
+				std::string const& name = this->name(slot.key - 1);
+				if (name.size() == n && memcmp(name.data(), s, n) == 0) {
+					return i;
+				}
+			}
+		}
+	}
+
+	/**
+		Place an id into a table that is known not to contain it.
+
+		@param t table to insert into.
+		@param id id of the name.
+		@param h hash of the name.
+	*/
+	static void place(Table& t, Id id, uint64_t h) {
+		size_t const mask = t.capacity - 1;
+		size_t i = size_t(h) & mask;
+		while (t.slots[i].key != empty && t.slots[i].key != tombstone) {
+			i = (i + 1) & mask;
+		}
+		if (t.slots[i].key == empty) {
+			++t.used;
+		}
+		t.slots[i].key = id + 1;
+		t.slots[i].hash = uint32_t(h >> 32);
+		++t.live;
+	}
+
+	/**
+		Move up to max_slots slots from the old generation into the current
+		one. Frees the old generation once it is drained.
+
+		@param max_slots bound on the amount of work done.
+	*/
+	void migrate(size_t max_slots) {
+		size_t const end = _old.capacity;
+		for (; max_slots != 0 && _migrate_pos < end; --max_slots) {
+			Slot& slot = _old.slots[_migrate_pos++];
+			if (slot.key != empty && slot.key != tombstone) {
+				std::string const& name = this->name(slot.key - 1);
+				place(_cur, slot.key - 1, hash_bytes(name.data(), name.size()));
+				slot.key = tombstone;
+				--_old.live;
+			}
+		}
+		if (_migrate_pos == end) {
+			_old.clear();
+			_migrate_pos = 0;
+		}
+	}
+
+	/**
+		Start a new generation if the current one is too full (counting
+		tombstones) or too sparse. The new table is sized so that it cannot
+		fill up before the old generation is drained, and shrinks by at most
+		a factor of 4 per generation. It is allocated zeroed, not filled.
+	*/
+	void maybe_start_generation() {
+		size_t const cap = _cur.capacity;
+		bool const too_full = (_cur.used + 1) * 4 > cap * 3;
+		bool const too_sparse = cap > min_capacity && _cur.live * 8 < cap;
+		if (_old.capacity != 0) {
+			if (!too_full) {
+				return;
+			}
+			// can't happen given the sizing below, but never overfill
+			migrate(_old.capacity);
+		} else if (!too_full && !too_sparse) {
+			return;
+		}
+		size_t const expected = _cur.live + cap / migrate_step + 1;
+		size_t new_cap = min_capacity;
+		while (new_cap < expected * 2) {
+			new_cap <<= 1;
+		}
+		std::swap(_old, _cur);
+		_cur.reset(new_cap);
+		_migrate_pos = 0;
+	}
+
+	/**
+		Hand out a fresh or recycled id for a name.
+
+		@param name the name, moved into the table.
+		@return the id.
+	*/
+	Id allocate(std::string&& name) {
+		Id id;
+		if (!_free.empty()) {
+			id = _free.back();
+			_free.pop_back();
+			_names[id / chunk_ids][id % chunk_ids] = std::move(name);
+		} else {
+			id = Id(_num_ids++);
+			if (id % chunk_ids == 0) {
+				_names.emplace_back();
+				_names.back().reserve(chunk_ids);
+			}
+			_names.back().emplace_back(std::move(name));
+		}
+		return id;
+	}
+
+public:
+	NameTable() {
+		_cur.reset(min_capacity);
+	}
+
+	/**
+		Look up a name.
+
+		@param s pointer to the name.
+		@param n length of the name.
+		@return the id of the name, or npos if it isn't interned.
+	*/
+	Id find(char const* s, size_t n) const {
+		uint64_t const h = hash_bytes(s, n);
+		size_t i = probe(_cur, s, n, h);
+		if (i != no_slot) {
+			return _cur.slots[i].key - 1;
+		}
+		i = probe(_old, s, n, h);
+		return i != no_slot ? _old.slots[i].key - 1 : npos;
+	}
+
+	/**
+		Look up a name.
+
+		@param name the name.
+		@return the id of the name, or npos if it isn't interned.
+	*/
+	Id find(StringRef name) const {
+		return find(name.data, name.size);
+	}
+
+	/**
+		Intern a name, if it isn't already.
+
+		@param name the name. Only copied if it is newly interned.
+		@param inserted set to whether the name is newly interned.
+		@return the id of the name.
+	*/
+	Id intern(StringRef name, bool& inserted) {
+		uint64_t const h = hash_bytes(name.data, name.size);
+		size_t i = probe(_cur, name.data, name.size, h);
+		if (i != no_slot) {
+			inserted = false;
+			return _cur.slots[i].key - 1;
+		}
+		i = probe(_old, name.data, name.size, h);
+		if (i != no_slot) {
+			inserted = false;
+			return _old.slots[i].key - 1;
+		}
+		inserted = true;
+		migrate(migrate_step);
+		maybe_start_generation();
+		Id const id = allocate(name.str());
+		place(_cur, id, h);
+		return id;
+	}
+
+	/**
+		Intern a name, if it isn't already.
+
+		@param name the name.
+		@return the id of the name.
+	*/
+	Id intern(StringRef name) {
+		bool inserted;
+		return intern(name, inserted);
+	}
+
+	/**
+		Release an id. The name is freed and the id may be handed out again
+		by a later intern().
+
+		@param id id of an interned name.
+	*/
+	void release(Id id) {
+		std::string& name = _names[id / chunk_ids][id % chunk_ids];
+		uint64_t const h = hash_bytes(name.data(), name.size());
+		Table* t = &_cur;
+		size_t i = probe(_cur, name.data(), name.size(), h);
+		if (i == no_slot) {
+			t = &_old;
+			i = probe(_old, name.data(), name.size(), h);
+		}
+		t->slots[i].key = tombstone;
+		--t->live;
+		std::string().swap(name);
+		_free.push_back(id);
+		migrate(migrate_step);
+		maybe_start_generation();
+	}
+
+	/**
+		Name of an id.
+
+		@param id id of an interned name.
+		@return the name.
+	*/
+	std::string const& name(Id id) const {
+		return _names[id / chunk_ids][id % chunk_ids];
+	}
+
+	/**
+		Number of interned names.
+
+		@return the number of live ids.
+	*/
+	size_t size() const {
+		return _num_ids - _free.size();
+	}
+
+	/**
+		Size of the id space. Every id handed out is less than this.
+
+		@return one past the largest id ever handed out.
+	*/
+	size_t id_capacity() const {
+		return _num_ids;
+	}
+
+	/**
+		Heap memory held, in parts: the names (released ones included, until
+		their ids are reused), the hash index over both generations, and
+		the list of released ids. Takes time linear in the ids handed out.
+
+		@return the account.
+	*/
+	MemoryUsage memory_usage() const {
+		size_t strings = MemoryUsage::of(_names);
+		for (std::vector<std::string> const& chunk : _names) {
+			strings += MemoryUsage::of(chunk);
+			for (std::string const& name : chunk) {
+				strings += MemoryUsage::of(name);
+			}
+		}
+		MemoryUsage m;
+		m.add("names", strings);
+		m.add("name_index", _cur.bytes() + _old.bytes());
+		m.add("free_ids", MemoryUsage::of(_free));
+		return m;
+	}
+
+	/* Testing & Debugging */
+
+	/**
+		Number of hash table slots over both generations.
+
+		@return the number of slots.
+	*/
+	size_t num_slots() const {
+		return _cur.capacity + _old.capacity;
+	}
+
+	/**
+		Whether an old generation is still being drained.
+
+		@return true while compaction is in progress.
+	*/
+	bool compacting() const {
+		return _old.capacity != 0;
+	}
+};  // class NameTable
+
+}  // namespace victor
+
+#endif  // NAME_TABLE_HPP_
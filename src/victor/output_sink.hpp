@@ -0,0 +1,526 @@
+/**
+    Insight Data Engineering Code Challenge
+    output_sink.hpp
+
+    Purpose:
+
+    Output sinks take one MedianEvent per payment (the payment's time, the
+    new median degree and the number of active vertices and edges) and
+    write it out. TextSink writes the median alone with two decimals, the
+    format of the challenge. JsonLinesSink writes every field as one JSON
+    object per line, for consumers that want structured output.
+
+    Neither goes through iostream formatting or builds a json object.
+    Numbers are formatted by NumberFormat straight into an OutputBuffer,
+    which hands the bytes to the stream's buffer in large chunks. The
+    JSON serializer is generated from a list of fields (JsonFields) at
+    compile time: keys are copied as literals, and each value is written
+    by the overload for its type. Doubles are written in their shortest
+    form that reads back as the same double, and neither sink depends on
+    the C locale.
+
+    @author Victor Chen
+*/
+#ifndef OUTPUT_SINK_HPP_
+#define OUTPUT_SINK_HPP_
+
+#include "json/json.hpp"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+namespace victor {
+
+/**
+	The state of the graph after one payment.
+*/
+struct MedianEvent {
+	time_t created_time = 0;
+	double median = 0;
+	size_t num_vertices = 0;	// vertices with an edge inside the window
+	size_t num_edges = 0;		// edges inside the window
+	int64_t triangles = -1;		// triangles inside the window, -1 if not counted
+};
+
+/**
+	A time to be written as an ISO 8601 UTC timestamp.
+*/
+struct Timestamp {
+	time_t t;
+};
+
+/**
+	Number Format
+
+	Each function writes a number at p, without a terminating '\0', and
+	returns one past the last character written.
+*/
+class NumberFormat {
+private:
+	/**
+		Replace the locale's decimal point in a number printed by snprintf
+		with '.'.
+
+		@param first first character of the number.
+		@param last one past its last character.
+		@return the new end of the number.
+	*/
+	static char* c_locale(char* first, char* last) {
+		char* p = first;
+		while (p != last && (('0' <= *p && *p <= '9') || *p == '-')) {
+			++p;
+		}
+		if (p == last || *p == '.' || *p == 'e') {
+			return last;
+		}
+		char* q = p;
+		while (q != last && !('0' <= *q && *q <= '9') && *q != 'e') {
+			++q;
+		}
+		if (q == last) {
+			return last;	// inf or nan
+		}
+		*p++ = '.';
+		memmove(p, q, size_t(last - q));
+		return p + (last - q);
+	}
+
+	/**
+		Write m with k digits after the decimal point, and at least one
+		before it.
+	*/
+	static char* decimal(char* p, uint64_t m, int k) {
+		char* const end = integer(p, m);
+		int const n = int(end - p);
+		if (n <= k) {
+			// 0.00ddd
+			int const shift = k - n + 2;
+			memmove(p + shift, p, size_t(n));
+			p[0] = '0';
+			p[1] = '.';
+			memset(p + 2, '0', size_t(k - n));
+			return end + shift;
+		}
+		if (k == 0) {
+			end[0] = '.';
+			end[1] = '0';
+			return end + 2;
+		}
+		memmove(end - k + 1, end - k, size_t(k));
+		end[-k] = '.';
+		return end + 1;
+	}
+
+public:
+	/**
+		Longest output of fixed2() and of shortest().
+	*/
+	static size_t const max_fixed2 = 320;
+	static size_t const max_shortest = 32;
+
+	/**
+		Write an unsigned integer.
+	*/
+	static char* integer(char* p, uint64_t v) {
+		static char const pairs[] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+		static uint64_t const limits[] = {
+			10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+			100000000u, 1000000000u, 10000000000u, 100000000000u,
+			1000000000000u, 10000000000000u, 100000000000000u,
+			1000000000000000u, 10000000000000000u, 100000000000000000u,
+			1000000000000000000u, 10000000000000000000u
+		};
+		int n = 1;	// number of digits
+		while (n != 20 && v >= limits[n - 1]) {
+			++n;
+		}
+		char* q = p + n;
+		while (v >= 100) {
+			unsigned const i = unsigned(v % 100) * 2;
+			v /= 100;
+			*--q = pairs[i + 1];
+			*--q = pairs[i];
+		}
+		if (v >= 10) {
+			*--q = pairs[v * 2 + 1];
+			*--q = pairs[v * 2];
+		} else {
+			*--q = char('0' + v);
+		}
+		return p + n;
+	}
+
+	/**
+		Write a signed integer.
+	*/
+	static char* integer(char* p, int64_t v) {
+		if (v < 0) {
+			*p++ = '-';
+			return integer(p, uint64_t(0) - uint64_t(v));
+		}
+		return integer(p, uint64_t(v));
+	}
+
+	/**
+		Write a double with two digits after the decimal point, exactly as
+		printf("%.2f") does in the C locale.
+	*/
+	static char* fixed2(char* p, double d) {
+		// if d * 100 rounds to an integer below 2^52, no half-way case is
+		// possible and that integer is also what printf rounds to
+		double const x = std::fabs(d) * 100;
+		if (x < 4503599627370496.0 && x == std::floor(x)) {
+			if (std::signbit(d)) {
+				*p++ = '-';
+			}
+			return decimal(p, uint64_t(x), 2);
+		}
+		int const n = snprintf(p, max_fixed2, "%.2f", d);
+		return c_locale(p, p + n);
+	}
+
+	/**
+		Write a double in JSON syntax, with the fewest significant digits
+		that read back as the same double. NaN and infinities are written
+		as null, as json.hpp does.
+	*/
+	static char* shortest(char* p, double d) {
+		if (!std::isfinite(d)) {
+			memcpy(p, "null", 4);
+			return p + 4;
+		}
+		if (std::signbit(d)) {
+			*p++ = '-';
+			d = -d;
+		}
+		if (d == 0) {
+			memcpy(p, "0.0", 3);
+			return p + 3;
+		}
+
+		// Fewest digits after the decimal point first: m / 10^k is
+		// correctly rounded when m < 2^53 and 10^k is exact, so it is the
+		// double the parser reads back.
+		static double const pow10[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		for (int k = 0; k != 23 && d * pow10[k] < 9007199254740992.0; ++k) {
+			double const x = d * pow10[k];
+			uint64_t const m = uint64_t(x + 0.5);
+			if (double(m) / pow10[k] == d) {
+				return decimal(p, m, k);
+			}
+			// Rounding x may have moved it across a half-way point. A
+			// neighbour of m can only read back as d if the spacing of
+			// doubles near x is a good part of 1.
+			if (x >= 1125899906842624.0) {
+				if (m != 0 && double(m - 1) / pow10[k] == d) {
+					return decimal(p, m - 1, k);
+				}
+				if (double(m + 1) / pow10[k] == d) {
+					return decimal(p, m + 1, k);
+				}
+			}
+		}
+
+		// Otherwise the fewest significant digits, by binary search: if
+		// the correctly rounded n-digit value reads back as d, so does the
+		// (n + 1)-digit one.
+		char buf[max_shortest];
+		int lo = 1;
+		int hi = 17;
+		while (lo < hi) {
+			int const mid = (lo + hi) / 2;
+			int const n = snprintf(buf, sizeof(buf), "%.*e", mid - 1, d);
+			if (nlohmann::float_parser::parse(buf, c_locale(buf, buf + n)) == d) {
+				hi = mid;
+			} else {
+				lo = mid + 1;
+			}
+		}
+		int const n = snprintf(buf, sizeof(buf), "%.*e", lo - 1, d);
+		size_t const len = size_t(c_locale(buf, buf + n) - buf);
+		memcpy(p, buf, len);
+		return p + len;
+	}
+
+	/**
+		Write a time as YYYY-MM-DDTHH:MM:SSZ.
+	*/
+	static char* iso_time(char* p, time_t t) {
+		int64_t const secs = int64_t(t);
+		int64_t days = secs / 86400;
+		int64_t rem = secs % 86400;
+		if (rem < 0) {
+			rem += 86400;
+			--days;
+		}
+		// civil date from days since 1970-01-01
+		days += 719468;
+		int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+		unsigned const doe = unsigned(days - era * 146097);
+		unsigned const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+		unsigned const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+		unsigned const mp = (5 * doy + 2) / 153;
+		unsigned const mday = doy - (153 * mp + 2) / 5 + 1;
+		unsigned const mon = mp < 10 ? mp + 3 : mp - 9;
+		int64_t const year = int64_t(yoe) + era * 400 + (mon <= 2);
+
+		if (year < 0) {
+			*p++ = '-';
+		}
+		uint64_t const y = uint64_t(year < 0 ? -year : year);
+		for (uint64_t scale = 1000; scale > 1 && y < scale; scale /= 10) {
+			*p++ = '0';
+		}
+		p = integer(p, y);
+		unsigned const fields[] = {
+			mon, mday, unsigned(rem / 3600), unsigned(rem / 60 % 60), unsigned(rem % 60)
+		};
+		for (int i = 0; i < 5; ++i) {
+			*p++ = "--T::"[i];
+			*p++ = char('0' + fields[i] / 10);
+			*p++ = char('0' + fields[i] % 10);
+		}
+		*p++ = 'Z';
+		return p;
+	}
+};  // class NumberFormat
+
+/**
+	Output Buffer
+
+	Collects output in a buffer and hands it to a stream buffer whenever
+	the buffer fills up. A stream buffer that takes less than it is given
+	marks the stream bad, as ostream::write() would.
+*/
+class OutputBuffer {
+private:
+	std::ostream& _os;
+	std::streambuf* _sb;
+	std::vector<char> _buf;
+	size_t _end = 0;	// end of the data in _buf
+
+public:
+	/**
+		@param os stream to write to.
+		@param size bytes buffered before they are handed to os.
+	*/
+	explicit OutputBuffer(std::ostream& os, size_t size = 1 << 16)
+		: _os(os), _sb(os.rdbuf()), _buf(size < 1 ? 1 : size) {}
+
+	~OutputBuffer() {
+		flush();
+	}
+
+	OutputBuffer(OutputBuffer const&) = delete;
+	OutputBuffer& operator=(OutputBuffer const&) = delete;
+
+	/**
+		Make room for n bytes.
+
+		@param n bytes about to be written.
+		@return where to write them; pass the new end to commit().
+	*/
+	char* reserve(size_t n) {
+		if (_buf.size() - _end < n) {
+			flush();
+			if (_buf.size() < n) {
+				_buf.resize(n);
+			}
+		}
+		return _buf.data() + _end;
+	}
+
+	/**
+		Keep what was written since reserve().
+
+		@param end one past the last byte written.
+	*/
+	void commit(char* end) {
+		_end = size_t(end - _buf.data());
+	}
+
+	/**
+		Write n bytes.
+	*/
+	void write(char const* s, size_t n) {
+		char* const p = reserve(n);
+		memcpy(p, s, n);
+		commit(p + n);
+	}
+
+	/**
+		Hand everything buffered to the stream.
+	*/
+	void flush() {
+		if (_end != 0 && (_sb == nullptr ||
+				_sb->sputn(_buf.data(), std::streamsize(_end)) != std::streamsize(_end))) {
+			_os.setstate(std::ios::badbit);
+		}
+		_end = 0;
+	}
+};  // class OutputBuffer
+
+/**
+	The fields of an event type that JsonLinesSink writes, in order. A
+	specialization defines
+
+		template <typename Writer>
+		static void write(Writer& w, Event const& e);
+
+	calling w.field("key", value) for each field.
+*/
+template <typename Event>
+struct JsonFields;
+
+template <>
+struct JsonFields<MedianEvent> {
+	template <typename Writer>
+	static void write(Writer& w, MedianEvent const& e) {
+		w.field("created_time", Timestamp{e.created_time});
+		w.field("median", e.median);
+		w.field("vertices", uint64_t(e.num_vertices));
+		w.field("edges", uint64_t(e.num_edges));
+		if (e.triangles >= 0) {
+			w.field("triangles", e.triangles);
+		}
+	}
+};
+
+/**
+	Text Sink
+
+	Writes the median of each event on its own line, with two decimals,
+	and the number of triangles after it if they are counted.
+*/
+class TextSink {
+private:
+	OutputBuffer _out;
+
+public:
+	explicit TextSink(std::ostream& os) : _out(os) {}
+
+	void write(MedianEvent const& e) {
+		char* p = _out.reserve(NumberFormat::max_fixed2 + 22);
+		p = NumberFormat::fixed2(p, e.median);
+		if (e.triangles >= 0) {
+			*p++ = ' ';
+			p = NumberFormat::integer(p, e.triangles);
+		}
+		*p++ = '\n';
+		_out.commit(p);
+	}
+
+	void flush() {
+		_out.flush();
+	}
+};  // class TextSink
+
+/**
+	JSON Lines Sink
+
+	Writes each event as one JSON object per line, with the fields given
+	by JsonFields<Event>. Keys must not need escaping.
+*/
+template <typename Event>
+class JsonLinesSink {
+private:
+	/**
+		Writes the fields of one event.
+	*/
+	class Writer {
+	private:
+		OutputBuffer& _out;
+		char _sep = '{';	// what goes before the next key
+
+		/**
+			Write a key and make room for its value.
+
+			@param key the key, without quotes.
+			@param n length of the key.
+			@param value_size the longest the value can be.
+			@return where to write the value.
+		*/
+		char* key(char const* key, size_t n, size_t value_size) {
+			char* p = _out.reserve(n + 4 + value_size);
+			*p++ = _sep;
+			*p++ = '"';
+			memcpy(p, key, n);
+			p += n;
+			*p++ = '"';
+			*p++ = ':';
+			_sep = ',';
+			return p;
+		}
+
+	public:
+		explicit Writer(OutputBuffer& out) : _out(out) {}
+
+		template <size_t N>
+		void field(char const (&k)[N], uint64_t v) {
+			_out.commit(NumberFormat::integer(key(k, N - 1, 20), v));
+		}
+
+		template <size_t N>
+		void field(char const (&k)[N], int64_t v) {
+			_out.commit(NumberFormat::integer(key(k, N - 1, 20), v));
+		}
+
+		template <size_t N>
+		void field(char const (&k)[N], double v) {
+			_out.commit(NumberFormat::shortest(key(k, N - 1,
+				NumberFormat::max_shortest), v));
+		}
+
+		template <size_t N>
+		void field(char const (&k)[N], Timestamp v) {
+			// a 64-bit time_t can have an 11-digit year
+			char* p = key(k, N - 1, 40);
+			*p++ = '"';
+			p = NumberFormat::iso_time(p, v.t);
+			*p++ = '"';
+			_out.commit(p);
+		}
+
+		/**
+			Close the object and the line.
+		*/
+		void end() {
+			char* p = _out.reserve(3);
+			if (_sep == '{') {
+				*p++ = '{';
+			}
+			*p++ = '}';
+			*p++ = '\n';
+			_out.commit(p);
+		}
+	};
+
+	OutputBuffer _out;
+
+public:
+	explicit JsonLinesSink(std::ostream& os) : _out(os) {}
+
+	void write(Event const& e) {
+		Writer w(_out);
+		JsonFields<Event>::write(w, e);
+		w.end();
+	}
+
+	void flush() {
+		_out.flush();
+	}
+};  // class JsonLinesSink
+
+}  // namespace victor
+
+#endif  // OUTPUT_SINK_HPP_
@@ -0,0 +1,392 @@
+/**
+    Insight Data Engineering Code Challenge
+    parallel_replay.hpp
+
+    Purpose:
+
+    ParallelReplay is an offline way to run a large file of JSON lines on
+    several threads, with the same output, byte for byte, as MedDegStream
+    (defined in src/victor/med_deg_stream.hpp) running it alone.
+
+    What the graph holds after a payment depends only on the payments of
+    the last 60 seconds before the latest one so far. So the file is cut
+    into chunks of lines, and each chunk is run by a worker with a graph of
+    its own, warmed up first on the payments before the chunk that the
+    graph would still hold at its start.
+
+    The input is mapped into memory, or read into it if it is compressed,
+    and cut into blocks of lines. A first
+    parallel pass parses every block and keeps its latest valid time;
+    skipped records are left out, since they don't move the window. The
+    running maximum of those times gives, for the start of each chunk, the
+    latest time L so far. No payment before the first block whose running
+    maximum is past L - 60 can be in the window there, however out of order
+    the file is, since no later time than the maximum had been seen when
+    it came. A worker replays from that block to its chunk's start without
+    output, which leaves its graph with the payments, the edges and the
+    latest time of the sequential run (some of the replayed payments may
+    not have been in the window, but those expire by the time the latest
+    one, L, is replayed). It then runs its chunk, keeping the medians, and
+    the messages about skipped records, in memory. A chunk's output is
+    written out, and let go, as soon as every chunk before it has been.
+
+    Workers take chunks from a shared counter, one at a time and in order,
+    on a fixed set of threads. Chunks are cut to about 64 MiB of input,
+    and at least one per thread, so only the output of the few chunks
+    being run, or waiting on an earlier one, is held at once. A mapped
+    input's pages are the kernel's to drop and to read back.
+
+    @author Victor Chen
+*/
+#ifndef PARALLEL_REPLAY_HPP_
+#define PARALLEL_REPLAY_HPP_
+
+#include "victor/med_deg_stream.hpp"
+#include "victor/rolling_median.hpp"
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace victor {
+
+/**
+	Parallel Replay
+*/
+class ParallelReplay {
+private:
+	/**
+		@return the latest time of a block with no valid record.
+	*/
+	static time_t no_time() {
+		return std::numeric_limits<time_t>::min();
+	}
+
+	/**
+		A run of whole lines, and the latest valid time in it.
+	*/
+	struct Block {
+		size_t begin;
+		size_t end;
+		time_t latest;
+	};
+
+	/**
+		What a worker writes for a chunk, until it is written out.
+	*/
+	struct ChunkOutput {
+		std::string medians;
+		std::string messages;
+		bool done = false;
+	};
+
+	std::string _in_filename;
+	std::string _out_filename;
+	unsigned _num_threads;
+	MedDegStream::Output _output;
+	bool _triangles = false;	// counted
+	size_t _block_size;
+	size_t _chunk_size;
+	void* _map = MAP_FAILED;	// the input, if it is mapped
+	size_t _map_size = 0;
+	std::string _text;			// the input, if it is read
+	char const* _data = nullptr;	// the input, either way
+	size_t _size = 0;
+	std::string _error;			// from opening or decompressing the input
+	std::vector<Block> _blocks;
+
+	std::mutex _write_mutex;
+	std::vector<ChunkOutput> _outputs;
+	size_t _written = 0;		// chunks written out
+	std::ofstream _ofs;
+
+	/**
+		Map the input into memory if it is a plain file; otherwise read
+		it whole, decompressing it.
+	*/
+	void read_input() {
+		int const fd = open(_in_filename.c_str(), O_RDONLY | O_CLOEXEC);
+		struct stat st;
+		if (fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			size_t const size = size_t(st.st_size);
+			void* const map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (map != MAP_FAILED && CompressedInput::detect(
+					static_cast<char const*>(map), size) == CompressedInput::plain) {
+				madvise(map, size, MADV_SEQUENTIAL);
+				_map = map;
+				_map_size = size;
+				_data = static_cast<char const*>(map);
+				_size = size;
+				close(fd);
+				return;
+			}
+			if (map != MAP_FAILED) {
+				munmap(map, size);
+			}
+		}
+		if (fd >= 0) {
+			close(fd);
+		}
+		LineReader lines(CompressedInput::open(_in_filename.c_str()));
+		if (lines.input() == nullptr) {
+			_error = "cannot read " + _in_filename;
+			return;
+		}
+		char const* first;
+		char const* last;
+		while (lines.next_block(first, last)) {
+			_text.append(first, last);
+		}
+		CompressedInput const* const compressed =
+			dynamic_cast<CompressedInput const*>(lines.input());
+		if (compressed != nullptr && compressed->failed()) {
+			_error = compressed->error();
+		}
+		_data = _text.data();
+		_size = _text.size();
+	}
+
+	/**
+		Cut the input into blocks of whole lines, of about the block size.
+	*/
+	void cut_blocks() {
+		size_t begin = 0;
+		while (begin < _size) {
+			size_t end = begin + _block_size;
+			if (end >= _size) {
+				end = _size;
+			} else {
+				char const* const nl = static_cast<char const*>(
+					memchr(_data + end, '\n', _size - end));
+				end = nl == nullptr ? _size : size_t(nl - _data) + 1;
+			}
+			Block const b = { begin, end, no_time() };
+			_blocks.push_back(b);
+			begin = end;
+		}
+	}
+
+	/**
+		Run a job for each of [0, n) on the threads.
+	*/
+	void parallel_for(size_t n, std::function<void(size_t)> const& job) const {
+		std::atomic<size_t> next(0);
+		auto const work = [&next, n, &job]() {
+			for (size_t i; (i = next++) < n; ) {
+				job(i);
+			}
+		};
+		std::vector<std::thread> threads;
+		for (unsigned t = 1; t < _num_threads && t < n; ++t) {
+			threads.emplace_back(work);
+		}
+		work();
+		for (std::thread& t : threads) {
+			t.join();
+		}
+	}
+
+	/**
+		Read the records of the blocks [first, last), as process_json()
+		does.
+
+		@param f called with the status and the record of each line.
+	*/
+	template <typename F>
+	void for_each_record(size_t first, size_t last, F const& f) const {
+		VenmoRecordReader reader;
+		VenmoRecord rec;
+		StructuralIndex index;
+		for (size_t b = first; b < last; ++b) {
+			char const* const block = _data + _blocks[b].begin;
+			char const* const block_end = _data + _blocks[b].end;
+			index.build(block, block_end);
+			char const* line;
+			char const* line_end;
+			uint32_t const* pos;
+			uint32_t const* pos_end;
+			while (index.next_line(line, line_end, pos, pos_end)) {
+				f(reader.read(line, line_end, block, pos, pos_end, rec), rec);
+			}
+		}
+	}
+
+	/**
+		Note that a chunk is done, and write out every chunk done whose
+		chunks before it have all been written, letting go of each.
+	*/
+	void chunk_done(size_t c) {
+		std::lock_guard<std::mutex> lock(_write_mutex);
+		_outputs[c].done = true;
+		for (; _written < _outputs.size() && _outputs[_written].done; ++_written) {
+			ChunkOutput& out = _outputs[_written];
+			_ofs.write(out.medians.data(), std::streamsize(out.medians.size()));
+			std::cout << out.messages;
+			std::string().swap(out.medians);
+			std::string().swap(out.messages);
+		}
+	}
+
+	/**
+		Run a chunk: warm up on [warm_up, first) quietly, then run
+		[first, last).
+	*/
+	template <typename Sink>
+	void run_chunk(size_t warm_up, size_t first, size_t last,
+				   ChunkOutput& out) const {
+		RollingMedian rolling;
+		if (_triangles) {
+			rolling.count_triangles();
+		}
+		for_each_record(warm_up, first,
+			[&rolling](VenmoRecordReader::Status status, VenmoRecord const& rec) {
+				if (status == VenmoRecordReader::ok) {
+					rolling.push(rec.actor, rec.target, rec.created_time);
+				}
+			});
+
+		std::ostringstream medians;
+		std::ostringstream messages;
+		{
+			Sink sink(medians);
+			for_each_record(first, last,
+				[&](VenmoRecordReader::Status status, VenmoRecord const& rec) {
+					if (status != VenmoRecordReader::ok) {
+						messages << VenmoRecordReader::describe(status) << '\n';
+						return;
+					}
+					rolling.push(rec.actor, rec.target, rec.created_time, sink);
+				});
+			sink.flush();
+		}
+		out.medians = medians.str();
+		out.messages = messages.str();
+	}
+
+	template <typename Sink>
+	void run() {
+		// the latest valid time of each block, then the running maximum
+		parallel_for(_blocks.size(), [this](size_t b) {
+			time_t latest = no_time();
+			for_each_record(b, b + 1,
+				[&latest](VenmoRecordReader::Status status, VenmoRecord const& rec) {
+					if (status == VenmoRecordReader::ok && rec.created_time > latest) {
+						latest = rec.created_time;
+					}
+				});
+			_blocks[b].latest = latest;
+		});
+		std::vector<time_t> running(_blocks.size());
+		time_t latest = no_time();
+		for (size_t b = 0; b < _blocks.size(); ++b) {
+			running[b] = latest = std::max(latest, _blocks[b].latest);
+		}
+
+		// chunks of about equal size, in blocks
+		size_t const num_chunks = std::min(_blocks.size(), std::max<size_t>(
+			_num_threads, (_size + _chunk_size - 1) / _chunk_size));
+		if (num_chunks == 0) {
+			return;
+		}
+		std::vector<size_t> starts;
+		for (size_t c = 0; c <= num_chunks; ++c) {
+			starts.push_back(_blocks.size() * c / num_chunks);
+		}
+		_outputs.resize(num_chunks);
+		parallel_for(num_chunks, [&](size_t c) {
+			size_t const first = starts[c];
+			size_t warm_up = first;
+			if (first != 0 && running[first - 1] != no_time()) {
+				time_t const window_start = running[first - 1] - 60;
+				warm_up = size_t(std::upper_bound(running.begin(),
+					running.begin() + ptrdiff_t(first), window_start) -
+					running.begin());
+			}
+			run_chunk<Sink>(warm_up, first, starts[c + 1], _outputs[c]);
+			chunk_done(c);
+		});
+	}
+
+public:
+	/**
+		@param in_filename file of JSON lines to read records from.
+		@param out_filename file to write medians to.
+		@param num_threads threads to run on; 0 for one per hardware thread.
+		@param output what to write for each payment.
+		@param block_size bytes of input parsed at a time.
+		@param chunk_size bytes of input, about, run by a worker at a time.
+	*/
+	ParallelReplay(char const* in_filename, char const* out_filename,
+				   unsigned num_threads, MedDegStream::Output output = MedDegStream::text,
+				   size_t block_size = 1 << 16, size_t chunk_size = size_t(1) << 26)
+		: _in_filename(in_filename), _out_filename(out_filename),
+		  _num_threads(num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency())
+			  : num_threads),
+		  _output(output), _block_size(block_size < 1 ? 1 : block_size),
+		  _chunk_size(chunk_size < 1 ? 1 : chunk_size) {}
+
+	~ParallelReplay() {
+		if (_map != MAP_FAILED) {
+			munmap(_map, _map_size);
+		}
+	}
+
+	ParallelReplay(ParallelReplay const&) = delete;
+	ParallelReplay& operator=(ParallelReplay const&) = delete;
+
+	/**
+		Count the triangles in the window, and write their number with
+		each median. The warm-up leaves each chunk's graph with the
+		triangles a single run would have.
+	*/
+	void count_triangles() {
+		_triangles = true;
+	}
+
+	/**
+		Run the input, writing to the output file.
+
+		@return false, with a message, if the input was cut short by an
+		error or the output couldn't all be written.
+	*/
+	bool process() {
+		_ofs.open(_out_filename.c_str(), std::ofstream::out);
+		read_input();
+		cut_blocks();
+		if (_output == MedDegStream::text) {
+			run<TextSink>();
+		} else {
+			run<JsonLinesSink<MedianEvent>>();
+		}
+		_ofs.flush();
+		bool ok = true;
+		if (!_error.empty()) {
+			std::cout << _error << std::endl;
+			ok = false;
+		}
+		if (!_ofs) {
+			std::cout << "cannot write " << _out_filename << std::endl;
+			ok = false;
+		}
+		std::cout.flush();
+		return ok;
+	}
+};  // class ParallelReplay
+
+}  // namespace victor
+
+#endif  // PARALLEL_REPLAY_HPP_
@@ -0,0 +1,278 @@
+/**
+    Insight Data Engineering Code Challenge
+    published_state.hpp
+
+    Purpose:
+
+    PublishedState lets other threads, or other processes on the same
+    host, read where the graph is (the median, the numbers of vertices and
+    edges, the latest time and the number of payments so far) while it
+    runs, without ever making the graph wait for them.
+
+    It is a seqlock. The one writer bumps a sequence number to odd, stores
+    the fields, and bumps it to even again. A reader loads the sequence
+    number, the fields, and the sequence number again; if both are the
+    same even number, no write overlapped the read and the fields are a
+    consistent snapshot. The writer takes no lock and never looks at the
+    readers, so it costs the writer a few stores per payment however many
+    readers there are. try_read() makes one attempt, and so never waits;
+    read() tries until it gets a snapshot, which only takes more than one
+    attempt if it overlaps a write, a few nanoseconds long. It gives up
+    after a while, though: a writer in another process that dies in the
+    middle of a write leaves the sequence number odd for good.
+
+    Every field is a lock-free std::atomic of 64 bits, so the block holds
+    no pointer and works the same mapped into another process. That is
+    what PublishedStateFile does: it maps a file (under /dev/shm, say, to
+    keep it in memory) holding a PublishedState, for writing or for
+    reading. The file stays after the writer is done, with the last state
+    in it.
+
+    @author Victor Chen
+*/
+#ifndef PUBLISHED_STATE_HPP_
+#define PUBLISHED_STATE_HPP_
+
+#include "victor/output_sink.hpp"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace victor {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+			  "a published state is shared between processes as 64-bit atomics");
+
+/**
+	A snapshot of the graph, after a payment.
+*/
+struct GraphState {
+	time_t latest_time = 0;		// latest time so far; 0 before the first payment
+	double median = 0;
+	uint64_t num_vertices = 0;
+	uint64_t num_edges = 0;
+	uint64_t payments = 0;		// given to the graph so far, dropped ones too
+};
+
+template <>
+struct JsonFields<GraphState> {
+	template <typename Writer>
+	static void write(Writer& w, GraphState const& s) {
+		w.field("latest_time", Timestamp{s.latest_time});
+		w.field("median", s.median);
+		w.field("vertices", s.num_vertices);
+		w.field("edges", s.num_edges);
+		w.field("payments", s.payments);
+	}
+};
+
+/**
+	Published State
+
+	Written by one thread at a time; read by any number.
+*/
+class alignas(64) PublishedState {
+private:
+	static uint64_t const magic = 0x7374617465763031ull;
+
+	std::atomic<uint64_t> _magic;		// set once the block is ready
+	std::atomic<uint64_t> _sequence;	// odd while a write is under way
+	std::atomic<int64_t> _latest_time;
+	std::atomic<uint64_t> _median;		// the bits of a double
+	std::atomic<uint64_t> _num_vertices;
+	std::atomic<uint64_t> _num_edges;
+	std::atomic<uint64_t> _payments;
+
+	friend class PublishedStateFile;
+
+public:
+	PublishedState()
+		: _magic(0), _sequence(0), _latest_time(0), _median(0),
+		  _num_vertices(0), _num_edges(0), _payments(0) {
+		_magic.store(magic, std::memory_order_release);
+	}
+
+	PublishedState(PublishedState const&) = delete;
+	PublishedState& operator=(PublishedState const&) = delete;
+
+	/**
+		Publish a snapshot. Only one thread may write at a time.
+	*/
+	void publish(GraphState const& s) {
+		uint64_t const seq = _sequence.load(std::memory_order_relaxed);
+		_sequence.store(seq + 1, std::memory_order_relaxed);
+		// the fields can't be stored before the sequence is odd
+		std::atomic_thread_fence(std::memory_order_release);
+		uint64_t median;
+		memcpy(&median, &s.median, sizeof median);
+		_latest_time.store(int64_t(s.latest_time), std::memory_order_relaxed);
+		_median.store(median, std::memory_order_relaxed);
+		_num_vertices.store(s.num_vertices, std::memory_order_relaxed);
+		_num_edges.store(s.num_edges, std::memory_order_relaxed);
+		_payments.store(s.payments, std::memory_order_relaxed);
+		_sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	/**
+		Read a snapshot, in one attempt.
+
+		@param s set to the snapshot, if there is one.
+		@return false if a write overlapped the read; s is then unchanged.
+	*/
+	bool try_read(GraphState& s) const {
+		uint64_t const seq = _sequence.load(std::memory_order_acquire);
+		if (seq & 1) {
+			return false;
+		}
+		int64_t const latest_time = _latest_time.load(std::memory_order_relaxed);
+		uint64_t const median = _median.load(std::memory_order_relaxed);
+		uint64_t const num_vertices = _num_vertices.load(std::memory_order_relaxed);
+		uint64_t const num_edges = _num_edges.load(std::memory_order_relaxed);
+		uint64_t const payments = _payments.load(std::memory_order_relaxed);
+		// the fields can't be loaded after the sequence is checked again
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (_sequence.load(std::memory_order_relaxed) != seq) {
+			return false;
+		}
+		s.latest_time = time_t(latest_time);
+		memcpy(&s.median, &median, sizeof median);
+		s.num_vertices = num_vertices;
+		s.num_edges = num_edges;
+		s.payments = payments;
+		return true;
+	}
+
+	/**
+		Read a snapshot, trying again while writes overlap the read, for
+		up to a time limit. A write takes nanoseconds, so only a writer
+		that stopped in the middle of one runs the limit out.
+
+		@param s set to the snapshot, if there is one.
+		@param timeout_seconds how long to keep trying.
+		@return false if no write left the state whole for that long; s
+		is then unchanged.
+	*/
+	bool read(GraphState& s, double timeout_seconds = 0.1) const {
+		std::chrono::steady_clock::time_point const deadline =
+			std::chrono::steady_clock::now() +
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<double>(timeout_seconds));
+		for (unsigned attempt = 1; !try_read(s); ++attempt) {
+			// a writer that was preempted mid-write needs the CPU back
+			if (attempt % 64 == 0) {
+				if (std::chrono::steady_clock::now() >= deadline) {
+					return false;
+				}
+				std::this_thread::yield();
+			}
+		}
+		return true;
+	}
+
+	/**
+		@return the number of snapshots published so far.
+	*/
+	uint64_t version() const {
+		return _sequence.load(std::memory_order_acquire) / 2;
+	}
+};  // class PublishedState
+
+/**
+	Published State File
+
+	A PublishedState in a file mapped into memory, shared with other
+	processes.
+*/
+class PublishedStateFile {
+private:
+	std::string _filename;
+	std::string _error;
+	void* _map = MAP_FAILED;
+	PublishedState* _state = nullptr;
+
+	void fail(char const* what) {
+		_error = std::string(what) + " " + _filename + ": " + strerror(errno);
+	}
+
+public:
+	/**
+		@param filename file to map.
+		@param writable true to create (or take over) the file and write
+			to it; false to read a file that a writer made.
+	*/
+	PublishedStateFile(char const* filename, bool writable) : _filename(filename) {
+		int const fd = open(filename, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+		if (fd < 0) {
+			fail("cannot open");
+			return;
+		}
+		struct stat st;
+		if (writable && ftruncate(fd, sizeof(PublishedState)) != 0) {
+			fail("cannot size");
+		} else if (fstat(fd, &st) != 0) {
+			fail("cannot stat");
+		} else if (size_t(st.st_size) < sizeof(PublishedState)) {
+			_error = _filename + " holds no published state";
+		} else {
+			_map = mmap(nullptr, sizeof(PublishedState),
+						writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+			if (_map == MAP_FAILED) {
+				fail("cannot map");
+			}
+		}
+		close(fd);
+		if (_map == MAP_FAILED) {
+			return;
+		}
+		if (writable) {
+			_state = new (_map) PublishedState;
+		} else if (static_cast<PublishedState*>(_map)->_magic.load(
+					   std::memory_order_acquire) != PublishedState::magic) {
+			_error = _filename + " holds no published state";
+		} else {
+			_state = static_cast<PublishedState*>(_map);
+		}
+	}
+
+	~PublishedStateFile() {
+		if (_map != MAP_FAILED) {
+			munmap(_map, sizeof(PublishedState));
+		}
+	}
+
+	PublishedStateFile(PublishedStateFile const&) = delete;
+	PublishedStateFile& operator=(PublishedStateFile const&) = delete;
+
+	bool is_open() const {
+		return _state != nullptr;
+	}
+
+	/**
+		What went wrong, if !is_open().
+	*/
+	std::string const& error() const {
+		return _error;
+	}
+
+	/**
+		@return the mapped state, or nullptr if !is_open(). Opened for
+		reading, it may only be read.
+	*/
+	PublishedState* state() {
+		return _state;
+	}
+};  // class PublishedStateFile
+
+}  // namespace victor
+
+#endif  // PUBLISHED_STATE_HPP_
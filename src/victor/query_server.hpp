@@ -0,0 +1,580 @@
+/**
+    Insight Data Engineering Code Challenge
+    query_server.hpp
+
+    Purpose:
+
+    QueryServer answers questions about a running graph over a Unix domain
+    socket: a user's degree and counterparties, the median, a quantile of
+    the degrees, and the size of the graph.
+
+    A client sends one query per line, and gets one JSON object per line
+    back, in order:
+
+        degree <user>        {"user":...,"degree":n}
+        counterparties <user>
+                             {"user":...,"counterparties":[{"user":...,
+                              "created_time":...},...]}
+        median               {"median":m}
+        quantile <q>         {"quantile":q,"degree":n}   (q from 0 to 1)
+        stats                {"latest_time":...,"median":m,"vertices":n,
+                              "edges":n}
+
+    Every reply also has "payments", the number of payments the graph had
+    been given when it was answered, and a query it can't make out gets
+    {"error":...}.
+
+    The sockets are served by a thread of its own, on an epoll loop: it
+    accepts clients, reads their queries and writes the replies out. The
+    graph isn't thread-safe, and a reply must agree with the latest
+    payment, so the queries are answered by the thread that owns the
+    graph, between payments: it calls answer() after each one, which
+    costs it one atomic load unless a query is waiting. The replies go
+    back to the loop, which is woken through an eventfd. A query waits for
+    the next payment; on a stream that pauses, its reply waits with it.
+
+    The graph's thread only does the lookups: it copies what a query asks
+    for out of the graph, and the loop turns that into JSON. It answers at
+    most a few queries per call of answer(), so that a burst of queries
+    delays the payments a little at a time, and at most 1024 queries may
+    wait in all. A client whose query finds no room gets
+    {"error":"too many queries waiting"} after the replies it is owed, and
+    is hung up on.
+
+    @author Victor Chen
+*/
+#ifndef QUERY_SERVER_HPP_
+#define QUERY_SERVER_HPP_
+
+#include "victor/venmo_graph.hpp"
+#include "victor/output_sink.hpp"
+#include "json/json.hpp"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace victor {
+
+/**
+	Query Server
+*/
+class QueryServer {
+private:
+	static size_t const max_query = 4096;	// longest line a client may send
+	static size_t const max_queued = 1024;	// queries waiting, of all clients
+
+	/**
+		A query, and the client it is from.
+	*/
+	struct Message {
+		uint64_t client;
+		std::string text;
+	};
+
+public:
+	static size_t const max_answered = 16;	// by default, per call of answer()
+
+	/**
+		What the graph had to say to a query, copied out of it so that the
+		reply can be written on another thread.
+	*/
+	struct Answer {
+		enum Kind {
+			bad_query,
+			degree_query,
+			counterparties_query,
+			median_query,
+			quantile_query,
+			stats_query
+		};
+
+		Kind kind = bad_query;
+		std::string text;			// the user, or what is wrong
+		uint64_t degree = 0;
+		double median = 0;
+		double quantile = 0;
+		std::vector<std::pair<std::string, time_t>> counterparties;
+		time_t latest_time = 0;
+		uint64_t vertices = 0;
+		uint64_t edges = 0;
+		uint64_t payments = 0;
+	};
+
+private:
+	/**
+		An answer, and the client it is for.
+	*/
+	struct Reply {
+		uint64_t client;
+		Answer answer;
+	};
+
+	/**
+		A connected client.
+	*/
+	struct Client {
+		int fd;
+		std::string in;				// read, not yet a whole line
+		std::string out;			// replies not yet written
+		std::string last;			// written once every reply is in
+		size_t in_flight = 0;		// queries not yet answered
+		uint32_t events = EPOLLIN;	// what it is polled for
+		bool hung_up = false;		// no more queries will come
+		bool gone = false;			// no more replies can go
+	};
+
+	std::string _path;
+	std::string _error;
+	int _listen_fd = -1;
+	int _epoll_fd = -1;
+	int _wake_fd = -1;			// eventfd: replies are ready, or stop
+	std::thread _thread;
+
+	std::mutex _mutex;
+	std::deque<Message> _queries;
+	std::vector<Reply> _replies;
+	std::atomic<bool> _pending;		// whether _queries has any
+	bool _stop = false;
+
+	void fail(char const* what) {
+		_error = std::string(what) + " " + _path + ": " + strerror(errno);
+	}
+
+	static void wake(int fd) {
+		uint64_t const one = 1;
+		ssize_t const n = write(fd, &one, sizeof one);
+		(void)n;
+	}
+
+	static std::string iso_time(time_t t) {
+		char buf[40];
+		return std::string(buf, NumberFormat::iso_time(buf, t));
+	}
+
+	/* The loop's thread */
+
+	void watch(int fd, uint64_t data, uint32_t events, int op) {
+		epoll_event ev = epoll_event();
+		ev.events = events;
+		ev.data.u64 = data;
+		epoll_ctl(_epoll_fd, op, fd, &ev);
+	}
+
+	/**
+		Write what a client has waiting, and poll it for what it can do
+		next: for queries until it hangs up, and for room to write while
+		replies are left. A client is closed once it has hung up and has
+		nothing left to get.
+	*/
+	void flush(std::map<uint64_t, Client>& clients, uint64_t id) {
+		Client& c = clients[id];
+		if (c.in_flight == 0 && !c.last.empty()) {
+			c.out += c.last;
+			c.last.clear();
+		}
+		while (!c.out.empty()) {
+			ssize_t const n = send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+			if (n < 0 && errno == EINTR) {
+				continue;
+			}
+			if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+				break;
+			}
+			if (n <= 0) {
+				c.gone = true;
+				break;
+			}
+			c.out.erase(0, size_t(n));
+		}
+		if (c.gone || (c.hung_up && c.out.empty() && c.in_flight == 0)) {
+			close(c.fd);
+			clients.erase(id);
+			return;
+		}
+		uint32_t const events = (c.hung_up ? 0u : uint32_t(EPOLLIN)) |
+			(c.out.empty() ? 0u : uint32_t(EPOLLOUT));
+		if (events != c.events) {
+			watch(c.fd, id, events, EPOLL_CTL_MOD);
+			c.events = events;
+		}
+	}
+
+	/**
+		Read what a client sent, and queue its whole lines as queries, as
+		many as there is room for.
+	*/
+	void receive(std::map<uint64_t, Client>& clients, uint64_t id) {
+		Client& c = clients[id];
+		std::vector<Message> queries;
+		char buf[4096];
+		for (;;) {
+			ssize_t const n = recv(c.fd, buf, sizeof buf, 0);
+			if (n < 0 && errno == EINTR) {
+				continue;
+			}
+			if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+				break;
+			}
+			if (n <= 0) {
+				c.hung_up = true;
+				break;
+			}
+			c.in.append(buf, size_t(n));
+			size_t begin = 0;
+			size_t nl;
+			while ((nl = c.in.find('\n', begin)) != std::string::npos) {
+				size_t end = nl;
+				if (end > begin && c.in[end - 1] == '\r') {
+					--end;
+				}
+				Message const q = { id, c.in.substr(begin, end - begin) };
+				queries.push_back(q);
+				begin = nl + 1;
+			}
+			c.in.erase(0, begin);
+			if (c.in.size() > max_query) {
+				c.last = "{\"error\":\"query too long\"}\n";
+				c.in.clear();
+				c.hung_up = true;
+				break;
+			}
+		}
+		if (!queries.empty()) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			size_t const room = _queries.size() < max_queued ? max_queued - _queries.size() : 0;
+			if (queries.size() > room) {
+				queries.resize(room);
+				c.last = "{\"error\":\"too many queries waiting\"}\n";
+				c.in.clear();
+				c.hung_up = true;
+			}
+			c.in_flight += queries.size();
+			_queries.insert(_queries.end(), std::make_move_iterator(queries.begin()),
+							std::make_move_iterator(queries.end()));
+			_pending.store(!_queries.empty(), std::memory_order_release);
+		}
+		flush(clients, id);
+	}
+
+	void run() {
+		std::map<uint64_t, Client> clients;
+		uint64_t next_id = 2;				// 0 and 1 are the listener and the eventfd
+		epoll_event events[64];
+		for (;;) {
+			int const n = epoll_wait(_epoll_fd, events, 64, -1);
+			for (int i = 0; i < n; ++i) {
+				uint64_t const id = events[i].data.u64;
+				if (id == 0) {
+					int fd;
+					while ((fd = accept4(_listen_fd, nullptr, nullptr,
+										 SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+						clients[next_id].fd = fd;
+						watch(fd, next_id++, EPOLLIN, EPOLL_CTL_ADD);
+					}
+				} else if (id == 1) {
+					uint64_t count;
+					ssize_t const r = read(_wake_fd, &count, sizeof count);
+					(void)r;
+					std::vector<Reply> replies;
+					{
+						std::lock_guard<std::mutex> lock(_mutex);
+						if (_stop) {
+							for (auto& c : clients) {
+								close(c.second.fd);
+							}
+							return;
+						}
+						replies.swap(_replies);
+					}
+					for (Reply const& r : replies) {
+						auto const it = clients.find(r.client);
+						if (it != clients.end()) {
+							it->second.out += format(r.answer);
+							--it->second.in_flight;
+						}
+					}
+					for (auto it = clients.begin(); it != clients.end(); ) {
+						uint64_t const c = (it++)->first;
+						flush(clients, c);
+					}
+				} else if (clients.count(id) != 0) {
+					Client& c = clients[id];
+					if (c.hung_up && (events[i].events & (EPOLLHUP | EPOLLERR))) {
+						c.gone = true;		// closed for good; drop its replies
+						flush(clients, id);
+					} else if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+						receive(clients, id);
+					} else if (events[i].events & EPOLLOUT) {
+						flush(clients, id);
+					}
+				}
+			}
+		}
+	}
+
+	/* The graph's thread */
+
+	/**
+		Parse the argument of a query, after its name.
+
+		@return whether the query is that name.
+	*/
+	static bool is(std::string const& query, char const* name, std::string& arg) {
+		size_t const n = strlen(name);
+		if (query.compare(0, n, name) != 0) {
+			return false;
+		}
+		if (query.size() == n) {
+			arg.clear();
+			return true;
+		}
+		if (query[n] != ' ') {
+			return false;
+		}
+		arg = query.substr(n + 1);
+		return true;
+	}
+
+	void answer_pending(VenmoGraph const& graph, size_t most) {
+		std::vector<Message> queries;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto const end = _queries.begin() +
+				ptrdiff_t(std::min(most, _queries.size()));
+			queries.assign(std::make_move_iterator(_queries.begin()),
+						   std::make_move_iterator(end));
+			_queries.erase(_queries.begin(), end);
+			_pending.store(!_queries.empty(), std::memory_order_relaxed);
+		}
+		std::vector<Reply> replies(queries.size());
+		for (size_t i = 0; i < queries.size(); ++i) {
+			replies[i].client = queries[i].client;
+			replies[i].answer = look_up(graph, queries[i].text);
+		}
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_replies.insert(_replies.end(), std::make_move_iterator(replies.begin()),
+							std::make_move_iterator(replies.end()));
+		}
+		wake(_wake_fd);
+	}
+
+public:
+	/**
+		@param path the socket's path; a socket already there is replaced,
+		but anything else there is left alone, and the server isn't opened.
+	*/
+	explicit QueryServer(char const* path) : _path(path), _pending(false) {
+		sockaddr_un addr = sockaddr_un();
+		addr.sun_family = AF_UNIX;
+		if (_path.size() >= sizeof addr.sun_path) {
+			_error = "socket path too long: " + _path;
+			return;
+		}
+		memcpy(addr.sun_path, _path.c_str(), _path.size() + 1);
+		_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (_listen_fd < 0) {
+			fail("cannot make a socket for");
+			return;
+		}
+		struct stat st;
+		if (lstat(path, &st) == 0) {
+			if (!S_ISSOCK(st.st_mode)) {
+				_error = "not a socket, won't replace: " + _path;
+				close(_listen_fd);
+				_listen_fd = -1;
+				return;
+			}
+			unlink(path);
+		} else if (errno != ENOENT) {
+			fail("cannot look at");
+			close(_listen_fd);
+			_listen_fd = -1;
+			return;
+		}
+		if (bind(_listen_fd, reinterpret_cast<sockaddr const*>(&addr), sizeof addr) != 0 ||
+			listen(_listen_fd, 64) != 0) {
+			fail("cannot listen on");
+			close(_listen_fd);
+			_listen_fd = -1;
+			return;
+		}
+		_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (_epoll_fd < 0 || _wake_fd < 0) {
+			fail("cannot poll");
+			return;
+		}
+		watch(_listen_fd, 0, EPOLLIN, EPOLL_CTL_ADD);
+		watch(_wake_fd, 1, EPOLLIN, EPOLL_CTL_ADD);
+		_thread = std::thread(&QueryServer::run, this);
+	}
+
+	~QueryServer() {
+		if (_thread.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			wake(_wake_fd);
+			_thread.join();
+		}
+		for (int fd : { _listen_fd, _epoll_fd, _wake_fd }) {
+			if (fd >= 0) {
+				close(fd);
+			}
+		}
+		if (_listen_fd >= 0) {
+			unlink(_path.c_str());
+		}
+	}
+
+	QueryServer(QueryServer const&) = delete;
+	QueryServer& operator=(QueryServer const&) = delete;
+
+	bool is_open() const {
+		return _thread.joinable();
+	}
+
+	/**
+		What went wrong, if !is_open().
+	*/
+	std::string const& error() const {
+		return _error;
+	}
+
+	/**
+		Answer the queries waiting, if any, oldest first. To be called by
+		the thread that owns the graph, whenever the graph is as it should
+		be seen.
+
+		@param graph the graph to answer from.
+		@param most the most queries to answer; the rest wait for the next
+		call.
+	*/
+	void answer(VenmoGraph const& graph, size_t most = max_answered) {
+		if (_pending.load(std::memory_order_acquire)) {
+			answer_pending(graph, most);
+		}
+	}
+
+	/**
+		Look a query up in the graph.
+
+		@param graph the graph to answer from.
+		@param query a query, without its newline.
+		@return what the reply needs from the graph.
+	*/
+	static Answer look_up(VenmoGraph const& graph, std::string const& query) {
+		Answer a;
+		std::string arg;
+		if (is(query, "degree", arg) && !arg.empty()) {
+			MedHeapMap const& vertices = graph.vertices();
+			a.kind = Answer::degree_query;
+			a.degree = vertices.contains(arg) ? vertices.degree(arg) : 0;
+			a.text = std::move(arg);
+		} else if (is(query, "counterparties", arg) && !arg.empty()) {
+			a.kind = Answer::counterparties_query;
+			a.counterparties = graph.counterparties(arg);
+			a.text = std::move(arg);
+		} else if (is(query, "median", arg) && arg.empty()) {
+			a.kind = Answer::median_query;
+			a.median = graph.vertices().median();
+		} else if (is(query, "quantile", arg) && !arg.empty()) {
+			char* end;
+			double const q = strtod(arg.c_str(), &end);
+			if (*end != '\0' || !(q >= 0 && q <= 1)) {
+				a.text = "quantile must be from 0 to 1";
+			} else {
+				a.kind = Answer::quantile_query;
+				a.quantile = q;
+				a.degree = graph.vertices().quantile(q);
+			}
+		} else if (is(query, "stats", arg) && arg.empty()) {
+			a.kind = Answer::stats_query;
+			a.latest_time = graph.latest_time();
+			a.median = graph.vertices().median();
+			a.vertices = graph.num_vertices();
+			a.edges = graph.num_edges();
+		} else {
+			a.text = "unknown query: " + query;
+		}
+		a.payments = graph.payments();
+		return a;
+	}
+
+	/**
+		Write the reply to a query.
+
+		@param a what the graph had to say.
+		@return the reply, a JSON object and a newline.
+	*/
+	static std::string format(Answer const& a) {
+		nlohmann::json reply;
+		switch (a.kind) {
+		case Answer::degree_query:
+			reply["user"] = a.text;
+			reply["degree"] = a.degree;
+			break;
+		case Answer::counterparties_query:
+			reply["user"] = a.text;
+			reply["counterparties"] = nlohmann::json::array();
+			for (auto const& c : a.counterparties) {
+				reply["counterparties"].push_back({ { "user", c.first },
+					{ "created_time", iso_time(c.second) } });
+			}
+			break;
+		case Answer::median_query:
+			reply["median"] = a.median;
+			break;
+		case Answer::quantile_query:
+			reply["quantile"] = a.quantile;
+			reply["degree"] = a.degree;
+			break;
+		case Answer::stats_query:
+			if (a.payments != 0) {
+				reply["latest_time"] = iso_time(a.latest_time);
+				reply["median"] = a.median;
+			}
+			reply["vertices"] = a.vertices;
+			reply["edges"] = a.edges;
+			break;
+		default:
+			reply["error"] = a.text;
+		}
+		reply["payments"] = a.payments;
+		return reply.dump() + '\n';
+	}
+
+	/**
+		Answer a query, on one thread.
+
+		@param graph the graph to answer from.
+		@param query a query, without its newline.
+		@return the reply, a JSON object and a newline.
+	*/
+	static std::string respond(VenmoGraph const& graph, std::string const& query) {
+		return format(look_up(graph, query));
+	}
+};  // class QueryServer
+
+}  // namespace victor
+
+#endif  // QUERY_SERVER_HPP_
@@ -0,0 +1,161 @@
+/**
+    Insight Data Engineering Code Challenge
+    reference_graph.hpp
+
+    Purpose:
+
+    ReferenceGraph answers the same questions as VenmoGraph - the median
+    degree, the number of vertices, edges and triangles after each
+    payment - by brute force: it keeps the payments in the window and, for
+    every payment, works the graph out from them again. It is slow
+    (O(n log n) per payment, n the payments in the window) and meant to be
+    obviously right, so that VenmoGraph and the engines built on it can be
+    checked against it (see src/victor/differential.hpp).
+
+    It is also where the rules are written down:
+
+    1. A payment is in the window if it is less than 60 seconds older than
+       the latest payment so far; the first payment is always in it.
+       Payments outside the window are dropped, and don't move it.
+    2. Two users are joined by an edge if a payment between them, in either
+       direction, is in the window. Paying the same user again doesn't add
+       another edge.
+    3. A payment to oneself joins nobody: it moves the window, like any
+       payment in it, but adds no edge and no vertex.
+    4. The degree of a user is the number of users it is joined to; users
+       with no edge are not in the graph. The median is taken over the
+       degrees of the users in the graph, and is 0 if there are none.
+    5. A triangle is three users each joined to the other two.
+
+    @author Victor Chen
+*/
+#ifndef REFERENCE_GRAPH_HPP_
+#define REFERENCE_GRAPH_HPP_
+
+#include <time.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace victor {
+
+/**
+	Reference Graph
+*/
+class ReferenceGraph {
+private:
+	struct Payment {
+		time_t created_time;
+		std::string actor;
+		std::string target;
+	};
+
+	std::vector<Payment> _payments;		// payments in the window
+	bool _started = false;
+	time_t _latest_time = 0;
+	size_t _num_vertices = 0;
+	size_t _num_edges = 0;
+	size_t _triangles = 0;
+	double _median = 0;
+
+	/**
+		Work out the graph from the payments in the window.
+	*/
+	void recompute() {
+		std::vector<std::pair<std::string, std::string>> edges;
+		for (Payment const& p : _payments) {
+			if (p.actor != p.target) {
+				edges.push_back(std::minmax(p.actor, p.target));
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+		std::map<std::string, size_t> degrees;
+		for (auto const& e : edges) {
+			++degrees[e.first];
+			++degrees[e.second];
+		}
+		std::map<std::string, std::set<std::string>> adjacent;
+		for (auto const& e : edges) {
+			adjacent[e.first].insert(e.second);
+			adjacent[e.second].insert(e.first);
+		}
+		// each triangle once, from its edge of the two least names
+		_triangles = 0;
+		for (auto const& e : edges) {
+			std::set<std::string> const& n = adjacent[e.second];
+			for (auto it = n.upper_bound(e.second); it != n.end(); ++it) {
+				_triangles += adjacent[e.first].count(*it);
+			}
+		}
+
+		std::vector<size_t> sorted;
+		for (auto const& d : degrees) {
+			sorted.push_back(d.second);
+		}
+		std::sort(sorted.begin(), sorted.end());
+
+		_num_edges = edges.size();
+		_num_vertices = sorted.size();
+		size_t const n = sorted.size();
+		if (n == 0) {
+			_median = 0;
+		} else if (n % 2 == 1) {
+			_median = double(sorted[n / 2]);
+		} else {
+			_median = double(sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+		}
+	}
+
+public:
+	/**
+		Add a payment, and return the median degree after it.
+
+		@param actor name of the Venmo payment actor.
+		@param target name of the Venmo payment target.
+		@param created_time time of the payment.
+		@return the current median.
+	*/
+	double extract_median(std::string actor, std::string target,
+						  time_t created_time) {
+		if (_started && created_time <= _latest_time - 60) {
+			return _median;
+		}
+		if (!_started || created_time > _latest_time) {
+			_started = true;
+			_latest_time = created_time;
+		}
+		Payment p = { created_time, std::move(actor), std::move(target) };
+		_payments.push_back(std::move(p));
+		_payments.erase(std::remove_if(_payments.begin(), _payments.end(),
+			[this](Payment const& q) { return q.created_time <= _latest_time - 60; }),
+			_payments.end());
+		recompute();
+		return _median;
+	}
+
+	size_t num_vertices() const {
+		return _num_vertices;
+	}
+
+	size_t num_edges() const {
+		return _num_edges;
+	}
+
+	/**
+		For the same calls as VenmoGraph; triangles are always counted.
+	*/
+	void count_triangles() {}
+
+	size_t triangles() const {
+		return _triangles;
+	}
+};  // class ReferenceGraph
+
+}  // namespace victor
+
+#endif  // REFERENCE_GRAPH_HPP_
@@ -0,0 +1,215 @@
+/**
+    Insight Data Engineering Code Challenge
+    rolling_median.hpp
+
+    Purpose:
+
+    RollingMedian is rolling_median as a library. Payments that are
+    already decoded are pushed into it, and after each one it gives back
+    the median degree of the graph of the last 60 seconds. It opens no
+    file and parses nothing: MedDegStream (src/victor/med_deg_stream.hpp)
+    reads files into it for the command line, and a service can push what
+    it takes off its own queues.
+
+    Names are passed as StringRef (src/victor/name_table.hpp), a pointer
+    and a length, so the caller needs no std::string. The graph copies a
+    name only when it is new to the graph; a name already in the window
+    is looked up where it lies.
+
+    Each payment's median may also go to a sink, as a MedianEvent (see
+    src/victor/output_sink.hpp). A callback can be set once, with
+    on_median(), and is then called for every payment. Or a sink, anything
+    with write(MedianEvent const&), can be given to push() itself; that is
+    resolved at compile time and costs no indirect call, and it is how the
+    command line writes its output.
+
+    A batch of payments can be pushed at once, from an array of Payment.
+
+    The triangles in the window can be counted as well, with
+    count_triangles(); each MedianEvent then carries their number.
+
+    @author Victor Chen
+*/
+#ifndef ROLLING_MEDIAN_HPP_
+#define ROLLING_MEDIAN_HPP_
+
+#include "victor/venmo_graph.hpp"
+#include "victor/name_table.hpp"
+#include "victor/output_sink.hpp"
+#include "victor/instrument.hpp"
+#include "victor/published_state.hpp"
+#include <time.h>
+#include <functional>
+#include <utility>
+
+namespace victor {
+
+class RollingMedian {
+public:
+	/**
+		A payment, decoded. The names must outlive the push.
+	*/
+	struct Payment {
+		StringRef actor;
+		StringRef target;
+		time_t created_time;
+	};
+
+	typedef std::function<void(MedianEvent const&)> Callback;
+
+private:
+	/**
+		Sink that hands events to a callback.
+	*/
+	struct CallbackSink {
+		Callback const& callback;
+
+		void write(MedianEvent const& e) {
+			callback(e);
+		}
+	};
+
+	VenmoGraph _graph;
+	double _median = 0;			// the latest
+	Callback _callback;
+
+public:
+	RollingMedian() {}
+
+	/**
+		@param callback called with every payment's median.
+	*/
+	explicit RollingMedian(Callback callback) : _callback(std::move(callback)) {}
+
+	/**
+		Set the callback called with every payment's median.
+
+		@param callback the callback, or an empty one to stop.
+	*/
+	void on_median(Callback callback) {
+		_callback = std::move(callback);
+	}
+
+	/**
+		Add a payment to the graph, and write the new median to a sink.
+		The callback, if any, isn't called.
+
+		@param actor name of the Venmo payment actor.
+		@param target name of the Venmo payment target.
+		@param created_time time of the payment, in seconds since the epoch.
+		@param sink anything with write(MedianEvent const&).
+		@return the median degree after the payment.
+	*/
+	template <typename Sink>
+	double push(StringRef actor, StringRef target, time_t created_time,
+				Sink& sink) {
+		MedianEvent e;
+		e.created_time = created_time;
+		e.median = VICTOR_TIMED(graph, _graph.extract_median(actor, target,
+															 created_time));
+		e.num_vertices = _graph.num_vertices();
+		e.num_edges = _graph.num_edges();
+		if (_graph.counts_triangles()) {
+			e.triangles = int64_t(_graph.triangles());
+		}
+		_median = e.median;
+		VICTOR_TIMED(output, sink.write(e));
+		return e.median;
+	}
+
+	/**
+		Add a payment to the graph, and call the callback, if any, with
+		the new median.
+
+		@param actor name of the Venmo payment actor.
+		@param target name of the Venmo payment target.
+		@param created_time time of the payment, in seconds since the epoch.
+		@return the median degree after the payment.
+	*/
+	double push(StringRef actor, StringRef target, time_t created_time) {
+		if (_callback) {
+			CallbackSink sink = { _callback };
+			return push(actor, target, created_time, sink);
+		}
+		_median = VICTOR_TIMED(graph, _graph.extract_median(actor, target,
+															created_time));
+		return _median;
+	}
+
+	/**
+		Add payments to the graph in order, writing each median to a sink.
+
+		@param first the first payment.
+		@param last one past the last payment.
+		@param sink anything with write(MedianEvent const&).
+		@return the median degree after the last payment.
+	*/
+	template <typename Sink>
+	double push(Payment const* first, Payment const* last, Sink& sink) {
+		for (; first != last; ++first) {
+			push(first->actor, first->target, first->created_time, sink);
+		}
+		return _median;
+	}
+
+	/**
+		Add payments to the graph in order, calling the callback, if any,
+		with each median.
+
+		@param first the first payment.
+		@param last one past the last payment.
+		@return the median degree after the last payment.
+	*/
+	double push(Payment const* first, Payment const* last) {
+		for (; first != last; ++first) {
+			push(first->actor, first->target, first->created_time);
+		}
+		return _median;
+	}
+
+	/**
+		@return the median degree after the latest payment, or 0 before
+		the first.
+	*/
+	double median() const {
+		return _median;
+	}
+
+	/**
+		Count the triangles in the window from now on (see
+		VenmoGraph::count_triangles()).
+	*/
+	void count_triangles() {
+		_graph.count_triangles();
+	}
+
+	/**
+		Index every user's counterparties from now on, for queries (see
+		VenmoGraph::index_counterparties()).
+	*/
+	void index_counterparties() {
+		_graph.index_counterparties();
+	}
+
+	/**
+		Publish a snapshot of the graph after every payment (see
+		VenmoGraph::publish_to()).
+
+		@param state where to publish, or nullptr to stop.
+	*/
+	void publish_to(PublishedState* state) {
+		_graph.publish_to(state);
+	}
+
+	/**
+		@return the graph, for queries, counters and the like.
+	*/
+	VenmoGraph const& graph() const {
+		return _graph;
+	}
+};  // class RollingMedian
+
+}  // namespace victor
+
+
+#endif  // ROLLING_MEDIAN_HPP_
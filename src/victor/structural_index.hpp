@@ -0,0 +1,699 @@
+/**
+    Insight Data Engineering Code Challenge
+    structural_index.hpp
+
+    Purpose:
+
+    StructuralIndex is a vectorised first pass over a buffer of newline
+    delimited JSON, in the style of simdjson's stage 1. It classifies the
+    buffer 64 bytes at a time and records the offset of every byte a parser
+    has to stop at:
+
+        - structural characters: { } [ ] : ,
+        - quotes and backslashes
+        - newlines (record boundaries)
+        - every other byte below 0x20 and every byte of 0x80 and above
+
+    Classification uses AVX2 or SSE4.2 (a pshufb nibble lookup plus one
+    compare), picked at run time, and a table lookup elsewhere. The offsets
+    are then extracted from each 64-bit mask with count-trailing-zeros.
+
+    Unlike simdjson, strings are not masked out here. A raw newline can't
+    occur inside a JSON string, so records are independent, and sax_walk()
+    tracks quotes itself while it walks one record's offsets. The walk
+    delivers the same SAX events as nlohmann::json::sax_parse, skipping the
+    bytes between offsets instead of scanning them one at a time. Strings
+    with non-ASCII bytes are checked with the parser's own UTF-8 validator.
+    Records the walk isn't sure about (escapes, control bytes, non-ASCII
+    bytes outside strings, invalid UTF-8, very long integers, out-of-range
+    floats, very deep nesting) are left to sax_parse. Floats are converted
+    with the same nlohmann::float_parser the lexer uses, so both paths
+    agree to the bit.
+
+    @author Victor Chen
+*/
+#ifndef STRUCTURAL_INDEX_HPP_
+#define STRUCTURAL_INDEX_HPP_
+
+#include "json/json.hpp"
+#include <stdint.h>
+#include <string.h>
+#include <cmath>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VICTOR_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace victor {
+/**
+	Structural Index
+*/
+class StructuralIndex {
+public:
+	/**
+		Classification kernels.
+	*/
+	enum Kernel {
+		scalar_kernel,
+		sse42_kernel,
+		avx2_kernel
+	};
+
+private:
+	std::vector<uint32_t> _pos;		// offsets of the indexed bytes
+	size_t _num_pos = 0;			// number of valid entries in _pos
+	Kernel _kernel;
+
+	char const* _first = nullptr;	// indexed buffer
+	char const* _last = nullptr;
+	char const* _line = nullptr;	// start of the next line
+	size_t _next = 0;				// first offset of the next line
+
+	/**
+		Whether a byte is one the index records.
+
+		@param c the byte.
+		@return true if it is.
+	*/
+	static bool interesting(unsigned char c) {
+		switch (c) {
+		case '"': case '\\': case '{': case '}':
+		case '[': case ']': case ':': case ',':
+			return true;
+		default:
+			return c < 0x20 || c >= 0x80;
+		}
+	}
+
+	/**
+		Append the offsets of the set bits of a block's mask.
+
+		@param out next free entry of the offsets array.
+		@param base offset of the block.
+		@param mask bit i is set if byte base + i is indexed.
+	*/
+	static uint32_t* flatten(uint32_t* out, uint32_t base, uint64_t mask) {
+		while (mask != 0) {
+			*out++ = base + uint32_t(__builtin_ctzll(mask));
+			mask &= mask - 1;
+		}
+		return out;
+	}
+
+	/**
+		Classify 64 bytes with a table lookup.
+
+		@param p the bytes.
+		@return the block's mask.
+	*/
+	static uint64_t classify_scalar(unsigned char const* p) {
+		uint64_t mask = 0;
+		for (int i = 0; i < 64; ++i) {
+			mask |= uint64_t(interesting(p[i])) << i;
+		}
+		return mask;
+	}
+
+	static uint32_t* index_scalar(unsigned char const* p, size_t n,
+								  uint32_t* out) {
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64) {
+			out = flatten(out, uint32_t(i), classify_scalar(p + i));
+		}
+		for (; i < n; ++i) {
+			if (interesting(p[i])) {
+				*out++ = uint32_t(i);
+			}
+		}
+		return out;
+	}
+
+#ifdef VICTOR_X86_SIMD
+	/*
+		The nibble lookup: a byte is structural, a quote or a backslash iff
+		lo_table[low nibble] & hi_table[high nibble] is non-zero.
+
+		    high nibble 2: '"' (0x22) ',' (0x2c)      bit 0
+		    high nibble 3: ':' (0x3a)                 bit 1
+		    high nibble 5: '[' (0x5b) '\' ']' (0x5d)  bit 2
+		    high nibble 7: '{' (0x7b) '}' (0x7d)      bit 3
+
+		Bytes below 0x20 or from 0x80 are found with one signed compare.
+	*/
+	__attribute__((target("sse4.2")))
+	static uint64_t classify_sse42(unsigned char const* p) {
+		__m128i const lo_table = _mm_setr_epi8(
+			0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 12, 5, 12, 0, 0);
+		__m128i const hi_table = _mm_setr_epi8(
+			0, 0, 1, 2, 0, 4, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0);
+		__m128i const nibble = _mm_set1_epi8(0x0f);
+		__m128i const space = _mm_set1_epi8(0x20);
+		__m128i const zero = _mm_setzero_si128();
+		uint64_t mask = 0;
+		for (int i = 0; i < 4; ++i) {
+			__m128i const x = _mm_loadu_si128(
+				reinterpret_cast<__m128i const*>(p + 16 * i));
+			__m128i const lo = _mm_shuffle_epi8(lo_table, _mm_and_si128(x, nibble));
+			__m128i const hi = _mm_shuffle_epi8(hi_table,
+				_mm_and_si128(_mm_srli_epi16(x, 4), nibble));
+			__m128i const plain = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero);
+			__m128i const low_or_high = _mm_cmpgt_epi8(space, x);
+			uint32_t const m = uint32_t(_mm_movemask_epi8(
+				_mm_or_si128(_mm_andnot_si128(plain, _mm_set1_epi8(-1)),
+							 low_or_high)));
+			mask |= uint64_t(m) << (16 * i);
+		}
+		return mask;
+	}
+
+	__attribute__((target("sse4.2")))
+	static uint32_t* index_sse42(unsigned char const* p, size_t n,
+								 uint32_t* out) {
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64) {
+			out = flatten(out, uint32_t(i), classify_sse42(p + i));
+		}
+		return index_tail(p, n, i, out, classify_sse42);
+	}
+
+	__attribute__((target("avx2")))
+	static uint64_t classify_avx2(unsigned char const* p) {
+		__m256i const lo_table = _mm256_setr_epi8(
+			0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 12, 5, 12, 0, 0,
+			0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 12, 5, 12, 0, 0);
+		__m256i const hi_table = _mm256_setr_epi8(
+			0, 0, 1, 2, 0, 4, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 1, 2, 0, 4, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0);
+		__m256i const nibble = _mm256_set1_epi8(0x0f);
+		__m256i const space = _mm256_set1_epi8(0x20);
+		__m256i const zero = _mm256_setzero_si256();
+		uint64_t mask = 0;
+		for (int i = 0; i < 2; ++i) {
+			__m256i const x = _mm256_loadu_si256(
+				reinterpret_cast<__m256i const*>(p + 32 * i));
+			__m256i const lo = _mm256_shuffle_epi8(lo_table,
+				_mm256_and_si256(x, nibble));
+			__m256i const hi = _mm256_shuffle_epi8(hi_table,
+				_mm256_and_si256(_mm256_srli_epi16(x, 4), nibble));
+			__m256i const plain = _mm256_cmpeq_epi8(
+				_mm256_and_si256(lo, hi), zero);
+			__m256i const low_or_high = _mm256_cmpgt_epi8(space, x);
+			uint32_t const m = uint32_t(_mm256_movemask_epi8(
+				_mm256_or_si256(_mm256_andnot_si256(plain,
+					_mm256_set1_epi8(-1)), low_or_high)));
+			mask |= uint64_t(m) << (32 * i);
+		}
+		return mask;
+	}
+
+	__attribute__((target("avx2")))
+	static uint32_t* index_avx2(unsigned char const* p, size_t n,
+								uint32_t* out) {
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64) {
+			out = flatten(out, uint32_t(i), classify_avx2(p + i));
+		}
+		return index_tail(p, n, i, out, classify_avx2);
+	}
+
+	/**
+		Classify the last, partial block through a space-padded copy.
+	*/
+	static uint32_t* index_tail(unsigned char const* p, size_t n, size_t i,
+								uint32_t* out,
+								uint64_t (*classify)(unsigned char const*)) {
+		if (i == n) {
+			return out;
+		}
+		unsigned char block[64];
+		memset(block, ' ', sizeof(block));
+		memcpy(block, p + i, n - i);
+		return flatten(out, uint32_t(i), classify(block));
+	}
+#endif  // VICTOR_X86_SIMD
+
+public:
+	/**
+		@param kernel classification kernel; defaults to the best one the
+		CPU supports.
+	*/
+	explicit StructuralIndex(Kernel kernel = best_kernel()) {
+		_kernel = supported(kernel) ? kernel : scalar_kernel;
+	}
+
+	/**
+		Whether the CPU can run a kernel.
+
+		@param kernel the kernel.
+		@return true if it can.
+	*/
+	static bool supported(Kernel kernel) {
+		switch (kernel) {
+		case scalar_kernel:
+			return true;
+#ifdef VICTOR_X86_SIMD
+		case sse42_kernel:
+			return __builtin_cpu_supports("sse4.2");
+		case avx2_kernel:
+			return __builtin_cpu_supports("avx2");
+#endif
+		default:
+			return false;
+		}
+	}
+
+	/**
+		The fastest kernel the CPU supports.
+
+		@return the kernel.
+	*/
+	static Kernel best_kernel() {
+		return supported(avx2_kernel) ? avx2_kernel
+			: supported(sse42_kernel) ? sse42_kernel
+			: scalar_kernel;
+	}
+
+	/**
+		Name of a kernel, for reports.
+
+		@param kernel the kernel.
+		@return its name.
+	*/
+	static char const* kernel_name(Kernel kernel) {
+		switch (kernel) {
+		case sse42_kernel: return "sse4.2";
+		case avx2_kernel: return "avx2";
+		default: return "scalar";
+		}
+	}
+
+	Kernel kernel() const {
+		return _kernel;
+	}
+
+	/**
+		Index a buffer of newline-delimited records. Offsets are relative
+		to first, so the buffer must be smaller than 4 GiB.
+
+		@param first first byte of the buffer.
+		@param last one past its last byte.
+	*/
+	void build(char const* first, char const* last) {
+		size_t const n = size_t(last - first);
+		if (_pos.size() < n + 64) {
+			_pos.resize(n + 64);
+		}
+		unsigned char const* p = reinterpret_cast<unsigned char const*>(first);
+		uint32_t* out;
+		switch (_kernel) {
+#ifdef VICTOR_X86_SIMD
+		case avx2_kernel:
+			out = index_avx2(p, n, _pos.data());
+			break;
+		case sse42_kernel:
+			out = index_sse42(p, n, _pos.data());
+			break;
+#endif
+		default:
+			out = index_scalar(p, n, _pos.data());
+			break;
+		}
+		_num_pos = size_t(out - _pos.data());
+		_first = first;
+		_last = last;
+		_line = first;
+		_next = 0;
+	}
+
+	/**
+		Offsets of the indexed bytes of the last buffer, in order.
+	*/
+	uint32_t const* begin() const {
+		return _pos.data();
+	}
+
+	uint32_t const* end() const {
+		return _pos.data() + _num_pos;
+	}
+
+	size_t size() const {
+		return _num_pos;
+	}
+
+	/**
+		Get the next line of the indexed buffer, without its '\n', and the
+		offsets that fall inside it.
+
+		@param first set to the first character of the line.
+		@param last set to one past its last character.
+		@param pos set to the line's first offset.
+		@param pos_end set to one past the line's last offset.
+		@return false once there are no more lines.
+	*/
+	bool next_line(char const*& first, char const*& last,
+				   uint32_t const*& pos, uint32_t const*& pos_end) {
+		if (_line == _last) {
+			return false;
+		}
+		uint32_t const* const all_end = end();
+		pos = begin() + _next;
+		uint32_t const* q = pos;
+		while (q != all_end && _first[*q] != '\n') {
+			++q;
+		}
+		first = _line;
+		pos_end = q;
+		if (q != all_end) {
+			last = _first + *q;
+			_line = last + 1;
+			_next = size_t(q - begin()) + 1;
+		} else {
+			last = _last;
+			_line = _last;
+			_next = _num_pos;
+		}
+		return true;
+	}
+};  // class StructuralIndex
+
+/**
+	Outcome of sax_walk().
+*/
+enum WalkResult {
+	walk_done,		// the whole record was read
+	walk_stopped,	// the handler stopped the walk (or got a parse error)
+	walk_fallback	// the record needs the full parser; events sent so far
+					// must be discarded
+};
+
+namespace walk_detail {
+
+inline bool is_space(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline char const* skip_space(char const* p, char const* q) {
+	while (p != q && is_space(*p)) {
+		++p;
+	}
+	return p;
+}
+
+inline bool is_digit(char c) {
+	return '0' <= c && c <= '9';
+}
+
+/**
+	Read a literal or a number at the start of [p, q) the way the json.hpp
+	lexer would: the longest prefix that is a token.
+
+	@param p start of the token.
+	@param q end of the gap the token is in.
+	@param kind set to 't', 'f', 'n', '-' (negative integer), '+' or 'd'
+	(float).
+	@param value set to the integer's absolute value.
+	@param real set to the float's value.
+	@return the end of the token, p if there is none, or nullptr if the
+	token is one sax_walk leaves to the parser (an integer that may not fit
+	into 64 bits, or a float that overflows).
+*/
+inline char const* scan_scalar(char const* p, char const* q, char& kind,
+							   uint64_t& value, double& real) {
+	size_t const n = size_t(q - p);
+	if (n >= 4 && memcmp(p, "true", 4) == 0) {
+		kind = 't';
+		return p + 4;
+	}
+	if (n >= 5 && memcmp(p, "false", 5) == 0) {
+		kind = 'f';
+		return p + 5;
+	}
+	if (n >= 4 && memcmp(p, "null", 4) == 0) {
+		kind = 'n';
+		return p + 4;
+	}
+	char const* r = p;
+	kind = '+';
+	if (r != q && *r == '-') {
+		kind = '-';
+		++r;
+	}
+	if (r == q || !is_digit(*r)) {
+		return p;
+	}
+	char const* const digits = r;
+	value = 0;
+	if (*r == '0') {
+		++r;
+	} else {
+		while (r != q && is_digit(*r)) {
+			value = value * 10 + uint64_t(*r++ - '0');
+			if (r - digits > 18) {
+				return nullptr;
+			}
+		}
+	}
+	// a fraction or exponent makes this a float
+	bool is_float = false;
+	if (r != q && *r == '.' && r + 1 != q && is_digit(r[1])) {
+		r += 2;
+		while (r != q && is_digit(*r)) {
+			++r;
+		}
+		is_float = true;
+	}
+	if (r != q && (*r == 'e' || *r == 'E')) {
+		char const* e = r + 1;
+		if (e != q && (*e == '+' || *e == '-')) {
+			++e;
+		}
+		if (e != q && is_digit(*e)) {
+			while (e != q && is_digit(*e)) {
+				++e;
+			}
+			r = e;
+			is_float = true;
+		}
+	}
+	if (is_float) {
+		kind = 'd';
+		real = nlohmann::float_parser::parse(p, r);
+		if (!std::isfinite(real)) {
+			return nullptr;
+		}
+	}
+	return r;
+}
+
+}  // namespace walk_detail
+
+/**
+	Walk one record through its structural offsets, sending the handler the
+	same events nlohmann::json::sax_parse(first, last, handler) would.
+
+	@param first first character of the record.
+	@param last one past its last character; not a '\n'.
+	@param base the buffer the offsets are relative to.
+	@param pos the record's first offset.
+	@param pos_end one past its last offset.
+	@param h the SAX handler (see nlohmann::json::sax_parse).
+	@return how the walk ended.
+*/
+template<typename Handler>
+WalkResult sax_walk(char const* first, char const* last, char const* base,
+					uint32_t const* pos, uint32_t const* pos_end, Handler& h) {
+	using walk_detail::skip_space;
+	typedef nlohmann::string_ref string_ref;
+	typedef nlohmann::json json;
+
+	enum Expect {
+		value,				// any value
+		first_value,		// a value or ']'
+		first_key,			// a key or '}'
+		key,
+		colon,
+		comma_or_close,
+		end					// nothing more
+	};
+
+	uint64_t stack = 0;		// bit i set: level i + 1 is an object
+	int depth = 0;
+	Expect ex = value;
+	char const* p = first;	// start of the text not yet read
+
+	// the parser reports errors at the unexpected token
+	auto error = [&](char const* at) {
+		h.parse_error(size_t(at - first), string_ref(at, at == last ? 0 : 1));
+		return walk_stopped;
+	};
+
+	while (true) {
+		char const* q = last;
+		char c = '\0';
+		if (pos != pos_end) {
+			q = base + *pos++;
+			c = *q;
+			if (c == '\t' || c == '\r') {
+				continue;	// whitespace
+			}
+			unsigned char const u = static_cast<unsigned char>(c);
+			if (c == '\\' || u < 0x20 || u >= 0x80) {
+				return walk_fallback;
+			}
+		}
+
+		// a literal or number may sit between p and q
+		p = skip_space(p, q);
+		if (p != q) {
+			if (ex != value && ex != first_value) {
+				return error(p);
+			}
+			char kind;
+			uint64_t v = 0;
+			double d = 0;
+			char const* const r = walk_detail::scan_scalar(p, q, kind, v, d);
+			if (r == nullptr) {
+				return walk_fallback;
+			}
+			if (r == p) {
+				return error(p);
+			}
+			bool keep_going;
+			switch (kind) {
+			case 't': keep_going = h.boolean(true); break;
+			case 'f': keep_going = h.boolean(false); break;
+			case 'n': keep_going = h.null(); break;
+			case 'd':
+				keep_going = h.number_float(d, string_ref(p, size_t(r - p)));
+				break;
+			case '-':
+				keep_going = h.number_integer(-static_cast<json::number_integer_t>(v));
+				break;
+			default:
+				keep_going = h.number_unsigned(json::number_unsigned_t(v));
+				break;
+			}
+			if (!keep_going) {
+				return walk_stopped;
+			}
+			ex = depth == 0 ? end : comma_or_close;
+			p = skip_space(r, q);
+			if (p != q) {
+				return error(p);
+			}
+		}
+
+		if (q == last) {
+			return ex == end ? walk_done : error(q);
+		}
+
+		switch (c) {
+		case '"': {
+			// find the closing quote; structural characters in between are
+			// part of the string
+			char const* close = nullptr;
+			bool ascii = true;
+			while (pos != pos_end) {
+				char const* const s = base + *pos++;
+				unsigned char const u = static_cast<unsigned char>(*s);
+				if (*s == '"') {
+					close = s;
+					break;
+				}
+				if (*s == '\\' || u < 0x20) {
+					return walk_fallback;
+				}
+				ascii = false;
+			}
+			if (close == nullptr) {
+				return walk_fallback;
+			}
+			// the parser rejects invalid UTF-8; let it report where
+			if (!ascii &&
+				!nlohmann::string_scanner::valid_utf8(q + 1, close)) {
+				return walk_fallback;
+			}
+			string_ref const str(q + 1, size_t(close - q - 1));
+			if (ex == key || ex == first_key) {
+				if (!h.key(str)) {
+					return walk_stopped;
+				}
+				ex = colon;
+			} else if (ex == value || ex == first_value) {
+				if (!h.string(str)) {
+					return walk_stopped;
+				}
+				ex = depth == 0 ? end : comma_or_close;
+			} else {
+				return error(q);
+			}
+			p = close + 1;
+			break;
+		}
+		case ':':
+			if (ex != colon) {
+				return error(q);
+			}
+			ex = value;
+			p = q + 1;
+			break;
+		case ',':
+			if (ex != comma_or_close) {
+				return error(q);
+			}
+			ex = (stack >> (depth - 1)) & 1 ? key : value;
+			p = q + 1;
+			break;
+		case '{':
+		case '[':
+			if (ex != value && ex != first_value) {
+				return error(q);
+			}
+			if (depth == 64) {
+				return walk_fallback;
+			}
+			if (c == '{') {
+				if (!h.start_object()) {
+					return walk_stopped;
+				}
+				stack |= uint64_t(1) << depth;
+				ex = first_key;
+			} else {
+				if (!h.start_array()) {
+					return walk_stopped;
+				}
+				stack &= ~(uint64_t(1) << depth);
+				ex = first_value;
+			}
+			++depth;
+			p = q + 1;
+			break;
+		case '}':
+		case ']': {
+			bool const object = c == '}';
+			bool const ok = object
+				? ex == first_key || (ex == comma_or_close && ((stack >> (depth - 1)) & 1))
+				: ex == first_value || (ex == comma_or_close && !((stack >> (depth - 1)) & 1));
+			if (!ok) {
+				return error(q);
+			}
+			--depth;
+			if (!(object ? h.end_object() : h.end_array())) {
+				return walk_stopped;
+			}
+			ex = depth == 0 ? end : comma_or_close;
+			p = q + 1;
+			break;
+		}
+		default:
+			// '\n' can't be inside a record
+			return walk_fallback;
+		}
+	}
+}
+
+}  // namespace victor
+
+#endif  // STRUCTURAL_INDEX_HPP_
@@ -0,0 +1,315 @@
+/**
+    Insight Data Engineering Code Challenge
+    triangle_counter.hpp
+
+    Purpose:
+
+    TriangleCounter keeps the number of triangles in the payment graph,
+    three users who have all paid each other inside the window, as edges
+    come and go. It is an optional analytic of VenmoGraph
+    (src/victor/venmo_graph.hpp), which tells it of every edge inserted
+    into the window and every edge expired from it.
+
+    Each vertex has its neighbors in a sorted array of ids. The triangles
+    an edge (a, b) closes are the common neighbors of a and b, so inserting
+    the edge adds |N(a) & N(b)| to the count, and expiring it takes away
+    the same, counted once the edge is gone. Nothing is ever recounted
+    from scratch.
+
+    The intersection of two sorted arrays is done four ids at a time with
+    SSE2 where the CPU has it: a block of one array is compared with all
+    four rotations of a block of the other, and whichever block ends lower
+    moves on. Elsewhere, and for the tails, it is a plain merge. When one
+    array is much shorter than the other, each of its ids is looked up in
+    the other by binary search instead.
+
+    VenmoGraph's own neighbors are stored under the lesser vertex of each
+    edge only, in hash maps, which can't be intersected quickly; these
+    arrays are kept next to them, and only while counting is on.
+
+    @author Victor Chen
+*/
+#ifndef TRIANGLE_COUNTER_HPP_
+#define TRIANGLE_COUNTER_HPP_
+
+#include "victor/memory_usage.hpp"
+#include <stdint.h>
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VICTOR_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace victor {
+/**
+	Triangle Counter
+*/
+class TriangleCounter {
+public:
+	typedef uint32_t Id;
+
+	/**
+		Intersection kernels.
+	*/
+	enum Kernel {
+		scalar_kernel,
+		sse2_kernel
+	};
+
+private:
+	std::vector<std::vector<Id>> _adjacency;	// indexed by id, sorted
+	uint64_t _triangles = 0;
+	uint64_t _edges = 0;
+	Kernel _kernel;
+
+	static size_t const gallop_ratio = 32;	// binary search past this
+
+	/**
+		Merge two sorted arrays, counting the ids they share.
+	*/
+	static uint64_t merge_count(Id const* a, size_t na, Id const* b, size_t nb) {
+		uint64_t count = 0;
+		size_t i = 0;
+		size_t j = 0;
+		while (i < na && j < nb) {
+			if (a[i] < b[j]) {
+				++i;
+			} else if (b[j] < a[i]) {
+				++j;
+			} else {
+				++count;
+				++i;
+				++j;
+			}
+		}
+		return count;
+	}
+
+	/**
+		Count the ids of a short sorted array found in a long one.
+	*/
+	static uint64_t gallop_count(Id const* a, size_t na, Id const* b, size_t nb) {
+		uint64_t count = 0;
+		Id const* const last = b + nb;
+		for (size_t i = 0; i < na && b != last; ++i) {
+			b = std::lower_bound(b, last, a[i]);
+			if (b != last && *b == a[i]) {
+				++count;
+				++b;
+			}
+		}
+		return count;
+	}
+
+#ifdef VICTOR_X86_SIMD
+	__attribute__((target("sse2")))
+	static uint64_t intersect_sse2(Id const* a, size_t na, Id const* b, size_t nb) {
+		uint64_t count = 0;
+		size_t i = 0;
+		size_t j = 0;
+		while (i + 4 <= na && j + 4 <= nb) {
+			__m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+			__m128i const y = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + j));
+			// x against every rotation of y; ids are unique in each array,
+			// so a lane matches at most once
+			__m128i m = _mm_cmpeq_epi32(x, y);
+			m = _mm_or_si128(m, _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, 0x39)));
+			m = _mm_or_si128(m, _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, 0x4e)));
+			m = _mm_or_si128(m, _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, 0x93)));
+			count += uint64_t(__builtin_popcount(unsigned(
+				_mm_movemask_ps(_mm_castsi128_ps(m)))));
+			Id const a_max = a[i + 3];
+			Id const b_max = b[j + 3];
+			i += a_max <= b_max ? 4 : 0;
+			j += b_max <= a_max ? 4 : 0;
+		}
+		return count + merge_count(a + i, na - i, b + j, nb - j);
+	}
+#endif
+
+	/**
+		Insert an id into a sorted array.
+	*/
+	static void insert_sorted(std::vector<Id>& v, Id id) {
+		v.insert(std::lower_bound(v.begin(), v.end(), id), id);
+	}
+
+	/**
+		Erase an id from a sorted array, which holds it.
+	*/
+	static void erase_sorted(std::vector<Id>& v, Id id) {
+		v.erase(std::lower_bound(v.begin(), v.end(), id));
+	}
+
+public:
+	explicit TriangleCounter(Kernel kernel = best_kernel())
+		: _kernel(supported(kernel) ? kernel : scalar_kernel) {}
+
+	/**
+		Add an edge. It must not be in the graph already.
+
+		@param a id of one vertex.
+		@param b id of the other, not a.
+	*/
+	void insert_edge(Id a, Id b) {
+		Id const top = std::max(a, b);
+		if (top >= _adjacency.size()) {
+			_adjacency.resize(size_t(top) + 1);
+		}
+		_triangles += common_neighbors(a, b);
+		insert_sorted(_adjacency[a], b);
+		insert_sorted(_adjacency[b], a);
+		++_edges;
+	}
+
+	/**
+		Remove an edge. It must be in the graph.
+
+		@param a id of one vertex.
+		@param b id of the other.
+	*/
+	void erase_edge(Id a, Id b) {
+		erase_sorted(_adjacency[a], b);
+		erase_sorted(_adjacency[b], a);
+		_triangles -= common_neighbors(a, b);
+		--_edges;
+		// a released id leaves no memory behind
+		for (Id v : { a, b }) {
+			if (_adjacency[v].empty()) {
+				std::vector<Id>().swap(_adjacency[v]);
+			}
+		}
+	}
+
+	/**
+		Neighbors two vertices share.
+
+		@param a id of one vertex.
+		@param b id of the other.
+		@return the number of vertices joined to both.
+	*/
+	uint64_t common_neighbors(Id a, Id b) const {
+		if (a >= _adjacency.size() || b >= _adjacency.size()) {
+			return 0;
+		}
+		return intersect(_adjacency[a], _adjacency[b], _kernel);
+	}
+
+	/**
+		Ids two sorted arrays share.
+
+		@param a ids, sorted and unique.
+		@param b ids, sorted and unique.
+		@param kernel the kernel to use; it must be supported.
+		@return the number of ids in both.
+	*/
+	static uint64_t intersect(std::vector<Id> const& a, std::vector<Id> const& b,
+							  Kernel kernel) {
+		Id const* pa = a.data();
+		Id const* pb = b.data();
+		size_t na = a.size();
+		size_t nb = b.size();
+		if (na > nb) {
+			std::swap(pa, pb);
+			std::swap(na, nb);
+		}
+		if (na == 0) {
+			return 0;
+		}
+		if (nb / na >= gallop_ratio) {
+			return gallop_count(pa, na, pb, nb);
+		}
+		switch (kernel) {
+#ifdef VICTOR_X86_SIMD
+		case sse2_kernel:
+			return intersect_sse2(pa, na, pb, nb);
+#endif
+		default:
+			return merge_count(pa, na, pb, nb);
+		}
+	}
+
+	/**
+		Whether a kernel can run on this CPU.
+
+		@param kernel the kernel.
+		@return true if it can.
+	*/
+	static bool supported(Kernel kernel) {
+		switch (kernel) {
+		case scalar_kernel:
+			return true;
+#ifdef VICTOR_X86_SIMD
+		case sse2_kernel:
+			return __builtin_cpu_supports("sse2");
+#endif
+		default:
+			return false;
+		}
+	}
+
+	/**
+		The fastest kernel the CPU supports.
+
+		@return the kernel.
+	*/
+	static Kernel best_kernel() {
+		return supported(sse2_kernel) ? sse2_kernel : scalar_kernel;
+	}
+
+	Kernel kernel() const {
+		return _kernel;
+	}
+
+	/**
+		Number of triangles.
+
+		@return the triangles among the edges in the graph.
+	*/
+	uint64_t triangles() const {
+		return _triangles;
+	}
+
+	/**
+		Number of edges.
+
+		@return the edges in the graph.
+	*/
+	uint64_t num_edges() const {
+		return _edges;
+	}
+
+	/**
+		Neighbors of a vertex.
+
+		@param id id of the vertex.
+		@return its neighbors' ids, sorted; none if it has no edge.
+	*/
+	std::vector<Id> const& neighbors(Id id) const {
+		static std::vector<Id> const none;
+		return id < _adjacency.size() ? _adjacency[id] : none;
+	}
+
+	/**
+		Estimate of the heap memory held.
+
+		@return bytes, by part.
+	*/
+	MemoryUsage memory_usage() const {
+		size_t bytes = MemoryUsage::of(_adjacency);
+		for (std::vector<Id> const& v : _adjacency) {
+			bytes += MemoryUsage::of(v);
+		}
+		MemoryUsage m;
+		m.add("triangle_adjacency", bytes);
+		return m;
+	}
+};  // class TriangleCounter
+
+}  // namespace victor
+
+
+#endif  // TRIANGLE_COUNTER_HPP_
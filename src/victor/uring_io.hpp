@@ -0,0 +1,619 @@
+/**
+    Insight Data Engineering Code Challenge
+    uring_io.hpp
+
+    Purpose:
+
+    UringInput and UringOutput are stream buffers that read and write a
+    file through io_uring, keeping several large reads or writes in flight
+    so that the thread parsing the input and writing the medians seldom
+    waits on the disk. That matters most when the storage is slow to
+    answer (a network mount, say); on a local disk with the file in the
+    page cache, they are about as fast as std::filebuf.
+
+    Each keeps a ring of buffers registered with the kernel. UringInput
+    reads the file ahead into them, in order; underflow() hands out the
+    next buffer once its read is done, and sends the one just used back
+    for the next part of the file. UringOutput fills a buffer and sends it
+    off as soon as it is full, taking the next free one; it only waits
+    when every buffer is still being written. Completions are reaped
+    whenever a buffer is handed out or sent off, so between batches of
+    records rather than on every record. Short reads and writes are
+    continued where they stopped.
+
+    Uring is the little of io_uring these need, on the raw system calls,
+    so no library is linked. Where io_uring isn't available (a kernel
+    without it, a seccomp policy forbidding it, or another OS), open()
+    returns nullptr and the caller falls back to std::filebuf.
+
+    @author Victor Chen
+*/
+#ifndef URING_IO_HPP_
+#define URING_IO_HPP_
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define VICTOR_HAVE_URING 1
+#endif
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#ifdef VICTOR_HAVE_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#include <algorithm>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace victor {
+
+#ifdef VICTOR_HAVE_URING
+
+/**
+	Uring
+
+	An io_uring instance: a submission and a completion queue shared with
+	the kernel.
+*/
+class Uring {
+private:
+	int _fd = -1;
+	void* _sq_map = MAP_FAILED;
+	void* _cq_map = MAP_FAILED;
+	size_t _sq_map_size = 0;
+	size_t _cq_map_size = 0;
+	io_uring_sqe* _sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+	size_t _sqes_size = 0;
+
+	unsigned* _sq_head = nullptr;
+	unsigned* _sq_tail = nullptr;
+	unsigned _sq_mask = 0;
+	unsigned _sq_entries = 0;
+	unsigned* _sq_array = nullptr;
+	unsigned* _cq_head = nullptr;
+	unsigned* _cq_tail = nullptr;
+	unsigned _cq_mask = 0;
+	io_uring_cqe* _cqes = nullptr;
+	unsigned _to_submit = 0;		// queued, not yet handed to the kernel
+
+	int enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+		return int(syscall(__NR_io_uring_enter, _fd, to_submit, min_complete,
+						   flags, nullptr, 0));
+	}
+
+	static unsigned* at(void* map, unsigned offset) {
+		return reinterpret_cast<unsigned*>(static_cast<char*>(map) + offset);
+	}
+
+public:
+	/**
+		@param entries most operations queued at once.
+	*/
+	explicit Uring(unsigned entries) {
+		io_uring_params p;
+		memset(&p, 0, sizeof p);
+		_fd = int(syscall(__NR_io_uring_setup, entries, &p));
+		if (_fd < 0) {
+			return;
+		}
+		_sq_map_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+		_cq_map_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+		if (p.features & IORING_FEAT_SINGLE_MMAP) {
+			_sq_map_size = _cq_map_size = std::max(_sq_map_size, _cq_map_size);
+		}
+		_sq_map = mmap(nullptr, _sq_map_size, PROT_READ | PROT_WRITE,
+					   MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+		_cq_map = (p.features & IORING_FEAT_SINGLE_MMAP) ? _sq_map
+			: mmap(nullptr, _cq_map_size, PROT_READ | PROT_WRITE,
+				   MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+		_sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+		_sqes = static_cast<io_uring_sqe*>(mmap(nullptr, _sqes_size,
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+		if (_sq_map == MAP_FAILED || _cq_map == MAP_FAILED || _sqes == MAP_FAILED) {
+			close(_fd);
+			_fd = -1;
+			return;
+		}
+		_sq_head = at(_sq_map, p.sq_off.head);
+		_sq_tail = at(_sq_map, p.sq_off.tail);
+		_sq_mask = *at(_sq_map, p.sq_off.ring_mask);
+		_sq_entries = p.sq_entries;
+		_sq_array = at(_sq_map, p.sq_off.array);
+		_cq_head = at(_cq_map, p.cq_off.head);
+		_cq_tail = at(_cq_map, p.cq_off.tail);
+		_cq_mask = *at(_cq_map, p.cq_off.ring_mask);
+		_cqes = reinterpret_cast<io_uring_cqe*>(
+			static_cast<char*>(_cq_map) + p.cq_off.cqes);
+	}
+
+	~Uring() {
+		if (_sqes != MAP_FAILED) {
+			munmap(_sqes, _sqes_size);
+		}
+		if (_cq_map != MAP_FAILED && _cq_map != _sq_map) {
+			munmap(_cq_map, _cq_map_size);
+		}
+		if (_sq_map != MAP_FAILED) {
+			munmap(_sq_map, _sq_map_size);
+		}
+		if (_fd >= 0) {
+			close(_fd);
+		}
+	}
+
+	Uring(Uring const&) = delete;
+	Uring& operator=(Uring const&) = delete;
+
+	bool is_open() const {
+		return _fd >= 0;
+	}
+
+	/**
+		Register buffers, to be named by index in fixed reads and writes.
+	*/
+	bool register_buffers(iovec const* iov, unsigned n) {
+		return syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, iov, n) == 0;
+	}
+
+	/**
+		Queue a fixed read or write; submit() hands it to the kernel.
+
+		@param op IORING_OP_READ_FIXED or IORING_OP_WRITE_FIXED.
+		@param fd file to read or write.
+		@param buf where in the registered buffer.
+		@param len bytes to read or write.
+		@param offset where in the file.
+		@param buf_index which registered buffer.
+		@param user_data handed back with the completion.
+		@return false if the queue is full.
+	*/
+	bool queue(uint8_t op, int fd, char* buf, size_t len, uint64_t offset,
+			   unsigned buf_index, uint64_t user_data) {
+		unsigned const tail = *_sq_tail;
+		if (tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) == _sq_entries) {
+			return false;
+		}
+		unsigned const i = tail & _sq_mask;
+		io_uring_sqe& sqe = _sqes[i];
+		memset(&sqe, 0, sizeof sqe);
+		sqe.opcode = op;
+		sqe.fd = fd;
+		sqe.addr = uint64_t(uintptr_t(buf));
+		sqe.len = unsigned(len);
+		sqe.off = offset;
+		sqe.buf_index = uint16_t(buf_index);
+		sqe.user_data = user_data;
+		_sq_array[i] = i;
+		__atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+		++_to_submit;
+		return true;
+	}
+
+	/**
+		Hand the queued operations to the kernel, and wait for some to
+		complete.
+
+		@param wait_for completions to wait for; 0 not to wait.
+		@return false on an error other than an interruption.
+	*/
+	bool submit(unsigned wait_for = 0) {
+		if (_to_submit == 0 && wait_for == 0) {
+			return true;
+		}
+		for (;;) {
+			int const n = enter(_to_submit, wait_for,
+								wait_for != 0 ? IORING_ENTER_GETEVENTS : 0);
+			if (n >= 0) {
+				_to_submit -= std::min(_to_submit, unsigned(n));
+				if (_to_submit == 0 || wait_for != 0) {
+					return true;
+				}
+			} else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+				return false;
+			}
+		}
+	}
+
+	/**
+		Take a completion, if there is one.
+
+		@param user_data set to what the operation was queued with.
+		@param res set to its result: bytes done, or -errno.
+		@return false if none has completed.
+	*/
+	bool reap(uint64_t& user_data, int& res) {
+		unsigned const head = *_cq_head;
+		if (head == __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)) {
+			return false;
+		}
+		io_uring_cqe const& cqe = _cqes[head & _cq_mask];
+		user_data = cqe.user_data;
+		res = cqe.res;
+		__atomic_store_n(_cq_head, head + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+};  // class Uring
+
+#endif  // VICTOR_HAVE_URING
+
+/**
+	Uring Input
+*/
+class UringInput : public std::streambuf {
+private:
+	std::string _error;			// why reading stopped early
+
+#ifdef VICTOR_HAVE_URING
+	/**
+		A registered buffer, and the part of the file read into it.
+	*/
+	struct Slot {
+		char* data;
+		uint64_t offset;		// in the file
+		size_t filled = 0;
+		bool ready = false;		// read to its end, or to the end of the file
+	};
+
+	int _fd;
+	size_t _buffer_size;
+	Uring _ring;
+	std::vector<char> _storage;
+	std::vector<Slot> _slots;
+	size_t _current = 0;		// the slot being handed out
+	uint64_t _next_offset = 0;	// of the next read to queue
+	unsigned _in_flight = 0;
+	bool _end = false;			// no more reads are queued past the end
+	uint64_t _end_offset = UINT64_MAX;	// where the file, or reading it, ended
+	bool _started = false;
+	bool _failed = false;		// the ring itself failed
+
+	/**
+		Note that the data ends at a slot's filled part; reads already
+		queued past it are dropped.
+	*/
+	void end_at(Slot& s) {
+		_end = true;
+		_end_offset = std::min(_end_offset, s.offset + s.filled);
+		s.ready = true;
+	}
+
+	bool read(size_t i) {
+		Slot& s = _slots[i];
+		++_in_flight;
+		return _ring.queue(IORING_OP_READ_FIXED, _fd, s.data + s.filled,
+						   _buffer_size - s.filled, s.offset + s.filled, unsigned(i), i);
+	}
+
+	/**
+		Read the next part of the file into a slot.
+	*/
+	void read_ahead(size_t i) {
+		Slot& s = _slots[i];
+		s.offset = _next_offset;
+		s.filled = 0;
+		s.ready = _end;
+		if (!_end) {
+			_next_offset += _buffer_size;
+			read(i);
+		}
+	}
+
+	/**
+		Take the completions there are, waiting for at least one if asked.
+	*/
+	void reap(bool wait) {
+		if (!_ring.submit(wait ? 1 : 0)) {
+			_error = std::string("io_uring: ") + strerror(errno);
+			_failed = true;
+			for (Slot& s : _slots) {
+				end_at(s);
+			}
+			_in_flight = 0;
+			return;
+		}
+		uint64_t i;
+		int res;
+		while (_ring.reap(i, res)) {
+			--_in_flight;
+			Slot& s = _slots[i];
+			if (res == -EINTR || res == -EAGAIN) {
+				read(size_t(i));
+			} else if (res < 0) {
+				if (_error.empty()) {
+					_error = std::string("cannot read: ") + strerror(-res);
+				}
+				end_at(s);
+			} else if (res == 0) {
+				end_at(s);
+			} else {
+				s.filled += size_t(res);
+				if (s.filled == _buffer_size) {
+					s.ready = true;
+				} else {
+					read(size_t(i));	// a short read; the rest may come
+				}
+			}
+		}
+	}
+
+	UringInput(int fd, size_t buffer_size, unsigned depth)
+		: _fd(fd), _buffer_size(buffer_size), _ring(depth * 2),
+		  _storage(buffer_size * depth), _slots(depth) {
+		std::vector<iovec> iov(depth);
+		for (unsigned i = 0; i < depth; ++i) {
+			_slots[i].data = _storage.data() + i * buffer_size;
+			iov[i].iov_base = _slots[i].data;
+			iov[i].iov_len = buffer_size;
+		}
+		if (!_ring.is_open() || !_ring.register_buffers(iov.data(), depth)) {
+			return;
+		}
+		for (unsigned i = 0; i < depth; ++i) {
+			read_ahead(i);
+		}
+		_started = true;
+	}
+
+protected:
+	int_type underflow() override {
+		if (gptr() != nullptr) {
+			// the slot handed out is used up
+			read_ahead(_current);
+			_current = (_current + 1) % _slots.size();
+		}
+		Slot const& s = _slots[_current];
+		reap(false);
+		while (!s.ready) {
+			reap(true);
+		}
+		size_t const n = s.offset >= _end_offset ? 0
+			: size_t(std::min<uint64_t>(s.filled, _end_offset - s.offset));
+		if (n == 0) {
+			setg(nullptr, nullptr, nullptr);
+			return traits_type::eof();
+		}
+		setg(s.data, s.data, s.data + n);
+		return traits_type::to_int_type(*gptr());
+	}
+
+public:
+	~UringInput() {
+		// the kernel may still be reading into the buffers
+		while (_in_flight != 0 && !_failed) {
+			reap(true);
+		}
+		close(_fd);
+	}
+#endif  // VICTOR_HAVE_URING
+
+public:
+	/**
+		What went wrong, if reading stopped early; "" if it didn't.
+	*/
+	std::string const& error() const {
+		return _error;
+	}
+
+	/**
+		Open a file to read through io_uring.
+
+		@param filename file to read.
+		@param buffer_size bytes per read.
+		@param depth reads in flight.
+		@return the stream buffer, or nullptr if the file can't be read or
+		io_uring can't be used.
+	*/
+	static std::unique_ptr<std::streambuf> open(char const* filename,
+												size_t buffer_size = 1 << 20,
+												unsigned depth = 4) {
+#ifdef VICTOR_HAVE_URING
+		int const fd = ::open(filename, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return nullptr;
+		}
+		std::unique_ptr<UringInput> in(new UringInput(fd, buffer_size, depth));
+		if (in->_started) {
+			return std::unique_ptr<std::streambuf>(in.release());
+		}
+#else
+		(void)filename;
+		(void)buffer_size;
+		(void)depth;
+#endif
+		return nullptr;
+	}
+};  // class UringInput
+
+/**
+	Uring Output
+*/
+class UringOutput : public std::streambuf {
+private:
+	std::string _error;			// why writing failed
+
+#ifdef VICTOR_HAVE_URING
+	/**
+		A registered buffer, and what is being written from it.
+	*/
+	struct Slot {
+		char* data;
+		uint64_t offset = 0;	// in the file
+		size_t length = 0;
+		size_t done = 0;
+		bool busy = false;		// being written
+	};
+
+	int _fd;
+	size_t _buffer_size;
+	Uring _ring;
+	std::vector<char> _storage;
+	std::vector<Slot> _slots;
+	size_t _current = 0;		// the slot being filled
+	uint64_t _offset = 0;		// in the file, of the next write
+	unsigned _in_flight = 0;
+	bool _started = false;
+	bool _failed = false;		// the ring itself failed
+
+	void write(size_t i) {
+		Slot& s = _slots[i];
+		++_in_flight;
+		_ring.queue(IORING_OP_WRITE_FIXED, _fd, s.data + s.done, s.length - s.done,
+					s.offset + s.done, unsigned(i), i);
+	}
+
+	/**
+		Take the completions there are, waiting for at least one if asked.
+	*/
+	void reap(bool wait) {
+		if (!_ring.submit(wait ? 1 : 0)) {
+			_error = std::string("io_uring: ") + strerror(errno);
+			_failed = true;
+			for (Slot& s : _slots) {
+				s.busy = false;
+			}
+			_in_flight = 0;
+			return;
+		}
+		uint64_t i;
+		int res;
+		while (_ring.reap(i, res)) {
+			--_in_flight;
+			Slot& s = _slots[i];
+			if (res == -EINTR || res == -EAGAIN) {
+				write(size_t(i));
+			} else if (res <= 0) {
+				if (_error.empty()) {
+					_error = std::string("cannot write: ") + strerror(res == 0 ? EIO : -res);
+				}
+				s.busy = false;
+			} else {
+				s.done += size_t(res);
+				if (s.done == s.length) {
+					s.busy = false;
+				} else {
+					write(size_t(i));	// a short write; send the rest
+				}
+			}
+		}
+	}
+
+	/**
+		Send off what the current slot holds, and take the next one once it
+		is free.
+	*/
+	bool send_current() {
+		Slot& s = _slots[_current];
+		s.length = size_t(pptr() - pbase());
+		if (s.length != 0) {
+			s.offset = _offset;
+			s.done = 0;
+			s.busy = true;
+			_offset += s.length;
+			write(_current);
+			_current = (_current + 1) % _slots.size();
+		}
+		reap(false);
+		while (_slots[_current].busy) {
+			reap(true);
+		}
+		Slot const& next = _slots[_current];
+		setp(next.data, next.data + _buffer_size);
+		return _error.empty();
+	}
+
+	UringOutput(int fd, size_t buffer_size, unsigned depth)
+		: _fd(fd), _buffer_size(buffer_size), _ring(depth * 2),
+		  _storage(buffer_size * depth), _slots(depth) {
+		std::vector<iovec> iov(depth);
+		for (unsigned i = 0; i < depth; ++i) {
+			_slots[i].data = _storage.data() + i * buffer_size;
+			iov[i].iov_base = _slots[i].data;
+			iov[i].iov_len = buffer_size;
+		}
+		if (!_ring.is_open() || !_ring.register_buffers(iov.data(), depth)) {
+			return;
+		}
+		setp(_slots[0].data, _slots[0].data + buffer_size);
+		_started = true;
+	}
+
+protected:
+	int_type overflow(int_type c) override {
+		if (!send_current()) {
+			return traits_type::eof();
+		}
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	int sync() override {
+		send_current();
+		while (_in_flight != 0 && !_failed) {
+			reap(true);
+		}
+		return _error.empty() ? 0 : -1;
+	}
+
+public:
+	~UringOutput() {
+		if (_started) {
+			sync();
+		}
+		close(_fd);
+	}
+#endif  // VICTOR_HAVE_URING
+
+public:
+	/**
+		What went wrong, if writing failed; "" if it didn't.
+	*/
+	std::string const& error() const {
+		return _error;
+	}
+
+	/**
+		Create (or truncate) a file to write through io_uring.
+
+		@param filename file to write.
+		@param buffer_size bytes per write.
+		@param depth writes in flight, at most.
+		@return the stream buffer, or nullptr if the file can't be created
+		or io_uring can't be used.
+	*/
+	static std::unique_ptr<std::streambuf> open(char const* filename,
+												size_t buffer_size = 1 << 20,
+												unsigned depth = 4) {
+#ifdef VICTOR_HAVE_URING
+		int const fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd < 0) {
+			return nullptr;
+		}
+		std::unique_ptr<UringOutput> out(new UringOutput(fd, buffer_size, depth));
+		if (out->_started) {
+			return std::unique_ptr<std::streambuf>(out.release());
+		}
+#else
+		(void)filename;
+		(void)buffer_size;
+		(void)depth;
+#endif
+		return nullptr;
+	}
+};  // class UringOutput
+
+}  // namespace victor
+
+#endif  // URING_IO_HPP_
@@ -23,7 +23,12 @@
     The graph also indirectly stores edges by keeping track of neighbors of each
     vertex. Actually, that isn't technically true, because it stores the
     neighbors of only the lesser of the vertices of an edge, where order is
-    defined by name (string) comparison. Doing so saves space.
+    defined by vertex id comparison. Doing so saves space.
+
+    Vertices are referred to by the integer ids handed out by the median heap
+    map's NameTable (defined in src/victor/name_table.hpp). An id is only
+    recycled once its vertex has degree 0, i.e. once no edge refers to it, so
+    the edges and neighbors containers never hold a stale id.
     
     Storing neighbors is necessary when we need to update an edge with a new
     time-stamp. One can easily linearly search for the old timestamp of the
@@ -36,18 +41,34 @@
     better to pay the price of maintaining the neighbors container to achieve
     low latency.
 
+    The graph can also count its triangles, three users who have all paid
+    each other inside the window, as edges come and go (see
+    src/victor/triangle_counter.hpp). That is off unless asked for.
+
+    Since neighbors are stored under the lesser vertex only, a user's
+    counterparties can't be found from the user alone. For queries, the
+    graph can keep a second index, also off unless asked for, from each
+    vertex to the lesser vertices it is joined to.
+
     @author Victor Chen
 */
 #ifndef VENMO_GRAPH_HPP_
 #define VENMO_GRAPH_HPP_
 
 #include "victor/med_heap_map.hpp"
+#include "victor/instrument.hpp"
+#include "victor/published_state.hpp"
+#include "victor/triangle_counter.hpp"
+#include <stdint.h>
 #include <time.h>
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <string>
 #include <sstream>
+#include <vector>
 
 // #include <iostream>
 // using std::cout;
@@ -58,92 +79,127 @@ namespace victor {
 	VenmoGraph
 */
 class VenmoGraph {
+public:
+	/**
+		What the graph has done with the payments it was given. Always
+		counted; they cost an increment each.
+	*/
+	struct Counters {
+		uint64_t edges_inserted = 0;
+		uint64_t edges_updated = 0;		// an edge in the window, paid again
+		uint64_t edges_expired = 0;
+		uint64_t late = 0;				// older than the latest, but in the window
+		uint64_t dropped = 0;			// too old for the window, skipped
+		uint64_t self_payments = 0;		// paid to oneself, which adds no edge
+		uint64_t peak_edges = 0;		// most edges at once
+	};
+
 private:
 	struct time_comp {
 		bool operator()(time_t lhs, time_t rhs) const {
 			return difftime(rhs, lhs) > 0.0;
 		}
 	};
-	
+
+	typedef MedHeapMap::Id Id;
 	typedef std::multimap<time_t,
-						  std::pair<std::string, std::string>,
+						  std::pair<Id, Id>,
 						  time_comp>
 		Edges;
-	typedef std::unordered_map<std::string,
-							   std::unordered_map<std::string, time_t>>
+	typedef std::unordered_map<Id,
+							   std::unordered_map<Id, time_t>>
 	   	Neighbors;
+	typedef std::unordered_map<Id, std::vector<Id>> Lesser;
 
 	MedHeapMap _vertices;		// Vertices container
 	Edges _edges;				// Edges container
 	Neighbors _neighbors;		// Neighbors container
 	time_t _latest_time = 0;	// time of an edge with the latest time-stamp
+	Counters _counters;
+	uint64_t _payments = 0;		// given to extract_median()
+	PublishedState* _published = nullptr;
+	std::unique_ptr<TriangleCounter> _triangles;	// if counting
+	std::unique_ptr<Lesser> _lesser;	// if indexed: vertex -> lesser neighbors
 	
 	/**
 		Sub-routine which:
 		
 		1. checks if the edge exists already.
-		2. updates it with the new timestamp (if it exists),or inserts
-		   it edge into the graph (if it doesn't exist yet).
+		2. updates it with the new timestamp (if it exists and the new one is
+		   later), or inserts the edge into the graph (if it doesn't exist
+		   yet).
+
+		A payment to oneself is no edge, and is only counted.
 	   
 	    @param actor name of the Venmo payment actor.
 	    @param target name of the Venmo payment target.
 	    @param created_time time of the payment.
 	*/
-	void process_helper(std::string actor, std::string target,
+	void process_helper(StringRef actor, StringRef target,
 						time_t created_time) {
-		std::string *name1_ptr;
-		std::string *name2_ptr;
-		
-		// edge identifiers are ordered via string comparison
-		int cmp_val = actor.compare(target);
-
-		if (cmp_val < 1) {
-			name1_ptr = &actor;
-			name2_ptr = &target;
-		} else if (cmp_val == 0) {
+		// paying oneself joins nobody
+		if (actor == target) {
+			++_counters.self_payments;
 			return;
-		} else {
-			name1_ptr = &target;
-			name2_ptr = &actor;
 		}
-		
+
+		// an edge can only exist if both of its vertices do
+		Id const actor_id = _vertices.find(actor);
+		Id const target_id = _vertices.find(target);
+
 		// check _neighbors for the edge
-		bool not_seen_before;
-		Neighbors::iterator const it = _neighbors.find(*name1_ptr);
-		std::unordered_map<std::string, time_t>::iterator it2;
-		if (it != _neighbors.end()) {
-			it2 = (it->second).find(*name2_ptr);
-			if (it2 != (it->second).end()) {
-				not_seen_before = false;
-			} else {
-				not_seen_before = true;
+		bool not_seen_before = true;
+		std::unordered_map<Id, time_t>::iterator it2;
+		if (actor_id != MedHeapMap::npos && target_id != MedHeapMap::npos) {
+			// edge identifiers are ordered via id comparison
+			Neighbors::iterator const it =
+				_neighbors.find(std::min(actor_id, target_id));
+			if (it != _neighbors.end()) {
+				it2 = (it->second).find(std::max(actor_id, target_id));
+				not_seen_before = it2 == (it->second).end();
 			}
-		} else {
-			not_seen_before = true;
 		}
 
 		if (not_seen_before) {
 			// New edge encountered -> just insert into _vertices
 			// and update _edegs & _neighbors.
-			_vertices.process_edge(actor, target);
-			_neighbors[*name1_ptr][*name2_ptr] = created_time;
-			_edges.emplace(created_time,
-				std::make_pair(std::move(*name1_ptr), std::move(*name2_ptr)));
+			std::pair<Id, Id> const ids = VICTOR_TIMED(heap,
+				_vertices.process_edge(actor, target));
+			Id const id1 = std::min(ids.first, ids.second);
+			Id const id2 = std::max(ids.first, ids.second);
+			_neighbors[id1][id2] = created_time;
+			_edges.emplace(created_time, std::make_pair(id1, id2));
+			if (_triangles) {
+				VICTOR_TIMED(triangle, _triangles->insert_edge(id1, id2));
+			}
+			if (_lesser) {
+				(*_lesser)[id2].push_back(id1);
+			}
+			++_counters.edges_inserted;
+			if (_edges.size() > _counters.peak_edges) {
+				_counters.peak_edges = _edges.size();
+			}
 		} else {
-			// Old edge encountered -> don't insert, just update its time.
+			// Old edge encountered -> don't insert, just update its time,
+			// unless the payment is late and the edge already newer.
+			++_counters.edges_updated;
+			Id const id1 = std::min(actor_id, target_id);
+			Id const id2 = std::max(actor_id, target_id);
 			time_t& time_ref = it2->second;
 			time_t old_time = time_ref;
+			if (difftime(created_time, old_time) <= 0.0) {
+				return;
+			}
 			time_ref = created_time;
 			Edges::const_iterator it3 = _edges.find(old_time);
 			for (; it3 != _edges.cend(); ++it3) {
 				auto const& p = it3->second;
-				if (p.first == *name1_ptr && p.second == *name2_ptr) {
+				if (p.first == id1 && p.second == id2) {
 					break;
 				}
 			}
 			_edges.erase(it3);
-			_edges.emplace(created_time,
-				std::make_pair(std::move(*name1_ptr), std::move(*name2_ptr)));
+			_edges.emplace(created_time, std::make_pair(id1, id2));
 		}
 	}
 
@@ -158,39 +214,58 @@ private:
 	    @param target name of the Venmo payment target.
 	    @param created_time time of the payment.
 	*/
-	void process(std::string actor, std::string target,
+	void process(StringRef actor, StringRef target,
 				 time_t created_time) {
 		if (_latest_time == 0) {
 			// First edge of the graph. Insert it.
 			_latest_time = created_time;
-			process_helper(std::move(actor), std::move(target), created_time);
+			process_helper(actor, target, created_time);
 		} else {
 			double diff_val = difftime(created_time, _latest_time);
 			if (diff_val > -60.0 && diff_val <= 0.0) {
 				// Edge is before & within the latest time. Deal with it.
-				process_helper(std::move(actor), std::move(target),
-							   created_time);
+				_counters.late += diff_val < 0.0;
+				process_helper(actor, target, created_time);
 			} else if (diff_val > 0.0) {
 				// Edge is the latest time. Erase all edges more than 60 seconds
 				// old. Then, deal with this new edge.
 				_latest_time = created_time;
-				
-				Edges::const_iterator ub =
-					_edges.upper_bound(created_time - 60);
-				for (auto it = _edges.cbegin(); it != ub; ++it) {
-					auto const& p = it->second;
-					bool b1 = _vertices.decrease_key(p.first);
-					_vertices.decrease_key(p.second);
-					if (b1) {
-						_neighbors.erase(p.first);
-					} else {
-						_neighbors[p.first].erase(p.second);
+				{
+					VICTOR_PROBE(expire);
+					Edges::const_iterator ub =
+						_edges.upper_bound(created_time - 60);
+					for (auto it = _edges.cbegin(); it != ub; ++it) {
+						auto const& p = it->second;
+						Neighbors::iterator const n = _neighbors.find(p.first);
+						(n->second).erase(p.second);
+						if ((n->second).empty()) {
+							_neighbors.erase(n);
+						}
+						if (_triangles) {
+							VICTOR_TIMED(triangle,
+								_triangles->erase_edge(p.first, p.second));
+						}
+						if (_lesser) {
+							Lesser::iterator const l = _lesser->find(p.second);
+							std::vector<Id>& ids = l->second;
+							*std::find(ids.begin(), ids.end(), p.first) = ids.back();
+							ids.pop_back();
+							if (ids.empty()) {
+								_lesser->erase(l);
+							}
+						}
+						// vertices left with degree 0 are erased & their ids
+						// released
+						VICTOR_TIMED(heap, _vertices.decrease_key(p.first));
+						VICTOR_TIMED(heap, _vertices.decrease_key(p.second));
+						++_counters.edges_expired;
 					}
+					_edges.erase(_edges.cbegin(), ub);
 				}
-				_edges.erase(_edges.cbegin(), ub);
 				
-				process_helper(std::move(actor), std::move(target),
-							   created_time);
+				process_helper(actor, target, created_time);
+			} else {
+				++_counters.dropped;
 			}
 		}
 	}
@@ -198,17 +273,88 @@ private:
 public:
 	/**
 		Return the current median, regardless of whether or not the edge is
-		inside or outside the time window.
+		inside or outside the time window. The names are only copied if
+		they are new to the graph.
 	   
 	    @param actor name of the Venmo payment actor.
 	    @param target name of the Venmo payment target.
 	    @param created_time time of the payment.
 	    @return the current median.
 	*/
-	double extract_median(std::string actor, std::string target,
+	double extract_median(StringRef actor, StringRef target,
 						  time_t created_time) {
-		process(std::move(actor), std::move(target), created_time);
-		return _vertices.median();
+		process(actor, target, created_time);
+		double const median = _vertices.median();
+		++_payments;
+		if (_published != nullptr) {
+			GraphState s;
+			s.latest_time = _latest_time;
+			s.median = median;
+			s.num_vertices = _vertices.size();
+			s.num_edges = _edges.size();
+			s.payments = _payments;
+			_published->publish(s);
+		}
+		return median;
+	}
+
+	/**
+		Publish a snapshot of the graph after every payment, for other
+		threads or processes to read (see src/victor/published_state.hpp).
+		The graph must be the only writer of the state.
+
+		@param state where to publish, or nullptr to stop.
+	*/
+	void publish_to(PublishedState* state) {
+		_published = state;
+	}
+
+	/**
+		Count the triangles in the window from now on, as edges are
+		inserted and expired. The edges already in the window are counted
+		first.
+	*/
+	void count_triangles() {
+		if (_triangles) {
+			return;
+		}
+		_triangles.reset(new TriangleCounter());
+		for (Edges::value_type const& e : _edges) {
+			_triangles->insert_edge(e.second.first, e.second.second);
+		}
+	}
+
+	/**
+		Index the counterparties of every vertex from now on, so that
+		counterparties() looks at the user's own edges only. The edges
+		already in the window are indexed first.
+	*/
+	void index_counterparties() {
+		if (_lesser) {
+			return;
+		}
+		_lesser.reset(new Lesser());
+		for (Edges::value_type const& e : _edges) {
+			(*_lesser)[e.second.second].push_back(e.second.first);
+		}
+	}
+
+	/**
+		Whether triangles are counted.
+
+		@return true once count_triangles() is called.
+	*/
+	bool counts_triangles() const {
+		return _triangles != nullptr;
+	}
+
+	/**
+		Number of triangles.
+
+		@return the triangles in the window, or 0 if they aren't counted.
+	*/
+	uint64_t triangles() const {
+		return _triangles ? _triangles->triangles() : 0;
 	}
 
 	/* Testing & Debugging */
@@ -230,6 +376,122 @@ public:
 	size_t num_edges() const {
 		return _edges.size();
 	}
+
+	/**
+		Latest time so far.
+
+		@return the time of the latest payment in the window, or 0 before
+		the first payment.
+	*/
+	time_t latest_time() const {
+		return _latest_time;
+	}
+
+	/**
+		Number of payments given to the graph.
+
+		@return the payments so far, dropped ones included.
+	*/
+	uint64_t payments() const {
+		return _payments;
+	}
+
+	/**
+		The users a user is joined to, and when each edge was last paid.
+		An edge is only stored with the lesser of its ids, so unless
+		index_counterparties() was called this looks through the neighbors
+		of every vertex; it is meant for queries, not for every payment.
+
+		@param name name of the user.
+		@return the user's counterparties, by name; none if the user isn't
+		in the graph.
+	*/
+	std::vector<std::pair<std::string, time_t>> counterparties(
+			std::string const& name) const {
+		std::vector<std::pair<std::string, time_t>> result;
+		Id const id = _vertices.find(name);
+		if (id == MedHeapMap::npos) {
+			return result;
+		}
+		if (_lesser) {
+			Neighbors::const_iterator const n = _neighbors.find(id);
+			if (n != _neighbors.end()) {
+				for (auto const& p : n->second) {
+					result.emplace_back(_vertices.name(p.first), p.second);
+				}
+			}
+			Lesser::const_iterator const l = _lesser->find(id);
+			if (l != _lesser->end()) {
+				for (Id const other : l->second) {
+					result.emplace_back(_vertices.name(other),
+										_neighbors.find(other)->second.find(id)->second);
+				}
+			}
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+		for (Neighbors::value_type const& n : _neighbors) {
+			if (n.first == id) {
+				for (auto const& p : n.second) {
+					result.emplace_back(_vertices.name(p.first), p.second);
+				}
+			} else if (n.first < id) {
+				auto const it = n.second.find(id);
+				if (it != n.second.end()) {
+					result.emplace_back(_vertices.name(n.first), it->second);
+				}
+			}
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	/**
+		Counters, for monitoring.
+
+		@return what the graph has done since it was made.
+	*/
+	Counters const& counters() const {
+		return _counters;
+	}
+
+	/**
+		Heap memory held, in parts: the edges, the neighbors, and the parts
+		of the vertices' median heap map. Takes time linear in the size of
+		the graph.
+
+		@return the account.
+	*/
+	MemoryUsage memory_usage() const {
+		size_t neighbors = MemoryUsage::hash_table(_neighbors);
+		for (Neighbors::value_type const& n : _neighbors) {
+			neighbors += MemoryUsage::hash_table(n.second);
+		}
+		MemoryUsage m;
+		m.add("edges", MemoryUsage::tree(_edges));
+		m.add("neighbors", neighbors);
+		m.add(_vertices.memory_usage());
+		if (_triangles) {
+			m.add(_triangles->memory_usage());
+		}
+		if (_lesser) {
+			size_t lesser = MemoryUsage::hash_table(*_lesser);
+			for (Lesser::value_type const& l : *_lesser) {
+				lesser += MemoryUsage::of(l.second);
+			}
+			m.add("counterparty_index", lesser);
+		}
+		return m;
+	}
+
+	/**
+		The vertices container.
+
+		@return the median heap map holding the vertices.
+	*/
+	MedHeapMap const& vertices() const {
+		return _vertices;
+	}
 	
 	/**
 		Dump of the edges and neighbors.
@@ -243,18 +505,18 @@ public:
 		for (auto const& p : _edges) {
 			time_t created_time = p.first;
 			auto const& p2 = p.second;
-			std::string const& name1 = p2.first;
-			std::string const& name2 = p2.second;
+			std::string const& name1 = _vertices.name(p2.first);
+			std::string const& name2 = _vertices.name(p2.second);
 			ss << created_time << ": " << name1 << ' ' << name2 << '\n';
 		}
 		ss << '\n';
 		
 		ss << "----- Neighbors -----\n";
 		for (auto const& p : _neighbors) {
-			std::string const& name = p.first;
+			std::string const& name = _vertices.name(p.first);
 			ss << name << ":\n";
 			for (auto const& p2 : p.second) {
-				std::string const& neighbor = p2.first;
+				std::string const& neighbor = _vertices.name(p2.first);
 				time_t created_time = p2.second;
 				ss << "  " << neighbor << " at " << created_time << '\n';
 			}
@@ -0,0 +1,386 @@
+/**
+    Insight Data Engineering Code Challenge
+    venmo_record.hpp
+
+    Purpose:
+
+    VenmoRecordReader pulls the three fields the graph needs (actor, target
+    and created_time) out of one line of Venmo JSON. It drives the SAX
+    interface of the vendored json.hpp (nlohmann::json::sax_parse) on the
+    line's characters in place, instead of building a json object: no DOM
+    nodes are allocated, keys are compared as views, and only the three
+    wanted string values are copied, into strings whose capacity is reused
+    from line to line. Parsing stops as soon as all three fields have been
+    seen, so whatever follows them on the line is never scanned.
+
+    created_time is parsed by hand as an ISO 8601 UTC timestamp
+    (YYYY-MM-DDTHH:MM:SSZ) and converted to seconds since the epoch without
+    going through the C library's local-time functions.
+
+    @author Victor Chen
+*/
+#ifndef VENMO_RECORD_HPP_
+#define VENMO_RECORD_HPP_
+
+#include "victor/structural_index.hpp"
+#include "json/json.hpp"
+#include <stdint.h>
+#include <time.h>
+#include <string>
+
+namespace victor {
+
+/**
+    One payment: the actor paid the target at created_time.
+*/
+struct VenmoRecord {
+	std::string actor;
+	std::string target;
+	time_t created_time = 0;
+};
+
+/**
+    Venmo Record Reader
+*/
+class VenmoRecordReader {
+public:
+	/**
+		Outcome of reading a line. Anything but ok means the line is skipped.
+	*/
+	enum Status {
+		ok,
+		malformed,				// not a JSON object
+		missing_actor,
+		empty_actor,
+		bad_actor,				// actor is not a string
+		missing_target,
+		empty_target,
+		bad_target,				// target is not a string
+		missing_created_time,
+		empty_created_time,
+		bad_created_time		// not a string, or not a valid timestamp
+	};
+
+private:
+	typedef nlohmann::json json;
+	typedef nlohmann::string_ref string_ref;
+
+	/**
+		Which top-level field the next value belongs to.
+	*/
+	enum Field {
+		no_field = -1,
+		actor_field,
+		target_field,
+		created_time_field,
+		num_fields
+	};
+
+	/**
+		SAX handler. Records the string values of the wanted top-level keys
+		and ignores everything else, including nested objects and arrays.
+	*/
+	struct Handler {
+		VenmoRecord& rec;
+		std::string& time_str;
+		int depth = 0;			// nesting level of the current value
+		Field field = no_field;	// field of the current top-level value
+		bool seen[num_fields];
+		bool bad[num_fields];
+		int num_seen = 0;
+		bool error = false;
+
+		Handler(VenmoRecord& r, std::string& t) : rec(r), time_str(t) {
+			for (int f = 0; f < num_fields; ++f) {
+				seen[f] = false;
+				bad[f] = false;
+			}
+		}
+
+		/**
+			A value that is not a string. Only matters if it belongs to a
+			wanted field.
+
+			@return whether to keep parsing.
+		*/
+		bool other() {
+			if (depth == 0) {
+				error = true;
+				return false;
+			}
+			return depth != 1 || take(false);
+		}
+
+		/**
+			Mark the current field as seen.
+
+			@param good whether its value is a string.
+			@return whether to keep parsing.
+		*/
+		bool take(bool good) {
+			if (field == no_field || seen[field]) {
+				field = no_field;
+				return true;
+			}
+			seen[field] = true;
+			bad[field] = !good;
+			field = no_field;
+			return ++num_seen != num_fields;
+		}
+
+		bool null() { return other(); }
+		bool boolean(bool) { return other(); }
+		bool number_integer(json::number_integer_t) { return other(); }
+		bool number_unsigned(json::number_unsigned_t) { return other(); }
+		bool number_float(json::number_float_t, string_ref) { return other(); }
+
+		bool string(string_ref s) {
+			if (depth == 0) {
+				error = true;
+				return false;
+			}
+			if (depth != 1 || field == no_field || seen[field]) {
+				return true;
+			}
+			std::string* dst = field == actor_field ? &rec.actor
+				: field == target_field ? &rec.target
+				: &time_str;
+			dst->assign(s.data(), s.size());
+			return take(true);
+		}
+
+		bool key(string_ref k) {
+			if (depth != 1) {
+				return true;
+			}
+			if (k == "actor") {
+				field = actor_field;
+			} else if (k == "target") {
+				field = target_field;
+			} else if (k == "created_time") {
+				field = created_time_field;
+			} else {
+				field = no_field;
+			}
+			return true;
+		}
+
+		bool start_object() {
+			// a nested object is the value of the current field
+			if (depth == 1 && !take(false)) {
+				return false;
+			}
+			++depth;
+			return true;
+		}
+
+		bool start_array() {
+			if (depth == 0) {
+				error = true;
+				return false;
+			}
+			if (depth == 1 && !take(false)) {
+				return false;
+			}
+			++depth;
+			return true;
+		}
+
+		bool end_object() { --depth; return true; }
+		bool end_array() { --depth; return true; }
+
+		bool parse_error(size_t, string_ref) {
+			error = true;
+			return false;
+		}
+	};
+
+	/**
+		Parse exactly n (at least 1) digits.
+
+		@param p cursor, advanced past the digits.
+		@param n number of digits.
+		@param value set to the parsed number.
+		@return false if fewer than n digits follow.
+	*/
+	static bool digits(char const*& p, int n, int& value) {
+		value = 0;
+		for (; n != 0; --n, ++p) {
+			if (*p < '0' || '9' < *p) {
+				return false;
+			}
+			value = value * 10 + (*p - '0');
+		}
+		return true;
+	}
+
+	/**
+		Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+
+		@param y year.
+		@param m month, 1 to 12.
+		@param d day of the month, 1 to 31.
+		@return the number of days, negative before 1970.
+	*/
+	static int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+		y -= m <= 2;
+		int64_t const era = (y >= 0 ? y : y - 399) / 400;
+		unsigned const yoe = unsigned(y - era * 400);
+		unsigned const doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+		unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+		return era * 146097 + int64_t(doe) - 719468;
+	}
+
+	std::string _time_str;	// created_time, reused from line to line
+
+	/**
+		Status of a line from what the handler saw. Also parses the time.
+
+		@param h handler that read the line.
+		@param rec the fields read.
+		@return ok, or why the line should be skipped.
+	*/
+	Status status(Handler const& h, VenmoRecord& rec) {
+		if (h.error) {
+			return malformed;
+		}
+		if (!h.seen[actor_field]) {
+			return missing_actor;
+		}
+		if (h.bad[actor_field]) {
+			return bad_actor;
+		}
+		if (rec.actor.empty()) {
+			return empty_actor;
+		}
+		if (!h.seen[target_field]) {
+			return missing_target;
+		}
+		if (h.bad[target_field]) {
+			return bad_target;
+		}
+		if (rec.target.empty()) {
+			return empty_target;
+		}
+		if (!h.seen[created_time_field]) {
+			return missing_created_time;
+		}
+		if (h.bad[created_time_field]) {
+			return bad_created_time;
+		}
+		if (_time_str.empty()) {
+			return empty_created_time;
+		}
+		if (!parse_time(_time_str.c_str(), rec.created_time)) {
+			return bad_created_time;
+		}
+		return ok;
+	}
+
+public:
+	/**
+		Parse a timestamp of the form YYYY-MM-DDTHH:MM:SSZ.
+
+		@param s the timestamp, null-terminated.
+		@param t set to the seconds since the epoch.
+		@return false if s is not such a timestamp.
+	*/
+	static bool parse_time(char const* s, time_t& t) {
+		int year, mon, mday, hour, min, sec;
+		if (!digits(s, 4, year) || *s++ != '-' ||
+			!digits(s, 2, mon) || *s++ != '-' ||
+			!digits(s, 2, mday) || *s++ != 'T' ||
+			!digits(s, 2, hour) || *s++ != ':' ||
+			!digits(s, 2, min) || *s++ != ':' ||
+			!digits(s, 2, sec) || *s++ != 'Z' || *s != '\0') {
+			return false;
+		}
+		if (mon < 1 || 12 < mon || mday < 1 || 31 < mday ||
+			23 < hour || 59 < min || 60 < sec) {
+			return false;
+		}
+		int64_t const days = days_from_civil(year, unsigned(mon), unsigned(mday));
+		t = time_t(days * 86400 + hour * 3600 + min * 60 + sec);
+		return true;
+	}
+
+	/**
+		Read the wanted fields of a line of JSON.
+
+		If a field appears more than once, the first occurrence wins. Once
+		all three fields are found, the rest of the line is not looked at
+		(and so not checked for syntax errors).
+
+		@param first first character of one JSON object.
+		@param last one past its last character.
+		@param rec set to the fields read; only meaningful on ok.
+		@return ok, or why the line should be skipped.
+	*/
+	Status read(char const* first, char const* last, VenmoRecord& rec) {
+		Handler h(rec, _time_str);
+		json::sax_parse(first, last, h);
+		return status(h, rec);
+	}
+
+	/**
+		Read the wanted fields of a line of JSON that has been through a
+		StructuralIndex. The line is walked through its offsets instead of
+		being scanned byte by byte, unless sax_walk() leaves it to the
+		parser. The result is the same as read(first, last, rec).
+
+		@param first first character of one JSON object.
+		@param last one past its last character.
+		@param base the buffer the offsets are relative to.
+		@param pos the line's first offset.
+		@param pos_end one past the line's last offset.
+		@param rec set to the fields read; only meaningful on ok.
+		@return ok, or why the line should be skipped.
+	*/
+	Status read(char const* first, char const* last, char const* base,
+				uint32_t const* pos, uint32_t const* pos_end,
+				VenmoRecord& rec) {
+		Handler h(rec, _time_str);
+		if (sax_walk(first, last, base, pos, pos_end, h) == walk_fallback) {
+			return read(first, last, rec);
+		}
+		return status(h, rec);
+	}
+
+	/**
+		Read the wanted fields of a line of JSON.
+
+		@param line one JSON object.
+		@param rec set to the fields read; only meaningful on ok.
+		@return ok, or why the line should be skipped.
+	*/
+	Status read(std::string const& line, VenmoRecord& rec) {
+		return read(line.data(), line.data() + line.size(), rec);
+	}
+
+	/**
+		Human-readable reason for a status.
+
+		@param status a status returned by read().
+		@return a short description.
+	*/
+	static char const* describe(Status status) {
+		switch (status) {
+		case ok: return "ok";
+		case malformed: return "malformed json";
+		case missing_actor: return "missing actor";
+		case empty_actor: return "empty actor";
+		case bad_actor: return "bad actor";
+		case missing_target: return "missing target";
+		case empty_target: return "empty target";
+		case bad_target: return "bad target";
+		case missing_created_time: return "missing created_time";
+		case empty_created_time: return "empty created_time";
+		case bad_created_time: return "bad created_time";
+		}
+		return "unknown";
+	}
+};  // class VenmoRecordReader
+
+}  // namespace victor
+
+#endif  // VENMO_RECORD_HPP_
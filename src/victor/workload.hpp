@@ -0,0 +1,505 @@
+/**
+    Insight Data Engineering Code Challenge
+    workload.hpp
+
+    Purpose:
+
+    WorkloadGenerator makes synthetic Venmo payments in any number, for
+    exercising MedHeapMap and VenmoGraph at scales that the sample in
+    data-gen/ can't reach. data-gen/gen_workload.cpp is its command line.
+
+    Everything about a workload is set by a WorkloadConfig and drawn from a
+    Random seeded by it, so the same config always gives the same bytes, on
+    any platform (the distributions of <random> are not specified exactly
+    enough for that). Actors and targets are drawn from users by popularity
+    following a Zipf law; payments arrive at a given mean rate, in bursts
+    that share a second; and given fractions of them are late (inside or
+    outside the 60 second window), repeat a recent edge, or are malformed
+    in one of the ways VenmoRecordReader reports. Records are written as
+    JSON lines like those of the challenge, or as MessagePack or CBOR maps
+    for BinaryRecordReader.
+
+    @author Victor Chen
+*/
+#ifndef WORKLOAD_HPP_
+#define WORKLOAD_HPP_
+
+#include "victor/output_sink.hpp"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <cmath>
+
+namespace victor {
+
+/**
+	Random number generator: xoshiro256**, seeded through splitmix64.
+*/
+class Random {
+private:
+	uint64_t _s[4];
+
+	static uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	explicit Random(uint64_t seed) {
+		for (int i = 0; i < 4; ++i) {
+			uint64_t z = (seed += 0x9e3779b97f4a7c15u);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+			_s[i] = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t next() {
+		uint64_t const result = rotl(_s[1] * 5, 7) * 9;
+		uint64_t const t = _s[1] << 17;
+		_s[2] ^= _s[0];
+		_s[3] ^= _s[1];
+		_s[1] ^= _s[2];
+		_s[0] ^= _s[3];
+		_s[2] ^= t;
+		_s[3] = rotl(_s[3], 45);
+		return result;
+	}
+
+	/**
+		@return a double uniform in [0, 1).
+	*/
+	double uniform() {
+		return double(next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	/**
+		@return an integer uniform in [0, n), for n > 0.
+	*/
+	uint64_t below(uint64_t n) {
+		// Lemire's multiply-shift, without the rejection step; the bias is
+		// at most n / 2^64
+		return uint64_t((unsigned __int128)(next()) * n >> 64);
+	}
+
+	/**
+		@return true with probability p.
+	*/
+	bool chance(double p) {
+		return uniform() < p;
+	}
+};  // class Random
+
+/**
+	Zipf Sampler
+
+	Draws k in [1, n] with probability proportional to 1 / k^s, in constant
+	time, by rejection-inversion (Hormann and Derflinger, "Rejection-
+	inversion to generate variates from monotone discrete distributions",
+	1996). s = 0 is the uniform distribution.
+*/
+class ZipfSampler {
+private:
+	uint64_t _n;
+	double _s;
+	double _h_integral_x1;
+	double _h_integral_n;
+	double _threshold;
+
+	static double helper1(double x) {
+		return std::fabs(x) > 1e-8 ? std::log1p(x) / x
+			: 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+	}
+
+	static double helper2(double x) {
+		return std::fabs(x) > 1e-8 ? std::expm1(x) / x
+			: 1 + x * 0.5 * (1 + x * (1.0 / 3) * (1 + 0.25 * x));
+	}
+
+	double h(double x) const {
+		return std::exp(-_s * std::log(x));
+	}
+
+	double h_integral(double x) const {
+		double const log_x = std::log(x);
+		return helper2((1 - _s) * log_x) * log_x;
+	}
+
+	double h_integral_inverse(double x) const {
+		double t = x * (1 - _s);
+		if (t < -1) {
+			t = -1;
+		}
+		return std::exp(helper1(t) * x);
+	}
+
+public:
+	/**
+		@param n number of elements, at least 1.
+		@param s exponent, at least 0.
+	*/
+	ZipfSampler(uint64_t n, double s) : _n(n < 1 ? 1 : n), _s(s < 0 ? 0 : s) {
+		_h_integral_x1 = h_integral(1.5) - 1;
+		_h_integral_n = h_integral(double(_n) + 0.5);
+		_threshold = 2 - h_integral_inverse(h_integral(2.5) - h(2));
+	}
+
+	/**
+		@return an element, 1 being the most likely.
+	*/
+	uint64_t operator()(Random& random) const {
+		if (_s == 0) {
+			return 1 + random.below(_n);
+		}
+		while (true) {
+			double const u = _h_integral_n +
+				random.uniform() * (_h_integral_x1 - _h_integral_n);
+			double const x = h_integral_inverse(u);
+			double k = std::floor(x + 0.5);
+			if (k < 1) {
+				k = 1;
+			} else if (k > double(_n)) {
+				k = double(_n);
+			}
+			if (k - x <= _threshold || u >= h_integral(k + 0.5) - h(k)) {
+				return uint64_t(k);
+			}
+		}
+	}
+};  // class ZipfSampler
+
+/**
+	Shape of a workload. The fractions are of all records.
+*/
+struct WorkloadConfig {
+	uint64_t seed = 1;
+	uint64_t num_users = 100000;
+	double zipf = 1.0;				// exponent of user popularity
+	double rate = 10;				// mean records per second
+	double burst = 1;				// mean records in a burst that share a second
+	double out_of_order = 0.05;		// late, but inside the window
+	double out_of_window = 0.01;	// too late to count
+	double repeat_edge = 0.1;		// same pair of users as a recent record
+	double malformed = 0.001;		// skipped by the reader
+	time_t start_time = 1459207392;	// 2016-03-28T23:23:12Z
+
+	/**
+		Encoding of the records written.
+	*/
+	enum Format {
+		json,		// one JSON object per line
+		msgpack,	// a stream of MessagePack maps
+		cbor		// a sequence of CBOR maps
+	};
+	Format format = json;
+};
+
+/**
+	Workload Generator
+*/
+class WorkloadGenerator {
+public:
+	/**
+		Ways a record is malformed.
+	*/
+	enum Defect {
+		no_defect,
+		missing_actor,
+		empty_target,
+		bad_created_time,
+		truncated,		// a cut-off line; an actor of the wrong type in binary
+		not_an_object,
+		num_defects
+	};
+
+	/**
+		One generated payment.
+	*/
+	struct Event {
+		time_t created_time;
+		uint64_t actor;		// user ids, in [0, num_users)
+		uint64_t target;
+		Defect defect;
+	};
+
+private:
+	static size_t const recent_size = 256;
+	static size_t const max_name = 48;
+	static size_t const max_record = 3 * max_name + 96;
+
+	WorkloadConfig _config;
+	Random _random;
+	ZipfSampler _zipf;
+	uint64_t _stride;				// maps popularity ranks to user ids
+	double _clock;					// arrival time, in seconds
+	time_t _latest;					// latest created_time so far
+	uint64_t _burst_left = 0;		// records left in the current burst
+	uint64_t _recent[recent_size][2];	// recent edges, for repeats
+	uint64_t _num_recent = 0;
+
+	/**
+		A user, drawn by popularity.
+	*/
+	uint64_t user() {
+		return (_zipf(_random) - 1) * _stride % _config.num_users;
+	}
+
+	/**
+		Number of extra records in a burst: geometric with mean burst - 1.
+	*/
+	uint64_t extra_in_burst() {
+		double const mean = _config.burst - 1;
+		if (mean <= 0) {
+			return 0;
+		}
+		return uint64_t(std::floor(std::log1p(-_random.uniform()) /
+								   std::log(mean / (mean + 1))));
+	}
+
+	static uint64_t gcd(uint64_t a, uint64_t b) {
+		while (b != 0) {
+			uint64_t const t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+
+	static char* copy(char* p, char const* s, size_t n) {
+		memcpy(p, s, n);
+		return p + n;
+	}
+
+	template <size_t N>
+	static char* copy(char* p, char const (&s)[N]) {
+		return copy(p, s, N - 1);
+	}
+
+	/**
+		Write a string header: MessagePack str8, or a CBOR text string.
+	*/
+	char* string_header(char* p, size_t n) const {
+		if (_config.format == WorkloadConfig::msgpack) {
+			*p++ = char(0xd9);
+		} else {
+			*p++ = char(0x78);
+		}
+		*p++ = char(n);
+		return p;
+	}
+
+	/**
+		Write a key, as a fixstr or a short CBOR text string.
+	*/
+	template <size_t N>
+	char* binary_key(char* p, char const (&key)[N]) const {
+		*p++ = char((_config.format == WorkloadConfig::msgpack ? 0xa0 : 0x60) +
+					(N - 1));
+		return copy(p, key);
+	}
+
+	/**
+		Write a name as a binary string.
+	*/
+	char* binary_name(char* p, uint64_t id) const {
+		char name[max_name];
+		size_t const n = size_t(user_name(name, id) - name);
+		return copy(string_header(p, n), name, n);
+	}
+
+	char* write_json(char* p, Event const& e) const {
+		char* const start = p;
+		if (e.defect == not_an_object) {
+			p = copy(p, "[\"");
+			p = user_name(p, e.actor);
+			return copy(p, "\"]\n");
+		}
+		p = copy(p, "{\"created_time\": \"");
+		if (e.defect == bad_created_time) {
+			p = copy(p, "2016-13-45 25:61:61");
+		} else {
+			p = NumberFormat::iso_time(p, e.created_time);
+		}
+		p = copy(p, "\", \"target\": \"");
+		if (e.defect != empty_target) {
+			p = user_name(p, e.target);
+		}
+		if (e.defect != missing_actor) {
+			p = copy(p, "\", \"actor\": \"");
+			p = user_name(p, e.actor);
+		}
+		p = copy(p, "\"}");
+		if (e.defect == truncated) {
+			p = start + (p - start) / 2;
+		}
+		*p++ = '\n';
+		return p;
+	}
+
+	char* write_binary(char* p, Event const& e) const {
+		bool const msgpack = _config.format == WorkloadConfig::msgpack;
+		if (e.defect == not_an_object) {
+			*p++ = char(msgpack ? 0x91 : 0x81);
+			return binary_name(p, e.actor);
+		}
+		*p++ = char((msgpack ? 0x80 : 0xa0) + (e.defect == missing_actor ? 2 : 3));
+		p = binary_key(p, "created_time");
+		if (e.defect == bad_created_time) {
+			p = copy(string_header(p, 19), "2016-13-45 25:61:61");
+		} else {
+			char* const time = string_header(p, 20);
+			p = NumberFormat::iso_time(time, e.created_time);
+		}
+		p = binary_key(p, "target");
+		if (e.defect == empty_target) {
+			p = string_header(p, 0);
+		} else {
+			p = binary_name(p, e.target);
+		}
+		if (e.defect != missing_actor) {
+			p = binary_key(p, "actor");
+			if (e.defect == truncated) {
+				*p++ = char(0x07);	// an integer, in both encodings
+			} else {
+				p = binary_name(p, e.actor);
+			}
+		}
+		return p;
+	}
+
+public:
+	explicit WorkloadGenerator(WorkloadConfig const& config)
+		: _config(config), _random(config.seed),
+		  _zipf(config.num_users < 1 ? 1 : config.num_users, config.zipf) {
+		if (_config.num_users < 2) {
+			_config.num_users = 2;
+		}
+		if (_config.num_users > (uint64_t(1) << 32)) {
+			_config.num_users = uint64_t(1) << 32;
+		}
+		// an odd stride coprime with the number of users scatters the
+		// popular users across the id range
+		_stride = 2654435761u % _config.num_users;
+		while (_stride == 0 || gcd(_stride, _config.num_users) != 1) {
+			++_stride;
+		}
+		_clock = double(_config.start_time);
+		_latest = _config.start_time;
+	}
+
+	/**
+		Write a user's name: a first and a last name, and a number to tell
+		apart users with the same names.
+
+		@param p where to write it, at least 48 characters.
+		@param id the user.
+		@return one past its last character.
+	*/
+	static char* user_name(char* p, uint64_t id) {
+		static char const* const first[] = {
+			"Amber", "Raffi", "Caroline", "Charlotte", "Jordan", "Maddie",
+			"Nick", "Sarah", "Tom", "Ana", "Brian", "Kara", "Luis", "Mei",
+			"Olu", "Priya", "Quinn", "Rosa", "Sam", "Theo", "Uma", "Vik",
+			"Wes", "Xena", "Yuki", "Zoe", "Abdul", "Beatriz", "Chidi",
+			"Dmitri", "Esther", "Farah"
+		};
+		static char const* const last[] = {
+			"Sauer", "Antilian", "Kaiser", "Macfarlane", "Lee", "Garcia",
+			"Nguyen", "Okafor", "Patel", "Rossi", "Schmidt", "Tanaka",
+			"Underwood", "Vasquez", "Walsh", "Xu", "Yilmaz", "Zhang",
+			"Abbott", "Bianchi", "Costa", "Dubois", "Eriksen", "Fischer",
+			"Gonzalez", "Hughes", "Ivanova", "Jensen", "Kowalski", "Larsen",
+			"Moreau", "Novak"
+		};
+		char const* const f = first[id % 32];
+		char const* const l = last[id / 32 % 32];
+		p = copy(p, f, strlen(f));
+		*p++ = '-';
+		p = copy(p, l, strlen(l));
+		if (id >= 1024) {
+			*p++ = '-';
+			p = NumberFormat::integer(p, uint64_t(id / 1024));
+		}
+		return p;
+	}
+
+	/**
+		Generate the next payment.
+
+		@param e set to the payment.
+	*/
+	void next(Event& e) {
+		if (_burst_left == 0) {
+			// bursts arrive as a Poisson process
+			_clock -= _config.burst / _config.rate * std::log1p(-_random.uniform());
+			_burst_left = 1 + extra_in_burst();
+		}
+		--_burst_left;
+		time_t const now = time_t(_clock);
+		if (now > _latest) {
+			_latest = now;
+		}
+
+		e.created_time = _latest;
+		double const late = _random.uniform();
+		if (late < _config.out_of_window) {
+			e.created_time = _latest - 60 - time_t(_random.below(3600));
+		} else if (late < _config.out_of_window + _config.out_of_order) {
+			e.created_time = _latest - 1 - time_t(_random.below(58));
+		}
+
+		if (_num_recent != 0 && _random.chance(_config.repeat_edge)) {
+			uint64_t const* const edge = _recent[_random.below(
+				_num_recent < recent_size ? _num_recent : recent_size)];
+			bool const flip = _random.chance(0.5);
+			e.actor = edge[flip];
+			e.target = edge[!flip];
+		} else {
+			e.actor = user();
+			do {
+				e.target = user();
+			} while (e.target == e.actor);
+			uint64_t* const slot = _recent[_num_recent++ % recent_size];
+			slot[0] = e.actor;
+			slot[1] = e.target;
+		}
+
+		e.defect = no_defect;
+		if (_random.chance(_config.malformed)) {
+			e.defect = Defect(1 + _random.below(num_defects - 1));
+		}
+	}
+
+	/**
+		Write a payment in the configured format.
+
+		@param e the payment.
+		@param out where to write it.
+	*/
+	void write(Event const& e, OutputBuffer& out) const {
+		char* const p = out.reserve(max_record);
+		out.commit(_config.format == WorkloadConfig::json ? write_json(p, e)
+			: write_binary(p, e));
+	}
+
+	/**
+		Generate and write payments.
+
+		@param count how many.
+		@param out where to write them.
+	*/
+	void generate(uint64_t count, OutputBuffer& out) {
+		Event e;
+		for (uint64_t i = 0; i < count; ++i) {
+			next(e);
+			write(e, out);
+		}
+	}
+
+	WorkloadConfig const& config() const {
+		return _config;
+	}
+};  // class WorkloadGenerator
+
+}  // namespace victor
+
+#endif  // WORKLOAD_HPP_